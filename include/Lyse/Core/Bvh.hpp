@@ -0,0 +1,78 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/CoreTypes.hpp>
+
+namespace lys
+{
+	// Dynamic bounding volume hierarchy of world-space axis aligned boxes. Leaves are inserted where they increase the
+	// surface area of the tree the least and refit in place when they move, which degrades the tree over time, so it
+	// should be rebuilt from time to time with the surface area heuristic. Leaf indices stay valid across rebuilds.
+
+	class LYS_API Bvh
+	{
+		public:
+
+			Bvh();
+			Bvh(const Bvh& bvh) = default;
+			Bvh(Bvh&& bvh) = default;
+
+			Bvh& operator=(const Bvh& bvh) = default;
+			Bvh& operator=(Bvh&& bvh) = default;
+
+
+			uint32_t insert(const Drawable* drawable, const scp::f32vec3& min, const scp::f32vec3& max);
+			void remove(uint32_t leaf);
+			void refit(uint32_t leaf, const scp::f32vec3& min, const scp::f32vec3& max);
+			void rebuild();
+			void clear();
+
+			void queryFrustum(const Frustum& frustum, std::vector<const Drawable*>& drawables) const;
+			void querySphere(const scp::f32vec3& center, float radius, std::vector<const Drawable*>& drawables) const;
+			void queryBox(const scp::f32vec3& min, const scp::f32vec3& max, std::vector<const Drawable*>& drawables) const;
+			void queryRay(const scp::f32vec3& origin, const scp::f32vec3& direction, float maxDistance, std::vector<const Drawable*>& drawables) const;	// Sorted by distance
+
+			uint32_t getLeafCount() const;
+
+			// Overlap tests used by the queries, `distance` is where the ray enters the box
+			static bool boxIntersectsSphere(const scp::f32vec3& min, const scp::f32vec3& max, const scp::f32vec3& center, float radius);
+			static bool boxIntersectsBox(const scp::f32vec3& min, const scp::f32vec3& max, const scp::f32vec3& boxMin, const scp::f32vec3& boxMax);
+			static bool boxIntersectsRay(const scp::f32vec3& min, const scp::f32vec3& max, const scp::f32vec3& origin, const scp::f32vec3& invDirection, float maxDistance, float& distance);
+
+
+			~Bvh() = default;
+
+			static constexpr uint32_t nullIndex = UINT32_MAX;
+			static constexpr uint32_t binCount = 12;
+
+		private:
+
+			struct Node
+			{
+				scp::f32vec3 min;
+				scp::f32vec3 max;
+				uint32_t parent;
+				uint32_t children[2];		// `nullIndex` for leaves
+				const Drawable* drawable;	// `nullptr` for internal nodes
+			};
+
+			uint32_t _allocateNode();
+			void _freeNode(uint32_t node);
+			void _insertLeaf(uint32_t leaf);
+			void _removeLeaf(uint32_t leaf);
+			void _refitAncestors(uint32_t node);
+			uint32_t _build(uint32_t* leaves, uint32_t count);
+			template<typename TOverlap> void _query(const TOverlap& overlaps, std::vector<const Drawable*>& drawables) const;
+
+			std::vector<Node> _nodes;
+			uint32_t _root;
+			uint32_t _freeNodes;	// Linked through `parent`
+			uint32_t _leafCount;
+	};
+}
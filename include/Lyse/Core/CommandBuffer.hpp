@@ -0,0 +1,67 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/CoreTypes.hpp>
+
+namespace lys
+{
+	// Compact binary stream of binds, uniforms and draws. Recording does not touch the GL context, so command buffers
+	// can be recorded by any thread, and are then executed on the context thread through a state cache, which skips
+	// the commands that would not change the state.
+	//
+	// Uniforms are set by location, as resolved in the shader interfaces. Range arrays and GL objects are referenced,
+	// not copied, and must outlive the execution. The data of `updateBuffer` is copied.
+
+	class LYS_API CommandBuffer
+	{
+		public:
+
+			CommandBuffer();
+			CommandBuffer(const CommandBuffer& commandBuffer) = default;
+			CommandBuffer(CommandBuffer&& commandBuffer) = default;
+
+			CommandBuffer& operator=(const CommandBuffer& commandBuffer) = default;
+			CommandBuffer& operator=(CommandBuffer&& commandBuffer) = default;
+
+
+			void bindShader(const spl::ShaderProgram* shader);
+			void setFaceCulling(spl::FaceCullingMode mode, spl::FaceOrientation orientation);
+			void bindBuffer(spl::BufferTarget target, const spl::Buffer* buffer, uint32_t index);
+			void updateBuffer(spl::Buffer* buffer, const void* data, uint32_t size);
+
+			void setUniform(int32_t location, float value);
+			void setUniform(int32_t location, uint32_t value);
+			void setUniform(int32_t location, const scp::u32vec2& value);
+			void setUniform(int32_t location, const scp::f32vec3& value);
+			void setUniform(int32_t location, const scp::f32vec4& value);
+			void setUniform(int32_t location, uint32_t unit, const spl::Texture* texture);
+
+			void draw(const Drawable* drawable, uint32_t vertexInputMask, uint32_t lod);
+			void drawRanges(const MeshBase* mesh, uint32_t vertexInputMask, const uint32_t* offsets, const uint32_t* counts, uint32_t rangeCount);
+			void drawIndirect(const MeshBase* mesh, uint32_t vertexInputMask, uint64_t commandOffset, uint32_t commandCount);
+			void drawIndirectCount(const MeshBase* mesh, uint32_t vertexInputMask, uint64_t commandOffset, uint64_t countOffset, uint32_t maxCommandCount);
+			void drawArrays(const spl::VertexArray* vertexArray, spl::PrimitiveType primitiveType, uint32_t first, uint32_t count);
+
+			void clear();
+			bool isEmpty() const;
+
+			void execute(StateCache& stateCache) const;
+
+
+			~CommandBuffer() = default;
+
+			static void execute(const CommandBuffer* commandBuffers, uint32_t count, StateCache& stateCache);
+
+		private:
+
+			void _write(const void* data, uint32_t size);
+
+			std::vector<uint8_t> _data;
+	};
+}
@@ -1,32 +1,37 @@
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//! \file
-//! \author Reiex
-//! \copyright The MIT License (MIT)
-//! \date 2023
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-
-#include <Lyse/Core/CoreDecl.hpp>
-
-#include <SciPP/SciPP.hpp>
-#include <Diskon/Diskon.hpp>
-#include <DejaVu/DejaVu.hpp>
-#include <SplayLibrary/SplayLibrary.hpp>
-
-
-#include <Lyse/Core/templates/Transformable.hpp>
-
-#include <Lyse/Core/templates/CameraBase.hpp>
-#include <Lyse/Core/templates/CameraPerspective.hpp>
-#include <Lyse/Core/templates/CameraOrthographic.hpp>
-
-#include <Lyse/Core/templates/LightBase.hpp>
-#include <Lyse/Core/templates/LightPoint.hpp>
-#include <Lyse/Core/templates/LightSun.hpp>
-#include <Lyse/Core/templates/LightSpot.hpp>
-
-
-#include <Lyse/Core/templates/Vertex.hpp>
-#include <Lyse/Core/templates/Mesh.hpp>
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+
+#include <Lyse/Core/CoreDecl.hpp>
+
+#include <SciPP/SciPP.hpp>
+#include <Diskon/Diskon.hpp>
+#include <DejaVu/DejaVu.hpp>
+#include <SplayLibrary/SplayLibrary.hpp>
+
+
+#include <Lyse/Core/templates/JobSystem.hpp>
+#include <Lyse/Core/templates/FrameArena.hpp>
+#include <Lyse/Core/templates/Transformable.hpp>
+#include <Lyse/Core/templates/TransformBatch.hpp>
+#include <Lyse/Core/templates/StateCache.hpp>
+
+#include <Lyse/Core/templates/CameraBase.hpp>
+#include <Lyse/Core/templates/CameraPerspective.hpp>
+#include <Lyse/Core/templates/CameraOrthographic.hpp>
+
+#include <Lyse/Core/templates/LightBase.hpp>
+#include <Lyse/Core/templates/LightPoint.hpp>
+#include <Lyse/Core/templates/LightSun.hpp>
+#include <Lyse/Core/templates/LightSpot.hpp>
+
+
+#include <Lyse/Core/templates/Vertex.hpp>
+#include <Lyse/Core/templates/Mesh.hpp>
+#include <Lyse/Core/templates/MeshOptimization.hpp>
@@ -1,41 +1,54 @@
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//! \file
-//! \author Reiex
-//! \copyright The MIT License (MIT)
-//! \date 2023
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-
-#include <Lyse/Core/CoreTypes.hpp>
-
-#include <SciPP/SciPPDecl.hpp>
-#include <Diskon/DiskonDecl.hpp>
-#include <DejaVu/DejaVuDecl.hpp>
-#include <SplayLibrary/SplayLibraryDecl.hpp>
-
-
-#include <Lyse/Core/Transformable.hpp>
-
-#include <Lyse/Core/CameraBase.hpp>
-#include <Lyse/Core/CameraPerspective.hpp>
-#include <Lyse/Core/CameraOrthographic.hpp>
-
-#include <Lyse/Core/LightBase.hpp>
-#include <Lyse/Core/LightPoint.hpp>
-#include <Lyse/Core/LightSun.hpp>
-#include <Lyse/Core/LightSpot.hpp>
-
-
-#include <Lyse/Core/ShaderSet.hpp>
-#include <Lyse/Core/Material.hpp>
-
-#include <Lyse/Core/Drawable.hpp>
-#include <Lyse/Core/DrawableGroup.hpp>
-
-#include <Lyse/Core/Vertex.hpp>
-
-#include <Lyse/Core/Mesh.hpp>
-
-#include <Lyse/Core/Scene.hpp>
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+
+#include <Lyse/Core/CoreTypes.hpp>
+
+#include <SciPP/SciPPDecl.hpp>
+#include <Diskon/DiskonDecl.hpp>
+#include <DejaVu/DejaVuDecl.hpp>
+#include <SplayLibrary/SplayLibraryDecl.hpp>
+
+
+#include <Lyse/Core/JobSystem.hpp>
+#include <Lyse/Core/FrameArena.hpp>
+
+#include <Lyse/Core/Transformable.hpp>
+#include <Lyse/Core/TransformBatch.hpp>
+
+#include <Lyse/Core/CameraBase.hpp>
+#include <Lyse/Core/CameraPerspective.hpp>
+#include <Lyse/Core/CameraOrthographic.hpp>
+#include <Lyse/Core/Frustum.hpp>
+#include <Lyse/Core/DepthPyramid.hpp>
+#include <Lyse/Core/OcclusionBuffer.hpp>
+#include <Lyse/Core/Bvh.hpp>
+
+#include <Lyse/Core/LightBase.hpp>
+#include <Lyse/Core/LightPoint.hpp>
+#include <Lyse/Core/LightSun.hpp>
+#include <Lyse/Core/LightSpot.hpp>
+
+
+#include <Lyse/Core/ShaderSet.hpp>
+#include <Lyse/Core/StateCache.hpp>
+#include <Lyse/Core/CommandBuffer.hpp>
+#include <Lyse/Core/Material.hpp>
+
+#include <Lyse/Core/Drawable.hpp>
+#include <Lyse/Core/DrawableGroup.hpp>
+#include <Lyse/Core/DrawableRegistry.hpp>
+
+#include <Lyse/Core/Vertex.hpp>
+
+#include <Lyse/Core/MeshBase.hpp>
+#include <Lyse/Core/Mesh.hpp>
+#include <Lyse/Core/MeshOptimization.hpp>
+
+#include <Lyse/Core/Scene.hpp>
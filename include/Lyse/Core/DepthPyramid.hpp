@@ -0,0 +1,59 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/CoreTypes.hpp>
+
+namespace lys
+{
+	// CPU copy of a hierarchical depth buffer (max of the linear depths of the G-Buffer), with the camera it was rendered
+	// from, used to test bounding boxes for occlusion. Level 0 has the resolution of the G-Buffer, but only the levels
+	// from the one read back from the GPU are stored.
+
+	class LYS_API DepthPyramid
+	{
+		public:
+
+			DepthPyramid();
+			DepthPyramid(const DepthPyramid& pyramid) = default;
+			DepthPyramid(DepthPyramid&& pyramid) = default;
+
+			DepthPyramid& operator=(const DepthPyramid& pyramid) = default;
+			DepthPyramid& operator=(DepthPyramid&& pyramid) = default;
+
+
+			void update(const float* depths, const scp::u32vec2& resolution, uint32_t level, const scp::f32mat4x4& view, const scp::f32mat4x4& projection, float near, float far);
+			void invalidate();
+
+			bool isBoxOccluded(const scp::f32vec3& min, const scp::f32vec3& max, const scp::f32mat4x4& model) const;
+
+			bool isValid() const;
+			uint32_t getFirstLevel() const;
+			uint32_t getLevelCount() const;
+			const scp::u32vec2& getLevelSize(uint32_t level) const;
+			const float* getLevelData(uint32_t level) const;
+			const scp::f32mat4x4& getViewMatrix() const;
+			const scp::f32mat4x4& getProjectionMatrix() const;
+			float getNearDistance() const;
+			float getFarDistance() const;
+
+
+			~DepthPyramid() = default;
+
+		private:
+
+			std::vector<std::vector<float>> _levels;
+			std::vector<scp::u32vec2> _sizes;
+			uint32_t _firstLevel;
+
+			scp::f32mat4x4 _view;
+			scp::f32mat4x4 _projection;
+			float _near;
+			float _far;
+	};
+}
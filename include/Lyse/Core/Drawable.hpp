@@ -1,64 +1,95 @@
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//! \file
-//! \author Reiex
-//! \copyright The MIT License (MIT)
-//! \date 2023
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-#include <Lyse/Core/CoreTypes.hpp>
-
-namespace lys
-{
-	enum class DrawableType
-	{
-		Particles,
-		Mesh,
-		MeshInstanced,
-		Group
-	};
-
-	class LYS_API Drawable : public Transformable
-	{
-		public:
-
-			void setShaderSet(const ShaderSet* shaderSet);
-			void setMaterial(const Material* material);
-			void setGeometryFaceCullingMode(spl::FaceCullingMode mode);
-			void setGeometryFaceCullingOrientation(spl::FaceOrientation orientation);
-			void setShadowFaceCullingMode(spl::FaceCullingMode mode);
-			void setShadowFaceCullingOrientation(spl::FaceOrientation orientation);
-
-			virtual DrawableType getType() const = 0;
-			const ShaderSet* getShaderSet() const;
-			const Material* getMaterial() const;
-			spl::FaceCullingMode getGeometryFaceCullingMode() const;
-			spl::FaceOrientation getGeometryFaceCullingOrientation() const;
-			spl::FaceCullingMode getShadowFaceCullingMode() const;
-			spl::FaceOrientation getShadowFaceCullingOrientation() const;
-
-		protected:
-
-
-			Drawable();
-			Drawable(const Drawable& drawable) = default;
-			Drawable(Drawable&& drawable) = default;
-
-			Drawable& operator=(const Drawable& drawable) = default;
-			Drawable& operator=(Drawable&& drawable) = default;
-
-			virtual void _draw() const = 0;
-
-			virtual ~Drawable() override = default;
-
-			const ShaderSet* _shaderSet;
-			const Material* _material;
-			spl::FaceCullingMode _geometryCullingMode;
-			spl::FaceOrientation _geometryCullingOrientation;
-			spl::FaceCullingMode _shadowCullingMode;
-			spl::FaceOrientation _shadowCullingOrientation;
-
-		friend class Scene;
-	};
-}
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/CoreTypes.hpp>
+
+namespace lys
+{
+	enum class DrawableType
+	{
+		Particles,
+		Mesh,
+		MeshInstanced,
+		Group
+	};
+
+	class LYS_API Drawable : public Transformable
+	{
+		public:
+
+			void setShaderSet(const ShaderSet* shaderSet);
+			void setMaterial(const Material* material);
+			void setGeometryFaceCullingMode(spl::FaceCullingMode mode);
+			void setGeometryFaceCullingOrientation(spl::FaceOrientation orientation);
+			void setShadowFaceCullingMode(spl::FaceCullingMode mode);
+			void setShadowFaceCullingOrientation(spl::FaceOrientation orientation);
+
+			virtual DrawableType getType() const = 0;
+			const ShaderSet* getShaderSet() const;
+			const Material* getMaterial() const;
+			spl::FaceCullingMode getGeometryFaceCullingMode() const;
+			spl::FaceOrientation getGeometryFaceCullingOrientation() const;
+			spl::FaceCullingMode getShadowFaceCullingMode() const;
+			spl::FaceOrientation getShadowFaceCullingOrientation() const;
+
+			const DrawableGroup* getParent() const;
+			const scp::f32mat4x4& getWorldTransformMatrix() const;	// Transform of the drawable composed with the ones of its ancestors
+			const scp::f32mat4x4& getInverseWorldTransformMatrix() const;
+			bool hasWorldBoundingBox() const;	// Drawables without bounds, and the groups containing one, are never culled
+			const scp::f32vec3& getWorldBoundingBoxMin() const;
+			const scp::f32vec3& getWorldBoundingBoxMax() const;
+
+		protected:
+
+
+			Drawable();
+			Drawable(const Drawable& drawable);
+			Drawable(Drawable&& drawable);
+
+			Drawable& operator=(const Drawable& drawable);
+			Drawable& operator=(Drawable&& drawable);
+
+			virtual void _draw(uint32_t vertexInputMask, uint32_t lod) const = 0;
+
+			void _updateWorldTransform() const;
+			virtual void _updateWorldBoundingBox() const;	// Updates the world transform first
+
+			virtual ~Drawable() override;
+
+			const ShaderSet* _shaderSet;
+			const Material* _material;
+			spl::FaceCullingMode _geometryCullingMode;
+			spl::FaceOrientation _geometryCullingOrientation;
+			spl::FaceCullingMode _shadowCullingMode;
+			spl::FaceOrientation _shadowCullingOrientation;
+
+			uint32_t _stateVersion;		// Incremented each time the shader set, the material or the culling modes change
+
+			DrawableGroup* _parent;
+
+			// The world transform is recomputed only when the local transform or the one of an ancestor changed
+			mutable scp::f32mat4x4 _worldTransform;
+			mutable scp::f32mat4x4 _invWorldTransform;
+			mutable uint32_t _worldTransformVersion;	// Incremented each time the world transform changes
+			mutable uint32_t _localTransformVersion;	// Versions the world transform was computed from
+			mutable uint32_t _parentTransformVersion;
+			mutable bool _worldTransformDirty;
+
+			mutable scp::f32vec3 _worldBoundingBoxMin;
+			mutable scp::f32vec3 _worldBoundingBoxMax;
+			mutable bool _hasWorldBoundingBox;
+			mutable uint32_t _worldBoundingBoxVersion;	// Incremented each time the world bounding box changes
+			mutable uint32_t _boundingBoxTransformVersion;	// World transform version the bounding box was computed from
+			mutable bool _worldBoundingBoxDirty;
+
+		friend class CommandBuffer;
+		friend class DrawableGroup;
+		friend class Scene;
+	};
+}
@@ -1,40 +1,50 @@
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//! \file
-//! \author Reiex
-//! \copyright The MIT License (MIT)
-//! \date 2023
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-#include <Lyse/Core/CoreTypes.hpp>
-
-namespace lys
-{
-	class DrawableGroup : public Drawable
-	{
-		public:
-
-			virtual DrawableType getType() const override = 0;
-
-		protected:
-
-			DrawableGroup() = default;
-
-			DrawableGroup(const DrawableGroup& group) = default;
-			DrawableGroup(DrawableGroup&& group) = default;
-
-			DrawableGroup& operator=(const DrawableGroup& group) = default;
-			DrawableGroup& operator=(DrawableGroup&& group) = default;
-
-			virtual ~DrawableGroup() override = default;
-
-		private:
-
-			virtual void _draw() const override = 0;
-			virtual uint32_t _getChildCount() const = 0;
-			virtual const Drawable* _getChild(uint32_t index) const = 0;
-
-		friend class Scene;
-	};
-}
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/CoreTypes.hpp>
+
+namespace lys
+{
+	// Node of the scene graph, the transforms of the children are relative to the group. The group does not own its
+	// children, a drawable has at most one parent and only the roots of the hierarchies are added to the scene.
+
+	class LYS_API DrawableGroup : public Drawable
+	{
+		public:
+
+			DrawableGroup();
+			DrawableGroup(const DrawableGroup& group) = delete;
+			DrawableGroup(DrawableGroup&& group) = delete;
+
+			DrawableGroup& operator=(const DrawableGroup& group) = delete;
+			DrawableGroup& operator=(DrawableGroup&& group) = delete;
+
+
+			void addChild(Drawable* child);
+			void removeChild(Drawable* child);
+
+			virtual DrawableType getType() const override final;
+			uint32_t getChildCount() const;
+			const Drawable* getChild(uint32_t index) const;
+
+
+			virtual ~DrawableGroup() override;
+
+		private:
+
+			virtual void _draw(uint32_t vertexInputMask, uint32_t lod) const override;
+			virtual void _updateWorldBoundingBox() const override;
+
+			std::vector<Drawable*> _children;
+			uint32_t _hierarchyVersion;		// Incremented each time a child is added or removed
+			mutable std::vector<uint32_t> _childBoundingBoxVersions;	// Versions the bounding box was computed from
+
+		friend class Scene;
+	};
+}
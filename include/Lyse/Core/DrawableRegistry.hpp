@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/CoreTypes.hpp>
+
+namespace lys
+{
+	struct DrawableHandle
+	{
+		uint32_t slot;
+		uint32_t generation;
+
+		constexpr bool operator==(const DrawableHandle& handle) const = default;
+	};
+
+	// Per-drawable data of a scene in contiguous arrays, so that the render passes can iterate them linearly. Entries
+	// are addressed by generational handles, which stay valid when the entries are reordered and become invalid when
+	// their drawable is removed. The arrays are in the order given to `assign`, so that a hierarchy can be laid out in
+	// depth-first order.
+
+	class LYS_API DrawableRegistry
+	{
+		public:
+
+			DrawableRegistry();
+			DrawableRegistry(const DrawableRegistry& registry) = default;
+			DrawableRegistry(DrawableRegistry&& registry) = default;
+
+			DrawableRegistry& operator=(const DrawableRegistry& registry) = default;
+			DrawableRegistry& operator=(DrawableRegistry&& registry) = default;
+
+
+			void assign(const Drawable* const* drawables, uint32_t count);	// Drawables not in the list are removed
+			void clear();
+
+			bool isValid(const DrawableHandle& handle) const;
+			DrawableHandle getHandle(const Drawable* drawable) const;	// `nullHandle` if the drawable is not registered
+			uint32_t getIndex(const DrawableHandle& handle) const;
+			uint32_t getSize() const;
+			const Drawable* getDrawable(uint32_t index) const;
+
+
+			~DrawableRegistry() = default;
+
+			static constexpr DrawableHandle nullHandle = { UINT32_MAX, 0 };
+
+			static constexpr uint32_t flagGroup = 1;
+			static constexpr uint32_t flagBounded = 2;
+			static constexpr uint32_t flagOccluder = 4;
+			static constexpr uint32_t flagGpuDriven = 8;
+			static constexpr uint32_t flagMesh = 16;
+
+		private:
+
+			uint32_t _getMaterialIndex(const Material* material);
+			void _clearMaterials();	// The material arrays are only ever reset together
+
+			// Index of the entry for used slots, next free slot otherwise
+
+			struct Slot
+			{
+				uint32_t index;
+				uint32_t generation;
+			};
+
+			std::vector<Slot> _slots;
+			uint32_t _freeSlots;
+			std::unordered_map<const Drawable*, uint32_t> _slotIndices;
+
+			// Entries
+
+			std::vector<uint32_t> _entrySlots;
+			std::vector<const Drawable*> _drawables;
+			std::vector<uint32_t> _subtreeEnds;		// Index of the first entry after the descendants of the entry
+			std::vector<uint32_t> _flags;
+			std::vector<scp::f32mat4x4> _transforms;
+			std::vector<scp::f32mat4x4> _invTransforms;
+			std::vector<scp::f32vec3> _boundingBoxMins;
+			std::vector<scp::f32vec3> _boundingBoxMaxs;
+			std::vector<const ShaderSet*> _shaderSets;			// Custom shader set, `nullptr` otherwise
+			std::vector<const ShaderSet*> _defaultShaderSets;	// Shader variants of the drawable type, `nullptr` if none
+			std::vector<uint32_t> _shaderVariants;				// Variant bits selected by the drawable itself
+			std::vector<uint32_t> _materialIndices;
+
+			// Versions of the drawable the entry was copied from
+
+			std::vector<uint32_t> _transformVersions;
+			std::vector<uint32_t> _boundingBoxVersions;
+			std::vector<uint32_t> _stateVersions;
+			std::vector<uint32_t> _hierarchyVersions;
+
+			// Materials of the entries, with the shader variant bits their textures select and the version they were
+			// read at
+
+			std::vector<const Material*> _materials;
+			std::vector<uint32_t> _materialVariants;
+			std::vector<uint32_t> _materialVersions;
+			std::unordered_map<const Material*, uint32_t> _materialIndexMap;
+
+		friend class Scene;
+	};
+}
@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/CoreTypes.hpp>
+
+namespace lys
+{
+	// Linear allocator for the data that only lives during a frame. Allocations move a cursor forward and are never
+	// freed one by one, everything is released at once by `reset`. When a frame needs more than the block, the extra
+	// memory is taken from the heap and the block grows at the next reset, so that a steady frame does not allocate.
+	//
+	// An arena is used by one thread at a time.
+
+	class LYS_API FrameArena
+	{
+		public:
+
+			FrameArena(uint64_t capacity = 1 << 16);
+			FrameArena(const FrameArena& arena) = delete;
+			FrameArena(FrameArena&& arena) = delete;
+
+			FrameArena& operator=(const FrameArena& arena) = delete;
+			FrameArena& operator=(FrameArena&& arena) = delete;
+
+
+			void* allocate(uint64_t size, uint64_t alignment);
+			void reset();
+
+			uint64_t getCapacity() const;
+			uint64_t getUsedSize() const;
+
+
+			~FrameArena() = default;
+
+		private:
+
+			std::unique_ptr<uint8_t[]> _block;
+			uint64_t _capacity;
+			uint64_t _offset;
+
+			std::vector<std::unique_ptr<uint8_t[]>> _overflowBlocks;
+			uint64_t _overflowSize;
+	};
+
+	// Standard allocator on top of a frame arena, the memory of a container is released with the arena
+
+	template<typename TValue>
+	class FrameAllocator
+	{
+		public:
+
+			using value_type = TValue;
+
+			constexpr FrameAllocator(FrameArena& arena);
+			template<typename TOther> constexpr FrameAllocator(const FrameAllocator<TOther>& allocator);
+			constexpr FrameAllocator(const FrameAllocator<TValue>& allocator) = default;
+			constexpr FrameAllocator(FrameAllocator<TValue>&& allocator) = default;
+
+			constexpr FrameAllocator<TValue>& operator=(const FrameAllocator<TValue>& allocator) = default;
+			constexpr FrameAllocator<TValue>& operator=(FrameAllocator<TValue>&& allocator) = default;
+
+
+			TValue* allocate(std::size_t count);
+			constexpr void deallocate(TValue* values, std::size_t count);
+
+			template<typename TOther> constexpr bool operator==(const FrameAllocator<TOther>& allocator) const;
+
+
+			constexpr ~FrameAllocator() = default;
+
+		private:
+
+			FrameArena* _arena;
+
+		template<typename TOther> friend class FrameAllocator;
+	};
+
+	template<typename TValue> using FrameVector = std::vector<TValue, FrameAllocator<TValue>>;
+
+	// Number of calls to the global `operator new` since the start of the process. They are only counted when the
+	// library is compiled with `LYSE_COUNT_ALLOCATIONS`, the count is always 0 otherwise.
+
+	LYS_API uint64_t getHeapAllocationCount();
+}
@@ -0,0 +1,42 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/CoreTypes.hpp>
+
+namespace lys
+{
+	// World-space view frustum of a camera, as six inward-facing planes (normal, distance)
+
+	class LYS_API Frustum
+	{
+		public:
+
+			Frustum(const CameraBase* camera);
+			Frustum(const Frustum& frustum) = default;
+			Frustum(Frustum&& frustum) = default;
+
+			Frustum& operator=(const Frustum& frustum) = default;
+			Frustum& operator=(Frustum&& frustum) = default;
+
+
+			bool intersectsSphere(const scp::f32vec3& center, float radius) const;
+			bool intersectsBox(const scp::f32vec3& min, const scp::f32vec3& max) const;
+
+			const scp::f32vec3& getEyePosition() const;
+			const std::array<scp::f32vec4, 6>& getPlanes() const;
+
+
+			~Frustum() = default;
+
+		private:
+
+			scp::f32vec3 _eye;
+			std::array<scp::f32vec4, 6> _planes;
+	};
+}
@@ -0,0 +1,125 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/CoreTypes.hpp>
+
+namespace lys
+{
+	// Number of jobs that are not finished yet, jobs can be made to wait for a counter to reach zero
+
+	class LYS_API JobCounter
+	{
+		public:
+
+			JobCounter();
+			JobCounter(const JobCounter& counter) = delete;
+			JobCounter(JobCounter&& counter) = delete;
+
+			JobCounter& operator=(const JobCounter& counter) = delete;
+			JobCounter& operator=(JobCounter&& counter) = delete;
+
+
+			bool isDone() const;
+
+
+			~JobCounter();
+
+		private:
+
+			std::atomic<uint32_t> _count;
+			std::mutex _mutex;
+			std::vector<std::pair<std::function<void()>, JobCounter*>> _continuations;	// Jobs waiting for the counter
+
+		friend class JobSystem;
+	};
+
+	// Thread pool of the application, that the job system can run its workers on instead of creating its own threads
+
+	class LYS_API JobExecutor
+	{
+		public:
+
+			virtual uint32_t getThreadCount() const = 0;
+			virtual void execute(std::function<void()> task) = 0;	// `task` may run for a while, until no job is left
+
+			virtual ~JobExecutor() = default;
+	};
+
+	// Work-stealing job system. Each worker pushes and pops its own jobs at the back of its deque, and steals the jobs
+	// of the others from the front when it has none left. A thread waiting for a counter runs jobs in the meantime,
+	// so that jobs can wait for other jobs without blocking a worker.
+
+	class LYS_API JobSystem
+	{
+		public:
+
+			using Job = std::function<void()>;
+
+			JobSystem(uint32_t threadCount = getDefaultThreadCount());	// With no thread, jobs run when they are waited for
+			JobSystem(JobExecutor& executor);
+			JobSystem(const JobSystem& jobSystem) = delete;
+			JobSystem(JobSystem&& jobSystem) = delete;
+
+			JobSystem& operator=(const JobSystem& jobSystem) = delete;
+			JobSystem& operator=(JobSystem&& jobSystem) = delete;
+
+
+			void run(Job job, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);	// Starts once `dependency` is done
+			void wait(JobCounter& counter);
+			template<typename TFunction> void parallelFor(uint32_t begin, uint32_t end, uint32_t grainSize, const TFunction& function);
+
+			uint32_t getThreadCount() const;
+
+
+			~JobSystem();
+
+			static JobSystem& getGlobal();					// Used by the library for its own parallel work
+			static void setGlobal(JobSystem* jobSystem);	// `nullptr` restores the default job system
+			static uint32_t getDefaultThreadCount();
+
+		private:
+
+			struct Task
+			{
+				Job job;
+				JobCounter* counter;
+			};
+
+			// Not a `std::deque`, which frees and allocates its chunks as jobs come and go
+
+			struct Worker
+			{
+				std::mutex mutex;
+				std::vector<Task> tasks;
+				uint32_t front;	// Tasks before it were stolen
+			};
+
+			void _push(Task&& task);
+			bool _pop(Task& task);
+			void _trimWorker(Worker& worker);
+			void _execute(Task& task);
+			void _workerLoop(uint32_t index);
+			void _helperLoop(uint32_t index);
+
+			// Deque 0 is shared by the threads that are not workers
+
+			std::vector<std::unique_ptr<Worker>> _workers;
+			std::vector<std::thread> _threads;
+			std::atomic<uint32_t> _pendingTasks;
+			std::atomic<bool> _stopping;
+			std::mutex _sleepMutex;
+			std::condition_variable _sleepCondition;
+
+			// Workers running on the executor, they return when no job is left
+
+			JobExecutor* _executor;
+			std::vector<bool> _activeHelpers;
+			std::condition_variable _helperCondition;	// Notified when a helper returns
+	};
+}
@@ -1,89 +1,105 @@
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//! \file
-//! \author Reiex
-//! \copyright The MIT License (MIT)
-//! \date 2023
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-#include <Lyse/Core/CoreTypes.hpp>
-
-namespace lys
-{
-	enum class MeshFormat
-	{
-		Obj
-	};
-
-	template<CVertex TVertex = VertexDefaultMesh>
-	class Mesh : public Drawable
-	{
-		public:
-
-			template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage> Mesh(const std::initializer_list<TVertex>& vertices, TVertexStorage vertexStorage, TIndexStorage indexStorage);
-			template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage> Mesh(const TVertex* vertices, uint32_t vertexCount, TVertexStorage vertexStorage, TIndexStorage indexStorage);
-			template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage> Mesh(const std::initializer_list<TVertex>& vertices, TVertexStorage vertexStorage, const std::initializer_list<uint32_t>& indices, TIndexStorage indexStorage);
-			template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage> Mesh(const TVertex* vertices, uint32_t vertexCount, TVertexStorage vertexStorage, const uint32_t* indices, uint32_t indexCount, TIndexStorage indexStorage);
-			template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage> Mesh(const std::filesystem::path& path, TVertexStorage vertexStorage, TIndexStorage indexStorage);
-			Mesh(const Mesh<TVertex>& mesh);
-			Mesh(Mesh<TVertex>&& mesh);
-
-			Mesh<TVertex>& operator=(const Mesh<TVertex>& mesh);
-			Mesh<TVertex>& operator=(Mesh<TVertex>&& mesh);
-
-			
-			template<CBufferStorageSpecifier TStorage> void createNewVertices(const TVertex* vertices, uint32_t count, TStorage storage);
-			template<CBufferStorageSpecifier TStorage> void createNewIndices(const uint32_t* indices, uint32_t count, TStorage storage);
-			template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage> void createFromFile(const std::filesystem::path& path, TVertexStorage vertexStorage, TIndexStorage indexStorage);
-
-			void updateVertices(const TVertex* vertices, uint32_t count, uint32_t offset = 0);
-			void updateIndices(const uint32_t* indices, uint32_t count, uint32_t offset = 0);
-
-			void destroy();
-
-
-			void setNormalMap(const spl::Texture2D* texture);
-
-
-			void draw(spl::PrimitiveType primitiveType = spl::PrimitiveType::Triangles) const;
-
-
-			virtual DrawableType getType() const override final;
-			const spl::VertexArray& getVertexArray() const;
-			spl::VertexArray& getVertexArray();
-			const spl::Buffer& getVertexBuffer() const;
-			spl::Buffer& getVertexBuffer();
-			const spl::Buffer& getElementBuffer() const;
-			spl::Buffer& getElementBuffer();
-
-			const spl::Texture2D* getNormalMap() const;
-
-			bool isValid() const;
-
-
-			virtual ~Mesh() override final = default;
-
-		private:
-
-			virtual void _draw() const override final;
-
-			Mesh();
-
-			void _createFromFile(const std::filesystem::path& path, std::vector<TVertex>& vertices, std::vector<uint32_t>& indices);
-			void _createFromStream(dsk::IStream* stream, MeshFormat format, std::vector<TVertex>& vertices, std::vector<uint32_t>& indices);
-
-			void _createFromObj(dsk::IStream* stream, std::vector<TVertex>& vertices, std::vector<uint32_t>& indices);
-
-			static constexpr void (Mesh<TVertex>::* _meshFormatToLoadFunc[])(dsk::IStream*, std::vector<TVertex>&, std::vector<uint32_t>&) = {
-				&Mesh<TVertex>::_createFromObj
-			};
-			static bool _extensionToMeshFormat(const std::filesystem::path& extension, MeshFormat& format);
-
-			spl::VertexArray _vao;
-			spl::Buffer _vbo;
-			spl::Buffer _ebo;
-
-			const spl::Texture2D* _normalMap;
-	};
-}
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/CoreTypes.hpp>
+
+namespace lys
+{
+	enum class MeshFormat
+	{
+		Obj
+	};
+
+	template<CVertex TVertex = VertexDefaultMesh>
+	class Mesh : public MeshBase
+	{
+		public:
+
+			template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage> Mesh(const std::initializer_list<TVertex>& vertices, TVertexStorage vertexStorage, TIndexStorage indexStorage);
+			template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage> Mesh(const TVertex* vertices, uint32_t vertexCount, TVertexStorage vertexStorage, TIndexStorage indexStorage);
+			template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage> Mesh(const std::initializer_list<TVertex>& vertices, TVertexStorage vertexStorage, const std::initializer_list<uint32_t>& indices, TIndexStorage indexStorage);
+			template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage> Mesh(const TVertex* vertices, uint32_t vertexCount, TVertexStorage vertexStorage, const uint32_t* indices, uint32_t indexCount, TIndexStorage indexStorage);
+			template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage> Mesh(const std::filesystem::path& path, TVertexStorage vertexStorage, TIndexStorage indexStorage);
+			Mesh(const Mesh<TVertex>& mesh);
+			Mesh(Mesh<TVertex>&& mesh);
+
+			Mesh<TVertex>& operator=(const Mesh<TVertex>& mesh);
+			Mesh<TVertex>& operator=(Mesh<TVertex>&& mesh);
+
+			
+			template<CBufferStorageSpecifier TStorage> void createNewVertices(const TVertex* vertices, uint32_t count, TStorage storage);
+			template<CBufferStorageSpecifier TStorage> void createNewIndices(const uint32_t* indices, uint32_t count, TStorage storage);
+			template<CBufferStorageSpecifier TStorage> void createNewIndices(const uint32_t* indices, uint32_t count, const MeshLod* lods, uint32_t lodCount, TStorage storage);
+			template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage> void createFromFile(const std::filesystem::path& path, TVertexStorage vertexStorage, TIndexStorage indexStorage);
+
+			void updateVertices(const TVertex* vertices, uint32_t count, uint32_t offset = 0);
+			void updateIndices(const uint32_t* indices, uint32_t count, uint32_t offset = 0);
+
+			void destroy();
+
+
+			void draw(spl::PrimitiveType primitiveType = spl::PrimitiveType::Triangles, uint32_t lod = 0) const;
+			void drawPositions(spl::PrimitiveType primitiveType = spl::PrimitiveType::Triangles, uint32_t lod = 0) const;
+
+
+			const spl::VertexArray& getVertexArray() const;
+			spl::VertexArray& getVertexArray();
+			const spl::VertexArray& getPositionVertexArray() const;
+			spl::VertexArray& getPositionVertexArray();
+			const spl::Buffer& getVertexBuffer() const;
+			spl::Buffer& getVertexBuffer();
+			const spl::Buffer& getPositionBuffer() const;
+			spl::Buffer& getPositionBuffer();
+			const spl::Buffer& getElementBuffer() const;
+			spl::Buffer& getElementBuffer();
+			spl::IndexType getIndexType() const;
+
+			uint32_t getVertexCount() const;
+			uint32_t getIndexCount() const;
+
+			bool isValid() const;
+
+
+			virtual ~Mesh() override final = default;
+
+		private:
+
+			using TSourceVertex = _lys::SourceVertex<TVertex>::Type;
+
+			virtual void _draw(uint32_t vertexInputMask, uint32_t lod) const override final;
+			virtual void _drawRanges(uint32_t vertexInputMask, const uint32_t* offsets, const uint32_t* counts, uint32_t rangeCount) const override final;
+			virtual void _drawIndirect(uint32_t vertexInputMask, uint64_t commandOffset, uint32_t commandCount) const override final;
+			virtual void _drawIndirectCount(uint32_t vertexInputMask, uint64_t commandOffset, uint64_t countOffset, uint32_t maxCommandCount) const override final;
+
+			Mesh();
+
+			const spl::VertexArray* _getVertexArray(uint32_t vertexInputMask) const;
+
+			void _bindVertexBuffers();
+
+			void _createFromFile(const std::filesystem::path& path, std::vector<TSourceVertex>& vertices, std::vector<uint32_t>& indices);
+			void _createFromStream(dsk::IStream* stream, MeshFormat format, std::vector<TSourceVertex>& vertices, std::vector<uint32_t>& indices);
+
+			void _createFromObj(dsk::IStream* stream, std::vector<TSourceVertex>& vertices, std::vector<uint32_t>& indices);
+
+			static constexpr void (Mesh<TVertex>::* _meshFormatToLoadFunc[])(dsk::IStream*, std::vector<TSourceVertex>&, std::vector<uint32_t>&) = {
+				&Mesh<TVertex>::_createFromObj
+			};
+			static bool _extensionToMeshFormat(const std::filesystem::path& extension, MeshFormat& format);
+
+			spl::VertexArray _vao;
+			spl::VertexArray _positionVao;
+			spl::Buffer _vbo;
+			spl::Buffer _positionVbo;
+			spl::Buffer _ebo;
+
+			uint32_t _vertexCount;
+			spl::IndexType _indexType;
+	};
+}
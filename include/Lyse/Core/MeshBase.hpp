@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/CoreTypes.hpp>
+
+namespace lys
+{
+	struct MeshLod
+	{
+		uint32_t indexOffset;
+		uint32_t indexCount;
+		float error;			// Geometric error of the simplification, relative to the bounding sphere radius
+	};
+
+	// Cluster of neighbouring triangles, culled as a whole. The cluster is back-facing for every point of view `eye` such
+	// that `dot(center - eye, coneAxis) >= coneCutoff * length(center - eye) + radius`.
+
+	struct Meshlet
+	{
+		uint32_t indexOffset;
+		uint32_t indexCount;
+		scp::f32vec3 center;
+		float radius;
+		scp::f32vec3 coneAxis;
+		float coneCutoff;
+	};
+
+	class LYS_API MeshBase : public Drawable
+	{
+		public:
+
+			void setNormalMap(const spl::Texture2D* texture);
+			void setBoundingBox(const scp::f32vec3& min, const scp::f32vec3& max);
+			void setMeshlets(const Meshlet* meshlets, uint32_t count);
+			void setOccluderGeometry(const scp::f32vec3* positions, const uint32_t* indices, uint32_t indexCount);
+			void setIsOccluder(bool isOccluder);
+
+			virtual DrawableType getType() const override final;
+			const spl::Texture2D* getNormalMap() const;
+			const scp::f32vec3& getBoundingBoxMin() const;
+			const scp::f32vec3& getBoundingBoxMax() const;
+			const std::vector<MeshLod>& getLods() const;
+			const std::vector<Meshlet>& getMeshlets() const;
+			const std::vector<scp::f32vec3>& getOccluderPositions() const;
+			const std::vector<uint32_t>& getOccluderIndices() const;
+			bool isOccluder() const;
+
+		protected:
+
+			MeshBase();
+			MeshBase(const MeshBase& mesh) = default;
+			MeshBase(MeshBase&& mesh) = default;
+
+			MeshBase& operator=(const MeshBase& mesh) = default;
+			MeshBase& operator=(MeshBase&& mesh) = default;
+
+			virtual void _drawRanges(uint32_t vertexInputMask, const uint32_t* offsets, const uint32_t* counts, uint32_t rangeCount) const = 0;
+
+			// Draw commands are read from the buffers bound to `DrawIndirect` and `Parameter`, offsets are in bytes
+			virtual void _drawIndirect(uint32_t vertexInputMask, uint64_t commandOffset, uint32_t commandCount) const = 0;
+			virtual void _drawIndirectCount(uint32_t vertexInputMask, uint64_t commandOffset, uint64_t countOffset, uint32_t maxCommandCount) const = 0;
+
+			virtual void _updateWorldBoundingBox() const override;
+
+			virtual ~MeshBase() override = default;
+
+			const spl::Texture2D* _normalMap;
+
+			// For compact vertex formats, positions are quantized against the bounding box
+			scp::f32vec3 _boundingBoxMin;
+			scp::f32vec3 _boundingBoxMax;
+			bool _compactVertices;
+
+			// Index ranges of the levels of detail in the element buffer, from the finest to the coarsest
+			std::vector<MeshLod> _lods;
+
+			// Clusters of the finest LOD, for culling
+			std::vector<Meshlet> _meshlets;
+
+			// Coarse copy of the geometry rasterized on the CPU when the mesh is flagged as an occluder
+			std::vector<scp::f32vec3> _occluderPositions;
+			std::vector<uint32_t> _occluderIndices;
+			bool _isOccluder;
+
+		friend class CommandBuffer;
+		friend class Scene;
+	};
+}
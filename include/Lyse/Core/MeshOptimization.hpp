@@ -0,0 +1,57 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/CoreTypes.hpp>
+
+namespace lys
+{
+	namespace _lys
+	{
+		template<CVertex TVertex> std::vector<scp::f32vec3> extractPositions(const TVertex* vertices, uint32_t vertexCount);
+	}
+
+	constexpr uint32_t defaultVertexCacheSize = 16;
+	constexpr float defaultOverdrawThreshold = 1.05f;
+	constexpr uint32_t defaultMaxLodCount = 5;
+	constexpr uint32_t defaultMeshletMaxVertexCount = 64;
+	constexpr uint32_t defaultMeshletMaxTriangleCount = 124;
+
+	// Reorder triangles for post-transform vertex cache locality (Tipsify)
+	LYS_API void optimizeVertexCache(uint32_t* indices, uint32_t indexCount, uint32_t vertexCount, uint32_t cacheSize = defaultVertexCacheSize);
+
+	// Reorder clusters of triangles, drawing first those facing outward so that early-Z rejects more fragments. The
+	// triangles must already be optimized for the vertex cache. `threshold` is the vertex cache efficiency that can be
+	// traded for less overdraw (1.05 means at most 5% more cache misses).
+	LYS_API void optimizeOverdraw(uint32_t* indices, uint32_t indexCount, const scp::f32vec3* positions, uint32_t vertexCount, float threshold = defaultOverdrawThreshold, uint32_t cacheSize = defaultVertexCacheSize);
+	template<CVertex TVertex> void optimizeOverdraw(uint32_t* indices, uint32_t indexCount, const TVertex* vertices, uint32_t vertexCount, float threshold = defaultOverdrawThreshold, uint32_t cacheSize = defaultVertexCacheSize);
+
+	// Reorder vertices in their order of first use and remove unused ones. Returns the new vertex count.
+	LYS_API uint32_t computeVertexFetchRemap(const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount, uint32_t* remap);
+	template<CVertex TVertex> uint32_t optimizeVertexFetch(TVertex* vertices, uint32_t vertexCount, uint32_t* indices, uint32_t indexCount);
+
+	// All of the above in order. Returns the new vertex count.
+	template<CVertex TVertex> uint32_t optimizeMesh(TVertex* vertices, uint32_t vertexCount, uint32_t* indices, uint32_t indexCount);
+
+	// Quadric error edge collapse, without creating vertices so that the result can share the vertex buffer of the
+	// original mesh. Borders and attribute seams are kept. Stops when the index count falls under `targetIndexCount` or
+	// when the error would exceed `targetError` (relative to the bounding sphere radius). Returns the new index count
+	// and the error reached in `error`.
+	LYS_API uint32_t simplifyMesh(const uint32_t* indices, uint32_t indexCount, const scp::f32vec3* positions, uint32_t vertexCount, uint32_t targetIndexCount, float targetError, uint32_t* simplifiedIndices, float& error);
+	template<CVertex TVertex> uint32_t simplifyMesh(const uint32_t* indices, uint32_t indexCount, const TVertex* vertices, uint32_t vertexCount, uint32_t targetIndexCount, float targetError, uint32_t* simplifiedIndices, float& error);
+
+	// LOD 0 is the original mesh, each following LOD halves the triangle count until `maxLodCount` LODs are generated
+	// or the simplification stalls. The indices of all LODs are concatenated in `lodIndices`.
+	LYS_API void generateLodChain(const uint32_t* indices, uint32_t indexCount, const scp::f32vec3* positions, uint32_t vertexCount, std::vector<uint32_t>& lodIndices, std::vector<MeshLod>& lods, uint32_t maxLodCount = defaultMaxLodCount);
+	// Split consecutive triangles in meshlets (the index buffer should be optimized for the vertex cache first) and
+	// compute their bounding sphere and normal cone.
+	LYS_API void buildMeshlets(const uint32_t* indices, uint32_t indexCount, const scp::f32vec3* positions, uint32_t vertexCount, std::vector<Meshlet>& meshlets, uint32_t maxVertexCount = defaultMeshletMaxVertexCount, uint32_t maxTriangleCount = defaultMeshletMaxTriangleCount);
+	template<CVertex TVertex> void buildMeshlets(const uint32_t* indices, uint32_t indexCount, const TVertex* vertices, uint32_t vertexCount, std::vector<Meshlet>& meshlets, uint32_t maxVertexCount = defaultMeshletMaxVertexCount, uint32_t maxTriangleCount = defaultMeshletMaxTriangleCount);
+
+	template<CVertex TVertex> void generateLodChain(const uint32_t* indices, uint32_t indexCount, const TVertex* vertices, uint32_t vertexCount, std::vector<uint32_t>& lodIndices, std::vector<MeshLod>& lods, uint32_t maxLodCount = defaultMaxLodCount);
+}
@@ -0,0 +1,56 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/CoreTypes.hpp>
+
+namespace lys
+{
+	// Low resolution depth buffer in which occluders are rasterized on the CPU, to test bounding boxes for occlusion in
+	// the same frame. Depths are NDC depths, linear in screen-space for perspective and orthographic projections alike.
+	// Occluders are rasterized conservatively, only the pixels they fully cover are written, with their farthest depth.
+	// The rows can be rasterized by several threads at once, as long as their ranges do not overlap.
+
+	class LYS_API OcclusionBuffer
+	{
+		public:
+
+			OcclusionBuffer();
+			OcclusionBuffer(const OcclusionBuffer& buffer) = default;
+			OcclusionBuffer(OcclusionBuffer&& buffer) = default;
+
+			OcclusionBuffer& operator=(const OcclusionBuffer& buffer) = default;
+			OcclusionBuffer& operator=(OcclusionBuffer&& buffer) = default;
+
+
+			void clear(const scp::u32vec2& resolution, const CameraBase* camera);
+			void rasterize(const scp::f32vec3* positions, const uint32_t* indices, uint32_t indexCount, const scp::f32mat4x4& model, uint32_t rowBegin, uint32_t rowEnd);
+			void updateTiles();
+
+			bool isBoxOccluded(const scp::f32vec3& min, const scp::f32vec3& max, const scp::f32mat4x4& model) const;
+
+			const scp::u32vec2& getResolution() const;
+			const float* getDepths() const;
+
+
+			~OcclusionBuffer() = default;
+
+			static constexpr uint32_t tileSize = 8;
+
+		private:
+
+			std::vector<float> _depths;
+			std::vector<float> _tileDepths;		// Max of the depths of each tile of `tileSize` x `tileSize` pixels
+			scp::u32vec2 _resolution;
+			scp::u32vec2 _tileResolution;
+
+			scp::f32mat4x4 _view;
+			scp::f32mat4x4 _projection;
+			float _near;
+	};
+}
@@ -1,152 +1,323 @@
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//! \file
-//! \author Reiex
-//! \copyright The MIT License (MIT)
-//! \date 2023
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-#include <Lyse/Core/CoreTypes.hpp>
-
-namespace lys
-{
-	struct SceneParameters
-	{
-		spl::TextureInternalFormat depthTextureFormat = spl::TextureInternalFormat::Depth_f32;
-		spl::TextureInternalFormat colorTextureFormat = spl::TextureInternalFormat::RGB_nu16;
-		spl::TextureInternalFormat materialTextureFormat = spl::TextureInternalFormat::RGB_nu16;
-		spl::TextureInternalFormat normalTextureFormat = spl::TextureInternalFormat::RGB_ni16;
-		spl::TextureInternalFormat tangentTextureFormat = spl::TextureInternalFormat::RGB_ni16;
-
-		bool shadowEnabled = true;
-		uint32_t shadowTextureCount = 16;
-		scp::u32vec2 shadowTextureResolution = { 2048, 2048 };
-		spl::TextureInternalFormat shadowTextureFormat = spl::TextureInternalFormat::Depth_nu16;
-
-		bool transparencyEnabled = true;
-		spl::TextureInternalFormat transparencyColorTextureFormat = spl::TextureInternalFormat::RGBA_f32;
-		spl::TextureInternalFormat transparencyCounterTextureFormat = spl::TextureInternalFormat::R_f32;
-
-		bool ssaoEnabled = true;
-		uint32_t ssaoSampleCount = 16;
-		spl::TextureInternalFormat ssaoTextureFormat = spl::TextureInternalFormat::R_nu16;
-
-		uint32_t lightSlotCount = 128;
-		spl::TextureInternalFormat renderTextureFormat = spl::TextureInternalFormat::RGB_nu16;
-
-
-		static constexpr uint32_t maxShadowTextureCount = 1024;
-		static constexpr uint32_t maxLightSlotCount = 1024;
-	};
-
-	class LYS_API Scene
-	{
-		public:
-	
-			Scene(uint32_t width, uint32_t height, const SceneParameters params = {});
-			Scene(const Scene& scene) = delete;
-			Scene(Scene&& scene) = delete;
-	
-			Scene& operator=(const Scene& scene) = delete;
-			Scene& operator=(Scene&& scene) = delete;
-	
-			
-			void resize(uint32_t width, uint32_t height);
-
-
-			void setBackgroundFlatColor(float red, float green, float blue);
-			void setBackgroundEquirectangular(const spl::Texture2D* texture);
-			void setBackgroundCubemap(const spl::Texture* texture);	// TODO : Change that when there is a "TextureCubeMap" class in SPL
-
-			void setCamera(const CameraBase* camera);
-
-			void addLight(const LightBase* light);
-			void removeLight(const LightBase* light);
-
-			void addDrawable(const Drawable* drawable);
-			void removeDrawable(const Drawable* drawable);
-	
-
-			void render();
-
-
-			const spl::Texture2D& getDepthTexture() const;
-			const spl::Texture2D& getColorTexture() const;
-			const spl::Texture2D& getMaterialTexture() const;
-			const spl::Texture2D& getNormalTexture() const;
-			const spl::Texture2D& getTangentTexture() const;
-
-			const spl::Texture& getShadowTexture() const;
-
-			const spl::Texture2D& getTransparencyColorTexture() const;
-			const spl::Texture2D& getTransparencyCounterTexture() const;
-
-			const spl::Texture2D& getSsaoTexture() const;
-
-			const spl::Texture2D& getRenderTexture() const;
-
-
-			~Scene();
-
-		private:
-
-			void _loadShaders();
-
-			const void _updateAndBindUboLights(uint32_t index, std::vector<const CameraBase*>& shadowCameras);
-			const void _updateAndBindUboDrawable(uint32_t index, const CameraBase* camera, const Drawable* drawable);
-			const void _updateAndBindUboShadowCameras(uint32_t index, const std::vector<const CameraBase*>& shadowCameras);
-			void _insertInDrawSequence(void* pDrawSequence, const Drawable* drawable, ShaderType shaderType) const;
-
-			void _setDrawableUniforms(const spl::ShaderProgram* shader, const shaderInterface::SubInterfaceDrawable* interface, const Drawable* drawable);
-			void _setGBufferResultUniforms(const spl::ShaderProgram* shader, const shaderInterface::SubInterfaceGBufferResult* interface);
-			void _setShadowResultUniforms(const spl::ShaderProgram* shader, const shaderInterface::SubInterfaceShadowResult* interface);
-			void _setTransparencyResultUniforms(const spl::ShaderProgram* shader, const shaderInterface::SubInterfaceTransparencyResult* interface);
-			void _setSsaoResultUniforms(const spl::ShaderProgram* shader, const shaderInterface::SubInterfaceSsaoResult* interface);
-
-			spl::VertexArray _screenVao;
-			spl::Buffer _screenVbo;
-
-
-			scp::u32vec2 _resolution;
-			SceneParameters _params;
-
-
-			std::vector<spl::ShaderProgram*> _shaders;
-			std::unordered_map<DrawableType, std::vector<ShaderSet>> _shaderMap;
-
-
-			scp::f32vec3 _clearColor;
-			const spl::Texture* _background;
-
-			const CameraBase* _camera;
-
-			std::unordered_set<const LightBase*> _lights;
-			spl::Buffer _uboLights;
-
-			std::unordered_set<const Drawable*> _drawables;
-			spl::Buffer _uboDrawable;
-
-
-			spl::Texture2D _depthTexture;
-			spl::Texture2D _colorTexture;
-			spl::Texture2D _materialTexture;
-			spl::Texture2D _normalTexture;
-			spl::Texture2D _tangentTexture;
-			spl::Framebuffer _gBufferFramebuffer;
-
-			spl::Texture _shadowTexture;
-			spl::Framebuffer _shadowMappingFramebuffer;
-			spl::Buffer _uboShadowCameras;
-
-			spl::Texture2D _transparencyColorTexture;
-			spl::Texture2D _transparencyCounterTexture;
-			spl::Framebuffer _transparencyFramebuffer;
-
-			spl::Texture2D _ssaoTexture;
-			spl::Framebuffer _ssaoFramebuffer;
-
-			spl::Texture2D _mergeTexture;
-			spl::Framebuffer _mergeFramebuffer;
-	};
-}
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/CoreTypes.hpp>
+
+namespace lys
+{
+	struct SceneParameters
+	{
+		spl::TextureInternalFormat depthTextureFormat = spl::TextureInternalFormat::Depth_f32;
+		spl::TextureInternalFormat colorTextureFormat = spl::TextureInternalFormat::RGB_nu16;
+		spl::TextureInternalFormat materialTextureFormat = spl::TextureInternalFormat::RGB_nu16;
+		spl::TextureInternalFormat normalTextureFormat = spl::TextureInternalFormat::RGB_ni16;
+		spl::TextureInternalFormat tangentTextureFormat = spl::TextureInternalFormat::RGB_ni16;
+
+		bool shadowEnabled = true;
+		uint32_t shadowTextureCount = 16;
+		scp::u32vec2 shadowTextureResolution = { 2048, 2048 };
+		spl::TextureInternalFormat shadowTextureFormat = spl::TextureInternalFormat::Depth_nu16;
+
+		bool transparencyEnabled = true;
+		spl::TextureInternalFormat transparencyColorTextureFormat = spl::TextureInternalFormat::RGBA_f32;
+		spl::TextureInternalFormat transparencyCounterTextureFormat = spl::TextureInternalFormat::R_f32;
+
+		bool ssaoEnabled = true;
+		uint32_t ssaoSampleCount = 16;
+		spl::TextureInternalFormat ssaoTextureFormat = spl::TextureInternalFormat::R_nu16;
+
+		bool lodEnabled = false;
+		float lodErrorThreshold = 1.f;		// Maximum screen-space error of a LOD, in pixels
+		uint32_t shadowLodBias = 1;			// Shadow maps use LODs that much coarser than their cameras would select
+
+		bool frustumCullingEnabled = true;
+		bool clusterCullingEnabled = true;	// Frustum and back-face culling of the meshlets of the finest LOD
+		bool occlusionCullingEnabled = true;
+		uint32_t occlusionCullingResolution = 256;	// Maximum size of the depth pyramid level read back for occlusion tests
+		bool softwareOcclusionCullingEnabled = true;	// Same-frame occlusion culling by the meshes flagged as occluders, rasterized on the CPU
+		scp::u32vec2 softwareOcclusionResolution = { 256, 128 };
+		uint32_t softwareOcclusionBandCount = 4;	// Rows of the occlusion buffer are rasterized by that many jobs
+		bool gpuDrivenEnabled = false;		// Culling and LOD selection of the meshes in a compute shader, drawn from indirect commands
+		uint32_t bvhRebuildPeriod = 120;	// Frames between two rebuilds of the BVH of the drawables, when some moved in the meantime
+
+		bool materialTextureArraysEnabled = false;	// Material textures of the same size and format are copied into texture arrays, without mipmaps
+
+		uint32_t lightSlotCount = 128;
+		uint32_t shaderLinkBudget = 4;	// Shader variants first needed by a frame linked by each `submit`, their draws use the variant without textures and the screen passes the generic program until then
+		std::filesystem::path shaderCacheDirectory;	// Linked programs are saved there and loaded back by the scenes with the same parameters and driver, empty to disable
+		spl::TextureInternalFormat renderTextureFormat = spl::TextureInternalFormat::RGB_nu16;
+
+		bool contextStateRestored = true;	// `submit` saves the whole context state and restores it, so that it appears unchanged
+
+
+		static constexpr uint32_t maxShadowTextureCount = 1024;
+		static constexpr uint32_t maxLightSlotCount = 1024;
+	};
+
+	class LYS_API Scene
+	{
+		public:
+	
+			Scene(uint32_t width, uint32_t height, const SceneParameters params = {});
+			Scene(const Scene& scene) = delete;
+			Scene(Scene&& scene) = delete;
+	
+			Scene& operator=(const Scene& scene) = delete;
+			Scene& operator=(Scene&& scene) = delete;
+	
+			
+			void resize(uint32_t width, uint32_t height);
+
+
+			void setBackgroundFlatColor(float red, float green, float blue);
+			void setBackgroundEquirectangular(const spl::Texture2D* texture);
+			void setBackgroundCubemap(const spl::Texture* texture);	// TODO : Change that when there is a "TextureCubeMap" class in SPL
+
+			void setCamera(const CameraBase* camera);
+
+			void addLight(const LightBase* light);
+			void removeLight(const LightBase* light);
+
+			void addDrawable(const Drawable* drawable);
+			void removeDrawable(const Drawable* drawable);
+
+			// Meshes whose world bounding box intersects the volume, other drawables have no bounds and are never returned.
+			// The queries read the BVH as of the last `prepare`, they can run with `submit` but not with `prepare`.
+			void queryFrustum(const Frustum& frustum, std::vector<const Drawable*>& drawables) const;
+			void querySphere(const scp::f32vec3& center, float radius, std::vector<const Drawable*>& drawables) const;
+			void queryBox(const scp::f32vec3& min, const scp::f32vec3& max, std::vector<const Drawable*>& drawables) const;
+			void queryRay(const scp::f32vec3& origin, const scp::f32vec3& direction, float maxDistance, std::vector<const Drawable*>& drawables) const;	// Sorted by distance
+	
+
+			// `prepare` does the CPU work of a frame (culling, sorting, matrices, lights and shadow cameras) and can run
+			// on any thread, `submit` only issues the GL commands of the last prepared frame on the context thread. The
+			// frames are double-buffered: the next frame can be prepared, and the scene edited, while one is submitted.
+			// Lights and material parameters are copied into the frame, but drawables are not: `submit` draws the
+			// meshes of the frame through their pointers. A drawable removed from the scene, or a child removed from a
+			// group of the scene (destroying it removes it), must stay alive, and keep its GL objects, until the first
+			// `submit` that starts after its removal has returned.
+			void prepare();
+			void submit();
+			void render();	// `prepare` then `submit`, asserts that a steady frame does not allocate with `LYSE_COUNT_ALLOCATIONS`
+
+
+			const spl::Texture2D& getDepthTexture() const;
+			const spl::Texture2D& getColorTexture() const;
+			const spl::Texture2D& getMaterialTexture() const;
+			const spl::Texture2D& getNormalTexture() const;
+			const spl::Texture2D& getTangentTexture() const;
+
+			const spl::Texture& getShadowTexture() const;
+
+			const spl::Texture2D& getTransparencyColorTexture() const;
+			const spl::Texture2D& getTransparencyCounterTexture() const;
+
+			const spl::Texture2D& getSsaoTexture() const;
+
+			const spl::Texture2D& getRenderTexture() const;
+
+
+			~Scene();
+
+		private:
+
+			struct BvhLeaf
+			{
+				uint32_t leaf;
+				uint32_t boundingBoxVersion;
+			};
+
+			// Copy of the depth pyramid level read back, consumed on the CPU once its fence is signaled
+
+			struct DepthPyramidReadback
+			{
+				spl::Buffer buffer;
+				spl::Fence fence;
+				bool pending;
+				scp::f32mat4x4 view;
+				scp::f32mat4x4 projection;
+				float near;
+				float far;
+			};
+
+			// Defined with the UBO layouts they hold
+
+			struct FrameDraw;
+			struct FramePacket;
+			struct GpuDrawableLayout;
+			struct MaterialTable;
+			struct ShaderLibrary;
+
+			void _loadShaders();
+			void _buildShaderLibrary(ShaderLibrary& library) const;
+			uint32_t _specializeShader(uint32_t index, uint32_t key);	// Called with the mutex of the shader library locked
+			void _compileShaderModule(uint32_t index);	// Called with the mutex of the shader library locked
+			void _linkShader(uint32_t index);	// Called with the mutex of the shader library locked
+			void _linkRequestedShaders();
+
+			void _prepareLights(FramePacket& packet, FrameVector<const CameraBase*>& shadowCameras) const;
+			void _prepareDraws(FramePacket& packet, const FrameVector<std::pair<const ShaderSet*, uint32_t>>& drawSequence, ShaderType shaderType, const uint32_t* lods, std::vector<FrameDraw>& draws) const;	// `lods` per registry entry, `nullptr` to select them for the camera
+			void _prepareGpuDrawables(FramePacket& packet);
+			void _buildMaterialTable();
+			void _updateAndBindUbos(const FramePacket& packet);
+			void _uploadMaterials(const FramePacket& packet);
+			void _updateMaterialTextureArrays(const MaterialTable& table);
+			const ShaderSet* _getShaderSet(uint32_t entry, ShaderType shaderType, uint32_t lightTypes);
+			void _buildDrawSequence(const FrameVector<uint32_t>& entries, ShaderType shaderType, uint32_t lightTypes, FrameVector<std::pair<const ShaderSet*, uint32_t>>& drawSequence);
+			uint32_t _selectLod(uint32_t entry, const CameraBase* camera, uint32_t height, uint32_t bias) const;	// `height` of the target in pixels
+			bool _cullMeshlets(uint32_t entry, uint32_t lod, const Frustum& frustum, std::vector<uint32_t>& rangeOffsets, std::vector<uint32_t>& rangeCounts) const;
+			template<typename TFilter> void _recordDraws(const FramePacket& packet, const std::vector<FrameDraw>& draws, ShaderType shaderType, std::vector<CommandBuffer>& commandBuffers, const TFilter& filter);
+			void _recordDraw(CommandBuffer& commands, const FramePacket& packet, const FrameDraw& draw, ShaderType shaderType, const spl::ShaderProgram*& currentShader);
+			bool _isOccluded(const FrameDraw& draw) const;
+			void _buildDepthPyramid(spl::Context* context);
+			void _requestDepthPyramidReadback(const FramePacket& packet);
+			void _readDepthPyramid();
+			void _uploadGpuDrawables(const FramePacket& packet);
+			void _dispatchCulling(uint32_t phase, const FramePacket& packet);
+			void _drawGpuDrawable(CommandBuffer& commands, const FramePacket& packet, const FrameDraw& draw, uint32_t vertexInputMask, ShaderType shaderType) const;
+			void _rasterizeOccluders(const FrameVector<uint32_t>& entries);
+			bool _isHiddenByOccluders(uint32_t entry) const;
+			void _registerInBvh(const Drawable* drawable);
+			void _appendToRegistry(const Drawable* drawable, std::vector<const Drawable*>& drawables, std::vector<uint32_t>& subtreeEnds) const;
+			bool _syncRegistry();
+			bool _hasHierarchyChanged() const;
+			void _updateDrawables();
+			void _collectDrawables(const Frustum& frustum, FrameVector<uint32_t>& entries) const;
+			template<typename TOverlap, typename TEntries> void _collectEntries(uint32_t root, const TOverlap& overlaps, TEntries& entries) const;
+			template<typename TOverlap> void _queryEntries(const std::vector<const Drawable*>& roots, const TOverlap& overlaps, std::vector<const Drawable*>& drawables) const;
+
+			void _setDrawableUniforms(CommandBuffer& commands, const shaderInterface::SubInterfaceDrawable* interface, const FramePacket& packet, const FrameDraw& draw) const;
+			void _setGBufferResultUniforms(CommandBuffer& commands, const shaderInterface::SubInterfaceGBufferResult* interface) const;
+			void _setShadowResultUniforms(CommandBuffer& commands, const shaderInterface::SubInterfaceShadowResult* interface) const;
+			void _setTransparencyResultUniforms(CommandBuffer& commands, const shaderInterface::SubInterfaceTransparencyResult* interface) const;
+			void _setSsaoResultUniforms(CommandBuffer& commands, const shaderInterface::SubInterfaceSsaoResult* interface) const;
+
+			spl::VertexArray _screenVao;
+			spl::Buffer _screenVbo;
+
+
+			scp::u32vec2 _resolution;
+			SceneParameters _params;
+
+
+			std::shared_ptr<ShaderLibrary> _shaderLibrary;	// Shared with the scenes of the context with the same shader header
+
+
+			scp::f32vec3 _clearColor;
+			const spl::Texture* _background;
+
+			const CameraBase* _camera;
+			spl::Buffer _uboCamera;
+
+			std::unordered_set<const LightBase*> _lights;
+			spl::Buffer _uboLights;
+
+			std::unordered_set<const Drawable*> _drawables;
+			spl::Buffer _uboDrawable;
+
+			// Commands of the passes, recorded by buckets of draws on the job system and executed on the context thread
+
+			std::vector<CommandBuffer> _gBufferCommands;
+			std::vector<CommandBuffer> _occludedCommands;
+			std::vector<CommandBuffer> _shadowCommands;
+			std::vector<CommandBuffer> _transparencyCommands;
+			CommandBuffer _screenCommands;
+			std::vector<uint8_t> _occludedDraws;	// Per G-Buffer draw of the frame, whether it was occluded in the first phase
+			StateCache _stateCache;
+
+			// Frames prepared on the CPU, one can be prepared while the other is submitted
+
+			std::array<std::unique_ptr<FramePacket>, 2> _packets;
+			std::mutex _packetMutex;
+			uint32_t _readyPacket;		// Prepared and not submitted yet, UINT32_MAX if none
+			uint32_t _submittedPacket;	// Being submitted, UINT32_MAX if none
+
+			// Transient containers of `prepare`, released at the start of the next one
+
+			FrameArena _frameArena;
+			bool _drawablesChanged;		// Rebuilt, refit, or changed state or material in the last `_updateDrawables`
+
+			#ifdef LYSE_COUNT_ALLOCATIONS
+				uint64_t _frameHash;		// Of the camera and lights of the last prepared frame
+				uint32_t _steadyFrameCount;	// Prepared frames since the scene last changed
+			#endif
+
+			// Materials of the registry in a shader storage buffer, indexed by the drawable data of the draws. The table
+			// is shared by the frames prepared with it, it is built again when a material is edited.
+			std::shared_ptr<const MaterialTable> _materialTable;
+			std::shared_ptr<const MaterialTable> _materialBufferTable;
+			bool _materialsDirty;
+			spl::Buffer _ssboMaterials;
+			std::vector<spl::Texture*> _materialTextureArrays;
+			std::vector<std::vector<const spl::Texture2D*>> _materialTextureArrayLayers;	// Textures copied in each array
+
+			// Meshes culled and drawn by the GPU, the index of a mesh is its slot in the shader storage buffers. The
+			// layout is shared by the frames prepared with it, the buffers are created again when it changes.
+			std::shared_ptr<const GpuDrawableLayout> _gpuDrawableLayout;
+			std::shared_ptr<const GpuDrawableLayout> _gpuBufferLayout;
+			std::vector<uint32_t> _gpuDrawableIndices;	// Per registry entry, `UINT32_MAX` if not GPU-driven
+			bool _gpuDrawablesDirty;
+			spl::Buffer _ssboDrawables;
+			spl::Buffer _ssboDrawablesCulling;
+			spl::Buffer _ssboLods;
+			spl::Buffer _ssboMeshlets;
+			spl::Buffer _ssboCommands;
+			spl::Buffer _ssboCounts;
+			spl::Buffer _ssboVisibility;
+			spl::Buffer _uboCulling;
+
+
+			std::vector<spl::Texture2D*> _depthPyramidTextures;
+			std::vector<spl::Framebuffer*> _depthPyramidFramebuffers;
+			std::vector<float> _depthPyramidReadback;
+			std::array<DepthPyramidReadback, 3> _depthPyramidReadbacks;	// Ring of readbacks, the oldest pending comes first
+			uint32_t _depthPyramidReadbackIndex;						// Next readback requested
+			uint32_t _depthPyramidReadbackLevel;						// Level of the texture read back
+			CameraBase::UboCameraData _depthPyramidCamera;				// Camera of the pyramid in the textures
+			bool _depthPyramidBuilt;
+			DepthPyramid _depthPyramid;									// Latest pyramid whose readback completed
+
+			// Roots of the scene in a BVH of their world bounding boxes, refit when they move
+
+			Bvh _bvh;
+			std::unordered_map<const Drawable*, BvhLeaf> _bvhLeaves;
+			std::vector<const Drawable*> _unboundedDrawables;
+			bool _bvhDirty;
+			bool _bvhRefit;
+			uint32_t _bvhFramesSinceRebuild;
+
+			// Copy of the drawables in depth-first order, the render passes only work on entry indices
+
+			DrawableRegistry _registry;
+
+			std::vector<const MeshBase*> _occluders;
+			OcclusionBuffer _occlusionBuffer;
+
+			spl::Texture2D _depthTexture;
+			spl::Texture2D _colorTexture;
+			spl::Texture2D _materialTexture;
+			spl::Texture2D _normalTexture;
+			spl::Texture2D _tangentTexture;
+			spl::Framebuffer _gBufferFramebuffer;
+
+			spl::Texture _shadowTexture;
+			spl::Framebuffer _shadowMappingFramebuffer;
+			spl::Buffer _uboShadowCameras;
+
+			spl::Texture2D _transparencyColorTexture;
+			spl::Texture2D _transparencyCounterTexture;
+			spl::Framebuffer _transparencyFramebuffer;
+
+			spl::Texture2D _ssaoTexture;
+			spl::Framebuffer _ssaoFramebuffer;
+
+			spl::Texture2D _mergeTexture;
+			spl::Framebuffer _mergeFramebuffer;
+	};
+}
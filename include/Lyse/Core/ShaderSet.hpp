@@ -1,103 +1,146 @@
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//! \file
-//! \author Reiex
-//! \copyright The MIT License (MIT)
-//! \date 2023
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-#include <Lyse/Core/CoreTypes.hpp>
-
-namespace lys
-{
-	enum class ShaderType
-	{
-		GBuffer,
-		ShadowMapping,
-		Transparency
-	};
-
-	namespace shaderInterface
-	{
-		struct SubInterfaceDrawable
-		{
-			spl::GlslType color = spl::GlslType::Undefined;
-			spl::GlslType material = spl::GlslType::Undefined;
-
-			spl::GlslType normal = spl::GlslType::Undefined;
-		};
-
-		struct SubInterfaceGBufferResult
-		{
-			spl::GlslType depth = spl::GlslType::Undefined;
-			spl::GlslType color = spl::GlslType::Undefined;
-			spl::GlslType material = spl::GlslType::Undefined;
-			spl::GlslType normal = spl::GlslType::Undefined;
-			spl::GlslType tangent = spl::GlslType::Undefined;
-		};
-
-		struct SubInterfaceShadowResult
-		{
-			spl::GlslType texture = spl::GlslType::Undefined;
-			spl::GlslType offset = spl::GlslType::Undefined;
-		};
-
-		struct SubInterfaceTransparencyResult
-		{
-			spl::GlslType color = spl::GlslType::Undefined;
-			spl::GlslType counter = spl::GlslType::Undefined;
-		};
-
-		struct SubInterfaceSsaoResult
-		{
-			spl::GlslType texture = spl::GlslType::Undefined;
-		};
-
-		struct InterfaceGBuffer
-		{
-			SubInterfaceDrawable u_drawable = {};
-		};
-
-		struct InterfaceShadow
-		{
-			SubInterfaceDrawable u_drawable = {};
-			SubInterfaceGBufferResult u_gBuffer = {};
-		};
-
-		struct InterfaceTransparency
-		{
-			SubInterfaceDrawable u_drawable = {};
-			SubInterfaceGBufferResult u_gBuffer = {};
-			SubInterfaceShadowResult u_shadow = {};
-		};
-	}
-
-	class LYS_API ShaderSet
-	{
-		public:
-
-			ShaderSet(const spl::ShaderProgram* shaderGBuffer, const spl::ShaderProgram* shaderShadow, const spl::ShaderProgram* shaderTransparency);
-			ShaderSet(const ShaderSet& set) = default;
-			ShaderSet(ShaderSet&& set) = default;
-
-			ShaderSet& operator=(const ShaderSet& set) = default;
-			ShaderSet& operator=(ShaderSet&& set) = default;
-
-			~ShaderSet() = default;
-
-		private:
-
-			static void fillInterface(const spl::ShaderProgram* shader, const std::unordered_map<std::string, intptr_t>& offsets, void* pInterface);
-
-			const spl::ShaderProgram* _shaderGBuffer;
-			const spl::ShaderProgram* _shaderShadow;
-			const spl::ShaderProgram* _shaderTransparency;
-
-			shaderInterface::InterfaceGBuffer _interfaceGBuffer;
-			shaderInterface::InterfaceShadow _interfaceShadow;
-			shaderInterface::InterfaceTransparency _interfaceTransparency;
-
-		friend class Scene;
-	};
-}
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/CoreTypes.hpp>
+
+namespace lys
+{
+	enum class ShaderType
+	{
+		GBuffer,
+		ShadowMapping,
+		Transparency
+	};
+
+	namespace shaderInterface
+	{
+		// Type of an active uniform, and where it is set. The location is resolved once when the interface is filled,
+		// and samplers get a fixed texture unit, so that the draws never look a uniform up by name.
+
+		struct Uniform
+		{
+			spl::GlslType type = spl::GlslType::Undefined;
+			int32_t location = -1;
+			uint32_t unit = 0;
+		};
+
+		struct SubInterfaceDrawable
+		{
+			Uniform color = {};
+			Uniform material = {};
+
+			Uniform normal = {};
+		};
+
+		struct SubInterfaceGBufferResult
+		{
+			Uniform depth = {};
+			Uniform color = {};
+			Uniform material = {};
+			Uniform normal = {};
+			Uniform tangent = {};
+		};
+
+		struct SubInterfaceShadowResult
+		{
+			Uniform texture = {};
+			Uniform offset = {};
+		};
+
+		struct SubInterfaceTransparencyResult
+		{
+			Uniform color = {};
+			Uniform counter = {};
+		};
+
+		struct SubInterfaceSsaoResult
+		{
+			Uniform texture = {};
+		};
+
+		struct InterfaceGBuffer
+		{
+			uint32_t vertexInputMask = 0;
+			SubInterfaceDrawable u_drawable = {};
+		};
+
+		struct InterfaceShadow
+		{
+			uint32_t vertexInputMask = 0;
+			SubInterfaceDrawable u_drawable = {};
+			SubInterfaceGBufferResult u_gBuffer = {};
+		};
+
+		struct InterfaceTransparency
+		{
+			uint32_t vertexInputMask = 0;
+			SubInterfaceDrawable u_drawable = {};
+			SubInterfaceGBufferResult u_gBuffer = {};
+			SubInterfaceShadowResult u_shadow = {};
+		};
+
+		// Screen passes of the scene
+
+		struct InterfaceSsao
+		{
+			SubInterfaceGBufferResult u_gBuffer = {};
+			Uniform u_sampleCount = {};
+			Uniform u_scaleStep = {};
+			Uniform u_tanHalfFov = {};
+			Uniform u_twoTanHalfFov = {};
+			Uniform u_resolution = {};
+		};
+
+		struct InterfaceMerge
+		{
+			SubInterfaceGBufferResult u_gBuffer = {};
+			SubInterfaceShadowResult u_shadow = {};
+			SubInterfaceTransparencyResult u_transparency = {};
+			SubInterfaceSsaoResult u_ssao = {};
+			Uniform u_background = {};
+			Uniform u_twoTanHalfFov = {};
+		};
+	}
+
+	class LYS_API ShaderSet
+	{
+		public:
+
+			ShaderSet(const spl::ShaderProgram* shaderGBuffer, const spl::ShaderProgram* shaderShadow, const spl::ShaderProgram* shaderTransparency);
+			ShaderSet(const ShaderSet& set) = default;
+			ShaderSet(ShaderSet&& set) = default;
+
+			ShaderSet& operator=(const ShaderSet& set) = default;
+			ShaderSet& operator=(ShaderSet&& set) = default;
+
+			~ShaderSet() = default;
+
+		private:
+
+			// A shader may be `nullptr` until the scene links it, the set is not used for that pass in the meantime
+
+			const spl::ShaderProgram* _getShader(ShaderType shaderType) const;
+			void _setShader(ShaderType shaderType, const spl::ShaderProgram* shader);
+
+			static void fillInterface(const spl::ShaderProgram* shader, shaderInterface::InterfaceSsao& interface);
+			static void fillInterface(const spl::ShaderProgram* shader, shaderInterface::InterfaceMerge& interface);
+			static void fillInterface(const spl::ShaderProgram* shader, const std::unordered_map<std::string, std::pair<intptr_t, uint32_t>>& slots, void* pInterface);
+			static uint32_t getVertexInputMask(const spl::ShaderProgram* shader);
+
+			const spl::ShaderProgram* _shaderGBuffer;
+			const spl::ShaderProgram* _shaderShadow;
+			const spl::ShaderProgram* _shaderTransparency;
+
+			shaderInterface::InterfaceGBuffer _interfaceGBuffer;
+			shaderInterface::InterfaceShadow _interfaceShadow;
+			shaderInterface::InterfaceTransparency _interfaceTransparency;
+
+		friend class Scene;
+	};
+}
@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/CoreTypes.hpp>
+
+namespace lys
+{
+	// Last state set through it on the current context: face culling, blending, depth test and write, program, buffer
+	// binding points, texture units and the uniforms of each program. A change that would not modify that state is
+	// dropped. The GL calls made without the cache are not seen, `invalidate` must be called after them, and after
+	// `createNew` on a bound buffer or texture, which keeps its address.
+
+	class LYS_API StateCache
+	{
+		public:
+
+			StateCache();
+			StateCache(const StateCache& cache) = delete;
+			StateCache(StateCache&& cache) = delete;
+
+			StateCache& operator=(const StateCache& cache) = delete;
+			StateCache& operator=(StateCache&& cache) = delete;
+
+
+			void invalidate();	// Everything is set again the next time it is requested
+
+
+			void setFaceCullingMode(spl::FaceCullingMode mode);
+			void setFaceCullingOrientation(spl::FaceOrientation orientation);
+			void setIsBlendEnabled(uint32_t drawBuffer, bool enabled);
+			void setIsDepthTestEnabled(bool enabled);
+			void setIsDepthWriteEnabled(bool enabled);
+
+			void bindShader(const spl::ShaderProgram* shader);
+			void bindBuffer(spl::BufferTarget target, const spl::Buffer* buffer, uint32_t index);
+
+			// Set on the bound shader
+			template<typename TValue> void setUniform(int32_t location, const TValue& value);
+			void setUniform(int32_t location, uint32_t unit, const spl::Texture* texture);
+
+			const spl::ShaderProgram* getShader() const;
+
+
+			~StateCache() = default;
+
+			static constexpr uint32_t maxDrawBufferCount = 8;
+
+		private:
+
+			struct BufferBinding
+			{
+				spl::BufferTarget target;
+				uint32_t index;
+				const spl::Buffer* buffer;
+			};
+
+			// Zero-padded, so that two values compare equal byte by byte
+
+			struct Uniform
+			{
+				int32_t location;
+				uint8_t value[16];
+			};
+
+			bool _updateUniform(int32_t location, const void* value, uint32_t size);	// Whether the value changed
+
+			spl::Context* _context;
+
+			std::optional<spl::FaceCullingMode> _faceCullingMode;
+			std::optional<spl::FaceOrientation> _faceCullingOrientation;
+			std::array<std::optional<bool>, maxDrawBufferCount> _blendEnabled;
+			std::optional<bool> _depthTestEnabled;
+			std::optional<bool> _depthWriteEnabled;
+
+			const spl::ShaderProgram* _shader;
+			std::vector<BufferBinding> _buffers;
+			std::vector<const spl::Texture*> _textureUnits;		// `nullptr` if unknown
+
+			// Uniforms are kept by the programs, they are not lost when another one is bound
+
+			std::unordered_map<const spl::ShaderProgram*, std::vector<Uniform>> _uniforms;
+			std::vector<Uniform>* _shaderUniforms;
+	};
+}
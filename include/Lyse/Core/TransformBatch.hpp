@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/CoreTypes.hpp>
+
+namespace lys
+{
+	// Translations, rotations and scales of many objects in separate arrays, so that their model and inverse model
+	// matrices are computed several at a time with SIMD instructions (AVX2 when the library is compiled with
+	// `LYSE_ENABLE_AVX2`, SSE otherwise). Only the blocks containing an entry changed since the last `update` are
+	// computed again.
+
+	class LYS_API TransformBatch
+	{
+		public:
+
+			TransformBatch();
+			TransformBatch(const TransformBatch& batch) = default;
+			TransformBatch(TransformBatch&& batch) = default;
+
+			TransformBatch& operator=(const TransformBatch& batch) = default;
+			TransformBatch& operator=(TransformBatch&& batch) = default;
+
+
+			uint32_t add(const scp::f32vec3& translation, const scp::f32quat& rotation, const scp::f32vec3& scale);
+			uint32_t add(const Transformable& transformable);
+			void set(uint32_t index, const scp::f32vec3& translation, const scp::f32quat& rotation, const scp::f32vec3& scale);
+			void set(uint32_t index, const Transformable& transformable);
+			void setTranslation(uint32_t index, const scp::f32vec3& translation);
+			void setRotation(uint32_t index, const scp::f32quat& rotation);
+			void setScale(uint32_t index, const scp::f32vec3& scale);
+			void resize(uint32_t size);	// New entries are identity transforms
+			void clear();
+
+			void update();
+
+			uint32_t getSize() const;
+			const scp::f32mat4x4& getTransformMatrix(uint32_t index) const;
+			const scp::f32mat4x4& getInverseTransformMatrix(uint32_t index) const;
+			const scp::f32mat4x4* getTransformMatrices() const;
+			const scp::f32mat4x4* getInverseTransformMatrices() const;
+
+			// Fill the matrix caches of the transformables that need it, which must not override `getTransformMatrix`
+			template<typename TTransformable> static void updateMatrices(const TTransformable* const* transformables, uint32_t count);
+
+
+			~TransformBatch() = default;
+
+			static constexpr uint32_t blockSize = 8;
+
+		private:
+
+			void _computeBlock(uint32_t block);
+
+			std::vector<float> _translationsX;
+			std::vector<float> _translationsY;
+			std::vector<float> _translationsZ;
+			std::vector<float> _rotationsW;
+			std::vector<float> _rotationsX;
+			std::vector<float> _rotationsY;
+			std::vector<float> _rotationsZ;
+			std::vector<float> _scalesX;
+			std::vector<float> _scalesY;
+			std::vector<float> _scalesZ;
+
+			std::vector<scp::f32mat4x4> _transforms;
+			std::vector<scp::f32mat4x4> _invTransforms;
+			std::vector<uint8_t> _dirtyBlocks;	// Not `std::vector<bool>`, blocks are computed in parallel
+			uint32_t _size;
+	};
+}
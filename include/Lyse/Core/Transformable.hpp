@@ -70,6 +70,7 @@ namespace lys
 			constexpr const scp::f32vec3& getPosition() const;
 			constexpr const scp::f32quat& getRotation() const;
 			constexpr const scp::f32vec3& getScale() const;
+			constexpr uint32_t getTransformVersion() const;	// Incremented each time the transform changes
 			
 			virtual constexpr const scp::f32mat4x4& getTransformMatrix() const;
 			constexpr const scp::f32mat4x4& getInverseTransformMatrix() const;
@@ -85,5 +86,8 @@ namespace lys
 			
 			mutable std::optional<scp::f32mat4x4> _transform;
 			mutable std::optional<scp::f32mat4x4> _invTransform;
+			uint32_t _transformVersion;
+
+		friend class TransformBatch;
 	};
 }
@@ -1,91 +1,140 @@
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//! \file
-//! \author Reiex
-//! \copyright The MIT License (MIT)
-//! \date 2023
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-#include <Lyse/Core/CoreTypes.hpp>
-
-namespace lys
-{
-	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
-	class VertexBase
-	{
-		static_assert(SpecialIndices.position == UINT32_MAX || SpecialIndices.position < sizeof...(TAttributes));
-		static_assert(SpecialIndices.normal == UINT32_MAX || SpecialIndices.normal < sizeof...(TAttributes));
-		static_assert(SpecialIndices.tangent == UINT32_MAX || SpecialIndices.tangent < sizeof...(TAttributes));
-		static_assert(SpecialIndices.texCoords == UINT32_MAX || SpecialIndices.texCoords < sizeof...(TAttributes));
-
-		public:
-
-			using IsVertex = bool;
-			
-			static constexpr VertexSpecialIndices specialIndices = SpecialIndices;
-
-			template<uint32_t Index> using AttributeType = std::tuple_element<Index, std::tuple<TAttributes...>>::type;
-
-			static constexpr uint32_t getAttributeCount();
-			static constexpr spl::GlslType getAttributeType(uint32_t i);
-			static constexpr uint32_t getAttributeOffsetInStructure(uint32_t i);
-
-			constexpr const void* getAttribute(uint32_t i) const;
-			constexpr void* getAttribute(uint32_t i);
-
-			constexpr void setPosition(float x, float y, float z, float w);
-			constexpr void setNormal(float x, float y, float z, float w);
-			constexpr void setTangent(float x, float y, float z, float w);
-			constexpr void setTexCoords(float x, float y, float z, float w);
-
-			constexpr void getPosition(float& x, float& y, float& z, float& w) const;
-			constexpr void getNormal(float& x, float& y, float& z, float& w) const;
-			constexpr void getTangent(float& x, float& y, float& z, float& w) const;
-			constexpr void getTexCoords(float& x, float& y, float& z, float& w) const;
-
-			constexpr ~VertexBase() = default;
-
-		protected:
-
-			constexpr VertexBase() = default;
-
-			constexpr VertexBase(const VertexBase<SpecialIndices, TAttributes...>& vertex) = default;
-			constexpr VertexBase(VertexBase<SpecialIndices, TAttributes...>&& vertex) = default;
-
-			constexpr VertexBase<SpecialIndices, TAttributes...>& operator=(const VertexBase<SpecialIndices, TAttributes...>& vertex) = default;
-			constexpr VertexBase<SpecialIndices, TAttributes...>& operator=(VertexBase<SpecialIndices, TAttributes...>&& vertex) = default;
-
-
-			template<uint32_t Index> constexpr void _setVector(float x, float y, float z, float w);
-			template<uint32_t Index> constexpr void _getVector(float& x, float& y, float& z, float& w) const;
-	};
-
-	namespace _lys
-	{
-		constexpr VertexSpecialIndices NoIndices = { UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX };
-		constexpr VertexSpecialIndices VertexDefaultMeshIndices = { 0, 1, 2, 3 };
-	}
-
-	#pragma pack(push, 1)
-
-	struct VertexDefaultMesh : public VertexBase<_lys::VertexDefaultMeshIndices, scp::f32vec4, scp::f32vec4, scp::f32vec4, scp::f32vec4>
-	{
-		constexpr VertexDefaultMesh();
-		constexpr VertexDefaultMesh(const scp::f32vec4& p, const scp::f32vec4& n, const scp::f32vec4& t, const scp::f32vec4& tc);
-		constexpr VertexDefaultMesh(const VertexDefaultMesh& vertex) = default;
-		constexpr VertexDefaultMesh(VertexDefaultMesh&& vertex) = default;
-
-		constexpr VertexDefaultMesh& operator=(const VertexDefaultMesh& vertex) = default;
-		constexpr VertexDefaultMesh& operator=(VertexDefaultMesh&& vertex) = default;
-
-		constexpr ~VertexDefaultMesh() = default;
-
-		scp::f32vec4 position;
-		scp::f32vec4 normal;
-		scp::f32vec4 tangent;
-		scp::f32vec4 texCoords;
-	};
-
-	#pragma pack(pop)
-}
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/CoreTypes.hpp>
+
+namespace lys
+{
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	class VertexBase
+	{
+		static_assert(SpecialIndices.position == UINT32_MAX || SpecialIndices.position < sizeof...(TAttributes));
+		static_assert(SpecialIndices.normal == UINT32_MAX || SpecialIndices.normal < sizeof...(TAttributes));
+		static_assert(SpecialIndices.tangent == UINT32_MAX || SpecialIndices.tangent < sizeof...(TAttributes));
+		static_assert(SpecialIndices.texCoords == UINT32_MAX || SpecialIndices.texCoords < sizeof...(TAttributes));
+
+		public:
+
+			using IsVertex = bool;
+			
+			static constexpr VertexSpecialIndices specialIndices = SpecialIndices;
+
+			template<uint32_t Index> using AttributeType = std::tuple_element<Index, std::tuple<TAttributes...>>::type;
+
+			static constexpr uint32_t getAttributeCount();
+			static constexpr spl::GlslType getAttributeType(uint32_t i);
+			static constexpr uint32_t getAttributeSize(uint32_t i);
+			static constexpr uint32_t getAttributeOffsetInStructure(uint32_t i);
+
+			// Attributes are split in vertex streams (one buffer binding each): the position alone in stream 0, and every
+			// other attribute in stream 1. Passes that only need positions can then fetch stream 0 only.
+			static constexpr uint32_t getStreamCount();
+			static constexpr uint32_t getStreamSize(uint32_t stream);
+			static constexpr uint32_t getAttributeStream(uint32_t i);
+			static constexpr uint32_t getAttributeOffsetInStream(uint32_t i);
+
+			constexpr const void* getAttribute(uint32_t i) const;
+			constexpr void* getAttribute(uint32_t i);
+			constexpr void copyStreamTo(uint32_t stream, void* dst) const;
+
+			constexpr void setPosition(float x, float y, float z, float w);
+			constexpr void setNormal(float x, float y, float z, float w);
+			constexpr void setTangent(float x, float y, float z, float w);
+			constexpr void setTexCoords(float x, float y, float z, float w);
+
+			constexpr void getPosition(float& x, float& y, float& z, float& w) const;
+			constexpr void getNormal(float& x, float& y, float& z, float& w) const;
+			constexpr void getTangent(float& x, float& y, float& z, float& w) const;
+			constexpr void getTexCoords(float& x, float& y, float& z, float& w) const;
+
+			constexpr ~VertexBase() = default;
+
+		protected:
+
+			constexpr VertexBase() = default;
+
+			constexpr VertexBase(const VertexBase<SpecialIndices, TAttributes...>& vertex) = default;
+			constexpr VertexBase(VertexBase<SpecialIndices, TAttributes...>&& vertex) = default;
+
+			constexpr VertexBase<SpecialIndices, TAttributes...>& operator=(const VertexBase<SpecialIndices, TAttributes...>& vertex) = default;
+			constexpr VertexBase<SpecialIndices, TAttributes...>& operator=(VertexBase<SpecialIndices, TAttributes...>&& vertex) = default;
+
+
+			template<uint32_t Index> constexpr void _setVector(float x, float y, float z, float w);
+			template<uint32_t Index> constexpr void _getVector(float& x, float& y, float& z, float& w) const;
+	};
+
+	namespace _lys
+	{
+		constexpr VertexSpecialIndices NoIndices = { UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX };
+		constexpr VertexSpecialIndices VertexDefaultMeshIndices = { 0, 1, 2, 3 };
+		constexpr VertexSpecialIndices VertexCompactMeshIndices = { 0, 1, 2, 3 };
+
+		// Vertex types that cannot be filled attribute by attribute (quantized formats for instance) declare the vertex
+		// type they are encoded from as `SourceVertex`. Mesh loaders work on that source type.
+
+		template<CVertex TVertex>
+		struct SourceVertex
+		{
+			using Type = TVertex;
+		};
+
+		template<CVertex TVertex> requires requires { typename TVertex::SourceVertex; }
+		struct SourceVertex<TVertex>
+		{
+			using Type = TVertex::SourceVertex;
+		};
+	}
+
+	#pragma pack(push, 1)
+
+	struct VertexDefaultMesh : public VertexBase<_lys::VertexDefaultMeshIndices, scp::f32vec4, scp::f32vec4, scp::f32vec4, scp::f32vec4>
+	{
+		constexpr VertexDefaultMesh();
+		constexpr VertexDefaultMesh(const scp::f32vec4& p, const scp::f32vec4& n, const scp::f32vec4& t, const scp::f32vec4& tc);
+		constexpr VertexDefaultMesh(const VertexDefaultMesh& vertex) = default;
+		constexpr VertexDefaultMesh(VertexDefaultMesh&& vertex) = default;
+
+		constexpr VertexDefaultMesh& operator=(const VertexDefaultMesh& vertex) = default;
+		constexpr VertexDefaultMesh& operator=(VertexDefaultMesh&& vertex) = default;
+
+		constexpr ~VertexDefaultMesh() = default;
+
+		scp::f32vec4 position;
+		scp::f32vec4 normal;
+		scp::f32vec4 tangent;
+		scp::f32vec4 texCoords;
+	};
+
+	// 20 bytes instead of 64: position quantized to 16 bits per component in the bounding box of the mesh, normal and
+	// tangent octahedral-encoded on 2x16 bits, texture coordinates as two half floats.
+
+	struct VertexCompactMesh : public VertexBase<_lys::VertexCompactMeshIndices, scp::u32vec2, uint32_t, uint32_t, uint32_t>
+	{
+		using SourceVertex = VertexDefaultMesh;
+
+		constexpr VertexCompactMesh();
+		constexpr VertexCompactMesh(const VertexCompactMesh& vertex) = default;
+		constexpr VertexCompactMesh(VertexCompactMesh&& vertex) = default;
+
+		constexpr VertexCompactMesh& operator=(const VertexCompactMesh& vertex) = default;
+		constexpr VertexCompactMesh& operator=(VertexCompactMesh&& vertex) = default;
+
+		static void encode(const VertexDefaultMesh* vertices, uint32_t count, VertexCompactMesh* compactVertices, scp::f32vec3& boundingBoxMin, scp::f32vec3& boundingBoxMax);
+
+		constexpr ~VertexCompactMesh() = default;
+
+		scp::u32vec2 position;
+		uint32_t normal;
+		uint32_t tangent;
+		uint32_t texCoords;
+	};
+
+	#pragma pack(pop)
+}
@@ -0,0 +1,45 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/FrameArena.hpp>
+
+namespace lys
+{
+	template<typename TValue>
+	constexpr FrameAllocator<TValue>::FrameAllocator(FrameArena& arena) :
+		_arena(&arena)
+	{
+	}
+
+	template<typename TValue>
+	template<typename TOther>
+	constexpr FrameAllocator<TValue>::FrameAllocator(const FrameAllocator<TOther>& allocator) :
+		_arena(allocator._arena)
+	{
+	}
+
+	template<typename TValue>
+	TValue* FrameAllocator<TValue>::allocate(std::size_t count)
+	{
+		return static_cast<TValue*>(_arena->allocate(count * sizeof(TValue), alignof(TValue)));
+	}
+
+	template<typename TValue>
+	constexpr void FrameAllocator<TValue>::deallocate(TValue* values, std::size_t count)
+	{
+		// Released by the reset of the arena
+	}
+
+	template<typename TValue>
+	template<typename TOther>
+	constexpr bool FrameAllocator<TValue>::operator==(const FrameAllocator<TOther>& allocator) const
+	{
+		return _arena == allocator._arena;
+	}
+}
@@ -0,0 +1,45 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/JobSystem.hpp>
+
+namespace lys
+{
+	template<typename TFunction>
+	void JobSystem::parallelFor(uint32_t begin, uint32_t end, uint32_t grainSize, const TFunction& function)
+	{
+		if (begin >= end)
+		{
+			return;
+		}
+
+		grainSize = std::max<uint32_t>(grainSize, 1);
+
+		if (end - begin <= grainSize || getThreadCount() == 0)
+		{
+			function(begin, end);
+			return;
+		}
+
+		// The calling thread takes the first range, and the others while it waits. The jobs only hold a reference to
+		// `function` and their range, small enough for `Job` not to allocate.
+
+		JobCounter counter;
+		for (uint32_t rangeBegin = begin + grainSize; rangeBegin < end;)
+		{
+			const uint32_t rangeEnd = rangeBegin + std::min(grainSize, end - rangeBegin);
+			run([&function, rangeBegin, rangeEnd]() { function(rangeBegin, rangeEnd); }, &counter);
+			rangeBegin = rangeEnd;
+		}
+
+		function(begin, begin + grainSize);
+
+		wait(counter);
+	}
+}
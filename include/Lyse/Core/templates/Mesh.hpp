@@ -1,417 +1,842 @@
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//! \file
-//! \author Reiex
-//! \copyright The MIT License (MIT)
-//! \date 2023
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-#include <Lyse/Core/CoreDecl.hpp>
-
-namespace lys
-{
-	template<CVertex TVertex>
-	Mesh<TVertex>::Mesh() : Drawable(),
-		_vao(),
-		_vbo(),
-		_ebo(),
-		_normalMap(nullptr)
-	{
-		for (uint32_t i = 0; i < TVertex::getAttributeCount(); ++i)
-		{
-			_vao.setAttributeFormat(i, TVertex::getAttributeType(i), TVertex::getAttributeOffsetInStructure(i));
-			_vao.setAttributeEnabled(i, true);
-			_vao.setAttributeBinding(i, 0);
-		}
-
-		_vao.setBindingDivisor(0, 0);
-	}
-
-	template<CVertex TVertex>
-	template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage>
-	Mesh<TVertex>::Mesh(const std::initializer_list<TVertex>& vertices, TVertexStorage vertexStorage, TIndexStorage indexStorage) : Mesh(vertices.begin(), vertices.size(), vertexStorage, indexStorage)
-	{
-	}
-
-	template<CVertex TVertex>
-	template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage>
-	Mesh<TVertex>::Mesh(const TVertex* vertices, uint32_t vertexCount, TVertexStorage vertexStorage, TIndexStorage indexStorage) : Mesh()
-	{
-		std::vector<uint32_t> indices(vertexCount);
-		for (uint32_t i = 0; i < vertexCount; ++i)
-		{
-			indices[i] = i;
-		}
-
-		createNewVertices(vertices, vertexCount, vertexStorage);
-		createNewIndices(indices.data(), indices.size(), indexStorage);
-	}
-
-	template<CVertex TVertex>
-	template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage>
-	Mesh<TVertex>::Mesh(const std::initializer_list<TVertex>& vertices, TVertexStorage vertexStorage, const std::initializer_list<uint32_t>& indices, TIndexStorage indexStorage) : Mesh(vertices.begin(), vertices.size(), vertexStorage, indices.begin(), indices.size(), indexStorage)
-	{
-	}
-
-	template<CVertex TVertex>
-	template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage>
-	Mesh<TVertex>::Mesh(const TVertex* vertices, uint32_t vertexCount, TVertexStorage vertexStorage, const uint32_t* indices, uint32_t indexCount, TIndexStorage indexStorage) : Mesh()
-	{
-		createNewVertices(vertices, vertexCount, vertexStorage);
-		createNewIndices(indices, indexCount, indexStorage);
-	}
-	
-	template<CVertex TVertex>
-	template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage>
-	Mesh<TVertex>::Mesh(const std::filesystem::path& path, TVertexStorage vertexStorage, TIndexStorage indexStorage) : Mesh()
-	{
-		createFromFile(path, vertexStorage, indexStorage);
-	}
-
-	template<CVertex TVertex>
-	Mesh<TVertex>::Mesh(const Mesh<TVertex>& mesh) : Mesh()
-	{
-		Mesh<TVertex>::operator=(mesh);
-	}
-
-	template<CVertex TVertex>
-	Mesh<TVertex>::Mesh(Mesh<TVertex>&& mesh) : Mesh()
-	{
-		Mesh<TVertex>::operator=(std::move(mesh));
-	}
-
-	template<CVertex TVertex>
-	Mesh<TVertex>& Mesh<TVertex>::operator=(const Mesh<TVertex>& mesh)
-	{
-		Drawable::operator=(mesh);
-
-		_vbo.copyFrom(mesh._vbo);
-		_ebo.copyFrom(mesh._ebo);
-
-		_vao.bindArrayBuffer(&_vbo, 0, sizeof(TVertex));
-		_vao.bindElementBuffer(&_ebo);
-
-		_normalMap = mesh._normalMap;
-
-		return *this;
-	}
-
-	template<CVertex TVertex>
-	Mesh<TVertex>& Mesh<TVertex>::operator=(Mesh<TVertex>&& mesh)
-	{
-		Drawable::operator=(std::move(mesh));
-
-		_vbo.moveFrom(mesh._vbo);
-		_ebo.moveFrom(mesh._ebo);
-
-		_vao.bindArrayBuffer(&_vbo, 0, sizeof(TVertex));
-		_vao.bindElementBuffer(&_ebo);
-
-		_normalMap = mesh._normalMap;
-
-		return *this;
-	}
-
-	template<CVertex TVertex>
-	template<CBufferStorageSpecifier TStorage>
-	void Mesh<TVertex>::createNewVertices(const TVertex* vertices, uint32_t count, TStorage storage)
-	{
-		_vbo.createNew(sizeof(TVertex) * count, storage, vertices);
-		_vao.bindArrayBuffer(&_vbo, 0, sizeof(TVertex));
-	}
-
-	template<CVertex TVertex>
-	template<CBufferStorageSpecifier TStorage>
-	void Mesh<TVertex>::createNewIndices(const uint32_t* indices, uint32_t count, TStorage storage)
-	{
-		_ebo.createNew(sizeof(uint32_t) * count, storage, indices);
-		_vao.bindElementBuffer(&_ebo);
-	}
-
-	template<CVertex TVertex>
-	template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage>
-	void Mesh<TVertex>::createFromFile(const std::filesystem::path& path, TVertexStorage vertexStorage, TIndexStorage indexStorage)
-	{
-		std::vector<TVertex> vertices;
-		std::vector<uint32_t> indices;
-
-		_createFromFile(path, vertices, indices);
-
-		if (!vertices.empty() && !indices.empty())
-		{
-			createNewVertices(vertices.data(), vertices.size(), vertexStorage);
-			createNewIndices(indices.data(), indices.size(), indexStorage);
-		}
-	}
-
-	template<CVertex TVertex>
-	void Mesh<TVertex>::updateVertices(const TVertex* vertices, uint32_t count, uint32_t offset)
-	{
-		_vbo.update(vertices, sizeof(TVertex) * count, sizeof(TVertex) * offset);
-	}
-
-	template<CVertex TVertex>
-	void Mesh<TVertex>::updateIndices(const uint32_t* indices, uint32_t count, uint32_t offset)
-	{
-		_ebo.update(indices, sizeof(uint32_t) * count, sizeof(uint32_t) * offset);
-	}
-
-	template<CVertex TVertex>
-	void Mesh<TVertex>::destroy()
-	{
-		_vbo.destroy();
-		_ebo.destroy();
-	}
-
-	template<CVertex TVertex>
-	void Mesh<TVertex>::setNormalMap(const spl::Texture2D* texture)
-	{
-		_normalMap = texture;
-	}
-
-	template<CVertex TVertex>
-	void Mesh<TVertex>::draw(spl::PrimitiveType primitiveType) const
-	{
-		assert(isValid());
-
-		_vao.drawElements(primitiveType, spl::IndexType::UnsignedInt, 0, _ebo.getSize() / sizeof(uint32_t));
-	}
-
-	template<CVertex TVertex>
-	DrawableType Mesh<TVertex>::getType() const
-	{
-		return DrawableType::Mesh;
-	}
-
-	template<CVertex TVertex>
-	const spl::VertexArray& Mesh<TVertex>::getVertexArray() const
-	{
-		return _vao;
-	}
-
-	template<CVertex TVertex>
-	spl::VertexArray& Mesh<TVertex>::getVertexArray()
-	{
-		return _vao;
-	}
-
-	template<CVertex TVertex>
-	const spl::Buffer& Mesh<TVertex>::getVertexBuffer() const
-	{
-		return _vbo;
-	}
-
-	template<CVertex TVertex>
-	spl::Buffer& Mesh<TVertex>::getVertexBuffer()
-	{
-		return _vbo;
-	}
-
-	template<CVertex TVertex>
-	const spl::Buffer& Mesh<TVertex>::getElementBuffer() const
-	{
-		return _ebo;
-	}
-
-	template<CVertex TVertex>
-	spl::Buffer& Mesh<TVertex>::getElementBuffer()
-	{
-		return _ebo;
-	}
-
-	template<CVertex TVertex>
-	const spl::Texture2D* Mesh<TVertex>::getNormalMap() const
-	{
-		return _normalMap;
-	}
-
-	template<CVertex TVertex>
-	bool Mesh<TVertex>::isValid() const
-	{
-		return _vbo.isValid() && _ebo.isValid();
-	}
-
-	template<CVertex TVertex>
-	void Mesh<TVertex>::_draw() const
-	{
-		draw();
-	}
-	
-	namespace _lys
-	{
-		inline uint64_t read(void* handle, uint8_t* data, uint64_t size)
-		{
-			return std::fread(data, 1, size, reinterpret_cast<std::FILE*>(handle));
-		}
-
-		inline bool eof(void* handle)
-		{
-			return std::feof(reinterpret_cast<std::FILE*>(handle));
-		}
-	}
-
-	template<CVertex TVertex>
-	void Mesh<TVertex>::_createFromFile(const std::filesystem::path& path, std::vector<TVertex>& vertices, std::vector<uint32_t>& indices)
-	{
-		if (!std::filesystem::exists(path))
-		{
-			return;
-		}
-
-		std::FILE* file = std::fopen(path.string().c_str(), "rb");
-		if (!file)
-		{
-			return;
-		}
-
-		MeshFormat format;
-		if (_extensionToMeshFormat(path.extension(), format))
-		{
-			dsk::IStream* stream = new dsk::IStream(file, _lys::read, _lys::eof);
-			_createFromStream(stream, format, vertices, indices);
-			delete stream;
-		}
-	}
-
-	template<CVertex TVertex>
-	void Mesh<TVertex>::_createFromStream(dsk::IStream* stream, MeshFormat format, std::vector<TVertex>& vertices, std::vector<uint32_t>& indices)
-	{
-		assert(stream);
-
-		(this->*(_meshFormatToLoadFunc[static_cast<size_t>(format)]))(stream, vertices, indices);
-	}
-
-	namespace _lys
-	{
-		template<CVertex TVertex>
-		void fillVertex(TVertex& v0, TVertex& v1, TVertex& v2)
-		{
-			float dummy;
-
-			// Extract "tex coords vectors" and check they're not colinear
-
-			scp::f32vec2 tc0, tc1, tc2, d0, d1;
-			v0.getTexCoords(tc0.x, tc0.y, dummy, dummy);
-			v1.getTexCoords(tc1.x, tc1.y, dummy, dummy);
-			v2.getTexCoords(tc2.x, tc2.y, dummy, dummy);
-			d0 = tc1 - tc0;
-			d1 = tc2 - tc1;
-			const float det = d0.x * d1.y - d1.x * d0.y;
-			if (det == 0.f)
-			{
-				return;
-			}
-
-			// Extract "position vectors" and check they're not colinear
-
-			scp::f32vec3 p0, p1, p2, e0, e1;
-			v0.getPosition(p0.x, p0.y, p0.z, dummy);
-			v1.getPosition(p1.x, p1.y, p1.z, dummy);
-			v2.getPosition(p2.x, p2.y, p2.z, dummy);
-			e0 = p1 - p0;
-			e1 = p2 - p1;
-
-			scp::f32vec3 t;
-			t = (d1.y * e0 - d0.y * e1) / det;
-			if (t.x == 0.f && t.y == 0.f && t.z == 0.f)
-			{
-				return;
-			}
-			t = scp::normalize(t);
-
-			// Compute/Extract normals
-
-			scp::f32vec3 n0, n1, n2;
-
-			v0.getNormal(n0.x, n0.y, n0.z, dummy);
-			if (n0.x == 0.f && n0.y == 0.f && n0.z == 0.f)
-			{
-				n0 = scp::normalize(scp::cross(e0, e1));
-			}
-
-			v1.getNormal(n1.x, n1.y, n1.z, dummy);
-			if (n1.x == 0.f && n1.y == 0.f && n1.z == 0.f)
-			{
-				n1 = scp::normalize(scp::cross(e0, e1));
-			}
-
-			v2.getNormal(n2.x, n2.y, n2.z, dummy);
-			if (n2.x == 0.f && n2.y == 0.f && n2.z == 0.f)
-			{
-				n2 = scp::normalize(scp::cross(e0, e1));
-			}
-
-			// Compute tangents
-
-			scp::f32vec3 tn;
-
-			tn = scp::normalize(t - scp::dot(t, n0) * n0);
-			v0.setTangent(tn.x, tn.y, tn.z, 0.f);
-			tn = scp::normalize(t - scp::dot(t, n1) * n1);
-			v1.setTangent(tn.x, tn.y, tn.z, 0.f);
-			tn = scp::normalize(t - scp::dot(t, n2) * n2);
-			v2.setTangent(tn.x, tn.y, tn.z, 0.f);
-		}
-	}
-
-	template<CVertex TVertex>
-	void Mesh<TVertex>::_createFromObj(dsk::IStream* stream, std::vector<TVertex>& vertices, std::vector<uint32_t>& indices)
-	{
-		dsk::fmt::ObjIStream objIStream(stream);
-
-		dsk::fmt::obj::File objFile;
-		objIStream.readFile(objFile);
-
-		for (const dsk::fmt::obj::Face& face : objFile.faces)
-		{
-			if (face.vertices.size() != 3)
-			{
-				continue;
-			}
-
-			for (const dsk::fmt::obj::FaceVertex& vertex : face.vertices)
-			{
-				TVertex outVertex;
-
-				assert(vertex.position != UINT64_MAX);
-				outVertex.setPosition(objFile.positions[vertex.position].x, objFile.positions[vertex.position].y, objFile.positions[vertex.position].z, objFile.positions[vertex.position].w);
-
-				if (vertex.normal != UINT64_MAX)
-				{
-					outVertex.setNormal(objFile.normals[vertex.normal].i, objFile.normals[vertex.normal].j, objFile.normals[vertex.normal].k, 0.f);
-				}
-
-				if (vertex.texCoord != UINT64_MAX)
-				{
-					outVertex.setTexCoords(objFile.texCoords[vertex.texCoord].u, objFile.texCoords[vertex.texCoord].v, objFile.texCoords[vertex.texCoord].w, 0.f);
-				}
-
-				vertices.push_back(outVertex);
-				indices.push_back(indices.size());
-			}
-
-			_lys::fillVertex(vertices[vertices.size() - 3], vertices[vertices.size() - 2], vertices[vertices.size() - 1]);
-		}
-	}
-
-	template<CVertex TVertex>
-	bool Mesh<TVertex>::_extensionToMeshFormat(const std::filesystem::path& extension, MeshFormat& format)
-	{
-		static const std::unordered_map<std::filesystem::path, MeshFormat> extensionToMeshFormat = {
-			{ ".obj", MeshFormat::Obj }
-		};
-
-		auto it = extensionToMeshFormat.find(extension);
-
-		if (it == extensionToMeshFormat.end())
-		{
-			return false;
-		}
-		else
-		{
-			format = it->second;
-			return true;
-		}
-	}
-}
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/CoreDecl.hpp>
+
+namespace lys
+{
+	namespace _lys
+	{
+		template<CVertex TVertex>
+		void splitVertexStreams(const TVertex* vertices, uint32_t count, std::vector<uint8_t>& positions, std::vector<uint8_t>& attributes)
+		{
+			static_assert(TVertex::getStreamCount() == 2);
+
+			constexpr uint32_t positionSize = TVertex::getStreamSize(0);
+			constexpr uint32_t attributesSize = TVertex::getStreamSize(1);
+
+			positions.resize(positionSize * count);
+			attributes.resize(attributesSize * count);
+
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				vertices[i].copyStreamTo(0, positions.data() + positionSize * i);
+				vertices[i].copyStreamTo(1, attributes.data() + attributesSize * i);
+			}
+		}
+
+		template<CVertex TVertex>
+		void expandBoundingBox(const TVertex* vertices, uint32_t count, scp::f32vec3& boundingBoxMin, scp::f32vec3& boundingBoxMax)
+		{
+			// Only floating point positions can be read back, quantized formats set their bounding box at encoding
+
+			if constexpr (TVertex::specialIndices.position != UINT32_MAX)
+			{
+				using TPosition = TVertex::template AttributeType<TVertex::specialIndices.position>;
+
+				if constexpr (scp::CVec<TPosition> && TPosition::size >= 3 && std::floating_point<decltype(TPosition::x)>)
+				{
+					for (uint32_t i = 0; i < count; ++i)
+					{
+						const TPosition& p = *reinterpret_cast<const TPosition*>(vertices[i].getAttribute(TVertex::specialIndices.position));
+
+						boundingBoxMin.x = std::min<float>(boundingBoxMin.x, p.x);
+						boundingBoxMin.y = std::min<float>(boundingBoxMin.y, p.y);
+						boundingBoxMin.z = std::min<float>(boundingBoxMin.z, p.z);
+						boundingBoxMax.x = std::max<float>(boundingBoxMax.x, p.x);
+						boundingBoxMax.y = std::max<float>(boundingBoxMax.y, p.y);
+						boundingBoxMax.z = std::max<float>(boundingBoxMax.z, p.z);
+					}
+				}
+			}
+		}
+
+		inline uint32_t getIndexSize(spl::IndexType indexType)
+		{
+			return indexType == spl::IndexType::UnsignedShort ? sizeof(uint16_t) : sizeof(uint32_t);
+		}
+	}
+
+	template<CVertex TVertex>
+	Mesh<TVertex>::Mesh() : MeshBase(),
+		_vao(),
+		_positionVao(),
+		_vbo(),
+		_positionVbo(),
+		_ebo(),
+		_vertexCount(0),
+		_indexType(spl::IndexType::UnsignedInt)
+	{
+		_compactVertices = !std::same_as<TVertex, TSourceVertex>;
+
+		for (uint32_t i = 0; i < TVertex::getAttributeCount(); ++i)
+		{
+			_vao.setAttributeFormat(i, TVertex::getAttributeType(i), TVertex::getAttributeOffsetInStream(i));
+			_vao.setAttributeEnabled(i, true);
+			_vao.setAttributeBinding(i, TVertex::getAttributeStream(i));
+		}
+
+		for (uint32_t i = 0; i < TVertex::getStreamCount(); ++i)
+		{
+			_vao.setBindingDivisor(i, 0);
+		}
+
+		// The position-only VAO reads stream 0 and nothing else
+
+		if constexpr (TVertex::getStreamCount() != 1)
+		{
+			constexpr uint32_t i = TVertex::specialIndices.position;
+
+			_positionVao.setAttributeFormat(i, TVertex::getAttributeType(i), 0);
+			_positionVao.setAttributeEnabled(i, true);
+			_positionVao.setAttributeBinding(i, 0);
+			_positionVao.setBindingDivisor(0, 0);
+		}
+	}
+
+	template<CVertex TVertex>
+	template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage>
+	Mesh<TVertex>::Mesh(const std::initializer_list<TVertex>& vertices, TVertexStorage vertexStorage, TIndexStorage indexStorage) : Mesh(vertices.begin(), vertices.size(), vertexStorage, indexStorage)
+	{
+	}
+
+	template<CVertex TVertex>
+	template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage>
+	Mesh<TVertex>::Mesh(const TVertex* vertices, uint32_t vertexCount, TVertexStorage vertexStorage, TIndexStorage indexStorage) : Mesh()
+	{
+		std::vector<uint32_t> indices(vertexCount);
+		for (uint32_t i = 0; i < vertexCount; ++i)
+		{
+			indices[i] = i;
+		}
+
+		createNewVertices(vertices, vertexCount, vertexStorage);
+		createNewIndices(indices.data(), indices.size(), indexStorage);
+	}
+
+	template<CVertex TVertex>
+	template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage>
+	Mesh<TVertex>::Mesh(const std::initializer_list<TVertex>& vertices, TVertexStorage vertexStorage, const std::initializer_list<uint32_t>& indices, TIndexStorage indexStorage) : Mesh(vertices.begin(), vertices.size(), vertexStorage, indices.begin(), indices.size(), indexStorage)
+	{
+	}
+
+	template<CVertex TVertex>
+	template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage>
+	Mesh<TVertex>::Mesh(const TVertex* vertices, uint32_t vertexCount, TVertexStorage vertexStorage, const uint32_t* indices, uint32_t indexCount, TIndexStorage indexStorage) : Mesh()
+	{
+		createNewVertices(vertices, vertexCount, vertexStorage);
+		createNewIndices(indices, indexCount, indexStorage);
+	}
+	
+	template<CVertex TVertex>
+	template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage>
+	Mesh<TVertex>::Mesh(const std::filesystem::path& path, TVertexStorage vertexStorage, TIndexStorage indexStorage) : Mesh()
+	{
+		createFromFile(path, vertexStorage, indexStorage);
+	}
+
+	template<CVertex TVertex>
+	Mesh<TVertex>::Mesh(const Mesh<TVertex>& mesh) : Mesh()
+	{
+		Mesh<TVertex>::operator=(mesh);
+	}
+
+	template<CVertex TVertex>
+	Mesh<TVertex>::Mesh(Mesh<TVertex>&& mesh) : Mesh()
+	{
+		Mesh<TVertex>::operator=(std::move(mesh));
+	}
+
+	template<CVertex TVertex>
+	Mesh<TVertex>& Mesh<TVertex>::operator=(const Mesh<TVertex>& mesh)
+	{
+		MeshBase::operator=(mesh);
+
+		_vbo.copyFrom(mesh._vbo);
+		_positionVbo.copyFrom(mesh._positionVbo);
+		_ebo.copyFrom(mesh._ebo);
+
+		_bindVertexBuffers();
+		_vao.bindElementBuffer(&_ebo);
+		_positionVao.bindElementBuffer(&_ebo);
+
+		_vertexCount = mesh._vertexCount;
+		_indexType = mesh._indexType;
+
+		return *this;
+	}
+
+	template<CVertex TVertex>
+	Mesh<TVertex>& Mesh<TVertex>::operator=(Mesh<TVertex>&& mesh)
+	{
+		MeshBase::operator=(std::move(mesh));
+
+		_vbo.moveFrom(mesh._vbo);
+		_positionVbo.moveFrom(mesh._positionVbo);
+		_ebo.moveFrom(mesh._ebo);
+
+		_bindVertexBuffers();
+		_vao.bindElementBuffer(&_ebo);
+		_positionVao.bindElementBuffer(&_ebo);
+
+		_vertexCount = mesh._vertexCount;
+		_indexType = mesh._indexType;
+
+		return *this;
+	}
+
+	template<CVertex TVertex>
+	template<CBufferStorageSpecifier TStorage>
+	void Mesh<TVertex>::createNewVertices(const TVertex* vertices, uint32_t count, TStorage storage)
+	{
+		if constexpr (TVertex::getStreamCount() == 1)
+		{
+			_vbo.createNew(sizeof(TVertex) * count, storage, vertices);
+		}
+		else
+		{
+			std::vector<uint8_t> positions, attributes;
+			_lys::splitVertexStreams(vertices, count, positions, attributes);
+
+			_positionVbo.createNew(positions.size(), storage, positions.data());
+			_vbo.createNew(attributes.size(), storage, attributes.data());
+		}
+
+		_vertexCount = count;
+		_bindVertexBuffers();
+
+		if (!_compactVertices && count != 0)
+		{
+			_boundingBoxMin = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+			_boundingBoxMax = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+			_lys::expandBoundingBox(vertices, count, _boundingBoxMin, _boundingBoxMax);
+			_worldBoundingBoxDirty = true;
+		}
+	}
+
+	template<CVertex TVertex>
+	template<CBufferStorageSpecifier TStorage>
+	void Mesh<TVertex>::createNewIndices(const uint32_t* indices, uint32_t count, TStorage storage)
+	{
+		const MeshLod lod = { 0, count, 0.f };
+		createNewIndices(indices, count, &lod, 1, storage);
+	}
+
+	template<CVertex TVertex>
+	template<CBufferStorageSpecifier TStorage>
+	void Mesh<TVertex>::createNewIndices(const uint32_t* indices, uint32_t count, const MeshLod* lods, uint32_t lodCount, TStorage storage)
+	{
+		assert(lodCount > 0);
+		assert(std::all_of(lods, lods + lodCount, [&](const MeshLod& lod) { return lod.indexOffset + lod.indexCount <= count; }));
+
+		_lods.assign(lods, lods + lodCount);
+		_meshlets.clear();
+
+		// Half the index bandwidth when every vertex can be addressed on 16 bits, the last value is left to primitive
+		// restart. Indices created before their vertices are kept on 32 bits.
+
+		const uint32_t maxIndex = count != 0 ? *std::max_element(indices, indices + count) : 0;
+
+		if (_vertexCount != 0 && _vertexCount <= UINT16_MAX && maxIndex < UINT16_MAX)
+		{
+			std::vector<uint16_t> shortIndices(indices, indices + count);
+
+			_indexType = spl::IndexType::UnsignedShort;
+			_ebo.createNew(sizeof(uint16_t) * count, storage, shortIndices.data());
+		}
+		else
+		{
+			_indexType = spl::IndexType::UnsignedInt;
+			_ebo.createNew(sizeof(uint32_t) * count, storage, indices);
+		}
+
+		_vao.bindElementBuffer(&_ebo);
+		_positionVao.bindElementBuffer(&_ebo);
+	}
+
+	template<CVertex TVertex>
+	template<CBufferStorageSpecifier TVertexStorage, CBufferStorageSpecifier TIndexStorage>
+	void Mesh<TVertex>::createFromFile(const std::filesystem::path& path, TVertexStorage vertexStorage, TIndexStorage indexStorage)
+	{
+		std::vector<TSourceVertex> vertices;
+		std::vector<uint32_t> indices;
+
+		_createFromFile(path, vertices, indices);
+
+		if (!vertices.empty() && !indices.empty())
+		{
+			vertices.resize(optimizeMesh(vertices.data(), vertices.size(), indices.data(), indices.size()));
+
+			std::vector<uint32_t> lodIndices;
+			std::vector<MeshLod> lods;
+			generateLodChain(indices.data(), indices.size(), vertices.data(), vertices.size(), lodIndices, lods);
+
+			if constexpr (std::same_as<TVertex, TSourceVertex>)
+			{
+				createNewVertices(vertices.data(), vertices.size(), vertexStorage);
+			}
+			else
+			{
+				std::vector<TVertex> encodedVertices(vertices.size());
+				TVertex::encode(vertices.data(), vertices.size(), encodedVertices.data(), _boundingBoxMin, _boundingBoxMax);
+				createNewVertices(encodedVertices.data(), encodedVertices.size(), vertexStorage);
+			}
+
+			createNewIndices(lodIndices.data(), lodIndices.size(), lods.data(), lods.size(), indexStorage);
+
+			std::vector<Meshlet> meshlets;
+			buildMeshlets(lodIndices.data(), lods[0].indexCount, vertices.data(), vertices.size(), meshlets);
+			setMeshlets(meshlets.data(), meshlets.size());
+
+			// The coarsest LOD is kept on the CPU for software occlusion culling
+
+			const std::vector<scp::f32vec3> positions = _lys::extractPositions(vertices.data(), vertices.size());
+			setOccluderGeometry(positions.data(), lodIndices.data() + lods.back().indexOffset, lods.back().indexCount);
+		}
+	}
+
+	template<CVertex TVertex>
+	void Mesh<TVertex>::updateVertices(const TVertex* vertices, uint32_t count, uint32_t offset)
+	{
+		if constexpr (TVertex::getStreamCount() == 1)
+		{
+			_vbo.update(vertices, sizeof(TVertex) * count, sizeof(TVertex) * offset);
+		}
+		else
+		{
+			std::vector<uint8_t> positions, attributes;
+			_lys::splitVertexStreams(vertices, count, positions, attributes);
+
+			_positionVbo.update(positions.data(), positions.size(), TVertex::getStreamSize(0) * offset);
+			_vbo.update(attributes.data(), attributes.size(), TVertex::getStreamSize(1) * offset);
+		}
+
+		if (!_compactVertices)
+		{
+			_lys::expandBoundingBox(vertices, count, _boundingBoxMin, _boundingBoxMax);
+			_worldBoundingBoxDirty = true;
+		}
+	}
+
+	template<CVertex TVertex>
+	void Mesh<TVertex>::updateIndices(const uint32_t* indices, uint32_t count, uint32_t offset)
+	{
+		if (_indexType == spl::IndexType::UnsignedShort)
+		{
+			const bool fits = count == 0 || *std::max_element(indices, indices + count) < UINT16_MAX;
+			if (fits)
+			{
+				std::vector<uint16_t> shortIndices(indices, indices + count);
+				_ebo.update(shortIndices.data(), sizeof(uint16_t) * count, sizeof(uint16_t) * offset);
+				return;
+			}
+
+			// The vertices were re-created larger since, the buffer is widened to 32 bits with the new indices. Read
+			// back once, truncated indices would draw wrong geometry.
+
+			const uint32_t indexCount = _ebo.getSize() / sizeof(uint16_t);
+			assert(offset + count <= indexCount);
+
+			std::vector<uint16_t> shortIndices(indexCount);
+			_ebo.getData(shortIndices.data(), sizeof(uint16_t) * indexCount);
+
+			std::vector<uint32_t> wideIndices(shortIndices.begin(), shortIndices.end());
+			std::copy(indices, indices + count, wideIndices.begin() + offset);
+
+			_indexType = spl::IndexType::UnsignedInt;
+			_ebo.createNew(sizeof(uint32_t) * indexCount, spl::BufferStorageFlags::DynamicStorage, wideIndices.data());
+
+			_vao.bindElementBuffer(&_ebo);
+			_positionVao.bindElementBuffer(&_ebo);
+		}
+		else
+		{
+			_ebo.update(indices, sizeof(uint32_t) * count, sizeof(uint32_t) * offset);
+		}
+	}
+
+	template<CVertex TVertex>
+	void Mesh<TVertex>::destroy()
+	{
+		_vbo.destroy();
+		_positionVbo.destroy();
+		_ebo.destroy();
+
+		_vertexCount = 0;
+		_lods.clear();
+		_meshlets.clear();
+		_occluderPositions.clear();
+		_occluderIndices.clear();
+	}
+
+	template<CVertex TVertex>
+	void Mesh<TVertex>::draw(spl::PrimitiveType primitiveType, uint32_t lod) const
+	{
+		assert(isValid());
+		assert(lod < _lods.size());
+
+		const uint32_t indexSize = _lys::getIndexSize(_indexType);
+		_vao.drawElements(primitiveType, _indexType, _lods[lod].indexOffset * indexSize, _lods[lod].indexCount);
+	}
+
+	template<CVertex TVertex>
+	void Mesh<TVertex>::drawPositions(spl::PrimitiveType primitiveType, uint32_t lod) const
+	{
+		assert(isValid());
+		assert(lod < _lods.size());
+
+		const uint32_t indexSize = _lys::getIndexSize(_indexType);
+		getPositionVertexArray().drawElements(primitiveType, _indexType, _lods[lod].indexOffset * indexSize, _lods[lod].indexCount);
+	}
+
+	template<CVertex TVertex>
+	const spl::VertexArray& Mesh<TVertex>::getVertexArray() const
+	{
+		return _vao;
+	}
+
+	template<CVertex TVertex>
+	spl::VertexArray& Mesh<TVertex>::getVertexArray()
+	{
+		return _vao;
+	}
+
+	template<CVertex TVertex>
+	const spl::VertexArray& Mesh<TVertex>::getPositionVertexArray() const
+	{
+		if constexpr (TVertex::getStreamCount() == 1)
+		{
+			return _vao;
+		}
+		else
+		{
+			return _positionVao;
+		}
+	}
+
+	template<CVertex TVertex>
+	spl::VertexArray& Mesh<TVertex>::getPositionVertexArray()
+	{
+		if constexpr (TVertex::getStreamCount() == 1)
+		{
+			return _vao;
+		}
+		else
+		{
+			return _positionVao;
+		}
+	}
+
+	template<CVertex TVertex>
+	const spl::Buffer& Mesh<TVertex>::getVertexBuffer() const
+	{
+		return _vbo;
+	}
+
+	template<CVertex TVertex>
+	spl::Buffer& Mesh<TVertex>::getVertexBuffer()
+	{
+		return _vbo;
+	}
+
+	template<CVertex TVertex>
+	const spl::Buffer& Mesh<TVertex>::getPositionBuffer() const
+	{
+		if constexpr (TVertex::getStreamCount() == 1)
+		{
+			return _vbo;
+		}
+		else
+		{
+			return _positionVbo;
+		}
+	}
+
+	template<CVertex TVertex>
+	spl::Buffer& Mesh<TVertex>::getPositionBuffer()
+	{
+		if constexpr (TVertex::getStreamCount() == 1)
+		{
+			return _vbo;
+		}
+		else
+		{
+			return _positionVbo;
+		}
+	}
+
+	template<CVertex TVertex>
+	const spl::Buffer& Mesh<TVertex>::getElementBuffer() const
+	{
+		return _ebo;
+	}
+
+	template<CVertex TVertex>
+	spl::Buffer& Mesh<TVertex>::getElementBuffer()
+	{
+		return _ebo;
+	}
+
+	template<CVertex TVertex>
+	spl::IndexType Mesh<TVertex>::getIndexType() const
+	{
+		return _indexType;
+	}
+
+	template<CVertex TVertex>
+	uint32_t Mesh<TVertex>::getVertexCount() const
+	{
+		return _vertexCount;
+	}
+
+	template<CVertex TVertex>
+	uint32_t Mesh<TVertex>::getIndexCount() const
+	{
+		return _ebo.getSize() / _lys::getIndexSize(_indexType);
+	}
+
+	template<CVertex TVertex>
+	bool Mesh<TVertex>::isValid() const
+	{
+		return _vbo.isValid() && _ebo.isValid() && (TVertex::getStreamCount() == 1 || _positionVbo.isValid());
+	}
+
+	template<CVertex TVertex>
+	void Mesh<TVertex>::_draw(uint32_t vertexInputMask, uint32_t lod) const
+	{
+		if constexpr (TVertex::getStreamCount() != 1)
+		{
+			if ((vertexInputMask & ~(1u << TVertex::specialIndices.position)) == 0)
+			{
+				drawPositions(spl::PrimitiveType::Triangles, lod);
+				return;
+			}
+		}
+
+		draw(spl::PrimitiveType::Triangles, lod);
+	}
+
+	template<CVertex TVertex>
+	void Mesh<TVertex>::_drawRanges(uint32_t vertexInputMask, const uint32_t* offsets, const uint32_t* counts, uint32_t rangeCount) const
+	{
+		assert(isValid());
+
+		const spl::VertexArray* vao = _getVertexArray(vertexInputMask);
+
+		const uint32_t indexSize = _lys::getIndexSize(_indexType);
+		for (uint32_t i = 0; i < rangeCount; ++i)
+		{
+			vao->drawElements(spl::PrimitiveType::Triangles, _indexType, offsets[i] * indexSize, counts[i]);
+		}
+	}
+
+	template<CVertex TVertex>
+	void Mesh<TVertex>::_drawIndirect(uint32_t vertexInputMask, uint64_t commandOffset, uint32_t commandCount) const
+	{
+		assert(isValid());
+
+		_getVertexArray(vertexInputMask)->multiDrawElementsIndirect(spl::PrimitiveType::Triangles, _indexType, commandOffset, commandCount);
+	}
+
+	template<CVertex TVertex>
+	void Mesh<TVertex>::_drawIndirectCount(uint32_t vertexInputMask, uint64_t commandOffset, uint64_t countOffset, uint32_t maxCommandCount) const
+	{
+		assert(isValid());
+
+		_getVertexArray(vertexInputMask)->multiDrawElementsIndirectCount(spl::PrimitiveType::Triangles, _indexType, commandOffset, countOffset, maxCommandCount);
+	}
+
+	template<CVertex TVertex>
+	const spl::VertexArray* Mesh<TVertex>::_getVertexArray(uint32_t vertexInputMask) const
+	{
+		if constexpr (TVertex::getStreamCount() != 1)
+		{
+			if ((vertexInputMask & ~(1u << TVertex::specialIndices.position)) == 0)
+			{
+				return &_positionVao;
+			}
+		}
+
+		return &_vao;
+	}
+
+	template<CVertex TVertex>
+	void Mesh<TVertex>::_bindVertexBuffers()
+	{
+		if constexpr (TVertex::getStreamCount() == 1)
+		{
+			_vao.bindArrayBuffer(&_vbo, 0, sizeof(TVertex));
+		}
+		else
+		{
+			_vao.bindArrayBuffer(&_positionVbo, 0, TVertex::getStreamSize(0));
+			_vao.bindArrayBuffer(&_vbo, 1, TVertex::getStreamSize(1));
+			_positionVao.bindArrayBuffer(&_positionVbo, 0, TVertex::getStreamSize(0));
+		}
+	}
+	
+	namespace _lys
+	{
+		inline uint64_t read(void* handle, uint8_t* data, uint64_t size)
+		{
+			return std::fread(data, 1, size, reinterpret_cast<std::FILE*>(handle));
+		}
+
+		inline bool eof(void* handle)
+		{
+			return std::feof(reinterpret_cast<std::FILE*>(handle));
+		}
+	}
+
+	template<CVertex TVertex>
+	void Mesh<TVertex>::_createFromFile(const std::filesystem::path& path, std::vector<TSourceVertex>& vertices, std::vector<uint32_t>& indices)
+	{
+		if (!std::filesystem::exists(path))
+		{
+			return;
+		}
+
+		std::FILE* file = std::fopen(path.string().c_str(), "rb");
+		if (!file)
+		{
+			return;
+		}
+
+		MeshFormat format;
+		if (_extensionToMeshFormat(path.extension(), format))
+		{
+			dsk::IStream* stream = new dsk::IStream(file, _lys::read, _lys::eof);
+			_createFromStream(stream, format, vertices, indices);
+			delete stream;
+		}
+	}
+
+	template<CVertex TVertex>
+	void Mesh<TVertex>::_createFromStream(dsk::IStream* stream, MeshFormat format, std::vector<TSourceVertex>& vertices, std::vector<uint32_t>& indices)
+	{
+		assert(stream);
+
+		(this->*(_meshFormatToLoadFunc[static_cast<size_t>(format)]))(stream, vertices, indices);
+	}
+
+	namespace _lys
+	{
+		struct ObjVertexKey
+		{
+			uint64_t position;
+			uint64_t normal;
+			uint64_t texCoord;
+
+			bool operator==(const ObjVertexKey& key) const = default;
+		};
+
+		struct ObjVertexKeyHash
+		{
+			size_t operator()(const ObjVertexKey& key) const
+			{
+				uint64_t h = key.position * 0x9e3779b97f4a7c15ull;
+				h = (h ^ (h >> 32) ^ key.normal) * 0xbf58476d1ce4e5b9ull;
+				h = (h ^ (h >> 29) ^ key.texCoord) * 0x94d049bb133111ebull;
+				return h ^ (h >> 31);
+			}
+		};
+
+		template<CVertex TVertex>
+		void fillVertices(std::vector<TVertex>& vertices, const std::vector<uint32_t>& indices)
+		{
+			JobSystem& jobSystem = JobSystem::getGlobal();
+
+			// Compute the face normal and tangent of every triangle, a null tangent is not accumulated
+
+			const uint32_t triangleCount = indices.size() / 3;
+			std::vector<scp::f32vec3> faceNormals(triangleCount);
+			std::vector<scp::f32vec3> faceTangents(triangleCount);
+
+			jobSystem.parallelFor(0, triangleCount, 4096, [&](uint32_t begin, uint32_t end) {
+				float dummy;
+
+				for (uint32_t i = begin; i < end; ++i)
+				{
+					const uint32_t i0 = indices[3 * i];
+					const uint32_t i1 = indices[3 * i + 1];
+					const uint32_t i2 = indices[3 * i + 2];
+
+					// Extract "position vectors", the face normal is weighted by the triangle area
+
+					scp::f32vec3 p0, p1, p2, e0, e1;
+					vertices[i0].getPosition(p0.x, p0.y, p0.z, dummy);
+					vertices[i1].getPosition(p1.x, p1.y, p1.z, dummy);
+					vertices[i2].getPosition(p2.x, p2.y, p2.z, dummy);
+					e0 = p1 - p0;
+					e1 = p2 - p1;
+
+					faceNormals[i] = scp::cross(e0, e1);
+					faceTangents[i] = { 0.f, 0.f, 0.f };
+
+					// Extract "tex coords vectors" and check they're not colinear
+
+					scp::f32vec2 tc0, tc1, tc2, d0, d1;
+					vertices[i0].getTexCoords(tc0.x, tc0.y, dummy, dummy);
+					vertices[i1].getTexCoords(tc1.x, tc1.y, dummy, dummy);
+					vertices[i2].getTexCoords(tc2.x, tc2.y, dummy, dummy);
+					d0 = tc1 - tc0;
+					d1 = tc2 - tc1;
+					const float det = d0.x * d1.y - d1.x * d0.y;
+					if (det == 0.f)
+					{
+						continue;
+					}
+
+					scp::f32vec3 t;
+					t = (d1.y * e0 - d0.y * e1) / det;
+					if (t.x == 0.f && t.y == 0.f && t.z == 0.f)
+					{
+						continue;
+					}
+
+					faceTangents[i] = scp::normalize(t);
+				}
+			});
+
+			// Accumulate them on the (welded) vertices of the triangles, in order so that the result does not depend on the threads
+
+			std::vector<scp::f32vec3> normals(vertices.size(), { 0.f, 0.f, 0.f });
+			std::vector<scp::f32vec3> tangents(vertices.size(), { 0.f, 0.f, 0.f });
+
+			for (uint32_t i = 0; i < triangleCount; ++i)
+			{
+				for (uint32_t j = 0; j < 3; ++j)
+				{
+					normals[indices[3 * i + j]] += faceNormals[i];
+					tangents[indices[3 * i + j]] += faceTangents[i];
+				}
+			}
+
+			// Compute tangents, orthogonal to the vertex normal (or to the accumulated face normals if there is none)
+
+			jobSystem.parallelFor(0, vertices.size(), 4096, [&](uint32_t begin, uint32_t end) {
+				float dummy;
+
+				for (uint32_t i = begin; i < end; ++i)
+				{
+					scp::f32vec3 n, t = tangents[i];
+					if (t.x == 0.f && t.y == 0.f && t.z == 0.f)
+					{
+						continue;
+					}
+
+					vertices[i].getNormal(n.x, n.y, n.z, dummy);
+					if (n.x == 0.f && n.y == 0.f && n.z == 0.f)
+					{
+						n = normals[i];
+						if (n.x == 0.f && n.y == 0.f && n.z == 0.f)
+						{
+							continue;
+						}
+						n = scp::normalize(n);
+					}
+
+					t = t - scp::dot(t, n) * n;
+					if (t.x == 0.f && t.y == 0.f && t.z == 0.f)
+					{
+						continue;
+					}
+					t = scp::normalize(t);
+
+					vertices[i].setTangent(t.x, t.y, t.z, 0.f);
+				}
+			});
+		}
+	}
+
+	template<CVertex TVertex>
+	void Mesh<TVertex>::_createFromObj(dsk::IStream* stream, std::vector<TSourceVertex>& vertices, std::vector<uint32_t>& indices)
+	{
+		dsk::fmt::ObjIStream objIStream(stream);
+
+		dsk::fmt::obj::File objFile;
+		objIStream.readFile(objFile);
+
+		// Face corners sharing the same position, normal and tex coords are welded in a single vertex
+
+		std::unordered_map<_lys::ObjVertexKey, uint32_t, _lys::ObjVertexKeyHash> vertexMap;
+		vertexMap.reserve(objFile.faces.size() * 3);
+		indices.reserve(objFile.faces.size() * 3);
+
+		std::vector<const dsk::fmt::obj::FaceVertex*> weldedVertices;
+		weldedVertices.reserve(objFile.faces.size() * 3);
+
+		for (const dsk::fmt::obj::Face& face : objFile.faces)
+		{
+			if (face.vertices.size() != 3)
+			{
+				continue;
+			}
+
+			for (const dsk::fmt::obj::FaceVertex& vertex : face.vertices)
+			{
+				assert(vertex.position != UINT64_MAX);
+
+				const auto [it, inserted] = vertexMap.try_emplace({ vertex.position, vertex.normal, vertex.texCoord }, weldedVertices.size());
+				indices.push_back(it->second);
+
+				if (inserted)
+				{
+					weldedVertices.push_back(&vertex);
+				}
+			}
+		}
+
+		// The vertices themselves do not depend on each other
+
+		vertices.resize(weldedVertices.size());
+
+		JobSystem::getGlobal().parallelFor(0, weldedVertices.size(), 4096, [&](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				const dsk::fmt::obj::FaceVertex& vertex = *weldedVertices[i];
+				TSourceVertex& outVertex = vertices[i];
+
+				outVertex.setPosition(objFile.positions[vertex.position].x, objFile.positions[vertex.position].y, objFile.positions[vertex.position].z, objFile.positions[vertex.position].w);
+
+				if (vertex.normal != UINT64_MAX)
+				{
+					outVertex.setNormal(objFile.normals[vertex.normal].i, objFile.normals[vertex.normal].j, objFile.normals[vertex.normal].k, 0.f);
+				}
+
+				if (vertex.texCoord != UINT64_MAX)
+				{
+					outVertex.setTexCoords(objFile.texCoords[vertex.texCoord].u, objFile.texCoords[vertex.texCoord].v, objFile.texCoords[vertex.texCoord].w, 0.f);
+				}
+			}
+		});
+
+		_lys::fillVertices(vertices, indices);
+	}
+
+	template<CVertex TVertex>
+	bool Mesh<TVertex>::_extensionToMeshFormat(const std::filesystem::path& extension, MeshFormat& format)
+	{
+		static const std::unordered_map<std::filesystem::path, MeshFormat> extensionToMeshFormat = {
+			{ ".obj", MeshFormat::Obj }
+		};
+
+		auto it = extensionToMeshFormat.find(extension);
+
+		if (it == extensionToMeshFormat.end())
+		{
+			return false;
+		}
+		else
+		{
+			format = it->second;
+			return true;
+		}
+	}
+}
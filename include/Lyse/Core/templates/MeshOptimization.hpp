@@ -0,0 +1,89 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/CoreDecl.hpp>
+
+namespace lys
+{
+	namespace _lys
+	{
+		template<CVertex TVertex>
+		std::vector<scp::f32vec3> extractPositions(const TVertex* vertices, uint32_t vertexCount)
+		{
+			float dummy;
+
+			std::vector<scp::f32vec3> positions(vertexCount);
+			for (uint32_t i = 0; i < vertexCount; ++i)
+			{
+				vertices[i].getPosition(positions[i].x, positions[i].y, positions[i].z, dummy);
+			}
+
+			return positions;
+		}
+	}
+
+	template<CVertex TVertex>
+	void optimizeOverdraw(uint32_t* indices, uint32_t indexCount, const TVertex* vertices, uint32_t vertexCount, float threshold, uint32_t cacheSize)
+	{
+		const std::vector<scp::f32vec3> positions = _lys::extractPositions(vertices, vertexCount);
+		optimizeOverdraw(indices, indexCount, positions.data(), vertexCount, threshold, cacheSize);
+	}
+
+	template<CVertex TVertex>
+	uint32_t optimizeVertexFetch(TVertex* vertices, uint32_t vertexCount, uint32_t* indices, uint32_t indexCount)
+	{
+		std::vector<uint32_t> remap(vertexCount);
+		const uint32_t newVertexCount = computeVertexFetchRemap(indices, indexCount, vertexCount, remap.data());
+
+		std::vector<TVertex> oldVertices(vertices, vertices + vertexCount);
+		for (uint32_t i = 0; i < vertexCount; ++i)
+		{
+			if (remap[i] != UINT32_MAX)
+			{
+				vertices[remap[i]] = oldVertices[i];
+			}
+		}
+
+		for (uint32_t i = 0; i < indexCount; ++i)
+		{
+			indices[i] = remap[indices[i]];
+		}
+
+		return newVertexCount;
+	}
+
+	template<CVertex TVertex>
+	uint32_t optimizeMesh(TVertex* vertices, uint32_t vertexCount, uint32_t* indices, uint32_t indexCount)
+	{
+		optimizeVertexCache(indices, indexCount, vertexCount);
+		optimizeOverdraw(indices, indexCount, vertices, vertexCount);
+		return optimizeVertexFetch(vertices, vertexCount, indices, indexCount);
+	}
+
+	template<CVertex TVertex>
+	uint32_t simplifyMesh(const uint32_t* indices, uint32_t indexCount, const TVertex* vertices, uint32_t vertexCount, uint32_t targetIndexCount, float targetError, uint32_t* simplifiedIndices, float& error)
+	{
+		const std::vector<scp::f32vec3> positions = _lys::extractPositions(vertices, vertexCount);
+		return simplifyMesh(indices, indexCount, positions.data(), vertexCount, targetIndexCount, targetError, simplifiedIndices, error);
+	}
+
+	template<CVertex TVertex>
+	void buildMeshlets(const uint32_t* indices, uint32_t indexCount, const TVertex* vertices, uint32_t vertexCount, std::vector<Meshlet>& meshlets, uint32_t maxVertexCount, uint32_t maxTriangleCount)
+	{
+		const std::vector<scp::f32vec3> positions = _lys::extractPositions(vertices, vertexCount);
+		buildMeshlets(indices, indexCount, positions.data(), vertexCount, meshlets, maxVertexCount, maxTriangleCount);
+	}
+
+	template<CVertex TVertex>
+	void generateLodChain(const uint32_t* indices, uint32_t indexCount, const TVertex* vertices, uint32_t vertexCount, std::vector<uint32_t>& lodIndices, std::vector<MeshLod>& lods, uint32_t maxLodCount)
+	{
+		const std::vector<scp::f32vec3> positions = _lys::extractPositions(vertices, vertexCount);
+		generateLodChain(indices, indexCount, positions.data(), vertexCount, lodIndices, lods, maxLodCount);
+	}
+}
@@ -0,0 +1,25 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/StateCache.hpp>
+
+namespace lys
+{
+	template<typename TValue>
+	void StateCache::setUniform(int32_t location, const TValue& value)
+	{
+		static_assert(sizeof(TValue) <= sizeof(Uniform::value));
+		assert(_shader);
+
+		if (_updateUniform(location, &value, sizeof(TValue)))
+		{
+			_shader->setUniform(location, value);
+		}
+	}
+}
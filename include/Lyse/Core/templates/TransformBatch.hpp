@@ -0,0 +1,51 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/TransformBatch.hpp>
+
+namespace lys
+{
+	template<typename TTransformable>
+	void TransformBatch::updateMatrices(const TTransformable* const* transformables, uint32_t count)
+	{
+		thread_local static TransformBatch batch;
+		thread_local static std::vector<const Transformable*> outdated;
+
+		outdated.clear();
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const Transformable* transformable = transformables[i];
+			if (!transformable->_transform.has_value() || !transformable->_invTransform.has_value())
+			{
+				outdated.push_back(transformable);
+			}
+		}
+
+		// Less than a block is not worth the copies, the matrices are computed when they are first requested
+
+		if (outdated.size() < blockSize)
+		{
+			return;
+		}
+
+		batch.resize(outdated.size());
+		for (uint32_t i = 0; i < outdated.size(); ++i)
+		{
+			batch.set(i, *outdated[i]);
+		}
+
+		batch.update();
+
+		for (uint32_t i = 0; i < outdated.size(); ++i)
+		{
+			outdated[i]->_transform = batch._transforms[i];
+			outdated[i]->_invTransform = batch._invTransforms[i];
+		}
+	}
+}
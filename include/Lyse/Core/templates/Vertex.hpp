@@ -1,196 +1,410 @@
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//! \file
-//! \author Reiex
-//! \copyright The MIT License (MIT)
-//! \date 2023
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-#include <Lyse/Core/CoreDecl.hpp>
-
-namespace lys
-{
-	namespace _lys
-	{
-		template<CVertexAttribute TAttribute, CVertexAttribute... TNextAttributes>
-		struct NextVertexBase
-		{
-			using Type = VertexBase<NoIndices, TNextAttributes...>;
-		};
-
-		template<CVertexAttribute TAttribute> struct NextVertexBase<TAttribute>
-		{
-			using Type = VertexBase<NoIndices, TAttribute>;
-		};
-	}
-
-	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
-	constexpr uint32_t VertexBase<SpecialIndices, TAttributes...>::getAttributeCount()
-	{
-		return sizeof...(TAttributes);
-	}
-
-	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
-	constexpr spl::GlslType VertexBase<SpecialIndices, TAttributes...>::getAttributeType(uint32_t i)
-	{
-		assert(i < sizeof...(TAttributes));
-
-		if (i == 0)
-		{
-			using TAttribute = std::tuple_element<0, std::tuple<TAttributes...>>::type;
-
-			if constexpr (spl::CGlslScalarType<TAttribute>)
-			{
-				return spl::_spl::glslScalarTypeToGlslType<TAttribute>();
-			}
-			else if constexpr (spl::CGlslVecType<TAttribute>)
-			{
-				return spl::_spl::glslVecTypeToGlslType<TAttribute>();
-			}
-			else
-			{
-				assert(false);
-				return spl::GlslType::Undefined;
-			}
-		}
-		else
-		{
-			return _lys::NextVertexBase<TAttributes...>::Type::getAttributeType(i - 1);
-		}
-	}
-
-	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
-	constexpr uint32_t VertexBase<SpecialIndices, TAttributes...>::getAttributeOffsetInStructure(uint32_t i)
-	{
-		assert(i < sizeof...(TAttributes));
-
-		if (i == 0)
-		{
-			return 0;
-		}
-		else
-		{
-			using TAttribute = std::tuple_element<0, std::tuple<TAttributes...>>::type;
-			return sizeof(TAttribute) + _lys::NextVertexBase<TAttributes...>::Type::getAttributeOffsetInStructure(i - 1);
-		}
-	}
-
-	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
-	constexpr const void* VertexBase<SpecialIndices, TAttributes...>::getAttribute(uint32_t i) const
-	{
-		return reinterpret_cast<const uint8_t*>(this) + getAttributeOffsetInStructure(i);
-	}
-
-	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
-	constexpr void* VertexBase<SpecialIndices, TAttributes...>::getAttribute(uint32_t i)
-	{
-		return reinterpret_cast<uint8_t*>(this) + getAttributeOffsetInStructure(i);
-	}
-
-	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
-	constexpr void VertexBase<SpecialIndices, TAttributes...>::setPosition(float x, float y, float z, float w)
-	{
-		_setVector<SpecialIndices.position>(x, y, z, w);
-	}
-
-	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
-	constexpr void VertexBase<SpecialIndices, TAttributes...>::setNormal(float x, float y, float z, float w)
-	{
-		_setVector<SpecialIndices.normal>(x, y, z, w);
-	}
-
-	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
-	constexpr void VertexBase<SpecialIndices, TAttributes...>::setTangent(float x, float y, float z, float w)
-	{
-		_setVector<SpecialIndices.tangent>(x, y, z, w);
-	}
-
-	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
-	constexpr void VertexBase<SpecialIndices, TAttributes...>::setTexCoords(float x, float y, float z, float w)
-	{
-		_setVector<SpecialIndices.texCoords>(x, y, z, w);
-	}
-
-	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
-	constexpr void VertexBase<SpecialIndices, TAttributes...>::getPosition(float& x, float& y, float& z, float& w) const
-	{
-		_getVector<SpecialIndices.position>(x, y, z, w);
-	}
-
-	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
-	constexpr void VertexBase<SpecialIndices, TAttributes...>::getNormal(float& x, float& y, float& z, float& w) const
-	{
-		_getVector<SpecialIndices.normal>(x, y, z, w);
-	}
-
-	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
-	constexpr void VertexBase<SpecialIndices, TAttributes...>::getTangent(float& x, float& y, float& z, float& w) const
-	{
-		_getVector<SpecialIndices.tangent>(x, y, z, w);
-	}
-
-	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
-	constexpr void VertexBase<SpecialIndices, TAttributes...>::getTexCoords(float& x, float& y, float& z, float& w) const
-	{
-		_getVector<SpecialIndices.texCoords>(x, y, z, w);
-	}
-
-	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
-	template<uint32_t Index>
-	constexpr void VertexBase<SpecialIndices, TAttributes...>::_setVector(float x, float y, float z, float w)
-	{
-		if constexpr (Index != UINT32_MAX)
-		{
-			using TAttr = AttributeType<Index>;
-			static_assert(scp::CVec<TAttr> && TAttr::size == 4);
-
-			TAttr& attr = *reinterpret_cast<TAttr*>(getAttribute(Index));
-			attr.x = x;
-			attr.y = y;
-			attr.z = z;
-			attr.w = w;
-		}
-	}
-
-	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
-	template<uint32_t Index>
-	constexpr void VertexBase<SpecialIndices, TAttributes...>::_getVector(float& x, float& y, float& z, float& w) const
-	{
-		if constexpr (Index != UINT32_MAX)
-		{
-			using TAttr = AttributeType<Index>;
-			static_assert(scp::CVec<TAttr> && TAttr::size == 4);
-
-			const TAttr& attr = *reinterpret_cast<const TAttr*>(getAttribute(Index));
-			x = attr.x;
-			y = attr.y;
-			z = attr.z;
-			w = attr.w;
-		}
-		else
-		{
-			x = 0.f;
-			y = 0.f;
-			z = 0.f;
-			w = 0.f;
-		}
-	}
-
-
-	constexpr VertexDefaultMesh::VertexDefaultMesh() :
-		position(0.f, 0.f, 0.f, 1.f),
-		normal(0.f, 0.f, 0.f, 0.f),
-		tangent(0.f, 0.f, 0.f, 0.f),
-		texCoords(0.f, 0.f, 0.f, 0.f)
-	{
-	}
-
-	constexpr VertexDefaultMesh::VertexDefaultMesh(const scp::f32vec4& p, const scp::f32vec4& n, const scp::f32vec4& t, const scp::f32vec4& tc) :
-		position(p),
-		normal(n),
-		tangent(t),
-		texCoords(tc)
-	{
-	}
-}
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <Lyse/Core/CoreDecl.hpp>
+
+namespace lys
+{
+	namespace _lys
+	{
+		template<CVertexAttribute TAttribute, CVertexAttribute... TNextAttributes>
+		struct NextVertexBase
+		{
+			using Type = VertexBase<NoIndices, TNextAttributes...>;
+		};
+
+		template<CVertexAttribute TAttribute> struct NextVertexBase<TAttribute>
+		{
+			using Type = VertexBase<NoIndices, TAttribute>;
+		};
+	}
+
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	constexpr uint32_t VertexBase<SpecialIndices, TAttributes...>::getAttributeCount()
+	{
+		return sizeof...(TAttributes);
+	}
+
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	constexpr spl::GlslType VertexBase<SpecialIndices, TAttributes...>::getAttributeType(uint32_t i)
+	{
+		assert(i < sizeof...(TAttributes));
+
+		if (i == 0)
+		{
+			using TAttribute = std::tuple_element<0, std::tuple<TAttributes...>>::type;
+
+			if constexpr (spl::CGlslScalarType<TAttribute>)
+			{
+				return spl::_spl::glslScalarTypeToGlslType<TAttribute>();
+			}
+			else if constexpr (spl::CGlslVecType<TAttribute>)
+			{
+				return spl::_spl::glslVecTypeToGlslType<TAttribute>();
+			}
+			else
+			{
+				assert(false);
+				return spl::GlslType::Undefined;
+			}
+		}
+		else
+		{
+			return _lys::NextVertexBase<TAttributes...>::Type::getAttributeType(i - 1);
+		}
+	}
+
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	constexpr uint32_t VertexBase<SpecialIndices, TAttributes...>::getAttributeSize(uint32_t i)
+	{
+		assert(i < sizeof...(TAttributes));
+
+		if (i == 0)
+		{
+			using TAttribute = std::tuple_element<0, std::tuple<TAttributes...>>::type;
+			return sizeof(TAttribute);
+		}
+		else
+		{
+			return _lys::NextVertexBase<TAttributes...>::Type::getAttributeSize(i - 1);
+		}
+	}
+
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	constexpr uint32_t VertexBase<SpecialIndices, TAttributes...>::getAttributeOffsetInStructure(uint32_t i)
+	{
+		assert(i < sizeof...(TAttributes));
+
+		if (i == 0)
+		{
+			return 0;
+		}
+		else
+		{
+			using TAttribute = std::tuple_element<0, std::tuple<TAttributes...>>::type;
+			return sizeof(TAttribute) + _lys::NextVertexBase<TAttributes...>::Type::getAttributeOffsetInStructure(i - 1);
+		}
+	}
+
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	constexpr uint32_t VertexBase<SpecialIndices, TAttributes...>::getStreamCount()
+	{
+		return (SpecialIndices.position != UINT32_MAX && sizeof...(TAttributes) > 1) ? 2 : 1;
+	}
+
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	constexpr uint32_t VertexBase<SpecialIndices, TAttributes...>::getStreamSize(uint32_t stream)
+	{
+		assert(stream < getStreamCount());
+
+		uint32_t size = 0;
+		for (uint32_t i = 0; i < sizeof...(TAttributes); ++i)
+		{
+			if (getAttributeStream(i) == stream)
+			{
+				size += getAttributeSize(i);
+			}
+		}
+
+		return size;
+	}
+
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	constexpr uint32_t VertexBase<SpecialIndices, TAttributes...>::getAttributeStream(uint32_t i)
+	{
+		assert(i < sizeof...(TAttributes));
+
+		if (getStreamCount() == 1)
+		{
+			return 0;
+		}
+		else
+		{
+			return i == SpecialIndices.position ? 0 : 1;
+		}
+	}
+
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	constexpr uint32_t VertexBase<SpecialIndices, TAttributes...>::getAttributeOffsetInStream(uint32_t i)
+	{
+		assert(i < sizeof...(TAttributes));
+
+		const uint32_t stream = getAttributeStream(i);
+
+		uint32_t offset = 0;
+		for (uint32_t j = 0; j < i; ++j)
+		{
+			if (getAttributeStream(j) == stream)
+			{
+				offset += getAttributeSize(j);
+			}
+		}
+
+		return offset;
+	}
+
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	constexpr const void* VertexBase<SpecialIndices, TAttributes...>::getAttribute(uint32_t i) const
+	{
+		return reinterpret_cast<const uint8_t*>(this) + getAttributeOffsetInStructure(i);
+	}
+
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	constexpr void* VertexBase<SpecialIndices, TAttributes...>::getAttribute(uint32_t i)
+	{
+		return reinterpret_cast<uint8_t*>(this) + getAttributeOffsetInStructure(i);
+	}
+
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	constexpr void VertexBase<SpecialIndices, TAttributes...>::copyStreamTo(uint32_t stream, void* dst) const
+	{
+		assert(stream < getStreamCount());
+
+		for (uint32_t i = 0; i < sizeof...(TAttributes); ++i)
+		{
+			if (getAttributeStream(i) == stream)
+			{
+				std::memcpy(reinterpret_cast<uint8_t*>(dst) + getAttributeOffsetInStream(i), getAttribute(i), getAttributeSize(i));
+			}
+		}
+	}
+
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	constexpr void VertexBase<SpecialIndices, TAttributes...>::setPosition(float x, float y, float z, float w)
+	{
+		_setVector<SpecialIndices.position>(x, y, z, w);
+	}
+
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	constexpr void VertexBase<SpecialIndices, TAttributes...>::setNormal(float x, float y, float z, float w)
+	{
+		_setVector<SpecialIndices.normal>(x, y, z, w);
+	}
+
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	constexpr void VertexBase<SpecialIndices, TAttributes...>::setTangent(float x, float y, float z, float w)
+	{
+		_setVector<SpecialIndices.tangent>(x, y, z, w);
+	}
+
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	constexpr void VertexBase<SpecialIndices, TAttributes...>::setTexCoords(float x, float y, float z, float w)
+	{
+		_setVector<SpecialIndices.texCoords>(x, y, z, w);
+	}
+
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	constexpr void VertexBase<SpecialIndices, TAttributes...>::getPosition(float& x, float& y, float& z, float& w) const
+	{
+		_getVector<SpecialIndices.position>(x, y, z, w);
+	}
+
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	constexpr void VertexBase<SpecialIndices, TAttributes...>::getNormal(float& x, float& y, float& z, float& w) const
+	{
+		_getVector<SpecialIndices.normal>(x, y, z, w);
+	}
+
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	constexpr void VertexBase<SpecialIndices, TAttributes...>::getTangent(float& x, float& y, float& z, float& w) const
+	{
+		_getVector<SpecialIndices.tangent>(x, y, z, w);
+	}
+
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	constexpr void VertexBase<SpecialIndices, TAttributes...>::getTexCoords(float& x, float& y, float& z, float& w) const
+	{
+		_getVector<SpecialIndices.texCoords>(x, y, z, w);
+	}
+
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	template<uint32_t Index>
+	constexpr void VertexBase<SpecialIndices, TAttributes...>::_setVector(float x, float y, float z, float w)
+	{
+		if constexpr (Index != UINT32_MAX)
+		{
+			using TAttr = AttributeType<Index>;
+			static_assert(scp::CVec<TAttr> && TAttr::size == 4);
+
+			TAttr& attr = *reinterpret_cast<TAttr*>(getAttribute(Index));
+			attr.x = x;
+			attr.y = y;
+			attr.z = z;
+			attr.w = w;
+		}
+	}
+
+	template<VertexSpecialIndices SpecialIndices, CVertexAttribute... TAttributes>
+	template<uint32_t Index>
+	constexpr void VertexBase<SpecialIndices, TAttributes...>::_getVector(float& x, float& y, float& z, float& w) const
+	{
+		if constexpr (Index != UINT32_MAX)
+		{
+			using TAttr = AttributeType<Index>;
+			static_assert(scp::CVec<TAttr> && TAttr::size == 4);
+
+			const TAttr& attr = *reinterpret_cast<const TAttr*>(getAttribute(Index));
+			x = attr.x;
+			y = attr.y;
+			z = attr.z;
+			w = attr.w;
+		}
+		else
+		{
+			x = 0.f;
+			y = 0.f;
+			z = 0.f;
+			w = 0.f;
+		}
+	}
+
+
+	constexpr VertexDefaultMesh::VertexDefaultMesh() :
+		position(0.f, 0.f, 0.f, 1.f),
+		normal(0.f, 0.f, 0.f, 0.f),
+		tangent(0.f, 0.f, 0.f, 0.f),
+		texCoords(0.f, 0.f, 0.f, 0.f)
+	{
+	}
+
+	constexpr VertexDefaultMesh::VertexDefaultMesh(const scp::f32vec4& p, const scp::f32vec4& n, const scp::f32vec4& t, const scp::f32vec4& tc) :
+		position(p),
+		normal(n),
+		tangent(t),
+		texCoords(tc)
+	{
+	}
+
+	namespace _lys
+	{
+		inline uint16_t floatToHalf(float x)
+		{
+			const uint32_t bits = std::bit_cast<uint32_t>(x);
+			const uint32_t sign = (bits >> 16) & 0x8000;
+			const int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xff) - 112;
+			uint32_t mantissa = bits & 0x007fffff;
+
+			// Too small, flushed to zero or encoded as a subnormal half
+
+			if (exponent <= 0)
+			{
+				if (exponent < -10)
+				{
+					return sign;
+				}
+
+				mantissa |= 0x00800000;
+				const uint32_t shift = 14 - exponent;
+				return sign | ((mantissa + (1 << (shift - 1))) >> shift);
+			}
+
+			// Too big, infinity or NaN
+
+			if (exponent >= 31)
+			{
+				const bool isNan = ((bits & 0x7f800000) == 0x7f800000) && mantissa;
+				return sign | 0x7c00 | (isNan ? 0x0200 : 0);
+			}
+
+			// Rounding may carry in the exponent, which is the correct result
+
+			return (sign | (exponent << 10) | (mantissa >> 13)) + ((mantissa >> 12) & 1);
+		}
+
+		inline uint16_t floatToSnorm16(float x)
+		{
+			return static_cast<uint16_t>(static_cast<int16_t>(std::round(std::clamp(x, -1.f, 1.f) * 32767.f)));
+		}
+
+		inline uint16_t floatToUnorm16(float x)
+		{
+			return static_cast<uint16_t>(std::round(std::clamp(x, 0.f, 1.f) * 65535.f));
+		}
+
+		inline uint32_t encodeOctahedral(float x, float y, float z)
+		{
+			const float norm = std::abs(x) + std::abs(y) + std::abs(z);
+			if (norm == 0.f)
+			{
+				return 0;
+			}
+
+			float u = x / norm;
+			float v = y / norm;
+
+			// Fold the lower hemisphere onto the corners of the square
+
+			if (z < 0.f)
+			{
+				const float foldedU = (1.f - std::abs(v)) * (u >= 0.f ? 1.f : -1.f);
+				const float foldedV = (1.f - std::abs(u)) * (v >= 0.f ? 1.f : -1.f);
+				u = foldedU;
+				v = foldedV;
+			}
+
+			return floatToSnorm16(u) | (static_cast<uint32_t>(floatToSnorm16(v)) << 16);
+		}
+	}
+
+	constexpr VertexCompactMesh::VertexCompactMesh() :
+		position(0, 0),
+		normal(0),
+		tangent(0),
+		texCoords(0)
+	{
+	}
+
+	inline void VertexCompactMesh::encode(const VertexDefaultMesh* vertices, uint32_t count, VertexCompactMesh* compactVertices, scp::f32vec3& boundingBoxMin, scp::f32vec3& boundingBoxMax)
+	{
+		assert(vertices || count == 0);
+		assert(compactVertices || count == 0);
+
+		boundingBoxMin = { 0.f, 0.f, 0.f };
+		boundingBoxMax = { 0.f, 0.f, 0.f };
+
+		if (count == 0)
+		{
+			return;
+		}
+
+		boundingBoxMin = { vertices[0].position.x, vertices[0].position.y, vertices[0].position.z };
+		boundingBoxMax = boundingBoxMin;
+		for (uint32_t i = 1; i < count; ++i)
+		{
+			boundingBoxMin.x = std::min(boundingBoxMin.x, vertices[i].position.x);
+			boundingBoxMin.y = std::min(boundingBoxMin.y, vertices[i].position.y);
+			boundingBoxMin.z = std::min(boundingBoxMin.z, vertices[i].position.z);
+			boundingBoxMax.x = std::max(boundingBoxMax.x, vertices[i].position.x);
+			boundingBoxMax.y = std::max(boundingBoxMax.y, vertices[i].position.y);
+			boundingBoxMax.z = std::max(boundingBoxMax.z, vertices[i].position.z);
+		}
+
+		const scp::f32vec3 extent = boundingBoxMax - boundingBoxMin;
+		const scp::f32vec3 invExtent = {
+			extent.x != 0.f ? 1.f / extent.x : 0.f,
+			extent.y != 0.f ? 1.f / extent.y : 0.f,
+			extent.z != 0.f ? 1.f / extent.z : 0.f
+		};
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const VertexDefaultMesh& src = vertices[i];
+			VertexCompactMesh& dst = compactVertices[i];
+
+			const uint32_t x = _lys::floatToUnorm16((src.position.x - boundingBoxMin.x) * invExtent.x);
+			const uint32_t y = _lys::floatToUnorm16((src.position.y - boundingBoxMin.y) * invExtent.y);
+			const uint32_t z = _lys::floatToUnorm16((src.position.z - boundingBoxMin.z) * invExtent.z);
+			dst.position = { x | (y << 16), z };
+
+			dst.normal = _lys::encodeOctahedral(src.normal.x, src.normal.y, src.normal.z);
+			dst.tangent = _lys::encodeOctahedral(src.tangent.x, src.tangent.y, src.tangent.z);
+			dst.texCoords = _lys::floatToHalf(src.texCoords.x) | (static_cast<uint32_t>(_lys::floatToHalf(src.texCoords.y)) << 16);
+		}
+	}
+}
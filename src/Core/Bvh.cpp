@@ -0,0 +1,500 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <Lyse/Core/Core.hpp>
+
+namespace lys
+{
+	namespace
+	{
+		float surfaceArea(const scp::f32vec3& min, const scp::f32vec3& max)
+		{
+			const scp::f32vec3 size = max - min;
+			return 2.f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+	}
+
+	Bvh::Bvh() :
+		_nodes(),
+		_root(nullIndex),
+		_freeNodes(nullIndex),
+		_leafCount(0)
+	{
+	}
+
+	uint32_t Bvh::insert(const Drawable* drawable, const scp::f32vec3& min, const scp::f32vec3& max)
+	{
+		assert(drawable);
+		assert(min.x <= max.x && min.y <= max.y && min.z <= max.z);
+
+		const uint32_t leaf = _allocateNode();
+		_nodes[leaf].min = min;
+		_nodes[leaf].max = max;
+		_nodes[leaf].drawable = drawable;
+
+		_insertLeaf(leaf);
+		++_leafCount;
+
+		return leaf;
+	}
+
+	void Bvh::remove(uint32_t leaf)
+	{
+		assert(leaf < _nodes.size() && _nodes[leaf].drawable);
+
+		_removeLeaf(leaf);
+		_freeNode(leaf);
+		--_leafCount;
+	}
+
+	void Bvh::refit(uint32_t leaf, const scp::f32vec3& min, const scp::f32vec3& max)
+	{
+		assert(leaf < _nodes.size() && _nodes[leaf].drawable);
+		assert(min.x <= max.x && min.y <= max.y && min.z <= max.z);
+
+		_nodes[leaf].min = min;
+		_nodes[leaf].max = max;
+
+		_refitAncestors(_nodes[leaf].parent);
+	}
+
+	void Bvh::rebuild()
+	{
+		if (_root == nullIndex)
+		{
+			return;
+		}
+
+		// Keep the leaves, free the internal nodes and build them again top-down
+
+		std::vector<uint32_t> leaves;
+		leaves.reserve(_leafCount);
+
+		std::vector<uint32_t> stack(1, _root);
+		while (!stack.empty())
+		{
+			const uint32_t index = stack.back();
+			stack.pop_back();
+
+			if (_nodes[index].drawable)
+			{
+				leaves.push_back(index);
+			}
+			else
+			{
+				stack.push_back(_nodes[index].children[0]);
+				stack.push_back(_nodes[index].children[1]);
+				_freeNode(index);
+			}
+		}
+
+		_root = _build(leaves.data(), leaves.size());
+		_nodes[_root].parent = nullIndex;
+	}
+
+	void Bvh::clear()
+	{
+		_nodes.clear();
+		_root = nullIndex;
+		_freeNodes = nullIndex;
+		_leafCount = 0;
+	}
+
+	void Bvh::queryFrustum(const Frustum& frustum, std::vector<const Drawable*>& drawables) const
+	{
+		_query([&](const scp::f32vec3& min, const scp::f32vec3& max) {
+			return frustum.intersectsBox(min, max);
+		}, drawables);
+	}
+
+	void Bvh::querySphere(const scp::f32vec3& center, float radius, std::vector<const Drawable*>& drawables) const
+	{
+		assert(radius >= 0.f);
+
+		_query([&](const scp::f32vec3& min, const scp::f32vec3& max) {
+			return boxIntersectsSphere(min, max, center, radius);
+		}, drawables);
+	}
+
+	void Bvh::queryBox(const scp::f32vec3& min, const scp::f32vec3& max, std::vector<const Drawable*>& drawables) const
+	{
+		assert(min.x <= max.x && min.y <= max.y && min.z <= max.z);
+
+		_query([&](const scp::f32vec3& nodeMin, const scp::f32vec3& nodeMax) {
+			return boxIntersectsBox(nodeMin, nodeMax, min, max);
+		}, drawables);
+	}
+
+	void Bvh::queryRay(const scp::f32vec3& origin, const scp::f32vec3& direction, float maxDistance, std::vector<const Drawable*>& drawables) const
+	{
+		assert(maxDistance >= 0.f);
+
+		drawables.clear();
+
+		if (_root == nullIndex)
+		{
+			return;
+		}
+
+		const scp::f32vec3 invDirection = { 1.f / direction.x, 1.f / direction.y, 1.f / direction.z };
+
+		thread_local static std::vector<uint32_t> stack;
+		thread_local static std::vector<std::pair<float, const Drawable*>> hits;
+
+		stack.assign(1, _root);
+		hits.clear();
+
+		while (!stack.empty())
+		{
+			const Node& node = _nodes[stack.back()];
+			stack.pop_back();
+
+			float distance;
+			if (!boxIntersectsRay(node.min, node.max, origin, invDirection, maxDistance, distance))
+			{
+				continue;
+			}
+
+			if (node.drawable)
+			{
+				hits.push_back({ distance, node.drawable });
+			}
+			else
+			{
+				stack.push_back(node.children[0]);
+				stack.push_back(node.children[1]);
+			}
+		}
+
+		std::sort(hits.begin(), hits.end(), [](const std::pair<float, const Drawable*>& a, const std::pair<float, const Drawable*>& b) {
+			return a.first < b.first;
+		});
+
+		for (const std::pair<float, const Drawable*>& hit : hits)
+		{
+			drawables.push_back(hit.second);
+		}
+	}
+
+	uint32_t Bvh::getLeafCount() const
+	{
+		return _leafCount;
+	}
+
+	bool Bvh::boxIntersectsSphere(const scp::f32vec3& min, const scp::f32vec3& max, const scp::f32vec3& center, float radius)
+	{
+		const scp::f32vec3 offset = center - scp::max(min, scp::min(center, max));
+		return scp::dot(offset, offset) <= radius * radius;
+	}
+
+	bool Bvh::boxIntersectsBox(const scp::f32vec3& min, const scp::f32vec3& max, const scp::f32vec3& boxMin, const scp::f32vec3& boxMax)
+	{
+		return min.x <= boxMax.x && max.x >= boxMin.x && min.y <= boxMax.y && max.y >= boxMin.y && min.z <= boxMax.z && max.z >= boxMin.z;
+	}
+
+	bool Bvh::boxIntersectsRay(const scp::f32vec3& min, const scp::f32vec3& max, const scp::f32vec3& origin, const scp::f32vec3& invDirection, float maxDistance, float& distance)
+	{
+		const scp::f32vec3 t0 = (min - origin) * invDirection;
+		const scp::f32vec3 t1 = (max - origin) * invDirection;
+
+		const float tEnter = std::max({ std::min(t0.x, t1.x), std::min(t0.y, t1.y), std::min(t0.z, t1.z), 0.f });
+		const float tExit = std::min({ std::max(t0.x, t1.x), std::max(t0.y, t1.y), std::max(t0.z, t1.z), maxDistance });
+
+		distance = tEnter;
+		return tEnter <= tExit;
+	}
+
+	uint32_t Bvh::_allocateNode()
+	{
+		uint32_t index;
+		if (_freeNodes != nullIndex)
+		{
+			index = _freeNodes;
+			_freeNodes = _nodes[index].parent;
+		}
+		else
+		{
+			index = _nodes.size();
+			_nodes.emplace_back();
+		}
+
+		Node& node = _nodes[index];
+		node.parent = nullIndex;
+		node.children[0] = nullIndex;
+		node.children[1] = nullIndex;
+		node.drawable = nullptr;
+
+		return index;
+	}
+
+	void Bvh::_freeNode(uint32_t node)
+	{
+		_nodes[node].parent = _freeNodes;
+		_nodes[node].drawable = nullptr;
+		_freeNodes = node;
+	}
+
+	void Bvh::_insertLeaf(uint32_t leaf)
+	{
+		if (_root == nullIndex)
+		{
+			_root = leaf;
+			_nodes[leaf].parent = nullIndex;
+			return;
+		}
+
+		// Go down towards the sibling whose merge with the leaf increases the surface area of the tree the least
+
+		const scp::f32vec3 leafMin = _nodes[leaf].min;
+		const scp::f32vec3 leafMax = _nodes[leaf].max;
+
+		uint32_t sibling = _root;
+		while (!_nodes[sibling].drawable)
+		{
+			const Node& node = _nodes[sibling];
+
+			const float area = surfaceArea(node.min, node.max);
+			const float combinedArea = surfaceArea(scp::min(node.min, leafMin), scp::max(node.max, leafMax));
+
+			// Cost of making a new parent for this node and the leaf, and cost pushed down to the children
+
+			const float cost = 2.f * combinedArea;
+			const float inheritanceCost = 2.f * (combinedArea - area);
+
+			float childCosts[2];
+			for (uint32_t i = 0; i < 2; ++i)
+			{
+				const Node& child = _nodes[node.children[i]];
+				childCosts[i] = surfaceArea(scp::min(child.min, leafMin), scp::max(child.max, leafMax)) + inheritanceCost;
+				if (!child.drawable)
+				{
+					childCosts[i] -= surfaceArea(child.min, child.max);
+				}
+			}
+
+			if (cost < childCosts[0] && cost < childCosts[1])
+			{
+				break;
+			}
+
+			sibling = node.children[childCosts[0] <= childCosts[1] ? 0 : 1];
+		}
+
+		// Replace the sibling by a new parent of the sibling and the leaf
+
+		const uint32_t oldParent = _nodes[sibling].parent;
+		const uint32_t newParent = _allocateNode();
+
+		_nodes[newParent].parent = oldParent;
+		_nodes[newParent].children[0] = sibling;
+		_nodes[newParent].children[1] = leaf;
+		_nodes[newParent].min = scp::min(_nodes[sibling].min, leafMin);
+		_nodes[newParent].max = scp::max(_nodes[sibling].max, leafMax);
+
+		if (oldParent != nullIndex)
+		{
+			uint32_t* children = _nodes[oldParent].children;
+			children[children[0] == sibling ? 0 : 1] = newParent;
+		}
+		else
+		{
+			_root = newParent;
+		}
+
+		_nodes[sibling].parent = newParent;
+		_nodes[leaf].parent = newParent;
+
+		_refitAncestors(oldParent);
+	}
+
+	void Bvh::_removeLeaf(uint32_t leaf)
+	{
+		if (leaf == _root)
+		{
+			_root = nullIndex;
+			return;
+		}
+
+		const uint32_t parent = _nodes[leaf].parent;
+		const uint32_t grandParent = _nodes[parent].parent;
+		const uint32_t sibling = _nodes[parent].children[_nodes[parent].children[0] == leaf ? 1 : 0];
+
+		if (grandParent != nullIndex)
+		{
+			uint32_t* children = _nodes[grandParent].children;
+			children[children[0] == parent ? 0 : 1] = sibling;
+			_nodes[sibling].parent = grandParent;
+
+			_refitAncestors(grandParent);
+		}
+		else
+		{
+			_root = sibling;
+			_nodes[sibling].parent = nullIndex;
+		}
+
+		_freeNode(parent);
+	}
+
+	void Bvh::_refitAncestors(uint32_t node)
+	{
+		while (node != nullIndex)
+		{
+			const Node& child0 = _nodes[_nodes[node].children[0]];
+			const Node& child1 = _nodes[_nodes[node].children[1]];
+
+			_nodes[node].min = scp::min(child0.min, child1.min);
+			_nodes[node].max = scp::max(child0.max, child1.max);
+
+			node = _nodes[node].parent;
+		}
+	}
+
+	uint32_t Bvh::_build(uint32_t* leaves, uint32_t count)
+	{
+		assert(count > 0);
+
+		if (count == 1)
+		{
+			return leaves[0];
+		}
+
+		// Split along the largest axis of the centroids, at the bin boundary with the lowest surface area heuristic
+
+		scp::f32vec3 centroidMin = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+		scp::f32vec3 centroidMax = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const scp::f32vec3 centroid = (_nodes[leaves[i]].min + _nodes[leaves[i]].max) * 0.5f;
+			centroidMin = scp::min(centroidMin, centroid);
+			centroidMax = scp::max(centroidMax, centroid);
+		}
+
+		const scp::f32vec3 extent = centroidMax - centroidMin;
+		const uint32_t axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z ? 1 : 2);
+		const float axisMin = (&centroidMin.x)[axis];
+		const float axisExtent = (&extent.x)[axis];
+
+		const auto getCentroid = [&](uint32_t leaf) {
+			return ((&_nodes[leaf].min.x)[axis] + (&_nodes[leaf].max.x)[axis]) * 0.5f;
+		};
+
+		uint32_t* middle = leaves + count / 2;
+		if (axisExtent > 0.f)
+		{
+			const auto getBin = [&](uint32_t leaf) {
+				return std::min(static_cast<uint32_t>((getCentroid(leaf) - axisMin) / axisExtent * binCount), binCount - 1);
+			};
+
+			uint32_t binLeafCounts[binCount] = {};
+			scp::f32vec3 binMins[binCount];
+			scp::f32vec3 binMaxs[binCount];
+			std::fill_n(binMins, binCount, scp::f32vec3(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()));
+			std::fill_n(binMaxs, binCount, scp::f32vec3(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()));
+
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				const uint32_t bin = getBin(leaves[i]);
+				++binLeafCounts[bin];
+				binMins[bin] = scp::min(binMins[bin], _nodes[leaves[i]].min);
+				binMaxs[bin] = scp::max(binMaxs[bin], _nodes[leaves[i]].max);
+			}
+
+			// Right to left sweep for the areas on the right of each boundary, then left to right for the costs
+
+			float rightCosts[binCount];
+			scp::f32vec3 rightMin = binMins[binCount - 1];
+			scp::f32vec3 rightMax = binMaxs[binCount - 1];
+			uint32_t rightCount = 0;
+			for (uint32_t i = binCount - 1; i > 0; --i)
+			{
+				rightMin = scp::min(rightMin, binMins[i]);
+				rightMax = scp::max(rightMax, binMaxs[i]);
+				rightCount += binLeafCounts[i];
+				rightCosts[i] = rightCount ? surfaceArea(rightMin, rightMax) * rightCount : 0.f;
+			}
+
+			uint32_t bestSplit = 0;
+			float bestCost = std::numeric_limits<float>::max();
+			scp::f32vec3 leftMin = binMins[0];
+			scp::f32vec3 leftMax = binMaxs[0];
+			uint32_t leftCount = 0;
+			for (uint32_t i = 1; i < binCount; ++i)
+			{
+				leftMin = scp::min(leftMin, binMins[i - 1]);
+				leftMax = scp::max(leftMax, binMaxs[i - 1]);
+				leftCount += binLeafCounts[i - 1];
+
+				const float cost = (leftCount ? surfaceArea(leftMin, leftMax) * leftCount : 0.f) + rightCosts[i];
+				if (leftCount != 0 && leftCount != count && cost < bestCost)
+				{
+					bestCost = cost;
+					bestSplit = i;
+				}
+			}
+
+			if (bestSplit != 0)
+			{
+				middle = std::partition(leaves, leaves + count, [&](uint32_t leaf) { return getBin(leaf) < bestSplit; });
+			}
+			else
+			{
+				std::nth_element(leaves, middle, leaves + count, [&](uint32_t a, uint32_t b) { return getCentroid(a) < getCentroid(b); });
+			}
+		}
+
+		const uint32_t leftCount = middle - leaves;
+		const uint32_t child0 = _build(leaves, leftCount);
+		const uint32_t child1 = _build(middle, count - leftCount);
+
+		const uint32_t node = _allocateNode();
+		_nodes[node].children[0] = child0;
+		_nodes[node].children[1] = child1;
+		_nodes[node].min = scp::min(_nodes[child0].min, _nodes[child1].min);
+		_nodes[node].max = scp::max(_nodes[child0].max, _nodes[child1].max);
+
+		_nodes[child0].parent = node;
+		_nodes[child1].parent = node;
+
+		return node;
+	}
+
+	template<typename TOverlap>
+	void Bvh::_query(const TOverlap& overlaps, std::vector<const Drawable*>& drawables) const
+	{
+		drawables.clear();
+
+		if (_root == nullIndex)
+		{
+			return;
+		}
+
+		thread_local static std::vector<uint32_t> stack;
+		stack.assign(1, _root);
+
+		while (!stack.empty())
+		{
+			const Node& node = _nodes[stack.back()];
+			stack.pop_back();
+
+			if (!overlaps(node.min, node.max))
+			{
+				continue;
+			}
+
+			if (node.drawable)
+			{
+				drawables.push_back(node.drawable);
+			}
+			else
+			{
+				stack.push_back(node.children[0]);
+				stack.push_back(node.children[1]);
+			}
+		}
+	}
+}
@@ -0,0 +1,388 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <Lyse/Core/Core.hpp>
+
+namespace lys
+{
+	namespace
+	{
+		// Each command is its type followed by its parameters, copied byte by byte so that nothing needs alignment
+
+		enum class CommandType : uint8_t
+		{
+			BindShader,
+			SetFaceCulling,
+			BindBuffer,
+			UpdateBuffer,
+			SetUniformFloat,
+			SetUniformUint,
+			SetUniformUVec2,
+			SetUniformVec3,
+			SetUniformVec4,
+			SetUniformTexture,
+			Draw,
+			DrawRanges,
+			DrawIndirect,
+			DrawIndirectCount,
+			DrawArrays
+		};
+
+		struct SetFaceCullingCommand
+		{
+			spl::FaceCullingMode mode;
+			spl::FaceOrientation orientation;
+		};
+
+		struct BindBufferCommand
+		{
+			spl::BufferTarget target;
+			const spl::Buffer* buffer;
+			uint32_t index;
+		};
+
+		struct UpdateBufferCommand
+		{
+			spl::Buffer* buffer;
+			uint32_t size;	// Bytes of data following the command
+		};
+
+		// Zeroed before being filled, so that no uninitialized byte is written to the stream
+
+		struct SetUniformCommand
+		{
+			int32_t location;
+			uint32_t unit;
+			const spl::Texture* texture;
+			uint8_t value[16];
+		};
+
+		struct DrawCommand
+		{
+			const Drawable* drawable;
+			uint32_t vertexInputMask;
+			uint32_t lod;
+		};
+
+		struct DrawRangesCommand
+		{
+			const MeshBase* mesh;
+			uint32_t vertexInputMask;
+			const uint32_t* offsets;
+			const uint32_t* counts;
+			uint32_t rangeCount;
+		};
+
+		struct DrawIndirectCommand
+		{
+			const MeshBase* mesh;
+			uint32_t vertexInputMask;
+			uint64_t commandOffset;
+			uint64_t countOffset;
+			uint32_t commandCount;	// Maximum command count for `DrawIndirectCount`
+		};
+
+		struct DrawArraysCommand
+		{
+			const spl::VertexArray* vertexArray;
+			spl::PrimitiveType primitiveType;
+			uint32_t first;
+			uint32_t count;
+		};
+
+		template<typename TValue>
+		SetUniformCommand makeSetUniformCommand(int32_t location, const TValue& value)
+		{
+			static_assert(sizeof(TValue) <= sizeof(SetUniformCommand::value));
+
+			SetUniformCommand command;
+			std::memset(&command, 0, sizeof(SetUniformCommand));
+			command.location = location;
+			std::memcpy(command.value, &value, sizeof(TValue));
+
+			return command;
+		}
+
+		template<typename TValue>
+		TValue readValue(const uint8_t*& it)
+		{
+			TValue value;
+			std::memcpy(&value, it, sizeof(TValue));
+			it += sizeof(TValue);
+
+			return value;
+		}
+
+		template<typename TValue>
+		TValue getUniformValue(const SetUniformCommand& command)
+		{
+			TValue value;
+			std::memcpy(&value, command.value, sizeof(TValue));
+
+			return value;
+		}
+	}
+
+	CommandBuffer::CommandBuffer() :
+		_data()
+	{
+	}
+
+	void CommandBuffer::bindShader(const spl::ShaderProgram* shader)
+	{
+		const CommandType type = CommandType::BindShader;
+		_write(&type, sizeof(CommandType));
+		_write(&shader, sizeof(const spl::ShaderProgram*));
+	}
+
+	void CommandBuffer::setFaceCulling(spl::FaceCullingMode mode, spl::FaceOrientation orientation)
+	{
+		const CommandType type = CommandType::SetFaceCulling;
+		const SetFaceCullingCommand command = { mode, orientation };
+		_write(&type, sizeof(CommandType));
+		_write(&command, sizeof(SetFaceCullingCommand));
+	}
+
+	void CommandBuffer::bindBuffer(spl::BufferTarget target, const spl::Buffer* buffer, uint32_t index)
+	{
+		const CommandType type = CommandType::BindBuffer;
+		const BindBufferCommand command = { target, buffer, index };
+		_write(&type, sizeof(CommandType));
+		_write(&command, sizeof(BindBufferCommand));
+	}
+
+	void CommandBuffer::updateBuffer(spl::Buffer* buffer, const void* data, uint32_t size)
+	{
+		assert(data && size != 0);
+
+		const CommandType type = CommandType::UpdateBuffer;
+		const UpdateBufferCommand command = { buffer, size };
+		_write(&type, sizeof(CommandType));
+		_write(&command, sizeof(UpdateBufferCommand));
+		_write(data, size);
+	}
+
+	void CommandBuffer::setUniform(int32_t location, float value)
+	{
+		const CommandType type = CommandType::SetUniformFloat;
+		const SetUniformCommand command = makeSetUniformCommand(location, value);
+		_write(&type, sizeof(CommandType));
+		_write(&command, sizeof(SetUniformCommand));
+	}
+
+	void CommandBuffer::setUniform(int32_t location, uint32_t value)
+	{
+		const CommandType type = CommandType::SetUniformUint;
+		const SetUniformCommand command = makeSetUniformCommand(location, value);
+		_write(&type, sizeof(CommandType));
+		_write(&command, sizeof(SetUniformCommand));
+	}
+
+	void CommandBuffer::setUniform(int32_t location, const scp::u32vec2& value)
+	{
+		const CommandType type = CommandType::SetUniformUVec2;
+		const SetUniformCommand command = makeSetUniformCommand(location, value);
+		_write(&type, sizeof(CommandType));
+		_write(&command, sizeof(SetUniformCommand));
+	}
+
+	void CommandBuffer::setUniform(int32_t location, const scp::f32vec3& value)
+	{
+		const CommandType type = CommandType::SetUniformVec3;
+		const SetUniformCommand command = makeSetUniformCommand(location, value);
+		_write(&type, sizeof(CommandType));
+		_write(&command, sizeof(SetUniformCommand));
+	}
+
+	void CommandBuffer::setUniform(int32_t location, const scp::f32vec4& value)
+	{
+		const CommandType type = CommandType::SetUniformVec4;
+		const SetUniformCommand command = makeSetUniformCommand(location, value);
+		_write(&type, sizeof(CommandType));
+		_write(&command, sizeof(SetUniformCommand));
+	}
+
+	void CommandBuffer::setUniform(int32_t location, uint32_t unit, const spl::Texture* texture)
+	{
+		const CommandType type = CommandType::SetUniformTexture;
+		SetUniformCommand command = makeSetUniformCommand(location, uint32_t(0));
+		command.unit = unit;
+		command.texture = texture;
+		_write(&type, sizeof(CommandType));
+		_write(&command, sizeof(SetUniformCommand));
+	}
+
+	void CommandBuffer::draw(const Drawable* drawable, uint32_t vertexInputMask, uint32_t lod)
+	{
+		const CommandType type = CommandType::Draw;
+		const DrawCommand command = { drawable, vertexInputMask, lod };
+		_write(&type, sizeof(CommandType));
+		_write(&command, sizeof(DrawCommand));
+	}
+
+	void CommandBuffer::drawRanges(const MeshBase* mesh, uint32_t vertexInputMask, const uint32_t* offsets, const uint32_t* counts, uint32_t rangeCount)
+	{
+		const CommandType type = CommandType::DrawRanges;
+		const DrawRangesCommand command = { mesh, vertexInputMask, offsets, counts, rangeCount };
+		_write(&type, sizeof(CommandType));
+		_write(&command, sizeof(DrawRangesCommand));
+	}
+
+	void CommandBuffer::drawIndirect(const MeshBase* mesh, uint32_t vertexInputMask, uint64_t commandOffset, uint32_t commandCount)
+	{
+		const CommandType type = CommandType::DrawIndirect;
+		const DrawIndirectCommand command = { mesh, vertexInputMask, commandOffset, 0, commandCount };
+		_write(&type, sizeof(CommandType));
+		_write(&command, sizeof(DrawIndirectCommand));
+	}
+
+	void CommandBuffer::drawIndirectCount(const MeshBase* mesh, uint32_t vertexInputMask, uint64_t commandOffset, uint64_t countOffset, uint32_t maxCommandCount)
+	{
+		const CommandType type = CommandType::DrawIndirectCount;
+		const DrawIndirectCommand command = { mesh, vertexInputMask, commandOffset, countOffset, maxCommandCount };
+		_write(&type, sizeof(CommandType));
+		_write(&command, sizeof(DrawIndirectCommand));
+	}
+
+	void CommandBuffer::drawArrays(const spl::VertexArray* vertexArray, spl::PrimitiveType primitiveType, uint32_t first, uint32_t count)
+	{
+		const CommandType type = CommandType::DrawArrays;
+		const DrawArraysCommand command = { vertexArray, primitiveType, first, count };
+		_write(&type, sizeof(CommandType));
+		_write(&command, sizeof(DrawArraysCommand));
+	}
+
+	void CommandBuffer::clear()
+	{
+		_data.clear();
+	}
+
+	bool CommandBuffer::isEmpty() const
+	{
+		return _data.empty();
+	}
+
+	void CommandBuffer::execute(StateCache& stateCache) const
+	{
+		const uint8_t* it = _data.data();
+		const uint8_t* const end = it + _data.size();
+
+		while (it != end)
+		{
+			const CommandType type = readValue<CommandType>(it);
+			switch (type)
+			{
+				case CommandType::BindShader:
+				{
+					stateCache.bindShader(readValue<const spl::ShaderProgram*>(it));
+					break;
+				}
+				case CommandType::SetFaceCulling:
+				{
+					const SetFaceCullingCommand command = readValue<SetFaceCullingCommand>(it);
+					stateCache.setFaceCullingMode(command.mode);
+					stateCache.setFaceCullingOrientation(command.orientation);
+					break;
+				}
+				case CommandType::BindBuffer:
+				{
+					const BindBufferCommand command = readValue<BindBufferCommand>(it);
+					stateCache.bindBuffer(command.target, command.buffer, command.index);
+					break;
+				}
+				case CommandType::UpdateBuffer:
+				{
+					const UpdateBufferCommand command = readValue<UpdateBufferCommand>(it);
+					command.buffer->update(it, command.size);
+					it += command.size;
+					break;
+				}
+				case CommandType::SetUniformFloat:
+				case CommandType::SetUniformUint:
+				case CommandType::SetUniformUVec2:
+				case CommandType::SetUniformVec3:
+				case CommandType::SetUniformVec4:
+				case CommandType::SetUniformTexture:
+				{
+					const SetUniformCommand command = readValue<SetUniformCommand>(it);
+
+					switch (type)
+					{
+						case CommandType::SetUniformFloat:
+							stateCache.setUniform(command.location, getUniformValue<float>(command));
+							break;
+						case CommandType::SetUniformUint:
+							stateCache.setUniform(command.location, getUniformValue<uint32_t>(command));
+							break;
+						case CommandType::SetUniformUVec2:
+							stateCache.setUniform(command.location, getUniformValue<scp::u32vec2>(command));
+							break;
+						case CommandType::SetUniformVec3:
+							stateCache.setUniform(command.location, getUniformValue<scp::f32vec3>(command));
+							break;
+						case CommandType::SetUniformVec4:
+							stateCache.setUniform(command.location, getUniformValue<scp::f32vec4>(command));
+							break;
+						default:
+							stateCache.setUniform(command.location, command.unit, command.texture);
+							break;
+					}
+					break;
+				}
+				case CommandType::Draw:
+				{
+					const DrawCommand command = readValue<DrawCommand>(it);
+					command.drawable->_draw(command.vertexInputMask, command.lod);
+					break;
+				}
+				case CommandType::DrawRanges:
+				{
+					const DrawRangesCommand command = readValue<DrawRangesCommand>(it);
+					command.mesh->_drawRanges(command.vertexInputMask, command.offsets, command.counts, command.rangeCount);
+					break;
+				}
+				case CommandType::DrawIndirect:
+				{
+					const DrawIndirectCommand command = readValue<DrawIndirectCommand>(it);
+					command.mesh->_drawIndirect(command.vertexInputMask, command.commandOffset, command.commandCount);
+					break;
+				}
+				case CommandType::DrawIndirectCount:
+				{
+					const DrawIndirectCommand command = readValue<DrawIndirectCommand>(it);
+					command.mesh->_drawIndirectCount(command.vertexInputMask, command.commandOffset, command.countOffset, command.commandCount);
+					break;
+				}
+				case CommandType::DrawArrays:
+				{
+					const DrawArraysCommand command = readValue<DrawArraysCommand>(it);
+					command.vertexArray->drawArrays(command.primitiveType, command.first, command.count);
+					break;
+				}
+				default:
+				{
+					assert(false);
+					return;
+				}
+			}
+		}
+	}
+
+	void CommandBuffer::execute(const CommandBuffer* commandBuffers, uint32_t count, StateCache& stateCache)
+	{
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			commandBuffers[i].execute(stateCache);
+		}
+	}
+
+	void CommandBuffer::_write(const void* data, uint32_t size)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		_data.insert(_data.end(), bytes, bytes + size);
+	}
+}
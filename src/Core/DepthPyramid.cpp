@@ -0,0 +1,213 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <Lyse/Core/Core.hpp>
+
+namespace lys
+{
+	DepthPyramid::DepthPyramid() :
+		_levels(),
+		_sizes(),
+		_firstLevel(0),
+		_view(),
+		_projection(),
+		_near(0.f),
+		_far(0.f)
+	{
+	}
+
+	void DepthPyramid::update(const float* depths, const scp::u32vec2& resolution, uint32_t level, const scp::f32mat4x4& view, const scp::f32mat4x4& projection, float near, float far)
+	{
+		assert(depths);
+		assert(resolution.x > 0 && resolution.y > 0);
+
+		_view = view;
+		_projection = projection;
+		_near = near;
+		_far = far;
+
+		_sizes.assign(1, resolution);
+		for (uint32_t i = 0; i < level; ++i)
+		{
+			_sizes.push_back({ std::max(_sizes.back().x / 2, 1u), std::max(_sizes.back().y / 2, 1u) });
+		}
+
+		_firstLevel = level;
+		_levels.resize(level + 1);
+		_levels[level].assign(depths, depths + _sizes[level].x * _sizes[level].y);
+
+		// Each texel is the max of the 2x2 texels below it (3 on the last row or column of odd sizes), like on the GPU
+
+		while (_sizes.back().x > 1 || _sizes.back().y > 1)
+		{
+			const scp::u32vec2 inputSize = _sizes.back();
+			const scp::u32vec2 outputSize = { std::max(inputSize.x / 2, 1u), std::max(inputSize.y / 2, 1u) };
+
+			std::vector<float> output(outputSize.x * outputSize.y);
+			const std::vector<float>& input = _levels.back();
+
+			for (uint32_t y = 0; y < outputSize.y; ++y)
+			{
+				const uint32_t yBegin = 2 * y;
+				const uint32_t yEnd = (y == outputSize.y - 1) ? inputSize.y - 1 : std::min(yBegin + 1, inputSize.y - 1);
+
+				for (uint32_t x = 0; x < outputSize.x; ++x)
+				{
+					const uint32_t xBegin = 2 * x;
+					const uint32_t xEnd = (x == outputSize.x - 1) ? inputSize.x - 1 : std::min(xBegin + 1, inputSize.x - 1);
+
+					float depth = 0.f;
+					for (uint32_t i = yBegin; i <= yEnd; ++i)
+					{
+						for (uint32_t j = xBegin; j <= xEnd; ++j)
+						{
+							depth = std::max(depth, input[i * inputSize.x + j]);
+						}
+					}
+
+					output[y * outputSize.x + x] = depth;
+				}
+			}
+
+			_levels.push_back(std::move(output));
+			_sizes.push_back(outputSize);
+		}
+	}
+
+	void DepthPyramid::invalidate()
+	{
+		_levels.clear();
+		_sizes.clear();
+		_firstLevel = 0;
+	}
+
+	bool DepthPyramid::isBoxOccluded(const scp::f32vec3& min, const scp::f32vec3& max, const scp::f32mat4x4& model) const
+	{
+		if (!isValid())
+		{
+			return false;
+		}
+
+		const scp::f32mat4x4 viewModel = _view * model;
+
+		// Screen-space rectangle and nearest linear depth of the box
+
+		scp::f32vec2 ndcMin = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+		scp::f32vec2 ndcMax = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+		float minDepth = std::numeric_limits<float>::max();
+
+		for (uint32_t i = 0; i < 8; ++i)
+		{
+			const scp::f32vec4 corner = { (i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z, 1.f };
+			const scp::f32vec4 viewCorner = viewModel * corner;
+
+			// A box crossing the near plane cannot be projected safely, consider it visible
+
+			if (-viewCorner.z <= _near)
+			{
+				return false;
+			}
+
+			const scp::f32vec4 clipCorner = _projection * viewCorner;
+			const scp::f32vec2 ndcCorner = { clipCorner.x / clipCorner.w, clipCorner.y / clipCorner.w };
+
+			ndcMin = scp::min(ndcMin, ndcCorner);
+			ndcMax = scp::max(ndcMax, ndcCorner);
+			minDepth = std::min(minDepth, (-viewCorner.z - _near) / (_far - _near));
+		}
+
+		if (ndcMax.x < -1.f || ndcMin.x > 1.f || ndcMax.y < -1.f || ndcMin.y > 1.f)
+		{
+			return false;
+		}
+
+		// Pixels covered in the G-Buffer, then go up to a stored level where the rectangle is at most 2x2 texels wide
+
+		const scp::u32vec2& size = _sizes[0];
+		const auto toTexel = [](float ndc, uint32_t size) {
+			return static_cast<uint32_t>(std::clamp((ndc * 0.5f + 0.5f) * size, 0.f, size - 1.f));
+		};
+
+		uint32_t xBegin = toTexel(ndcMin.x, size.x);
+		uint32_t xEnd = toTexel(ndcMax.x, size.x);
+		uint32_t yBegin = toTexel(ndcMin.y, size.y);
+		uint32_t yEnd = toTexel(ndcMax.y, size.y);
+
+		uint32_t level = 0;
+		while (level < _firstLevel || (level + 1 < _levels.size() && (xEnd - xBegin > 1 || yEnd - yBegin > 1)))
+		{
+			++level;
+			xBegin = std::min(xBegin / 2, _sizes[level].x - 1);
+			xEnd = std::min(xEnd / 2, _sizes[level].x - 1);
+			yBegin = std::min(yBegin / 2, _sizes[level].y - 1);
+			yEnd = std::min(yEnd / 2, _sizes[level].y - 1);
+		}
+
+		const std::vector<float>& depths = _levels[level];
+		const uint32_t width = _sizes[level].x;
+
+		for (uint32_t y = yBegin; y <= yEnd; ++y)
+		{
+			for (uint32_t x = xBegin; x <= xEnd; ++x)
+			{
+				if (depths[y * width + x] >= minDepth)
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool DepthPyramid::isValid() const
+	{
+		return !_levels.empty();
+	}
+
+	uint32_t DepthPyramid::getFirstLevel() const
+	{
+		return _firstLevel;
+	}
+
+	uint32_t DepthPyramid::getLevelCount() const
+	{
+		return _levels.size();
+	}
+
+	const scp::u32vec2& DepthPyramid::getLevelSize(uint32_t level) const
+	{
+		assert(level < _sizes.size());
+		return _sizes[level];
+	}
+
+	const float* DepthPyramid::getLevelData(uint32_t level) const
+	{
+		assert(level >= _firstLevel && level < _levels.size());
+		return _levels[level].data();
+	}
+
+	const scp::f32mat4x4& DepthPyramid::getViewMatrix() const
+	{
+		return _view;
+	}
+
+	const scp::f32mat4x4& DepthPyramid::getProjectionMatrix() const
+	{
+		return _projection;
+	}
+
+	float DepthPyramid::getNearDistance() const
+	{
+		return _near;
+	}
+
+	float DepthPyramid::getFarDistance() const
+	{
+		return _far;
+	}
+}
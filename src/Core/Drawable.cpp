@@ -15,39 +15,94 @@ namespace lys
 		_geometryCullingMode(spl::FaceCullingMode::CounterClockWise),
 		_geometryCullingOrientation(spl::FaceOrientation::Back),
 		_shadowCullingMode(spl::FaceCullingMode::CounterClockWise),
-		_shadowCullingOrientation(spl::FaceOrientation::Front)
+		_shadowCullingOrientation(spl::FaceOrientation::Front),
+		_stateVersion(0),
+		_parent(nullptr),
+		_worldTransform(),
+		_invWorldTransform(),
+		_worldTransformVersion(0),
+		_localTransformVersion(0),
+		_parentTransformVersion(0),
+		_worldTransformDirty(true),
+		_worldBoundingBoxMin(0.f, 0.f, 0.f),
+		_worldBoundingBoxMax(0.f, 0.f, 0.f),
+		_hasWorldBoundingBox(false),
+		_worldBoundingBoxVersion(0),
+		_boundingBoxTransformVersion(0),
+		_worldBoundingBoxDirty(true)
 	{
 	}
 
+	Drawable::Drawable(const Drawable& drawable) : Drawable()
+	{
+		*this = drawable;
+	}
+
+	Drawable::Drawable(Drawable&& drawable) : Drawable()
+	{
+		*this = std::move(drawable);
+	}
+
+	Drawable& Drawable::operator=(const Drawable& drawable)
+	{
+		// The copy keeps its own place in the hierarchy, only the caches are invalidated
+
+		Transformable::operator=(drawable);
+
+		_shaderSet = drawable._shaderSet;
+		_material = drawable._material;
+		_geometryCullingMode = drawable._geometryCullingMode;
+		_geometryCullingOrientation = drawable._geometryCullingOrientation;
+		_shadowCullingMode = drawable._shadowCullingMode;
+		_shadowCullingOrientation = drawable._shadowCullingOrientation;
+		++_stateVersion;
+
+		_worldTransformDirty = true;
+		_worldBoundingBoxDirty = true;
+
+		return *this;
+	}
+
+	Drawable& Drawable::operator=(Drawable&& drawable)
+	{
+		return *this = static_cast<const Drawable&>(drawable);
+	}
+
 	void Drawable::setShaderSet(const ShaderSet* shaderSet)
 	{
 		_shaderSet = shaderSet;
+		++_stateVersion;
 	}
 
 	void Drawable::setMaterial(const Material* material)
 	{
 		assert(material != nullptr);
 		_material = material;
+		++_stateVersion;
 	}
 
 	void Drawable::setGeometryFaceCullingMode(spl::FaceCullingMode mode)
 	{
 		_geometryCullingMode = mode;
+		++_stateVersion;
 	}
 
 	void Drawable::setGeometryFaceCullingOrientation(spl::FaceOrientation orientation)
 	{
 		_geometryCullingOrientation = orientation;
+		++_stateVersion;
 	}
 
 	void Drawable::setShadowFaceCullingMode(spl::FaceCullingMode mode)
 	{
 		_shadowCullingMode = mode;
+		++_stateVersion;
 	}
 
 	void Drawable::setShadowFaceCullingOrientation(spl::FaceOrientation orientation)
 	{
 		_shadowCullingOrientation = orientation;
+		++_stateVersion;
 	}
 
 	const ShaderSet* Drawable::getShaderSet() const
@@ -79,4 +134,84 @@ namespace lys
 	{
 		return _shadowCullingOrientation;
 	}
+
+	const DrawableGroup* Drawable::getParent() const
+	{
+		return _parent;
+	}
+
+	const scp::f32mat4x4& Drawable::getWorldTransformMatrix() const
+	{
+		_updateWorldTransform();
+		return _worldTransform;
+	}
+
+	const scp::f32mat4x4& Drawable::getInverseWorldTransformMatrix() const
+	{
+		_updateWorldTransform();
+		return _invWorldTransform;
+	}
+
+	bool Drawable::hasWorldBoundingBox() const
+	{
+		_updateWorldBoundingBox();
+		return _hasWorldBoundingBox;
+	}
+
+	const scp::f32vec3& Drawable::getWorldBoundingBoxMin() const
+	{
+		_updateWorldBoundingBox();
+		return _worldBoundingBoxMin;
+	}
+
+	const scp::f32vec3& Drawable::getWorldBoundingBoxMax() const
+	{
+		_updateWorldBoundingBox();
+		return _worldBoundingBoxMax;
+	}
+
+	void Drawable::_updateWorldTransform() const
+	{
+		uint32_t parentTransformVersion = 0;
+		if (_parent)
+		{
+			_parent->_updateWorldTransform();
+			parentTransformVersion = _parent->_worldTransformVersion;
+		}
+
+		if (!_worldTransformDirty && _localTransformVersion == getTransformVersion() && _parentTransformVersion == parentTransformVersion)
+		{
+			return;
+		}
+
+		if (_parent)
+		{
+			_worldTransform = _parent->_worldTransform * getTransformMatrix();
+			_invWorldTransform = getInverseTransformMatrix() * _parent->_invWorldTransform;
+		}
+		else
+		{
+			_worldTransform = getTransformMatrix();
+			_invWorldTransform = getInverseTransformMatrix();
+		}
+
+		_localTransformVersion = getTransformVersion();
+		_parentTransformVersion = parentTransformVersion;
+		_worldTransformDirty = false;
+		++_worldTransformVersion;
+	}
+
+	void Drawable::_updateWorldBoundingBox() const
+	{
+		_updateWorldTransform();
+		_hasWorldBoundingBox = false;
+	}
+
+	Drawable::~Drawable()
+	{
+		if (_parent)
+		{
+			_parent->removeChild(this);
+		}
+	}
 }
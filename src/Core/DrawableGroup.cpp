@@ -0,0 +1,125 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <Lyse/Core/Core.hpp>
+
+namespace lys
+{
+	DrawableGroup::DrawableGroup() : Drawable(),
+		_children(),
+		_hierarchyVersion(0),
+		_childBoundingBoxVersions()
+	{
+	}
+
+	void DrawableGroup::addChild(Drawable* child)
+	{
+		assert(child != nullptr);
+		assert(child != this);
+		assert(child->_parent == nullptr);
+
+		child->_parent = this;
+		child->_worldTransformDirty = true;
+
+		_children.push_back(child);
+		_childBoundingBoxVersions.push_back(0);
+		_worldBoundingBoxDirty = true;
+		++_hierarchyVersion;
+	}
+
+	void DrawableGroup::removeChild(Drawable* child)
+	{
+		assert(child != nullptr);
+		assert(child->_parent == this);
+
+		const auto it = std::find(_children.begin(), _children.end(), child);
+		assert(it != _children.end());
+
+		_childBoundingBoxVersions.erase(_childBoundingBoxVersions.begin() + (it - _children.begin()));
+		_children.erase(it);
+		_worldBoundingBoxDirty = true;
+		++_hierarchyVersion;
+
+		child->_parent = nullptr;
+		child->_worldTransformDirty = true;
+	}
+
+	DrawableType DrawableGroup::getType() const
+	{
+		return DrawableType::Group;
+	}
+
+	uint32_t DrawableGroup::getChildCount() const
+	{
+		return _children.size();
+	}
+
+	const Drawable* DrawableGroup::getChild(uint32_t index) const
+	{
+		assert(index < _children.size());
+		return _children[index];
+	}
+
+	DrawableGroup::~DrawableGroup()
+	{
+		for (Drawable* child : _children)
+		{
+			child->_parent = nullptr;
+			child->_worldTransformDirty = true;
+		}
+	}
+
+	void DrawableGroup::_draw(uint32_t vertexInputMask, uint32_t lod) const
+	{
+		// Groups are expanded by the scene, only their leaves are drawn
+		assert(false);
+	}
+
+	void DrawableGroup::_updateWorldBoundingBox() const
+	{
+		_updateWorldTransform();
+
+		// Only merge the children bounding boxes again if one of them changed
+
+		bool changed = _worldBoundingBoxDirty;
+		for (uint32_t i = 0; i < _children.size(); ++i)
+		{
+			const Drawable* child = _children[i];
+			child->_updateWorldBoundingBox();
+
+			if (child->_worldBoundingBoxVersion != _childBoundingBoxVersions[i])
+			{
+				_childBoundingBoxVersions[i] = child->_worldBoundingBoxVersion;
+				changed = true;
+			}
+		}
+
+		if (!changed)
+		{
+			return;
+		}
+
+		_worldBoundingBoxMin = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+		_worldBoundingBoxMax = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+		_hasWorldBoundingBox = !_children.empty();
+
+		for (const Drawable* child : _children)
+		{
+			if (!child->_hasWorldBoundingBox)
+			{
+				_hasWorldBoundingBox = false;
+				break;
+			}
+
+			_worldBoundingBoxMin = scp::min(_worldBoundingBoxMin, child->_worldBoundingBoxMin);
+			_worldBoundingBoxMax = scp::max(_worldBoundingBoxMax, child->_worldBoundingBoxMax);
+		}
+
+		_worldBoundingBoxDirty = false;
+		++_worldBoundingBoxVersion;
+	}
+}
@@ -0,0 +1,173 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <Lyse/Core/Core.hpp>
+
+namespace lys
+{
+	DrawableRegistry::DrawableRegistry() :
+		_slots(),
+		_freeSlots(UINT32_MAX),
+		_slotIndices(),
+		_entrySlots(),
+		_drawables(),
+		_subtreeEnds(),
+		_flags(),
+		_transforms(),
+		_invTransforms(),
+		_boundingBoxMins(),
+		_boundingBoxMaxs(),
+		_shaderSets(),
+		_defaultShaderSets(),
+		_shaderVariants(),
+		_materialIndices(),
+		_transformVersions(),
+		_boundingBoxVersions(),
+		_stateVersions(),
+		_hierarchyVersions(),
+		_materials(),
+		_materialVariants(),
+		_materialVersions(),
+		_materialIndexMap()
+	{
+	}
+
+	void DrawableRegistry::assign(const Drawable* const* drawables, uint32_t count)
+	{
+		assert(drawables || count == 0);
+
+		// Free the slots of the drawables that are not kept
+
+		std::unordered_set<const Drawable*> kept(drawables, drawables + count);
+		for (auto it = _slotIndices.begin(); it != _slotIndices.end();)
+		{
+			if (kept.contains(it->first))
+			{
+				++it;
+				continue;
+			}
+
+			Slot& slot = _slots[it->second];
+			++slot.generation;
+			slot.index = _freeSlots;
+			_freeSlots = it->second;
+
+			it = _slotIndices.erase(it);
+		}
+
+		// Lay the entries out in the given order, the versions are reset so that everything is copied again
+
+		_entrySlots.resize(count);
+		_drawables.assign(drawables, drawables + count);
+		_subtreeEnds.resize(count);
+		_flags.assign(count, 0);
+		_transforms.resize(count);
+		_invTransforms.resize(count);
+		_boundingBoxMins.resize(count);
+		_boundingBoxMaxs.resize(count);
+		_shaderSets.assign(count, nullptr);
+		_defaultShaderSets.assign(count, nullptr);
+		_shaderVariants.assign(count, 0);
+		_materialIndices.assign(count, 0);
+		_transformVersions.assign(count, UINT32_MAX);
+		_boundingBoxVersions.assign(count, UINT32_MAX);
+		_stateVersions.assign(count, UINT32_MAX);
+		_hierarchyVersions.assign(count, UINT32_MAX);
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			auto it = _slotIndices.find(drawables[i]);
+			if (it == _slotIndices.end())
+			{
+				uint32_t slot;
+				if (_freeSlots != UINT32_MAX)
+				{
+					slot = _freeSlots;
+					_freeSlots = _slots[slot].index;
+				}
+				else
+				{
+					slot = _slots.size();
+					_slots.push_back({ 0, 0 });
+				}
+
+				it = _slotIndices.insert({ drawables[i], slot }).first;
+			}
+
+			_slots[it->second].index = i;
+			_entrySlots[i] = it->second;
+			_subtreeEnds[i] = i + 1;
+		}
+
+		_clearMaterials();
+	}
+
+	void DrawableRegistry::clear()
+	{
+		assign(nullptr, 0);
+	}
+
+	bool DrawableRegistry::isValid(const DrawableHandle& handle) const
+	{
+		if (handle.slot >= _slots.size())
+		{
+			return false;
+		}
+
+		const Slot& slot = _slots[handle.slot];
+		return slot.generation == handle.generation && slot.index < _entrySlots.size() && _entrySlots[slot.index] == handle.slot;
+	}
+
+	DrawableHandle DrawableRegistry::getHandle(const Drawable* drawable) const
+	{
+		const auto it = _slotIndices.find(drawable);
+		if (it == _slotIndices.end())
+		{
+			return nullHandle;
+		}
+
+		return { it->second, _slots[it->second].generation };
+	}
+
+	uint32_t DrawableRegistry::getIndex(const DrawableHandle& handle) const
+	{
+		assert(isValid(handle));
+		return _slots[handle.slot].index;
+	}
+
+	uint32_t DrawableRegistry::getSize() const
+	{
+		return _drawables.size();
+	}
+
+	const Drawable* DrawableRegistry::getDrawable(uint32_t index) const
+	{
+		assert(index < _drawables.size());
+		return _drawables[index];
+	}
+
+	uint32_t DrawableRegistry::_getMaterialIndex(const Material* material)
+	{
+		const auto [it, inserted] = _materialIndexMap.insert({ material, _materials.size() });
+		if (inserted)
+		{
+			_materials.push_back(material);
+			_materialVariants.push_back(UINT32_MAX);
+			_materialVersions.push_back(UINT32_MAX);
+		}
+
+		return it->second;
+	}
+
+	void DrawableRegistry::_clearMaterials()
+	{
+		_materials.clear();
+		_materialVariants.clear();
+		_materialVersions.clear();
+		_materialIndexMap.clear();
+	}
+}
@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <Lyse/Core/Core.hpp>
+
+#ifdef LYSE_COUNT_ALLOCATIONS
+
+namespace
+{
+	std::atomic<uint64_t> heapAllocationCount = 0;
+
+	void* countedAllocate(std::size_t size)
+	{
+		++heapAllocationCount;
+		return std::malloc(size != 0 ? size : 1);
+	}
+}
+
+// Only the default-aligned forms are replaced, the over-aligned ones are rare and not used by the library
+
+void* operator new(std::size_t size)
+{
+	void* memory = countedAllocate(size);
+	if (!memory)
+	{
+		throw std::bad_alloc();
+	}
+
+	return memory;
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return countedAllocate(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t size) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t size) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+	std::free(memory);
+}
+
+#endif
+
+namespace lys
+{
+	FrameArena::FrameArena(uint64_t capacity) :
+		_block(new uint8_t[capacity]),
+		_capacity(capacity),
+		_offset(0),
+		_overflowBlocks(),
+		_overflowSize(0)
+	{
+		assert(capacity != 0);
+	}
+
+	void* FrameArena::allocate(uint64_t size, uint64_t alignment)
+	{
+		assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+		assert(alignment <= alignof(std::max_align_t));
+
+		const uint64_t offset = (_offset + alignment - 1) & ~(alignment - 1);
+		if (offset + size <= _capacity)
+		{
+			_offset = offset + size;
+			return _block.get() + offset;
+		}
+
+		// The block is full, the extra memory is counted so that the next block is big enough for the whole frame
+
+		_overflowBlocks.emplace_back(new uint8_t[size]);
+		_overflowSize += size;
+
+		return _overflowBlocks.back().get();
+	}
+
+	void FrameArena::reset()
+	{
+		if (!_overflowBlocks.empty())
+		{
+			_capacity = std::bit_ceil(_capacity + _overflowSize);
+			_block.reset(new uint8_t[_capacity]);
+
+			_overflowBlocks.clear();
+			_overflowSize = 0;
+		}
+
+		_offset = 0;
+	}
+
+	uint64_t FrameArena::getCapacity() const
+	{
+		return _capacity;
+	}
+
+	uint64_t FrameArena::getUsedSize() const
+	{
+		return _offset + _overflowSize;
+	}
+
+	uint64_t getHeapAllocationCount()
+	{
+		#ifdef LYSE_COUNT_ALLOCATIONS
+			return heapAllocationCount.load();
+		#else
+			return 0;
+		#endif
+	}
+}
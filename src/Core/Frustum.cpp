@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <Lyse/Core/Core.hpp>
+
+namespace lys
+{
+	Frustum::Frustum(const CameraBase* camera) :
+		_eye(camera->getPosition()),
+		_planes()
+	{
+		assert(camera);
+
+		const float tanY = std::tan(camera->getFieldOfView() * 0.5f);
+		const float tanX = camera->getAspect() * tanY;
+		const float near = camera->getNearDistance();
+		const float far = camera->getFarDistance();
+
+		// Planes in view-space (x right, y up, looking toward -z)
+
+		std::array<scp::f32vec4, 6> viewPlanes;
+		switch (camera->getType())
+		{
+			case CameraType::Perspective:
+			{
+				viewPlanes = {
+					scp::f32vec4(1.f, 0.f, -tanX, 0.f),
+					scp::f32vec4(-1.f, 0.f, -tanX, 0.f),
+					scp::f32vec4(0.f, 1.f, -tanY, 0.f),
+					scp::f32vec4(0.f, -1.f, -tanY, 0.f),
+					scp::f32vec4(0.f, 0.f, -1.f, -near),
+					scp::f32vec4(0.f, 0.f, 1.f, far)
+				};
+				break;
+			}
+			case CameraType::Orthographic:
+			{
+				viewPlanes = {
+					scp::f32vec4(1.f, 0.f, 0.f, far * tanX),
+					scp::f32vec4(-1.f, 0.f, 0.f, far * tanX),
+					scp::f32vec4(0.f, 1.f, 0.f, far * tanY),
+					scp::f32vec4(0.f, -1.f, 0.f, far * tanY),
+					scp::f32vec4(0.f, 0.f, -1.f, -near),
+					scp::f32vec4(0.f, 0.f, 1.f, far)
+				};
+				break;
+			}
+			default:
+			{
+				assert(false);
+				break;
+			}
+		}
+
+		// Express them in world-space
+
+		const scp::f32vec3& front = camera->getFrontVector();
+		const scp::f32vec3& up = camera->getUpVector();
+		const scp::f32vec3 right = scp::cross(front, up);
+
+		for (uint32_t i = 0; i < 6; ++i)
+		{
+			const scp::f32vec4& p = viewPlanes[i];
+
+			scp::f32vec3 normal = p.x * right + p.y * up - p.z * front;
+			const float length = scp::length(normal);
+			normal /= length;
+
+			_planes[i] = scp::f32vec4(normal, p.w / length - scp::dot(normal, _eye));
+		}
+	}
+
+	bool Frustum::intersectsSphere(const scp::f32vec3& center, float radius) const
+	{
+		for (const scp::f32vec4& plane : _planes)
+		{
+			if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool Frustum::intersectsBox(const scp::f32vec3& min, const scp::f32vec3& max) const
+	{
+		for (const scp::f32vec4& plane : _planes)
+		{
+			// Corner of the box the farthest along the plane normal
+
+			const float x = plane.x >= 0.f ? max.x : min.x;
+			const float y = plane.y >= 0.f ? max.y : min.y;
+			const float z = plane.z >= 0.f ? max.z : min.z;
+
+			if (plane.x * x + plane.y * y + plane.z * z + plane.w < 0.f)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	const scp::f32vec3& Frustum::getEyePosition() const
+	{
+		return _eye;
+	}
+
+	const std::array<scp::f32vec4, 6>& Frustum::getPlanes() const
+	{
+		return _planes;
+	}
+}
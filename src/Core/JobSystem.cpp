@@ -0,0 +1,348 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <Lyse/Core/Core.hpp>
+
+namespace lys
+{
+	namespace
+	{
+		// Deque of the calling thread, if it is a worker of `currentJobSystem`
+
+		thread_local const JobSystem* currentJobSystem = nullptr;
+		thread_local uint32_t currentWorker = 0;
+
+		JobSystem* globalJobSystem = nullptr;
+	}
+
+	JobCounter::JobCounter() :
+		_count(0),
+		_mutex(),
+		_continuations()
+	{
+	}
+
+	bool JobCounter::isDone() const
+	{
+		return _count.load() == 0;
+	}
+
+	JobCounter::~JobCounter()
+	{
+		assert(isDone());
+	}
+
+	JobSystem::JobSystem(uint32_t threadCount) :
+		_workers(),
+		_threads(),
+		_pendingTasks(0),
+		_stopping(false),
+		_sleepMutex(),
+		_sleepCondition(),
+		_executor(nullptr),
+		_activeHelpers(),
+		_helperCondition()
+	{
+		for (uint32_t i = 0; i <= threadCount; ++i)
+		{
+			_workers.push_back(std::make_unique<Worker>());
+		}
+
+		for (uint32_t i = 1; i <= threadCount; ++i)
+		{
+			_threads.emplace_back(&JobSystem::_workerLoop, this, i);
+		}
+	}
+
+	JobSystem::JobSystem(JobExecutor& executor) :
+		_workers(),
+		_threads(),
+		_pendingTasks(0),
+		_stopping(false),
+		_sleepMutex(),
+		_sleepCondition(),
+		_executor(&executor),
+		_activeHelpers(executor.getThreadCount(), false),
+		_helperCondition()
+	{
+		for (uint32_t i = 0; i <= executor.getThreadCount(); ++i)
+		{
+			_workers.push_back(std::make_unique<Worker>());
+		}
+	}
+
+	void JobSystem::run(Job job, JobCounter* counter, JobCounter* dependency)
+	{
+		assert(job);
+
+		if (counter)
+		{
+			++counter->_count;
+		}
+
+		// The job is pushed by the last job of its dependency if it is not done yet
+
+		if (dependency)
+		{
+			std::lock_guard lock(dependency->_mutex);
+			if (!dependency->isDone())
+			{
+				dependency->_continuations.emplace_back(std::move(job), counter);
+				return;
+			}
+		}
+
+		_push({ std::move(job), counter });
+	}
+
+	void JobSystem::wait(JobCounter& counter)
+	{
+		while (!counter.isDone())
+		{
+			Task task;
+			if (_pop(task))
+			{
+				_execute(task);
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		// The last job may still hold the lock of the counter, which the caller is about to destroy
+
+		std::lock_guard lock(counter._mutex);
+	}
+
+	uint32_t JobSystem::getThreadCount() const
+	{
+		return _workers.size() - 1;
+	}
+
+	JobSystem::~JobSystem()
+	{
+		assert(_pendingTasks.load() == 0);
+
+		{
+			std::lock_guard lock(_sleepMutex);
+			_stopping = true;
+		}
+
+		_sleepCondition.notify_all();
+
+		for (std::thread& thread : _threads)
+		{
+			thread.join();
+		}
+
+		// Helpers return once there is no job left, but may not have returned yet
+
+		std::unique_lock lock(_sleepMutex);
+		_helperCondition.wait(lock, [&]() { return std::find(_activeHelpers.begin(), _activeHelpers.end(), true) == _activeHelpers.end(); });
+	}
+
+	JobSystem& JobSystem::getGlobal()
+	{
+		if (globalJobSystem)
+		{
+			return *globalJobSystem;
+		}
+
+		static JobSystem defaultJobSystem;
+		return defaultJobSystem;
+	}
+
+	void JobSystem::setGlobal(JobSystem* jobSystem)
+	{
+		globalJobSystem = jobSystem;
+	}
+
+	uint32_t JobSystem::getDefaultThreadCount()
+	{
+		return std::max<uint32_t>(std::thread::hardware_concurrency(), 1) - 1;
+	}
+
+	void JobSystem::_push(Task&& task)
+	{
+		// Counted first, so that the count never goes below the number of jobs in the deques
+
+		++_pendingTasks;
+
+		const uint32_t index = (currentJobSystem == this) ? currentWorker : 0;
+
+		{
+			std::lock_guard lock(_workers[index]->mutex);
+			_workers[index]->tasks.push_back(std::move(task));
+		}
+
+		std::unique_lock lock(_sleepMutex);
+
+		if (!_executor)
+		{
+			_sleepCondition.notify_one();
+			return;
+		}
+
+		// Start a helper on the executor if one is not running yet. It is marked active under the lock, but started
+		// once the lock is released, the executor may run it inline or block until a thread is available.
+
+		const auto it = std::find(_activeHelpers.begin(), _activeHelpers.end(), false);
+		if (it == _activeHelpers.end())
+		{
+			return;
+		}
+
+		*it = true;
+		const uint32_t helper = (it - _activeHelpers.begin()) + 1;
+
+		lock.unlock();
+
+		_executor->execute([this, helper]() { _helperLoop(helper); });
+	}
+
+	bool JobSystem::_pop(Task& task)
+	{
+		if (_pendingTasks.load() == 0)
+		{
+			return false;
+		}
+
+		// Own jobs are taken from the back, the most recent are the most likely to be in cache
+
+		const uint32_t index = (currentJobSystem == this) ? currentWorker : 0;
+
+		{
+			Worker& worker = *_workers[index];
+			std::lock_guard lock(worker.mutex);
+			if (worker.tasks.size() != worker.front)
+			{
+				task = std::move(worker.tasks.back());
+				worker.tasks.pop_back();
+				_trimWorker(worker);
+				--_pendingTasks;
+				return true;
+			}
+		}
+
+		// Jobs of the other workers are stolen from the front, the oldest are usually the biggest
+
+		for (uint32_t i = 1; i < _workers.size(); ++i)
+		{
+			Worker& worker = *_workers[(index + i) % _workers.size()];
+			std::lock_guard lock(worker.mutex);
+			if (worker.tasks.size() != worker.front)
+			{
+				task = std::move(worker.tasks[worker.front]);
+				++worker.front;
+				_trimWorker(worker);
+				--_pendingTasks;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void JobSystem::_trimWorker(Worker& worker)
+	{
+		// The slots of the stolen tasks are reused once the worker has no task left, the capacity is kept
+
+		if (worker.tasks.size() == worker.front)
+		{
+			worker.tasks.clear();
+			worker.front = 0;
+		}
+	}
+
+	void JobSystem::_execute(Task& task)
+	{
+		task.job();
+
+		if (!task.counter)
+		{
+			return;
+		}
+
+		// The last job of a counter pushes the jobs that depend on it
+
+		std::vector<std::pair<Job, JobCounter*>> continuations;
+		{
+			std::lock_guard lock(task.counter->_mutex);
+			if (--task.counter->_count != 0)
+			{
+				return;
+			}
+
+			continuations.swap(task.counter->_continuations);
+		}
+
+		for (std::pair<Job, JobCounter*>& continuation : continuations)
+		{
+			_push({ std::move(continuation.first), continuation.second });
+		}
+	}
+
+	void JobSystem::_workerLoop(uint32_t index)
+	{
+		currentJobSystem = this;
+		currentWorker = index;
+
+		while (true)
+		{
+			Task task;
+			if (_pop(task))
+			{
+				_execute(task);
+				continue;
+			}
+
+			std::unique_lock lock(_sleepMutex);
+			_sleepCondition.wait(lock, [&]() { return _stopping || _pendingTasks.load() != 0; });
+
+			if (_stopping)
+			{
+				break;
+			}
+		}
+
+		currentJobSystem = nullptr;
+	}
+
+	void JobSystem::_helperLoop(uint32_t index)
+	{
+		const JobSystem* previousJobSystem = currentJobSystem;
+		const uint32_t previousWorker = currentWorker;
+
+		currentJobSystem = this;
+		currentWorker = index;
+
+		while (true)
+		{
+			Task task;
+			if (_pop(task))
+			{
+				_execute(task);
+				continue;
+			}
+
+			// Checked under the lock, so that a job pushed in the meantime either sees this helper or starts another
+
+			std::unique_lock lock(_sleepMutex);
+			if (_pendingTasks.load() == 0)
+			{
+				_activeHelpers[index - 1] = false;
+				lock.unlock();
+				_helperCondition.notify_all();
+				break;
+			}
+		}
+
+		currentJobSystem = previousJobSystem;
+		currentWorker = previousWorker;
+	}
+}
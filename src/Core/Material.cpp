@@ -15,7 +15,8 @@ namespace lys
 		_color(r, g, b, a),
 		_props(ambiant, metallic, roughness),
 		_colorTexture(nullptr),
-		_propsTexture(nullptr)
+		_propsTexture(nullptr),
+		_version(0)
 	{
 		assert(r >= 0.f && r <= 1.f);
 		assert(g >= 0.f && g <= 1.f);
@@ -30,7 +31,8 @@ namespace lys
 		_color(1.f, 1.f, 1.f, 1.f),
 		_props(ambiant, metallic, roughness),
 		_colorTexture(colorTexture),
-		_propsTexture(nullptr)
+		_propsTexture(nullptr),
+		_version(0)
 	{
 		assert(ambiant >= 0.f && ambiant <= 1.f);
 		assert(metallic >= 0.f && metallic <= 1.f);
@@ -41,7 +43,8 @@ namespace lys
 		_color(r, g, b, a),
 		_props(0.1f, 0.1f, 0.3f),
 		_colorTexture(nullptr),
-		_propsTexture(propsTexture)
+		_propsTexture(propsTexture),
+		_version(0)
 	{
 		assert(r >= 0.f && r <= 1.f);
 		assert(g >= 0.f && g <= 1.f);
@@ -53,10 +56,27 @@ namespace lys
 		_color(1.f, 1.f, 1.f, 1.f),
 		_props(0.1f, 0.1f, 0.3f),
 		_colorTexture(colorTexture),
-		_propsTexture(propsTexture)
+		_propsTexture(propsTexture),
+		_version(0)
 	{
 	}
 
+	Material& Material::operator=(const Material& material)
+	{
+		_color = material._color;
+		_props = material._props;
+		_colorTexture = material._colorTexture;
+		_propsTexture = material._propsTexture;
+		++_version;
+
+		return *this;
+	}
+
+	Material& Material::operator=(Material&& material)
+	{
+		return *this = static_cast<const Material&>(material);
+	}
+
 	void Material::setColor(float r, float g, float b, float a)
 	{
 		assert(r >= 0.f && r <= 1.f);
@@ -68,6 +88,7 @@ namespace lys
 		_color.y = g;
 		_color.z = b;
 		_color.w = a;
+		++_version;
 	}
 
 	void Material::setProperties(float ambiant, float metallic, float roughness)
@@ -79,16 +100,19 @@ namespace lys
 		_props.x = ambiant;
 		_props.y = metallic;
 		_props.z = roughness;
+		++_version;
 	}
 
 	void Material::setColorTexture(const spl::Texture2D* texture)
 	{
 		_colorTexture = texture;
+		++_version;
 	}
 
 	void Material::setPropertiesTexture(const spl::Texture2D* texture)
 	{
 		_propsTexture = texture;
+		++_version;
 	}
 
 	const scp::f32vec4& Material::getColor() const
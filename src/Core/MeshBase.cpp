@@ -0,0 +1,151 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <Lyse/Core/Core.hpp>
+
+namespace lys
+{
+	MeshBase::MeshBase() : Drawable(),
+		_normalMap(nullptr),
+		_boundingBoxMin(0.f, 0.f, 0.f),
+		_boundingBoxMax(0.f, 0.f, 0.f),
+		_compactVertices(false),
+		_lods(),
+		_meshlets(),
+		_occluderPositions(),
+		_occluderIndices(),
+		_isOccluder(false)
+	{
+	}
+
+	void MeshBase::setNormalMap(const spl::Texture2D* texture)
+	{
+		_normalMap = texture;
+		++_stateVersion;
+	}
+
+	void MeshBase::setBoundingBox(const scp::f32vec3& min, const scp::f32vec3& max)
+	{
+		assert(min.x <= max.x && min.y <= max.y && min.z <= max.z);
+
+		_boundingBoxMin = min;
+		_boundingBoxMax = max;
+		_worldBoundingBoxDirty = true;
+	}
+
+	void MeshBase::setMeshlets(const Meshlet* meshlets, uint32_t count)
+	{
+		assert(meshlets || count == 0);
+		assert(!_lods.empty());
+		assert(std::all_of(meshlets, meshlets + count, [&](const Meshlet& meshlet) { return meshlet.indexOffset + meshlet.indexCount <= _lods[0].indexOffset + _lods[0].indexCount; }));
+
+		_meshlets.assign(meshlets, meshlets + count);
+	}
+
+	void MeshBase::setOccluderGeometry(const scp::f32vec3* positions, const uint32_t* indices, uint32_t indexCount)
+	{
+		assert(positions || indexCount == 0);
+		assert(indices || indexCount == 0);
+		assert(indexCount % 3 == 0);
+
+		// Only keep the vertices used by the triangles
+
+		std::unordered_map<uint32_t, uint32_t> remap;
+
+		_occluderPositions.clear();
+		_occluderIndices.resize(indexCount);
+
+		for (uint32_t i = 0; i < indexCount; ++i)
+		{
+			const auto [it, inserted] = remap.insert({ indices[i], _occluderPositions.size() });
+			if (inserted)
+			{
+				_occluderPositions.push_back(positions[indices[i]]);
+			}
+
+			_occluderIndices[i] = it->second;
+		}
+
+		++_stateVersion;
+	}
+
+	void MeshBase::setIsOccluder(bool isOccluder)
+	{
+		_isOccluder = isOccluder;
+		++_stateVersion;
+	}
+
+	DrawableType MeshBase::getType() const
+	{
+		return DrawableType::Mesh;
+	}
+
+	const spl::Texture2D* MeshBase::getNormalMap() const
+	{
+		return _normalMap;
+	}
+
+	const scp::f32vec3& MeshBase::getBoundingBoxMin() const
+	{
+		return _boundingBoxMin;
+	}
+
+	const scp::f32vec3& MeshBase::getBoundingBoxMax() const
+	{
+		return _boundingBoxMax;
+	}
+
+	const std::vector<MeshLod>& MeshBase::getLods() const
+	{
+		return _lods;
+	}
+
+	const std::vector<Meshlet>& MeshBase::getMeshlets() const
+	{
+		return _meshlets;
+	}
+
+	const std::vector<scp::f32vec3>& MeshBase::getOccluderPositions() const
+	{
+		return _occluderPositions;
+	}
+
+	const std::vector<uint32_t>& MeshBase::getOccluderIndices() const
+	{
+		return _occluderIndices;
+	}
+
+	bool MeshBase::isOccluder() const
+	{
+		return _isOccluder && !_occluderIndices.empty();
+	}
+
+	void MeshBase::_updateWorldBoundingBox() const
+	{
+		_updateWorldTransform();
+
+		if (!_worldBoundingBoxDirty && _boundingBoxTransformVersion == _worldTransformVersion)
+		{
+			return;
+		}
+
+		_worldBoundingBoxMin = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+		_worldBoundingBoxMax = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+
+		for (uint32_t i = 0; i < 8; ++i)
+		{
+			const scp::f32vec4 corner = _worldTransform * scp::f32vec4((i & 1) ? _boundingBoxMax.x : _boundingBoxMin.x, (i & 2) ? _boundingBoxMax.y : _boundingBoxMin.y, (i & 4) ? _boundingBoxMax.z : _boundingBoxMin.z, 1.f);
+			_worldBoundingBoxMin = scp::min(_worldBoundingBoxMin, scp::f32vec3(corner.x, corner.y, corner.z));
+			_worldBoundingBoxMax = scp::max(_worldBoundingBoxMax, scp::f32vec3(corner.x, corner.y, corner.z));
+		}
+
+		_hasWorldBoundingBox = true;
+		_boundingBoxTransformVersion = _worldTransformVersion;
+		_worldBoundingBoxDirty = false;
+		++_worldBoundingBoxVersion;
+	}
+}
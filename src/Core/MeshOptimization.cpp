@@ -0,0 +1,775 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <Lyse/Core/Core.hpp>
+
+namespace lys
+{
+	namespace
+	{
+		struct TriangleAdjacency
+		{
+			std::vector<uint32_t> offsets;
+			std::vector<uint32_t> counts;
+			std::vector<uint32_t> triangles;
+		};
+
+		void buildTriangleAdjacency(TriangleAdjacency& adjacency, const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount)
+		{
+			adjacency.offsets.assign(vertexCount, 0);
+			adjacency.counts.assign(vertexCount, 0);
+			adjacency.triangles.resize(indexCount);
+
+			for (uint32_t i = 0; i < indexCount; ++i)
+			{
+				assert(indices[i] < vertexCount);
+				++adjacency.counts[indices[i]];
+			}
+
+			uint32_t offset = 0;
+			for (uint32_t i = 0; i < vertexCount; ++i)
+			{
+				adjacency.offsets[i] = offset;
+				offset += adjacency.counts[i];
+			}
+
+			std::vector<uint32_t> fill(adjacency.offsets);
+			for (uint32_t i = 0; i < indexCount; ++i)
+			{
+				adjacency.triangles[fill[indices[i]]++] = i / 3;
+			}
+		}
+
+		uint32_t skipDeadEnd(const std::vector<uint32_t>& liveTriangles, std::vector<uint32_t>& deadEnd, uint32_t& cursor)
+		{
+			while (!deadEnd.empty())
+			{
+				const uint32_t vertex = deadEnd.back();
+				deadEnd.pop_back();
+
+				if (liveTriangles[vertex] > 0)
+				{
+					return vertex;
+				}
+			}
+
+			while (cursor < liveTriangles.size())
+			{
+				if (liveTriangles[cursor] > 0)
+				{
+					return cursor;
+				}
+
+				++cursor;
+			}
+
+			return UINT32_MAX;
+		}
+
+		// Error quadric of a set of planes, the error of a point is the sum of its squared distances to the planes
+
+		struct Quadric
+		{
+			double a2, ab, ac, ad, b2, bc, bd, c2, cd, d2;
+
+			void addPlane(double a, double b, double c, double d)
+			{
+				a2 += a * a; ab += a * b; ac += a * c; ad += a * d;
+				b2 += b * b; bc += b * c; bd += b * d;
+				c2 += c * c; cd += c * d;
+				d2 += d * d;
+			}
+
+			void add(const Quadric& q)
+			{
+				a2 += q.a2; ab += q.ab; ac += q.ac; ad += q.ad;
+				b2 += q.b2; bc += q.bc; bd += q.bd;
+				c2 += q.c2; cd += q.cd;
+				d2 += q.d2;
+			}
+
+			double evaluate(const scp::f32vec3& p) const
+			{
+				const double x = p.x, y = p.y, z = p.z;
+				const double error = a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x
+					+ b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y
+					+ c2 * z * z + 2.0 * cd * z
+					+ d2;
+
+				return std::max(error, 0.0);
+			}
+		};
+
+		struct PositionKey
+		{
+			uint32_t x, y, z;
+
+			bool operator==(const PositionKey& key) const = default;
+		};
+
+		struct PositionKeyHash
+		{
+			size_t operator()(const PositionKey& key) const
+			{
+				uint64_t h = key.x * 0x9e3779b97f4a7c15ull;
+				h = (h ^ (h >> 32) ^ key.y) * 0xbf58476d1ce4e5b9ull;
+				h = (h ^ (h >> 29) ^ key.z) * 0x94d049bb133111ebull;
+				return h ^ (h >> 31);
+			}
+		};
+
+		struct Collapse
+		{
+			uint32_t from;
+			uint32_t to;
+			double cost;
+		};
+
+		// Would replacing `from` by `to` flip (or collapse to zero area) one of the triangles around `from` ?
+
+		bool collapseFlipsTriangle(const std::vector<uint32_t>& indices, const TriangleAdjacency& adjacency, const scp::f32vec3* positions, uint32_t from, uint32_t to)
+		{
+			const uint32_t* neighbours = adjacency.triangles.data() + adjacency.offsets[from];
+			for (uint32_t i = 0; i < adjacency.counts[from]; ++i)
+			{
+				const uint32_t* triangle = indices.data() + neighbours[i] * 3;
+				if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+				{
+					continue;
+				}
+
+				const scp::f32vec3& p0 = positions[triangle[0] == from ? to : triangle[0]];
+				const scp::f32vec3& p1 = positions[triangle[1] == from ? to : triangle[1]];
+				const scp::f32vec3& p2 = positions[triangle[2] == from ? to : triangle[2]];
+
+				const scp::f32vec3 before = scp::cross(positions[triangle[1]] - positions[triangle[0]], positions[triangle[2]] - positions[triangle[0]]);
+				const scp::f32vec3 after = scp::cross(p1 - p0, p2 - p0);
+
+				if (scp::dot(before, after) <= 0.f)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		// Simulate a FIFO post-transform cache of `cacheSize` entries and return the number of misses of a triangle
+
+		uint32_t simulateCache(const uint32_t* triangle, std::vector<uint32_t>& cacheTimestamps, uint32_t& timestamp, uint32_t cacheSize)
+		{
+			uint32_t misses = 0;
+
+			for (uint32_t i = 0; i < 3; ++i)
+			{
+				if (timestamp - cacheTimestamps[triangle[i]] > cacheSize)
+				{
+					cacheTimestamps[triangle[i]] = timestamp++;
+					++misses;
+				}
+			}
+
+			return misses;
+		}
+	}
+
+	void optimizeVertexCache(uint32_t* indices, uint32_t indexCount, uint32_t vertexCount, uint32_t cacheSize)
+	{
+		assert(indices || indexCount == 0);
+		assert(indexCount % 3 == 0);
+
+		const uint32_t triangleCount = indexCount / 3;
+		if (triangleCount == 0)
+		{
+			return;
+		}
+
+		TriangleAdjacency adjacency;
+		buildTriangleAdjacency(adjacency, indices, indexCount, vertexCount);
+
+		std::vector<uint32_t> liveTriangles(adjacency.counts);
+		std::vector<uint32_t> cacheTimestamps(vertexCount, 0);
+		std::vector<bool> emitted(triangleCount, false);
+		std::vector<uint32_t> deadEnd;
+		std::vector<uint32_t> candidates;
+
+		std::vector<uint32_t> result;
+		result.reserve(indexCount);
+
+		uint32_t timestamp = cacheSize + 1;
+		uint32_t cursor = 0;
+		uint32_t fanningVertex = 0;
+
+		while (fanningVertex != UINT32_MAX)
+		{
+			candidates.clear();
+
+			// Emit every remaining triangle around the fanning vertex
+
+			const uint32_t* neighbours = adjacency.triangles.data() + adjacency.offsets[fanningVertex];
+			for (uint32_t i = 0; i < adjacency.counts[fanningVertex]; ++i)
+			{
+				const uint32_t triangle = neighbours[i];
+				if (emitted[triangle])
+				{
+					continue;
+				}
+
+				for (uint32_t j = 0; j < 3; ++j)
+				{
+					const uint32_t vertex = indices[triangle * 3 + j];
+
+					result.push_back(vertex);
+					deadEnd.push_back(vertex);
+					candidates.push_back(vertex);
+					--liveTriangles[vertex];
+
+					if (timestamp - cacheTimestamps[vertex] > cacheSize)
+					{
+						cacheTimestamps[vertex] = timestamp++;
+					}
+				}
+
+				emitted[triangle] = true;
+			}
+
+			// Next fanning vertex: the candidate that will still be in cache after emitting its triangles, oldest first
+
+			uint32_t bestVertex = UINT32_MAX;
+			int32_t bestPriority = -1;
+			for (uint32_t vertex : candidates)
+			{
+				if (liveTriangles[vertex] == 0)
+				{
+					continue;
+				}
+
+				int32_t priority = 0;
+				if (timestamp - cacheTimestamps[vertex] + 2 * liveTriangles[vertex] <= cacheSize)
+				{
+					priority = timestamp - cacheTimestamps[vertex];
+				}
+
+				if (priority > bestPriority)
+				{
+					bestPriority = priority;
+					bestVertex = vertex;
+				}
+			}
+
+			if (bestVertex == UINT32_MAX)
+			{
+				bestVertex = skipDeadEnd(liveTriangles, deadEnd, cursor);
+			}
+
+			fanningVertex = bestVertex;
+		}
+
+		assert(result.size() == indexCount);
+		std::copy(result.begin(), result.end(), indices);
+	}
+
+	void optimizeOverdraw(uint32_t* indices, uint32_t indexCount, const scp::f32vec3* positions, uint32_t vertexCount, float threshold, uint32_t cacheSize)
+	{
+		assert(indices || indexCount == 0);
+		assert(positions || vertexCount == 0);
+		assert(indexCount % 3 == 0);
+		assert(threshold >= 1.f);
+
+		const uint32_t triangleCount = indexCount / 3;
+		if (triangleCount == 0)
+		{
+			return;
+		}
+
+		// Hard boundaries: the triangles for which the cache is completely cold, they can be moved freely
+
+		std::vector<uint32_t> cacheTimestamps(vertexCount, 0);
+		uint32_t timestamp = cacheSize + 1;
+
+		std::vector<uint32_t> hardClusters;
+		for (uint32_t i = 0; i < triangleCount; ++i)
+		{
+			if (simulateCache(indices + i * 3, cacheTimestamps, timestamp, cacheSize) == 3 || i == 0)
+			{
+				hardClusters.push_back(i);
+			}
+		}
+		hardClusters.push_back(triangleCount);
+
+		// Soft boundaries: split the hard clusters further while their cache efficiency stays within the threshold
+
+		std::vector<uint32_t> clusters;
+		for (uint32_t c = 0; c + 1 < hardClusters.size(); ++c)
+		{
+			const uint32_t start = hardClusters[c];
+			const uint32_t end = hardClusters[c + 1];
+
+			std::fill(cacheTimestamps.begin(), cacheTimestamps.end(), 0);
+			timestamp = cacheSize + 1;
+
+			uint32_t clusterMisses = 0;
+			for (uint32_t i = start; i < end; ++i)
+			{
+				clusterMisses += simulateCache(indices + i * 3, cacheTimestamps, timestamp, cacheSize);
+			}
+
+			const float clusterThreshold = threshold * static_cast<float>(clusterMisses) / (end - start);
+
+			std::fill(cacheTimestamps.begin(), cacheTimestamps.end(), 0);
+			timestamp = cacheSize + 1;
+
+			clusters.push_back(start);
+
+			uint32_t misses = 0;
+			uint32_t clusterStart = start;
+			for (uint32_t i = start; i < end; ++i)
+			{
+				misses += simulateCache(indices + i * 3, cacheTimestamps, timestamp, cacheSize);
+
+				if (i + 1 < end && misses <= clusterThreshold * (i + 1 - clusterStart))
+				{
+					clusters.push_back(i + 1);
+					clusterStart = i + 1;
+					misses = 0;
+
+					std::fill(cacheTimestamps.begin(), cacheTimestamps.end(), 0);
+					timestamp = cacheSize + 1;
+				}
+			}
+		}
+		clusters.push_back(triangleCount);
+
+		// Sort clusters by how much they face outward of the mesh
+
+		scp::f32vec3 meshCentroid = { 0.f, 0.f, 0.f };
+		for (uint32_t i = 0; i < indexCount; ++i)
+		{
+			meshCentroid += positions[indices[i]];
+		}
+		meshCentroid /= static_cast<float>(indexCount);
+
+		const uint32_t clusterCount = clusters.size() - 1;
+		std::vector<float> sortKeys(clusterCount);
+		for (uint32_t c = 0; c < clusterCount; ++c)
+		{
+			scp::f32vec3 centroid = { 0.f, 0.f, 0.f };
+			scp::f32vec3 normal = { 0.f, 0.f, 0.f };
+			float area = 0.f;
+
+			for (uint32_t i = clusters[c]; i < clusters[c + 1]; ++i)
+			{
+				const scp::f32vec3& p0 = positions[indices[i * 3]];
+				const scp::f32vec3& p1 = positions[indices[i * 3 + 1]];
+				const scp::f32vec3& p2 = positions[indices[i * 3 + 2]];
+
+				const scp::f32vec3 n = scp::cross(p1 - p0, p2 - p0);
+				const float triangleArea = scp::length(n);
+
+				centroid += (p0 + p1 + p2) * (triangleArea / 3.f);
+				normal += n;
+				area += triangleArea;
+			}
+
+			const float normalLength = scp::length(normal);
+			if (area == 0.f || normalLength == 0.f)
+			{
+				sortKeys[c] = 0.f;
+			}
+			else
+			{
+				sortKeys[c] = scp::dot(centroid / area - meshCentroid, normal / normalLength);
+			}
+		}
+
+		std::vector<uint32_t> clusterOrder(clusterCount);
+		for (uint32_t c = 0; c < clusterCount; ++c)
+		{
+			clusterOrder[c] = c;
+		}
+
+		std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&](uint32_t a, uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+
+		std::vector<uint32_t> result;
+		result.reserve(indexCount);
+		for (uint32_t c : clusterOrder)
+		{
+			result.insert(result.end(), indices + clusters[c] * 3, indices + clusters[c + 1] * 3);
+		}
+
+		std::copy(result.begin(), result.end(), indices);
+	}
+
+	uint32_t simplifyMesh(const uint32_t* indices, uint32_t indexCount, const scp::f32vec3* positions, uint32_t vertexCount, uint32_t targetIndexCount, float targetError, uint32_t* simplifiedIndices, float& error)
+	{
+		assert(indices || indexCount == 0);
+		assert(positions || vertexCount == 0);
+		assert(simplifiedIndices || indexCount == 0);
+		assert(indexCount % 3 == 0);
+
+		error = 0.f;
+
+		std::vector<uint32_t> result(indices, indices + indexCount);
+		if (indexCount == 0)
+		{
+			return 0;
+		}
+
+		// Errors are computed relative to the bounding sphere radius
+
+		scp::f32vec3 boundingBoxMin = positions[indices[0]];
+		scp::f32vec3 boundingBoxMax = positions[indices[0]];
+		for (uint32_t i = 0; i < indexCount; ++i)
+		{
+			const scp::f32vec3& p = positions[indices[i]];
+			boundingBoxMin = { std::min(boundingBoxMin.x, p.x), std::min(boundingBoxMin.y, p.y), std::min(boundingBoxMin.z, p.z) };
+			boundingBoxMax = { std::max(boundingBoxMax.x, p.x), std::max(boundingBoxMax.y, p.y), std::max(boundingBoxMax.z, p.z) };
+		}
+
+		const double radius = scp::length(boundingBoxMax - boundingBoxMin) * 0.5;
+		const double maxCost = radius == 0.0 ? 0.0 : (targetError * radius) * (targetError * radius);
+
+		// Lock vertices on attribute seams (several vertices at the same position) and on borders
+
+		std::vector<bool> locked(vertexCount, false);
+
+		std::unordered_map<PositionKey, uint32_t, PositionKeyHash> positionMap;
+		positionMap.reserve(vertexCount);
+		for (uint32_t i = 0; i < vertexCount; ++i)
+		{
+			const PositionKey key = { std::bit_cast<uint32_t>(positions[i].x), std::bit_cast<uint32_t>(positions[i].y), std::bit_cast<uint32_t>(positions[i].z) };
+			const auto [it, inserted] = positionMap.try_emplace(key, i);
+			if (!inserted)
+			{
+				locked[i] = true;
+				locked[it->second] = true;
+			}
+		}
+
+		std::unordered_map<uint64_t, uint32_t> edgeCounts;
+		edgeCounts.reserve(indexCount);
+		for (uint32_t i = 0; i < indexCount; i += 3)
+		{
+			for (uint32_t j = 0; j < 3; ++j)
+			{
+				const uint32_t a = indices[i + j];
+				const uint32_t b = indices[i + (j + 1) % 3];
+				++edgeCounts[(static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b)];
+			}
+		}
+
+		for (const std::pair<const uint64_t, uint32_t>& edge : edgeCounts)
+		{
+			if (edge.second == 1)
+			{
+				locked[edge.first >> 32] = true;
+				locked[edge.first & UINT32_MAX] = true;
+			}
+		}
+
+		// Vertex quadrics from the planes of their triangles
+
+		std::vector<Quadric> quadrics(vertexCount, Quadric{});
+		for (uint32_t i = 0; i < indexCount; i += 3)
+		{
+			const scp::f32vec3& p0 = positions[indices[i]];
+			const scp::f32vec3 n = scp::cross(positions[indices[i + 1]] - p0, positions[indices[i + 2]] - p0);
+			const float length = scp::length(n);
+			if (length == 0.f)
+			{
+				continue;
+			}
+
+			const scp::f32vec3 normal = n / length;
+			const double d = -scp::dot(normal, p0);
+
+			for (uint32_t j = 0; j < 3; ++j)
+			{
+				quadrics[indices[i + j]].addPlane(normal.x, normal.y, normal.z, d);
+			}
+		}
+
+		// Collapse edges by passes, cheapest first, each vertex being touched at most once per pass
+
+		TriangleAdjacency adjacency;
+		std::vector<Collapse> collapses;
+		std::vector<uint32_t> remap(vertexCount);
+		std::vector<bool> touched(vertexCount);
+		double reachedCost = 0.0;
+
+		while (result.size() > targetIndexCount)
+		{
+			collapses.clear();
+			for (uint32_t i = 0; i < result.size(); i += 3)
+			{
+				for (uint32_t j = 0; j < 3; ++j)
+				{
+					const uint32_t a = result[i + j];
+					const uint32_t b = result[i + (j + 1) % 3];
+
+					for (const auto [from, to] : { std::pair(a, b), std::pair(b, a) })
+					{
+						if (!locked[from])
+						{
+							Quadric q = quadrics[from];
+							q.add(quadrics[to]);
+							collapses.push_back({ from, to, q.evaluate(positions[to]) });
+						}
+					}
+				}
+			}
+
+			if (collapses.empty())
+			{
+				break;
+			}
+
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+			buildTriangleAdjacency(adjacency, result.data(), result.size(), vertexCount);
+
+			for (uint32_t i = 0; i < vertexCount; ++i)
+			{
+				remap[i] = i;
+			}
+			std::fill(touched.begin(), touched.end(), false);
+
+			uint32_t triangleCount = result.size() / 3;
+			uint32_t collapseCount = 0;
+			for (const Collapse& collapse : collapses)
+			{
+				if (triangleCount * 3 <= targetIndexCount || collapse.cost > maxCost)
+				{
+					break;
+				}
+
+				if (touched[collapse.from] || touched[collapse.to] || collapseFlipsTriangle(result, adjacency, positions, collapse.from, collapse.to))
+				{
+					continue;
+				}
+
+				remap[collapse.from] = collapse.to;
+				quadrics[collapse.to].add(quadrics[collapse.from]);
+				reachedCost = std::max(reachedCost, collapse.cost);
+				++collapseCount;
+
+				// The triangles around `from` change, so their vertices cannot be collapsed again in this pass
+
+				const uint32_t* neighbours = adjacency.triangles.data() + adjacency.offsets[collapse.from];
+				for (uint32_t j = 0; j < adjacency.counts[collapse.from]; ++j)
+				{
+					const uint32_t* triangle = result.data() + neighbours[j] * 3;
+					touched[triangle[0]] = true;
+					touched[triangle[1]] = true;
+					touched[triangle[2]] = true;
+
+					if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+					{
+						--triangleCount;
+					}
+				}
+			}
+
+			if (collapseCount == 0)
+			{
+				break;
+			}
+
+			// Apply the collapses and remove the degenerate triangles
+
+			uint32_t writeIndex = 0;
+			for (uint32_t i = 0; i < result.size(); i += 3)
+			{
+				const uint32_t a = remap[result[i]];
+				const uint32_t b = remap[result[i + 1]];
+				const uint32_t c = remap[result[i + 2]];
+
+				if (a != b && b != c && c != a)
+				{
+					result[writeIndex++] = a;
+					result[writeIndex++] = b;
+					result[writeIndex++] = c;
+				}
+			}
+			result.resize(writeIndex);
+		}
+
+		error = radius == 0.0 ? 0.f : static_cast<float>(std::sqrt(reachedCost) / radius);
+
+		std::copy(result.begin(), result.end(), simplifiedIndices);
+		return result.size();
+	}
+
+	void generateLodChain(const uint32_t* indices, uint32_t indexCount, const scp::f32vec3* positions, uint32_t vertexCount, std::vector<uint32_t>& lodIndices, std::vector<MeshLod>& lods, uint32_t maxLodCount)
+	{
+		assert(maxLodCount > 0);
+
+		lodIndices.assign(indices, indices + indexCount);
+		lods.assign(1, { 0, indexCount, 0.f });
+
+		// Each LOD is simplified from the original mesh so that its error is measured against the real surface
+
+		std::vector<uint32_t> simplifiedIndices(indexCount);
+		for (uint32_t i = 1; i < maxLodCount; ++i)
+		{
+			const uint32_t previousIndexCount = lods.back().indexCount;
+			const uint32_t targetIndexCount = (previousIndexCount / 6) * 3;
+			if (targetIndexCount == 0)
+			{
+				break;
+			}
+
+			float error;
+			const uint32_t simplifiedIndexCount = simplifyMesh(indices, indexCount, positions, vertexCount, targetIndexCount, 1.f, simplifiedIndices.data(), error);
+
+			// Not worth a LOD if the simplification stalled
+
+			if (simplifiedIndexCount == 0 || simplifiedIndexCount > previousIndexCount * 0.9f)
+			{
+				break;
+			}
+
+			optimizeVertexCache(simplifiedIndices.data(), simplifiedIndexCount, vertexCount);
+
+			lods.push_back({ static_cast<uint32_t>(lodIndices.size()), simplifiedIndexCount, std::max(error, lods.back().error) });
+			lodIndices.insert(lodIndices.end(), simplifiedIndices.begin(), simplifiedIndices.begin() + simplifiedIndexCount);
+		}
+	}
+
+	void buildMeshlets(const uint32_t* indices, uint32_t indexCount, const scp::f32vec3* positions, uint32_t vertexCount, std::vector<Meshlet>& meshlets, uint32_t maxVertexCount, uint32_t maxTriangleCount)
+	{
+		assert(indices || indexCount == 0);
+		assert(positions || vertexCount == 0);
+		assert(indexCount % 3 == 0);
+		assert(maxVertexCount >= 3);
+		assert(maxTriangleCount > 0);
+
+		meshlets.clear();
+
+		// Split the triangles in contiguous ranges, so that each meshlet can be drawn straight from the index buffer
+
+		std::vector<uint32_t> vertexStamps(vertexCount, UINT32_MAX);
+		uint32_t meshletVertexCount = 0;
+		uint32_t meshletBegin = 0;
+
+		std::vector<std::pair<uint32_t, uint32_t>> ranges;
+		for (uint32_t i = 0; i < indexCount; i += 3)
+		{
+			uint32_t newVertexCount = 0;
+			for (uint32_t j = 0; j < 3; ++j)
+			{
+				assert(indices[i + j] < vertexCount);
+				newVertexCount += vertexStamps[indices[i + j]] != ranges.size();
+			}
+
+			if (meshletVertexCount + newVertexCount > maxVertexCount || (i - meshletBegin) / 3 == maxTriangleCount)
+			{
+				ranges.emplace_back(meshletBegin, i - meshletBegin);
+				meshletBegin = i;
+				meshletVertexCount = 0;
+			}
+
+			const uint32_t stamp = ranges.size();
+			for (uint32_t j = 0; j < 3; ++j)
+			{
+				if (vertexStamps[indices[i + j]] != stamp)
+				{
+					vertexStamps[indices[i + j]] = stamp;
+					++meshletVertexCount;
+				}
+			}
+		}
+
+		if (meshletBegin != indexCount)
+		{
+			ranges.emplace_back(meshletBegin, indexCount - meshletBegin);
+		}
+
+		// Compute the bounding sphere and the normal cone of each meshlet
+
+		meshlets.reserve(ranges.size());
+		for (const auto& [offset, count] : ranges)
+		{
+			scp::f32vec3 bbMin = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+			scp::f32vec3 bbMax = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+			for (uint32_t i = offset; i < offset + count; ++i)
+			{
+				bbMin = scp::min(bbMin, positions[indices[i]]);
+				bbMax = scp::max(bbMax, positions[indices[i]]);
+			}
+
+			Meshlet meshlet;
+			meshlet.indexOffset = offset;
+			meshlet.indexCount = count;
+			meshlet.center = (bbMin + bbMax) * 0.5f;
+			meshlet.radius = 0.f;
+			for (uint32_t i = offset; i < offset + count; ++i)
+			{
+				meshlet.radius = std::max(meshlet.radius, scp::length(positions[indices[i]] - meshlet.center));
+			}
+
+			std::vector<scp::f32vec3> normals;
+			normals.reserve(count / 3);
+			scp::f32vec3 normalSum = { 0.f, 0.f, 0.f };
+			for (uint32_t i = offset; i < offset + count; i += 3)
+			{
+				const scp::f32vec3& a = positions[indices[i]];
+				const scp::f32vec3 normal = scp::cross(positions[indices[i + 1]] - a, positions[indices[i + 2]] - a);
+				const float normalLength = scp::length(normal);
+				if (normalLength != 0.f)
+				{
+					normals.push_back(normal / normalLength);
+					normalSum += normals.back();
+				}
+			}
+
+			// A cutoff of 1 means the cone test never succeeds
+
+			const float normalSumLength = scp::length(normalSum);
+			if (normalSumLength == 0.f)
+			{
+				meshlet.coneAxis = { 0.f, 0.f, 0.f };
+				meshlet.coneCutoff = 1.f;
+			}
+			else
+			{
+				meshlet.coneAxis = normalSum / normalSumLength;
+
+				float minDot = 1.f;
+				for (const scp::f32vec3& normal : normals)
+				{
+					minDot = std::min(minDot, scp::dot(normal, meshlet.coneAxis));
+				}
+
+				meshlet.coneCutoff = minDot <= 0.f ? 1.f : std::sqrt(1.f - minDot * minDot);
+			}
+
+			meshlets.push_back(meshlet);
+		}
+	}
+
+	uint32_t computeVertexFetchRemap(const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount, uint32_t* remap)
+	{
+		assert(indices || indexCount == 0);
+		assert(remap || vertexCount == 0);
+
+		std::fill(remap, remap + vertexCount, UINT32_MAX);
+
+		uint32_t nextVertex = 0;
+		for (uint32_t i = 0; i < indexCount; ++i)
+		{
+			assert(indices[i] < vertexCount);
+
+			if (remap[indices[i]] == UINT32_MAX)
+			{
+				remap[indices[i]] = nextVertex++;
+			}
+		}
+
+		return nextVertex;
+	}
+}
@@ -0,0 +1,256 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <Lyse/Core/Core.hpp>
+
+namespace lys
+{
+	OcclusionBuffer::OcclusionBuffer() :
+		_depths(),
+		_tileDepths(),
+		_resolution(0, 0),
+		_tileResolution(0, 0),
+		_view(),
+		_projection(),
+		_near(0.f)
+	{
+	}
+
+	void OcclusionBuffer::clear(const scp::u32vec2& resolution, const CameraBase* camera)
+	{
+		assert(resolution.x > 0 && resolution.y > 0);
+
+		_resolution = resolution;
+		_tileResolution = { (resolution.x + tileSize - 1) / tileSize, (resolution.y + tileSize - 1) / tileSize };
+
+		_depths.assign(_resolution.x * _resolution.y, 1.f);
+		_tileDepths.assign(_tileResolution.x * _tileResolution.y, 1.f);
+
+		_view = camera->getViewMatrix();
+		_projection = camera->getProjectionMatrix();
+		_near = camera->getNearDistance();
+	}
+
+	void OcclusionBuffer::rasterize(const scp::f32vec3* positions, const uint32_t* indices, uint32_t indexCount, const scp::f32mat4x4& model, uint32_t rowBegin, uint32_t rowEnd)
+	{
+		assert(positions || indexCount == 0);
+		assert(indices || indexCount == 0);
+		assert(indexCount % 3 == 0);
+		assert(rowBegin <= rowEnd && rowEnd <= _resolution.y);
+
+		const scp::f32mat4x4 viewModel = _view * model;
+		const scp::f32vec2 resolution = { static_cast<float>(_resolution.x), static_cast<float>(_resolution.y) };
+
+		for (uint32_t i = 0; i < indexCount; i += 3)
+		{
+			// Screen-space vertices, triangles crossing the near plane are skipped, which is conservative
+
+			scp::f32vec3 vertices[3];
+			bool crossesNearPlane = false;
+
+			for (uint32_t j = 0; j < 3; ++j)
+			{
+				const scp::f32vec4 viewVertex = viewModel * scp::f32vec4(positions[indices[i + j]], 1.f);
+				if (-viewVertex.z <= _near)
+				{
+					crossesNearPlane = true;
+					break;
+				}
+
+				const scp::f32vec4 clipVertex = _projection * viewVertex;
+				vertices[j].x = (clipVertex.x / clipVertex.w * 0.5f + 0.5f) * resolution.x;
+				vertices[j].y = (clipVertex.y / clipVertex.w * 0.5f + 0.5f) * resolution.y;
+				vertices[j].z = clipVertex.z / clipVertex.w;
+			}
+
+			if (crossesNearPlane)
+			{
+				continue;
+			}
+
+			// Occluders are not back-face culled, the nearest face wins anyway
+
+			float area = (vertices[1].x - vertices[0].x) * (vertices[2].y - vertices[0].y) - (vertices[2].x - vertices[0].x) * (vertices[1].y - vertices[0].y);
+			if (area == 0.f)
+			{
+				continue;
+			}
+			else if (area < 0.f)
+			{
+				std::swap(vertices[1], vertices[2]);
+				area = -area;
+			}
+
+			// Pixels whose center is in the bounding rectangle of the triangle
+
+			const float xMin = std::min({ vertices[0].x, vertices[1].x, vertices[2].x });
+			const float xMax = std::max({ vertices[0].x, vertices[1].x, vertices[2].x });
+			const float yMin = std::min({ vertices[0].y, vertices[1].y, vertices[2].y });
+			const float yMax = std::max({ vertices[0].y, vertices[1].y, vertices[2].y });
+
+			if (xMax < 0.5f || xMin > resolution.x - 0.5f || yMax < rowBegin + 0.5f || yMin > rowEnd - 0.5f)
+			{
+				continue;
+			}
+
+			const uint32_t xBegin = static_cast<uint32_t>(std::max(std::ceil(xMin - 0.5f), 0.f));
+			const uint32_t xEnd = static_cast<uint32_t>(std::min(std::floor(xMax - 0.5f), resolution.x - 1.f)) + 1;
+			const uint32_t yBegin = static_cast<uint32_t>(std::max(std::ceil(yMin - 0.5f), static_cast<float>(rowBegin)));
+			const uint32_t yEnd = static_cast<uint32_t>(std::min(std::floor(yMax - 0.5f), rowEnd - 1.f)) + 1;
+
+			// Edge functions and depth plane, as `a * x + b * y + c`, evaluated at pixel centers. Occluders must be
+			// conservative: the edges are moved in by half a pixel so that only the pixels the triangle fully covers
+			// are written, and the depth is moved back to the farthest corner of the pixel.
+
+			float edgeA[3], edgeB[3], edgeC[3];
+			for (uint32_t j = 0; j < 3; ++j)
+			{
+				const scp::f32vec3& v0 = vertices[j];
+				const scp::f32vec3& v1 = vertices[(j + 1) % 3];
+
+				edgeA[j] = v0.y - v1.y;
+				edgeB[j] = v1.x - v0.x;
+				edgeC[j] = v0.x * v1.y - v0.y * v1.x - 0.5f * (std::abs(edgeA[j]) + std::abs(edgeB[j]));
+			}
+
+			const float depthA = ((vertices[1].z - vertices[0].z) * (vertices[2].y - vertices[0].y) - (vertices[2].z - vertices[0].z) * (vertices[1].y - vertices[0].y)) / area;
+			const float depthB = ((vertices[2].z - vertices[0].z) * (vertices[1].x - vertices[0].x) - (vertices[1].z - vertices[0].z) * (vertices[2].x - vertices[0].x)) / area;
+			const float depthC = vertices[0].z - depthA * vertices[0].x - depthB * vertices[0].y + 0.5f * (std::abs(depthA) + std::abs(depthB));
+
+			for (uint32_t y = yBegin; y < yEnd; ++y)
+			{
+				const float py = y + 0.5f;
+
+				const float rowEdge0 = edgeB[0] * py + edgeC[0];
+				const float rowEdge1 = edgeB[1] * py + edgeC[1];
+				const float rowEdge2 = edgeB[2] * py + edgeC[2];
+				const float rowDepth = depthB * py + depthC;
+
+				// Branchless span so that the compiler vectorizes it
+
+				float* row = _depths.data() + y * _resolution.x;
+				for (uint32_t x = xBegin; x < xEnd; ++x)
+				{
+					const float px = x + 0.5f;
+
+					const bool inside = (edgeA[0] * px + rowEdge0 >= 0.f) & (edgeA[1] * px + rowEdge1 >= 0.f) & (edgeA[2] * px + rowEdge2 >= 0.f);
+					const float depth = depthA * px + rowDepth;
+
+					row[x] = inside ? std::min(row[x], depth) : row[x];
+				}
+			}
+		}
+	}
+
+	void OcclusionBuffer::updateTiles()
+	{
+		std::fill(_tileDepths.begin(), _tileDepths.end(), 0.f);
+
+		for (uint32_t y = 0; y < _resolution.y; ++y)
+		{
+			const float* row = _depths.data() + y * _resolution.x;
+			float* tileRow = _tileDepths.data() + (y / tileSize) * _tileResolution.x;
+
+			for (uint32_t x = 0; x < _resolution.x; ++x)
+			{
+				tileRow[x / tileSize] = std::max(tileRow[x / tileSize], row[x]);
+			}
+		}
+	}
+
+	bool OcclusionBuffer::isBoxOccluded(const scp::f32vec3& min, const scp::f32vec3& max, const scp::f32mat4x4& model) const
+	{
+		if (_depths.empty())
+		{
+			return false;
+		}
+
+		const scp::f32mat4x4 viewModel = _view * model;
+
+		// Screen-space rectangle and nearest depth of the box
+
+		scp::f32vec2 ndcMin = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+		scp::f32vec2 ndcMax = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+		float minDepth = std::numeric_limits<float>::max();
+
+		for (uint32_t i = 0; i < 8; ++i)
+		{
+			const scp::f32vec4 corner = { (i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z, 1.f };
+			const scp::f32vec4 viewCorner = viewModel * corner;
+
+			if (-viewCorner.z <= _near)
+			{
+				return false;
+			}
+
+			const scp::f32vec4 clipCorner = _projection * viewCorner;
+			const scp::f32vec2 ndcCorner = { clipCorner.x / clipCorner.w, clipCorner.y / clipCorner.w };
+
+			ndcMin = scp::min(ndcMin, ndcCorner);
+			ndcMax = scp::max(ndcMax, ndcCorner);
+			minDepth = std::min(minDepth, clipCorner.z / clipCorner.w);
+		}
+
+		if (ndcMax.x < -1.f || ndcMin.x > 1.f || ndcMax.y < -1.f || ndcMin.y > 1.f)
+		{
+			return false;
+		}
+
+		// Every pixel touched by the rectangle, tested tile by tile first
+
+		const auto toPixel = [](float ndc, uint32_t size) {
+			return static_cast<uint32_t>(std::clamp((ndc * 0.5f + 0.5f) * size, 0.f, size - 1.f));
+		};
+
+		const uint32_t xBegin = toPixel(ndcMin.x, _resolution.x);
+		const uint32_t xEnd = toPixel(ndcMax.x, _resolution.x);
+		const uint32_t yBegin = toPixel(ndcMin.y, _resolution.y);
+		const uint32_t yEnd = toPixel(ndcMax.y, _resolution.y);
+
+		bool tilesOccluded = true;
+		for (uint32_t y = yBegin / tileSize; y <= yEnd / tileSize && tilesOccluded; ++y)
+		{
+			for (uint32_t x = xBegin / tileSize; x <= xEnd / tileSize; ++x)
+			{
+				if (_tileDepths[y * _tileResolution.x + x] >= minDepth)
+				{
+					tilesOccluded = false;
+					break;
+				}
+			}
+		}
+
+		if (tilesOccluded)
+		{
+			return true;
+		}
+
+		for (uint32_t y = yBegin; y <= yEnd; ++y)
+		{
+			const float* row = _depths.data() + y * _resolution.x;
+			for (uint32_t x = xBegin; x <= xEnd; ++x)
+			{
+				if (row[x] >= minDepth)
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	const scp::u32vec2& OcclusionBuffer::getResolution() const
+	{
+		return _resolution;
+	}
+
+	const float* OcclusionBuffer::getDepths() const
+	{
+		return _depths.data();
+	}
+}
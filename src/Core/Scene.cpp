@@ -9,6 +9,10 @@
 
 #include "Shaders/shaders.cpp"
 
+#ifdef LYSE_PRECOMPILED_SHADERS
+#include "shaders_spirv.cpp"
+#endif
+
 namespace lys
 {
 	namespace
@@ -40,6 +44,9 @@ namespace lys
 			alignas(16) scp::f32mat4x4 invViewModel;
 			alignas(16) scp::f32mat4x4 projectionViewModel;
 			alignas(16) scp::f32mat4x4 invProjectionViewModel;
+			alignas(16) scp::f32vec3 positionOffset;
+			alignas(16) scp::f32vec3 positionScale;
+			alignas(4) uint32_t materialIndex;
 		};
 
 		struct alignas(16) UboShadowCameraData
@@ -55,9 +62,397 @@ namespace lys
 			alignas(4) uint32_t count;
 			alignas(16) UboShadowCameraData cameras[SceneParameters::maxShadowTextureCount];
 		};
+
 		#pragma pack(pop)
+
+		struct alignas(16) UboCullingData
+		{
+			alignas(16) scp::f32vec4 frustumPlanes[6];
+			alignas(16) scp::f32vec3 eye;
+			alignas(4) float lodErrorThreshold;
+			alignas(8) scp::u32vec2 resolution;
+			alignas(4) uint32_t drawableCount;
+			alignas(4) uint32_t shadowLodBias;
+			alignas(8) scp::u32vec2 shadowResolution;
+
+			alignas(16) scp::f32mat4x4 pyramidView;
+			alignas(16) scp::f32mat4x4 pyramidProjection;
+			alignas(4) float pyramidNear;
+			alignas(4) float pyramidFar;
+			alignas(4) uint32_t pyramidLevelCount;
+
+			alignas(4) uint32_t flags;
+		};
+
+		struct alignas(16) SsboDrawableCullingData
+		{
+			alignas(16) scp::f32vec3 boundingBoxMin;
+			alignas(4) uint32_t lodOffset;
+			alignas(16) scp::f32vec3 boundingBoxMax;
+			alignas(4) uint32_t lodCount;
+			alignas(4) uint32_t meshletOffset;
+			alignas(4) uint32_t meshletCount;
+			alignas(4) uint32_t commandOffset;
+			alignas(4) uint32_t flags;
+		};
+
+		struct alignas(16) SsboMeshletData
+		{
+			alignas(4) uint32_t indexOffset;
+			alignas(4) uint32_t indexCount;
+			alignas(16) scp::f32vec3 center;
+			alignas(4) float radius;
+			alignas(16) scp::f32vec3 coneAxis;
+			alignas(4) float coneCutoff;
+		};
+
+		struct alignas(16) SsboMaterialData
+		{
+			alignas(16) scp::f32vec4 color;
+			alignas(16) scp::f32vec3 properties;
+			alignas(4) int32_t colorLayer;
+			alignas(4) int32_t propertiesLayer;
+		};
+
+		struct SsboDrawCommand
+		{
+			uint32_t count;
+			uint32_t instanceCount;
+			uint32_t firstIndex;
+			int32_t baseVertex;
+			uint32_t baseInstance;
+		};
+
+		// Flags of `UboCullingData` and `SsboDrawableCullingData`, must match `culling.comp`
+
+		constexpr uint32_t cullingFrustum = 1;
+		constexpr uint32_t cullingCluster = 2;
+		constexpr uint32_t cullingOcclusion = 4;
+		constexpr uint32_t cullingLodSelection = 8;
+
+		constexpr uint32_t cullingCone = 1;
+		constexpr uint32_t cullingConeFlipped = 2;
+
+		constexpr uint32_t maxDepthPyramidTextureCount = 16;	// Sampled by the GPU-driven culling, as many as `culling.comp`
+
+		// Draws recorded in the same command buffer, a pass is recorded by as many jobs as it has buckets
+
+		constexpr uint32_t drawBucketSize = 64;
+
+		// Shader storage binding of the material table, after the ones of the culling shader
+
+		constexpr uint32_t materialsBinding = 8;
+
+		// Layers of a material texture array, below the minimum `GL_MAX_ARRAY_TEXTURE_LAYERS` of OpenGL 4.5
+
+		constexpr uint32_t maxMaterialTextureLayerCount = 256;
+
+		// Textures of the materials with the same size and format, copied into the layers of one texture array
+
+		struct MaterialTextureArray
+		{
+			scp::u32vec2 size;
+			spl::TextureInternalFormat format;
+			std::vector<const spl::Texture2D*> layers;
+		};
+
+		// Color, material and normal map bits of a mesh shader variant
+
+		constexpr uint32_t textureVariantMask = 0b111;
+
+		// Bit per light type in the lights of a frame, as `LIGHT_TYPES` in the shaders. The generic lighting handles all.
+
+		constexpr uint32_t allLightTypes = 0b111;
+
+		// FNV-1a, to tell a frame that sees the same camera and lights as the previous one, and to name the cached
+		// program binaries
+
+		constexpr uint64_t fnvOffsetBasis = 14695981039346656037ull;
+		constexpr uint64_t fnvPrime = 1099511628211ull;
+
+		uint64_t hashBytes(uint64_t hash, const void* data, uint64_t size)
+		{
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+			for (uint64_t i = 0; i < size; ++i)
+			{
+				hash = (hash ^ bytes[i]) * fnvPrime;
+			}
+
+			return hash;
+		}
+
+		uint64_t hashShaderModule(spl::ShaderStage::Stage stage, const std::vector<std::string_view>& sources)
+		{
+			uint64_t hash = hashBytes(fnvOffsetBasis, &stage, sizeof(spl::ShaderStage::Stage));
+			for (const std::string_view& src : sources)
+			{
+				hash = hashBytes(hash, src.data(), src.size());
+			}
+
+			return hash;
+		}
+
+		// A cached program binary is its format followed by the bytes returned by the driver
+
+		bool readProgramBinary(const std::filesystem::path& path, uint32_t& format, std::vector<uint8_t>& binary)
+		{
+			std::FILE* file = std::fopen(path.string().c_str(), "rb");
+			if (!file)
+			{
+				return false;
+			}
+
+			std::fseek(file, 0, SEEK_END);
+			const long fileSize = std::ftell(file);
+			std::fseek(file, 0, SEEK_SET);
+
+			bool success = fileSize > static_cast<long>(sizeof(uint32_t));
+			if (success)
+			{
+				binary.resize(fileSize - sizeof(uint32_t));
+				success = std::fread(&format, sizeof(uint32_t), 1, file) == 1
+					&& std::fread(binary.data(), 1, binary.size(), file) == binary.size();
+			}
+
+			std::fclose(file);
+
+			return success;
+		}
+
+		void writeProgramBinary(const std::filesystem::path& path, uint32_t format, const std::vector<uint8_t>& binary)
+		{
+			std::FILE* file = std::fopen(path.string().c_str(), "wb");
+			if (!file)
+			{
+				return;
+			}
+
+			std::fwrite(&format, sizeof(uint32_t), 1, file);
+			std::fwrite(binary.data(), 1, binary.size(), file);
+			std::fclose(file);
+		}
+
+		// SPIR-V does not have to keep the names, some drivers reflect its uniforms without them
+
+		bool hasUniformNames(const spl::ShaderProgram& shader)
+		{
+			const spl::ShaderProgramInterfaceInfos& interfaceInfos = shader.getInterfaceInfos(spl::ShaderProgramInterface::Uniform);
+			for (int32_t i = 0; i < interfaceInfos.activeResources; ++i)
+			{
+				if (shader.getResourceInfos(spl::ShaderProgramInterface::Uniform, i).name.empty())
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		#ifdef LYSE_COUNT_ALLOCATIONS
+
+			// Frames a scene must stay unchanged before it is expected not to allocate, both packets and the scratch
+			// buffers have reached their size by then
+
+			constexpr uint32_t steadyFrameCount = 3;
+
+		#endif
+
+		void computeDrawableData(UboDrawableData& drawableData, const CameraBase* camera, const scp::f32mat4x4& model, const scp::f32mat4x4& invModel, const MeshBase* compactMesh, uint32_t materialIndex)
+		{
+			drawableData.model = model;
+			drawableData.invModel = invModel;
+			drawableData.viewModel = camera->getViewMatrix() * drawableData.model;
+			drawableData.invViewModel = drawableData.invModel * camera->getInverseViewMatrix();
+			drawableData.projectionViewModel = camera->getProjectionMatrix() * drawableData.viewModel;
+			drawableData.invProjectionViewModel = drawableData.invViewModel * camera->getInverseProjectionMatrix();
+
+			// Compact vertices store their positions normalized in the bounding box of the mesh
+
+			if (compactMesh)
+			{
+				drawableData.positionOffset = compactMesh->getBoundingBoxMin();
+				drawableData.positionScale = compactMesh->getBoundingBoxMax() - compactMesh->getBoundingBoxMin();
+			}
+			else
+			{
+				drawableData.positionOffset = { 0.f, 0.f, 0.f };
+				drawableData.positionScale = { 1.f, 1.f, 1.f };
+			}
+
+			drawableData.materialIndex = materialIndex;
+		}
+
+		// Scale of a model matrix if it is uniform and keeps the orientation, zero otherwise
+
+		float getUniformScale(const scp::f32mat4x4& model, float& maxScale)
+		{
+			const scp::f32vec4 x = model * scp::f32vec4(1.f, 0.f, 0.f, 0.f);
+			const scp::f32vec4 y = model * scp::f32vec4(0.f, 1.f, 0.f, 0.f);
+			const scp::f32vec4 z = model * scp::f32vec4(0.f, 0.f, 1.f, 0.f);
+
+			const float xScale = scp::length(scp::f32vec3(x.x, x.y, x.z));
+			const float yScale = scp::length(scp::f32vec3(y.x, y.y, y.z));
+			const float zScale = scp::length(scp::f32vec3(z.x, z.y, z.z));
+			maxScale = std::max({ xScale, yScale, zScale });
+
+			const float determinant = scp::dot(scp::cross(scp::f32vec3(x.x, x.y, x.z), scp::f32vec3(y.x, y.y, y.z)), scp::f32vec3(z.x, z.y, z.z));
+			const float tolerance = 1e-4f * maxScale;
+			if (determinant <= 0.f || std::abs(xScale - yScale) > tolerance || std::abs(xScale - zScale) > tolerance)
+			{
+				return 0.f;
+			}
+
+			return xScale;
+		}
 	}
 
+	struct Scene::FrameDraw
+	{
+		const ShaderSet* shaderSet;
+		const Drawable* drawable;
+		uint32_t materialIndex;					// In the material table of the packet
+		const spl::Texture2D* normalMap;
+		spl::FaceCullingMode faceCullingMode;
+		spl::FaceOrientation faceCullingOrientation;
+
+		uint32_t lod;
+		bool meshletsCulled;					// Only the ranges of the visible meshlets are drawn
+		uint32_t firstRange;
+		uint32_t rangeCount;
+
+		uint32_t gpuIndex;						// UINT32_MAX if the drawable is not culled and drawn by the GPU
+		bool occlusionTested;					// Tested against the depth pyramid, with its local bounding box
+		scp::f32vec3 boundingBoxMin;
+		scp::f32vec3 boundingBoxMax;
+		UboDrawableData drawableData;
+	};
+
+	struct Scene::GpuDrawableLayout
+	{
+		std::vector<const MeshBase*> meshes;
+		std::vector<uint32_t> entries;		// Registry entry of each mesh
+		std::vector<uint32_t> commandOffsets;
+		std::vector<MeshLod> lods;
+		std::vector<SsboMeshletData> meshlets;
+		uint32_t commandCount;
+	};
+
+	struct Scene::MaterialTable
+	{
+		std::vector<Material> materials;					// Copies, the materials may be edited while the frame is submitted
+		std::vector<SsboMaterialData> materialsData;
+		std::vector<MaterialTextureArray> textureArrays;	// Empty if `materialTextureArraysEnabled` is false
+		std::vector<scp::u32vec2> textureArrayIndices;		// Color and properties texture arrays of each material
+	};
+
+	// Everything `submit` needs to draw a frame, the scene can change once it is prepared
+
+	struct Scene::FramePacket
+	{
+		CameraBase::UboCameraData camera;
+		std::optional<Frustum> frustum;
+
+		std::vector<UboLightData> lights;
+		uint32_t lightTypes;	// Bit per light type, selects the lighting shaders specialized to them
+		std::vector<UboShadowCameraData> shadowCameras;
+		std::shared_ptr<const MaterialTable> materialTable;
+
+		std::vector<FrameDraw> gBufferDraws;
+		std::vector<FrameDraw> shadowDraws;
+		std::vector<FrameDraw> transparencyDraws;
+		std::vector<uint32_t> rangeOffsets;
+		std::vector<uint32_t> rangeCounts;
+
+		std::shared_ptr<const GpuDrawableLayout> gpuLayout;
+		std::vector<UboDrawableData> gpuDrawablesData;
+		std::vector<SsboDrawableCullingData> gpuDrawablesCullingData;
+
+		scp::f32vec3 clearColor;
+		const spl::Texture* background;
+	};
+
+	// Sources of the modules and programs of the scenes with the same header on a context, compiled and linked the first
+	// time a frame of one of them needs them. The default shader sets are filled as their programs are linked, `prepare`
+	// requests those it lacks.
+
+	struct Scene::ShaderLibrary
+	{
+		struct Module
+		{
+			spl::ShaderStage::Stage stage;
+			std::vector<std::string_view> sources;
+			uint64_t hash;					// Of the stage and the sources, header included
+			spl::ShaderModule* module;		// `nullptr` until compiled
+			const uint32_t* spirv;			// Precompiled by the build, `nullptr` if not
+			uint32_t spirvSize;
+			bool fromSpirv;					// Whether `module` was specialized from `spirv`
+		};
+
+		struct Program
+		{
+			std::array<uint32_t, 3> modules;
+			uint32_t moduleCount;
+			uint32_t base;		// Program it is specialized from, itself if it is not
+		};
+
+		struct DefaultShaderSet
+		{
+			ShaderSet* shaderSet;
+			std::array<uint32_t, 3> programs;	// Per shader type
+		};
+
+		struct Request
+		{
+			const ShaderSet* shaderSet;
+			ShaderType shaderType;
+			bool required;		// A prepared frame draws with it, it cannot wait for a later frame
+		};
+
+		~ShaderLibrary()
+		{
+			for (spl::ShaderProgram* shader : shaders)
+			{
+				delete shader;
+			}
+
+			for (Module& module : modules)
+			{
+				delete module.module;
+			}
+		}
+
+		std::string header;
+		std::string spirvHeader;				// The header without the counts, which are specialization constants
+		std::array<uint32_t, 2> specializationConstants;
+		bool spirvEnabled;						// Cleared if the driver rejects a precompiled module
+		std::filesystem::path cacheDirectory;	// Of the scene that created the library
+		uint64_t driverHash;
+		std::vector<Module> modules;
+		std::vector<Program> programs;
+
+		std::vector<spl::ShaderProgram*> shaders;	// Per program, `nullptr` until linked
+		std::vector<uint8_t> linkFailed;			// Per program, its slot stays `nullptr` so that its users fall back
+		std::unordered_map<uint32_t, shaderInterface::InterfaceSsao> interfaceSsao;		// Per program
+		std::unordered_map<uint32_t, shaderInterface::InterfaceMerge> interfaceMerge;	// Per program
+		const spl::ShaderProgram* depthPyramidShader;
+		int32_t depthPyramidDepthLocation;
+		const spl::ShaderProgram* cullingShader;
+		int32_t cullingPhaseLocation;
+		int32_t cullingDepthPyramidLocation;	// Of the first texture, the array elements follow
+		std::unordered_map<DrawableType, std::vector<ShaderSet>> shaderMap;
+		std::vector<DefaultShaderSet> shaderSets;
+
+		// Programs specialized to a sample count or to light types, appended the first time a frame needs them
+
+		std::map<std::pair<uint32_t, std::string>, uint32_t> specializedModules;	// Per module and define, which the sources reference
+		std::map<std::pair<uint32_t, uint32_t>, uint32_t> specializedPrograms;	// Per program and key
+		std::map<std::pair<const ShaderSet*, uint32_t>, ShaderSet> specializedShaderSets;	// Per default set and light types
+
+		std::mutex mutex;		// Linking, and reading the default shader sets in `prepare`, which may run while `submit` links
+		std::vector<Request> requests;
+		std::vector<uint32_t> programRequests;		// Specialized screen programs, the frames use the generic ones until linked
+	};
+
 	Scene::Scene(uint32_t width, uint32_t height, const SceneParameters params) :
 		_screenVao(),
 		_screenVbo(),
@@ -67,14 +462,14 @@ namespace lys
 		_params(params),
 
 
-		_shaders(),
-		_shaderMap(),
+		_shaderLibrary(),
 
 
 		_clearColor(0.f, 0.f, 0.f),
 		_background(nullptr),
 
 		_camera(nullptr),
+		_uboCamera(sizeof(CameraBase::UboCameraData), spl::BufferStorageFlags::DynamicStorage),
 
 		_lights(),
 		_uboLights(),
@@ -82,6 +477,66 @@ namespace lys
 		_drawables(),
 		_uboDrawable(sizeof(UboDrawableData), spl::BufferStorageFlags::DynamicStorage),
 
+		_gBufferCommands(),
+		_occludedCommands(),
+		_shadowCommands(),
+		_transparencyCommands(),
+		_screenCommands(),
+		_occludedDraws(),
+		_stateCache(),
+
+		_packets(),
+		_packetMutex(),
+		_readyPacket(UINT32_MAX),
+		_submittedPacket(UINT32_MAX),
+
+		_frameArena(),
+		_drawablesChanged(true),
+		#ifdef LYSE_COUNT_ALLOCATIONS
+			_frameHash(0),
+			_steadyFrameCount(0),
+		#endif
+
+		_materialTable(),
+		_materialBufferTable(),
+		_materialsDirty(true),
+		_ssboMaterials(),
+		_materialTextureArrays(),
+		_materialTextureArrayLayers(),
+
+		_gpuDrawableLayout(),
+		_gpuBufferLayout(),
+		_gpuDrawableIndices(),
+		_gpuDrawablesDirty(true),
+		_ssboDrawables(),
+		_ssboDrawablesCulling(),
+		_ssboLods(),
+		_ssboMeshlets(),
+		_ssboCommands(),
+		_ssboCounts(),
+		_ssboVisibility(),
+		_uboCulling(),
+
+		_depthPyramidTextures(),
+		_depthPyramidFramebuffers(),
+		_depthPyramidReadback(),
+		_depthPyramidReadbacks(),
+		_depthPyramidReadbackIndex(0),
+		_depthPyramidReadbackLevel(0),
+		_depthPyramidCamera(),
+		_depthPyramidBuilt(false),
+		_depthPyramid(),
+
+		_bvh(),
+		_bvhLeaves(),
+		_unboundedDrawables(),
+		_bvhDirty(true),
+		_bvhRefit(false),
+		_bvhFramesSinceRebuild(0),
+		_registry(),
+
+		_occluders(),
+		_occlusionBuffer(),
 
 		_depthTexture(),
 		_colorTexture(),
@@ -104,6 +559,9 @@ namespace lys
 		_mergeTexture(),
 		_mergeFramebuffer()
 	{
+		_packets[0] = std::make_unique<FramePacket>();
+		_packets[1] = std::make_unique<FramePacket>();
+
 		// Create "screen" mesh
 
 		_screenVao.setAttributeFormat(0, spl::GlslType::FloatVec2, 0);
@@ -180,6 +638,13 @@ namespace lys
 
 		_uboLights.createNew(offsetof(UboLightsData, lights) + sizeof(UboLightData) * _params.lightSlotCount, spl::BufferStorageFlags::DynamicStorage);
 
+		// Check GPU-driven rendering parameters
+
+		if (_params.gpuDrivenEnabled)
+		{
+			_uboCulling.createNew(sizeof(UboCullingData), spl::BufferStorageFlags::DynamicStorage);
+		}
+
 		// Compile shaders and create framebuffers with those parameters
 
 		_loadShaders();
@@ -222,6 +687,63 @@ namespace lys
 
 		_mergeTexture.createNew(_resolution.x, _resolution.y, _params.renderTextureFormat);
 		_mergeFramebuffer.attachTexture(spl::FramebufferAttachment::ColorAttachment, 0, &_mergeTexture);
+
+		// The depth pyramid is built on the GPU down to the level read back, the coarser levels are built on the CPU. The
+		// GPU-driven culling samples the textures directly, they go down to 1x1 for it.
+
+		if (_params.occlusionCullingEnabled)
+		{
+			for (spl::Texture2D* texture : _depthPyramidTextures)
+			{
+				delete texture;
+			}
+			_depthPyramidTextures.clear();
+
+			for (spl::Framebuffer* framebuffer : _depthPyramidFramebuffers)
+			{
+				delete framebuffer;
+			}
+			_depthPyramidFramebuffers.clear();
+
+			scp::u32vec2 size = _resolution;
+			scp::u32vec2 readbackSize = _resolution;
+			_depthPyramidReadbackLevel = 0;
+			do
+			{
+				size = { std::max(size.x / 2, 1u), std::max(size.y / 2, 1u) };
+
+				spl::Texture2D* texture = new spl::Texture2D();
+				texture->createNew(size.x, size.y, spl::TextureInternalFormat::R_f32);
+				texture->setMinifyingFilter(spl::TextureFiltering::Nearest);
+				texture->setMagnifyingFilter(spl::TextureFiltering::Nearest);
+				_depthPyramidTextures.push_back(texture);
+
+				spl::Framebuffer* framebuffer = new spl::Framebuffer();
+				framebuffer->attachTexture(spl::FramebufferAttachment::ColorAttachment, 0, texture);
+				_depthPyramidFramebuffers.push_back(framebuffer);
+
+				if (_depthPyramidReadbackLevel == 0 && size.x <= _params.occlusionCullingResolution && size.y <= _params.occlusionCullingResolution)
+				{
+					_depthPyramidReadbackLevel = _depthPyramidTextures.size();
+					readbackSize = size;
+				}
+			}
+			while (_depthPyramidReadbackLevel == 0 || (_params.gpuDrivenEnabled && (size.x > 1 || size.y > 1)));
+
+			assert(!_params.gpuDrivenEnabled || _depthPyramidTextures.size() <= maxDepthPyramidTextureCount);
+
+			_depthPyramidReadback.resize(readbackSize.x * readbackSize.y);
+			_depthPyramid.invalidate();
+			_depthPyramidBuilt = false;
+
+			for (DepthPyramidReadback& readback : _depthPyramidReadbacks)
+			{
+				readback.buffer.createNew(sizeof(float) * readbackSize.x * readbackSize.y, spl::BufferStorageFlags::None);
+				readback.fence.destroy();
+				readback.pending = false;
+			}
+			_depthPyramidReadbackIndex = 0;
+		}
 	}
 
 	void Scene::setBackgroundFlatColor(float red, float green, float blue)
@@ -270,266 +792,522 @@ namespace lys
 	
 	void Scene::addDrawable(const Drawable* drawable)
 	{
+		assert(drawable->getParent() == nullptr);
+
 		switch (drawable->getType())
 		{
 			case DrawableType::Mesh:
-				assert(dynamic_cast<const Mesh<>*>(drawable));
+				assert(dynamic_cast<const MeshBase*>(drawable));
 				break;
 		}
 
 		_drawables.insert(drawable);
+		_gpuDrawablesDirty = true;
+		_bvhDirty = true;
 	}
 
 	void Scene::removeDrawable(const Drawable* drawable)
 	{
 		_drawables.erase(drawable);
+		_gpuDrawablesDirty = true;
+		_bvhDirty = true;
 	}
 
-	void Scene::render()
+	void Scene::queryFrustum(const Frustum& frustum, std::vector<const Drawable*>& drawables) const
 	{
-		// Save context context - `render` must not appear to modify context state from caller pov
+		std::vector<const Drawable*> roots;
+		_bvh.queryFrustum(frustum, roots);
 
-		spl::Context* context = spl::Context::getCurrentContext();
-		spl::ContextState savedContextState = context->getState();
+		_queryEntries(roots, [&](const scp::f32vec3& min, const scp::f32vec3& max) {
+			return frustum.intersectsBox(min, max);
+		}, drawables);
+	}
 
-		// Set context state for rendering
+	void Scene::querySphere(const scp::f32vec3& center, float radius, std::vector<const Drawable*>& drawables) const
+	{
+		std::vector<const Drawable*> roots;
+		_bvh.querySphere(center, radius, roots);
 
-		context->setIsSeamlessCubeMapFilteringEnabled(true);
-		context->setViewport(0, 0, _resolution.x, _resolution.y);
-		context->setClearColor(0.f, 0.f, 0.f, 0.f);
-		context->setClearDepth(1.0);
-		context->setClearStencil(0);
-		context->setIsDepthWriteEnabled(true);
-		context->setIsDepthTestEnabled(true);
-		context->setDepthTestFunc(spl::CompareFunc::Less);
-		context->setIsStencilTestEnabled(false);
-		context->setIsBlendEnabled(0, false);
-		context->setIsBlendEnabled(1, false);
-		context->setIsBlendEnabled(2, false);
-		context->setIsBlendEnabled(3, false);
+		_queryEntries(roots, [&](const scp::f32vec3& min, const scp::f32vec3& max) {
+			return Bvh::boxIntersectsSphere(min, max, center, radius);
+		}, drawables);
+	}
 
-		// Update and bind UBOs
-		
-		std::vector<const CameraBase*> shadowCameras;
+	void Scene::queryBox(const scp::f32vec3& min, const scp::f32vec3& max, std::vector<const Drawable*>& drawables) const
+	{
+		std::vector<const Drawable*> roots;
+		_bvh.queryBox(min, max, roots);
 
-		_camera->updateAndBindUbo(0);
-		_updateAndBindUboLights(1, shadowCameras);
-		// 2 :	DrawableData
-		_updateAndBindUboShadowCameras(3, shadowCameras);
-		
-		// Draw G-Buffer
-		
-		spl::Framebuffer::bind(spl::FramebufferTarget::DrawFramebuffer, &_gBufferFramebuffer);
-		spl::Framebuffer::clear(true, true, false);
-		
-		std::multimap<std::pair<const spl::ShaderProgram*, const shaderInterface::InterfaceGBuffer*>, const Drawable*> gBufferDrawSequence;
-		for (const Drawable* drawable : _drawables)
+		_queryEntries(roots, [&](const scp::f32vec3& leafMin, const scp::f32vec3& leafMax) {
+			return Bvh::boxIntersectsBox(leafMin, leafMax, min, max);
+		}, drawables);
+	}
+
+	void Scene::queryRay(const scp::f32vec3& origin, const scp::f32vec3& direction, float maxDistance, std::vector<const Drawable*>& drawables) const
+	{
+		std::vector<const Drawable*> roots;
+		_bvh.queryRay(origin, direction, maxDistance, roots);
+
+		const scp::f32vec3 invDirection = { 1.f / direction.x, 1.f / direction.y, 1.f / direction.z };
+		_queryEntries(roots, [&](const scp::f32vec3& min, const scp::f32vec3& max) {
+			float distance;
+			return Bvh::boxIntersectsRay(min, max, origin, invDirection, maxDistance, distance);
+		}, drawables);
+
+		// The leaves of the groups are not in the order of the roots. The bounds are those of the registry, the
+		// drawables may have moved, or been removed, since the last `prepare`.
+
+		std::vector<std::pair<float, const Drawable*>> hits(drawables.size());
+		for (uint32_t i = 0; i < drawables.size(); ++i)
 		{
-			_insertInDrawSequence(&gBufferDrawSequence, drawable, ShaderType::GBuffer);
+			const uint32_t entry = _registry.getIndex(_registry.getHandle(drawables[i]));
+			Bvh::boxIntersectsRay(_registry._boundingBoxMins[entry], _registry._boundingBoxMaxs[entry], origin, invDirection, maxDistance, hits[i].first);
+			hits[i].second = drawables[i];
 		}
-		
-		const spl::ShaderProgram* currentShader = nullptr;
-		for (const std::pair<std::pair<const spl::ShaderProgram*, const shaderInterface::InterfaceGBuffer*>, const Drawable*>& elt : gBufferDrawSequence)
+
+		std::sort(hits.begin(), hits.end(), [](const std::pair<float, const Drawable*>& a, const std::pair<float, const Drawable*>& b) {
+			return a.first < b.first;
+		});
+
+		for (uint32_t i = 0; i < hits.size(); ++i)
 		{
-			if (elt.first.first != currentShader)
-			{
-				currentShader = elt.first.first;
-				spl::ShaderProgram::bind(currentShader);
-			}
+			drawables[i] = hits[i].second;
+		}
+	}
 
-			context->setFaceCullingMode(elt.second->getGeometryFaceCullingMode());
-			context->setFaceCullingOrientation(elt.second->getGeometryFaceCullingOrientation());
-		
-			_updateAndBindUboDrawable(2, _camera, elt.second);
+	void Scene::prepare()
+	{
+		assert(_camera);
 
-			_setDrawableUniforms(elt.first.first, &elt.first.second->u_drawable, elt.second);
+		// Fill the packet that is not being submitted, a prepared frame that was not submitted yet is replaced
 
-			elt.second->_draw();
-		}
-		
-		// Draw shadow maps
-		
-		if (_params.shadowEnabled)
+		uint32_t packetIndex;
 		{
-			context->setViewport(0, 0, _params.shadowTextureResolution.x, _params.shadowTextureResolution.y);
-
-			spl::Framebuffer::bind(spl::FramebufferTarget::DrawFramebuffer, &_shadowMappingFramebuffer);
-			spl::Framebuffer::clear(false, true, false);
+			std::lock_guard lock(_packetMutex);
 
-			std::multimap<std::pair<const spl::ShaderProgram*, const shaderInterface::InterfaceShadow*>, const Drawable*> shadowMappingDrawSequence;
-			for (const Drawable* drawable : _drawables)
+			if (_submittedPacket != UINT32_MAX)
+			{
+				packetIndex = 1 - _submittedPacket;
+			}
+			else
 			{
-				_insertInDrawSequence(&shadowMappingDrawSequence, drawable, ShaderType::ShadowMapping);
+				packetIndex = (_readyPacket == 0) ? 1 : 0;
 			}
 
-			const spl::ShaderProgram* currentShader = nullptr;
-			for (const std::pair<std::pair<const spl::ShaderProgram*, const shaderInterface::InterfaceShadow*>, const Drawable*>& elt : shadowMappingDrawSequence)
+			if (_readyPacket == packetIndex)
 			{
-				if (elt.first.first != currentShader)
-				{
-					currentShader = elt.first.first;
-					spl::ShaderProgram::bind(currentShader);
+				_readyPacket = UINT32_MAX;
+			}
+		}
 
-					_setGBufferResultUniforms(elt.first.first, &elt.first.second->u_gBuffer);
-				}
+		FramePacket& packet = *_packets[packetIndex];
 
-				context->setFaceCullingMode(elt.second->getShadowFaceCullingMode());
-				context->setFaceCullingOrientation(elt.second->getShadowFaceCullingOrientation());
+		_frameArena.reset();
 
-				_updateAndBindUboDrawable(2, _camera, elt.second);
+		_camera->_updateUboCameraData();
+		packet.camera = _camera->_uboCameraData;
+		packet.frustum.emplace(_camera);
+		packet.clearColor = _clearColor;
+		packet.background = _background;
 
-				_setDrawableUniforms(elt.first.first, &elt.first.second->u_drawable, elt.second);
+		FrameVector<const CameraBase*> shadowCameras(_frameArena);
+		shadowCameras.reserve(_params.shadowTextureCount);
+		_prepareLights(packet, shadowCameras);
 
-				elt.second->_draw();
-			}
+		// Update the hierarchies, the BVH and the registry, and gather the drawables that may be seen by the camera
 
-			context->setViewport(0, 0, _resolution.x, _resolution.y);
-		}
+		_updateDrawables();
 
-		// Draw transparent objects
+		FrameVector<uint32_t> drawables(_frameArena);
+		drawables.reserve(_registry.getSize());
+		_collectDrawables(*packet.frustum, drawables);
 
-		context->setIsDepthWriteEnabled(false);
+		// Rasterize the occluders on the CPU, the drawables they hide are not inserted in the draw sequences
 
-		if (_params.transparencyEnabled)
+		if (_params.softwareOcclusionCullingEnabled)
 		{
-			context->setIsBlendEnabled(0, true);
-			context->setBlendEquations(0, spl::BlendEquation::Add, spl::BlendEquation::Add);
-			context->setBlendFuncs(0, spl::BlendFunc::One, spl::BlendFunc::One, spl::BlendFunc::One, spl::BlendFunc::One);
+			_rasterizeOccluders(drawables);
+		}
 
-			context->setIsBlendEnabled(1, true);
-			context->setBlendEquations(1, spl::BlendEquation::Add, spl::BlendEquation::Add);
-			context->setBlendFuncs(1, spl::BlendFunc::One, spl::BlendFunc::One, spl::BlendFunc::One, spl::BlendFunc::One);
+		// Register the GPU-driven meshes before the shader sets are chosen, they depend on it
 
-			spl::Framebuffer::bind(spl::FramebufferTarget::DrawFramebuffer, &_transparencyFramebuffer);
-			spl::Framebuffer::clear(true, false, false);
+		if (_params.gpuDrivenEnabled)
+		{
+			_prepareGpuDrawables(packet);
+		}
 
-			std::multimap<std::pair<const spl::ShaderProgram*, const shaderInterface::InterfaceTransparency*>, const Drawable*> transparencyDrawSequence;
-			for (const Drawable* drawable : _drawables)
-			{
-				_insertInDrawSequence(&transparencyDrawSequence, drawable, ShaderType::Transparency);
-			}
+		packet.rangeOffsets.clear();
+		packet.rangeCounts.clear();
 
-			const spl::ShaderProgram* currentShader = nullptr;
-			for (const std::pair<std::pair<const spl::ShaderProgram*, const shaderInterface::InterfaceTransparency*>, const Drawable*>& elt : transparencyDrawSequence)
-			{
-				if (elt.first.first != currentShader)
-				{
-					currentShader = elt.first.first;
-					spl::ShaderProgram::bind(currentShader);
+		FrameVector<std::pair<const ShaderSet*, uint32_t>> drawSequence(_frameArena);
+		drawSequence.reserve(_registry.getSize());
 
-					_setGBufferResultUniforms(elt.first.first, &elt.first.second->u_gBuffer);
-					_setShadowResultUniforms(elt.first.first, &elt.first.second->u_shadow);
-				}
+		_buildDrawSequence(drawables, ShaderType::GBuffer, packet.lightTypes, drawSequence);
+		_prepareDraws(packet, drawSequence, ShaderType::GBuffer, nullptr, packet.gBufferDraws);
 
-				context->setFaceCullingMode(elt.second->getGeometryFaceCullingMode());
-				context->setFaceCullingOrientation(elt.second->getGeometryFaceCullingOrientation());
+		// Shadow casters are the drawables in the frustum of at least one shadow camera. A caster is drawn in all the
+		// shadow maps at once, with the finest LOD of the shadow cameras that see it.
 
-				_updateAndBindUboDrawable(2, _camera, elt.second);
+		packet.shadowDraws.clear();
+		if (_params.shadowEnabled)
+		{
+			FrameVector<uint32_t> shadowDrawables(_frameArena);
+			FrameVector<uint32_t> shadowCameraDrawables(_frameArena);
+			FrameVector<uint32_t> shadowLods(_registry.getSize(), UINT32_MAX, _frameArena);
+
+			shadowDrawables.reserve(_registry.getSize());
+			shadowCameraDrawables.reserve(_registry.getSize());
+			for (const CameraBase* shadowCamera : shadowCameras)
+			{
+				_collectDrawables(Frustum(shadowCamera), shadowCameraDrawables);
 
-				_setDrawableUniforms(elt.first.first, &elt.first.second->u_drawable, elt.second);
+				for (const uint32_t entry : shadowCameraDrawables)
+				{
+					if (shadowLods[entry] == UINT32_MAX)
+					{
+						shadowDrawables.push_back(entry);
+					}
 
-				elt.second->_draw();
+					const uint32_t lod = _selectLod(entry, shadowCamera, _params.shadowTextureResolution.y, _params.shadowLodBias);
+					shadowLods[entry] = std::min(shadowLods[entry], lod);
+				}
 			}
 
-			context->setIsBlendEnabled(0, false);
-			context->setIsBlendEnabled(1, false);
+			_buildDrawSequence(shadowDrawables, ShaderType::ShadowMapping, packet.lightTypes, drawSequence);
+			_prepareDraws(packet, drawSequence, ShaderType::ShadowMapping, shadowLods.data(), packet.shadowDraws);
 		}
-		
-		// Compute SSAO
 
-		context->setFaceCullingMode(spl::FaceCullingMode::Disabled);
-		context->setIsDepthTestEnabled(false);
-		
-		if (_params.ssaoEnabled)
+		packet.transparencyDraws.clear();
+		if (_params.transparencyEnabled)
 		{
-			spl::Framebuffer::bind(spl::FramebufferTarget::DrawFramebuffer, &_ssaoFramebuffer);
-
-			const spl::ShaderProgram* ssaoShader = _shaders[0];
-
-			spl::ShaderProgram::bind(ssaoShader);
+			_buildDrawSequence(drawables, ShaderType::Transparency, packet.lightTypes, drawSequence);
+			_prepareDraws(packet, drawSequence, ShaderType::Transparency, nullptr, packet.transparencyDraws);
+		}
 
-			static constexpr shaderInterface::SubInterfaceGBufferResult ssaoGBufferResultInterface = {
-				.depth = spl::GlslType::Sampler2d,
-				.normal = spl::GlslType::Sampler2d,
-				.tangent = spl::GlslType::Sampler2d
-			};
-			_setGBufferResultUniforms(ssaoShader, &ssaoGBufferResultInterface);
+		// Materials are copied in a table shared by the frames until one of them is edited
 
-			static constexpr shaderInterface::SubInterfaceShadowResult ssaoShadowResultInterface = {};
-			_setShadowResultUniforms(ssaoShader, &ssaoShadowResultInterface);
+		if (_materialsDirty)
+		{
+			_buildMaterialTable();
+		}
 
-			static constexpr shaderInterface::SubInterfaceTransparencyResult ssaoTransparencyResultInterface = {};
-			_setTransparencyResultUniforms(ssaoShader, &ssaoTransparencyResultInterface);
+		packet.materialTable = _materialTable;
 
-			ssaoShader->setUniform("u_sampleCount", _params.ssaoSampleCount);
+		#ifdef LYSE_COUNT_ALLOCATIONS
+		{
+			// A frame that sees the same thing as the previous ones fits in the containers they already grew
 
-			ssaoShader->setUniform("u_scaleStep", 1.f / (_params.ssaoSampleCount * _params.ssaoSampleCount));
-			ssaoShader->setUniform("u_tanHalfFov", std::tan(_camera->getFieldOfView() * 0.5f));
-			ssaoShader->setUniform("u_twoTanHalfFov", 2.f * std::tan(_camera->getFieldOfView() * 0.5f));
-			ssaoShader->setUniform("u_resolution", _resolution);
+			uint64_t hash = hashBytes(fnvOffsetBasis, &packet.camera, sizeof(packet.camera));
+			hash = hashBytes(hash, packet.lights.data(), packet.lights.size() * sizeof(UboLightData));
+			hash = hashBytes(hash, packet.shadowCameras.data(), packet.shadowCameras.size() * sizeof(UboShadowCameraData));
 
-			_screenVao.drawArrays(spl::PrimitiveType::TriangleStrips, 0, 4);
+			_steadyFrameCount = (!_drawablesChanged && hash == _frameHash) ? _steadyFrameCount + 1 : 0;
+			_frameHash = hash;
 		}
-		
-		// Merge into final picture
+		#endif
 
-		spl::Framebuffer::bind(spl::FramebufferTarget::DrawFramebuffer, &_mergeFramebuffer);
+		std::lock_guard lock(_packetMutex);
+		_readyPacket = packetIndex;
+	}
+
+	void Scene::submit()
+	{
+		uint32_t packetIndex;
+		{
+			std::lock_guard lock(_packetMutex);
+
+			// Nothing new to draw, the render texture keeps the last frame
+
+			if (_readyPacket == UINT32_MAX)
+			{
+				return;
+			}
+
+			packetIndex = _readyPacket;
+			_readyPacket = UINT32_MAX;
+			_submittedPacket = packetIndex;
+		}
+
+		const FramePacket& packet = *_packets[packetIndex];
+
+		// Save context state - `submit` must not appear to modify context state from caller pov, unless it opted out
+
+		spl::Context* context = spl::Context::getCurrentContext();
+
+		std::optional<spl::ContextState> savedContextState;
+		if (_params.contextStateRestored)
+		{
+			savedContextState = context->getState();
+		}
+
+		// Shaders first needed by the frame, before the draws are recorded with them
+
+		_linkRequestedShaders();
+
+		// The caller may have changed the context since the last frame
+
+		_stateCache.invalidate();
+
+		// Set context state for rendering
+
+		context->setIsSeamlessCubeMapFilteringEnabled(true);
+		context->setViewport(0, 0, _resolution.x, _resolution.y);
+		context->setClearColor(0.f, 0.f, 0.f, 0.f);
+		context->setClearDepth(1.0);
+		context->setClearStencil(0);
+		context->setDepthTestFunc(spl::CompareFunc::Less);
+		context->setIsStencilTestEnabled(false);
+		_stateCache.setIsDepthWriteEnabled(true);
+		_stateCache.setIsDepthTestEnabled(true);
+		_stateCache.setIsBlendEnabled(0, false);
+		_stateCache.setIsBlendEnabled(1, false);
+		_stateCache.setIsBlendEnabled(2, false);
+		_stateCache.setIsBlendEnabled(3, false);
+
+		// Update and bind UBOs
+
+		_updateAndBindUbos(packet);
+		_uploadMaterials(packet);
+
+		// Depth pyramids whose readback completed since the last frame, the first phase of occlusion culling uses the latest
+
+		if (_params.occlusionCullingEnabled)
+		{
+			_readDepthPyramid();
+		}
+
+		// The shadow pass does not depend on the depth pyramid, it is recorded by the workers while the G-Buffer is drawn
+
+		JobSystem& jobSystem = JobSystem::getGlobal();
 
-		const uint32_t mergeShaderIndex = _background ? (_background->getCreationParams().target == spl::TextureTarget::CubeMap ? 3 : 2) : 1;
-		const spl::ShaderProgram* mergeShader = _shaders[mergeShaderIndex];
+		JobCounter shadowCounter;
+		if (_params.shadowEnabled)
+		{
+			jobSystem.run([&]() { _recordDraws(packet, packet.shadowDraws, ShaderType::ShadowMapping, _shadowCommands, [](uint32_t) { return true; }); }, &shadowCounter);
+		}
+
+		// Cull the GPU-driven meshes and generate their draw commands
+
+		if (_params.gpuDrivenEnabled)
+		{
+			_uploadGpuDrawables(packet);
+			_dispatchCulling(0, packet);
+		}
 		
-		spl::ShaderProgram::bind(mergeShader);
+		// Draw G-Buffer, except the drawables occluded in the depth pyramid of the previous frame. GPU-driven meshes are
+		// culled by the compute shader, they are all drawn again after the second culling phase.
 
-		static constexpr shaderInterface::SubInterfaceGBufferResult mergeGBufferResultInterface = {
-			.depth = spl::GlslType::Sampler2d,
-			.color = spl::GlslType::Sampler2d,
-			.material = spl::GlslType::Sampler2d,
-			.normal = spl::GlslType::Sampler2d
-		};
-		_setGBufferResultUniforms(mergeShader, &mergeGBufferResultInterface);
+		_occludedDraws.assign(packet.gBufferDraws.size(), false);
+
+		_recordDraws(packet, packet.gBufferDraws, ShaderType::GBuffer, _gBufferCommands, [&](uint32_t i) {
+			const bool gpuDriven = packet.gBufferDraws[i].gpuIndex != UINT32_MAX;
+			_occludedDraws[i] = gpuDriven ? _params.occlusionCullingEnabled : _isOccluded(packet.gBufferDraws[i]);
+			return gpuDriven || !_occludedDraws[i];
+		});
 		
-		if (_params.shadowEnabled)
+		spl::Framebuffer::bind(spl::FramebufferTarget::DrawFramebuffer, &_gBufferFramebuffer);
+		spl::Framebuffer::clear(true, true, false);
+
+		CommandBuffer::execute(_gBufferCommands.data(), _gBufferCommands.size(), _stateCache);
+
+		// Build the depth pyramid of this frame. It is copied into a buffer without waiting for the GPU, the CPU tests
+		// use it once the copy is done, usually by the next frame.
+
+		if (_params.occlusionCullingEnabled)
 		{
-			static constexpr shaderInterface::SubInterfaceShadowResult mergeShadowResultInterface = {
-				.texture = spl::GlslType::Sampler2dArrayShadow,
-				.offset = spl::GlslType::FloatVec3
-			};
-			_setShadowResultUniforms(mergeShader, &mergeShadowResultInterface);
+			_buildDepthPyramid(context);
+			_requestDepthPyramidReadback(packet);
+
+			_depthPyramidCamera = packet.camera;
+			_depthPyramidBuilt = true;
 		}
 		
+		// Draw shadow maps
+		
+		if (_params.shadowEnabled)
+		{
+			context->setViewport(0, 0, _params.shadowTextureResolution.x, _params.shadowTextureResolution.y);
+
+			spl::Framebuffer::bind(spl::FramebufferTarget::DrawFramebuffer, &_shadowMappingFramebuffer);
+			spl::Framebuffer::clear(false, true, false);
+
+			jobSystem.wait(shadowCounter);
+			CommandBuffer::execute(_shadowCommands.data(), _shadowCommands.size(), _stateCache);
+
+			context->setViewport(0, 0, _resolution.x, _resolution.y);
+		}
+
+		// Test the drawables occluded in the first phase again, against the latest pyramid read back by then
+
+		if (_params.occlusionCullingEnabled)
+		{
+			_readDepthPyramid();
+
+			if (_params.gpuDrivenEnabled)
+			{
+				_dispatchCulling(1, packet);
+			}
+
+			_recordDraws(packet, packet.gBufferDraws, ShaderType::GBuffer, _occludedCommands, [&](uint32_t i) {
+				return _occludedDraws[i] && (packet.gBufferDraws[i].gpuIndex != UINT32_MAX || !_isOccluded(packet.gBufferDraws[i]));
+			});
+
+			spl::Framebuffer::bind(spl::FramebufferTarget::DrawFramebuffer, &_gBufferFramebuffer);
+
+			CommandBuffer::execute(_occludedCommands.data(), _occludedCommands.size(), _stateCache);
+		}
+
+		// Draw transparent objects
+
+		_stateCache.setIsDepthWriteEnabled(false);
+
 		if (_params.transparencyEnabled)
 		{
-			static constexpr shaderInterface::SubInterfaceTransparencyResult mergeTransparencyResultInterface = {
-				.color = spl::GlslType::Sampler2d,
-				.counter = spl::GlslType::Sampler2d
-			};
-			_setTransparencyResultUniforms(mergeShader, &mergeTransparencyResultInterface);
+			_stateCache.setIsBlendEnabled(0, true);
+			context->setBlendEquations(0, spl::BlendEquation::Add, spl::BlendEquation::Add);
+			context->setBlendFuncs(0, spl::BlendFunc::One, spl::BlendFunc::One, spl::BlendFunc::One, spl::BlendFunc::One);
+
+			_stateCache.setIsBlendEnabled(1, true);
+			context->setBlendEquations(1, spl::BlendEquation::Add, spl::BlendEquation::Add);
+			context->setBlendFuncs(1, spl::BlendFunc::One, spl::BlendFunc::One, spl::BlendFunc::One, spl::BlendFunc::One);
+
+			_recordDraws(packet, packet.transparencyDraws, ShaderType::Transparency, _transparencyCommands, [&](uint32_t i) {
+				return !_isOccluded(packet.transparencyDraws[i]);
+			});
+
+			spl::Framebuffer::bind(spl::FramebufferTarget::DrawFramebuffer, &_transparencyFramebuffer);
+			spl::Framebuffer::clear(true, false, false);
+
+			CommandBuffer::execute(_transparencyCommands.data(), _transparencyCommands.size(), _stateCache);
+
+			_stateCache.setIsBlendEnabled(0, false);
+			_stateCache.setIsBlendEnabled(1, false);
 		}
+		
+		// Compute SSAO
 
+		_stateCache.setFaceCullingMode(spl::FaceCullingMode::Disabled);
+		_stateCache.setIsDepthTestEnabled(false);
+		
 		if (_params.ssaoEnabled)
 		{
-			static constexpr shaderInterface::SubInterfaceSsaoResult mergeSsaoResultInterface = {
-				.texture = spl::GlslType::Sampler2d
-			};
-			_setSsaoResultUniforms(mergeShader, &mergeSsaoResultInterface);
+			spl::Framebuffer::bind(spl::FramebufferTarget::DrawFramebuffer, &_ssaoFramebuffer);
+
+			// Specialized to the sample count, other scenes may be appending programs to the library meanwhile
+
+			const spl::ShaderProgram* ssaoShader;
+			const shaderInterface::InterfaceSsao* pSsaoInterface;
+			{
+				std::lock_guard lock(_shaderLibrary->mutex);
+
+				uint32_t ssaoShaderIndex = _specializeShader(0, _params.ssaoSampleCount);
+				if (!_shaderLibrary->shaders[ssaoShaderIndex])
+				{
+					ssaoShaderIndex = 0;
+				}
+
+				ssaoShader = _shaderLibrary->shaders[ssaoShaderIndex];
+				pSsaoInterface = &_shaderLibrary->interfaceSsao[ssaoShaderIndex];
+			}
+
+			const shaderInterface::InterfaceSsao& ssaoInterface = *pSsaoInterface;
+
+			_screenCommands.clear();
+			_screenCommands.bindShader(ssaoShader);
+
+			_setGBufferResultUniforms(_screenCommands, &ssaoInterface.u_gBuffer);
+
+			_screenCommands.setUniform(ssaoInterface.u_sampleCount.location, _params.ssaoSampleCount);
+
+			_screenCommands.setUniform(ssaoInterface.u_scaleStep.location, 1.f / (_params.ssaoSampleCount * _params.ssaoSampleCount));
+			_screenCommands.setUniform(ssaoInterface.u_tanHalfFov.location, std::tan(packet.camera.fov * 0.5f));
+			_screenCommands.setUniform(ssaoInterface.u_twoTanHalfFov.location, 2.f * std::tan(packet.camera.fov * 0.5f));
+			_screenCommands.setUniform(ssaoInterface.u_resolution.location, _resolution);
+
+			_screenCommands.drawArrays(&_screenVao, spl::PrimitiveType::TriangleStrips, 0, 4);
+			_screenCommands.execute(_stateCache);
+		}
+		
+		// Merge into final picture
+
+		spl::Framebuffer::bind(spl::FramebufferTarget::DrawFramebuffer, &_mergeFramebuffer);
+
+		// Specialized to the light types of the frame. A specialization not linked yet is requested, the frame merges with
+		// the generic program of its background in the meantime.
+
+		const spl::ShaderProgram* mergeShader;
+		const shaderInterface::InterfaceMerge* pMergeInterface;
+		{
+			std::lock_guard lock(_shaderLibrary->mutex);
+
+			const uint32_t genericMergeShaderIndex = packet.background ? (packet.background->getCreationParams().target == spl::TextureTarget::CubeMap ? 3 : 2) : 1;
+			uint32_t mergeShaderIndex = _specializeShader(genericMergeShaderIndex, packet.lightTypes);
+			if (!_shaderLibrary->shaders[mergeShaderIndex])
+			{
+				std::vector<uint32_t>& programRequests = _shaderLibrary->programRequests;
+				if (!_shaderLibrary->linkFailed[mergeShaderIndex] && std::find(programRequests.begin(), programRequests.end(), mergeShaderIndex) == programRequests.end())
+				{
+					programRequests.push_back(mergeShaderIndex);
+				}
+
+				mergeShaderIndex = genericMergeShaderIndex;
+			}
+
+			mergeShader = _shaderLibrary->shaders[mergeShaderIndex];
+			pMergeInterface = &_shaderLibrary->interfaceMerge[mergeShaderIndex];
 		}
+
+		const shaderInterface::InterfaceMerge& mergeInterface = *pMergeInterface;
+
+		_screenCommands.clear();
+		_screenCommands.bindShader(mergeShader);
+
+		// The results of the disabled passes are not in the interface, the shader was compiled without them
+
+		_setGBufferResultUniforms(_screenCommands, &mergeInterface.u_gBuffer);
+		_setShadowResultUniforms(_screenCommands, &mergeInterface.u_shadow);
+		_setTransparencyResultUniforms(_screenCommands, &mergeInterface.u_transparency);
+		_setSsaoResultUniforms(_screenCommands, &mergeInterface.u_ssao);
 		
-		if (_background)
+		if (packet.background)
 		{
-			mergeShader->setUniform("u_background", 12, _background);
+			_screenCommands.setUniform(mergeInterface.u_background.location, mergeInterface.u_background.unit, packet.background);
 		}
 		else
 		{
-			mergeShader->setUniform("u_background", _clearColor);
+			_screenCommands.setUniform(mergeInterface.u_background.location, packet.clearColor);
 		}
 		
-		mergeShader->setUniform("u_twoTanHalfFov", 2.f * std::tan(_camera->getFieldOfView() * 0.5f));
+		_screenCommands.setUniform(mergeInterface.u_twoTanHalfFov.location, 2.f * std::tan(packet.camera.fov * 0.5f));
 		
-		_screenVao.drawArrays(spl::PrimitiveType::TriangleStrips, 0, 4);
+		_screenCommands.drawArrays(&_screenVao, spl::PrimitiveType::TriangleStrips, 0, 4);
+		_screenCommands.execute(_stateCache);
 		
 		// Restore OpenGL context
 
-		context->setState(savedContextState);
+		if (savedContextState)
+		{
+			context->setState(*savedContextState);
+		}
+
+		std::lock_guard lock(_packetMutex);
+		_submittedPacket = UINT32_MAX;
+	}
+
+	void Scene::render()
+	{
+		#ifdef LYSE_COUNT_ALLOCATIONS
+			const uint64_t allocationCount = getHeapAllocationCount();
+		#endif
+
+		prepare();
+		submit();
+
+		// The count is process-wide, the application must not allocate from other threads in the meantime
+
+		#ifdef LYSE_COUNT_ALLOCATIONS
+			assert(_steadyFrameCount < steadyFrameCount || getHeapAllocationCount() == allocationCount);
+		#endif
 	}
 
 	const spl::Texture2D& Scene::getDepthTexture() const
@@ -584,45 +1362,129 @@ namespace lys
 
 	Scene::~Scene()
 	{
-		for (spl::ShaderProgram* shader : _shaders)
+		for (spl::Texture2D* texture : _depthPyramidTextures)
 		{
-			delete shader;
+			delete texture;
+		}
+
+		for (spl::Framebuffer* framebuffer : _depthPyramidFramebuffers)
+		{
+			delete framebuffer;
+		}
+
+		for (spl::Texture* texture : _materialTextureArrays)
+		{
+			delete texture;
 		}
 	}
 
 	void Scene::_loadShaders()
 	{
-		std::string headerString = std::format(
+		std::string features;
+
+		if (_params.shadowEnabled)
+		{
+			features += "#define SHADOW\n";
+		}
+
+		if (_params.transparencyEnabled)
+		{
+			features += "#define TRANSPARENCY\n";
+		}
+
+		if (_params.ssaoEnabled)
+		{
+			features += "#define SSAO\n";
+		}
+
+		if (_params.materialTextureArraysEnabled)
+		{
+			features += "#define TEXTURE_ARRAYS\n";
+		}
+
+		std::string header = std::format(
 			"#version 460 core\n"
 			"#define LIGHT_SLOT_COUNT {}\n"
-			"#define SHADOW_TEXTURE_COUNT {}\n",
+			"#define SHADOW_TEXTURE_COUNT {}\n"
+			"{}",
 
 			_params.lightSlotCount,
-			_params.shadowTextureCount
+			_params.shadowTextureCount,
+			features
 		);
 
-		if (_params.shadowEnabled)
+		// Scenes with the same header on the same context share their shaders, the last one destroys them. The library
+		// caches its binaries in the directory of the scene that built it, scenes with another directory have their own.
+
 		{
-			headerString += "#define SHADOW\n";
+			static std::mutex librariesMutex;
+			static std::map<std::tuple<const spl::Context*, std::string, std::filesystem::path>, std::weak_ptr<ShaderLibrary>> libraries;
+
+			std::lock_guard lock(librariesMutex);
+
+			std::erase_if(libraries, [](const auto& library) { return library.second.expired(); });
+
+			std::weak_ptr<ShaderLibrary>& library = libraries[{ spl::Context::getCurrentContext(), header, _params.shaderCacheDirectory }];
+			_shaderLibrary = library.lock();
+			if (!_shaderLibrary)
+			{
+				_shaderLibrary = std::make_shared<ShaderLibrary>();
+				_shaderLibrary->header = std::move(header);
+				_shaderLibrary->spirvHeader = "#version 460 core\n" + features;
+				_buildShaderLibrary(*_shaderLibrary);
+				library = _shaderLibrary;
+			}
 		}
 
-		if (_params.transparencyEnabled)
+		// Screen passes of the enabled features. The generic merges are the fallbacks of their specializations, the
+		// frames never wait for a link.
+
+		std::lock_guard lock(_shaderLibrary->mutex);
+
+		for (uint32_t i = 1; i <= 3; ++i)
 		{
-			headerString += "#define TRANSPARENCY\n";
+			_linkShader(i);
+			assert(_shaderLibrary->shaders[i]);
 		}
 
 		if (_params.ssaoEnabled)
 		{
-			headerString += "#define SSAO\n";
+			const uint32_t ssaoShaderIndex = _specializeShader(0, _params.ssaoSampleCount);
+			_linkShader(ssaoShaderIndex);
+
+			// The generic SSAO reads the sample count from a uniform, slower but drawn if the specialization is broken
+
+			if (!_shaderLibrary->shaders[ssaoShaderIndex])
+			{
+				_linkShader(0);
+				assert(_shaderLibrary->shaders[0]);
+			}
+		}
+
+		if (_params.occlusionCullingEnabled)
+		{
+			_linkShader(4);
+			assert(_shaderLibrary->shaders[4]);
 		}
 
-		const std::string_view header =					{ headerString.data(), headerString.size() };
+		if (_params.gpuDrivenEnabled)
+		{
+			_linkShader(5);
+			assert(_shaderLibrary->shaders[5]);
+		}
+	}
+
+	void Scene::_buildShaderLibrary(ShaderLibrary& library) const
+	{
+		const std::string_view header =					{ library.header.data(), library.header.size() };
 		const std::string_view background =				"#define BACKGROUND_TEXTURE\n";
 		const std::string_view backgroundProjection =	"#define BACKGROUND_PROJECTION\n";
 		const std::string_view backgroundCubemap =		"#define BACKGROUND_CUBEMAP\n";
 		const std::string_view colorMap =				"#define COLOR_TEXTURE\n";
 		const std::string_view materialMap =			"#define MATERIAL_TEXTURE\n";
 		const std::string_view normalMap =				"#define NORMAL_TEXTURE\n";
+		const std::string_view compactVertex =			"#define COMPACT_VERTEX\n";
+		const std::string_view gpuDriven =				"#define GPU_DRIVEN\n";
 
 
 		const std::pair<spl::ShaderStage::Stage, std::vector<std::string_view>> sources[] = {
@@ -635,423 +1497,2017 @@ namespace lys
 			/* 03 */{ spl::ShaderStage::Fragment,	{ header, common_glsl, lightingHeader_glsl,   									merge_frag, lighting_glsl } },
 			/* 04 */{ spl::ShaderStage::Fragment,	{ header, common_glsl, lightingHeader_glsl, background,	backgroundProjection,	merge_frag, lighting_glsl } },
 			/* 05 */{ spl::ShaderStage::Fragment,	{ header, common_glsl, lightingHeader_glsl, background,	backgroundCubemap,		merge_frag, lighting_glsl } },
+			/* 06 */{ spl::ShaderStage::Fragment,	{ header, common_glsl,  														depthPyramid_frag } },
+			/* 07 */{ spl::ShaderStage::Compute,	{ header, common_glsl,  														culling_comp } },
 
 			// Drawable dependent - Mesh
 
-			/* 06 */{ spl::ShaderStage::Vertex,		{ header, common_glsl,						 										mesh_gBuffer_vert } },
-			/* 07 */{ spl::ShaderStage::Fragment,	{ header, common_glsl,						 										mesh_gBuffer_frag } },
-			/* 08 */{ spl::ShaderStage::Fragment,	{ header, common_glsl,						colorMap,								mesh_gBuffer_frag } },
-			/* 09 */{ spl::ShaderStage::Fragment,	{ header, common_glsl,						 			materialMap,				mesh_gBuffer_frag } },
-			/* 10 */{ spl::ShaderStage::Fragment,	{ header, common_glsl,						colorMap,	materialMap,				mesh_gBuffer_frag } },
-			/* 11 */{ spl::ShaderStage::Fragment,	{ header, common_glsl,						 							normalMap,	mesh_gBuffer_frag } },
-			/* 12 */{ spl::ShaderStage::Fragment,	{ header, common_glsl,						colorMap,					normalMap,	mesh_gBuffer_frag } },
-			/* 13 */{ spl::ShaderStage::Fragment,	{ header, common_glsl,						 			materialMap,	normalMap,	mesh_gBuffer_frag } },
-			/* 14 */{ spl::ShaderStage::Fragment,	{ header, common_glsl,						colorMap,	materialMap,	normalMap,	mesh_gBuffer_frag } },
-			/* 15 */{ spl::ShaderStage::Vertex,		{ header, common_glsl,						 										mesh_shadowMapping_vert } },
-			/* 16 */{ spl::ShaderStage::Geometry,	{ header, common_glsl,						 										mesh_shadowMapping_geom } },
-			/* 17 */{ spl::ShaderStage::Fragment,	{ header, common_glsl,																mesh_shadowMapping_frag } },
-			/* 18 */{ spl::ShaderStage::Fragment,	{ header, common_glsl,						colorMap,								mesh_shadowMapping_frag } },
-			/* 19 */{ spl::ShaderStage::Vertex,		{ header, common_glsl,  															mesh_transparency_vert } },
-			/* 20 */{ spl::ShaderStage::Fragment,	{ header, common_glsl, lightingHeader_glsl,  										mesh_transparency_frag, lighting_glsl } },
-			/* 21 */{ spl::ShaderStage::Fragment,	{ header, common_glsl, lightingHeader_glsl, colorMap,								mesh_transparency_frag, lighting_glsl } },
-			/* 22 */{ spl::ShaderStage::Fragment,	{ header, common_glsl, lightingHeader_glsl,  			materialMap,				mesh_transparency_frag, lighting_glsl } },
-			/* 23 */{ spl::ShaderStage::Fragment,	{ header, common_glsl, lightingHeader_glsl, colorMap,	materialMap,				mesh_transparency_frag, lighting_glsl } },
-			/* 24 */{ spl::ShaderStage::Fragment,	{ header, common_glsl, lightingHeader_glsl,  							normalMap,	mesh_transparency_frag, lighting_glsl } },
-			/* 25 */{ spl::ShaderStage::Fragment,	{ header, common_glsl, lightingHeader_glsl, colorMap,					normalMap,	mesh_transparency_frag, lighting_glsl } },
-			/* 26 */{ spl::ShaderStage::Fragment,	{ header, common_glsl, lightingHeader_glsl,  			materialMap,	normalMap,	mesh_transparency_frag, lighting_glsl } },
-			/* 27 */{ spl::ShaderStage::Fragment,	{ header, common_glsl, lightingHeader_glsl, colorMap,	materialMap,	normalMap,	mesh_transparency_frag, lighting_glsl } },
+			/* 08 */{ spl::ShaderStage::Vertex,		{ header, common_glsl,						 										mesh_gBuffer_vert } },
+			/* 09 */{ spl::ShaderStage::Vertex,		{ header, common_glsl, compactVertex,			 										mesh_gBuffer_vert } },
+			/* 10 */{ spl::ShaderStage::Vertex,		{ header, common_glsl,				gpuDriven,		 								mesh_gBuffer_vert } },
+			/* 11 */{ spl::ShaderStage::Vertex,		{ header, common_glsl, compactVertex,	gpuDriven,		 								mesh_gBuffer_vert } },
+			/* 12 */{ spl::ShaderStage::Fragment,	{ header, common_glsl,						 										mesh_gBuffer_frag } },
+			/* 13 */{ spl::ShaderStage::Fragment,	{ header, common_glsl,						colorMap,								mesh_gBuffer_frag } },
+			/* 14 */{ spl::ShaderStage::Fragment,	{ header, common_glsl,						 			materialMap,				mesh_gBuffer_frag } },
+			/* 15 */{ spl::ShaderStage::Fragment,	{ header, common_glsl,						colorMap,	materialMap,				mesh_gBuffer_frag } },
+			/* 16 */{ spl::ShaderStage::Fragment,	{ header, common_glsl,						 							normalMap,	mesh_gBuffer_frag } },
+			/* 17 */{ spl::ShaderStage::Fragment,	{ header, common_glsl,						colorMap,					normalMap,	mesh_gBuffer_frag } },
+			/* 18 */{ spl::ShaderStage::Fragment,	{ header, common_glsl,						 			materialMap,	normalMap,	mesh_gBuffer_frag } },
+			/* 19 */{ spl::ShaderStage::Fragment,	{ header, common_glsl,						colorMap,	materialMap,	normalMap,	mesh_gBuffer_frag } },
+			/* 20 */{ spl::ShaderStage::Vertex,		{ header, common_glsl,						 										mesh_shadowMapping_vert } },
+			/* 21 */{ spl::ShaderStage::Vertex,		{ header, common_glsl,						colorMap,								mesh_shadowMapping_vert } },
+			/* 22 */{ spl::ShaderStage::Vertex,		{ header, common_glsl, compactVertex,			 										mesh_shadowMapping_vert } },
+			/* 23 */{ spl::ShaderStage::Vertex,		{ header, common_glsl, compactVertex,			colorMap,								mesh_shadowMapping_vert } },
+			/* 24 */{ spl::ShaderStage::Vertex,		{ header, common_glsl,				gpuDriven,						 				mesh_shadowMapping_vert } },
+			/* 25 */{ spl::ShaderStage::Vertex,		{ header, common_glsl,				gpuDriven,	colorMap,							mesh_shadowMapping_vert } },
+			/* 26 */{ spl::ShaderStage::Vertex,		{ header, common_glsl, compactVertex,	gpuDriven,						 				mesh_shadowMapping_vert } },
+			/* 27 */{ spl::ShaderStage::Vertex,		{ header, common_glsl, compactVertex,	gpuDriven,	colorMap,							mesh_shadowMapping_vert } },
+			/* 28 */{ spl::ShaderStage::Geometry,	{ header, common_glsl,						 										mesh_shadowMapping_geom } },
+			/* 29 */{ spl::ShaderStage::Geometry,	{ header, common_glsl,						colorMap,								mesh_shadowMapping_geom } },
+			/* 30 */{ spl::ShaderStage::Fragment,	{ header, common_glsl,																mesh_shadowMapping_frag } },
+			/* 31 */{ spl::ShaderStage::Fragment,	{ header, common_glsl,						colorMap,								mesh_shadowMapping_frag } },
+			/* 32 */{ spl::ShaderStage::Vertex,		{ header, common_glsl,  															mesh_transparency_vert } },
+			/* 33 */{ spl::ShaderStage::Vertex,		{ header, common_glsl, compactVertex,														mesh_transparency_vert } },
+			/* 34 */{ spl::ShaderStage::Fragment,	{ header, common_glsl, lightingHeader_glsl,  										mesh_transparency_frag, lighting_glsl } },
+			/* 35 */{ spl::ShaderStage::Fragment,	{ header, common_glsl, lightingHeader_glsl, colorMap,								mesh_transparency_frag, lighting_glsl } },
+			/* 36 */{ spl::ShaderStage::Fragment,	{ header, common_glsl, lightingHeader_glsl,  			materialMap,				mesh_transparency_frag, lighting_glsl } },
+			/* 37 */{ spl::ShaderStage::Fragment,	{ header, common_glsl, lightingHeader_glsl, colorMap,	materialMap,				mesh_transparency_frag, lighting_glsl } },
+			/* 38 */{ spl::ShaderStage::Fragment,	{ header, common_glsl, lightingHeader_glsl,  							normalMap,	mesh_transparency_frag, lighting_glsl } },
+			/* 39 */{ spl::ShaderStage::Fragment,	{ header, common_glsl, lightingHeader_glsl, colorMap,					normalMap,	mesh_transparency_frag, lighting_glsl } },
+			/* 40 */{ spl::ShaderStage::Fragment,	{ header, common_glsl, lightingHeader_glsl,  			materialMap,	normalMap,	mesh_transparency_frag, lighting_glsl } },
+			/* 41 */{ spl::ShaderStage::Fragment,	{ header, common_glsl, lightingHeader_glsl, colorMap,	materialMap,	normalMap,	mesh_transparency_frag, lighting_glsl } },
 		};
 
 		static constexpr uint32_t count = sizeof(sources) / sizeof(sources[0]);
 
-		spl::ShaderModule modules[count];
-		for (uint32_t i = 0; i < count; ++i)
-		{
-			std::vector<const char*> srcPtrs;
-			std::vector<uint32_t> srcSizes;
-			for (const std::string_view& src : sources[i].second)
-			{
-				srcPtrs.push_back(src.data());
-				srcSizes.push_back(src.size());
-			}
+		// Binaries are looked up in the cache by the hash of the sources of the modules of a program, and of the driver
 
-			modules[i].createFromGlsl(sources[i].first, srcPtrs.data(), srcSizes.data(), sources[i].second.size());
+		library.cacheDirectory = _params.shaderCacheDirectory;
+		if (!library.cacheDirectory.empty())
+		{
+			std::error_code error;
+			std::filesystem::create_directories(library.cacheDirectory, error);
 		}
 
-		std::array<const spl::ShaderModule*, 5> moduleArray;
+		// A driver update keeps the renderer string, the binaries it produced before may no longer load
 
-		for (spl::ShaderProgram* shader : _shaders)
+		const spl::Context* context = spl::Context::getCurrentContext();
+		library.driverHash = fnvOffsetBasis;
+		for (const char* string : { context->getVendorString(), context->getRendererString(), context->getVersionString() })
 		{
-			delete shader;
+			library.driverHash = hashBytes(library.driverHash, string, std::strlen(string) + 1);
 		}
-		_shaders.clear();
-
-		// Drawable independent
-
-		moduleArray = { modules + 0, modules + 1, nullptr, nullptr, nullptr };			// 00
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 2));
-		moduleArray = { modules + 2, modules + 3, nullptr, nullptr, nullptr };			// 01
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 2));
-		moduleArray = { modules + 2, modules + 4, nullptr, nullptr, nullptr };			// 02
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 2));
-		moduleArray = { modules + 2, modules + 5, nullptr, nullptr, nullptr };			// 03
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 2));
-
-		// Drawable dependent - Mesh
-
-		moduleArray = { modules + 6, modules + 7, nullptr, nullptr, nullptr };			// 04
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 2));
-		moduleArray = { modules + 6, modules + 8, nullptr, nullptr, nullptr };			// 05
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 2));
-		moduleArray = { modules + 6, modules + 9, nullptr, nullptr, nullptr };			// 06
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 2));
-		moduleArray = { modules + 6, modules + 10, nullptr, nullptr, nullptr };			// 07
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 2));
-		moduleArray = { modules + 6, modules + 11, nullptr, nullptr, nullptr };			// 08
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 2));
-		moduleArray = { modules + 6, modules + 12, nullptr, nullptr, nullptr };			// 09
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 2));
-		moduleArray = { modules + 6, modules + 13, nullptr, nullptr, nullptr };			// 10
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 2));
-		moduleArray = { modules + 6, modules + 14, nullptr, nullptr, nullptr };			// 11
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 2));
-		moduleArray = { modules + 15, modules + 16, modules + 17, nullptr, nullptr };	// 12
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 3));
-		moduleArray = { modules + 15, modules + 16, modules + 18, nullptr, nullptr };	// 13
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 3));
-		moduleArray = { modules + 19, modules + 20, nullptr, nullptr, nullptr };		// 14
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 2));
-		moduleArray = { modules + 19, modules + 21, nullptr, nullptr, nullptr };		// 15
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 2));
-		moduleArray = { modules + 19, modules + 22, nullptr, nullptr, nullptr };		// 16
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 2));
-		moduleArray = { modules + 19, modules + 23, nullptr, nullptr, nullptr };		// 17
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 2));
-		moduleArray = { modules + 19, modules + 24, nullptr, nullptr, nullptr };		// 18
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 2));
-		moduleArray = { modules + 19, modules + 25, nullptr, nullptr, nullptr };		// 19
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 2));
-		moduleArray = { modules + 19, modules + 26, nullptr, nullptr, nullptr };		// 20
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 2));
-		moduleArray = { modules + 19, modules + 27, nullptr, nullptr, nullptr };		// 21
-		_shaders.push_back(new spl::ShaderProgram(moduleArray.data(), 2));
-
-
-		_shaderMap = {
-			{ 
-				DrawableType::Particles,
-				{
-					// Nothing
-				}
-			},
-			{
-				DrawableType::Mesh,
-				{
-					{
-						{ _shaders[4],	_shaders[12], _shaders[14] },	//
-						{ _shaders[5],	_shaders[13], _shaders[15] },	// colorMap
-						{ _shaders[6],	_shaders[12], _shaders[16] },	// 			  materialMap
-						{ _shaders[7],	_shaders[13], _shaders[17] },	// colorMap + materialMap
-						{ _shaders[8],	_shaders[12], _shaders[18] },	// 							normalMap
-						{ _shaders[9],	_shaders[13], _shaders[19] },	// colorMap					normalMap
-						{ _shaders[10],	_shaders[12], _shaders[20] },	// 			  materialMap + normalMap
-						{ _shaders[11],	_shaders[13], _shaders[21] }	// colorMap + materialMap + normalMap
-					}
-				}
-			},
+
+		// Modules precompiled to SPIR-V by the build are found by the hash of their sources with the header without the
+		// counts. Without GL_ARB_gl_spirv, or for the modules that were not precompiled, the GLSL is compiled.
+
+		library.specializationConstants = { _params.lightSlotCount, _params.shadowTextureCount };
+#ifdef LYSE_PRECOMPILED_SHADERS
+		library.spirvEnabled = spl::Context::getCurrentContext()->hasExtension("GL_ARB_gl_spirv");
+#else
+		library.spirvEnabled = false;
+#endif
+
+		library.modules.resize(count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			ShaderLibrary::Module& module = library.modules[i];
+			module.stage = sources[i].first;
+			module.sources = sources[i].second;
+			module.hash = hashShaderModule(module.stage, module.sources);
+			module.module = nullptr;
+			module.spirv = nullptr;
+			module.spirvSize = 0;
+			module.fromSpirv = false;
+
+#ifdef LYSE_PRECOMPILED_SHADERS
+			uint64_t spirvHash = hashBytes(fnvOffsetBasis, library.spirvHeader.data(), library.spirvHeader.size());
+			for (uint32_t j = 1; j < module.sources.size(); ++j)
 			{
-				DrawableType::MeshInstanced,
-				{
-					// etc...
-				}
-			},
+				spirvHash = hashBytes(spirvHash, module.sources[j].data(), module.sources[j].size());
+			}
+
+			for (const PrecompiledShaderModule* precompiled = precompiledShaderModules; precompiled->spirv; ++precompiled)
 			{
-				DrawableType::Group,
+				if (precompiled->hash == spirvHash)
 				{
-					// Nothing
+					module.spirv = precompiled->spirv;
+					module.spirvSize = precompiled->size;
+					break;
 				}
 			}
-		};
-	}
+#endif
+		}
 
-	const void Scene::_updateAndBindUboLights(uint32_t index, std::vector<const CameraBase*>& shadowCameras)
-	{
-		assert(_lights.size() < _params.lightSlotCount);
+		library.programs = {
 
-		shadowCameras.clear();
+			// Drawable independent
 
-		// Might be too big for the stack
-		thread_local static UboLightsData uboLightsData;
+			/* 00 */{ { 0, 1, 0 }, 2 },
+			/* 01 */{ { 2, 3, 0 }, 2 },
+			/* 02 */{ { 2, 4, 0 }, 2 },
+			/* 03 */{ { 2, 5, 0 }, 2 },
+			/* 04 */{ { 0, 6, 0 }, 2 },
+			/* 05 */{ { 7, 0, 0 }, 1 },
 
-		uint32_t i = 0;
-		for (const LightBase* light : _lights)
-		{
-			uboLightsData.lights[i].type = static_cast<uint32_t>(light->getType());
+			// Drawable dependent - Mesh
 
-			uboLightsData.lights[i].shadowMapStartIndex = shadowCameras.size();
-			if (_params.shadowEnabled && light->getShadowCascadeSize() != 0)
-			{
-				light->_getShadowCameras(_camera, shadowCameras);
-			}
-			uboLightsData.lights[i].shadowMapStopIndex = shadowCameras.size();
+			/* 06 */{ { 8, 12, 0 }, 2 },
+			/* 07 */{ { 8, 13, 0 }, 2 },
+			/* 08 */{ { 8, 14, 0 }, 2 },
+			/* 09 */{ { 8, 15, 0 }, 2 },
+			/* 10 */{ { 8, 16, 0 }, 2 },
+			/* 11 */{ { 8, 17, 0 }, 2 },
+			/* 12 */{ { 8, 18, 0 }, 2 },
+			/* 13 */{ { 8, 19, 0 }, 2 },
+			/* 14 */{ { 9, 12, 0 }, 2 },
+			/* 15 */{ { 9, 13, 0 }, 2 },
+			/* 16 */{ { 9, 14, 0 }, 2 },
+			/* 17 */{ { 9, 15, 0 }, 2 },
+			/* 18 */{ { 9, 16, 0 }, 2 },
+			/* 19 */{ { 9, 17, 0 }, 2 },
+			/* 20 */{ { 9, 18, 0 }, 2 },
+			/* 21 */{ { 9, 19, 0 }, 2 },
+			/* 22 */{ { 10, 12, 0 }, 2 },
+			/* 23 */{ { 10, 13, 0 }, 2 },
+			/* 24 */{ { 10, 14, 0 }, 2 },
+			/* 25 */{ { 10, 15, 0 }, 2 },
+			/* 26 */{ { 10, 16, 0 }, 2 },
+			/* 27 */{ { 10, 17, 0 }, 2 },
+			/* 28 */{ { 10, 18, 0 }, 2 },
+			/* 29 */{ { 10, 19, 0 }, 2 },
+			/* 30 */{ { 11, 12, 0 }, 2 },
+			/* 31 */{ { 11, 13, 0 }, 2 },
+			/* 32 */{ { 11, 14, 0 }, 2 },
+			/* 33 */{ { 11, 15, 0 }, 2 },
+			/* 34 */{ { 11, 16, 0 }, 2 },
+			/* 35 */{ { 11, 17, 0 }, 2 },
+			/* 36 */{ { 11, 18, 0 }, 2 },
+			/* 37 */{ { 11, 19, 0 }, 2 },
+			/* 38 */{ { 20, 28, 30 }, 3 },
+			/* 39 */{ { 21, 29, 31 }, 3 },
+			/* 40 */{ { 22, 28, 30 }, 3 },
+			/* 41 */{ { 23, 29, 31 }, 3 },
+			/* 42 */{ { 24, 28, 30 }, 3 },
+			/* 43 */{ { 25, 29, 31 }, 3 },
+			/* 44 */{ { 26, 28, 30 }, 3 },
+			/* 45 */{ { 27, 29, 31 }, 3 },
+			/* 46 */{ { 32, 34, 0 }, 2 },
+			/* 47 */{ { 32, 35, 0 }, 2 },
+			/* 48 */{ { 32, 36, 0 }, 2 },
+			/* 49 */{ { 32, 37, 0 }, 2 },
+			/* 50 */{ { 32, 38, 0 }, 2 },
+			/* 51 */{ { 32, 39, 0 }, 2 },
+			/* 52 */{ { 32, 40, 0 }, 2 },
+			/* 53 */{ { 32, 41, 0 }, 2 },
+			/* 54 */{ { 33, 34, 0 }, 2 },
+			/* 55 */{ { 33, 35, 0 }, 2 },
+			/* 56 */{ { 33, 36, 0 }, 2 },
+			/* 57 */{ { 33, 37, 0 }, 2 },
+			/* 58 */{ { 33, 38, 0 }, 2 },
+			/* 59 */{ { 33, 39, 0 }, 2 },
+			/* 60 */{ { 33, 40, 0 }, 2 },
+			/* 61 */{ { 33, 41, 0 }, 2 },
+		};
 
-			uboLightsData.lights[i].color = light->getColor() * light->getIntensity();
+		for (uint32_t i = 0; i < library.programs.size(); ++i)
+		{
+			library.programs[i].base = i;
+		}
 
-			light->_getUboParams(_camera, &uboLightsData.lights[i].param0);
+		library.shaders.assign(library.programs.size(), nullptr);
+		library.linkFailed.assign(library.programs.size(), false);
+		library.interfaceSsao = {};
+		library.interfaceMerge = {};
+		library.depthPyramidShader = nullptr;
+		library.depthPyramidDepthLocation = -1;
+		library.cullingShader = nullptr;
+		library.cullingPhaseLocation = -1;
+		library.cullingDepthPyramidLocation = -1;
+
+		// Programs of the mesh shader sets, linked when a frame first draws with them
+
+		static constexpr std::array<uint32_t, 3> meshShaderSetPrograms[] = {
+			{ 6,	38, 46 },	//
+			{ 7,	39, 47 },	// colorMap
+			{ 8,	38, 48 },	// 			  materialMap
+			{ 9,	39, 49 },	// colorMap + materialMap
+			{ 10,	38, 50 },	// 							normalMap
+			{ 11,	39, 51 },	// colorMap					normalMap
+			{ 12,	38, 52 },	// 			  materialMap + normalMap
+			{ 13,	39, 53 },	// colorMap + materialMap + normalMap
+			{ 14,	40, 54 },	// compactVertex
+			{ 15,	41, 55 },	// colorMap + compactVertex
+			{ 16,	40, 56 },	// 			  materialMap + compactVertex
+			{ 17,	41, 57 },	// colorMap + materialMap + compactVertex
+			{ 18,	40, 58 },	// 							normalMap + compactVertex
+			{ 19,	41, 59 },	// colorMap					normalMap + compactVertex
+			{ 20,	40, 60 },	// 			  materialMap + normalMap + compactVertex
+			{ 21,	41, 61 },	// colorMap + materialMap + normalMap + compactVertex
+			{ 22,	42, 46 },	// gpuDriven
+			{ 23,	43, 47 },	// colorMap + gpuDriven
+			{ 24,	42, 48 },	// 			  materialMap + gpuDriven
+			{ 25,	43, 49 },	// colorMap + materialMap + gpuDriven
+			{ 26,	42, 50 },	// 							normalMap + gpuDriven
+			{ 27,	43, 51 },	// colorMap					normalMap + gpuDriven
+			{ 28,	42, 52 },	// 			  materialMap + normalMap + gpuDriven
+			{ 29,	43, 53 },	// colorMap + materialMap + normalMap + gpuDriven
+			{ 30,	44, 54 },	// compactVertex + gpuDriven
+			{ 31,	45, 55 },	// colorMap + compactVertex + gpuDriven
+			{ 32,	44, 56 },	// 			  materialMap + compactVertex + gpuDriven
+			{ 33,	45, 57 },	// colorMap + materialMap + compactVertex + gpuDriven
+			{ 34,	44, 58 },	// 							normalMap + compactVertex + gpuDriven
+			{ 35,	45, 59 },	// colorMap					normalMap + compactVertex + gpuDriven
+			{ 36,	44, 60 },	// 			  materialMap + normalMap + compactVertex + gpuDriven
+			{ 37,	45, 61 }	// colorMap + materialMap + normalMap + compactVertex + gpuDriven
+		};
 
-			++i;
-		}
-		uboLightsData.count = i;
+		static constexpr uint32_t meshShaderSetCount = sizeof(meshShaderSetPrograms) / sizeof(meshShaderSetPrograms[0]);
 
-		_uboLights.update(&uboLightsData, offsetof(UboLightsData, lights) + sizeof(UboLightData) * i);
+		library.shaderMap = {
+			{ DrawableType::Particles, {} },	// Nothing
+			{ DrawableType::Mesh, std::vector<ShaderSet>(meshShaderSetCount, ShaderSet(nullptr, nullptr, nullptr)) },
+			{ DrawableType::MeshInstanced, {} },	// etc...
+			{ DrawableType::Group, {} }	// Nothing
+		};
 
-		spl::Buffer::bind(spl::BufferTarget::Uniform, &_uboLights, index);
+		std::vector<ShaderSet>& meshShaderSets = library.shaderMap[DrawableType::Mesh];
+		for (uint32_t i = 0; i < meshShaderSetCount; ++i)
+		{
+			library.shaderSets.push_back({ &meshShaderSets[i], meshShaderSetPrograms[i] });
+		}
 	}
 
-	const void Scene::_updateAndBindUboDrawable(uint32_t index, const CameraBase* camera, const Drawable* drawable)
+	void Scene::_linkShader(uint32_t index)
 	{
-		UboDrawableData uboDrawableData;
-
-		uboDrawableData.model = drawable->getTransformMatrix();
-		uboDrawableData.invModel = drawable->getInverseTransformMatrix();
-		uboDrawableData.viewModel = camera->getViewMatrix() * uboDrawableData.model;
-		uboDrawableData.invViewModel = uboDrawableData.invModel * camera->getInverseViewMatrix();
-		uboDrawableData.projectionViewModel = camera->getProjectionMatrix() * uboDrawableData.viewModel;
-		uboDrawableData.invProjectionViewModel = uboDrawableData.invViewModel * camera->getInverseProjectionMatrix();
+		ShaderLibrary& library = *_shaderLibrary;
+		if (library.shaders[index] || library.linkFailed[index])
+		{
+			return;
+		}
 
-		_uboDrawable.update(&uboDrawableData, sizeof(UboDrawableData));
+		const ShaderLibrary::Program& program = library.programs[index];
 
-		spl::Buffer::bind(spl::BufferTarget::Uniform, &_uboDrawable, index);
-	}
+		spl::ShaderProgram* shader = new spl::ShaderProgram();
+		library.shaders[index] = shader;
 
-	const void Scene::_updateAndBindUboShadowCameras(uint32_t index, const std::vector<const CameraBase*>& shadowCameras)
-	{
-		assert(shadowCameras.size() <= _params.shadowTextureCount);
+		const bool cacheEnabled = !library.cacheDirectory.empty();
+		bool linked = false;
 
-		if (_params.shadowEnabled)
+		std::vector<uint8_t> binary;
+		std::filesystem::path path;
+		if (cacheEnabled)
 		{
-			// Might be too big for the stack
-			thread_local static UboShadowCamerasData uboShadowCamerasData;
-
-			for (uint32_t i = 0; i < shadowCameras.size(); ++i)
+			uint64_t hash = library.driverHash;
+			for (uint32_t i = 0; i < program.moduleCount; ++i)
 			{
-				uboShadowCamerasData.cameras[i].projection = shadowCameras[i]->getProjectionMatrix();
-				uboShadowCamerasData.cameras[i].view = shadowCameras[i]->getViewMatrix();
-				uboShadowCamerasData.cameras[i].near = shadowCameras[i]->getNearDistance();
-				uboShadowCamerasData.cameras[i].far = shadowCameras[i]->getFarDistance();
+				hash = hashBytes(hash, &library.modules[program.modules[i]].hash, sizeof(uint64_t));
 			}
-			uboShadowCamerasData.count = shadowCameras.size();
 
-			_uboShadowCameras.update(&uboShadowCamerasData, offsetof(UboShadowCamerasData, cameras) + sizeof(UboShadowCameraData) * shadowCameras.size());
-		}
-
-		spl::Buffer::bind(spl::BufferTarget::Uniform, &_uboShadowCameras, index);
-	}
-
-	void Scene::_insertInDrawSequence(void* pDrawSequence, const Drawable* drawable, ShaderType shaderType) const
-	{
-		DrawableType drawableType = drawable->getType();
-
-		if (drawableType == DrawableType::Group)
-		{
-			const DrawableGroup* group = dynamic_cast<const DrawableGroup*>(drawable);
-			assert(group != nullptr);
+			path = library.cacheDirectory / std::format("{:016x}.bin", hash);
 
-			uint32_t childCount = group->_getChildCount();
-			for (uint32_t i = 0; i < childCount; ++i)
+			uint32_t format;
+			if (readProgramBinary(path, format, binary))
 			{
-				_insertInDrawSequence(pDrawSequence, group->_getChild(i), shaderType);
+				shader->createFromBinary(format, binary.data(), binary.size());
+				linked = shader->isValid();
 			}
 		}
-		else
-		{
-			const ShaderSet* drawableShaderSet = drawable->getShaderSet();
-			const Material* material = drawable->getMaterial();
 
-			uint32_t index = (material->getColorTexture() != nullptr) | ((material->getPropertiesTexture() != nullptr) << 1);
-			if (drawableType == DrawableType::Mesh)
-			{
-				index |= (dynamic_cast<const Mesh<>*>(drawable)->getNormalMap() != nullptr) << 2;
-			}
+		// Missing, or rejected after a driver update. The modules are compiled the first time a program needs them.
 
-			switch (shaderType)
+		if (!linked)
+		{
+			std::array<const spl::ShaderModule*, 3> modules;
+			bool fromSpirv = false;
+			for (uint32_t i = 0; i < program.moduleCount; ++i)
 			{
-				case ShaderType::GBuffer:
+				ShaderLibrary::Module& module = library.modules[program.modules[i]];
+				if (!module.module)
 				{
-					using TKey = std::pair<const spl::ShaderProgram*, const shaderInterface::InterfaceGBuffer*>;
+					_compileShaderModule(program.modules[i]);
+				}
 
-					TKey key;
-					if (drawableShaderSet)
-					{
-						key.first = drawableShaderSet->_shaderGBuffer;
-						key.second = &drawableShaderSet->_interfaceGBuffer;
-					}
-					else
+				modules[i] = module.module;
+				fromSpirv |= module.fromSpirv;
+			}
+
+			shader->setBinaryRetrievableHint(cacheEnabled);
+			shader->createFromModules(modules.data(), program.moduleCount);
+
+			// Drivers that link SPIR-V but strip the names of the uniforms cannot serve the interfaces, looked up by
+			// name: the scenes of the library go back to GLSL.
+
+			if (fromSpirv && (!shader->isValid() || !hasUniformNames(*shader)))
+			{
+				library.spirvEnabled = false;
+
+				for (uint32_t i = 0; i < program.moduleCount; ++i)
+				{
+					ShaderLibrary::Module& module = library.modules[program.modules[i]];
+					if (module.fromSpirv)
+					{
+						delete module.module;
+						_compileShaderModule(program.modules[i]);
+					}
+
+					modules[i] = module.module;
+				}
+
+				delete shader;
+				shader = new spl::ShaderProgram();
+				library.shaders[index] = shader;
+
+				shader->setBinaryRetrievableHint(cacheEnabled);
+				shader->createFromModules(modules.data(), program.moduleCount);
+			}
+
+			uint32_t format;
+			if (cacheEnabled && shader->isValid() && shader->getBinary(format, binary))
+			{
+				writeProgramBinary(path, format, binary);
+			}
+		}
+
+		// A broken variant is not linked again, the draws and screen passes that would use it keep their fallback
+
+		if (!shader->isValid())
+		{
+			delete shader;
+			library.shaders[index] = nullptr;
+			library.linkFailed[index] = true;
+			return;
+		}
+
+		// Uniform locations of the drawable independent shaders, the shader sets resolve their own
+
+		switch (program.base)
+		{
+			case 0:
+				ShaderSet::fillInterface(shader, library.interfaceSsao[index]);
+				break;
+			case 1:
+			case 2:
+			case 3:
+				ShaderSet::fillInterface(shader, library.interfaceMerge[index]);
+				break;
+			case 4:
+				library.depthPyramidShader = shader;
+				library.depthPyramidDepthLocation = shader->getUniformLocation("u_depth");
+				break;
+			case 5:
+				library.cullingShader = shader;
+				library.cullingPhaseLocation = shader->getUniformLocation("u_phase");
+				library.cullingDepthPyramidLocation = shader->getUniformLocation("u_depthPyramid[0]");
+				break;
+			default:
+				break;
+		}
+	}
+
+	uint32_t Scene::_specializeShader(uint32_t index, uint32_t key)
+	{
+		ShaderLibrary& library = *_shaderLibrary;
+
+		// The SSAO is specialized to a sample count, the lighting to light types. Only the fragment modules change.
+
+		const bool ssao = (index == 0);
+		if (!ssao && key == allLightTypes)
+		{
+			return index;
+		}
+
+		const auto it = library.specializedPrograms.find({ index, key });
+		if (it != library.specializedPrograms.end())
+		{
+			return it->second;
+		}
+
+		const std::string define = ssao ? std::format("#define SSAO_SAMPLE_COUNT {}\n", key) : std::format("#define LIGHT_TYPES {}\n", key);
+
+		ShaderLibrary::Program program = library.programs[index];
+		for (uint32_t i = 0; i < program.moduleCount; ++i)
+		{
+			if (library.modules[program.modules[i]].stage != spl::ShaderStage::Fragment)
+			{
+				continue;
+			}
+
+			const auto [moduleIt, inserted] = library.specializedModules.try_emplace({ program.modules[i], define }, library.modules.size());
+			if (inserted)
+			{
+				ShaderLibrary::Module module = library.modules[program.modules[i]];
+				module.sources.insert(module.sources.begin() + 1, moduleIt->first.second);
+				module.hash = hashShaderModule(module.stage, module.sources);
+				module.module = nullptr;
+				module.spirv = nullptr;
+				module.spirvSize = 0;
+				module.fromSpirv = false;
+
+				library.modules.push_back(std::move(module));
+			}
+
+			program.modules[i] = moduleIt->second;
+		}
+
+		program.base = index;
+
+		const uint32_t specializedIndex = library.programs.size();
+		library.programs.push_back(program);
+		library.shaders.push_back(nullptr);
+		library.linkFailed.push_back(false);
+		library.specializedPrograms.emplace(std::make_pair(index, key), specializedIndex);
+
+		return specializedIndex;
+	}
+
+	void Scene::_compileShaderModule(uint32_t index)
+	{
+		ShaderLibrary& library = *_shaderLibrary;
+		ShaderLibrary::Module& module = library.modules[index];
+
+		module.module = new spl::ShaderModule();
+		module.fromSpirv = false;
+
+		if (library.spirvEnabled && module.spirv)
+		{
+			static constexpr uint32_t specializationIndices[] = { 0, 1 };
+
+			module.module->createFromSpirV(module.stage, module.spirv, module.spirvSize, "main", specializationIndices, library.specializationConstants.data(), 2);
+			if (module.module->isValid())
+			{
+				module.fromSpirv = true;
+				return;
+			}
+
+			delete module.module;
+			module.module = new spl::ShaderModule();
+		}
+
+		std::vector<const char*> srcPtrs;
+		std::vector<uint32_t> srcSizes;
+		for (const std::string_view& src : module.sources)
+		{
+			srcPtrs.push_back(src.data());
+			srcSizes.push_back(src.size());
+		}
+
+		module.module->createFromGlsl(module.stage, srcPtrs.data(), srcSizes.data(), module.sources.size());
+	}
+
+	void Scene::_linkRequestedShaders()
+	{
+		ShaderLibrary& library = *_shaderLibrary;
+		std::lock_guard lock(library.mutex);
+
+		// The variants drawn by a prepared frame are linked whatever the budget, the others wait for a later frame
+
+		uint32_t budget = _params.shaderLinkBudget;
+		uint32_t pendingCount = 0;
+		for (uint32_t i = 0; i < library.programRequests.size(); ++i)
+		{
+			const uint32_t program = library.programRequests[i];
+			if (library.shaders[program] || library.linkFailed[program])
+			{
+				continue;
+			}
+
+			if (budget == 0)
+			{
+				library.programRequests[pendingCount++] = program;
+				continue;
+			}
+
+			_linkShader(program);
+			--budget;
+		}
+
+		library.programRequests.resize(pendingCount);
+
+		pendingCount = 0;
+		for (uint32_t i = 0; i < library.requests.size(); ++i)
+		{
+			const ShaderLibrary::Request request = library.requests[i];
+
+			const auto it = std::find_if(library.shaderSets.begin(), library.shaderSets.end(), [&](const ShaderLibrary::DefaultShaderSet& shaderSet) {
+				return shaderSet.shaderSet == request.shaderSet;
+			});
+			assert(it != library.shaderSets.end());
+
+			const uint32_t program = it->programs[static_cast<uint32_t>(request.shaderType)];
+			if (!library.shaders[program] && !library.linkFailed[program])
+			{
+				if (!request.required && budget == 0)
+				{
+					library.requests[pendingCount++] = request;
+					continue;
+				}
+
+				_linkShader(program);
+				assert(library.shaders[program] || !request.required);
+
+				if (!request.required)
+				{
+					--budget;
+				}
+			}
+
+			it->shaderSet->_setShader(request.shaderType, library.shaders[program]);
+		}
+
+		library.requests.resize(pendingCount);
+	}
+
+	void Scene::_prepareLights(FramePacket& packet, FrameVector<const CameraBase*>& shadowCameras) const
+	{
+		assert(_lights.size() < _params.lightSlotCount);
+
+		shadowCameras.clear();
+		packet.lights.resize(_lights.size());
+		packet.lightTypes = 0;
+
+		uint32_t i = 0;
+		for (const LightBase* light : _lights)
+		{
+			UboLightData& lightData = packet.lights[i];
+
+			lightData.type = static_cast<uint32_t>(light->getType());
+			packet.lightTypes |= 1 << lightData.type;
+
+			lightData.shadowMapStartIndex = shadowCameras.size();
+			if (_params.shadowEnabled && light->getShadowCascadeSize() != 0)
+			{
+				light->_getShadowCameras(_camera, shadowCameras);
+			}
+			lightData.shadowMapStopIndex = shadowCameras.size();
+
+			lightData.color = light->getColor() * light->getIntensity();
+
+			light->_getUboParams(_camera, &lightData.param0);
+
+			++i;
+		}
+
+		// The shadow cameras belong to the lights, their matrices are copied
+
+		assert(shadowCameras.size() <= _params.shadowTextureCount);
+
+		packet.shadowCameras.resize(shadowCameras.size());
+		for (i = 0; i < shadowCameras.size(); ++i)
+		{
+			packet.shadowCameras[i].projection = shadowCameras[i]->getProjectionMatrix();
+			packet.shadowCameras[i].view = shadowCameras[i]->getViewMatrix();
+			packet.shadowCameras[i].near = shadowCameras[i]->getNearDistance();
+			packet.shadowCameras[i].far = shadowCameras[i]->getFarDistance();
+		}
+	}
+
+	void Scene::_prepareDraws(FramePacket& packet, const FrameVector<std::pair<const ShaderSet*, uint32_t>>& drawSequence, ShaderType shaderType, const uint32_t* lods, std::vector<FrameDraw>& draws) const
+	{
+		const bool shadow = (shaderType == ShaderType::ShadowMapping);
+
+		// The transparency shaders have no GPU-driven variant, those meshes are drawn like the others in that pass
+
+		const bool gpuDrivenPass = (shaderType != ShaderType::Transparency);
+
+		draws.resize(drawSequence.size());
+		for (uint32_t i = 0; i < drawSequence.size(); ++i)
+		{
+			const uint32_t entry = drawSequence[i].second;
+			const uint32_t flags = _registry._flags[entry];
+			const Drawable* drawable = _registry._drawables[entry];
+			const MeshBase* mesh = (flags & DrawableRegistry::flagMesh) ? static_cast<const MeshBase*>(drawable) : nullptr;
+
+			FrameDraw& draw = draws[i];
+			draw.shaderSet = drawSequence[i].first;
+			draw.drawable = drawable;
+			draw.materialIndex = _registry._materialIndices[entry];
+			draw.normalMap = mesh ? mesh->getNormalMap() : nullptr;
+			draw.faceCullingMode = shadow ? drawable->getShadowFaceCullingMode() : drawable->getGeometryFaceCullingMode();
+			draw.faceCullingOrientation = shadow ? drawable->getShadowFaceCullingOrientation() : drawable->getGeometryFaceCullingOrientation();
+			draw.lod = 0;
+			draw.meshletsCulled = false;
+			draw.firstRange = 0;
+			draw.rangeCount = 0;
+
+			if (gpuDrivenPass && (flags & DrawableRegistry::flagGpuDriven))
+			{
+				draw.gpuIndex = _gpuDrawableIndices[entry];
+				draw.occlusionTested = false;
+				continue;
+			}
+
+			draw.gpuIndex = UINT32_MAX;
+			draw.occlusionTested = (mesh != nullptr);
+			if (mesh)
+			{
+				draw.boundingBoxMin = mesh->getBoundingBoxMin();
+				draw.boundingBoxMax = mesh->getBoundingBoxMax();
+			}
+
+			const MeshBase* compactMesh = (_registry._shaderVariants[entry] & (1 << 3)) ? mesh : nullptr;
+			computeDrawableData(draw.drawableData, _camera, _registry._transforms[entry], _registry._invTransforms[entry], compactMesh, draw.materialIndex);
+
+			// Shadow maps draw whole LODs, the meshlets are only culled against the camera
+
+			draw.lod = lods ? lods[entry] : _selectLod(entry, _camera, _resolution.y, 0);
+
+			if (!shadow)
+			{
+				draw.firstRange = packet.rangeOffsets.size();
+				draw.meshletsCulled = _cullMeshlets(entry, draw.lod, *packet.frustum, packet.rangeOffsets, packet.rangeCounts);
+				draw.rangeCount = packet.rangeOffsets.size() - draw.firstRange;
+			}
+		}
+	}
+
+	void Scene::_buildMaterialTable()
+	{
+		std::shared_ptr<MaterialTable> table = std::make_shared<MaterialTable>();
+
+		const uint32_t materialCount = _registry._materials.size();
+		table->materials.reserve(materialCount);
+		table->materialsData.resize(materialCount);
+		table->textureArrayIndices.resize(materialCount, { UINT32_MAX, UINT32_MAX });
+
+		// Each texture is given a layer in the first texture array of its size and format that is not full
+
+		std::unordered_map<const spl::Texture2D*, scp::u32vec2> textureLayers;
+		const auto getTextureLayer = [&](const spl::Texture2D* texture) {
+			const auto [it, inserted] = textureLayers.insert({ texture, { 0, 0 } });
+			if (inserted)
+			{
+				uint32_t arrayIndex = 0;
+				for (; arrayIndex < table->textureArrays.size(); ++arrayIndex)
+				{
+					const MaterialTextureArray& textureArray = table->textureArrays[arrayIndex];
+					if (textureArray.size == texture->getSize() && textureArray.format == texture->getInternalFormat() && textureArray.layers.size() < maxMaterialTextureLayerCount)
+					{
+						break;
+					}
+				}
+
+				if (arrayIndex == table->textureArrays.size())
+				{
+					table->textureArrays.push_back({ texture->getSize(), texture->getInternalFormat(), {} });
+				}
+
+				std::vector<const spl::Texture2D*>& layers = table->textureArrays[arrayIndex].layers;
+				it->second = { arrayIndex, static_cast<uint32_t>(layers.size()) };
+				layers.push_back(texture);
+			}
+
+			return it->second;
+		};
+
+		for (uint32_t i = 0; i < materialCount; ++i)
+		{
+			const Material& material = table->materials.emplace_back(*_registry._materials[i]);
+
+			SsboMaterialData& materialData = table->materialsData[i];
+			materialData.color = material.getColor();
+			materialData.properties = material.getProperties();
+			materialData.colorLayer = 0;
+			materialData.propertiesLayer = 0;
+
+			if (!_params.materialTextureArraysEnabled)
+			{
+				continue;
+			}
+
+			if (material.getColorTexture())
+			{
+				const scp::u32vec2 layer = getTextureLayer(material.getColorTexture());
+				table->textureArrayIndices[i].x = layer.x;
+				materialData.colorLayer = layer.y;
+			}
+
+			if (material.getPropertiesTexture())
+			{
+				const scp::u32vec2 layer = getTextureLayer(material.getPropertiesTexture());
+				table->textureArrayIndices[i].y = layer.x;
+				materialData.propertiesLayer = layer.y;
+			}
+		}
+
+		_materialTable = std::move(table);
+		_materialsDirty = false;
+	}
+
+	void Scene::_updateAndBindUbos(const FramePacket& packet)
+	{
+		_uboCamera.update(&packet.camera, sizeof(CameraBase::UboCameraData));
+		_stateCache.bindBuffer(spl::BufferTarget::Uniform, &_uboCamera, 0);
+
+		const uint32_t lightCount = packet.lights.size();
+		_uboLights.update(&lightCount, sizeof(uint32_t));
+		if (lightCount != 0)
+		{
+			_uboLights.update(packet.lights.data(), sizeof(UboLightData) * lightCount, offsetof(UboLightsData, lights));
+		}
+		_stateCache.bindBuffer(spl::BufferTarget::Uniform, &_uboLights, 1);
+
+		// 2 :	DrawableData
+
+		if (_params.shadowEnabled)
+		{
+			const uint32_t shadowCameraCount = packet.shadowCameras.size();
+			_uboShadowCameras.update(&shadowCameraCount, sizeof(uint32_t));
+			if (shadowCameraCount != 0)
+			{
+				_uboShadowCameras.update(packet.shadowCameras.data(), sizeof(UboShadowCameraData) * shadowCameraCount, offsetof(UboShadowCamerasData, cameras));
+			}
+		}
+		_stateCache.bindBuffer(spl::BufferTarget::Uniform, &_uboShadowCameras, 3);
+
+		// 4 :	CullingData
+	}
+
+	void Scene::_uploadMaterials(const FramePacket& packet)
+	{
+		const MaterialTable& table = *packet.materialTable;
+		if (table.materials.empty())
+		{
+			return;
+		}
+
+		// The buffer is created again only when the number of materials changed
+
+		if (packet.materialTable != _materialBufferTable)
+		{
+			const uint64_t size = sizeof(SsboMaterialData) * table.materialsData.size();
+			if (!_materialBufferTable || _materialBufferTable->materialsData.size() != table.materialsData.size())
+			{
+				_ssboMaterials.createNew(size, spl::BufferStorageFlags::DynamicStorage);
+			}
+
+			_ssboMaterials.update(table.materialsData.data(), size);
+
+			_updateMaterialTextureArrays(table);
+
+			_materialBufferTable = packet.materialTable;
+		}
+
+		_stateCache.bindBuffer(spl::BufferTarget::ShaderStorage, &_ssboMaterials, materialsBinding);
+	}
+
+	void Scene::_updateMaterialTextureArrays(const MaterialTable& table)
+	{
+		thread_local static std::vector<uint8_t> texels;
+
+		// Only the arrays whose textures changed are copied again, the content of a texture is not watched
+
+		for (uint32_t i = 0; i < table.textureArrays.size(); ++i)
+		{
+			const MaterialTextureArray& textureArray = table.textureArrays[i];
+
+			if (i == _materialTextureArrays.size())
+			{
+				_materialTextureArrays.push_back(new spl::Texture());
+				_materialTextureArrayLayers.emplace_back();
+			}
+			else if (_materialTextureArrayLayers[i] == textureArray.layers)
+			{
+				continue;
+			}
+
+			spl::TextureCreationParams creationParams;
+			creationParams.target = spl::TextureTarget::Array2D;
+			creationParams.internalFormat = textureArray.format;
+			creationParams.width = textureArray.size.x;
+			creationParams.height = textureArray.size.y;
+			creationParams.depth = textureArray.layers.size();
+
+			spl::Texture* texture = _materialTextureArrays[i];
+			texture->createNew(creationParams);
+			texture->setMinifyingFilter(spl::TextureFiltering::Linear);
+			texture->setMagnifyingFilter(spl::TextureFiltering::Linear);
+			texture->setWrappingS(spl::TextureWrapping::Repeat);
+			texture->setWrappingT(spl::TextureWrapping::Repeat);
+
+			// Large enough for any format, up to four channels of 32 bits
+
+			texels.resize(textureArray.size.x * textureArray.size.y * 16);
+			for (uint32_t j = 0; j < textureArray.layers.size(); ++j)
+			{
+				textureArray.layers[j]->getImage(texels.data());
+				texture->update(texels.data(), 0, 0, j, textureArray.size.x, textureArray.size.y, 1);
+			}
+
+			_materialTextureArrayLayers[i] = textureArray.layers;
+		}
+
+		while (_materialTextureArrays.size() > table.textureArrays.size())
+		{
+			delete _materialTextureArrays.back();
+			_materialTextureArrays.pop_back();
+			_materialTextureArrayLayers.pop_back();
+		}
+	}
+
+	const ShaderSet* Scene::_getShaderSet(uint32_t entry, ShaderType shaderType, uint32_t lightTypes)
+	{
+		if (_registry._shaderSets[entry])
+		{
+			return _registry._shaderSets[entry];
+		}
+
+		assert(_registry._defaultShaderSets[entry]);
+
+		uint32_t variant = _registry._materialVariants[_registry._materialIndices[entry]] | _registry._shaderVariants[entry];
+		if (_registry._flags[entry] & DrawableRegistry::flagGpuDriven)
+		{
+			variant |= 1 << 4;
+		}
+
+		const auto request = [&](const ShaderSet* shaderSet, bool required) {
+			std::vector<ShaderLibrary::Request>& requests = _shaderLibrary->requests;
+
+			const auto it = std::find_if(requests.begin(), requests.end(), [&](const ShaderLibrary::Request& pending) {
+				return pending.shaderSet == shaderSet && pending.shaderType == shaderType;
+			});
+
+			if (it == requests.end())
+			{
+				requests.push_back({ shaderSet, shaderType, required });
+			}
+			else
+			{
+				it->required = it->required || required;
+			}
+		};
+
+		// A variant not linked yet is requested, its draws use the variant with the same vertex inputs and no texture
+		// in the meantime
+
+		const ShaderSet* shaderSet = _registry._defaultShaderSets[entry] + variant;
+		const ShaderSet* fallback = _registry._defaultShaderSets[entry] + (variant & ~textureVariantMask);
+
+		if (!shaderSet->_getShader(shaderType) && shaderSet != fallback)
+		{
+			request(shaderSet, false);
+			shaderSet = fallback;
+		}
+
+		if (!shaderSet->_getShader(shaderType))
+		{
+			request(shaderSet, true);
+			return shaderSet;
+		}
+
+		// The transparency of a linked set is specialized to the light types of the frame, requested like a variant
+
+		if (shaderType != ShaderType::Transparency || lightTypes == allLightTypes)
+		{
+			return shaderSet;
+		}
+
+		auto it = _shaderLibrary->specializedShaderSets.find({ shaderSet, lightTypes });
+		if (it == _shaderLibrary->specializedShaderSets.end())
+		{
+			const auto defaultIt = std::find_if(_shaderLibrary->shaderSets.begin(), _shaderLibrary->shaderSets.end(), [&](const ShaderLibrary::DefaultShaderSet& defaultShaderSet) {
+				return defaultShaderSet.shaderSet == shaderSet;
+			});
+			assert(defaultIt != _shaderLibrary->shaderSets.end());
+
+			std::array<uint32_t, 3> programs = defaultIt->programs;
+			programs[static_cast<uint32_t>(ShaderType::Transparency)] = _specializeShader(programs[static_cast<uint32_t>(ShaderType::Transparency)], lightTypes);
+
+			it = _shaderLibrary->specializedShaderSets.emplace(std::make_pair(shaderSet, lightTypes), ShaderSet(nullptr, nullptr, nullptr)).first;
+			_shaderLibrary->shaderSets.push_back({ &it->second, programs });
+		}
+
+		if (!it->second._getShader(shaderType))
+		{
+			request(&it->second, false);
+			return shaderSet;
+		}
+
+		return &it->second;
+	}
+
+	void Scene::_buildDrawSequence(const FrameVector<uint32_t>& entries, ShaderType shaderType, uint32_t lightTypes, FrameVector<std::pair<const ShaderSet*, uint32_t>>& drawSequence)
+	{
+		// Test the drawables against the occlusion buffer in parallel, it is read-only by now
+
+		FrameVector<uint8_t> hidden(entries.size(), false, _frameArena);
+
+		if (shaderType != ShaderType::ShadowMapping && _params.softwareOcclusionCullingEnabled && !_occluders.empty())
+		{
+			JobSystem::getGlobal().parallelFor(0, entries.size(), 256, [&](uint32_t begin, uint32_t end) {
+				for (uint32_t i = begin; i < end; ++i)
+				{
+					hidden[i] = _isHiddenByOccluders(entries[i]);
+				}
+			});
+		}
+
+		// `submit` may be linking the shaders of the default shader sets
+
+		std::lock_guard lock(_shaderLibrary->mutex);
+
+		drawSequence.clear();
+
+		for (uint32_t i = 0; i < entries.size(); ++i)
+		{
+			if (!hidden[i])
+			{
+				drawSequence.push_back({ _getShaderSet(entries[i], shaderType, lightTypes), entries[i] });
+			}
+		}
+
+		// Drawables that use the same program are drawn one after the other. Ties are broken by entry rather than with
+		// `std::stable_sort`, which allocates its buffer on the heap.
+
+		std::sort(drawSequence.begin(), drawSequence.end(), [&](const std::pair<const ShaderSet*, uint32_t>& a, const std::pair<const ShaderSet*, uint32_t>& b) {
+			const spl::ShaderProgram* shaderA = a.first->_getShader(shaderType);
+			const spl::ShaderProgram* shaderB = b.first->_getShader(shaderType);
+			return (shaderA != shaderB) ? std::less<const spl::ShaderProgram*>()(shaderA, shaderB) : (a.second < b.second);
+		});
+	}
+	
+	uint32_t Scene::_selectLod(uint32_t entry, const CameraBase* camera, uint32_t height, uint32_t bias) const
+	{
+		if (!_params.lodEnabled || !(_registry._flags[entry] & DrawableRegistry::flagMesh))
+		{
+			return 0;
+		}
+
+		const MeshBase* mesh = static_cast<const MeshBase*>(_registry._drawables[entry]);
+		const std::vector<MeshLod>& lods = mesh->getLods();
+		if (lods.size() <= 1)
+		{
+			return 0;
+		}
+
+		// Bounding sphere of the mesh in view-space (the view matrix has no scale, the model matrix might)
+
+		const scp::f32vec3 center = (mesh->getBoundingBoxMin() + mesh->getBoundingBoxMax()) * 0.5f;
+		const float localRadius = scp::length(mesh->getBoundingBoxMax() - mesh->getBoundingBoxMin()) * 0.5f;
+
+		const scp::f32mat4x4 viewModel = camera->getViewMatrix() * _registry._transforms[entry];
+		const scp::f32vec4 viewCenter = viewModel * scp::f32vec4(center, 1.f);
+		const float radius = std::max({
+			scp::length(viewModel * scp::f32vec4(localRadius, 0.f, 0.f, 0.f)),
+			scp::length(viewModel * scp::f32vec4(0.f, localRadius, 0.f, 0.f)),
+			scp::length(viewModel * scp::f32vec4(0.f, 0.f, localRadius, 0.f))
+		});
+
+		// Projected radius in pixels, works for perspective and orthographic projections alike
+
+		const scp::f32vec4 clipCenter = camera->getProjectionMatrix() * viewCenter;
+		const scp::f32vec4 clipRadius = camera->getProjectionMatrix() * scp::f32vec4(0.f, radius, 0.f, 0.f);
+		if (clipCenter.w <= 0.f)
+		{
+			return 0;
+		}
+
+		const float pixelRadius = std::abs(clipRadius.y) / clipCenter.w * height * 0.5f;
+
+		// Coarsest LOD whose error stays under the threshold
+
+		uint32_t lod = 0;
+		while (lod + 1 < lods.size() && lods[lod + 1].error * pixelRadius <= _params.lodErrorThreshold)
+		{
+			++lod;
+		}
+
+		return std::min<uint32_t>(lod + bias, lods.size() - 1);
+	}
+
+	bool Scene::_cullMeshlets(uint32_t entry, uint32_t lod, const Frustum& frustum, std::vector<uint32_t>& rangeOffsets, std::vector<uint32_t>& rangeCounts) const
+	{
+		if (!_params.clusterCullingEnabled || lod != 0 || !(_registry._flags[entry] & DrawableRegistry::flagMesh))
+		{
+			return false;
+		}
+
+		const MeshBase* mesh = static_cast<const MeshBase*>(_registry._drawables[entry]);
+		if (mesh->getMeshlets().empty())
+		{
+			return false;
+		}
+
+		// The normal cones assume counter-clockwise front faces and are only valid under a uniform positive scale
+
+		const scp::f32mat4x4& model = _registry._transforms[entry];
+
+		float maxScale;
+		const float uniformScale = getUniformScale(model, maxScale);
+
+		float coneSign = 0.f;
+		if (uniformScale != 0.f && mesh->getGeometryFaceCullingOrientation() == spl::FaceOrientation::Back)
+		{
+			if (mesh->getGeometryFaceCullingMode() == spl::FaceCullingMode::CounterClockWise)
+			{
+				coneSign = 1.f;
+			}
+			else if (mesh->getGeometryFaceCullingMode() == spl::FaceCullingMode::Clockwise)
+			{
+				coneSign = -1.f;
+			}
+		}
+
+		// Cull each meshlet and merge the visible ones that are contiguous in the index buffer
+
+		const uint32_t firstRange = rangeOffsets.size();
+
+		for (const Meshlet& meshlet : mesh->getMeshlets())
+		{
+			const scp::f32vec4 worldCenter = model * scp::f32vec4(meshlet.center, 1.f);
+			const scp::f32vec3 center = { worldCenter.x, worldCenter.y, worldCenter.z };
+			const float radius = meshlet.radius * maxScale;
+
+			if (!frustum.intersectsSphere(center, radius))
+			{
+				continue;
+			}
+
+			if (coneSign != 0.f)
+			{
+				const scp::f32vec4 worldAxis = model * scp::f32vec4(meshlet.coneAxis * (coneSign / uniformScale), 0.f);
+				const scp::f32vec3 axis = { worldAxis.x, worldAxis.y, worldAxis.z };
+
+				const scp::f32vec3 direction = center - frustum.getEyePosition();
+				if (scp::dot(direction, axis) >= meshlet.coneCutoff * scp::length(direction) + radius)
+				{
+					continue;
+				}
+			}
+
+			if (rangeOffsets.size() > firstRange && rangeOffsets.back() + rangeCounts.back() == meshlet.indexOffset)
+			{
+				rangeCounts.back() += meshlet.indexCount;
+			}
+			else
+			{
+				rangeOffsets.push_back(meshlet.indexOffset);
+				rangeCounts.push_back(meshlet.indexCount);
+			}
+		}
+
+		return true;
+	}
+
+	template<typename TFilter>
+	void Scene::_recordDraws(const FramePacket& packet, const std::vector<FrameDraw>& draws, ShaderType shaderType, std::vector<CommandBuffer>& commandBuffers, const TFilter& filter)
+	{
+		// Each bucket of consecutive draws has its own command buffer, executed in order, so the sequence is kept
+
+		const uint32_t bucketCount = (draws.size() + drawBucketSize - 1) / drawBucketSize;
+		commandBuffers.resize(bucketCount);
+
+		JobSystem::getGlobal().parallelFor(0, bucketCount, 1, [&](uint32_t bucketBegin, uint32_t bucketEnd) {
+			for (uint32_t bucket = bucketBegin; bucket < bucketEnd; ++bucket)
+			{
+				CommandBuffer& commands = commandBuffers[bucket];
+				commands.clear();
+
+				const spl::ShaderProgram* currentShader = nullptr;
+
+				const uint32_t end = std::min<uint32_t>((bucket + 1) * drawBucketSize, draws.size());
+				for (uint32_t i = bucket * drawBucketSize; i < end; ++i)
+				{
+					if (filter(i))
 					{
-						key.first = _shaderMap.find(drawableType)->second[index]._shaderGBuffer;
-						key.second = &_shaderMap.find(drawableType)->second[index]._interfaceGBuffer;
+						_recordDraw(commands, packet, draws[i], shaderType, currentShader);
 					}
+				}
+			}
+		});
+	}
+
+	void Scene::_recordDraw(CommandBuffer& commands, const FramePacket& packet, const FrameDraw& draw, ShaderType shaderType, const spl::ShaderProgram*& currentShader)
+	{
+		const ShaderSet* shaderSet = draw.shaderSet;
+
+		const spl::ShaderProgram* shader = nullptr;
+		const shaderInterface::SubInterfaceDrawable* drawableInterface = nullptr;
+		uint32_t vertexInputMask = 0;
+		switch (shaderType)
+		{
+			case ShaderType::GBuffer:
+				shader = shaderSet->_shaderGBuffer;
+				drawableInterface = &shaderSet->_interfaceGBuffer.u_drawable;
+				vertexInputMask = shaderSet->_interfaceGBuffer.vertexInputMask;
+				break;
+			case ShaderType::ShadowMapping:
+				shader = shaderSet->_shaderShadow;
+				drawableInterface = &shaderSet->_interfaceShadow.u_drawable;
+				vertexInputMask = shaderSet->_interfaceShadow.vertexInputMask;
+				break;
+			case ShaderType::Transparency:
+				shader = shaderSet->_shaderTransparency;
+				drawableInterface = &shaderSet->_interfaceTransparency.u_drawable;
+				vertexInputMask = shaderSet->_interfaceTransparency.vertexInputMask;
+				break;
+			default:
+				assert(false);
+				return;
+		}
+
+		// The results of the previous passes are set once per program
+
+		if (shader != currentShader)
+		{
+			currentShader = shader;
+			commands.bindShader(currentShader);
+
+			if (shaderType == ShaderType::ShadowMapping)
+			{
+				_setGBufferResultUniforms(commands, &shaderSet->_interfaceShadow.u_gBuffer);
+			}
+			else if (shaderType == ShaderType::Transparency)
+			{
+				_setGBufferResultUniforms(commands, &shaderSet->_interfaceTransparency.u_gBuffer);
+				_setShadowResultUniforms(commands, &shaderSet->_interfaceTransparency.u_shadow);
+			}
+		}
+
+		commands.setFaceCulling(draw.faceCullingMode, draw.faceCullingOrientation);
+
+		_setDrawableUniforms(commands, drawableInterface, packet, draw);
+
+		if (draw.gpuIndex != UINT32_MAX)
+		{
+			_drawGpuDrawable(commands, packet, draw, vertexInputMask, shaderType);
+			return;
+		}
+
+		commands.updateBuffer(&_uboDrawable, &draw.drawableData, sizeof(UboDrawableData));
+		commands.bindBuffer(spl::BufferTarget::Uniform, &_uboDrawable, 2);
+
+		if (draw.meshletsCulled)
+		{
+			const MeshBase* mesh = static_cast<const MeshBase*>(draw.drawable);
+			commands.drawRanges(mesh, vertexInputMask, packet.rangeOffsets.data() + draw.firstRange, packet.rangeCounts.data() + draw.firstRange, draw.rangeCount);
+		}
+		else
+		{
+			commands.draw(draw.drawable, vertexInputMask, draw.lod);
+		}
+	}
+
+	bool Scene::_isOccluded(const FrameDraw& draw) const
+	{
+		if (!_params.occlusionCullingEnabled || !draw.occlusionTested)
+		{
+			return false;
+		}
+
+		return _depthPyramid.isBoxOccluded(draw.boundingBoxMin, draw.boundingBoxMax, draw.drawableData.model);
+	}
+
+	void Scene::_buildDepthPyramid(spl::Context* context)
+	{
+		_stateCache.setFaceCullingMode(spl::FaceCullingMode::Disabled);
+		_stateCache.setIsDepthTestEnabled(false);
+		_stateCache.bindShader(_shaderLibrary->depthPyramidShader);
+
+		const spl::Texture2D* input = &_depthTexture;
+		for (uint32_t i = 0; i < _depthPyramidTextures.size(); ++i)
+		{
+			const scp::u32vec2& size = _depthPyramidTextures[i]->getSize();
+			context->setViewport(0, 0, size.x, size.y);
+
+			spl::Framebuffer::bind(spl::FramebufferTarget::DrawFramebuffer, _depthPyramidFramebuffers[i]);
+
+			_stateCache.setUniform(_shaderLibrary->depthPyramidDepthLocation, 0, input);
+
+			_screenVao.drawArrays(spl::PrimitiveType::TriangleStrips, 0, 4);
+
+			input = _depthPyramidTextures[i];
+		}
+
+		context->setViewport(0, 0, _resolution.x, _resolution.y);
+		_stateCache.setIsDepthTestEnabled(true);
+	}
+
+	void Scene::_requestDepthPyramidReadback(const FramePacket& packet)
+	{
+		// The GPU is more than a ring behind, this frame's pyramid is not read back rather than waiting
+
+		DepthPyramidReadback& readback = _depthPyramidReadbacks[_depthPyramidReadbackIndex];
+		if (readback.pending)
+		{
+			return;
+		}
+
+		// With a pixel pack buffer bound, the image is written at an offset in the buffer, asynchronously
+
+		spl::Buffer::bind(spl::BufferTarget::PixelPack, &readback.buffer);
+		_depthPyramidTextures[_depthPyramidReadbackLevel - 1]->getImage(nullptr);
+		spl::Buffer::bind(spl::BufferTarget::PixelPack, nullptr);
+
+		readback.fence.insert();
+		readback.pending = true;
+		readback.view = packet.camera.view;
+		readback.projection = packet.camera.projection;
+		readback.near = packet.camera.near;
+		readback.far = packet.camera.far;
+
+		_depthPyramidReadbackIndex = (_depthPyramidReadbackIndex + 1) % _depthPyramidReadbacks.size();
+	}
+
+	void Scene::_readDepthPyramid()
+	{
+		// The copies complete in order, only the latest complete one is built into the pyramid
+
+		const DepthPyramidReadback* latest = nullptr;
+		for (uint32_t i = 0; i < _depthPyramidReadbacks.size(); ++i)
+		{
+			DepthPyramidReadback& readback = _depthPyramidReadbacks[(_depthPyramidReadbackIndex + i) % _depthPyramidReadbacks.size()];
+			if (!readback.pending)
+			{
+				continue;
+			}
+
+			if (!readback.fence.isSignaled())
+			{
+				break;
+			}
+
+			readback.fence.destroy();
+			readback.pending = false;
+			latest = &readback;
+		}
+
+		if (latest)
+		{
+			latest->buffer.getData(_depthPyramidReadback.data(), sizeof(float) * _depthPyramidReadback.size());
+			_depthPyramid.update(_depthPyramidReadback.data(), _resolution, _depthPyramidReadbackLevel, latest->view, latest->projection, latest->near, latest->far);
+		}
+	}
+
+	void Scene::_prepareGpuDrawables(FramePacket& packet)
+	{
+		// Register the meshes and gather their LODs and meshlets when the drawables changed
+
+		if (_gpuDrawablesDirty)
+		{
+			std::shared_ptr<GpuDrawableLayout> layout = std::make_shared<GpuDrawableLayout>();
+			layout->commandCount = 0;
+
+			_gpuDrawableIndices.assign(_registry.getSize(), UINT32_MAX);
+
+			for (uint32_t i = 0; i < _registry.getSize(); ++i)
+			{
+				uint32_t& flags = _registry._flags[i];
+				flags &= ~DrawableRegistry::flagGpuDriven;
+
+				if (!(flags & DrawableRegistry::flagMesh) || _registry._shaderSets[i])
+				{
+					continue;
+				}
+
+				const MeshBase* mesh = static_cast<const MeshBase*>(_registry._drawables[i]);
+				if (!mesh->getLods().empty())
+				{
+					_gpuDrawableIndices[i] = layout->meshes.size();
+					layout->meshes.push_back(mesh);
+					layout->entries.push_back(i);
+					flags |= DrawableRegistry::flagGpuDriven;
+				}
+			}
+
+			for (const MeshBase* mesh : layout->meshes)
+			{
+				layout->lods.insert(layout->lods.end(), mesh->getLods().begin(), mesh->getLods().end());
+
+				for (const Meshlet& meshlet : mesh->getMeshlets())
+				{
+					layout->meshlets.push_back({ meshlet.indexOffset, meshlet.indexCount, meshlet.center, meshlet.radius, meshlet.coneAxis, meshlet.coneCutoff });
+				}
+
+				// Each mesh has room for one command per meshlet, the visible meshlets merge into fewer commands
+
+				layout->commandOffsets.push_back(layout->commandCount);
+				layout->commandCount += std::max<uint32_t>(mesh->getMeshlets().size(), 1);
+			}
+
+			if (layout->meshlets.empty())
+			{
+				layout->meshlets.emplace_back();
+			}
+
+			_gpuDrawableLayout = std::move(layout);
+			_gpuDrawablesDirty = false;
+		}
+
+		packet.gpuLayout = _gpuDrawableLayout;
+
+		// Transforms and culling data are uploaded every frame
+
+		const std::vector<const MeshBase*>& meshes = _gpuDrawableLayout->meshes;
+
+		packet.gpuDrawablesData.resize(meshes.size());
+		packet.gpuDrawablesCullingData.resize(meshes.size());
+
+		uint32_t lodOffset = 0;
+		uint32_t meshletOffset = 0;
+		for (uint32_t i = 0; i < meshes.size(); ++i)
+		{
+			const MeshBase* mesh = meshes[i];
+			const uint32_t entry = _gpuDrawableLayout->entries[i];
+
+			computeDrawableData(packet.gpuDrawablesData[i], _camera, _registry._transforms[entry], _registry._invTransforms[entry], mesh->_compactVertices ? mesh : nullptr, _registry._materialIndices[entry]);
+
+			SsboDrawableCullingData& cullingData = packet.gpuDrawablesCullingData[i];
+			cullingData.boundingBoxMin = mesh->getBoundingBoxMin();
+			cullingData.lodOffset = lodOffset;
+			cullingData.boundingBoxMax = mesh->getBoundingBoxMax();
+			cullingData.lodCount = mesh->getLods().size();
+			cullingData.meshletOffset = meshletOffset;
+			cullingData.meshletCount = mesh->getMeshlets().size();
+			cullingData.commandOffset = _gpuDrawableLayout->commandOffsets[i];
+			cullingData.flags = 0;
+
+			// Same conditions as `_cullMeshlets` for the normal cones
+
+			float maxScale;
+			if (getUniformScale(_registry._transforms[entry], maxScale) != 0.f && mesh->getGeometryFaceCullingOrientation() == spl::FaceOrientation::Back)
+			{
+				if (mesh->getGeometryFaceCullingMode() == spl::FaceCullingMode::CounterClockWise)
+				{
+					cullingData.flags = cullingCone;
+				}
+				else if (mesh->getGeometryFaceCullingMode() == spl::FaceCullingMode::Clockwise)
+				{
+					cullingData.flags = cullingCone | cullingConeFlipped;
+				}
+			}
+
+			lodOffset += cullingData.lodCount;
+			meshletOffset += cullingData.meshletCount;
+		}
+	}
+
+	void Scene::_uploadGpuDrawables(const FramePacket& packet)
+	{
+		const GpuDrawableLayout& layout = *packet.gpuLayout;
+		if (layout.meshes.empty())
+		{
+			return;
+		}
+
+		// The buffers are created again when the frame was prepared with another layout
+
+		if (packet.gpuLayout != _gpuBufferLayout)
+		{
+			const uint32_t drawableCount = layout.meshes.size();
+
+			_ssboDrawables.createNew(sizeof(UboDrawableData) * drawableCount, spl::BufferStorageFlags::DynamicStorage);
+			_ssboDrawablesCulling.createNew(sizeof(SsboDrawableCullingData) * drawableCount, spl::BufferStorageFlags::DynamicStorage);
+			_ssboLods.createNew(sizeof(MeshLod) * layout.lods.size(), spl::BufferStorageFlags::None, layout.lods.data());
+			_ssboMeshlets.createNew(sizeof(SsboMeshletData) * layout.meshlets.size(), spl::BufferStorageFlags::None, layout.meshlets.data());
+			_ssboCommands.createNew(sizeof(SsboDrawCommand) * (drawableCount + layout.commandCount), spl::BufferStorageFlags::None);
+			_ssboCounts.createNew(sizeof(uint32_t) * drawableCount, spl::BufferStorageFlags::None);
+			_ssboVisibility.createNew(sizeof(uint32_t) * drawableCount, spl::BufferStorageFlags::None);
+
+			_gpuBufferLayout = packet.gpuLayout;
+		}
+
+		_ssboDrawables.update(packet.gpuDrawablesData.data(), sizeof(UboDrawableData) * packet.gpuDrawablesData.size());
+		_ssboDrawablesCulling.update(packet.gpuDrawablesCullingData.data(), sizeof(SsboDrawableCullingData) * packet.gpuDrawablesCullingData.size());
+	}
+
+	void Scene::_dispatchCulling(uint32_t phase, const FramePacket& packet)
+	{
+		const uint32_t drawableCount = packet.gpuLayout->meshes.size();
+		if (drawableCount == 0)
+		{
+			return;
+		}
+
+		const Frustum& frustum = *packet.frustum;
+
+		UboCullingData uboCullingData;
+
+		std::copy(frustum.getPlanes().begin(), frustum.getPlanes().end(), uboCullingData.frustumPlanes);
+		uboCullingData.eye = frustum.getEyePosition();
+		uboCullingData.lodErrorThreshold = _params.lodErrorThreshold;
+		uboCullingData.resolution = _resolution;
+		uboCullingData.drawableCount = drawableCount;
+		uboCullingData.shadowLodBias = _params.shadowLodBias;
+		uboCullingData.shadowResolution = _params.shadowTextureResolution;
+
+		// The pyramid textures hold the one of the previous frame in the first phase, and the one of this frame in the
+		// second, they are sampled directly
+
+		if (_params.occlusionCullingEnabled && _depthPyramidBuilt)
+		{
+			uboCullingData.pyramidView = _depthPyramidCamera.view;
+			uboCullingData.pyramidProjection = _depthPyramidCamera.projection;
+			uboCullingData.pyramidNear = _depthPyramidCamera.near;
+			uboCullingData.pyramidFar = _depthPyramidCamera.far;
+			uboCullingData.pyramidLevelCount = _depthPyramidTextures.size() + 1;
+		}
+		else
+		{
+			uboCullingData.pyramidLevelCount = 0;
+		}
+
+		uboCullingData.flags = 0;
+		uboCullingData.flags |= _params.frustumCullingEnabled ? cullingFrustum : 0;
+		uboCullingData.flags |= _params.clusterCullingEnabled ? cullingCluster : 0;
+		uboCullingData.flags |= _params.occlusionCullingEnabled ? cullingOcclusion : 0;
+		uboCullingData.flags |= _params.lodEnabled ? cullingLodSelection : 0;
 
-					std::multimap<TKey, const Drawable*>& drawSequence = *reinterpret_cast<std::multimap<TKey, const Drawable*>*>(pDrawSequence);
-					drawSequence.insert({ key, drawable });
+		_uboCulling.update(&uboCullingData, sizeof(UboCullingData));
 
-					break;
+		_stateCache.bindBuffer(spl::BufferTarget::Uniform, &_uboCulling, 4);
+		_stateCache.bindBuffer(spl::BufferTarget::ShaderStorage, &_ssboDrawables, 0);
+		_stateCache.bindBuffer(spl::BufferTarget::ShaderStorage, &_ssboDrawablesCulling, 1);
+		_stateCache.bindBuffer(spl::BufferTarget::ShaderStorage, &_ssboLods, 2);
+		_stateCache.bindBuffer(spl::BufferTarget::ShaderStorage, &_ssboMeshlets, 3);
+		_stateCache.bindBuffer(spl::BufferTarget::ShaderStorage, &_ssboCommands, 4);
+		_stateCache.bindBuffer(spl::BufferTarget::ShaderStorage, &_ssboCounts, 5);
+		_stateCache.bindBuffer(spl::BufferTarget::ShaderStorage, &_ssboVisibility, 6);
+
+		const spl::ShaderProgram* cullingShader = _shaderLibrary->cullingShader;
+		_stateCache.bindShader(cullingShader);
+
+		_stateCache.setUniform(_shaderLibrary->cullingPhaseLocation, phase);
+		if (uboCullingData.pyramidLevelCount != 0)
+		{
+			for (uint32_t i = 0; i < _depthPyramidTextures.size(); ++i)
+			{
+				_stateCache.setUniform(_shaderLibrary->cullingDepthPyramidLocation + i, i, _depthPyramidTextures[i]);
+			}
+		}
+		cullingShader->dispatchCompute((drawableCount + 63) / 64, 1, 1);
+
+		spl::ShaderProgram::memoryBarrier(spl::MemoryBarrier::Command | spl::MemoryBarrier::ShaderStorage);
+
+		spl::Buffer::bind(spl::BufferTarget::DrawIndirect, &_ssboCommands);
+		spl::Buffer::bind(spl::BufferTarget::Parameter, &_ssboCounts);
+	}
+
+	void Scene::_rasterizeOccluders(const FrameVector<uint32_t>& entries)
+	{
+		_occluders.clear();
+		for (const uint32_t entry : entries)
+		{
+			if (_registry._flags[entry] & DrawableRegistry::flagOccluder)
+			{
+				_occluders.push_back(static_cast<const MeshBase*>(_registry._drawables[entry]));
+			}
+		}
+
+		if (_occluders.empty())
+		{
+			return;
+		}
+
+		_occlusionBuffer.clear(_params.softwareOcclusionResolution, _camera);
+
+		// Each job rasterizes every occluder in its own band of rows, so that no two jobs write the same pixel
+
+		const uint32_t height = _params.softwareOcclusionResolution.y;
+		const uint32_t bandCount = std::clamp<uint32_t>(_params.softwareOcclusionBandCount, 1, height);
+		const uint32_t bandHeight = (height + bandCount - 1) / bandCount;
+
+		JobSystem::getGlobal().parallelFor(0, height, bandHeight, [&](uint32_t rowBegin, uint32_t rowEnd) {
+			for (const MeshBase* occluder : _occluders)
+			{
+				const std::vector<uint32_t>& indices = occluder->getOccluderIndices();
+				_occlusionBuffer.rasterize(occluder->getOccluderPositions().data(), indices.data(), indices.size(), occluder->_worldTransform, rowBegin, rowEnd);
+			}
+		});
+
+		_occlusionBuffer.updateTiles();
+	}
+
+	bool Scene::_isHiddenByOccluders(uint32_t entry) const
+	{
+		const uint32_t flags = _registry._flags[entry];
+		if (!_params.softwareOcclusionCullingEnabled || _occluders.empty() || !(flags & DrawableRegistry::flagMesh))
+		{
+			return false;
+		}
+
+		// Occluders are never tested, they would hide themselves where their box and surface meet
+
+		if (flags & DrawableRegistry::flagOccluder)
+		{
+			return false;
+		}
+
+		const MeshBase* mesh = static_cast<const MeshBase*>(_registry._drawables[entry]);
+
+		return _occlusionBuffer.isBoxOccluded(mesh->getBoundingBoxMin(), mesh->getBoundingBoxMax(), _registry._transforms[entry]);
+	}
+
+	void Scene::_drawGpuDrawable(CommandBuffer& commands, const FramePacket& packet, const FrameDraw& draw, uint32_t vertexInputMask, ShaderType shaderType) const
+	{
+		const GpuDrawableLayout& layout = *packet.gpuLayout;
+		const uint32_t index = draw.gpuIndex;
+		const MeshBase* mesh = layout.meshes[index];
+
+		switch (shaderType)
+		{
+			case ShaderType::GBuffer:
+			{
+				// Commands of the camera follow the shadow commands, one per drawable
+
+				const uint64_t commandOffset = sizeof(SsboDrawCommand) * (layout.meshes.size() + layout.commandOffsets[index]);
+				const uint32_t maxCommandCount = std::max<uint32_t>(mesh->getMeshlets().size(), 1);
+				commands.drawIndirectCount(mesh, vertexInputMask, commandOffset, sizeof(uint32_t) * index, maxCommandCount);
+				break;
+			}
+			case ShaderType::ShadowMapping:
+			{
+				commands.drawIndirect(mesh, vertexInputMask, sizeof(SsboDrawCommand) * index, 1);
+				break;
+			}
+			default:
+			{
+				assert(false);
+				break;
+			}
+		}
+	}
+
+	void Scene::_registerInBvh(const Drawable* drawable)
+	{
+		// Only the roots are in the BVH, the bounding box of a group covers all its children
+
+		drawable->_updateWorldBoundingBox();
+
+		if (drawable->_hasWorldBoundingBox)
+		{
+			_bvhLeaves[drawable] = { _bvh.insert(drawable, drawable->_worldBoundingBoxMin, drawable->_worldBoundingBoxMax), drawable->_worldBoundingBoxVersion };
+		}
+		else
+		{
+			_unboundedDrawables.push_back(drawable);
+		}
+	}
+
+	void Scene::_updateDrawables()
+	{
+		// A child removed from its group may have been destroyed since, the registry must be laid out again before its
+		// entries are read
+
+		if (!_bvhDirty)
+		{
+			_bvhDirty = _hasHierarchyChanged();
+		}
+
+		// Compute the local matrices of the drawables that moved several at a time, before the hierarchies request them
+
+		if (!_bvhDirty)
+		{
+			TransformBatch::updateMatrices(_registry._drawables.data(), _registry.getSize());
+		}
+
+		_drawablesChanged = _bvhDirty;
+
+		// Update the world transforms and bounding boxes of the hierarchies, and refit the roots whose bounds changed
+
+		if (!_bvhDirty)
+		{
+			for (std::pair<const Drawable* const, BvhLeaf>& leaf : _bvhLeaves)
+			{
+				leaf.first->_updateWorldBoundingBox();
+
+				if (!leaf.first->_hasWorldBoundingBox)
+				{
+					_bvhDirty = true;
 				}
-				case ShaderType::ShadowMapping:
+				else if (leaf.first->_worldBoundingBoxVersion != leaf.second.boundingBoxVersion)
 				{
-					using TKey = std::pair<const spl::ShaderProgram*, const shaderInterface::InterfaceShadow*>;
+					_bvh.refit(leaf.second.leaf, leaf.first->_worldBoundingBoxMin, leaf.first->_worldBoundingBoxMax);
 
-					TKey key;
-					if (drawableShaderSet)
-					{
-						key.first = drawableShaderSet->_shaderShadow;
-						key.second = &drawableShaderSet->_interfaceShadow;
-					}
-					else
+					leaf.second.boundingBoxVersion = leaf.first->_worldBoundingBoxVersion;
+					_bvhRefit = true;
+					_drawablesChanged = true;
+				}
+			}
+
+			for (const Drawable* drawable : _unboundedDrawables)
+			{
+				drawable->_updateWorldBoundingBox();
+				_bvhDirty |= drawable->_hasWorldBoundingBox;
+			}
+		}
+
+		// Copy what changed into the registry, a group whose children changed needs the registry laid out again
+
+		if (!_bvhDirty)
+		{
+			_bvhDirty = _syncRegistry();
+		}
+
+		_drawablesChanged |= _bvhDirty;
+
+		// Drawables were added or removed, or a group gained or lost its bounds or children
+
+		if (_bvhDirty)
+		{
+			std::vector<const Drawable*> drawables;
+			std::vector<uint32_t> subtreeEnds;
+			for (const Drawable* drawable : _drawables)
+			{
+				_appendToRegistry(drawable, drawables, subtreeEnds);
+			}
+
+			_registry.assign(drawables.data(), drawables.size());
+
+			for (uint32_t i = 0; i < drawables.size(); ++i)
+			{
+				_registry._subtreeEnds[i] = subtreeEnds[i];
+
+				switch (drawables[i]->getType())
+				{
+					case DrawableType::Group:
+						_registry._flags[i] = DrawableRegistry::flagGroup;
+						break;
+					case DrawableType::Mesh:
+						_registry._flags[i] = DrawableRegistry::flagMesh;
+						break;
+					default:
+						break;
+				}
+			}
+
+			TransformBatch::updateMatrices(_registry._drawables.data(), _registry.getSize());
+
+			_bvh.clear();
+			_bvhLeaves.clear();
+			_unboundedDrawables.clear();
+
+			for (const Drawable* drawable : _drawables)
+			{
+				_registerInBvh(drawable);
+			}
+
+			_bvh.rebuild();
+
+			_syncRegistry();
+			_gpuDrawablesDirty = true;
+
+			_bvhDirty = false;
+			_bvhRefit = false;
+			_bvhFramesSinceRebuild = 0;
+
+			return;
+		}
+
+		// Refitting keeps the topology of the tree, which gets worse as the roots move away from where they were inserted
+
+		++_bvhFramesSinceRebuild;
+		if (_bvhRefit && _bvhFramesSinceRebuild >= _params.bvhRebuildPeriod)
+		{
+			_bvh.rebuild();
+
+			_bvhRefit = false;
+			_bvhFramesSinceRebuild = 0;
+			_drawablesChanged = true;
+		}
+	}
+
+	void Scene::_appendToRegistry(const Drawable* drawable, std::vector<const Drawable*>& drawables, std::vector<uint32_t>& subtreeEnds) const
+	{
+		// Depth-first, so that the descendants of an entry directly follow it
+
+		const uint32_t index = drawables.size();
+		drawables.push_back(drawable);
+		subtreeEnds.push_back(0);
+
+		if (drawable->getType() == DrawableType::Group)
+		{
+			const DrawableGroup* group = static_cast<const DrawableGroup*>(drawable);
+
+			uint32_t childCount = group->getChildCount();
+			for (uint32_t i = 0; i < childCount; ++i)
+			{
+				_appendToRegistry(group->getChild(i), drawables, subtreeEnds);
+			}
+		}
+
+		subtreeEnds[index] = drawables.size();
+	}
+
+	bool Scene::_hasHierarchyChanged() const
+	{
+		// Only the groups are read, and a group comes before its children: the first group whose children changed is
+		// found before any of the entries it lost
+
+		const uint32_t size = _registry.getSize();
+		for (uint32_t i = 0; i < size; ++i)
+		{
+			if (!(_registry._flags[i] & DrawableRegistry::flagGroup))
+			{
+				continue;
+			}
+
+			const DrawableGroup* group = static_cast<const DrawableGroup*>(_registry._drawables[i]);
+			if (_registry._hierarchyVersions[i] != UINT32_MAX && group->_hierarchyVersion != _registry._hierarchyVersions[i])
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool Scene::_syncRegistry()
+	{
+		// Most entries only compare their versions, their data is copied when the drawable changed
+
+		bool stateChanged = false;
+
+		const uint32_t size = _registry.getSize();
+		for (uint32_t i = 0; i < size; ++i)
+		{
+			const Drawable* drawable = _registry._drawables[i];
+			uint32_t& flags = _registry._flags[i];
+
+			if (drawable->_worldBoundingBoxVersion != _registry._boundingBoxVersions[i])
+			{
+				_registry._boundingBoxMins[i] = drawable->_worldBoundingBoxMin;
+				_registry._boundingBoxMaxs[i] = drawable->_worldBoundingBoxMax;
+				_registry._boundingBoxVersions[i] = drawable->_worldBoundingBoxVersion;
+
+				if (drawable->_hasWorldBoundingBox)
+				{
+					flags |= DrawableRegistry::flagBounded;
+				}
+				else
+				{
+					flags &= ~DrawableRegistry::flagBounded;
+				}
+			}
+
+			if (flags & DrawableRegistry::flagGroup)
+			{
+				const DrawableGroup* group = static_cast<const DrawableGroup*>(drawable);
+
+				if (group->_hierarchyVersion != _registry._hierarchyVersions[i])
+				{
+					if (_registry._hierarchyVersions[i] != UINT32_MAX)
 					{
-						key.first = _shaderMap.find(drawableType)->second[index]._shaderShadow;
-						key.second = &_shaderMap.find(drawableType)->second[index]._interfaceShadow;
+						return true;
 					}
 
-					std::multimap<TKey, const Drawable*>& drawSequence = *reinterpret_cast<std::multimap<TKey, const Drawable*>*>(pDrawSequence);
-					drawSequence.insert({ key, drawable });
-
-					break;
+					_registry._hierarchyVersions[i] = group->_hierarchyVersion;
 				}
-				case ShaderType::Transparency:
+
+				continue;
+			}
+
+			if (drawable->_worldTransformVersion != _registry._transformVersions[i])
+			{
+				_registry._transforms[i] = drawable->_worldTransform;
+				_registry._invTransforms[i] = drawable->_invWorldTransform;
+				_registry._transformVersions[i] = drawable->_worldTransformVersion;
+			}
+
+			if (drawable->_stateVersion != _registry._stateVersions[i])
+			{
+				_registry._stateVersions[i] = drawable->_stateVersion;
+				_registry._shaderSets[i] = drawable->getShaderSet();
+
+				const auto it = _shaderLibrary->shaderMap.find(drawable->getType());
+				_registry._defaultShaderSets[i] = (it != _shaderLibrary->shaderMap.end() && !it->second.empty()) ? it->second.data() : nullptr;
+
+				if (flags & DrawableRegistry::flagMesh)
 				{
-					using TKey = std::pair<const spl::ShaderProgram*, const shaderInterface::InterfaceTransparency*>;
+					const MeshBase* mesh = static_cast<const MeshBase*>(drawable);
+					_registry._shaderVariants[i] = ((mesh->getNormalMap() != nullptr) << 2) | (mesh->_compactVertices << 3);
 
-					TKey key;
-					if (drawableShaderSet)
+					if (mesh->isOccluder())
 					{
-						key.first = drawableShaderSet->_shaderTransparency;
-						key.second = &drawableShaderSet->_interfaceTransparency;
+						flags |= DrawableRegistry::flagOccluder;
 					}
 					else
 					{
-						key.first = _shaderMap.find(drawableType)->second[index]._shaderTransparency;
-						key.second = &_shaderMap.find(drawableType)->second[index]._interfaceTransparency;
+						flags &= ~DrawableRegistry::flagOccluder;
 					}
+				}
+
+				stateChanged = true;
+			}
+		}
 
-					std::multimap<TKey, const Drawable*>& drawSequence = *reinterpret_cast<std::multimap<TKey, const Drawable*>*>(pDrawSequence);
-					drawSequence.insert({ key, drawable });
+		// The material table is rebuilt when a drawable changed, so that it never holds a material no longer used
 
-					break;
-				}
-				default:
+		if (stateChanged)
+		{
+			_registry._clearMaterials();
+
+			for (uint32_t i = 0; i < size; ++i)
+			{
+				if (!(_registry._flags[i] & DrawableRegistry::flagGroup))
 				{
-					assert(false);
-					break;
+					_registry._materialIndices[i] = _registry._getMaterialIndex(_registry._drawables[i]->getMaterial());
 				}
 			}
+
+			// A custom shader set may have been added or removed
+
+			_gpuDrawablesDirty = true;
+			_drawablesChanged = true;
+		}
+
+		// Materials can be edited at any time, their versions are compared each frame
+
+		for (uint32_t i = 0; i < _registry._materials.size(); ++i)
+		{
+			const Material* material = _registry._materials[i];
+			if (material->_version != _registry._materialVersions[i])
+			{
+				_registry._materialVariants[i] = (material->getColorTexture() != nullptr) | ((material->getPropertiesTexture() != nullptr) << 1);
+				_registry._materialVersions[i] = material->_version;
+
+				_materialsDirty = true;
+				_drawablesChanged = true;
+			}
 		}
+
+		return false;
 	}
-	
-	void Scene::_setDrawableUniforms(const spl::ShaderProgram* shader, const shaderInterface::SubInterfaceDrawable* interface, const Drawable* drawable)
+
+	void Scene::_collectDrawables(const Frustum& frustum, FrameVector<uint32_t>& entries) const
 	{
-		const Material* material = drawable->getMaterial();
+		entries.clear();
 
-		if (interface->color == spl::GlslType::Sampler2d)
+		if (!_params.frustumCullingEnabled)
 		{
-			assert(material->getColorTexture());
-			shader->setUniform("u_drawableColor", 0, material->getColorTexture());
+			for (uint32_t i = 0; i < _registry.getSize(); ++i)
+			{
+				if (!(_registry._flags[i] & DrawableRegistry::flagGroup))
+				{
+					entries.push_back(i);
+				}
+			}
+
+			return;
 		}
-		else if (interface->color == spl::GlslType::FloatVec4)
+
+		thread_local static std::vector<const Drawable*> roots;
+
+		_bvh.queryFrustum(frustum, roots);
+		roots.insert(roots.end(), _unboundedDrawables.begin(), _unboundedDrawables.end());
+
+		for (const Drawable* root : roots)
 		{
-			shader->setUniform("u_drawableColor", material->getColor());
+			_collectEntries(_registry.getIndex(_registry.getHandle(root)), [&](const scp::f32vec3& min, const scp::f32vec3& max) {
+				return frustum.intersectsBox(min, max);
+			}, entries);
 		}
+	}
+
+	template<typename TOverlap, typename TEntries>
+	void Scene::_collectEntries(uint32_t root, const TOverlap& overlaps, TEntries& entries) const
+	{
+		// One test skips a whole group with its descendants, entries without bounds are always kept
 
-		if (interface->material == spl::GlslType::Sampler2d)
+		const uint32_t end = _registry._subtreeEnds[root];
+		for (uint32_t i = root; i < end;)
 		{
-			assert(material->getPropertiesTexture());
-			shader->setUniform("u_drawableMaterial", 1, material->getPropertiesTexture());
+			const uint32_t flags = _registry._flags[i];
+
+			if ((flags & DrawableRegistry::flagBounded) && !overlaps(_registry._boundingBoxMins[i], _registry._boundingBoxMaxs[i]))
+			{
+				i = _registry._subtreeEnds[i];
+				continue;
+			}
+
+			if (!(flags & DrawableRegistry::flagGroup))
+			{
+				entries.push_back(i);
+			}
+
+			++i;
+		}
+	}
+
+	template<typename TOverlap>
+	void Scene::_queryEntries(const std::vector<const Drawable*>& roots, const TOverlap& overlaps, std::vector<const Drawable*>& drawables) const
+	{
+		thread_local static std::vector<uint32_t> entries;
+		entries.clear();
+
+		for (const Drawable* root : roots)
+		{
+			_collectEntries(_registry.getIndex(_registry.getHandle(root)), overlaps, entries);
 		}
-		else if (interface->material == spl::GlslType::FloatVec3)
+
+		// Groups without bounds may still contain meshes that match
+
+		for (const Drawable* root : _unboundedDrawables)
 		{
-			shader->setUniform("u_drawableMaterial", material->getProperties());
+			_collectEntries(_registry.getIndex(_registry.getHandle(root)), overlaps, entries);
 		}
 
-		switch (drawable->getType())
+		drawables.clear();
+		for (const uint32_t entry : entries)
 		{
-			case DrawableType::Mesh:
+			if (_registry._flags[entry] & DrawableRegistry::flagBounded)
 			{
-				const Mesh<>& mesh = *dynamic_cast<const Mesh<>*>(drawable);
+				drawables.push_back(_registry._drawables[entry]);
+			}
+		}
+	}
 
-				if (interface->normal == spl::GlslType::Sampler2d)
-				{
-					assert(mesh.getNormalMap());
-					shader->setUniform("u_drawableNormal", 2, mesh.getNormalMap());
-				}
+	void Scene::_setDrawableUniforms(CommandBuffer& commands, const shaderInterface::SubInterfaceDrawable* interface, const FramePacket& packet, const FrameDraw& draw) const
+	{
+		// Colors and properties are read from the material table, only the textures are bound. Pooled textures bind
+		// the same texture array for many materials, the command buffer skips those that are already set.
 
-				break;
-			}
-			default:
-			{
-				break;
-			}
+		const MaterialTable& table = *packet.materialTable;
+		const Material* material = &table.materials[draw.materialIndex];
+
+		if (interface->color.type == spl::GlslType::Sampler2d)
+		{
+			assert(material->getColorTexture());
+			commands.setUniform(interface->color.location, interface->color.unit, material->getColorTexture());
+		}
+		else if (interface->color.type == spl::GlslType::Sampler2dArray)
+		{
+			assert(table.textureArrayIndices[draw.materialIndex].x != UINT32_MAX);
+			commands.setUniform(interface->color.location, interface->color.unit, _materialTextureArrays[table.textureArrayIndices[draw.materialIndex].x]);
+		}
+
+		if (interface->material.type == spl::GlslType::Sampler2d)
+		{
+			assert(material->getPropertiesTexture());
+			commands.setUniform(interface->material.location, interface->material.unit, material->getPropertiesTexture());
+		}
+		else if (interface->material.type == spl::GlslType::Sampler2dArray)
+		{
+			assert(table.textureArrayIndices[draw.materialIndex].y != UINT32_MAX);
+			commands.setUniform(interface->material.location, interface->material.unit, _materialTextureArrays[table.textureArrayIndices[draw.materialIndex].y]);
+		}
+
+		if (interface->normal.type == spl::GlslType::Sampler2d)
+		{
+			assert(draw.normalMap);
+			commands.setUniform(interface->normal.location, interface->normal.unit, draw.normalMap);
 		}
 	}
 
-	void Scene::_setGBufferResultUniforms(const spl::ShaderProgram* shader, const shaderInterface::SubInterfaceGBufferResult* interface)
+	void Scene::_setGBufferResultUniforms(CommandBuffer& commands, const shaderInterface::SubInterfaceGBufferResult* interface) const
 	{
-		if (interface->depth == spl::GlslType::Sampler2d)
+		if (interface->depth.type == spl::GlslType::Sampler2d)
 		{
-			shader->setUniform("u_gBufferDepth", 3, &getDepthTexture());
+			commands.setUniform(interface->depth.location, interface->depth.unit, &getDepthTexture());
 		}
 
-		if (interface->color == spl::GlslType::Sampler2d)
+		if (interface->color.type == spl::GlslType::Sampler2d)
 		{
-			shader->setUniform("u_gBufferColor", 4, &getColorTexture());
+			commands.setUniform(interface->color.location, interface->color.unit, &getColorTexture());
 		}
 
-		if (interface->material == spl::GlslType::Sampler2d)
+		if (interface->material.type == spl::GlslType::Sampler2d)
 		{
-			shader->setUniform("u_gBufferMaterial", 5, &getMaterialTexture());
+			commands.setUniform(interface->material.location, interface->material.unit, &getMaterialTexture());
 		}
 
-		if (interface->normal == spl::GlslType::Sampler2d)
+		if (interface->normal.type == spl::GlslType::Sampler2d)
 		{
-			shader->setUniform("u_gBufferNormal", 6, &getNormalTexture());
+			commands.setUniform(interface->normal.location, interface->normal.unit, &getNormalTexture());
 		}
 
-		if (interface->tangent == spl::GlslType::Sampler2d)
+		if (interface->tangent.type == spl::GlslType::Sampler2d)
 		{
-			shader->setUniform("u_gBufferTangent", 7, &getTangentTexture());
+			commands.setUniform(interface->tangent.location, interface->tangent.unit, &getTangentTexture());
 		}
 	}
 
-	void Scene::_setShadowResultUniforms(const spl::ShaderProgram* shader, const shaderInterface::SubInterfaceShadowResult* interface)
+	void Scene::_setShadowResultUniforms(CommandBuffer& commands, const shaderInterface::SubInterfaceShadowResult* interface) const
 	{
-		if (interface->texture == spl::GlslType::Sampler2dArrayShadow)
+		if (interface->texture.type == spl::GlslType::Sampler2dArrayShadow)
 		{
-			shader->setUniform("u_shadowTexture", 8, &getShadowTexture());
+			commands.setUniform(interface->texture.location, interface->texture.unit, &getShadowTexture());
 		}
 
-		if (interface->offset == spl::GlslType::FloatVec3)
+		if (interface->offset.type == spl::GlslType::FloatVec3)
 		{
-			shader->setUniform("u_shadowOffset", scp::f32vec3(1.f / _params.shadowTextureResolution.x, 1.f / _params.shadowTextureResolution.y, 1e-4f));
+			commands.setUniform(interface->offset.location, scp::f32vec3(1.f / _params.shadowTextureResolution.x, 1.f / _params.shadowTextureResolution.y, 1e-4f));
 		}
 	}
 
-	void Scene::_setTransparencyResultUniforms(const spl::ShaderProgram* shader, const shaderInterface::SubInterfaceTransparencyResult* interface)
+	void Scene::_setTransparencyResultUniforms(CommandBuffer& commands, const shaderInterface::SubInterfaceTransparencyResult* interface) const
 	{
-		if (interface->color == spl::GlslType::Sampler2d)
+		if (interface->color.type == spl::GlslType::Sampler2d)
 		{
-			shader->setUniform("u_transparencyColor", 9, &getTransparencyColorTexture());
+			commands.setUniform(interface->color.location, interface->color.unit, &getTransparencyColorTexture());
 		}
 
-		if (interface->counter == spl::GlslType::Sampler2d)
+		if (interface->counter.type == spl::GlslType::Sampler2d)
 		{
-			shader->setUniform("u_transparencyCounter", 10, &getTransparencyCounterTexture());
+			commands.setUniform(interface->counter.location, interface->counter.unit, &getTransparencyCounterTexture());
 		}
 	}
 
-	void Scene::_setSsaoResultUniforms(const spl::ShaderProgram* shader, const shaderInterface::SubInterfaceSsaoResult* interface)
+	void Scene::_setSsaoResultUniforms(CommandBuffer& commands, const shaderInterface::SubInterfaceSsaoResult* interface) const
 	{
-		if (interface->texture == spl::GlslType::Sampler2d)
+		if (interface->texture.type == spl::GlslType::Sampler2d)
 		{
-			shader->setUniform("u_ssaoTexture", 11, &getSsaoTexture());
+			commands.setUniform(interface->texture.location, interface->texture.unit, &getSsaoTexture());
 		}
 	}
 }
@@ -11,53 +11,138 @@ namespace lys
 {
 	namespace
 	{
-		const std::unordered_map<std::string, intptr_t> offsetsGBuffer = {
-			{ "u_drawableColor",		offsetof(shaderInterface::InterfaceGBuffer, u_drawable.color) },
-			{ "u_drawableMaterial",		offsetof(shaderInterface::InterfaceGBuffer, u_drawable.material) },
-			{ "u_drawableNormal",		offsetof(shaderInterface::InterfaceGBuffer, u_drawable.normal) }
+		// Offset of each uniform in its interface, and the texture unit it is given if it is a sampler
+
+		const std::unordered_map<std::string, std::pair<intptr_t, uint32_t>> slotsGBuffer = {
+			{ "u_drawableColor",		{ offsetof(shaderInterface::InterfaceGBuffer, u_drawable.color), 0 } },
+			{ "u_drawableMaterial",		{ offsetof(shaderInterface::InterfaceGBuffer, u_drawable.material), 1 } },
+			{ "u_drawableNormal",		{ offsetof(shaderInterface::InterfaceGBuffer, u_drawable.normal), 2 } }
+		};
+
+		const std::unordered_map<std::string, std::pair<intptr_t, uint32_t>> slotsShadow = {
+			{ "u_drawableColor",		{ offsetof(shaderInterface::InterfaceShadow, u_drawable.color), 0 } },
+			{ "u_drawableMaterial",		{ offsetof(shaderInterface::InterfaceShadow, u_drawable.material), 1 } },
+			{ "u_drawableNormal",		{ offsetof(shaderInterface::InterfaceShadow, u_drawable.normal), 2 } },
+			{ "u_gBufferDepth",			{ offsetof(shaderInterface::InterfaceShadow, u_gBuffer.depth), 3 } },
+			{ "u_gBufferColor",			{ offsetof(shaderInterface::InterfaceShadow, u_gBuffer.color), 4 } },
+			{ "u_gBufferMaterial",		{ offsetof(shaderInterface::InterfaceShadow, u_gBuffer.material), 5 } },
+			{ "u_gBufferNormal",		{ offsetof(shaderInterface::InterfaceShadow, u_gBuffer.normal), 6 } },
+			{ "u_gBufferTangent",		{ offsetof(shaderInterface::InterfaceShadow, u_gBuffer.tangent), 7 } }
+		};
+
+		const std::unordered_map<std::string, std::pair<intptr_t, uint32_t>> slotsTransparency = {
+			{ "u_drawableColor",		{ offsetof(shaderInterface::InterfaceTransparency, u_drawable.color), 0 } },
+			{ "u_drawableMaterial",		{ offsetof(shaderInterface::InterfaceTransparency, u_drawable.material), 1 } },
+			{ "u_drawableNormal",		{ offsetof(shaderInterface::InterfaceTransparency, u_drawable.normal), 2 } },
+			{ "u_gBufferDepth",			{ offsetof(shaderInterface::InterfaceTransparency, u_gBuffer.depth), 3 } },
+			{ "u_gBufferColor",			{ offsetof(shaderInterface::InterfaceTransparency, u_gBuffer.color), 4 } },
+			{ "u_gBufferMaterial",		{ offsetof(shaderInterface::InterfaceTransparency, u_gBuffer.material), 5 } },
+			{ "u_gBufferNormal",		{ offsetof(shaderInterface::InterfaceTransparency, u_gBuffer.normal), 6 } },
+			{ "u_gBufferTangent",		{ offsetof(shaderInterface::InterfaceTransparency, u_gBuffer.tangent), 7 } },
+			{ "u_shadowTexture",		{ offsetof(shaderInterface::InterfaceTransparency, u_shadow.texture), 8 } },
+			{ "u_shadowOffset",			{ offsetof(shaderInterface::InterfaceTransparency, u_shadow.offset), 0 } }
 		};
 
-		const std::unordered_map<std::string, intptr_t> offsetsShadow = {
-			{ "u_drawableColor",		offsetof(shaderInterface::InterfaceShadow, u_drawable.color) },
-			{ "u_drawableMaterial",		offsetof(shaderInterface::InterfaceShadow, u_drawable.material) },
-			{ "u_drawableNormal",		offsetof(shaderInterface::InterfaceShadow, u_drawable.normal) },
-			{ "u_gBufferDepth",			offsetof(shaderInterface::InterfaceShadow, u_gBuffer.depth) },
-			{ "u_gBufferColor",			offsetof(shaderInterface::InterfaceShadow, u_gBuffer.color) },
-			{ "u_gBufferMaterial",		offsetof(shaderInterface::InterfaceShadow, u_gBuffer.material) },
-			{ "u_gBufferNormal",		offsetof(shaderInterface::InterfaceShadow, u_gBuffer.normal) },
-			{ "u_gBufferTangent",		offsetof(shaderInterface::InterfaceShadow, u_gBuffer.tangent) }
+		const std::unordered_map<std::string, std::pair<intptr_t, uint32_t>> slotsSsao = {
+			{ "u_gBufferDepth",			{ offsetof(shaderInterface::InterfaceSsao, u_gBuffer.depth), 3 } },
+			{ "u_gBufferColor",			{ offsetof(shaderInterface::InterfaceSsao, u_gBuffer.color), 4 } },
+			{ "u_gBufferMaterial",		{ offsetof(shaderInterface::InterfaceSsao, u_gBuffer.material), 5 } },
+			{ "u_gBufferNormal",		{ offsetof(shaderInterface::InterfaceSsao, u_gBuffer.normal), 6 } },
+			{ "u_gBufferTangent",		{ offsetof(shaderInterface::InterfaceSsao, u_gBuffer.tangent), 7 } },
+			{ "u_sampleCount",			{ offsetof(shaderInterface::InterfaceSsao, u_sampleCount), 0 } },
+			{ "u_scaleStep",			{ offsetof(shaderInterface::InterfaceSsao, u_scaleStep), 0 } },
+			{ "u_tanHalfFov",			{ offsetof(shaderInterface::InterfaceSsao, u_tanHalfFov), 0 } },
+			{ "u_twoTanHalfFov",		{ offsetof(shaderInterface::InterfaceSsao, u_twoTanHalfFov), 0 } },
+			{ "u_resolution",			{ offsetof(shaderInterface::InterfaceSsao, u_resolution), 0 } }
 		};
 
-		const std::unordered_map<std::string, intptr_t> offsetsTransparency = {
-			{ "u_drawableColor",		offsetof(shaderInterface::InterfaceTransparency, u_drawable.color) },
-			{ "u_drawableMaterial",		offsetof(shaderInterface::InterfaceTransparency, u_drawable.material) },
-			{ "u_drawableNormal",		offsetof(shaderInterface::InterfaceTransparency, u_drawable.normal) },
-			{ "u_gBufferDepth",			offsetof(shaderInterface::InterfaceTransparency, u_gBuffer.depth) },
-			{ "u_gBufferColor",			offsetof(shaderInterface::InterfaceTransparency, u_gBuffer.color) },
-			{ "u_gBufferMaterial",		offsetof(shaderInterface::InterfaceTransparency, u_gBuffer.material) },
-			{ "u_gBufferNormal",		offsetof(shaderInterface::InterfaceTransparency, u_gBuffer.normal) },
-			{ "u_gBufferTangent",		offsetof(shaderInterface::InterfaceTransparency, u_gBuffer.tangent) },
-			{ "u_shadowTexture",		offsetof(shaderInterface::InterfaceTransparency, u_shadow.texture) },
-			{ "u_shadowOffset",			offsetof(shaderInterface::InterfaceTransparency, u_shadow.offset) }
+		const std::unordered_map<std::string, std::pair<intptr_t, uint32_t>> slotsMerge = {
+			{ "u_gBufferDepth",			{ offsetof(shaderInterface::InterfaceMerge, u_gBuffer.depth), 3 } },
+			{ "u_gBufferColor",			{ offsetof(shaderInterface::InterfaceMerge, u_gBuffer.color), 4 } },
+			{ "u_gBufferMaterial",		{ offsetof(shaderInterface::InterfaceMerge, u_gBuffer.material), 5 } },
+			{ "u_gBufferNormal",		{ offsetof(shaderInterface::InterfaceMerge, u_gBuffer.normal), 6 } },
+			{ "u_gBufferTangent",		{ offsetof(shaderInterface::InterfaceMerge, u_gBuffer.tangent), 7 } },
+			{ "u_shadowTexture",		{ offsetof(shaderInterface::InterfaceMerge, u_shadow.texture), 8 } },
+			{ "u_shadowOffset",			{ offsetof(shaderInterface::InterfaceMerge, u_shadow.offset), 0 } },
+			{ "u_transparencyColor",	{ offsetof(shaderInterface::InterfaceMerge, u_transparency.color), 9 } },
+			{ "u_transparencyCounter",	{ offsetof(shaderInterface::InterfaceMerge, u_transparency.counter), 10 } },
+			{ "u_ssaoTexture",			{ offsetof(shaderInterface::InterfaceMerge, u_ssao.texture), 11 } },
+			{ "u_background",			{ offsetof(shaderInterface::InterfaceMerge, u_background), 12 } },
+			{ "u_twoTanHalfFov",		{ offsetof(shaderInterface::InterfaceMerge, u_twoTanHalfFov), 0 } }
 		};
 	}
 
 	ShaderSet::ShaderSet(const spl::ShaderProgram* shaderGBuffer, const spl::ShaderProgram* shaderShadow, const spl::ShaderProgram* shaderTransparency) :
-		_shaderGBuffer(shaderGBuffer),
-		_shaderShadow(shaderShadow),
-		_shaderTransparency(shaderTransparency),
+		_shaderGBuffer(nullptr),
+		_shaderShadow(nullptr),
+		_shaderTransparency(nullptr),
 		_interfaceGBuffer(),
 		_interfaceShadow(),
 		_interfaceTransparency()
 	{
-		fillInterface(_shaderGBuffer, offsetsGBuffer, &_interfaceGBuffer);
-		fillInterface(_shaderShadow, offsetsShadow, &_interfaceShadow);
-		fillInterface(_shaderTransparency, offsetsTransparency, &_interfaceTransparency);
+		_setShader(ShaderType::GBuffer, shaderGBuffer);
+		_setShader(ShaderType::ShadowMapping, shaderShadow);
+		_setShader(ShaderType::Transparency, shaderTransparency);
 
 		// TODO: Per-interface function to check: uniform types, uniform blocks, inputs and outputs (va/fo), etc...
 	}
 
-	void ShaderSet::fillInterface(const spl::ShaderProgram* shader, const std::unordered_map<std::string, intptr_t>& offsets, void* pInterface)
+	const spl::ShaderProgram* ShaderSet::_getShader(ShaderType shaderType) const
+	{
+		switch (shaderType)
+		{
+			case ShaderType::GBuffer:
+				return _shaderGBuffer;
+			case ShaderType::ShadowMapping:
+				return _shaderShadow;
+			case ShaderType::Transparency:
+				return _shaderTransparency;
+			default:
+				assert(false);
+				return nullptr;
+		}
+	}
+
+	void ShaderSet::_setShader(ShaderType shaderType, const spl::ShaderProgram* shader)
+	{
+		if (!shader)
+		{
+			return;
+		}
+
+		switch (shaderType)
+		{
+			case ShaderType::GBuffer:
+				_shaderGBuffer = shader;
+				fillInterface(_shaderGBuffer, slotsGBuffer, &_interfaceGBuffer);
+				_interfaceGBuffer.vertexInputMask = getVertexInputMask(_shaderGBuffer);
+				break;
+			case ShaderType::ShadowMapping:
+				_shaderShadow = shader;
+				fillInterface(_shaderShadow, slotsShadow, &_interfaceShadow);
+				_interfaceShadow.vertexInputMask = getVertexInputMask(_shaderShadow);
+				break;
+			case ShaderType::Transparency:
+				_shaderTransparency = shader;
+				fillInterface(_shaderTransparency, slotsTransparency, &_interfaceTransparency);
+				_interfaceTransparency.vertexInputMask = getVertexInputMask(_shaderTransparency);
+				break;
+			default:
+				assert(false);
+		}
+	}
+
+	void ShaderSet::fillInterface(const spl::ShaderProgram* shader, shaderInterface::InterfaceSsao& interface)
+	{
+		fillInterface(shader, slotsSsao, &interface);
+	}
+
+	void ShaderSet::fillInterface(const spl::ShaderProgram* shader, shaderInterface::InterfaceMerge& interface)
+	{
+		fillInterface(shader, slotsMerge, &interface);
+	}
+
+	void ShaderSet::fillInterface(const spl::ShaderProgram* shader, const std::unordered_map<std::string, std::pair<intptr_t, uint32_t>>& slots, void* pInterface)
 	{
 		const spl::ShaderProgramInterfaceInfos& interfaceInfos = shader->getInterfaceInfos(spl::ShaderProgramInterface::Uniform);
 		char* pcInterface = reinterpret_cast<char*>(pInterface);
@@ -66,11 +151,34 @@ namespace lys
 		{
 			const spl::ShaderProgramResourceInfos& resourceInfos = shader->getResourceInfos(spl::ShaderProgramInterface::Uniform, i);
 
-			auto it = offsets.find(resourceInfos.name.c_str());
-			if (it != offsets.end())
+			auto it = slots.find(resourceInfos.name.c_str());
+			if (it != slots.end())
+			{
+				shaderInterface::Uniform& uniform = *reinterpret_cast<shaderInterface::Uniform*>(pcInterface + it->second.first);
+				uniform.type = resourceInfos.type;
+				uniform.location = resourceInfos.location;
+				uniform.unit = it->second.second;
+			}
+		}
+	}
+
+	uint32_t ShaderSet::getVertexInputMask(const spl::ShaderProgram* shader)
+	{
+		const spl::ShaderProgramInterfaceInfos& interfaceInfos = shader->getInterfaceInfos(spl::ShaderProgramInterface::ProgramInput);
+
+		uint32_t mask = 0;
+		for (int32_t i = 0; i < interfaceInfos.activeResources; ++i)
+		{
+			const spl::ShaderProgramResourceInfos& resourceInfos = shader->getResourceInfos(spl::ShaderProgramInterface::ProgramInput, i);
+
+			// Built-in inputs (gl_VertexID, etc...) have no location
+
+			if (resourceInfos.location >= 0 && resourceInfos.location < 32)
 			{
-				*reinterpret_cast<spl::GlslType*>(pcInterface + it->second) = resourceInfos.type;
+				mask |= 1u << resourceInfos.location;
 			}
 		}
+
+		return mask;
 	}
 }
@@ -1,79 +1,133 @@
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//! \file
-//! \author Reiex
-//! \copyright The MIT License (MIT)
-//! \date 2023
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-// Custom types 
-
-struct CameraData
-{
-	float aspect;
-	float fov;
-	float near;
-	float far;
-
-	vec3 up;
-	vec3 front;
-	vec3 left;
-
-	mat4 view;
-	mat4 invView;
-	mat4 projection;
-	mat4 invProjection;
-	mat4 projectionView;
-	mat4 invProjectionView;
-};
-
-struct LightData
-{
-	uint type;
-	uint shadowMapStartIndex;
-	uint shadowMapStopIndex;
-	vec3 color;
-	vec4 param0;
-	vec4 param1;
-};
-
-struct LightsData
-{
-	uint count;
-	LightData lights[LIGHT_SLOT_COUNT];
-};
-
-struct DrawableData
-{
-	mat4 model;
-	mat4 invModel;
-	mat4 viewModel;
-	mat4 invViewModel;
-	mat4 projectionViewModel;
-	mat4 invProjectionViewModel;
-};
-
-struct ShadowCameraData
-{
-	mat4 projection;
-	mat4 view;
-	float near;
-	float far;
-};
-
-struct ShadowCamerasData
-{
-	uint count;
-	ShadowCameraData cameras[SHADOW_TEXTURE_COUNT];
-};
-
-// Constants
-
-const float c_epsilon = 0.00001;
-const float c_oneMinusEpsilon = 0.99999;
-
-const float c_halfPi = 1.57079632679;
-const float c_pi = 3.14159265359;
-const float c_2pi = 6.28318530718;
-const float c_invHalfPi = 0.63661977236;
-const float c_invPi = 0.31830988618;
-const float c_inv2pi = 0.15915494309;
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Counts, defined by the header, or specialized when the module is loaded from SPIR-V
+
+#ifndef LIGHT_SLOT_COUNT
+layout (constant_id = 0) const uint LIGHT_SLOT_COUNT = 1;
+layout (constant_id = 1) const uint SHADOW_TEXTURE_COUNT = 1;
+#endif
+
+// Custom types
+
+struct CameraData
+{
+	float aspect;
+	float fov;
+	float near;
+	float far;
+
+	vec3 up;
+	vec3 front;
+	vec3 left;
+
+	mat4 view;
+	mat4 invView;
+	mat4 projection;
+	mat4 invProjection;
+	mat4 projectionView;
+	mat4 invProjectionView;
+};
+
+struct LightData
+{
+	uint type;
+	uint shadowMapStartIndex;
+	uint shadowMapStopIndex;
+	vec3 color;
+	vec4 param0;
+	vec4 param1;
+};
+
+struct LightsData
+{
+	uint count;
+	LightData lights[LIGHT_SLOT_COUNT];
+};
+
+struct DrawableData
+{
+	mat4 model;
+	mat4 invModel;
+	mat4 viewModel;
+	mat4 invViewModel;
+	mat4 projectionViewModel;
+	mat4 invProjectionViewModel;
+	vec3 positionOffset;
+	vec3 positionScale;
+	uint materialIndex;
+};
+
+struct MaterialData
+{
+	vec4 color;
+	vec3 properties;
+	int colorLayer;				// Layer of the color texture in its texture array
+	int propertiesLayer;		// Layer of the properties texture in its texture array
+};
+
+struct ShadowCameraData
+{
+	mat4 projection;
+	mat4 view;
+	float near;
+	float far;
+};
+
+struct ShadowCamerasData
+{
+	uint count;
+	ShadowCameraData cameras[SHADOW_TEXTURE_COUNT];
+};
+
+// Constants
+
+const float c_epsilon = 0.00001;
+const float c_oneMinusEpsilon = 0.99999;
+
+const float c_halfPi = 1.57079632679;
+const float c_pi = 3.14159265359;
+const float c_2pi = 6.28318530718;
+const float c_invHalfPi = 0.63661977236;
+const float c_invPi = 0.31830988618;
+const float c_inv2pi = 0.15915494309;
+
+// Compact vertex decoding
+
+vec4 decodeCompactPosition(uvec2 position, vec3 offset, vec3 scale)
+{
+	const vec3 p = vec3(unpackUnorm2x16(position.x), unpackUnorm2x16(position.y).x);
+	return vec4(offset + scale * p, 1.0);
+}
+
+vec4 decodeOctahedralDirection(uint direction)
+{
+	const vec2 e = unpackSnorm2x16(direction);
+	vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+
+	if (v.z < 0.0)
+	{
+		v.xy = (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+	}
+
+	return vec4(normalize(v), 0.0);
+}
+
+vec4 decodeHalfTexCoords(uint texCoords)
+{
+	return vec4(unpackHalf2x16(texCoords), 0.0, 0.0);
+}
+
+// Material textures, pooled in texture arrays with `TEXTURE_ARRAYS`
+
+#ifdef TEXTURE_ARRAYS
+	#define MaterialSampler sampler2DArray
+	#define sampleMaterialTexture(tex, texCoords, layer) texture(tex, vec3(texCoords, float(layer)))
+#else
+	#define MaterialSampler sampler2D
+	#define sampleMaterialTexture(tex, texCoords, layer) texture(tex, texCoords)
+#endif
@@ -0,0 +1,42 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Uniforms
+
+uniform sampler2D u_depth;
+
+// Fragment outputs
+
+layout (location = 0) out float fo_depth;
+
+// Function definitions
+
+void main()
+{
+	// Max of the 2x2 texels of the previous level, extended to 3 on the last row and column of odd sizes
+
+	const ivec2 inputSize = textureSize(u_depth, 0);
+	const ivec2 outputSize = max(inputSize / 2, ivec2(1));
+	const ivec2 texel = ivec2(gl_FragCoord.xy);
+
+	const ivec2 begin = 2 * texel;
+	const ivec2 end = ivec2(
+		texel.x == outputSize.x - 1 ? inputSize.x - 1 : min(begin.x + 1, inputSize.x - 1),
+		texel.y == outputSize.y - 1 ? inputSize.y - 1 : min(begin.y + 1, inputSize.y - 1)
+	);
+
+	float depth = 0.0;
+	for (int y = begin.y; y <= end.y; ++y)
+	{
+		for (int x = begin.x; x <= end.x; ++x)
+		{
+			depth = max(depth, texelFetch(u_depth, ivec2(x, y), 0).r);
+		}
+	}
+
+	fo_depth = depth;
+}
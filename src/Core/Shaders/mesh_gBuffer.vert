@@ -1,51 +1,89 @@
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//! \file
-//! \author Reiex
-//! \copyright The MIT License (MIT)
-//! \date 2023
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-// Vertex attributes
-
-layout (location = 0) in vec4 va_position;
-layout (location = 1) in vec4 va_normal;
-layout (location = 2) in vec4 va_tangent;
-layout (location = 3) in vec4 va_texCoords;
-
-// Uniform blocks
-
-layout (std140, row_major, binding = 0) uniform ubo_camera_layout
-{
-	CameraData ubo_camera;
-};
-
-layout (std140, row_major, binding = 2) uniform ubo_drawable_layout
-{
-	DrawableData ubo_drawable;
-};
-
-// Outputs
-
-out VertexOutput
-{
-	float depth;
-	vec3 normal;
-	vec3 tangent;
-	vec2 texCoords;
-} io_vertexOutput;
-
-// Function definitions
-
-void main()
-{
-	// Compute everything in view-space
-	
-	gl_Position = ubo_drawable.viewModel * va_position;
-
-	io_vertexOutput.depth = 1.0 - (ubo_camera.far + gl_Position.z) / (ubo_camera.far - ubo_camera.near);
-	io_vertexOutput.normal = normalize(ubo_drawable.viewModel * va_normal).xyz;		// TODO: Change that ! Not OK for non-uniform scale !
-	io_vertexOutput.tangent = normalize(ubo_drawable.viewModel * va_tangent).xyz;	// TODO: Change that ! Not OK for non-uniform scale !
-	io_vertexOutput.texCoords = va_texCoords.xy;
-
-	gl_Position = ubo_camera.projection * gl_Position;
-}
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Vertex attributes
+
+#ifdef COMPACT_VERTEX
+	layout (location = 0) in uvec2 va_position;
+	layout (location = 1) in uint va_normal;
+	layout (location = 2) in uint va_tangent;
+	layout (location = 3) in uint va_texCoords;
+#else
+	layout (location = 0) in vec4 va_position;
+	layout (location = 1) in vec4 va_normal;
+	layout (location = 2) in vec4 va_tangent;
+	layout (location = 3) in vec4 va_texCoords;
+#endif
+
+// Uniform blocks
+
+layout (std140, row_major, binding = 0) uniform ubo_camera_layout
+{
+	CameraData ubo_camera;
+};
+
+#ifdef GPU_DRIVEN
+	layout (std430, row_major, binding = 0) readonly buffer ssbo_drawables_layout
+	{
+		DrawableData ssbo_drawables[];
+	};
+#else
+	layout (std140, row_major, binding = 2) uniform ubo_drawable_layout
+	{
+		DrawableData ubo_drawable;
+	};
+#endif
+
+// Outputs
+
+out VertexOutput
+{
+	float depth;
+	vec3 normal;
+	vec3 tangent;
+	vec2 texCoords;
+	flat uint materialIndex;
+} io_vertexOutput;
+
+// Function definitions
+
+void main()
+{
+	// Indirect draws carry the index of the drawable in their base instance
+
+	#ifdef GPU_DRIVEN
+		const DrawableData drawable = ssbo_drawables[gl_BaseInstance];
+	#else
+		const DrawableData drawable = ubo_drawable;
+	#endif
+
+	// Decode vertex attributes
+
+	#ifdef COMPACT_VERTEX
+		const vec4 position = decodeCompactPosition(va_position, drawable.positionOffset, drawable.positionScale);
+		const vec4 normal = decodeOctahedralDirection(va_normal);
+		const vec4 tangent = decodeOctahedralDirection(va_tangent);
+		const vec4 texCoords = decodeHalfTexCoords(va_texCoords);
+	#else
+		const vec4 position = va_position;
+		const vec4 normal = va_normal;
+		const vec4 tangent = va_tangent;
+		const vec4 texCoords = va_texCoords;
+	#endif
+
+	// Compute everything in view-space
+	
+	gl_Position = drawable.viewModel * position;
+
+	io_vertexOutput.depth = 1.0 - (ubo_camera.far + gl_Position.z) / (ubo_camera.far - ubo_camera.near);
+	io_vertexOutput.normal = normalize(drawable.viewModel * normal).xyz;		// TODO: Change that ! Not OK for non-uniform scale !
+	io_vertexOutput.tangent = normalize(drawable.viewModel * tangent).xyz;	// TODO: Change that ! Not OK for non-uniform scale !
+	io_vertexOutput.texCoords = texCoords.xy;
+	io_vertexOutput.materialIndex = drawable.materialIndex;
+
+	gl_Position = ubo_camera.projection * gl_Position;
+}
@@ -1,42 +1,52 @@
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//! \file
-//! \author Reiex
-//! \copyright The MIT License (MIT)
-//! \date 2023
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-// Inputs
-
-in GeometryOutput
-{
-	vec2 texCoords;
-	float depth;
-} io_geometryOutput;
-
-// Uniforms
-
-#ifdef COLOR_TEXTURE
-	uniform sampler2D u_drawableColor;
-#else
-	uniform vec4 u_drawableColor;
-#endif
-
-// Function definitions
-
-void main()
-{
-	// If the fragment has transparency, it doesn't cast any shadow (convenient approximation) thus it is discarded
-
-	#ifdef COLOR_TEXTURE
-		vec4 color = texture(u_drawableColor, io_geometryOutput.texCoords);
-	#else
-		vec4 color = u_drawableColor;
-	#endif
-
-	if (color.a != 1.0)
-	{
-		discard;
-	}
-
-	gl_FragDepth = io_geometryOutput.depth;
-}
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Inputs
+
+in GeometryOutput
+{
+	#ifdef COLOR_TEXTURE
+		vec2 texCoords;
+	#endif
+	float depth;
+	flat uint materialIndex;
+} io_geometryOutput;
+
+// Shader storage blocks
+
+layout (std430, binding = 8) readonly buffer ssbo_materials_layout
+{
+	MaterialData ssbo_materials[];
+};
+
+// Uniforms
+
+#ifdef COLOR_TEXTURE
+	uniform MaterialSampler u_drawableColor;
+#endif
+
+// Function definitions
+
+void main()
+{
+	// If the fragment has transparency, it doesn't cast any shadow (convenient approximation) thus it is discarded
+
+	const MaterialData material = ssbo_materials[io_geometryOutput.materialIndex];
+
+	#ifdef COLOR_TEXTURE
+		vec4 color = sampleMaterialTexture(u_drawableColor, io_geometryOutput.texCoords, material.colorLayer);
+	#else
+		vec4 color = material.color;
+	#endif
+
+	if (color.a != 1.0)
+	{
+		discard;
+	}
+
+	gl_FragDepth = io_geometryOutput.depth;
+}
@@ -1,37 +1,80 @@
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//! \file
-//! \author Reiex
-//! \copyright The MIT License (MIT)
-//! \date 2023
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-// Vertex attributes
-
-layout (location = 0) in vec4 va_position;
-layout (location = 1) in vec4 va_normal;
-layout (location = 2) in vec4 va_tangent;
-layout (location = 3) in vec4 va_texCoords;
-
-// Uniform blocks
-
-layout (std140, row_major, binding = 2) uniform ubo_drawable_layout
-{
-	DrawableData ubo_drawable;
-};
-
-// Outputs
-
-out VertexOutput
-{
-	vec2 texCoords;
-} io_vertexOutput;
-
-// Function definitions
-
-void main()
-{
-	io_vertexOutput.texCoords = va_texCoords.xy;
-
-	// Careful ! It's not view-space but model-space ! View-space will only be computed in geometry shader.
-	gl_Position = ubo_drawable.model * va_position;
-}
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Vertex attributes
+
+#ifdef COMPACT_VERTEX
+	layout (location = 0) in uvec2 va_position;
+#else
+	layout (location = 0) in vec4 va_position;
+#endif
+
+// Texture coordinates are only fetched when needed for alpha testing, so that the pass can read the position stream only
+
+#ifdef COLOR_TEXTURE
+	#ifdef COMPACT_VERTEX
+		layout (location = 3) in uint va_texCoords;
+	#else
+		layout (location = 3) in vec4 va_texCoords;
+	#endif
+#endif
+
+// Uniform blocks
+
+#ifdef GPU_DRIVEN
+	layout (std430, row_major, binding = 0) readonly buffer ssbo_drawables_layout
+	{
+		DrawableData ssbo_drawables[];
+	};
+#else
+	layout (std140, row_major, binding = 2) uniform ubo_drawable_layout
+	{
+		DrawableData ubo_drawable;
+	};
+#endif
+
+// Outputs
+
+out VertexOutput
+{
+	#ifdef COLOR_TEXTURE
+		vec2 texCoords;
+	#endif
+	flat uint materialIndex;
+} io_vertexOutput;
+
+// Function definitions
+
+void main()
+{
+	// Indirect draws carry the index of the drawable in their base instance
+
+	#ifdef GPU_DRIVEN
+		const DrawableData drawable = ssbo_drawables[gl_BaseInstance];
+	#else
+		const DrawableData drawable = ubo_drawable;
+	#endif
+
+	io_vertexOutput.materialIndex = drawable.materialIndex;
+
+	#ifdef COLOR_TEXTURE
+		#ifdef COMPACT_VERTEX
+			io_vertexOutput.texCoords = decodeHalfTexCoords(va_texCoords).xy;
+		#else
+			io_vertexOutput.texCoords = va_texCoords.xy;
+		#endif
+	#endif
+
+	#ifdef COMPACT_VERTEX
+		const vec4 position = decodeCompactPosition(va_position, drawable.positionOffset, drawable.positionScale);
+	#else
+		const vec4 position = va_position;
+	#endif
+
+	// Careful ! It's not view-space but model-space ! View-space will only be computed in geometry shader.
+	gl_Position = drawable.model * position;
+}
@@ -22,7 +22,19 @@ static constexpr char common_glsl[] = {
 	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
 	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
 	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x0a, 
-	0x0a, 0x2f, 0x2f, 0x20, 0x43, 0x75, 0x73, 0x74, 0x6f, 0x6d, 0x20, 0x74, 0x79, 0x70, 0x65, 0x73, 0x20, 0x0a, 0x0a, 0x73, 
+	0x0a, 0x2f, 0x2f, 0x20, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x73, 0x2c, 0x20, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x65, 0x64, 0x20, 
+	0x62, 0x79, 0x20, 0x74, 0x68, 0x65, 0x20, 0x68, 0x65, 0x61, 0x64, 0x65, 0x72, 0x2c, 0x20, 0x6f, 0x72, 0x20, 0x73, 0x70, 
+	0x65, 0x63, 0x69, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x64, 0x20, 0x77, 0x68, 0x65, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6d, 
+	0x6f, 0x64, 0x75, 0x6c, 0x65, 0x20, 0x69, 0x73, 0x20, 0x6c, 0x6f, 0x61, 0x64, 0x65, 0x64, 0x20, 0x66, 0x72, 0x6f, 0x6d, 
+	0x20, 0x53, 0x50, 0x49, 0x52, 0x2d, 0x56, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x6e, 0x64, 0x65, 0x66, 0x20, 0x4c, 0x49, 0x47, 
+	0x48, 0x54, 0x5f, 0x53, 0x4c, 0x4f, 0x54, 0x5f, 0x43, 0x4f, 0x55, 0x4e, 0x54, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 
+	0x20, 0x28, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x74, 0x5f, 0x69, 0x64, 0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x63, 
+	0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x5f, 0x53, 0x4c, 0x4f, 0x54, 
+	0x5f, 0x43, 0x4f, 0x55, 0x4e, 0x54, 0x20, 0x3d, 0x20, 0x31, 0x3b, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 
+	0x63, 0x6f, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x74, 0x5f, 0x69, 0x64, 0x20, 0x3d, 0x20, 0x31, 0x29, 0x20, 0x63, 0x6f, 0x6e, 
+	0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x53, 0x48, 0x41, 0x44, 0x4f, 0x57, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 
+	0x52, 0x45, 0x5f, 0x43, 0x4f, 0x55, 0x4e, 0x54, 0x20, 0x3d, 0x20, 0x31, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 
+	0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x43, 0x75, 0x73, 0x74, 0x6f, 0x6d, 0x20, 0x74, 0x79, 0x70, 0x65, 0x73, 0x0a, 0x0a, 0x73, 
 	0x74, 0x72, 0x75, 0x63, 0x74, 0x20, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x44, 0x61, 0x74, 0x61, 0x0a, 0x7b, 0x0a, 0x09, 
 	0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x73, 0x70, 0x65, 0x63, 0x74, 0x3b, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
 	0x20, 0x66, 0x6f, 0x76, 0x3b, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6e, 0x65, 0x61, 0x72, 0x3b, 0x0a, 0x09, 
@@ -51,32 +63,705 @@ static constexpr char common_glsl[] = {
 	0x34, 0x20, 0x69, 0x6e, 0x76, 0x56, 0x69, 0x65, 0x77, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x3b, 0x0a, 0x09, 0x6d, 0x61, 0x74, 
 	0x34, 0x20, 0x70, 0x72, 0x6f, 0x6a, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x56, 0x69, 0x65, 0x77, 0x4d, 0x6f, 0x64, 0x65, 
 	0x6c, 0x3b, 0x0a, 0x09, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x69, 0x6e, 0x76, 0x50, 0x72, 0x6f, 0x6a, 0x65, 0x63, 0x74, 0x69, 
-	0x6f, 0x6e, 0x56, 0x69, 0x65, 0x77, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x73, 0x74, 0x72, 
-	0x75, 0x63, 0x74, 0x20, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x44, 0x61, 0x74, 0x61, 
-	0x0a, 0x7b, 0x0a, 0x09, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x70, 0x72, 0x6f, 0x6a, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 
-	0x0a, 0x09, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x76, 0x69, 0x65, 0x77, 0x3b, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
-	0x6e, 0x65, 0x61, 0x72, 0x3b, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x66, 0x61, 0x72, 0x3b, 0x0a, 0x7d, 0x3b, 
-	0x0a, 0x0a, 0x73, 0x74, 0x72, 0x75, 0x63, 0x74, 0x20, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 0x65, 0x72, 
-	0x61, 0x73, 0x44, 0x61, 0x74, 0x61, 0x0a, 0x7b, 0x0a, 0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x63, 0x6f, 0x75, 0x6e, 0x74, 
-	0x3b, 0x0a, 0x09, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x44, 0x61, 0x74, 0x61, 0x20, 
-	0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x5b, 0x53, 0x48, 0x41, 0x44, 0x4f, 0x57, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 
-	0x52, 0x45, 0x5f, 0x43, 0x4f, 0x55, 0x4e, 0x54, 0x5d, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x43, 0x6f, 
-	0x6e, 0x73, 0x74, 0x61, 0x6e, 0x74, 0x73, 0x0a, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
-	0x20, 0x63, 0x5f, 0x65, 0x70, 0x73, 0x69, 0x6c, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x30, 0x2e, 0x30, 0x30, 0x30, 0x30, 0x31, 
-	0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x5f, 0x6f, 0x6e, 0x65, 0x4d, 
-	0x69, 0x6e, 0x75, 0x73, 0x45, 0x70, 0x73, 0x69, 0x6c, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x30, 0x2e, 0x39, 0x39, 0x39, 0x39, 
-	0x39, 0x3b, 0x0a, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x5f, 0x68, 0x61, 
-	0x6c, 0x66, 0x50, 0x69, 0x20, 0x3d, 0x20, 0x31, 0x2e, 0x35, 0x37, 0x30, 0x37, 0x39, 0x36, 0x33, 0x32, 0x36, 0x37, 0x39, 
-	0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x5f, 0x70, 0x69, 0x20, 0x3d, 
-	0x20, 0x33, 0x2e, 0x31, 0x34, 0x31, 0x35, 0x39, 0x32, 0x36, 0x35, 0x33, 0x35, 0x39, 0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 
-	0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x5f, 0x32, 0x70, 0x69, 0x20, 0x3d, 0x20, 0x36, 0x2e, 0x32, 0x38, 
-	0x33, 0x31, 0x38, 0x35, 0x33, 0x30, 0x37, 0x31, 0x38, 0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 
-	0x61, 0x74, 0x20, 0x63, 0x5f, 0x69, 0x6e, 0x76, 0x48, 0x61, 0x6c, 0x66, 0x50, 0x69, 0x20, 0x3d, 0x20, 0x30, 0x2e, 0x36, 
-	0x33, 0x36, 0x36, 0x31, 0x39, 0x37, 0x37, 0x32, 0x33, 0x36, 0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 
-	0x6f, 0x61, 0x74, 0x20, 0x63, 0x5f, 0x69, 0x6e, 0x76, 0x50, 0x69, 0x20, 0x3d, 0x20, 0x30, 0x2e, 0x33, 0x31, 0x38, 0x33, 
-	0x30, 0x39, 0x38, 0x38, 0x36, 0x31, 0x38, 0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
-	0x20, 0x63, 0x5f, 0x69, 0x6e, 0x76, 0x32, 0x70, 0x69, 0x20, 0x3d, 0x20, 0x30, 0x2e, 0x31, 0x35, 0x39, 0x31, 0x35, 0x34, 
-	0x39, 0x34, 0x33, 0x30, 0x39, 0x3b, 0x0a, 0x00
+	0x6f, 0x6e, 0x56, 0x69, 0x65, 0x77, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x70, 
+	0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 
+	0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x53, 0x63, 0x61, 0x6c, 0x65, 0x3b, 0x0a, 0x09, 0x75, 0x69, 0x6e, 
+	0x74, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x49, 0x6e, 0x64, 0x65, 0x78, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 
+	0x0a, 0x73, 0x74, 0x72, 0x75, 0x63, 0x74, 0x20, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x44, 0x61, 0x74, 0x61, 
+	0x0a, 0x7b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x34, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 
+	0x33, 0x20, 0x70, 0x72, 0x6f, 0x70, 0x65, 0x72, 0x74, 0x69, 0x65, 0x73, 0x3b, 0x0a, 0x09, 0x69, 0x6e, 0x74, 0x20, 0x63, 
+	0x6f, 0x6c, 0x6f, 0x72, 0x4c, 0x61, 0x79, 0x65, 0x72, 0x3b, 0x09, 0x09, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x4c, 0x61, 0x79, 
+	0x65, 0x72, 0x20, 0x6f, 0x66, 0x20, 0x74, 0x68, 0x65, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x74, 0x65, 0x78, 0x74, 
+	0x75, 0x72, 0x65, 0x20, 0x69, 0x6e, 0x20, 0x69, 0x74, 0x73, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x20, 0x61, 
+	0x72, 0x72, 0x61, 0x79, 0x0a, 0x09, 0x69, 0x6e, 0x74, 0x20, 0x70, 0x72, 0x6f, 0x70, 0x65, 0x72, 0x74, 0x69, 0x65, 0x73, 
+	0x4c, 0x61, 0x79, 0x65, 0x72, 0x3b, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x4c, 0x61, 0x79, 0x65, 0x72, 0x20, 0x6f, 0x66, 0x20, 
+	0x74, 0x68, 0x65, 0x20, 0x70, 0x72, 0x6f, 0x70, 0x65, 0x72, 0x74, 0x69, 0x65, 0x73, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 
+	0x72, 0x65, 0x20, 0x69, 0x6e, 0x20, 0x69, 0x74, 0x73, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x20, 0x61, 0x72, 
+	0x72, 0x61, 0x79, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x73, 0x74, 0x72, 0x75, 0x63, 0x74, 0x20, 0x53, 0x68, 0x61, 0x64, 0x6f, 
+	0x77, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x44, 0x61, 0x74, 0x61, 0x0a, 0x7b, 0x0a, 0x09, 0x6d, 0x61, 0x74, 0x34, 0x20, 
+	0x70, 0x72, 0x6f, 0x6a, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x09, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x76, 0x69, 
+	0x65, 0x77, 0x3b, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6e, 0x65, 0x61, 0x72, 0x3b, 0x0a, 0x09, 0x66, 0x6c, 
+	0x6f, 0x61, 0x74, 0x20, 0x66, 0x61, 0x72, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x73, 0x74, 0x72, 0x75, 0x63, 0x74, 0x20, 
+	0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x44, 0x61, 0x74, 0x61, 0x0a, 0x7b, 0x0a, 
+	0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 
+	0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x44, 0x61, 0x74, 0x61, 0x20, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x5b, 0x53, 
+	0x48, 0x41, 0x44, 0x4f, 0x57, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x5f, 0x43, 0x4f, 0x55, 0x4e, 0x54, 0x5d, 
+	0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x43, 0x6f, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x74, 0x73, 0x0a, 0x0a, 
+	0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x5f, 0x65, 0x70, 0x73, 0x69, 0x6c, 0x6f, 
+	0x6e, 0x20, 0x3d, 0x20, 0x30, 0x2e, 0x30, 0x30, 0x30, 0x30, 0x31, 0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 
+	0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x5f, 0x6f, 0x6e, 0x65, 0x4d, 0x69, 0x6e, 0x75, 0x73, 0x45, 0x70, 0x73, 0x69, 0x6c, 
+	0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x30, 0x2e, 0x39, 0x39, 0x39, 0x39, 0x39, 0x3b, 0x0a, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 
+	0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x5f, 0x68, 0x61, 0x6c, 0x66, 0x50, 0x69, 0x20, 0x3d, 0x20, 0x31, 0x2e, 
+	0x35, 0x37, 0x30, 0x37, 0x39, 0x36, 0x33, 0x32, 0x36, 0x37, 0x39, 0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 
+	0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x5f, 0x70, 0x69, 0x20, 0x3d, 0x20, 0x33, 0x2e, 0x31, 0x34, 0x31, 0x35, 0x39, 0x32, 
+	0x36, 0x35, 0x33, 0x35, 0x39, 0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 
+	0x5f, 0x32, 0x70, 0x69, 0x20, 0x3d, 0x20, 0x36, 0x2e, 0x32, 0x38, 0x33, 0x31, 0x38, 0x35, 0x33, 0x30, 0x37, 0x31, 0x38, 
+	0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x5f, 0x69, 0x6e, 0x76, 0x48, 
+	0x61, 0x6c, 0x66, 0x50, 0x69, 0x20, 0x3d, 0x20, 0x30, 0x2e, 0x36, 0x33, 0x36, 0x36, 0x31, 0x39, 0x37, 0x37, 0x32, 0x33, 
+	0x36, 0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x5f, 0x69, 0x6e, 0x76, 
+	0x50, 0x69, 0x20, 0x3d, 0x20, 0x30, 0x2e, 0x33, 0x31, 0x38, 0x33, 0x30, 0x39, 0x38, 0x38, 0x36, 0x31, 0x38, 0x3b, 0x0a, 
+	0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x5f, 0x69, 0x6e, 0x76, 0x32, 0x70, 0x69, 
+	0x20, 0x3d, 0x20, 0x30, 0x2e, 0x31, 0x35, 0x39, 0x31, 0x35, 0x34, 0x39, 0x34, 0x33, 0x30, 0x39, 0x3b, 0x0a, 0x0a, 0x2f, 
+	0x2f, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x61, 0x63, 0x74, 0x20, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x20, 0x64, 0x65, 0x63, 
+	0x6f, 0x64, 0x69, 0x6e, 0x67, 0x0a, 0x0a, 0x76, 0x65, 0x63, 0x34, 0x20, 0x64, 0x65, 0x63, 0x6f, 0x64, 0x65, 0x43, 0x6f, 
+	0x6d, 0x70, 0x61, 0x63, 0x74, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x75, 0x76, 0x65, 0x63, 0x32, 0x20, 
+	0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6f, 0x66, 0x66, 0x73, 0x65, 
+	0x74, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x63, 0x6f, 
+	0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x70, 0x20, 0x3d, 0x20, 0x76, 0x65, 0x63, 0x33, 0x28, 0x75, 0x6e, 
+	0x70, 0x61, 0x63, 0x6b, 0x55, 0x6e, 0x6f, 0x72, 0x6d, 0x32, 0x78, 0x31, 0x36, 0x28, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 
+	0x6f, 0x6e, 0x2e, 0x78, 0x29, 0x2c, 0x20, 0x75, 0x6e, 0x70, 0x61, 0x63, 0x6b, 0x55, 0x6e, 0x6f, 0x72, 0x6d, 0x32, 0x78, 
+	0x31, 0x36, 0x28, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x79, 0x29, 0x2e, 0x78, 0x29, 0x3b, 0x0a, 0x09, 
+	0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x28, 0x6f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x20, 0x2b, 
+	0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x20, 0x2a, 0x20, 0x70, 0x2c, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 
+	0x0a, 0x76, 0x65, 0x63, 0x34, 0x20, 0x64, 0x65, 0x63, 0x6f, 0x64, 0x65, 0x4f, 0x63, 0x74, 0x61, 0x68, 0x65, 0x64, 0x72, 
+	0x61, 0x6c, 0x44, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x64, 0x69, 0x72, 
+	0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 
+	0x32, 0x20, 0x65, 0x20, 0x3d, 0x20, 0x75, 0x6e, 0x70, 0x61, 0x63, 0x6b, 0x53, 0x6e, 0x6f, 0x72, 0x6d, 0x32, 0x78, 0x31, 
+	0x36, 0x28, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 
+	0x76, 0x20, 0x3d, 0x20, 0x76, 0x65, 0x63, 0x33, 0x28, 0x65, 0x2c, 0x20, 0x31, 0x2e, 0x30, 0x20, 0x2d, 0x20, 0x61, 0x62, 
+	0x73, 0x28, 0x65, 0x2e, 0x78, 0x29, 0x20, 0x2d, 0x20, 0x61, 0x62, 0x73, 0x28, 0x65, 0x2e, 0x79, 0x29, 0x29, 0x3b, 0x0a, 
+	0x0a, 0x09, 0x69, 0x66, 0x20, 0x28, 0x76, 0x2e, 0x7a, 0x20, 0x3c, 0x20, 0x30, 0x2e, 0x30, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 
+	0x09, 0x09, 0x76, 0x2e, 0x78, 0x79, 0x20, 0x3d, 0x20, 0x28, 0x31, 0x2e, 0x30, 0x20, 0x2d, 0x20, 0x61, 0x62, 0x73, 0x28, 
+	0x76, 0x2e, 0x79, 0x78, 0x29, 0x29, 0x20, 0x2a, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x76, 0x2e, 0x78, 0x20, 0x3e, 0x3d, 
+	0x20, 0x30, 0x2e, 0x30, 0x20, 0x3f, 0x20, 0x31, 0x2e, 0x30, 0x20, 0x3a, 0x20, 0x2d, 0x31, 0x2e, 0x30, 0x2c, 0x20, 0x76, 
+	0x2e, 0x79, 0x20, 0x3e, 0x3d, 0x20, 0x30, 0x2e, 0x30, 0x20, 0x3f, 0x20, 0x31, 0x2e, 0x30, 0x20, 0x3a, 0x20, 0x2d, 0x31, 
+	0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x76, 0x65, 0x63, 
+	0x34, 0x28, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x76, 0x29, 0x2c, 0x20, 0x30, 0x2e, 0x30, 0x29, 
+	0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x76, 0x65, 0x63, 0x34, 0x20, 0x64, 0x65, 0x63, 0x6f, 0x64, 0x65, 0x48, 0x61, 0x6c, 0x66, 
+	0x54, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x28, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 
+	0x6f, 0x72, 0x64, 0x73, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 
+	0x28, 0x75, 0x6e, 0x70, 0x61, 0x63, 0x6b, 0x48, 0x61, 0x6c, 0x66, 0x32, 0x78, 0x31, 0x36, 0x28, 0x74, 0x65, 0x78, 0x43, 
+	0x6f, 0x6f, 0x72, 0x64, 0x73, 0x29, 0x2c, 0x20, 0x30, 0x2e, 0x30, 0x2c, 0x20, 0x30, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x7d, 
+	0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 
+	0x65, 0x73, 0x2c, 0x20, 0x70, 0x6f, 0x6f, 0x6c, 0x65, 0x64, 0x20, 0x69, 0x6e, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 
+	0x65, 0x20, 0x61, 0x72, 0x72, 0x61, 0x79, 0x73, 0x20, 0x77, 0x69, 0x74, 0x68, 0x20, 0x60, 0x54, 0x45, 0x58, 0x54, 0x55, 
+	0x52, 0x45, 0x5f, 0x41, 0x52, 0x52, 0x41, 0x59, 0x53, 0x60, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x54, 
+	0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x5f, 0x41, 0x52, 0x52, 0x41, 0x59, 0x53, 0x0a, 0x09, 0x23, 0x64, 0x65, 0x66, 0x69, 
+	0x6e, 0x65, 0x20, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x53, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x20, 0x73, 
+	0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x41, 0x72, 0x72, 0x61, 0x79, 0x0a, 0x09, 0x23, 0x64, 0x65, 0x66, 0x69, 
+	0x6e, 0x65, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x54, 0x65, 0x78, 
+	0x74, 0x75, 0x72, 0x65, 0x28, 0x74, 0x65, 0x78, 0x2c, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2c, 
+	0x20, 0x6c, 0x61, 0x79, 0x65, 0x72, 0x29, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x74, 0x65, 0x78, 0x2c, 
+	0x20, 0x76, 0x65, 0x63, 0x33, 0x28, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2c, 0x20, 0x66, 0x6c, 0x6f, 
+	0x61, 0x74, 0x28, 0x6c, 0x61, 0x79, 0x65, 0x72, 0x29, 0x29, 0x29, 0x0a, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x23, 
+	0x64, 0x65, 0x66, 0x69, 0x6e, 0x65, 0x20, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x53, 0x61, 0x6d, 0x70, 0x6c, 
+	0x65, 0x72, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x0a, 0x09, 0x23, 0x64, 0x65, 0x66, 0x69, 0x6e, 
+	0x65, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x54, 0x65, 0x78, 0x74, 
+	0x75, 0x72, 0x65, 0x28, 0x74, 0x65, 0x78, 0x2c, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2c, 0x20, 
+	0x6c, 0x61, 0x79, 0x65, 0x72, 0x29, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x74, 0x65, 0x78, 0x2c, 0x20, 
+	0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x29, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x00
+};
+
+static constexpr char culling_comp[] = {
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x0a, 
+	0x2f, 0x2f, 0x21, 0x20, 0x5c, 0x66, 0x69, 0x6c, 0x65, 0x0a, 0x2f, 0x2f, 0x21, 0x20, 0x5c, 0x61, 0x75, 0x74, 0x68, 0x6f, 
+	0x72, 0x20, 0x52, 0x65, 0x69, 0x65, 0x78, 0x0a, 0x2f, 0x2f, 0x21, 0x20, 0x5c, 0x63, 0x6f, 0x70, 0x79, 0x72, 0x69, 0x67, 
+	0x68, 0x74, 0x20, 0x54, 0x68, 0x65, 0x20, 0x4d, 0x49, 0x54, 0x20, 0x4c, 0x69, 0x63, 0x65, 0x6e, 0x73, 0x65, 0x20, 0x28, 
+	0x4d, 0x49, 0x54, 0x29, 0x0a, 0x2f, 0x2f, 0x21, 0x20, 0x5c, 0x64, 0x61, 0x74, 0x65, 0x20, 0x32, 0x30, 0x32, 0x33, 0x0a, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x0a, 
+	0x0a, 0x2f, 0x2f, 0x20, 0x57, 0x6f, 0x72, 0x6b, 0x20, 0x67, 0x72, 0x6f, 0x75, 0x70, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 
+	0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x6c, 0x5f, 0x73, 0x69, 0x7a, 0x65, 0x5f, 0x78, 0x20, 0x3d, 0x20, 0x36, 
+	0x34, 0x29, 0x20, 0x69, 0x6e, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x43, 0x75, 0x73, 0x74, 0x6f, 0x6d, 0x20, 0x74, 0x79, 
+	0x70, 0x65, 0x73, 0x0a, 0x0a, 0x73, 0x74, 0x72, 0x75, 0x63, 0x74, 0x20, 0x43, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x44, 
+	0x61, 0x74, 0x61, 0x0a, 0x7b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x34, 0x20, 0x66, 0x72, 0x75, 0x73, 0x74, 0x75, 0x6d, 0x50, 
+	0x6c, 0x61, 0x6e, 0x65, 0x73, 0x5b, 0x36, 0x5d, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x65, 0x79, 0x65, 0x3b, 
+	0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6c, 0x6f, 0x64, 0x45, 0x72, 0x72, 0x6f, 0x72, 0x54, 0x68, 0x72, 0x65, 
+	0x73, 0x68, 0x6f, 0x6c, 0x64, 0x3b, 0x0a, 0x09, 0x75, 0x76, 0x65, 0x63, 0x32, 0x20, 0x72, 0x65, 0x73, 0x6f, 0x6c, 0x75, 
+	0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 
+	0x43, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4c, 
+	0x6f, 0x64, 0x42, 0x69, 0x61, 0x73, 0x3b, 0x0a, 0x09, 0x75, 0x76, 0x65, 0x63, 0x32, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 
+	0x77, 0x52, 0x65, 0x73, 0x6f, 0x6c, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x0a, 0x09, 0x6d, 0x61, 0x74, 0x34, 0x20, 
+	0x70, 0x79, 0x72, 0x61, 0x6d, 0x69, 0x64, 0x56, 0x69, 0x65, 0x77, 0x3b, 0x0a, 0x09, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x70, 
+	0x79, 0x72, 0x61, 0x6d, 0x69, 0x64, 0x50, 0x72, 0x6f, 0x6a, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x09, 0x66, 
+	0x6c, 0x6f, 0x61, 0x74, 0x20, 0x70, 0x79, 0x72, 0x61, 0x6d, 0x69, 0x64, 0x4e, 0x65, 0x61, 0x72, 0x3b, 0x0a, 0x09, 0x66, 
+	0x6c, 0x6f, 0x61, 0x74, 0x20, 0x70, 0x79, 0x72, 0x61, 0x6d, 0x69, 0x64, 0x46, 0x61, 0x72, 0x3b, 0x0a, 0x09, 0x75, 0x69, 
+	0x6e, 0x74, 0x20, 0x70, 0x79, 0x72, 0x61, 0x6d, 0x69, 0x64, 0x4c, 0x65, 0x76, 0x65, 0x6c, 0x43, 0x6f, 0x75, 0x6e, 0x74, 
+	0x3b, 0x0a, 0x0a, 0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x66, 0x6c, 0x61, 0x67, 0x73, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 
+	0x73, 0x74, 0x72, 0x75, 0x63, 0x74, 0x20, 0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x43, 0x75, 0x6c, 0x6c, 0x69, 
+	0x6e, 0x67, 0x44, 0x61, 0x74, 0x61, 0x0a, 0x7b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 0x6f, 0x75, 0x6e, 0x64, 
+	0x69, 0x6e, 0x67, 0x42, 0x6f, 0x78, 0x4d, 0x69, 0x6e, 0x3b, 0x0a, 0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x6c, 0x6f, 0x64, 
+	0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 0x6f, 0x75, 0x6e, 0x64, 0x69, 
+	0x6e, 0x67, 0x42, 0x6f, 0x78, 0x4d, 0x61, 0x78, 0x3b, 0x0a, 0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x6c, 0x6f, 0x64, 0x43, 
+	0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x6d, 0x65, 0x73, 0x68, 0x6c, 0x65, 0x74, 0x4f, 
+	0x66, 0x66, 0x73, 0x65, 0x74, 0x3b, 0x0a, 0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x6d, 0x65, 0x73, 0x68, 0x6c, 0x65, 0x74, 
+	0x43, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x63, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 
+	0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x3b, 0x0a, 0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x66, 0x6c, 0x61, 0x67, 0x73, 0x3b, 
+	0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x73, 0x74, 0x72, 0x75, 0x63, 0x74, 0x20, 0x4c, 0x6f, 0x64, 0x44, 0x61, 0x74, 0x61, 0x0a, 
+	0x7b, 0x0a, 0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x3b, 
+	0x0a, 0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 
+	0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x65, 0x72, 0x72, 0x6f, 0x72, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x73, 0x74, 0x72, 
+	0x75, 0x63, 0x74, 0x20, 0x4d, 0x65, 0x73, 0x68, 0x6c, 0x65, 0x74, 0x44, 0x61, 0x74, 0x61, 0x0a, 0x7b, 0x0a, 0x09, 0x75, 
+	0x69, 0x6e, 0x74, 0x20, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x3b, 0x0a, 0x09, 0x75, 0x69, 
+	0x6e, 0x74, 0x20, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 
+	0x20, 0x63, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x3b, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x72, 0x61, 0x64, 0x69, 
+	0x75, 0x73, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x6f, 0x6e, 0x65, 0x41, 0x78, 0x69, 0x73, 0x3b, 0x0a, 
+	0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x6f, 0x6e, 0x65, 0x43, 0x75, 0x74, 0x6f, 0x66, 0x66, 0x3b, 0x0a, 0x7d, 
+	0x3b, 0x0a, 0x0a, 0x73, 0x74, 0x72, 0x75, 0x63, 0x74, 0x20, 0x44, 0x72, 0x61, 0x77, 0x43, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 
+	0x64, 0x0a, 0x7b, 0x0a, 0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x75, 0x69, 
+	0x6e, 0x74, 0x20, 0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x75, 
+	0x69, 0x6e, 0x74, 0x20, 0x66, 0x69, 0x72, 0x73, 0x74, 0x49, 0x6e, 0x64, 0x65, 0x78, 0x3b, 0x0a, 0x09, 0x69, 0x6e, 0x74, 
+	0x20, 0x62, 0x61, 0x73, 0x65, 0x56, 0x65, 0x72, 0x74, 0x65, 0x78, 0x3b, 0x0a, 0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x62, 
+	0x61, 0x73, 0x65, 0x49, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 
+	0x55, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 
+	0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 0x31, 0x34, 0x30, 0x2c, 0x20, 0x72, 0x6f, 0x77, 0x5f, 0x6d, 0x61, 0x6a, 0x6f, 
+	0x72, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x75, 0x6e, 0x69, 0x66, 
+	0x6f, 0x72, 0x6d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 
+	0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x44, 0x61, 0x74, 0x61, 0x20, 0x75, 0x62, 0x6f, 0x5f, 
+	0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 
+	0x73, 0x74, 0x64, 0x31, 0x34, 0x30, 0x2c, 0x20, 0x72, 0x6f, 0x77, 0x5f, 0x6d, 0x61, 0x6a, 0x6f, 0x72, 0x2c, 0x20, 0x62, 
+	0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x33, 0x29, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 
+	0x75, 0x62, 0x6f, 0x5f, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x5f, 0x6c, 0x61, 
+	0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 
+	0x73, 0x44, 0x61, 0x74, 0x61, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 0x65, 
+	0x72, 0x61, 0x73, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 
+	0x31, 0x34, 0x30, 0x2c, 0x20, 0x72, 0x6f, 0x77, 0x5f, 0x6d, 0x61, 0x6a, 0x6f, 0x72, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 
+	0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x34, 0x29, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x75, 0x62, 0x6f, 
+	0x5f, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x43, 
+	0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x44, 0x61, 0x74, 0x61, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x75, 0x6c, 0x6c, 0x69, 
+	0x6e, 0x67, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x53, 0x68, 0x61, 0x64, 0x65, 0x72, 0x20, 0x73, 0x74, 
+	0x6f, 0x72, 0x61, 0x67, 0x65, 0x20, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 
+	0x20, 0x28, 0x73, 0x74, 0x64, 0x34, 0x33, 0x30, 0x2c, 0x20, 0x72, 0x6f, 0x77, 0x5f, 0x6d, 0x61, 0x6a, 0x6f, 0x72, 0x2c, 
+	0x20, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x72, 0x65, 0x61, 0x64, 0x6f, 0x6e, 
+	0x6c, 0x79, 0x20, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 
+	0x62, 0x6c, 0x65, 0x73, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x44, 0x72, 0x61, 0x77, 0x61, 
+	0x62, 0x6c, 0x65, 0x44, 0x61, 0x74, 0x61, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 
+	0x65, 0x73, 0x5b, 0x5d, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 
+	0x64, 0x34, 0x33, 0x30, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x31, 0x29, 0x20, 0x72, 
+	0x65, 0x61, 0x64, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 
+	0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x73, 0x5f, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x5f, 0x6c, 0x61, 
+	0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x43, 0x75, 0x6c, 0x6c, 
+	0x69, 0x6e, 0x67, 0x44, 0x61, 0x74, 0x61, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 
+	0x65, 0x73, 0x43, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x5b, 0x5d, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 
+	0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 0x34, 0x33, 0x30, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 
+	0x20, 0x3d, 0x20, 0x32, 0x29, 0x20, 0x72, 0x65, 0x61, 0x64, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x62, 0x75, 0x66, 0x66, 0x65, 
+	0x72, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x6c, 0x6f, 0x64, 0x73, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 
+	0x0a, 0x09, 0x4c, 0x6f, 0x64, 0x44, 0x61, 0x74, 0x61, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x6c, 0x6f, 0x64, 0x73, 0x5b, 
+	0x5d, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 0x34, 0x33, 
+	0x30, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x33, 0x29, 0x20, 0x72, 0x65, 0x61, 0x64, 
+	0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x6d, 0x65, 0x73, 
+	0x68, 0x6c, 0x65, 0x74, 0x73, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x4d, 0x65, 0x73, 0x68, 
+	0x6c, 0x65, 0x74, 0x44, 0x61, 0x74, 0x61, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x6d, 0x65, 0x73, 0x68, 0x6c, 0x65, 0x74, 
+	0x73, 0x5b, 0x5d, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 
+	0x34, 0x33, 0x30, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x34, 0x29, 0x20, 0x77, 0x72, 
+	0x69, 0x74, 0x65, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 
+	0x63, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x73, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x44, 
+	0x72, 0x61, 0x77, 0x43, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x63, 0x6f, 0x6d, 0x6d, 
+	0x61, 0x6e, 0x64, 0x73, 0x5b, 0x5d, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 
+	0x73, 0x74, 0x64, 0x34, 0x33, 0x30, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x35, 0x29, 
+	0x20, 0x77, 0x72, 0x69, 0x74, 0x65, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 0x73, 0x73, 
+	0x62, 0x6f, 0x5f, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x73, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 
+	0x75, 0x69, 0x6e, 0x74, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x73, 0x5b, 0x5d, 0x3b, 0x0a, 
+	0x7d, 0x3b, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 0x34, 0x33, 0x30, 0x2c, 0x20, 
+	0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x36, 0x29, 0x20, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 
+	0x73, 0x73, 0x62, 0x6f, 0x5f, 0x76, 0x69, 0x73, 0x69, 0x62, 0x69, 0x6c, 0x69, 0x74, 0x79, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 
+	0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x76, 0x69, 0x73, 0x69, 
+	0x62, 0x69, 0x6c, 0x69, 0x74, 0x79, 0x5b, 0x5d, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x43, 0x6f, 0x6e, 
+	0x73, 0x74, 0x61, 0x6e, 0x74, 0x73, 0x0a, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x63, 
+	0x5f, 0x6d, 0x61, 0x78, 0x44, 0x65, 0x70, 0x74, 0x68, 0x50, 0x79, 0x72, 0x61, 0x6d, 0x69, 0x64, 0x54, 0x65, 0x78, 0x74, 
+	0x75, 0x72, 0x65, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x31, 0x36, 0x3b, 0x0a, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 
+	0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x63, 0x5f, 0x66, 0x72, 0x75, 0x73, 0x74, 0x75, 0x6d, 0x43, 0x75, 0x6c, 0x6c, 
+	0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x31, 0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 
+	0x63, 0x5f, 0x63, 0x6c, 0x75, 0x73, 0x74, 0x65, 0x72, 0x43, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x32, 
+	0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x63, 0x5f, 0x6f, 0x63, 0x63, 0x6c, 0x75, 
+	0x73, 0x69, 0x6f, 0x6e, 0x43, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x34, 0x3b, 0x0a, 0x63, 0x6f, 0x6e, 
+	0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x63, 0x5f, 0x6c, 0x6f, 0x64, 0x53, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x69, 
+	0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x38, 0x3b, 0x0a, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 
+	0x63, 0x5f, 0x63, 0x6f, 0x6e, 0x65, 0x43, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x31, 0x3b, 0x0a, 0x63, 
+	0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x63, 0x5f, 0x63, 0x6f, 0x6e, 0x65, 0x46, 0x6c, 0x69, 0x70, 
+	0x70, 0x65, 0x64, 0x20, 0x3d, 0x20, 0x32, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x55, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 
+	0x73, 0x0a, 0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x75, 0x5f, 0x70, 0x68, 
+	0x61, 0x73, 0x65, 0x3b, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x30, 0x3a, 0x20, 0x74, 0x65, 0x73, 0x74, 0x20, 0x61, 0x67, 0x61, 
+	0x69, 0x6e, 0x73, 0x74, 0x20, 0x74, 0x68, 0x65, 0x20, 0x64, 0x65, 0x70, 0x74, 0x68, 0x20, 0x70, 0x79, 0x72, 0x61, 0x6d, 
+	0x69, 0x64, 0x20, 0x6f, 0x66, 0x20, 0x74, 0x68, 0x65, 0x20, 0x70, 0x72, 0x65, 0x76, 0x69, 0x6f, 0x75, 0x73, 0x20, 0x66, 
+	0x72, 0x61, 0x6d, 0x65, 0x2c, 0x20, 0x31, 0x3a, 0x20, 0x72, 0x65, 0x74, 0x65, 0x73, 0x74, 0x20, 0x74, 0x68, 0x65, 0x20, 
+	0x6f, 0x63, 0x63, 0x6c, 0x75, 0x64, 0x65, 0x64, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x73, 0x0a, 0x75, 
+	0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 0x5f, 0x64, 
+	0x65, 0x70, 0x74, 0x68, 0x50, 0x79, 0x72, 0x61, 0x6d, 0x69, 0x64, 0x5b, 0x63, 0x5f, 0x6d, 0x61, 0x78, 0x44, 0x65, 0x70, 
+	0x74, 0x68, 0x50, 0x79, 0x72, 0x61, 0x6d, 0x69, 0x64, 0x54, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x43, 0x6f, 0x75, 0x6e, 
+	0x74, 0x5d, 0x3b, 0x09, 0x2f, 0x2f, 0x20, 0x46, 0x72, 0x6f, 0x6d, 0x20, 0x6c, 0x65, 0x76, 0x65, 0x6c, 0x20, 0x31, 0x2c, 
+	0x20, 0x6c, 0x65, 0x76, 0x65, 0x6c, 0x20, 0x30, 0x20, 0x69, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x47, 0x2d, 0x42, 0x75, 
+	0x66, 0x66, 0x65, 0x72, 0x20, 0x64, 0x65, 0x70, 0x74, 0x68, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x75, 0x6e, 0x63, 0x74, 
+	0x69, 0x6f, 0x6e, 0x20, 0x64, 0x65, 0x63, 0x6c, 0x61, 0x72, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x0a, 0x0a, 0x66, 0x6c, 
+	0x6f, 0x61, 0x74, 0x20, 0x67, 0x65, 0x74, 0x4d, 0x61, 0x78, 0x53, 0x63, 0x61, 0x6c, 0x65, 0x28, 0x69, 0x6e, 0x20, 0x63, 
+	0x6f, 0x6e, 0x73, 0x74, 0x20, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x6f, 0x72, 0x6d, 0x29, 
+	0x3b, 0x0a, 0x62, 0x6f, 0x6f, 0x6c, 0x20, 0x69, 0x73, 0x53, 0x70, 0x68, 0x65, 0x72, 0x65, 0x49, 0x6e, 0x46, 0x72, 0x75, 
+	0x73, 0x74, 0x75, 0x6d, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 
+	0x65, 0x6e, 0x74, 0x65, 0x72, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 
+	0x74, 0x20, 0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x29, 0x3b, 0x0a, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x66, 0x65, 0x74, 
+	0x63, 0x68, 0x50, 0x79, 0x72, 0x61, 0x6d, 0x69, 0x64, 0x44, 0x65, 0x70, 0x74, 0x68, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 
+	0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x6c, 0x65, 0x76, 0x65, 0x6c, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 
+	0x6f, 0x6e, 0x73, 0x74, 0x20, 0x69, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x29, 0x3b, 0x0a, 0x62, 
+	0x6f, 0x6f, 0x6c, 0x20, 0x69, 0x73, 0x42, 0x6f, 0x78, 0x4f, 0x63, 0x63, 0x6c, 0x75, 0x64, 0x65, 0x64, 0x28, 0x69, 0x6e, 
+	0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 0x62, 0x4d, 0x69, 0x6e, 0x2c, 0x20, 0x69, 
+	0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 0x62, 0x4d, 0x61, 0x78, 0x2c, 0x20, 
+	0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x29, 
+	0x3b, 0x0a, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x73, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x4c, 0x6f, 0x64, 0x28, 0x69, 0x6e, 0x20, 
+	0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x43, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 
+	0x67, 0x44, 0x61, 0x74, 0x61, 0x20, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 
+	0x6e, 0x73, 0x74, 0x20, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x76, 0x69, 0x65, 0x77, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x2c, 0x20, 
+	0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x70, 0x72, 0x6f, 0x6a, 0x65, 0x63, 
+	0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 
+	0x68, 0x65, 0x69, 0x67, 0x68, 0x74, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 
+	0x74, 0x20, 0x62, 0x69, 0x61, 0x73, 0x29, 0x3b, 0x0a, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x73, 0x65, 0x6c, 0x65, 0x63, 0x74, 
+	0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4c, 0x6f, 0x64, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x44, 
+	0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x44, 0x61, 0x74, 0x61, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 
+	0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x43, 
+	0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x44, 0x61, 0x74, 0x61, 0x20, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x29, 0x3b, 
+	0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x65, 0x6d, 0x69, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x73, 0x28, 0x69, 
+	0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x2c, 0x20, 
+	0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x44, 0x61, 0x74, 
+	0x61, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 
+	0x20, 0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x43, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x44, 0x61, 0x74, 0x61, 
+	0x20, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x29, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x75, 0x6e, 0x63, 0x74, 
+	0x69, 0x6f, 0x6e, 0x20, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 
+	0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 
+	0x6e, 0x74, 0x20, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x20, 0x3d, 0x20, 0x67, 0x6c, 0x5f, 0x47, 0x6c, 0x6f, 0x62, 0x61, 0x6c, 
+	0x49, 0x6e, 0x76, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x49, 0x44, 0x2e, 0x78, 0x3b, 0x0a, 0x09, 0x69, 0x66, 0x20, 
+	0x28, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x20, 0x3e, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 
+	0x67, 0x2e, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 
+	0x09, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 
+	0x20, 0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x44, 0x61, 0x74, 0x61, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 
+	0x6c, 0x65, 0x20, 0x3d, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x73, 0x5b, 
+	0x69, 0x6e, 0x64, 0x65, 0x78, 0x5d, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x44, 0x72, 0x61, 0x77, 0x61, 
+	0x62, 0x6c, 0x65, 0x43, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x44, 0x61, 0x74, 0x61, 0x20, 0x63, 0x75, 0x6c, 0x6c, 0x69, 
+	0x6e, 0x67, 0x20, 0x3d, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x73, 0x43, 
+	0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x5b, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x5d, 0x3b, 0x0a, 0x0a, 0x09, 0x69, 0x66, 0x20, 
+	0x28, 0x75, 0x5f, 0x70, 0x68, 0x61, 0x73, 0x65, 0x20, 0x3d, 0x3d, 0x20, 0x30, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 
+	0x2f, 0x2f, 0x20, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x20, 0x63, 0x61, 0x73, 0x74, 0x65, 0x72, 0x73, 0x20, 0x61, 0x72, 
+	0x65, 0x20, 0x6e, 0x6f, 0x74, 0x20, 0x63, 0x75, 0x6c, 0x6c, 0x65, 0x64, 0x20, 0x61, 0x67, 0x61, 0x69, 0x6e, 0x73, 0x74, 
+	0x20, 0x74, 0x68, 0x65, 0x20, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2c, 0x20, 0x74, 0x68, 0x65, 0x69, 0x72, 0x20, 0x63, 
+	0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x20, 0x63, 0x6f, 0x6d, 0x65, 0x73, 0x20, 0x66, 0x69, 0x72, 0x73, 0x74, 0x0a, 0x0a, 
+	0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x4c, 0x6f, 0x64, 0x44, 0x61, 0x74, 0x61, 0x20, 0x73, 0x68, 0x61, 0x64, 
+	0x6f, 0x77, 0x4c, 0x6f, 0x64, 0x20, 0x3d, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x6c, 0x6f, 0x64, 0x73, 0x5b, 0x63, 0x75, 
+	0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x6c, 0x6f, 0x64, 0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x20, 0x2b, 0x20, 0x73, 0x65, 
+	0x6c, 0x65, 0x63, 0x74, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4c, 0x6f, 0x64, 0x28, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 
+	0x6c, 0x65, 0x2c, 0x20, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x29, 0x5d, 0x3b, 0x0a, 0x09, 0x09, 0x73, 0x73, 0x62, 
+	0x6f, 0x5f, 0x63, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x73, 0x5b, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x5d, 0x20, 0x3d, 0x20, 
+	0x44, 0x72, 0x61, 0x77, 0x43, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x28, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4c, 0x6f, 
+	0x64, 0x2e, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x2c, 0x20, 0x31, 0x75, 0x2c, 0x20, 0x73, 0x68, 
+	0x61, 0x64, 0x6f, 0x77, 0x4c, 0x6f, 0x64, 0x2e, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x2c, 
+	0x20, 0x30, 0x2c, 0x20, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x09, 0x73, 0x73, 0x62, 0x6f, 0x5f, 
+	0x63, 0x6f, 0x75, 0x6e, 0x74, 0x73, 0x5b, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x5d, 0x20, 0x3d, 0x20, 0x30, 0x3b, 0x0a, 0x09, 
+	0x09, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x76, 0x69, 0x73, 0x69, 0x62, 0x69, 0x6c, 0x69, 0x74, 0x79, 0x5b, 0x69, 0x6e, 0x64, 
+	0x65, 0x78, 0x5d, 0x20, 0x3d, 0x20, 0x30, 0x3b, 0x0a, 0x0a, 0x09, 0x09, 0x69, 0x66, 0x20, 0x28, 0x28, 0x75, 0x62, 0x6f, 
+	0x5f, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x66, 0x6c, 0x61, 0x67, 0x73, 0x20, 0x26, 0x20, 0x63, 0x5f, 0x66, 
+	0x72, 0x75, 0x73, 0x74, 0x75, 0x6d, 0x43, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x29, 0x20, 0x21, 0x3d, 0x20, 0x30, 0x29, 
+	0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 
+	0x65, 0x6e, 0x74, 0x65, 0x72, 0x20, 0x3d, 0x20, 0x28, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x6d, 0x6f, 
+	0x64, 0x65, 0x6c, 0x20, 0x2a, 0x20, 0x76, 0x65, 0x63, 0x34, 0x28, 0x28, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 
+	0x62, 0x6f, 0x75, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x42, 0x6f, 0x78, 0x4d, 0x69, 0x6e, 0x20, 0x2b, 0x20, 0x63, 0x75, 0x6c, 
+	0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x62, 0x6f, 0x75, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x42, 0x6f, 0x78, 0x4d, 0x61, 0x78, 0x29, 
+	0x20, 0x2a, 0x20, 0x30, 0x2e, 0x35, 0x2c, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x29, 0x2e, 0x78, 0x79, 0x7a, 0x3b, 0x0a, 0x09, 
+	0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 
+	0x20, 0x3d, 0x20, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x28, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x62, 0x6f, 
+	0x75, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x42, 0x6f, 0x78, 0x4d, 0x61, 0x78, 0x20, 0x2d, 0x20, 0x63, 0x75, 0x6c, 0x6c, 0x69, 
+	0x6e, 0x67, 0x2e, 0x62, 0x6f, 0x75, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x42, 0x6f, 0x78, 0x4d, 0x69, 0x6e, 0x29, 0x20, 0x2a, 
+	0x20, 0x30, 0x2e, 0x35, 0x20, 0x2a, 0x20, 0x67, 0x65, 0x74, 0x4d, 0x61, 0x78, 0x53, 0x63, 0x61, 0x6c, 0x65, 0x28, 0x64, 
+	0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x09, 0x09, 
+	0x69, 0x66, 0x20, 0x28, 0x21, 0x69, 0x73, 0x53, 0x70, 0x68, 0x65, 0x72, 0x65, 0x49, 0x6e, 0x46, 0x72, 0x75, 0x73, 0x74, 
+	0x75, 0x6d, 0x28, 0x63, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x2c, 0x20, 0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x29, 0x29, 0x0a, 
+	0x09, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x3b, 0x0a, 0x09, 0x09, 0x09, 
+	0x7d, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x09, 0x69, 0x66, 0x20, 0x28, 0x69, 0x73, 0x42, 0x6f, 0x78, 0x4f, 0x63, 
+	0x63, 0x6c, 0x75, 0x64, 0x65, 0x64, 0x28, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x62, 0x6f, 0x75, 0x6e, 0x64, 
+	0x69, 0x6e, 0x67, 0x42, 0x6f, 0x78, 0x4d, 0x69, 0x6e, 0x2c, 0x20, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x62, 
+	0x6f, 0x75, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x42, 0x6f, 0x78, 0x4d, 0x61, 0x78, 0x2c, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 
+	0x62, 0x6c, 0x65, 0x2e, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x29, 0x29, 0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x73, 
+	0x73, 0x62, 0x6f, 0x5f, 0x76, 0x69, 0x73, 0x69, 0x62, 0x69, 0x6c, 0x69, 0x74, 0x79, 0x5b, 0x69, 0x6e, 0x64, 0x65, 0x78, 
+	0x5d, 0x20, 0x3d, 0x20, 0x31, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x3b, 0x0a, 0x09, 0x09, 
+	0x7d, 0x0a, 0x09, 0x7d, 0x0a, 0x09, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x73, 0x73, 0x62, 0x6f, 
+	0x5f, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x73, 0x5b, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x5d, 0x20, 0x3d, 0x20, 0x30, 0x3b, 0x0a, 
+	0x0a, 0x09, 0x09, 0x69, 0x66, 0x20, 0x28, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x76, 0x69, 0x73, 0x69, 0x62, 0x69, 0x6c, 0x69, 
+	0x74, 0x79, 0x5b, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x5d, 0x20, 0x3d, 0x3d, 0x20, 0x30, 0x20, 0x7c, 0x7c, 0x20, 0x69, 0x73, 
+	0x42, 0x6f, 0x78, 0x4f, 0x63, 0x63, 0x6c, 0x75, 0x64, 0x65, 0x64, 0x28, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 
+	0x62, 0x6f, 0x75, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x42, 0x6f, 0x78, 0x4d, 0x69, 0x6e, 0x2c, 0x20, 0x63, 0x75, 0x6c, 0x6c, 
+	0x69, 0x6e, 0x67, 0x2e, 0x62, 0x6f, 0x75, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x42, 0x6f, 0x78, 0x4d, 0x61, 0x78, 0x2c, 0x20, 
+	0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x29, 0x29, 0x0a, 0x09, 0x09, 0x7b, 
+	0x0a, 0x09, 0x09, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x7d, 0x0a, 0x0a, 
+	0x09, 0x65, 0x6d, 0x69, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x73, 0x28, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x2c, 
+	0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2c, 0x20, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x29, 0x3b, 
+	0x0a, 0x7d, 0x0a, 0x0a, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x67, 0x65, 0x74, 0x4d, 0x61, 0x78, 0x53, 0x63, 0x61, 0x6c, 
+	0x65, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x74, 0x72, 0x61, 0x6e, 
+	0x73, 0x66, 0x6f, 0x72, 0x6d, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x6d, 0x61, 0x78, 
+	0x28, 0x6d, 0x61, 0x78, 0x28, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x28, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x6f, 0x72, 
+	0x6d, 0x5b, 0x30, 0x5d, 0x2e, 0x78, 0x79, 0x7a, 0x29, 0x2c, 0x20, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x28, 0x74, 0x72, 
+	0x61, 0x6e, 0x73, 0x66, 0x6f, 0x72, 0x6d, 0x5b, 0x31, 0x5d, 0x2e, 0x78, 0x79, 0x7a, 0x29, 0x29, 0x2c, 0x20, 0x6c, 0x65, 
+	0x6e, 0x67, 0x74, 0x68, 0x28, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x6f, 0x72, 0x6d, 0x5b, 0x32, 0x5d, 0x2e, 0x78, 0x79, 
+	0x7a, 0x29, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x62, 0x6f, 0x6f, 0x6c, 0x20, 0x69, 0x73, 0x53, 0x70, 0x68, 0x65, 0x72, 
+	0x65, 0x49, 0x6e, 0x46, 0x72, 0x75, 0x73, 0x74, 0x75, 0x6d, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 
+	0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 
+	0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x66, 
+	0x6f, 0x72, 0x20, 0x28, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x20, 0x3d, 0x20, 0x30, 0x3b, 0x20, 0x69, 0x20, 0x3c, 0x20, 
+	0x36, 0x3b, 0x20, 0x2b, 0x2b, 0x69, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x69, 0x66, 0x20, 0x28, 0x64, 0x6f, 0x74, 
+	0x28, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x66, 0x72, 0x75, 0x73, 0x74, 0x75, 0x6d, 
+	0x50, 0x6c, 0x61, 0x6e, 0x65, 0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x78, 0x79, 0x7a, 0x2c, 0x20, 0x63, 0x65, 0x6e, 0x74, 0x65, 
+	0x72, 0x29, 0x20, 0x2b, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x66, 0x72, 0x75, 
+	0x73, 0x74, 0x75, 0x6d, 0x50, 0x6c, 0x61, 0x6e, 0x65, 0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x77, 0x20, 0x3c, 0x20, 0x2d, 0x72, 
+	0x61, 0x64, 0x69, 0x75, 0x73, 0x29, 0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 
+	0x20, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x72, 0x65, 0x74, 
+	0x75, 0x72, 0x6e, 0x20, 0x74, 0x72, 0x75, 0x65, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x66, 
+	0x65, 0x74, 0x63, 0x68, 0x50, 0x79, 0x72, 0x61, 0x6d, 0x69, 0x64, 0x44, 0x65, 0x70, 0x74, 0x68, 0x28, 0x69, 0x6e, 0x20, 
+	0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x6c, 0x65, 0x76, 0x65, 0x6c, 0x2c, 0x20, 0x69, 0x6e, 
+	0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x69, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x29, 0x0a, 
+	0x7b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x54, 0x68, 0x65, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x73, 0x20, 0x6f, 
+	0x66, 0x20, 0x61, 0x6e, 0x20, 0x61, 0x72, 0x72, 0x61, 0x79, 0x20, 0x63, 0x61, 0x6e, 0x20, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 
+	0x62, 0x65, 0x20, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x65, 0x64, 0x20, 0x62, 0x79, 0x20, 0x61, 0x20, 0x64, 0x79, 0x6e, 0x61, 
+	0x6d, 0x69, 0x63, 0x61, 0x6c, 0x6c, 0x79, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x76, 0x61, 0x6c, 0x75, 
+	0x65, 0x2c, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6c, 0x6f, 0x6f, 0x70, 0x20, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x65, 0x72, 0x20, 
+	0x69, 0x73, 0x20, 0x6f, 0x6e, 0x65, 0x0a, 0x0a, 0x09, 0x66, 0x6f, 0x72, 0x20, 0x28, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 
+	0x20, 0x3d, 0x20, 0x30, 0x3b, 0x20, 0x69, 0x20, 0x3c, 0x20, 0x63, 0x5f, 0x6d, 0x61, 0x78, 0x44, 0x65, 0x70, 0x74, 0x68, 
+	0x50, 0x79, 0x72, 0x61, 0x6d, 0x69, 0x64, 0x54, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 
+	0x20, 0x2b, 0x2b, 0x69, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x69, 0x66, 0x20, 0x28, 0x69, 0x20, 0x2b, 0x20, 0x31, 
+	0x20, 0x3d, 0x3d, 0x20, 0x6c, 0x65, 0x76, 0x65, 0x6c, 0x29, 0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x72, 0x65, 
+	0x74, 0x75, 0x72, 0x6e, 0x20, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x46, 0x65, 0x74, 0x63, 0x68, 0x28, 0x75, 0x5f, 0x64, 0x65, 
+	0x70, 0x74, 0x68, 0x50, 0x79, 0x72, 0x61, 0x6d, 0x69, 0x64, 0x5b, 0x69, 0x5d, 0x2c, 0x20, 0x74, 0x65, 0x78, 0x65, 0x6c, 
+	0x2c, 0x20, 0x30, 0x29, 0x2e, 0x72, 0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x72, 0x65, 0x74, 
+	0x75, 0x72, 0x6e, 0x20, 0x30, 0x2e, 0x30, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x62, 0x6f, 0x6f, 0x6c, 0x20, 0x69, 0x73, 0x42, 
+	0x6f, 0x78, 0x4f, 0x63, 0x63, 0x6c, 0x75, 0x64, 0x65, 0x64, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 
+	0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 0x62, 0x4d, 0x69, 0x6e, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 
+	0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 0x62, 0x4d, 0x61, 0x78, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 
+	0x74, 0x20, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 
+	0x53, 0x61, 0x6d, 0x65, 0x20, 0x74, 0x65, 0x73, 0x74, 0x20, 0x61, 0x73, 0x20, 0x60, 0x44, 0x65, 0x70, 0x74, 0x68, 0x50, 
+	0x79, 0x72, 0x61, 0x6d, 0x69, 0x64, 0x3a, 0x3a, 0x69, 0x73, 0x42, 0x6f, 0x78, 0x4f, 0x63, 0x63, 0x6c, 0x75, 0x64, 0x65, 
+	0x64, 0x60, 0x2c, 0x20, 0x6f, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x70, 0x79, 0x72, 0x61, 0x6d, 0x69, 0x64, 0x20, 0x74, 
+	0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x73, 0x0a, 0x0a, 0x09, 0x69, 0x66, 0x20, 0x28, 0x28, 0x75, 0x62, 0x6f, 0x5f, 0x63, 
+	0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x66, 0x6c, 0x61, 0x67, 0x73, 0x20, 0x26, 0x20, 0x63, 0x5f, 0x6f, 0x63, 0x63, 
+	0x6c, 0x75, 0x73, 0x69, 0x6f, 0x6e, 0x43, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x29, 0x20, 0x3d, 0x3d, 0x20, 0x30, 0x20, 
+	0x7c, 0x7c, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x70, 0x79, 0x72, 0x61, 0x6d, 
+	0x69, 0x64, 0x4c, 0x65, 0x76, 0x65, 0x6c, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x20, 0x3d, 0x3d, 0x20, 0x30, 0x29, 0x0a, 0x09, 
+	0x7b, 0x0a, 0x09, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x3b, 0x0a, 0x09, 0x7d, 
+	0x0a, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x76, 0x69, 0x65, 0x77, 0x4d, 0x6f, 
+	0x64, 0x65, 0x6c, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x70, 0x79, 
+	0x72, 0x61, 0x6d, 0x69, 0x64, 0x56, 0x69, 0x65, 0x77, 0x20, 0x2a, 0x20, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x3b, 0x0a, 0x0a, 
+	0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x6e, 0x64, 0x63, 0x4d, 0x69, 0x6e, 0x20, 0x3d, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 
+	0x33, 0x2e, 0x34, 0x65, 0x33, 0x38, 0x29, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x6e, 0x64, 0x63, 0x4d, 0x61, 
+	0x78, 0x20, 0x3d, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x2d, 0x33, 0x2e, 0x34, 0x65, 0x33, 0x38, 0x29, 0x3b, 0x0a, 0x09, 
+	0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6d, 0x69, 0x6e, 0x44, 0x65, 0x70, 0x74, 0x68, 0x20, 0x3d, 0x20, 0x33, 0x2e, 0x34, 
+	0x65, 0x33, 0x38, 0x3b, 0x0a, 0x0a, 0x09, 0x66, 0x6f, 0x72, 0x20, 0x28, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x20, 0x3d, 
+	0x20, 0x30, 0x3b, 0x20, 0x69, 0x20, 0x3c, 0x20, 0x38, 0x3b, 0x20, 0x2b, 0x2b, 0x69, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 
+	0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x63, 0x6f, 0x72, 0x6e, 0x65, 0x72, 0x20, 0x3d, 
+	0x20, 0x76, 0x65, 0x63, 0x34, 0x28, 0x28, 0x69, 0x20, 0x26, 0x20, 0x31, 0x75, 0x29, 0x20, 0x21, 0x3d, 0x20, 0x30, 0x75, 
+	0x20, 0x3f, 0x20, 0x62, 0x62, 0x4d, 0x61, 0x78, 0x2e, 0x78, 0x20, 0x3a, 0x20, 0x62, 0x62, 0x4d, 0x69, 0x6e, 0x2e, 0x78, 
+	0x2c, 0x20, 0x28, 0x69, 0x20, 0x26, 0x20, 0x32, 0x75, 0x29, 0x20, 0x21, 0x3d, 0x20, 0x30, 0x75, 0x20, 0x3f, 0x20, 0x62, 
+	0x62, 0x4d, 0x61, 0x78, 0x2e, 0x79, 0x20, 0x3a, 0x20, 0x62, 0x62, 0x4d, 0x69, 0x6e, 0x2e, 0x79, 0x2c, 0x20, 0x28, 0x69, 
+	0x20, 0x26, 0x20, 0x34, 0x75, 0x29, 0x20, 0x21, 0x3d, 0x20, 0x30, 0x75, 0x20, 0x3f, 0x20, 0x62, 0x62, 0x4d, 0x61, 0x78, 
+	0x2e, 0x7a, 0x20, 0x3a, 0x20, 0x62, 0x62, 0x4d, 0x69, 0x6e, 0x2e, 0x7a, 0x2c, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 
+	0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x69, 0x65, 0x77, 0x43, 0x6f, 0x72, 
+	0x6e, 0x65, 0x72, 0x20, 0x3d, 0x20, 0x76, 0x69, 0x65, 0x77, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x20, 0x2a, 0x20, 0x63, 0x6f, 
+	0x72, 0x6e, 0x65, 0x72, 0x3b, 0x0a, 0x0a, 0x09, 0x09, 0x69, 0x66, 0x20, 0x28, 0x2d, 0x76, 0x69, 0x65, 0x77, 0x43, 0x6f, 
+	0x72, 0x6e, 0x65, 0x72, 0x2e, 0x7a, 0x20, 0x3c, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 
+	0x67, 0x2e, 0x70, 0x79, 0x72, 0x61, 0x6d, 0x69, 0x64, 0x4e, 0x65, 0x61, 0x72, 0x29, 0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 
+	0x09, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 
+	0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x63, 0x6c, 0x69, 0x70, 0x43, 0x6f, 
+	0x72, 0x6e, 0x65, 0x72, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x70, 
+	0x79, 0x72, 0x61, 0x6d, 0x69, 0x64, 0x50, 0x72, 0x6f, 0x6a, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x2a, 0x20, 0x76, 
+	0x69, 0x65, 0x77, 0x43, 0x6f, 0x72, 0x6e, 0x65, 0x72, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 
+	0x65, 0x63, 0x32, 0x20, 0x6e, 0x64, 0x63, 0x43, 0x6f, 0x72, 0x6e, 0x65, 0x72, 0x20, 0x3d, 0x20, 0x63, 0x6c, 0x69, 0x70, 
+	0x43, 0x6f, 0x72, 0x6e, 0x65, 0x72, 0x2e, 0x78, 0x79, 0x20, 0x2f, 0x20, 0x63, 0x6c, 0x69, 0x70, 0x43, 0x6f, 0x72, 0x6e, 
+	0x65, 0x72, 0x2e, 0x77, 0x3b, 0x0a, 0x0a, 0x09, 0x09, 0x6e, 0x64, 0x63, 0x4d, 0x69, 0x6e, 0x20, 0x3d, 0x20, 0x6d, 0x69, 
+	0x6e, 0x28, 0x6e, 0x64, 0x63, 0x4d, 0x69, 0x6e, 0x2c, 0x20, 0x6e, 0x64, 0x63, 0x43, 0x6f, 0x72, 0x6e, 0x65, 0x72, 0x29, 
+	0x3b, 0x0a, 0x09, 0x09, 0x6e, 0x64, 0x63, 0x4d, 0x61, 0x78, 0x20, 0x3d, 0x20, 0x6d, 0x61, 0x78, 0x28, 0x6e, 0x64, 0x63, 
+	0x4d, 0x61, 0x78, 0x2c, 0x20, 0x6e, 0x64, 0x63, 0x43, 0x6f, 0x72, 0x6e, 0x65, 0x72, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x6d, 
+	0x69, 0x6e, 0x44, 0x65, 0x70, 0x74, 0x68, 0x20, 0x3d, 0x20, 0x6d, 0x69, 0x6e, 0x28, 0x6d, 0x69, 0x6e, 0x44, 0x65, 0x70, 
+	0x74, 0x68, 0x2c, 0x20, 0x28, 0x2d, 0x76, 0x69, 0x65, 0x77, 0x43, 0x6f, 0x72, 0x6e, 0x65, 0x72, 0x2e, 0x7a, 0x20, 0x2d, 
+	0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x70, 0x79, 0x72, 0x61, 0x6d, 0x69, 0x64, 
+	0x4e, 0x65, 0x61, 0x72, 0x29, 0x20, 0x2f, 0x20, 0x28, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 
+	0x2e, 0x70, 0x79, 0x72, 0x61, 0x6d, 0x69, 0x64, 0x46, 0x61, 0x72, 0x20, 0x2d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x75, 
+	0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x70, 0x79, 0x72, 0x61, 0x6d, 0x69, 0x64, 0x4e, 0x65, 0x61, 0x72, 0x29, 0x29, 0x3b, 
+	0x0a, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x69, 0x66, 0x20, 0x28, 0x61, 0x6e, 0x79, 0x28, 0x6c, 0x65, 0x73, 0x73, 0x54, 0x68, 
+	0x61, 0x6e, 0x28, 0x6e, 0x64, 0x63, 0x4d, 0x61, 0x78, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x2d, 0x31, 0x2e, 0x30, 
+	0x29, 0x29, 0x29, 0x20, 0x7c, 0x7c, 0x20, 0x61, 0x6e, 0x79, 0x28, 0x67, 0x72, 0x65, 0x61, 0x74, 0x65, 0x72, 0x54, 0x68, 
+	0x61, 0x6e, 0x28, 0x6e, 0x64, 0x63, 0x4d, 0x69, 0x6e, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x31, 0x2e, 0x30, 0x29, 
+	0x29, 0x29, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x66, 0x61, 0x6c, 0x73, 
+	0x65, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x73, 
+	0x69, 0x7a, 0x65, 0x20, 0x3d, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x75, 0x6c, 0x6c, 0x69, 
+	0x6e, 0x67, 0x2e, 0x72, 0x65, 0x73, 0x6f, 0x6c, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x3b, 0x0a, 0x09, 0x75, 0x76, 0x65, 
+	0x63, 0x32, 0x20, 0x62, 0x65, 0x67, 0x69, 0x6e, 0x20, 0x3d, 0x20, 0x75, 0x76, 0x65, 0x63, 0x32, 0x28, 0x63, 0x6c, 0x61, 
+	0x6d, 0x70, 0x28, 0x28, 0x6e, 0x64, 0x63, 0x4d, 0x69, 0x6e, 0x20, 0x2a, 0x20, 0x30, 0x2e, 0x35, 0x20, 0x2b, 0x20, 0x30, 
+	0x2e, 0x35, 0x29, 0x20, 0x2a, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x30, 0x2e, 0x30, 
+	0x29, 0x2c, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x20, 0x2d, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x29, 0x3b, 0x0a, 0x09, 0x75, 0x76, 
+	0x65, 0x63, 0x32, 0x20, 0x65, 0x6e, 0x64, 0x20, 0x3d, 0x20, 0x75, 0x76, 0x65, 0x63, 0x32, 0x28, 0x63, 0x6c, 0x61, 0x6d, 
+	0x70, 0x28, 0x28, 0x6e, 0x64, 0x63, 0x4d, 0x61, 0x78, 0x20, 0x2a, 0x20, 0x30, 0x2e, 0x35, 0x20, 0x2b, 0x20, 0x30, 0x2e, 
+	0x35, 0x29, 0x20, 0x2a, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x30, 0x2e, 0x30, 0x29, 
+	0x2c, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x20, 0x2d, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x75, 0x76, 
+	0x65, 0x63, 0x32, 0x20, 0x6c, 0x65, 0x76, 0x65, 0x6c, 0x53, 0x69, 0x7a, 0x65, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 
+	0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x72, 0x65, 0x73, 0x6f, 0x6c, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 
+	0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x6c, 0x65, 0x76, 0x65, 0x6c, 0x20, 0x3d, 0x20, 0x30, 0x3b, 0x0a, 0x09, 0x77, 0x68, 
+	0x69, 0x6c, 0x65, 0x20, 0x28, 0x6c, 0x65, 0x76, 0x65, 0x6c, 0x20, 0x3d, 0x3d, 0x20, 0x30, 0x20, 0x7c, 0x7c, 0x20, 0x28, 
+	0x6c, 0x65, 0x76, 0x65, 0x6c, 0x20, 0x2b, 0x20, 0x31, 0x20, 0x3c, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x75, 0x6c, 0x6c, 
+	0x69, 0x6e, 0x67, 0x2e, 0x70, 0x79, 0x72, 0x61, 0x6d, 0x69, 0x64, 0x4c, 0x65, 0x76, 0x65, 0x6c, 0x43, 0x6f, 0x75, 0x6e, 
+	0x74, 0x20, 0x26, 0x26, 0x20, 0x28, 0x65, 0x6e, 0x64, 0x2e, 0x78, 0x20, 0x2d, 0x20, 0x62, 0x65, 0x67, 0x69, 0x6e, 0x2e, 
+	0x78, 0x20, 0x3e, 0x20, 0x31, 0x75, 0x20, 0x7c, 0x7c, 0x20, 0x65, 0x6e, 0x64, 0x2e, 0x79, 0x20, 0x2d, 0x20, 0x62, 0x65, 
+	0x67, 0x69, 0x6e, 0x2e, 0x79, 0x20, 0x3e, 0x20, 0x31, 0x75, 0x29, 0x29, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x2b, 
+	0x2b, 0x6c, 0x65, 0x76, 0x65, 0x6c, 0x3b, 0x0a, 0x0a, 0x09, 0x09, 0x6c, 0x65, 0x76, 0x65, 0x6c, 0x53, 0x69, 0x7a, 0x65, 
+	0x20, 0x3d, 0x20, 0x6d, 0x61, 0x78, 0x28, 0x6c, 0x65, 0x76, 0x65, 0x6c, 0x53, 0x69, 0x7a, 0x65, 0x20, 0x2f, 0x20, 0x32, 
+	0x75, 0x2c, 0x20, 0x75, 0x76, 0x65, 0x63, 0x32, 0x28, 0x31, 0x75, 0x29, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x62, 0x65, 0x67, 
+	0x69, 0x6e, 0x20, 0x3d, 0x20, 0x6d, 0x69, 0x6e, 0x28, 0x62, 0x65, 0x67, 0x69, 0x6e, 0x20, 0x2f, 0x20, 0x32, 0x75, 0x2c, 
+	0x20, 0x6c, 0x65, 0x76, 0x65, 0x6c, 0x53, 0x69, 0x7a, 0x65, 0x20, 0x2d, 0x20, 0x31, 0x75, 0x29, 0x3b, 0x0a, 0x09, 0x09, 
+	0x65, 0x6e, 0x64, 0x20, 0x3d, 0x20, 0x6d, 0x69, 0x6e, 0x28, 0x65, 0x6e, 0x64, 0x20, 0x2f, 0x20, 0x32, 0x75, 0x2c, 0x20, 
+	0x6c, 0x65, 0x76, 0x65, 0x6c, 0x53, 0x69, 0x7a, 0x65, 0x20, 0x2d, 0x20, 0x31, 0x75, 0x29, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 
+	0x0a, 0x09, 0x66, 0x6f, 0x72, 0x20, 0x28, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x79, 0x20, 0x3d, 0x20, 0x62, 0x65, 0x67, 0x69, 
+	0x6e, 0x2e, 0x79, 0x3b, 0x20, 0x79, 0x20, 0x3c, 0x3d, 0x20, 0x65, 0x6e, 0x64, 0x2e, 0x79, 0x3b, 0x20, 0x2b, 0x2b, 0x79, 
+	0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x66, 0x6f, 0x72, 0x20, 0x28, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x78, 0x20, 0x3d, 
+	0x20, 0x62, 0x65, 0x67, 0x69, 0x6e, 0x2e, 0x78, 0x3b, 0x20, 0x78, 0x20, 0x3c, 0x3d, 0x20, 0x65, 0x6e, 0x64, 0x2e, 0x78, 
+	0x3b, 0x20, 0x2b, 0x2b, 0x78, 0x29, 0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x69, 0x66, 0x20, 0x28, 0x66, 0x65, 
+	0x74, 0x63, 0x68, 0x50, 0x79, 0x72, 0x61, 0x6d, 0x69, 0x64, 0x44, 0x65, 0x70, 0x74, 0x68, 0x28, 0x6c, 0x65, 0x76, 0x65, 
+	0x6c, 0x2c, 0x20, 0x69, 0x76, 0x65, 0x63, 0x32, 0x28, 0x78, 0x2c, 0x20, 0x79, 0x29, 0x29, 0x20, 0x3e, 0x3d, 0x20, 0x6d, 
+	0x69, 0x6e, 0x44, 0x65, 0x70, 0x74, 0x68, 0x29, 0x0a, 0x09, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x72, 0x65, 
+	0x74, 0x75, 0x72, 0x6e, 0x20, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x7d, 
+	0x0a, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x74, 0x72, 0x75, 0x65, 0x3b, 0x0a, 0x7d, 
+	0x0a, 0x0a, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x73, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x4c, 0x6f, 0x64, 0x28, 0x69, 0x6e, 0x20, 
+	0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x43, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 
+	0x67, 0x44, 0x61, 0x74, 0x61, 0x20, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 
+	0x6e, 0x73, 0x74, 0x20, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x76, 0x69, 0x65, 0x77, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x2c, 0x20, 
+	0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x70, 0x72, 0x6f, 0x6a, 0x65, 0x63, 
+	0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 
+	0x68, 0x65, 0x69, 0x67, 0x68, 0x74, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 
+	0x74, 0x20, 0x62, 0x69, 0x61, 0x73, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x53, 0x61, 0x6d, 0x65, 0x20, 0x73, 
+	0x65, 0x6c, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x61, 0x73, 0x20, 0x60, 0x53, 0x63, 0x65, 0x6e, 0x65, 0x3a, 0x3a, 
+	0x5f, 0x73, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x4c, 0x6f, 0x64, 0x60, 0x0a, 0x0a, 0x09, 0x69, 0x66, 0x20, 0x28, 0x28, 0x75, 
+	0x62, 0x6f, 0x5f, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x66, 0x6c, 0x61, 0x67, 0x73, 0x20, 0x26, 0x20, 0x63, 
+	0x5f, 0x6c, 0x6f, 0x64, 0x53, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x20, 0x3d, 0x3d, 0x20, 0x30, 0x20, 
+	0x7c, 0x7c, 0x20, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x6c, 0x6f, 0x64, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x20, 
+	0x3c, 0x3d, 0x20, 0x31, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x30, 0x3b, 
+	0x0a, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x65, 0x6e, 
+	0x74, 0x65, 0x72, 0x20, 0x3d, 0x20, 0x28, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x62, 0x6f, 0x75, 0x6e, 0x64, 
+	0x69, 0x6e, 0x67, 0x42, 0x6f, 0x78, 0x4d, 0x69, 0x6e, 0x20, 0x2b, 0x20, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 
+	0x62, 0x6f, 0x75, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x42, 0x6f, 0x78, 0x4d, 0x61, 0x78, 0x29, 0x20, 0x2a, 0x20, 0x30, 0x2e, 
+	0x35, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6c, 0x6f, 0x63, 0x61, 
+	0x6c, 0x52, 0x61, 0x64, 0x69, 0x75, 0x73, 0x20, 0x3d, 0x20, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x28, 0x63, 0x75, 0x6c, 
+	0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x62, 0x6f, 0x75, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x42, 0x6f, 0x78, 0x4d, 0x61, 0x78, 0x20, 
+	0x2d, 0x20, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x62, 0x6f, 0x75, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x42, 0x6f, 
+	0x78, 0x4d, 0x69, 0x6e, 0x29, 0x20, 0x2a, 0x20, 0x30, 0x2e, 0x35, 0x3b, 0x0a, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 
+	0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x69, 0x65, 0x77, 0x43, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x20, 0x3d, 0x20, 0x76, 
+	0x69, 0x65, 0x77, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x20, 0x2a, 0x20, 0x76, 0x65, 0x63, 0x34, 0x28, 0x63, 0x65, 0x6e, 0x74, 
+	0x65, 0x72, 0x2c, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 
+	0x61, 0x74, 0x20, 0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x20, 0x3d, 0x20, 0x6c, 0x6f, 0x63, 0x61, 0x6c, 0x52, 0x61, 0x64, 
+	0x69, 0x75, 0x73, 0x20, 0x2a, 0x20, 0x67, 0x65, 0x74, 0x4d, 0x61, 0x78, 0x53, 0x63, 0x61, 0x6c, 0x65, 0x28, 0x76, 0x69, 
+	0x65, 0x77, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 
+	0x63, 0x34, 0x20, 0x63, 0x6c, 0x69, 0x70, 0x43, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x20, 0x3d, 0x20, 0x70, 0x72, 0x6f, 0x6a, 
+	0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x2a, 0x20, 0x76, 0x69, 0x65, 0x77, 0x43, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x3b, 
+	0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x63, 0x6c, 0x69, 0x70, 0x52, 0x61, 0x64, 
+	0x69, 0x75, 0x73, 0x20, 0x3d, 0x20, 0x70, 0x72, 0x6f, 0x6a, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x2a, 0x20, 0x76, 
+	0x65, 0x63, 0x34, 0x28, 0x30, 0x2e, 0x30, 0x2c, 0x20, 0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x2c, 0x20, 0x30, 0x2e, 0x30, 
+	0x2c, 0x20, 0x30, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x09, 0x69, 0x66, 0x20, 0x28, 0x63, 0x6c, 0x69, 0x70, 0x43, 0x65, 0x6e, 
+	0x74, 0x65, 0x72, 0x2e, 0x77, 0x20, 0x3c, 0x3d, 0x20, 0x30, 0x2e, 0x30, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x72, 
+	0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x30, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 
+	0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x70, 0x69, 0x78, 0x65, 0x6c, 0x52, 0x61, 0x64, 0x69, 0x75, 0x73, 0x20, 0x3d, 0x20, 
+	0x61, 0x62, 0x73, 0x28, 0x63, 0x6c, 0x69, 0x70, 0x52, 0x61, 0x64, 0x69, 0x75, 0x73, 0x2e, 0x79, 0x29, 0x20, 0x2f, 0x20, 
+	0x63, 0x6c, 0x69, 0x70, 0x43, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x2e, 0x77, 0x20, 0x2a, 0x20, 0x68, 0x65, 0x69, 0x67, 0x68, 
+	0x74, 0x20, 0x2a, 0x20, 0x30, 0x2e, 0x35, 0x3b, 0x0a, 0x0a, 0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x6c, 0x6f, 0x64, 0x20, 
+	0x3d, 0x20, 0x30, 0x3b, 0x0a, 0x09, 0x77, 0x68, 0x69, 0x6c, 0x65, 0x20, 0x28, 0x6c, 0x6f, 0x64, 0x20, 0x2b, 0x20, 0x31, 
+	0x20, 0x3c, 0x20, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x6c, 0x6f, 0x64, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x20, 
+	0x26, 0x26, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x6c, 0x6f, 0x64, 0x73, 0x5b, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 
+	0x2e, 0x6c, 0x6f, 0x64, 0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x20, 0x2b, 0x20, 0x6c, 0x6f, 0x64, 0x20, 0x2b, 0x20, 0x31, 
+	0x5d, 0x2e, 0x65, 0x72, 0x72, 0x6f, 0x72, 0x20, 0x2a, 0x20, 0x70, 0x69, 0x78, 0x65, 0x6c, 0x52, 0x61, 0x64, 0x69, 0x75, 
+	0x73, 0x20, 0x3c, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x6c, 0x6f, 0x64, 
+	0x45, 0x72, 0x72, 0x6f, 0x72, 0x54, 0x68, 0x72, 0x65, 0x73, 0x68, 0x6f, 0x6c, 0x64, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 
+	0x09, 0x2b, 0x2b, 0x6c, 0x6f, 0x64, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 
+	0x6d, 0x69, 0x6e, 0x28, 0x6c, 0x6f, 0x64, 0x20, 0x2b, 0x20, 0x62, 0x69, 0x61, 0x73, 0x2c, 0x20, 0x63, 0x75, 0x6c, 0x6c, 
+	0x69, 0x6e, 0x67, 0x2e, 0x6c, 0x6f, 0x64, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x20, 0x2d, 0x20, 0x31, 0x29, 0x3b, 0x0a, 0x7d, 
+	0x0a, 0x0a, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x73, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4c, 
+	0x6f, 0x64, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 
+	0x44, 0x61, 0x74, 0x61, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 
+	0x6e, 0x73, 0x74, 0x20, 0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x43, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x44, 
+	0x61, 0x74, 0x61, 0x20, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x54, 
+	0x68, 0x65, 0x20, 0x63, 0x61, 0x73, 0x74, 0x65, 0x72, 0x20, 0x69, 0x73, 0x20, 0x64, 0x72, 0x61, 0x77, 0x6e, 0x20, 0x69, 
+	0x6e, 0x20, 0x61, 0x6c, 0x6c, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x20, 0x6d, 0x61, 0x70, 
+	0x73, 0x20, 0x61, 0x74, 0x20, 0x6f, 0x6e, 0x63, 0x65, 0x2c, 0x20, 0x77, 0x69, 0x74, 0x68, 0x20, 0x74, 0x68, 0x65, 0x20, 
+	0x66, 0x69, 0x6e, 0x65, 0x73, 0x74, 0x20, 0x4c, 0x4f, 0x44, 0x20, 0x6f, 0x66, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x68, 
+	0x61, 0x64, 0x6f, 0x77, 0x20, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x0a, 0x0a, 0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 
+	0x6c, 0x6f, 0x64, 0x20, 0x3d, 0x20, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x6c, 0x6f, 0x64, 0x43, 0x6f, 0x75, 
+	0x6e, 0x74, 0x20, 0x2d, 0x20, 0x31, 0x3b, 0x0a, 0x09, 0x66, 0x6f, 0x72, 0x20, 0x28, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 
+	0x20, 0x3d, 0x20, 0x30, 0x3b, 0x20, 0x69, 0x20, 0x3c, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 
+	0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x2e, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x20, 0x2b, 0x2b, 0x69, 0x29, 0x0a, 
+	0x09, 0x7b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 
+	0x65, 0x72, 0x61, 0x44, 0x61, 0x74, 0x61, 0x20, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 
+	0x5f, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x2e, 0x63, 0x61, 0x6d, 0x65, 0x72, 
+	0x61, 0x73, 0x5b, 0x69, 0x5d, 0x3b, 0x0a, 0x09, 0x09, 0x6c, 0x6f, 0x64, 0x20, 0x3d, 0x20, 0x6d, 0x69, 0x6e, 0x28, 0x6c, 
+	0x6f, 0x64, 0x2c, 0x20, 0x73, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x4c, 0x6f, 0x64, 0x28, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 
+	0x67, 0x2c, 0x20, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 0x76, 0x69, 0x65, 0x77, 0x20, 0x2a, 0x20, 0x64, 0x72, 0x61, 
+	0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x2c, 0x20, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 
+	0x70, 0x72, 0x6f, 0x6a, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x75, 0x6c, 0x6c, 
+	0x69, 0x6e, 0x67, 0x2e, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x52, 0x65, 0x73, 0x6f, 0x6c, 0x75, 0x74, 0x69, 0x6f, 0x6e, 
+	0x2e, 0x79, 0x2c, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x73, 0x68, 0x61, 0x64, 
+	0x6f, 0x77, 0x4c, 0x6f, 0x64, 0x42, 0x69, 0x61, 0x73, 0x29, 0x29, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x72, 0x65, 
+	0x74, 0x75, 0x72, 0x6e, 0x20, 0x6c, 0x6f, 0x64, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x65, 0x6d, 
+	0x69, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x73, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 
+	0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 
+	0x20, 0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x44, 0x61, 0x74, 0x61, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 
+	0x6c, 0x65, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 
+	0x65, 0x43, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x44, 0x61, 0x74, 0x61, 0x20, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 
+	0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x63, 0x6f, 0x6d, 0x6d, 
+	0x61, 0x6e, 0x64, 0x49, 0x6e, 0x64, 0x65, 0x78, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x75, 0x6c, 0x6c, 0x69, 
+	0x6e, 0x67, 0x2e, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x20, 0x2b, 0x20, 0x63, 
+	0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x63, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 
+	0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x6c, 0x6f, 0x64, 0x20, 0x3d, 0x20, 
+	0x73, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x4c, 0x6f, 0x64, 0x28, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2c, 0x20, 0x64, 
+	0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x76, 0x69, 0x65, 0x77, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x2c, 0x20, 0x75, 
+	0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 0x70, 0x72, 0x6f, 0x6a, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 
+	0x2c, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x72, 0x65, 0x73, 0x6f, 0x6c, 0x75, 
+	0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x79, 0x2c, 0x20, 0x30, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x69, 0x66, 0x20, 0x28, 0x6c, 0x6f, 
+	0x64, 0x20, 0x21, 0x3d, 0x20, 0x30, 0x20, 0x7c, 0x7c, 0x20, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x6d, 0x65, 
+	0x73, 0x68, 0x6c, 0x65, 0x74, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x20, 0x3d, 0x3d, 0x20, 0x30, 0x20, 0x7c, 0x7c, 0x20, 0x28, 
+	0x75, 0x62, 0x6f, 0x5f, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x66, 0x6c, 0x61, 0x67, 0x73, 0x20, 0x26, 0x20, 
+	0x63, 0x5f, 0x63, 0x6c, 0x75, 0x73, 0x74, 0x65, 0x72, 0x43, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x29, 0x20, 0x3d, 0x3d, 
+	0x20, 0x30, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x4c, 0x6f, 0x64, 0x44, 0x61, 
+	0x74, 0x61, 0x20, 0x6c, 0x6f, 0x64, 0x44, 0x61, 0x74, 0x61, 0x20, 0x3d, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x6c, 0x6f, 
+	0x64, 0x73, 0x5b, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x6c, 0x6f, 0x64, 0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 
+	0x20, 0x2b, 0x20, 0x6c, 0x6f, 0x64, 0x5d, 0x3b, 0x0a, 0x09, 0x09, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x63, 0x6f, 0x6d, 0x6d, 
+	0x61, 0x6e, 0x64, 0x73, 0x5b, 0x63, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x49, 0x6e, 0x64, 0x65, 0x78, 0x5d, 0x20, 0x3d, 
+	0x20, 0x44, 0x72, 0x61, 0x77, 0x43, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x28, 0x6c, 0x6f, 0x64, 0x44, 0x61, 0x74, 0x61, 
+	0x2e, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x2c, 0x20, 0x31, 0x75, 0x2c, 0x20, 0x6c, 0x6f, 0x64, 
+	0x44, 0x61, 0x74, 0x61, 0x2e, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x2c, 0x20, 0x30, 0x2c, 
+	0x20, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x63, 0x6f, 0x75, 0x6e, 
+	0x74, 0x73, 0x5b, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x5d, 0x20, 0x3d, 0x20, 0x31, 0x3b, 0x0a, 0x09, 0x09, 0x72, 0x65, 0x74, 
+	0x75, 0x72, 0x6e, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x53, 0x61, 0x6d, 0x65, 0x20, 0x63, 0x75, 
+	0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x20, 0x61, 0x73, 0x20, 0x60, 0x53, 0x63, 0x65, 0x6e, 0x65, 0x3a, 0x3a, 0x5f, 0x63, 0x75, 
+	0x6c, 0x6c, 0x4d, 0x65, 0x73, 0x68, 0x6c, 0x65, 0x74, 0x73, 0x60, 0x2c, 0x20, 0x76, 0x69, 0x73, 0x69, 0x62, 0x6c, 0x65, 
+	0x20, 0x6d, 0x65, 0x73, 0x68, 0x6c, 0x65, 0x74, 0x73, 0x20, 0x63, 0x6f, 0x6e, 0x74, 0x69, 0x67, 0x75, 0x6f, 0x75, 0x73, 
+	0x20, 0x69, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x20, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 
+	0x20, 0x73, 0x68, 0x61, 0x72, 0x65, 0x20, 0x61, 0x20, 0x63, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x0a, 0x0a, 0x09, 0x63, 
+	0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x20, 0x3d, 0x20, 0x67, 
+	0x65, 0x74, 0x4d, 0x61, 0x78, 0x53, 0x63, 0x61, 0x6c, 0x65, 0x28, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 
+	0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x29, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
+	0x20, 0x63, 0x6f, 0x6e, 0x65, 0x53, 0x69, 0x67, 0x6e, 0x20, 0x3d, 0x20, 0x28, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 
+	0x2e, 0x66, 0x6c, 0x61, 0x67, 0x73, 0x20, 0x26, 0x20, 0x63, 0x5f, 0x63, 0x6f, 0x6e, 0x65, 0x46, 0x6c, 0x69, 0x70, 0x70, 
+	0x65, 0x64, 0x29, 0x20, 0x21, 0x3d, 0x20, 0x30, 0x20, 0x3f, 0x20, 0x2d, 0x31, 0x2e, 0x30, 0x20, 0x3a, 0x20, 0x31, 0x2e, 
+	0x30, 0x3b, 0x0a, 0x0a, 0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x63, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x43, 0x6f, 0x75, 
+	0x6e, 0x74, 0x20, 0x3d, 0x20, 0x30, 0x3b, 0x0a, 0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x72, 0x61, 0x6e, 0x67, 0x65, 0x4f, 
+	0x66, 0x66, 0x73, 0x65, 0x74, 0x20, 0x3d, 0x20, 0x30, 0x3b, 0x0a, 0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x72, 0x61, 0x6e, 
+	0x67, 0x65, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x30, 0x3b, 0x0a, 0x0a, 0x09, 0x66, 0x6f, 0x72, 0x20, 0x28, 
+	0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x20, 0x3d, 0x20, 0x30, 0x3b, 0x20, 0x69, 0x20, 0x3c, 0x20, 0x63, 0x75, 0x6c, 0x6c, 
+	0x69, 0x6e, 0x67, 0x2e, 0x6d, 0x65, 0x73, 0x68, 0x6c, 0x65, 0x74, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x20, 0x2b, 0x2b, 
+	0x69, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x4d, 0x65, 0x73, 0x68, 0x6c, 0x65, 
+	0x74, 0x44, 0x61, 0x74, 0x61, 0x20, 0x6d, 0x65, 0x73, 0x68, 0x6c, 0x65, 0x74, 0x20, 0x3d, 0x20, 0x73, 0x73, 0x62, 0x6f, 
+	0x5f, 0x6d, 0x65, 0x73, 0x68, 0x6c, 0x65, 0x74, 0x73, 0x5b, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x6d, 0x65, 
+	0x73, 0x68, 0x6c, 0x65, 0x74, 0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x20, 0x2b, 0x20, 0x69, 0x5d, 0x3b, 0x0a, 0x0a, 0x09, 
+	0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x20, 0x3d, 
+	0x20, 0x28, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x20, 0x2a, 0x20, 0x76, 
+	0x65, 0x63, 0x34, 0x28, 0x6d, 0x65, 0x73, 0x68, 0x6c, 0x65, 0x74, 0x2e, 0x63, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x2c, 0x20, 
+	0x31, 0x2e, 0x30, 0x29, 0x29, 0x2e, 0x78, 0x79, 0x7a, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 
+	0x6c, 0x6f, 0x61, 0x74, 0x20, 0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x20, 0x3d, 0x20, 0x6d, 0x65, 0x73, 0x68, 0x6c, 0x65, 
+	0x74, 0x2e, 0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x20, 0x2a, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x3b, 0x0a, 0x0a, 0x09, 
+	0x09, 0x69, 0x66, 0x20, 0x28, 0x21, 0x69, 0x73, 0x53, 0x70, 0x68, 0x65, 0x72, 0x65, 0x49, 0x6e, 0x46, 0x72, 0x75, 0x73, 
+	0x74, 0x75, 0x6d, 0x28, 0x63, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x2c, 0x20, 0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x29, 0x29, 
+	0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x74, 0x69, 0x6e, 0x75, 0x65, 0x3b, 0x0a, 0x09, 0x09, 
+	0x7d, 0x0a, 0x0a, 0x09, 0x09, 0x69, 0x66, 0x20, 0x28, 0x28, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x66, 0x6c, 
+	0x61, 0x67, 0x73, 0x20, 0x26, 0x20, 0x63, 0x5f, 0x63, 0x6f, 0x6e, 0x65, 0x43, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x29, 
+	0x20, 0x21, 0x3d, 0x20, 0x30, 0x20, 0x26, 0x26, 0x20, 0x6d, 0x65, 0x73, 0x68, 0x6c, 0x65, 0x74, 0x2e, 0x63, 0x6f, 0x6e, 
+	0x65, 0x43, 0x75, 0x74, 0x6f, 0x66, 0x66, 0x20, 0x3c, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 
+	0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x61, 0x78, 0x69, 0x73, 0x20, 0x3d, 0x20, 
+	0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x28, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 
+	0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x20, 0x2a, 0x20, 0x76, 0x65, 0x63, 0x34, 0x28, 0x6d, 0x65, 0x73, 0x68, 0x6c, 0x65, 0x74, 
+	0x2e, 0x63, 0x6f, 0x6e, 0x65, 0x41, 0x78, 0x69, 0x73, 0x2c, 0x20, 0x30, 0x2e, 0x30, 0x29, 0x29, 0x2e, 0x78, 0x79, 0x7a, 
+	0x29, 0x20, 0x2a, 0x20, 0x63, 0x6f, 0x6e, 0x65, 0x53, 0x69, 0x67, 0x6e, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x63, 0x6f, 0x6e, 
+	0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 
+	0x63, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x20, 0x2d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x75, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 
+	0x2e, 0x65, 0x79, 0x65, 0x3b, 0x0a, 0x0a, 0x09, 0x09, 0x09, 0x69, 0x66, 0x20, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x64, 0x69, 
+	0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x61, 0x78, 0x69, 0x73, 0x29, 0x20, 0x3e, 0x3d, 0x20, 0x6d, 0x65, 
+	0x73, 0x68, 0x6c, 0x65, 0x74, 0x2e, 0x63, 0x6f, 0x6e, 0x65, 0x43, 0x75, 0x74, 0x6f, 0x66, 0x66, 0x20, 0x2a, 0x20, 0x6c, 
+	0x65, 0x6e, 0x67, 0x74, 0x68, 0x28, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x20, 0x2b, 0x20, 0x72, 
+	0x61, 0x64, 0x69, 0x75, 0x73, 0x29, 0x0a, 0x09, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x74, 
+	0x69, 0x6e, 0x75, 0x65, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x09, 0x69, 0x66, 
+	0x20, 0x28, 0x72, 0x61, 0x6e, 0x67, 0x65, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x20, 0x21, 0x3d, 0x20, 0x30, 0x20, 0x26, 0x26, 
+	0x20, 0x72, 0x61, 0x6e, 0x67, 0x65, 0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x20, 0x2b, 0x20, 0x72, 0x61, 0x6e, 0x67, 0x65, 
+	0x43, 0x6f, 0x75, 0x6e, 0x74, 0x20, 0x3d, 0x3d, 0x20, 0x6d, 0x65, 0x73, 0x68, 0x6c, 0x65, 0x74, 0x2e, 0x69, 0x6e, 0x64, 
+	0x65, 0x78, 0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x29, 0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x72, 0x61, 0x6e, 
+	0x67, 0x65, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x20, 0x2b, 0x3d, 0x20, 0x6d, 0x65, 0x73, 0x68, 0x6c, 0x65, 0x74, 0x2e, 0x69, 
+	0x6e, 0x64, 0x65, 0x78, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x65, 0x6c, 0x73, 
+	0x65, 0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x69, 0x66, 0x20, 0x28, 0x72, 0x61, 0x6e, 0x67, 0x65, 0x43, 0x6f, 
+	0x75, 0x6e, 0x74, 0x20, 0x21, 0x3d, 0x20, 0x30, 0x29, 0x0a, 0x09, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x73, 
+	0x73, 0x62, 0x6f, 0x5f, 0x63, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x73, 0x5b, 0x63, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 
+	0x49, 0x6e, 0x64, 0x65, 0x78, 0x20, 0x2b, 0x20, 0x63, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x43, 0x6f, 0x75, 0x6e, 0x74, 
+	0x5d, 0x20, 0x3d, 0x20, 0x44, 0x72, 0x61, 0x77, 0x43, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x28, 0x72, 0x61, 0x6e, 0x67, 
+	0x65, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x2c, 0x20, 0x31, 0x75, 0x2c, 0x20, 0x72, 0x61, 0x6e, 0x67, 0x65, 0x4f, 0x66, 0x66, 
+	0x73, 0x65, 0x74, 0x2c, 0x20, 0x30, 0x2c, 0x20, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x09, 
+	0x2b, 0x2b, 0x63, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x7d, 
+	0x0a, 0x0a, 0x09, 0x09, 0x09, 0x72, 0x61, 0x6e, 0x67, 0x65, 0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x20, 0x3d, 0x20, 0x6d, 
+	0x65, 0x73, 0x68, 0x6c, 0x65, 0x74, 0x2e, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x3b, 0x0a, 
+	0x09, 0x09, 0x09, 0x72, 0x61, 0x6e, 0x67, 0x65, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x6d, 0x65, 0x73, 0x68, 
+	0x6c, 0x65, 0x74, 0x2e, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 
+	0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x69, 0x66, 0x20, 0x28, 0x72, 0x61, 0x6e, 0x67, 0x65, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x20, 
+	0x21, 0x3d, 0x20, 0x30, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x63, 0x6f, 0x6d, 0x6d, 
+	0x61, 0x6e, 0x64, 0x73, 0x5b, 0x63, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x49, 0x6e, 0x64, 0x65, 0x78, 0x20, 0x2b, 0x20, 
+	0x63, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x5d, 0x20, 0x3d, 0x20, 0x44, 0x72, 0x61, 0x77, 
+	0x43, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x28, 0x72, 0x61, 0x6e, 0x67, 0x65, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x2c, 0x20, 
+	0x31, 0x75, 0x2c, 0x20, 0x72, 0x61, 0x6e, 0x67, 0x65, 0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x2c, 0x20, 0x30, 0x2c, 0x20, 
+	0x69, 0x6e, 0x64, 0x65, 0x78, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x2b, 0x2b, 0x63, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x43, 
+	0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x63, 0x6f, 0x75, 0x6e, 
+	0x74, 0x73, 0x5b, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x5d, 0x20, 0x3d, 0x20, 0x63, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x43, 
+	0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x0a, 0x7d, 0x0a, 0x00
+};
+
+static constexpr char depthPyramid_frag[] = {
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x0a, 
+	0x2f, 0x2f, 0x21, 0x20, 0x5c, 0x66, 0x69, 0x6c, 0x65, 0x0a, 0x2f, 0x2f, 0x21, 0x20, 0x5c, 0x61, 0x75, 0x74, 0x68, 0x6f, 
+	0x72, 0x20, 0x52, 0x65, 0x69, 0x65, 0x78, 0x0a, 0x2f, 0x2f, 0x21, 0x20, 0x5c, 0x63, 0x6f, 0x70, 0x79, 0x72, 0x69, 0x67, 
+	0x68, 0x74, 0x20, 0x54, 0x68, 0x65, 0x20, 0x4d, 0x49, 0x54, 0x20, 0x4c, 0x69, 0x63, 0x65, 0x6e, 0x73, 0x65, 0x20, 0x28, 
+	0x4d, 0x49, 0x54, 0x29, 0x0a, 0x2f, 0x2f, 0x21, 0x20, 0x5c, 0x64, 0x61, 0x74, 0x65, 0x20, 0x32, 0x30, 0x32, 0x33, 0x0a, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x0a, 
+	0x0a, 0x2f, 0x2f, 0x20, 0x55, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x73, 0x0a, 0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 
+	0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 0x5f, 0x64, 0x65, 0x70, 0x74, 0x68, 0x3b, 
+	0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x72, 0x61, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x6f, 0x75, 0x74, 0x70, 0x75, 0x74, 
+	0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 
+	0x3d, 0x20, 0x30, 0x29, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x66, 0x6f, 0x5f, 0x64, 0x65, 
+	0x70, 0x74, 0x68, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x64, 0x65, 
+	0x66, 0x69, 0x6e, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 
+	0x28, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x4d, 0x61, 0x78, 0x20, 0x6f, 0x66, 0x20, 0x74, 0x68, 0x65, 0x20, 
+	0x32, 0x78, 0x32, 0x20, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x73, 0x20, 0x6f, 0x66, 0x20, 0x74, 0x68, 0x65, 0x20, 0x70, 0x72, 
+	0x65, 0x76, 0x69, 0x6f, 0x75, 0x73, 0x20, 0x6c, 0x65, 0x76, 0x65, 0x6c, 0x2c, 0x20, 0x65, 0x78, 0x74, 0x65, 0x6e, 0x64, 
+	0x65, 0x64, 0x20, 0x74, 0x6f, 0x20, 0x33, 0x20, 0x6f, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6c, 0x61, 0x73, 0x74, 0x20, 
+	0x72, 0x6f, 0x77, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x63, 0x6f, 0x6c, 0x75, 0x6d, 0x6e, 0x20, 0x6f, 0x66, 0x20, 0x6f, 0x64, 
+	0x64, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x73, 0x0a, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x69, 0x76, 0x65, 0x63, 
+	0x32, 0x20, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x53, 0x69, 0x7a, 0x65, 0x20, 0x3d, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 
+	0x65, 0x53, 0x69, 0x7a, 0x65, 0x28, 0x75, 0x5f, 0x64, 0x65, 0x70, 0x74, 0x68, 0x2c, 0x20, 0x30, 0x29, 0x3b, 0x0a, 0x09, 
+	0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x69, 0x76, 0x65, 0x63, 0x32, 0x20, 0x6f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x53, 0x69, 
+	0x7a, 0x65, 0x20, 0x3d, 0x20, 0x6d, 0x61, 0x78, 0x28, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x53, 0x69, 0x7a, 0x65, 0x20, 0x2f, 
+	0x20, 0x32, 0x2c, 0x20, 0x69, 0x76, 0x65, 0x63, 0x32, 0x28, 0x31, 0x29, 0x29, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 
+	0x74, 0x20, 0x69, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x20, 0x3d, 0x20, 0x69, 0x76, 0x65, 0x63, 
+	0x32, 0x28, 0x67, 0x6c, 0x5f, 0x46, 0x72, 0x61, 0x67, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x2e, 0x78, 0x79, 0x29, 0x3b, 0x0a, 
+	0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x69, 0x76, 0x65, 0x63, 0x32, 0x20, 0x62, 0x65, 0x67, 0x69, 0x6e, 0x20, 
+	0x3d, 0x20, 0x32, 0x20, 0x2a, 0x20, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 
+	0x69, 0x76, 0x65, 0x63, 0x32, 0x20, 0x65, 0x6e, 0x64, 0x20, 0x3d, 0x20, 0x69, 0x76, 0x65, 0x63, 0x32, 0x28, 0x0a, 0x09, 
+	0x09, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x2e, 0x78, 0x20, 0x3d, 0x3d, 0x20, 0x6f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x53, 0x69, 
+	0x7a, 0x65, 0x2e, 0x78, 0x20, 0x2d, 0x20, 0x31, 0x20, 0x3f, 0x20, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x53, 0x69, 0x7a, 0x65, 
+	0x2e, 0x78, 0x20, 0x2d, 0x20, 0x31, 0x20, 0x3a, 0x20, 0x6d, 0x69, 0x6e, 0x28, 0x62, 0x65, 0x67, 0x69, 0x6e, 0x2e, 0x78, 
+	0x20, 0x2b, 0x20, 0x31, 0x2c, 0x20, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x53, 0x69, 0x7a, 0x65, 0x2e, 0x78, 0x20, 0x2d, 0x20, 
+	0x31, 0x29, 0x2c, 0x0a, 0x09, 0x09, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x2e, 0x79, 0x20, 0x3d, 0x3d, 0x20, 0x6f, 0x75, 0x74, 
+	0x70, 0x75, 0x74, 0x53, 0x69, 0x7a, 0x65, 0x2e, 0x79, 0x20, 0x2d, 0x20, 0x31, 0x20, 0x3f, 0x20, 0x69, 0x6e, 0x70, 0x75, 
+	0x74, 0x53, 0x69, 0x7a, 0x65, 0x2e, 0x79, 0x20, 0x2d, 0x20, 0x31, 0x20, 0x3a, 0x20, 0x6d, 0x69, 0x6e, 0x28, 0x62, 0x65, 
+	0x67, 0x69, 0x6e, 0x2e, 0x79, 0x20, 0x2b, 0x20, 0x31, 0x2c, 0x20, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x53, 0x69, 0x7a, 0x65, 
+	0x2e, 0x79, 0x20, 0x2d, 0x20, 0x31, 0x29, 0x0a, 0x09, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+	0x64, 0x65, 0x70, 0x74, 0x68, 0x20, 0x3d, 0x20, 0x30, 0x2e, 0x30, 0x3b, 0x0a, 0x09, 0x66, 0x6f, 0x72, 0x20, 0x28, 0x69, 
+	0x6e, 0x74, 0x20, 0x79, 0x20, 0x3d, 0x20, 0x62, 0x65, 0x67, 0x69, 0x6e, 0x2e, 0x79, 0x3b, 0x20, 0x79, 0x20, 0x3c, 0x3d, 
+	0x20, 0x65, 0x6e, 0x64, 0x2e, 0x79, 0x3b, 0x20, 0x2b, 0x2b, 0x79, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x66, 0x6f, 
+	0x72, 0x20, 0x28, 0x69, 0x6e, 0x74, 0x20, 0x78, 0x20, 0x3d, 0x20, 0x62, 0x65, 0x67, 0x69, 0x6e, 0x2e, 0x78, 0x3b, 0x20, 
+	0x78, 0x20, 0x3c, 0x3d, 0x20, 0x65, 0x6e, 0x64, 0x2e, 0x78, 0x3b, 0x20, 0x2b, 0x2b, 0x78, 0x29, 0x0a, 0x09, 0x09, 0x7b, 
+	0x0a, 0x09, 0x09, 0x09, 0x64, 0x65, 0x70, 0x74, 0x68, 0x20, 0x3d, 0x20, 0x6d, 0x61, 0x78, 0x28, 0x64, 0x65, 0x70, 0x74, 
+	0x68, 0x2c, 0x20, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x46, 0x65, 0x74, 0x63, 0x68, 0x28, 0x75, 0x5f, 0x64, 0x65, 0x70, 0x74, 
+	0x68, 0x2c, 0x20, 0x69, 0x76, 0x65, 0x63, 0x32, 0x28, 0x78, 0x2c, 0x20, 0x79, 0x29, 0x2c, 0x20, 0x30, 0x29, 0x2e, 0x72, 
+	0x29, 0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x66, 0x6f, 0x5f, 0x64, 0x65, 0x70, 0x74, 0x68, 
+	0x20, 0x3d, 0x20, 0x64, 0x65, 0x70, 0x74, 0x68, 0x3b, 0x0a, 0x7d, 0x0a, 0x00
 };
 
 static constexpr char lighting_glsl[] = {
@@ -167,210 +852,251 @@ static constexpr char lighting_glsl[] = {
 	0x65, 0x63, 0x33, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 
 	0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x2c, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 
 	0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x72, 
-	0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x73, 0x77, 0x69, 0x74, 0x63, 0x68, 0x20, 0x28, 
-	0x75, 0x62, 0x6f, 0x5f, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 0x69, 0x5d, 
-	0x2e, 0x74, 0x79, 0x70, 0x65, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x63, 0x61, 0x73, 0x65, 0x20, 0x30, 0x3a, 0x09, 
-	0x09, 0x2f, 0x2f, 0x20, 0x50, 0x6f, 0x69, 0x6e, 0x74, 0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x6c, 0x69, 0x67, 
-	0x68, 0x74, 0x44, 0x69, 0x72, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x6c, 
-	0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x70, 0x61, 0x72, 0x61, 0x6d, 0x30, 0x2e, 0x78, 0x79, 0x7a, 0x20, 
-	0x2d, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x72, 0x61, 0x64, 0x69, 0x61, 
-	0x6e, 0x63, 0x65, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x6c, 0x69, 0x67, 
-	0x68, 0x74, 0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x2f, 0x20, 0x6d, 0x61, 0x78, 0x28, 0x64, 
-	0x6f, 0x74, 0x28, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 
-	0x72, 0x29, 0x2c, 0x20, 0x63, 0x5f, 0x65, 0x70, 0x73, 0x69, 0x6c, 0x6f, 0x6e, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x6c, 
-	0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 
-	0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x62, 0x72, 0x65, 0x61, 0x6b, 0x3b, 
-	0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x63, 0x61, 0x73, 0x65, 0x20, 0x31, 0x3a, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x53, 
-	0x75, 0x6e, 0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x20, 0x3d, 
+	0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x41, 0x20, 0x73, 0x69, 0x6e, 
+	0x67, 0x6c, 0x65, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x74, 0x79, 0x70, 0x65, 0x20, 0x6e, 0x65, 0x65, 0x64, 0x73, 
+	0x20, 0x6e, 0x6f, 0x20, 0x73, 0x77, 0x69, 0x74, 0x63, 0x68, 0x0a, 0x0a, 0x09, 0x23, 0x69, 0x66, 0x20, 0x4c, 0x49, 0x47, 
+	0x48, 0x54, 0x5f, 0x54, 0x59, 0x50, 0x45, 0x53, 0x20, 0x3d, 0x3d, 0x20, 0x31, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6d, 0x70, 
+	0x75, 0x74, 0x65, 0x50, 0x6f, 0x69, 0x6e, 0x74, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x28, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 
+	0x6f, 0x6e, 0x2c, 0x20, 0x69, 0x2c, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x72, 0x61, 0x64, 
+	0x69, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6c, 0x69, 0x66, 0x20, 0x4c, 0x49, 0x47, 0x48, 0x54, 
+	0x5f, 0x54, 0x59, 0x50, 0x45, 0x53, 0x20, 0x3d, 0x3d, 0x20, 0x32, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6d, 0x70, 0x75, 0x74, 
+	0x65, 0x53, 0x75, 0x6e, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x28, 0x69, 0x2c, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 
+	0x72, 0x2c, 0x20, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6c, 0x69, 0x66, 
+	0x20, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x5f, 0x54, 0x59, 0x50, 0x45, 0x53, 0x20, 0x3d, 0x3d, 0x20, 0x34, 0x0a, 0x09, 0x09, 
+	0x63, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x53, 0x70, 0x6f, 0x74, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x28, 0x70, 0x6f, 0x73, 
+	0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x69, 0x2c, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 
+	0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x09, 
+	0x73, 0x77, 0x69, 0x74, 0x63, 0x68, 0x20, 0x28, 0x75, 0x62, 0x6f, 0x5f, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x6c, 
+	0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x74, 0x79, 0x70, 0x65, 0x29, 0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 
+	0x09, 0x09, 0x23, 0x69, 0x66, 0x20, 0x28, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x5f, 0x54, 0x59, 0x50, 0x45, 0x53, 0x20, 0x26, 
+	0x20, 0x31, 0x29, 0x20, 0x21, 0x3d, 0x20, 0x30, 0x0a, 0x09, 0x09, 0x09, 0x63, 0x61, 0x73, 0x65, 0x20, 0x30, 0x3a, 0x09, 
+	0x09, 0x2f, 0x2f, 0x20, 0x50, 0x6f, 0x69, 0x6e, 0x74, 0x0a, 0x09, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x63, 
+	0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x50, 0x6f, 0x69, 0x6e, 0x74, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x28, 0x70, 0x6f, 0x73, 
+	0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x69, 0x2c, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 
+	0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x62, 0x72, 0x65, 0x61, 0x6b, 
+	0x3b, 0x0a, 0x09, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x09, 0x09, 0x09, 
+	0x23, 0x69, 0x66, 0x20, 0x28, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x5f, 0x54, 0x59, 0x50, 0x45, 0x53, 0x20, 0x26, 0x20, 0x32, 
+	0x29, 0x20, 0x21, 0x3d, 0x20, 0x30, 0x0a, 0x09, 0x09, 0x09, 0x63, 0x61, 0x73, 0x65, 0x20, 0x31, 0x3a, 0x09, 0x09, 0x2f, 
+	0x2f, 0x20, 0x53, 0x75, 0x6e, 0x0a, 0x09, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x63, 0x6f, 0x6d, 0x70, 0x75, 
+	0x74, 0x65, 0x53, 0x75, 0x6e, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x28, 0x69, 0x2c, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 
+	0x69, 0x72, 0x2c, 0x20, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x62, 
+	0x72, 0x65, 0x61, 0x6b, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 
+	0x0a, 0x09, 0x09, 0x09, 0x23, 0x69, 0x66, 0x20, 0x28, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x5f, 0x54, 0x59, 0x50, 0x45, 0x53, 
+	0x20, 0x26, 0x20, 0x34, 0x29, 0x20, 0x21, 0x3d, 0x20, 0x30, 0x0a, 0x09, 0x09, 0x09, 0x63, 0x61, 0x73, 0x65, 0x20, 0x32, 
+	0x3a, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x53, 0x70, 0x6f, 0x74, 0x0a, 0x09, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x09, 
+	0x63, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x53, 0x70, 0x6f, 0x74, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x28, 0x70, 0x6f, 0x73, 
+	0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x69, 0x2c, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 
+	0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x62, 0x72, 0x65, 0x61, 0x6b, 
+	0x3b, 0x0a, 0x09, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x09, 0x09, 0x09, 
+	0x64, 0x65, 0x66, 0x61, 0x75, 0x6c, 0x74, 0x3a, 0x0a, 0x09, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x62, 0x72, 
+	0x65, 0x61, 0x6b, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 
+	0x66, 0x0a, 0x7d, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x63, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x50, 0x6f, 0x69, 
+	0x6e, 0x74, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 
+	0x33, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 
+	0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x2c, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6c, 0x69, 
+	0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x72, 0x61, 0x64, 
+	0x69, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x20, 0x3d, 
 	0x20, 0x75, 0x62, 0x6f, 0x5f, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 0x69, 
-	0x5d, 0x2e, 0x70, 0x61, 0x72, 0x61, 0x6d, 0x30, 0x2e, 0x78, 0x79, 0x7a, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x72, 0x61, 0x64, 
-	0x69, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x6c, 
-	0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x62, 
-	0x72, 0x65, 0x61, 0x6b, 0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x63, 0x61, 0x73, 0x65, 0x20, 0x32, 0x3a, 0x09, 
-	0x09, 0x2f, 0x2f, 0x20, 0x53, 0x70, 0x6f, 0x74, 0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x6c, 0x69, 0x67, 0x68, 
-	0x74, 0x44, 0x69, 0x72, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x6c, 0x69, 
-	0x67, 0x68, 0x74, 0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x70, 0x61, 0x72, 0x61, 0x6d, 0x30, 0x2e, 0x78, 0x79, 0x7a, 0x20, 0x2d, 
-	0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 
-	0x63, 0x65, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x6c, 0x69, 0x67, 0x68, 
-	0x74, 0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x2f, 0x20, 0x6d, 0x61, 0x78, 0x28, 0x64, 0x6f, 
-	0x74, 0x28, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 
-	0x29, 0x2c, 0x20, 0x63, 0x5f, 0x65, 0x70, 0x73, 0x69, 0x6c, 0x6f, 0x6e, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x6c, 0x69, 
-	0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x6c, 
-	0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 
-	0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x49, 0x6e, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 
-	0x5f, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x70, 0x61, 
-	0x72, 0x61, 0x6d, 0x30, 0x2e, 0x77, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 
-	0x61, 0x74, 0x20, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x4f, 0x75, 0x74, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x6c, 
-	0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x70, 0x61, 0x72, 0x61, 
-	0x6d, 0x31, 0x2e, 0x77, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x69, 0x66, 0x20, 0x28, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x49, 
-	0x6e, 0x20, 0x3d, 0x3d, 0x20, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x4f, 0x75, 0x74, 0x29, 0x0a, 0x09, 0x09, 0x09, 0x7b, 
-	0x0a, 0x09, 0x09, 0x09, 0x09, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x2a, 0x3d, 0x20, 0x66, 0x6c, 0x6f, 
-	0x61, 0x74, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x75, 0x62, 0x6f, 
+	0x5d, 0x2e, 0x70, 0x61, 0x72, 0x61, 0x6d, 0x30, 0x2e, 0x78, 0x79, 0x7a, 0x20, 0x2d, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 
+	0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x09, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 
+	0x5f, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x63, 0x6f, 
+	0x6c, 0x6f, 0x72, 0x20, 0x2f, 0x20, 0x6d, 0x61, 0x78, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 
+	0x69, 0x72, 0x2c, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x29, 0x2c, 0x20, 0x63, 0x5f, 0x65, 0x70, 0x73, 
+	0x69, 0x6c, 0x6f, 0x6e, 0x29, 0x3b, 0x0a, 0x09, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x20, 0x3d, 0x20, 0x6e, 
+	0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x29, 0x3b, 0x0a, 
+	0x7d, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x63, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x53, 0x75, 0x6e, 0x4c, 0x69, 
+	0x67, 0x68, 0x74, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x2c, 
+	0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 
+	0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x0a, 0x7b, 
+	0x0a, 0x09, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x6c, 0x69, 0x67, 
+	0x68, 0x74, 0x73, 0x2e, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x70, 0x61, 0x72, 0x61, 0x6d, 0x30, 
+	0x2e, 0x78, 0x79, 0x7a, 0x3b, 0x0a, 0x09, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x3d, 0x20, 0x75, 0x62, 
+	0x6f, 0x5f, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x63, 
+	0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x63, 0x6f, 0x6d, 0x70, 0x75, 0x74, 
+	0x65, 0x53, 0x70, 0x6f, 0x74, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 
+	0x76, 0x65, 0x63, 0x33, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 
+	0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x2c, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 
+	0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 
+	0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 
+	0x72, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x6c, 0x69, 0x67, 0x68, 0x74, 
+	0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x70, 0x61, 0x72, 0x61, 0x6d, 0x30, 0x2e, 0x78, 0x79, 0x7a, 0x20, 0x2d, 0x20, 0x70, 0x6f, 
+	0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x09, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x3d, 0x20, 
+	0x75, 0x62, 0x6f, 0x5f, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 0x69, 0x5d, 
+	0x2e, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x2f, 0x20, 0x6d, 0x61, 0x78, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x6c, 0x69, 0x67, 
+	0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x29, 0x2c, 0x20, 0x63, 0x5f, 
+	0x65, 0x70, 0x73, 0x69, 0x6c, 0x6f, 0x6e, 0x29, 0x3b, 0x0a, 0x09, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x20, 
+	0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 
+	0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x54, 0x68, 
+	0x65, 0x74, 0x61, 0x49, 0x6e, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x6c, 
+	0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x70, 0x61, 0x72, 0x61, 0x6d, 0x30, 0x2e, 0x77, 0x3b, 0x0a, 0x09, 
+	0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x4f, 0x75, 
+	0x74, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x6c, 0x69, 0x67, 0x68, 0x74, 
+	0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x70, 0x61, 0x72, 0x61, 0x6d, 0x31, 0x2e, 0x77, 0x3b, 0x0a, 0x09, 0x69, 0x66, 0x20, 0x28, 
+	0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x49, 0x6e, 0x20, 0x3d, 0x3d, 0x20, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x4f, 0x75, 
+	0x74, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x2a, 0x3d, 0x20, 
+	0x66, 0x6c, 0x6f, 0x61, 0x74, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 
+	0x75, 0x62, 0x6f, 0x5f, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 0x69, 0x5d, 
+	0x2e, 0x70, 0x61, 0x72, 0x61, 0x6d, 0x31, 0x2e, 0x78, 0x79, 0x7a, 0x29, 0x20, 0x3c, 0x20, 0x63, 0x54, 0x68, 0x65, 0x74, 
+	0x61, 0x49, 0x6e, 0x29, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x09, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 
+	0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x74, 0x20, 0x3d, 0x20, 0x28, 0x63, 0x6c, 0x61, 
+	0x6d, 0x70, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x75, 0x62, 0x6f, 
 	0x5f, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x70, 0x61, 
-	0x72, 0x61, 0x6d, 0x31, 0x2e, 0x78, 0x79, 0x7a, 0x29, 0x20, 0x3c, 0x20, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x49, 0x6e, 
-	0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x09, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x09, 0x09, 0x7b, 
-	0x0a, 0x09, 0x09, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x74, 0x20, 0x3d, 
-	0x20, 0x28, 0x63, 0x6c, 0x61, 0x6d, 0x70, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 
-	0x2c, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 
-	0x69, 0x5d, 0x2e, 0x70, 0x61, 0x72, 0x61, 0x6d, 0x31, 0x2e, 0x78, 0x79, 0x7a, 0x29, 0x2c, 0x20, 0x63, 0x54, 0x68, 0x65, 
-	0x74, 0x61, 0x4f, 0x75, 0x74, 0x2c, 0x20, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x49, 0x6e, 0x29, 0x20, 0x2d, 0x20, 0x63, 
-	0x54, 0x68, 0x65, 0x74, 0x61, 0x4f, 0x75, 0x74, 0x29, 0x20, 0x2f, 0x20, 0x28, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x49, 
-	0x6e, 0x20, 0x2d, 0x20, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x4f, 0x75, 0x74, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x09, 
-	0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x2a, 0x3d, 0x20, 0x65, 0x78, 0x70, 0x28, 0x2d, 0x70, 0x6f, 0x77, 
-	0x28, 0x31, 0x2e, 0x30, 0x20, 0x2f, 0x20, 0x74, 0x2c, 0x20, 0x32, 0x2e, 0x30, 0x29, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 
-	0x7d, 0x0a, 0x0a, 0x09, 0x09, 0x09, 0x62, 0x72, 0x65, 0x61, 0x6b, 0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x64, 
-	0x65, 0x66, 0x61, 0x75, 0x6c, 0x74, 0x3a, 0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x62, 0x72, 0x65, 0x61, 0x6b, 
-	0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x7d, 0x0a, 0x7d, 0x0a, 0x0a, 0x76, 0x65, 0x63, 0x33, 0x20, 0x66, 0x72, 0x65, 
-	0x73, 0x6e, 0x65, 0x6c, 0x53, 0x63, 0x68, 0x6c, 0x69, 0x63, 0x6b, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 
-	0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 
-	0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x69, 0x6e, 
-	0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x46, 0x72, 
-	0x65, 0x73, 0x6e, 0x65, 0x6c, 0x52, 0x65, 0x66, 0x6c, 0x65, 0x63, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x0a, 0x7b, 0x0a, 
-	0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x46, 0x72, 0x65, 0x73, 0x6e, 0x65, 
-	0x6c, 0x52, 0x65, 0x66, 0x6c, 0x65, 0x63, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x2b, 0x20, 0x28, 0x31, 0x2e, 0x30, 0x20, 
-	0x2d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x46, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x52, 0x65, 0x66, 0x6c, 0x65, 
-	0x63, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x20, 0x2a, 0x20, 0x70, 0x6f, 0x77, 0x28, 0x31, 0x2e, 0x30, 0x20, 0x2d, 0x20, 
-	0x6d, 0x61, 0x78, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x6c, 0x69, 0x67, 0x68, 
-	0x74, 0x44, 0x69, 0x72, 0x29, 0x2c, 0x20, 0x30, 0x2e, 0x30, 0x29, 0x2c, 0x20, 0x35, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 
-	0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x64, 0x69, 0x73, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x47, 0x47, 
-	0x58, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 
-	0x61, 0x6c, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x76, 0x65, 
-	0x63, 0x74, 0x6f, 0x72, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
-	0x20, 0x72, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 0x53, 0x71, 0x53, 0x71, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x63, 
-	0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x20, 0x3d, 0x20, 
-	0x6d, 0x61, 0x78, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x74, 
-	0x6f, 0x72, 0x29, 0x2c, 0x20, 0x30, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x09, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
-	0x64, 0x65, 0x6e, 0x6f, 0x6d, 0x20, 0x3d, 0x20, 0x28, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x20, 0x2a, 0x20, 0x63, 0x54, 
-	0x68, 0x65, 0x74, 0x61, 0x20, 0x2a, 0x20, 0x28, 0x72, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 0x53, 0x71, 0x53, 
-	0x71, 0x20, 0x2d, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x20, 0x2b, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x09, 0x64, 0x65, 
-	0x6e, 0x6f, 0x6d, 0x20, 0x3d, 0x20, 0x63, 0x5f, 0x70, 0x69, 0x20, 0x2a, 0x20, 0x64, 0x65, 0x6e, 0x6f, 0x6d, 0x20, 0x2a, 
-	0x20, 0x64, 0x65, 0x6e, 0x6f, 0x6d, 0x3b, 0x0a, 0x09, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x72, 0x6f, 
-	0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 0x53, 0x71, 0x53, 0x71, 0x20, 0x2f, 0x20, 0x64, 0x65, 0x6e, 0x6f, 0x6d, 0x3b, 
-	0x0a, 0x7d, 0x0a, 0x0a, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x47, 0x47, 
-	0x58, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x54, 0x68, 
-	0x65, 0x74, 0x61, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
-	0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x43, 0x6f, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x74, 0x29, 0x0a, 0x7b, 0x0a, 
-	0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x20, 0x2f, 0x20, 0x6d, 0x69, 0x78, 
-	0x28, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x2c, 0x20, 0x31, 0x2e, 0x30, 0x2c, 0x20, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 
-	0x72, 0x79, 0x43, 0x6f, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x74, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x76, 0x65, 0x63, 0x33, 
-	0x20, 0x63, 0x6f, 0x6f, 0x6b, 0x54, 0x6f, 0x72, 0x72, 0x61, 0x6e, 0x63, 0x65, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 
-	0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 
-	0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x2c, 0x20, 0x69, 
-	0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 
-	0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 
-	0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x73, 0x61, 0x6f, 0x29, 0x0a, 
-	0x7b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x50, 0x72, 0x65, 0x2d, 0x63, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x20, 0x75, 0x73, 
-	0x65, 0x66, 0x75, 0x6c, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x74, 0x73, 0x0a, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 
-	0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x65, 0x79, 0x65, 0x44, 0x69, 0x72, 0x20, 0x3d, 0x20, 0x2d, 0x6e, 0x6f, 
-	0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x3b, 0x0a, 0x0a, 
-	0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6d, 0x65, 0x74, 0x61, 0x6c, 0x6c, 0x69, 
-	0x63, 0x20, 0x3d, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x2e, 0x79, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 
-	0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x72, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 0x20, 0x3d, 
-	0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x2e, 0x7a, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 
-	0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x72, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 0x53, 0x71, 0x20, 0x3d, 0x20, 
-	0x72, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 0x20, 0x2a, 0x20, 0x72, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 
-	0x73, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x72, 0x6f, 0x75, 0x67, 
-	0x68, 0x6e, 0x65, 0x73, 0x73, 0x53, 0x71, 0x53, 0x71, 0x20, 0x3d, 0x20, 0x72, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 
-	0x73, 0x53, 0x71, 0x20, 0x2a, 0x20, 0x72, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 0x53, 0x71, 0x3b, 0x0a, 0x09, 
+	0x72, 0x61, 0x6d, 0x31, 0x2e, 0x78, 0x79, 0x7a, 0x29, 0x2c, 0x20, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x4f, 0x75, 0x74, 
+	0x2c, 0x20, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x49, 0x6e, 0x29, 0x20, 0x2d, 0x20, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 
+	0x4f, 0x75, 0x74, 0x29, 0x20, 0x2f, 0x20, 0x28, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x49, 0x6e, 0x20, 0x2d, 0x20, 0x63, 
+	0x54, 0x68, 0x65, 0x74, 0x61, 0x4f, 0x75, 0x74, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 
+	0x65, 0x20, 0x2a, 0x3d, 0x20, 0x65, 0x78, 0x70, 0x28, 0x2d, 0x70, 0x6f, 0x77, 0x28, 0x31, 0x2e, 0x30, 0x20, 0x2f, 0x20, 
+	0x74, 0x2c, 0x20, 0x32, 0x2e, 0x30, 0x29, 0x29, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x7d, 0x0a, 0x0a, 0x76, 0x65, 0x63, 0x33, 
+	0x20, 0x66, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x53, 0x63, 0x68, 0x6c, 0x69, 0x63, 0x6b, 0x28, 0x69, 0x6e, 0x20, 0x63, 
+	0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x69, 0x6e, 
+	0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 
+	0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 
+	0x61, 0x6c, 0x46, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x52, 0x65, 0x66, 0x6c, 0x65, 0x63, 0x74, 0x61, 0x6e, 0x63, 0x65, 
+	0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x46, 0x72, 
+	0x65, 0x73, 0x6e, 0x65, 0x6c, 0x52, 0x65, 0x66, 0x6c, 0x65, 0x63, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x2b, 0x20, 0x28, 
+	0x31, 0x2e, 0x30, 0x20, 0x2d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x46, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x52, 
+	0x65, 0x66, 0x6c, 0x65, 0x63, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x20, 0x2a, 0x20, 0x70, 0x6f, 0x77, 0x28, 0x31, 0x2e, 
+	0x30, 0x20, 0x2d, 0x20, 0x6d, 0x61, 0x78, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 
+	0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x29, 0x2c, 0x20, 0x30, 0x2e, 0x30, 0x29, 0x2c, 0x20, 0x35, 0x29, 0x3b, 
+	0x0a, 0x7d, 0x0a, 0x0a, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x64, 0x69, 0x73, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x69, 
+	0x6f, 0x6e, 0x47, 0x47, 0x58, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 
+	0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 
+	0x33, 0x20, 0x76, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 
+	0x6c, 0x6f, 0x61, 0x74, 0x20, 0x72, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 0x53, 0x71, 0x53, 0x71, 0x29, 0x0a, 
+	0x7b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x54, 0x68, 0x65, 0x74, 
+	0x61, 0x20, 0x3d, 0x20, 0x6d, 0x61, 0x78, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 
+	0x76, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x29, 0x2c, 0x20, 0x30, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x09, 0x0a, 0x09, 0x66, 0x6c, 
+	0x6f, 0x61, 0x74, 0x20, 0x64, 0x65, 0x6e, 0x6f, 0x6d, 0x20, 0x3d, 0x20, 0x28, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x20, 
+	0x2a, 0x20, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x20, 0x2a, 0x20, 0x28, 0x72, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 
+	0x73, 0x53, 0x71, 0x53, 0x71, 0x20, 0x2d, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x20, 0x2b, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x3b, 
+	0x0a, 0x09, 0x64, 0x65, 0x6e, 0x6f, 0x6d, 0x20, 0x3d, 0x20, 0x63, 0x5f, 0x70, 0x69, 0x20, 0x2a, 0x20, 0x64, 0x65, 0x6e, 
+	0x6f, 0x6d, 0x20, 0x2a, 0x20, 0x64, 0x65, 0x6e, 0x6f, 0x6d, 0x3b, 0x0a, 0x09, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 
+	0x6e, 0x20, 0x72, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 0x53, 0x71, 0x53, 0x71, 0x20, 0x2f, 0x20, 0x64, 0x65, 
+	0x6e, 0x6f, 0x6d, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 
+	0x72, 0x79, 0x47, 0x47, 0x58, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
+	0x20, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 
+	0x6f, 0x61, 0x74, 0x20, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x43, 0x6f, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x74, 
+	0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x20, 0x2f, 
+	0x20, 0x6d, 0x69, 0x78, 0x28, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x2c, 0x20, 0x31, 0x2e, 0x30, 0x2c, 0x20, 0x67, 0x65, 
+	0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x43, 0x6f, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x74, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 
+	0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x6f, 0x6f, 0x6b, 0x54, 0x6f, 0x72, 0x72, 0x61, 0x6e, 0x63, 0x65, 0x28, 0x69, 0x6e, 
+	0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2c, 0x20, 0x69, 
+	0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 
+	0x6c, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 
+	0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x70, 
+	0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x73, 
+	0x61, 0x6f, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x50, 0x72, 0x65, 0x2d, 0x63, 0x6f, 0x6d, 0x70, 0x75, 0x74, 
+	0x65, 0x20, 0x75, 0x73, 0x65, 0x66, 0x75, 0x6c, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x74, 0x73, 0x0a, 0x0a, 
+	0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x65, 0x79, 0x65, 0x44, 0x69, 0x72, 0x20, 0x3d, 
+	0x20, 0x2d, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 
+	0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6d, 0x65, 0x74, 
+	0x61, 0x6c, 0x6c, 0x69, 0x63, 0x20, 0x3d, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x2e, 0x79, 0x3b, 0x0a, 
+	0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x72, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 
+	0x73, 0x73, 0x20, 0x3d, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x2e, 0x7a, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 
+	0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x72, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 0x53, 
+	0x71, 0x20, 0x3d, 0x20, 0x72, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 0x20, 0x2a, 0x20, 0x72, 0x6f, 0x75, 0x67, 
+	0x68, 0x6e, 0x65, 0x73, 0x73, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+	0x72, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 0x53, 0x71, 0x53, 0x71, 0x20, 0x3d, 0x20, 0x72, 0x6f, 0x75, 0x67, 
+	0x68, 0x6e, 0x65, 0x73, 0x73, 0x53, 0x71, 0x20, 0x2a, 0x20, 0x72, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 0x53, 
+	0x71, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x67, 0x65, 0x6f, 0x6d, 
+	0x65, 0x74, 0x72, 0x79, 0x43, 0x6f, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x72, 0x6f, 0x75, 0x67, 0x68, 
+	0x6e, 0x65, 0x73, 0x73, 0x53, 0x71, 0x20, 0x2a, 0x20, 0x30, 0x2e, 0x31, 0x32, 0x35, 0x3b, 0x0a, 0x09, 0x09, 0x0a, 0x09, 
+	0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x46, 0x72, 0x65, 
+	0x73, 0x6e, 0x65, 0x6c, 0x52, 0x65, 0x66, 0x6c, 0x65, 0x63, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x3d, 0x20, 0x6d, 0x69, 
+	0x78, 0x28, 0x63, 0x5f, 0x64, 0x69, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x72, 0x69, 0x63, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 
+	0x46, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x52, 0x65, 0x66, 0x6c, 0x65, 0x63, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x2c, 0x20, 
+	0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2c, 0x20, 0x6d, 0x65, 0x74, 0x61, 0x6c, 0x6c, 0x69, 0x63, 0x29, 0x3b, 0x09, 0x2f, 0x2f, 
+	0x20, 0x54, 0x4f, 0x44, 0x4f, 0x3a, 0x20, 0x43, 0x68, 0x65, 0x63, 0x6b, 0x20, 0x74, 0x68, 0x61, 0x74, 0x20, 0x66, 0x6f, 
+	0x72, 0x6d, 0x75, 0x6c, 0x61, 0x2e, 0x2e, 0x2e, 0x0a, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 
+	0x61, 0x74, 0x20, 0x64, 0x6f, 0x74, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x56, 0x69, 0x65, 0x77, 0x44, 0x69, 0x72, 0x20, 
+	0x3d, 0x20, 0x6d, 0x61, 0x78, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x65, 0x79, 
+	0x65, 0x44, 0x69, 0x72, 0x29, 0x2c, 0x20, 0x63, 0x5f, 0x65, 0x70, 0x73, 0x69, 0x6c, 0x6f, 0x6e, 0x29, 0x3b, 0x0a, 0x09, 
 	0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 
-	0x43, 0x6f, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x72, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 
-	0x53, 0x71, 0x20, 0x2a, 0x20, 0x30, 0x2e, 0x31, 0x32, 0x35, 0x3b, 0x0a, 0x09, 0x09, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 
-	0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x46, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 
-	0x52, 0x65, 0x66, 0x6c, 0x65, 0x63, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x3d, 0x20, 0x6d, 0x69, 0x78, 0x28, 0x63, 0x5f, 
-	0x64, 0x69, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x72, 0x69, 0x63, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x46, 0x72, 0x65, 0x73, 
-	0x6e, 0x65, 0x6c, 0x52, 0x65, 0x66, 0x6c, 0x65, 0x63, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x2c, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 
-	0x72, 0x2c, 0x20, 0x6d, 0x65, 0x74, 0x61, 0x6c, 0x6c, 0x69, 0x63, 0x29, 0x3b, 0x09, 0x2f, 0x2f, 0x20, 0x54, 0x4f, 0x44, 
-	0x4f, 0x3a, 0x20, 0x43, 0x68, 0x65, 0x63, 0x6b, 0x20, 0x74, 0x68, 0x61, 0x74, 0x20, 0x66, 0x6f, 0x72, 0x6d, 0x75, 0x6c, 
-	0x61, 0x2e, 0x2e, 0x2e, 0x0a, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x64, 
-	0x6f, 0x74, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x56, 0x69, 0x65, 0x77, 0x44, 0x69, 0x72, 0x20, 0x3d, 0x20, 0x6d, 0x61, 
-	0x78, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x65, 0x79, 0x65, 0x44, 0x69, 0x72, 
-	0x29, 0x2c, 0x20, 0x63, 0x5f, 0x65, 0x70, 0x73, 0x69, 0x6c, 0x6f, 0x6e, 0x29, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 
-	0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x56, 0x69, 0x65, 0x77, 
-	0x20, 0x3d, 0x20, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x47, 0x47, 0x58, 0x28, 0x64, 0x6f, 0x74, 0x4e, 0x6f, 
-	0x72, 0x6d, 0x61, 0x6c, 0x56, 0x69, 0x65, 0x77, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 
-	0x79, 0x43, 0x6f, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x74, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x43, 
-	0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x20, 0x61, 0x6d, 0x62, 0x69, 0x61, 0x6e, 0x74, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 
-	0x69, 0x6e, 0x67, 0x0a, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x61, 0x6d, 0x62, 
-	0x69, 0x61, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x2a, 0x20, 0x28, 0x6d, 0x61, 0x74, 0x65, 
-	0x72, 0x69, 0x61, 0x6c, 0x2e, 0x78, 0x20, 0x2a, 0x20, 0x28, 0x31, 0x2e, 0x30, 0x20, 0x2d, 0x20, 0x73, 0x73, 0x61, 0x6f, 
-	0x29, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x49, 0x74, 0x65, 0x72, 0x61, 0x74, 0x65, 0x20, 0x6f, 0x76, 0x65, 
-	0x72, 0x20, 0x65, 0x61, 0x63, 0x68, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x20, 
-	0x66, 0x6f, 0x72, 0x20, 0x64, 0x69, 0x66, 0x66, 0x75, 0x73, 0x65, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x73, 0x70, 0x65, 0x63, 
-	0x75, 0x6c, 0x61, 0x72, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x69, 0x6e, 0x67, 0x0a, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 
-	0x20, 0x64, 0x69, 0x66, 0x66, 0x75, 0x73, 0x65, 0x20, 0x3d, 0x20, 0x76, 0x65, 0x63, 0x33, 0x28, 0x30, 0x2e, 0x30, 0x29, 
-	0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x20, 0x3d, 0x20, 0x76, 
-	0x65, 0x63, 0x33, 0x28, 0x30, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x09, 0x66, 0x6f, 0x72, 0x20, 0x28, 0x75, 0x69, 0x6e, 0x74, 
-	0x20, 0x69, 0x20, 0x3d, 0x20, 0x30, 0x3b, 0x20, 0x69, 0x20, 0x3c, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x6c, 0x69, 0x67, 0x68, 
-	0x74, 0x73, 0x2e, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x20, 0x2b, 0x2b, 0x69, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 
-	0x2f, 0x2f, 0x20, 0x49, 0x66, 0x20, 0x66, 0x72, 0x61, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x69, 0x73, 0x20, 0x74, 0x6f, 
-	0x74, 0x61, 0x6c, 0x6c, 0x79, 0x20, 0x69, 0x6e, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x2c, 0x20, 0x73, 0x6b, 0x69, 
-	0x70, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x69, 0x6e, 0x67, 0x20, 0x77, 0x69, 0x74, 0x68, 0x20, 0x74, 0x68, 0x69, 0x73, 
-	0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x2c, 0x20, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x61, 0x70, 0x70, 0x6c, 0x79, 0x20, 0x61, 
-	0x6e, 0x20, 0x6f, 0x63, 0x63, 0x6c, 0x75, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x66, 0x61, 0x63, 0x74, 0x6f, 0x72, 0x0a, 0x0a, 
-	0x09, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6f, 0x63, 0x63, 0x6c, 0x75, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 
-	0x63, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4f, 0x63, 0x63, 0x6c, 0x75, 0x73, 0x69, 
-	0x6f, 0x6e, 0x28, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 
-	0x20, 0x69, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x09, 0x69, 0x66, 0x20, 0x28, 0x6f, 0x63, 0x63, 0x6c, 0x75, 0x73, 0x69, 0x6f, 
-	0x6e, 0x20, 0x3d, 0x3d, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x63, 0x6f, 0x6e, 
-	0x74, 0x69, 0x6e, 0x75, 0x65, 0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x43, 0x6f, 0x6d, 
-	0x70, 0x75, 0x74, 0x65, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 
-	0x20, 0x61, 0x6e, 0x64, 0x20, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x64, 0x65, 0x70, 0x65, 0x6e, 0x64, 
-	0x69, 0x6e, 0x67, 0x20, 0x6f, 0x6e, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x74, 0x79, 0x70, 0x65, 0x20, 0x61, 0x6e, 
-	0x64, 0x20, 0x70, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74, 0x65, 0x72, 0x73, 0x2e, 0x20, 0x49, 0x66, 0x20, 0x6c, 0x69, 0x67, 
-	0x68, 0x74, 0x20, 0x69, 0x73, 0x20, 0x74, 0x6f, 0x6f, 0x20, 0x77, 0x65, 0x61, 0x6b, 0x2c, 0x20, 0x73, 0x6b, 0x69, 0x70, 
-	0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x69, 0x6e, 0x67, 0x0a, 0x0a, 0x09, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6c, 0x69, 
-	0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x3b, 0x0a, 0x09, 0x09, 
-	0x63, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x41, 0x6e, 0x64, 0x52, 0x61, 
-	0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x28, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x69, 0x2c, 0x20, 
-	0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x3b, 
-	0x0a, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x64, 0x6f, 0x74, 0x4e, 
-	0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x20, 0x3d, 0x20, 0x6d, 0x61, 0x78, 0x28, 
-	0x64, 0x6f, 0x74, 0x28, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 
-	0x29, 0x2c, 0x20, 0x63, 0x5f, 0x65, 0x70, 0x73, 0x69, 0x6c, 0x6f, 0x6e, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x72, 0x61, 0x64, 
-	0x69, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x2a, 0x3d, 0x20, 0x64, 0x6f, 0x74, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x4c, 0x69, 
-	0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x20, 0x2a, 0x20, 0x28, 0x31, 0x2e, 0x30, 0x20, 0x2d, 0x20, 0x6f, 0x63, 0x63, 0x6c, 
-	0x75, 0x73, 0x69, 0x6f, 0x6e, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x09, 0x69, 0x66, 0x20, 0x28, 0x6c, 0x65, 0x6e, 0x67, 0x74, 
-	0x68, 0x28, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x20, 0x3c, 0x20, 0x63, 0x5f, 0x65, 0x70, 0x73, 0x69, 
-	0x6c, 0x6f, 0x6e, 0x29, 0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x74, 0x69, 0x6e, 0x75, 0x65, 
-	0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x46, 0x69, 0x6e, 0x61, 0x6c, 0x79, 0x20, 0x63, 
-	0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x20, 0x64, 0x69, 0x66, 0x66, 0x75, 0x73, 0x65, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x73, 
-	0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x69, 0x6e, 0x67, 0x20, 0x66, 0x6f, 0x72, 
-	0x20, 0x74, 0x68, 0x69, 0x73, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x0a, 0x0a, 
-	0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x68, 0x61, 0x6c, 0x66, 0x44, 0x69, 0x72, 
-	0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 
-	0x72, 0x20, 0x2b, 0x20, 0x65, 0x79, 0x65, 0x44, 0x69, 0x72, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 
-	0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x66, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x52, 0x65, 0x66, 0x6c, 0x65, 0x63, 
-	0x74, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x3d, 0x20, 0x66, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x53, 0x63, 0x68, 0x6c, 0x69, 
-	0x63, 0x6b, 0x28, 0x68, 0x61, 0x6c, 0x66, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 
-	0x2c, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x46, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x52, 0x65, 0x66, 0x6c, 0x65, 
-	0x63, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 
-	0x61, 0x74, 0x20, 0x64, 0x69, 0x73, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x64, 0x69, 
-	0x73, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x47, 0x47, 0x58, 0x28, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 
-	0x2c, 0x20, 0x68, 0x61, 0x6c, 0x66, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x72, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 
-	0x53, 0x71, 0x53, 0x71, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
-	0x20, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x3d, 0x20, 0x67, 0x65, 0x6f, 
-	0x6d, 0x65, 0x74, 0x72, 0x79, 0x47, 0x47, 0x58, 0x28, 0x64, 0x6f, 0x74, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x4c, 0x69, 
-	0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x43, 0x6f, 0x6e, 0x73, 
-	0x74, 0x61, 0x6e, 0x74, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x09, 0x64, 0x69, 0x66, 0x66, 0x75, 0x73, 0x65, 0x20, 0x2b, 0x3d, 
-	0x20, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x2a, 0x20, 0x28, 0x31, 0x2e, 0x30, 0x20, 0x2d, 0x20, 0x66, 
-	0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x52, 0x65, 0x66, 0x6c, 0x65, 0x63, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x3b, 0x0a, 
-	0x09, 0x09, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x20, 0x2b, 0x3d, 0x20, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 
-	0x63, 0x65, 0x20, 0x2a, 0x20, 0x66, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x52, 0x65, 0x66, 0x6c, 0x65, 0x63, 0x74, 0x61, 
-	0x6e, 0x63, 0x65, 0x20, 0x2a, 0x20, 0x64, 0x69, 0x73, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x2a, 
-	0x20, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x2f, 0x20, 0x64, 0x6f, 0x74, 
-	0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x0a, 
-	0x09, 0x2f, 0x2f, 0x20, 0x43, 0x6f, 0x72, 0x72, 0x65, 0x63, 0x74, 0x20, 0x64, 0x69, 0x66, 0x66, 0x75, 0x73, 0x65, 0x20, 
-	0x61, 0x6e, 0x64, 0x20, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x20, 0x62, 0x79, 0x20, 0x73, 0x6f, 0x6d, 0x65, 
-	0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x74, 0x73, 0x20, 0x28, 0x63, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x64, 
-	0x20, 0x61, 0x74, 0x20, 0x74, 0x68, 0x65, 0x20, 0x65, 0x6e, 0x64, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x6f, 0x70, 0x74, 0x69, 
-	0x6d, 0x69, 0x7a, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x0a, 0x0a, 0x09, 0x64, 0x69, 0x66, 0x66, 0x75, 0x73, 0x65, 0x20, 
-	0x2a, 0x3d, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x2a, 0x20, 0x28, 0x31, 0x2e, 0x30, 0x20, 0x2d, 0x20, 0x6d, 0x65, 
-	0x74, 0x61, 0x6c, 0x6c, 0x69, 0x63, 0x29, 0x20, 0x2f, 0x20, 0x63, 0x5f, 0x70, 0x69, 0x3b, 0x0a, 0x09, 0x73, 0x70, 0x65, 
-	0x63, 0x75, 0x6c, 0x61, 0x72, 0x20, 0x2a, 0x3d, 0x20, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x56, 0x69, 0x65, 
-	0x77, 0x20, 0x2f, 0x20, 0x28, 0x34, 0x2e, 0x30, 0x20, 0x2a, 0x20, 0x64, 0x6f, 0x74, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 
-	0x56, 0x69, 0x65, 0x77, 0x44, 0x69, 0x72, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x61, 
-	0x6d, 0x62, 0x69, 0x61, 0x6e, 0x74, 0x20, 0x2b, 0x20, 0x64, 0x69, 0x66, 0x66, 0x75, 0x73, 0x65, 0x20, 0x2b, 0x20, 0x73, 
-	0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x3b, 0x0a, 0x7d, 0x0a, 0x00
+	0x56, 0x69, 0x65, 0x77, 0x20, 0x3d, 0x20, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x47, 0x47, 0x58, 0x28, 0x64, 
+	0x6f, 0x74, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x56, 0x69, 0x65, 0x77, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x67, 0x65, 0x6f, 
+	0x6d, 0x65, 0x74, 0x72, 0x79, 0x43, 0x6f, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x74, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x0a, 0x09, 
+	0x2f, 0x2f, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x20, 0x61, 0x6d, 0x62, 0x69, 0x61, 0x6e, 0x74, 0x20, 0x6c, 
+	0x69, 0x67, 0x68, 0x74, 0x69, 0x6e, 0x67, 0x0a, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 
+	0x20, 0x61, 0x6d, 0x62, 0x69, 0x61, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x2a, 0x20, 0x28, 
+	0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x2e, 0x78, 0x20, 0x2a, 0x20, 0x28, 0x31, 0x2e, 0x30, 0x20, 0x2d, 0x20, 
+	0x73, 0x73, 0x61, 0x6f, 0x29, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x49, 0x74, 0x65, 0x72, 0x61, 0x74, 0x65, 
+	0x20, 0x6f, 0x76, 0x65, 0x72, 0x20, 0x65, 0x61, 0x63, 0x68, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x73, 0x6f, 0x75, 
+	0x72, 0x63, 0x65, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x64, 0x69, 0x66, 0x66, 0x75, 0x73, 0x65, 0x20, 0x61, 0x6e, 0x64, 0x20, 
+	0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x69, 0x6e, 0x67, 0x0a, 0x0a, 0x09, 
+	0x76, 0x65, 0x63, 0x33, 0x20, 0x64, 0x69, 0x66, 0x66, 0x75, 0x73, 0x65, 0x20, 0x3d, 0x20, 0x76, 0x65, 0x63, 0x33, 0x28, 
+	0x30, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 
+	0x20, 0x3d, 0x20, 0x76, 0x65, 0x63, 0x33, 0x28, 0x30, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x09, 0x66, 0x6f, 0x72, 0x20, 0x28, 
+	0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x20, 0x3d, 0x20, 0x30, 0x3b, 0x20, 0x69, 0x20, 0x3c, 0x20, 0x75, 0x62, 0x6f, 0x5f, 
+	0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x20, 0x2b, 0x2b, 0x69, 0x29, 0x0a, 0x09, 
+	0x7b, 0x0a, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x49, 0x66, 0x20, 0x66, 0x72, 0x61, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x69, 
+	0x73, 0x20, 0x74, 0x6f, 0x74, 0x61, 0x6c, 0x6c, 0x79, 0x20, 0x69, 0x6e, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x2c, 
+	0x20, 0x73, 0x6b, 0x69, 0x70, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x69, 0x6e, 0x67, 0x20, 0x77, 0x69, 0x74, 0x68, 0x20, 
+	0x74, 0x68, 0x69, 0x73, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x2c, 0x20, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x61, 0x70, 0x70, 
+	0x6c, 0x79, 0x20, 0x61, 0x6e, 0x20, 0x6f, 0x63, 0x63, 0x6c, 0x75, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x66, 0x61, 0x63, 0x74, 
+	0x6f, 0x72, 0x0a, 0x0a, 0x09, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6f, 0x63, 0x63, 0x6c, 0x75, 0x73, 0x69, 0x6f, 
+	0x6e, 0x20, 0x3d, 0x20, 0x63, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4f, 0x63, 0x63, 
+	0x6c, 0x75, 0x73, 0x69, 0x6f, 0x6e, 0x28, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x6e, 0x6f, 0x72, 
+	0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x69, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x09, 0x69, 0x66, 0x20, 0x28, 0x6f, 0x63, 0x63, 0x6c, 
+	0x75, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x3d, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 
+	0x09, 0x63, 0x6f, 0x6e, 0x74, 0x69, 0x6e, 0x75, 0x65, 0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x09, 0x2f, 0x2f, 
+	0x20, 0x43, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x64, 0x69, 0x72, 0x65, 0x63, 
+	0x74, 0x69, 0x6f, 0x6e, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x64, 0x65, 
+	0x70, 0x65, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x6f, 0x6e, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x74, 0x79, 0x70, 
+	0x65, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x70, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74, 0x65, 0x72, 0x73, 0x2e, 0x20, 0x49, 0x66, 
+	0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x69, 0x73, 0x20, 0x74, 0x6f, 0x6f, 0x20, 0x77, 0x65, 0x61, 0x6b, 0x2c, 0x20, 
+	0x73, 0x6b, 0x69, 0x70, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x69, 0x6e, 0x67, 0x0a, 0x0a, 0x09, 0x09, 0x76, 0x65, 0x63, 
+	0x33, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 
+	0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x41, 
+	0x6e, 0x64, 0x52, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x28, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 
+	0x20, 0x69, 0x2c, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 
+	0x63, 0x65, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+	0x64, 0x6f, 0x74, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x20, 0x3d, 0x20, 
+	0x6d, 0x61, 0x78, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x6c, 0x69, 0x67, 0x68, 
+	0x74, 0x44, 0x69, 0x72, 0x29, 0x2c, 0x20, 0x63, 0x5f, 0x65, 0x70, 0x73, 0x69, 0x6c, 0x6f, 0x6e, 0x29, 0x3b, 0x0a, 0x09, 
+	0x09, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x2a, 0x3d, 0x20, 0x64, 0x6f, 0x74, 0x4e, 0x6f, 0x72, 0x6d, 
+	0x61, 0x6c, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x20, 0x2a, 0x20, 0x28, 0x31, 0x2e, 0x30, 0x20, 0x2d, 0x20, 
+	0x6f, 0x63, 0x63, 0x6c, 0x75, 0x73, 0x69, 0x6f, 0x6e, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x09, 0x69, 0x66, 0x20, 0x28, 0x6c, 
+	0x65, 0x6e, 0x67, 0x74, 0x68, 0x28, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x20, 0x3c, 0x20, 0x63, 0x5f, 
+	0x65, 0x70, 0x73, 0x69, 0x6c, 0x6f, 0x6e, 0x29, 0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x74, 
+	0x69, 0x6e, 0x75, 0x65, 0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x46, 0x69, 0x6e, 0x61, 
+	0x6c, 0x79, 0x20, 0x63, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x20, 0x64, 0x69, 0x66, 0x66, 0x75, 0x73, 0x65, 0x20, 0x61, 
+	0x6e, 0x64, 0x20, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x69, 0x6e, 0x67, 
+	0x20, 0x66, 0x6f, 0x72, 0x20, 0x74, 0x68, 0x69, 0x73, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x73, 0x6f, 0x75, 0x72, 
+	0x63, 0x65, 0x0a, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x68, 0x61, 0x6c, 
+	0x66, 0x44, 0x69, 0x72, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x6c, 0x69, 0x67, 
+	0x68, 0x74, 0x44, 0x69, 0x72, 0x20, 0x2b, 0x20, 0x65, 0x79, 0x65, 0x44, 0x69, 0x72, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x09, 
+	0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x66, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x52, 0x65, 
+	0x66, 0x6c, 0x65, 0x63, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x3d, 0x20, 0x66, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x53, 
+	0x63, 0x68, 0x6c, 0x69, 0x63, 0x6b, 0x28, 0x68, 0x61, 0x6c, 0x66, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x6c, 0x69, 0x67, 0x68, 
+	0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x46, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x52, 
+	0x65, 0x66, 0x6c, 0x65, 0x63, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 
+	0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x64, 0x69, 0x73, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x20, 
+	0x3d, 0x20, 0x64, 0x69, 0x73, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x47, 0x47, 0x58, 0x28, 0x6e, 0x6f, 
+	0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x68, 0x61, 0x6c, 0x66, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x72, 0x6f, 0x75, 0x67, 0x68, 
+	0x6e, 0x65, 0x73, 0x73, 0x53, 0x71, 0x53, 0x71, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 
+	0x6c, 0x6f, 0x61, 0x74, 0x20, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x3d, 
+	0x20, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x47, 0x47, 0x58, 0x28, 0x64, 0x6f, 0x74, 0x4e, 0x6f, 0x72, 0x6d, 
+	0x61, 0x6c, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 
+	0x43, 0x6f, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x74, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x09, 0x64, 0x69, 0x66, 0x66, 0x75, 0x73, 
+	0x65, 0x20, 0x2b, 0x3d, 0x20, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x2a, 0x20, 0x28, 0x31, 0x2e, 0x30, 
+	0x20, 0x2d, 0x20, 0x66, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x52, 0x65, 0x66, 0x6c, 0x65, 0x63, 0x74, 0x61, 0x6e, 0x63, 
+	0x65, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x20, 0x2b, 0x3d, 0x20, 0x72, 0x61, 
+	0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x2a, 0x20, 0x66, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x52, 0x65, 0x66, 0x6c, 
+	0x65, 0x63, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x2a, 0x20, 0x64, 0x69, 0x73, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x69, 
+	0x6f, 0x6e, 0x20, 0x2a, 0x20, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x2f, 
+	0x20, 0x64, 0x6f, 0x74, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x3b, 0x0a, 
+	0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x43, 0x6f, 0x72, 0x72, 0x65, 0x63, 0x74, 0x20, 0x64, 0x69, 0x66, 0x66, 
+	0x75, 0x73, 0x65, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x20, 0x62, 0x79, 0x20, 
+	0x73, 0x6f, 0x6d, 0x65, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x74, 0x73, 0x20, 0x28, 0x63, 0x6f, 0x6d, 0x70, 
+	0x75, 0x74, 0x65, 0x64, 0x20, 0x61, 0x74, 0x20, 0x74, 0x68, 0x65, 0x20, 0x65, 0x6e, 0x64, 0x20, 0x66, 0x6f, 0x72, 0x20, 
+	0x6f, 0x70, 0x74, 0x69, 0x6d, 0x69, 0x7a, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x0a, 0x0a, 0x09, 0x64, 0x69, 0x66, 0x66, 
+	0x75, 0x73, 0x65, 0x20, 0x2a, 0x3d, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x2a, 0x20, 0x28, 0x31, 0x2e, 0x30, 0x20, 
+	0x2d, 0x20, 0x6d, 0x65, 0x74, 0x61, 0x6c, 0x6c, 0x69, 0x63, 0x29, 0x20, 0x2f, 0x20, 0x63, 0x5f, 0x70, 0x69, 0x3b, 0x0a, 
+	0x09, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x20, 0x2a, 0x3d, 0x20, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 
+	0x79, 0x56, 0x69, 0x65, 0x77, 0x20, 0x2f, 0x20, 0x28, 0x34, 0x2e, 0x30, 0x20, 0x2a, 0x20, 0x64, 0x6f, 0x74, 0x4e, 0x6f, 
+	0x72, 0x6d, 0x61, 0x6c, 0x56, 0x69, 0x65, 0x77, 0x44, 0x69, 0x72, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 
+	0x72, 0x6e, 0x20, 0x61, 0x6d, 0x62, 0x69, 0x61, 0x6e, 0x74, 0x20, 0x2b, 0x20, 0x64, 0x69, 0x66, 0x66, 0x75, 0x73, 0x65, 
+	0x20, 0x2b, 0x20, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x3b, 0x0a, 0x7d, 0x0a, 0x00
 };
 
 static constexpr char lightingHeader_glsl[] = {
@@ -394,38 +1120,62 @@ static constexpr char lightingHeader_glsl[] = {
 	0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x5f, 0x64, 0x69, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x72, 0x69, 0x63, 0x4e, 0x6f, 
 	0x72, 0x6d, 0x61, 0x6c, 0x46, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x52, 0x65, 0x66, 0x6c, 0x65, 0x63, 0x74, 0x61, 0x6e, 
 	0x63, 0x65, 0x20, 0x3d, 0x20, 0x76, 0x65, 0x63, 0x33, 0x28, 0x30, 0x2e, 0x30, 0x34, 0x29, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 
-	0x20, 0x46, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x64, 0x65, 0x63, 0x6c, 0x61, 0x72, 0x61, 0x74, 0x69, 0x6f, 
-	0x6e, 0x73, 0x0a, 0x0a, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x53, 0x68, 0x61, 
-	0x64, 0x6f, 0x77, 0x4f, 0x63, 0x63, 0x6c, 0x75, 0x73, 0x69, 0x6f, 0x6e, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 
-	0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x69, 0x6e, 0x20, 
-	0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x69, 
-	0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x29, 0x3b, 0x0a, 0x76, 0x6f, 0x69, 
-	0x64, 0x20, 0x63, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x41, 0x6e, 0x64, 
-	0x52, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 
-	0x63, 0x33, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 
-	0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x2c, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6c, 
-	0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x72, 0x61, 
-	0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x3b, 0x0a, 0x0a, 0x76, 0x65, 0x63, 0x33, 0x20, 0x66, 0x72, 0x65, 0x73, 0x6e, 
-	0x65, 0x6c, 0x53, 0x63, 0x68, 0x6c, 0x69, 0x63, 0x6b, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 
-	0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 
-	0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 
-	0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x46, 0x72, 0x65, 0x73, 
-	0x6e, 0x65, 0x6c, 0x52, 0x65, 0x66, 0x6c, 0x65, 0x63, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x3b, 0x0a, 0x66, 0x6c, 0x6f, 
-	0x61, 0x74, 0x20, 0x64, 0x69, 0x73, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x47, 0x47, 0x58, 0x28, 0x69, 
+	0x20, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x74, 0x79, 0x70, 0x65, 0x73, 0x20, 0x6c, 0x69, 0x74, 0x20, 0x62, 0x79, 0x20, 
+	0x74, 0x68, 0x65, 0x20, 0x73, 0x68, 0x61, 0x64, 0x65, 0x72, 0x2c, 0x20, 0x61, 0x20, 0x62, 0x69, 0x74, 0x20, 0x70, 0x65, 
+	0x72, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3a, 0x20, 0x70, 0x6f, 0x69, 0x6e, 0x74, 0x2c, 0x20, 0x73, 0x75, 0x6e, 0x2c, 0x20, 
+	0x73, 0x70, 0x6f, 0x74, 0x2e, 0x20, 0x50, 0x72, 0x6f, 0x67, 0x72, 0x61, 0x6d, 0x73, 0x20, 0x73, 0x70, 0x65, 0x63, 0x69, 
+	0x61, 0x6c, 0x69, 0x7a, 0x65, 0x64, 0x20, 0x74, 0x6f, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 
+	0x20, 0x6f, 0x66, 0x20, 0x61, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x20, 0x61, 0x72, 0x65, 0x0a, 0x2f, 0x2f, 0x20, 0x63, 
+	0x6f, 0x6d, 0x70, 0x69, 0x6c, 0x65, 0x64, 0x20, 0x77, 0x69, 0x74, 0x68, 0x6f, 0x75, 0x74, 0x20, 0x74, 0x68, 0x65, 0x20, 
+	0x6f, 0x74, 0x68, 0x65, 0x72, 0x73, 0x2e, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x6e, 0x64, 0x65, 0x66, 0x20, 0x4c, 0x49, 0x47, 
+	0x48, 0x54, 0x5f, 0x54, 0x59, 0x50, 0x45, 0x53, 0x0a, 0x09, 0x23, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x65, 0x20, 0x4c, 0x49, 
+	0x47, 0x48, 0x54, 0x5f, 0x54, 0x59, 0x50, 0x45, 0x53, 0x20, 0x37, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 
+	0x2f, 0x2f, 0x20, 0x46, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x64, 0x65, 0x63, 0x6c, 0x61, 0x72, 0x61, 0x74, 
+	0x69, 0x6f, 0x6e, 0x73, 0x0a, 0x0a, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x53, 
+	0x68, 0x61, 0x64, 0x6f, 0x77, 0x4f, 0x63, 0x63, 0x6c, 0x75, 0x73, 0x69, 0x6f, 0x6e, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 
+	0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x69, 
 	0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 
-	0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x76, 0x65, 0x63, 0x74, 0x6f, 
-	0x72, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x72, 0x6f, 
-	0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 0x29, 0x3b, 0x0a, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x67, 0x65, 0x6f, 0x6d, 
-	0x65, 0x74, 0x72, 0x79, 0x47, 0x47, 0x58, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 
-	0x61, 0x74, 0x20, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 
-	0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x72, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 0x29, 0x3b, 0x0a, 0x0a, 0x76, 
-	0x65, 0x63, 0x33, 0x20, 0x63, 0x6f, 0x6f, 0x6b, 0x54, 0x6f, 0x72, 0x72, 0x61, 0x6e, 0x63, 0x65, 0x28, 0x69, 0x6e, 0x20, 
-	0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2c, 0x20, 0x69, 0x6e, 
-	0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 
-	0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 
-	0x61, 0x6c, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x70, 0x6f, 
-	0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x73, 0x61, 
-	0x6f, 0x29, 0x3b, 0x0a, 0x00
+	0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x29, 0x3b, 0x0a, 0x76, 
+	0x6f, 0x69, 0x64, 0x20, 0x63, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x41, 
+	0x6e, 0x64, 0x52, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 
+	0x76, 0x65, 0x63, 0x33, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 
+	0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x2c, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 
+	0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 
+	0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x3b, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x63, 0x6f, 0x6d, 0x70, 
+	0x75, 0x74, 0x65, 0x50, 0x6f, 0x69, 0x6e, 0x74, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 
+	0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x69, 0x6e, 
+	0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x2c, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 
+	0x65, 0x63, 0x33, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 
+	0x63, 0x33, 0x20, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x3b, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x63, 
+	0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x53, 0x75, 0x6e, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 
+	0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x2c, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 
+	0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 
+	0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x3b, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x63, 0x6f, 0x6d, 0x70, 
+	0x75, 0x74, 0x65, 0x53, 0x70, 0x6f, 0x74, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 
+	0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x69, 0x6e, 0x20, 
+	0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x2c, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 
+	0x63, 0x33, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 
+	0x33, 0x20, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x3b, 0x0a, 0x0a, 0x76, 0x65, 0x63, 0x33, 0x20, 0x66, 
+	0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x53, 0x63, 0x68, 0x6c, 0x69, 0x63, 0x6b, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 
+	0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 
+	0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x44, 0x69, 0x72, 0x2c, 0x20, 
+	0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 
+	0x46, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x52, 0x65, 0x66, 0x6c, 0x65, 0x63, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x29, 0x3b, 
+	0x0a, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x64, 0x69, 0x73, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x47, 
+	0x47, 0x58, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 
+	0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x76, 
+	0x65, 0x63, 0x74, 0x6f, 0x72, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 
+	0x74, 0x20, 0x72, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 0x29, 0x3b, 0x0a, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+	0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x47, 0x47, 0x58, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 
+	0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x54, 0x68, 0x65, 0x74, 0x61, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 
+	0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x72, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 0x29, 
+	0x3b, 0x0a, 0x0a, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x6f, 0x6f, 0x6b, 0x54, 0x6f, 0x72, 0x72, 0x61, 0x6e, 0x63, 0x65, 
+	0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 
+	0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6d, 0x61, 0x74, 0x65, 
+	0x72, 0x69, 0x61, 0x6c, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 
+	0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 
+	0x33, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x69, 0x6e, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
+	0x20, 0x73, 0x73, 0x61, 0x6f, 0x29, 0x3b, 0x0a, 0x00
 };
 
 static constexpr char merge_frag[] = {
@@ -710,87 +1460,99 @@ static constexpr char mesh_gBuffer_frag[] = {
 	0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x64, 0x65, 0x70, 
 	0x74, 0x68, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 0x09, 0x76, 
 	0x65, 0x63, 0x33, 0x20, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 
-	0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 0x7d, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 
-	0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x55, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 
-	0x73, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 0x4f, 0x4c, 0x4f, 0x52, 0x5f, 0x54, 0x45, 0x58, 0x54, 
-	0x55, 0x52, 0x45, 0x0a, 0x09, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 
-	0x32, 0x44, 0x20, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 
-	0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 
-	0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 
-	0x64, 0x69, 0x66, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x4d, 0x41, 0x54, 0x45, 0x52, 0x49, 0x41, 0x4c, 
-	0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 
-	0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x4d, 0x61, 
-	0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x3b, 0x0a, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x75, 0x6e, 0x69, 0x66, 0x6f, 
-	0x72, 0x6d, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x4d, 0x61, 
-	0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x64, 
-	0x65, 0x66, 0x20, 0x4e, 0x4f, 0x52, 0x4d, 0x41, 0x4c, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x75, 
-	0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 0x5f, 0x64, 
-	0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 
-	0x66, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x72, 0x61, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x6f, 0x75, 0x74, 0x70, 0x75, 
-	0x74, 0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 
-	0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x66, 0x6f, 0x5f, 0x63, 0x6f, 
-	0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 
-	0x6e, 0x20, 0x3d, 0x20, 0x31, 0x29, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x66, 0x6f, 0x5f, 0x6d, 
-	0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x3b, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 
-	0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x32, 0x29, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 
-	0x66, 0x6f, 0x5f, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 
-	0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x33, 0x29, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 
-	0x33, 0x20, 0x66, 0x6f, 0x5f, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x75, 
-	0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x0a, 0x0a, 
-	0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x44, 0x65, 
-	0x70, 0x74, 0x68, 0x0a, 0x09, 0x0a, 0x09, 0x67, 0x6c, 0x5f, 0x46, 0x72, 0x61, 0x67, 0x44, 0x65, 0x70, 0x74, 0x68, 0x20, 
-	0x3d, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x64, 0x65, 
-	0x70, 0x74, 0x68, 0x3b, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x0a, 0x0a, 0x09, 0x23, 0x69, 
-	0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 0x4f, 0x4c, 0x4f, 0x52, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 
-	0x09, 0x76, 0x65, 0x63, 0x34, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 
-	0x65, 0x28, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x2c, 0x20, 0x69, 
-	0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x65, 0x78, 0x43, 0x6f, 
-	0x6f, 0x72, 0x64, 0x73, 0x29, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x09, 0x76, 0x65, 0x63, 0x34, 
-	0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x43, 
-	0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x49, 
-	0x66, 0x20, 0x74, 0x68, 0x65, 0x72, 0x65, 0x20, 0x69, 0x73, 0x20, 0x61, 0x6c, 0x70, 0x68, 0x61, 0x20, 0x74, 0x72, 0x61, 
-	0x6e, 0x73, 0x70, 0x61, 0x72, 0x65, 0x6e, 0x63, 0x79, 0x2c, 0x20, 0x74, 0x68, 0x65, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 
-	0x66, 0x72, 0x61, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x6d, 0x75, 0x73, 0x74, 0x20, 0x62, 0x65, 0x20, 0x64, 0x69, 0x73, 
-	0x63, 0x61, 0x72, 0x64, 0x65, 0x64, 0x2e, 0x20, 0x49, 0x74, 0x20, 0x77, 0x69, 0x6c, 0x6c, 0x20, 0x62, 0x65, 0x20, 0x68, 
-	0x61, 0x6e, 0x64, 0x6c, 0x65, 0x64, 0x20, 0x62, 0x79, 0x20, 0x74, 0x68, 0x65, 0x20, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x70, 
-	0x61, 0x72, 0x65, 0x6e, 0x63, 0x79, 0x20, 0x73, 0x68, 0x61, 0x64, 0x65, 0x72, 0x20, 0x21, 0x0a, 0x09, 0x69, 0x66, 0x20, 
-	0x28, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2e, 0x61, 0x20, 0x21, 0x3d, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 
-	0x09, 0x09, 0x64, 0x69, 0x73, 0x63, 0x61, 0x72, 0x64, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x09, 0x0a, 0x09, 0x66, 0x6f, 0x5f, 
-	0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2e, 0x72, 0x67, 0x62, 0x3b, 0x0a, 0x0a, 
-	0x09, 0x2f, 0x2f, 0x20, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x0a, 0x0a, 0x09, 0x23, 0x69, 0x66, 0x64, 0x65, 
-	0x66, 0x20, 0x4d, 0x41, 0x54, 0x45, 0x52, 0x49, 0x41, 0x4c, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 
-	0x09, 0x66, 0x6f, 0x5f, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 
-	0x72, 0x65, 0x28, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 
-	0x6c, 0x2c, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 
-	0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x29, 0x2e, 0x72, 0x67, 0x62, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6c, 0x73, 
-	0x65, 0x0a, 0x09, 0x09, 0x66, 0x6f, 0x5f, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x75, 0x5f, 
-	0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x3b, 0x0a, 0x09, 0x23, 
-	0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 0x61, 0x6e, 
-	0x64, 0x20, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x0a, 0x0a, 0x09, 0x66, 0x6f, 0x5f, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 
-	0x6c, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 
-	0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x29, 0x3b, 0x0a, 0x09, 
-	0x66, 0x6f, 0x5f, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 
-	0x7a, 0x65, 0x28, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 
-	0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x4e, 0x4f, 
-	0x52, 0x4d, 0x41, 0x4c, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 
-	0x62, 0x69, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x63, 0x72, 0x6f, 0x73, 0x73, 0x28, 0x66, 0x6f, 
-	0x5f, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x66, 0x6f, 0x5f, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x29, 
-	0x3b, 0x0a, 0x09, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x4d, 0x61, 0x70, 0x56, 0x61, 
-	0x6c, 0x75, 0x65, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x74, 0x65, 0x78, 0x74, 
-	0x75, 0x72, 0x65, 0x28, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 
+	0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 0x09, 0x66, 0x6c, 0x61, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 
+	0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x49, 0x6e, 0x64, 0x65, 0x78, 0x3b, 0x0a, 0x7d, 0x20, 0x69, 0x6f, 
+	0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x53, 
+	0x68, 0x61, 0x64, 0x65, 0x72, 0x20, 0x73, 0x74, 0x6f, 0x72, 0x61, 0x67, 0x65, 0x20, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x73, 
+	0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 0x34, 0x33, 0x30, 0x2c, 0x20, 0x62, 0x69, 
+	0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x38, 0x29, 0x20, 0x72, 0x65, 0x61, 0x64, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 
+	0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 
+	0x73, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 
+	0x44, 0x61, 0x74, 0x61, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x73, 0x5b, 
+	0x5d, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x55, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x73, 0x0a, 0x0a, 
+	0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 0x4f, 0x4c, 0x4f, 0x52, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 
+	0x0a, 0x09, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x53, 0x61, 
+	0x6d, 0x70, 0x6c, 0x65, 0x72, 0x20, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x43, 0x6f, 0x6c, 0x6f, 
+	0x72, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x4d, 0x41, 
+	0x54, 0x45, 0x52, 0x49, 0x41, 0x4c, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x75, 0x6e, 0x69, 0x66, 
+	0x6f, 0x72, 0x6d, 0x20, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x53, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x20, 
+	0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x3b, 0x0a, 
+	0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x4e, 0x4f, 0x52, 0x4d, 0x41, 
+	0x4c, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 
+	0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x4e, 
+	0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x72, 
+	0x61, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x6f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 
+	0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x6f, 0x75, 
+	0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x66, 0x6f, 0x5f, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x6c, 0x61, 0x79, 
+	0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x31, 0x29, 0x20, 0x6f, 
+	0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x66, 0x6f, 0x5f, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x3b, 
+	0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 
+	0x32, 0x29, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x66, 0x6f, 0x5f, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 
+	0x6c, 0x3b, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 
+	0x3d, 0x20, 0x33, 0x29, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x66, 0x6f, 0x5f, 0x74, 0x61, 0x6e, 
+	0x67, 0x65, 0x6e, 0x74, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x64, 
+	0x65, 0x66, 0x69, 0x6e, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 
+	0x6e, 0x28, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x44, 0x65, 0x70, 0x74, 0x68, 0x0a, 0x09, 0x0a, 0x09, 0x67, 
+	0x6c, 0x5f, 0x46, 0x72, 0x61, 0x67, 0x44, 0x65, 0x70, 0x74, 0x68, 0x20, 0x3d, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 
+	0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x64, 0x65, 0x70, 0x74, 0x68, 0x3b, 0x0a, 0x0a, 0x09, 0x63, 
+	0x6f, 0x6e, 0x73, 0x74, 0x20, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x44, 0x61, 0x74, 0x61, 0x20, 0x6d, 0x61, 
+	0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 
+	0x61, 0x6c, 0x73, 0x5b, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 
+	0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x49, 0x6e, 0x64, 0x65, 0x78, 0x5d, 0x3b, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 
+	0x20, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x0a, 0x0a, 0x09, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 0x4f, 0x4c, 0x4f, 
+	0x52, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x09, 0x76, 0x65, 0x63, 0x34, 0x20, 0x63, 0x6f, 0x6c, 
+	0x6f, 0x72, 0x20, 0x3d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x54, 
+	0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x43, 0x6f, 0x6c, 
+	0x6f, 0x72, 0x2c, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 
+	0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2c, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x2e, 
+	0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x4c, 0x61, 0x79, 0x65, 0x72, 0x29, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 
+	0x09, 0x09, 0x76, 0x65, 0x63, 0x34, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 
+	0x69, 0x61, 0x6c, 0x2e, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 
+	0x09, 0x2f, 0x2f, 0x20, 0x49, 0x66, 0x20, 0x74, 0x68, 0x65, 0x72, 0x65, 0x20, 0x69, 0x73, 0x20, 0x61, 0x6c, 0x70, 0x68, 
+	0x61, 0x20, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x70, 0x61, 0x72, 0x65, 0x6e, 0x63, 0x79, 0x2c, 0x20, 0x74, 0x68, 0x65, 0x6e, 
+	0x20, 0x74, 0x68, 0x65, 0x20, 0x66, 0x72, 0x61, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x6d, 0x75, 0x73, 0x74, 0x20, 0x62, 
+	0x65, 0x20, 0x64, 0x69, 0x73, 0x63, 0x61, 0x72, 0x64, 0x65, 0x64, 0x2e, 0x20, 0x49, 0x74, 0x20, 0x77, 0x69, 0x6c, 0x6c, 
+	0x20, 0x62, 0x65, 0x20, 0x68, 0x61, 0x6e, 0x64, 0x6c, 0x65, 0x64, 0x20, 0x62, 0x79, 0x20, 0x74, 0x68, 0x65, 0x20, 0x74, 
+	0x72, 0x61, 0x6e, 0x73, 0x70, 0x61, 0x72, 0x65, 0x6e, 0x63, 0x79, 0x20, 0x73, 0x68, 0x61, 0x64, 0x65, 0x72, 0x20, 0x21, 
+	0x0a, 0x09, 0x69, 0x66, 0x20, 0x28, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2e, 0x61, 0x20, 0x21, 0x3d, 0x20, 0x31, 0x2e, 0x30, 
+	0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x64, 0x69, 0x73, 0x63, 0x61, 0x72, 0x64, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x09, 
+	0x0a, 0x09, 0x66, 0x6f, 0x5f, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2e, 0x72, 
+	0x67, 0x62, 0x3b, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x0a, 0x0a, 0x09, 
+	0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x4d, 0x41, 0x54, 0x45, 0x52, 0x49, 0x41, 0x4c, 0x5f, 0x54, 0x45, 0x58, 0x54, 
+	0x55, 0x52, 0x45, 0x0a, 0x09, 0x09, 0x66, 0x6f, 0x5f, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x20, 0x3d, 0x20, 
+	0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x54, 0x65, 0x78, 0x74, 0x75, 0x72, 
+	0x65, 0x28, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 
 	0x2c, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x65, 
-	0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x29, 0x2e, 0x72, 0x67, 0x62, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x66, 0x6f, 0x5f, 
-	0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x66, 
-	0x6f, 0x5f, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x2a, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x4d, 0x61, 
-	0x70, 0x56, 0x61, 0x6c, 0x75, 0x65, 0x2e, 0x78, 0x20, 0x2b, 0x20, 0x62, 0x69, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 
-	0x20, 0x2a, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x4d, 0x61, 0x70, 0x56, 0x61, 0x6c, 0x75, 0x65, 0x2e, 0x79, 0x20, 
-	0x2b, 0x20, 0x66, 0x6f, 0x5f, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 0x2a, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 
-	0x4d, 0x61, 0x70, 0x56, 0x61, 0x6c, 0x75, 0x65, 0x2e, 0x7a, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x66, 0x6f, 0x5f, 0x74, 0x61, 
-	0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x66, 0x6f, 
-	0x5f, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x2d, 0x20, 0x64, 0x6f, 0x74, 0x28, 0x66, 0x6f, 0x5f, 0x74, 0x61, 
-	0x6e, 0x67, 0x65, 0x6e, 0x74, 0x2c, 0x20, 0x66, 0x6f, 0x5f, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x29, 0x20, 0x2a, 0x20, 
-	0x66, 0x6f, 0x5f, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x29, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 
-	0x7d, 0x20, 0x0a, 0x00
+	0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2c, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x2e, 0x70, 0x72, 
+	0x6f, 0x70, 0x65, 0x72, 0x74, 0x69, 0x65, 0x73, 0x4c, 0x61, 0x79, 0x65, 0x72, 0x29, 0x2e, 0x72, 0x67, 0x62, 0x3b, 0x0a, 
+	0x09, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x09, 0x66, 0x6f, 0x5f, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 
+	0x20, 0x3d, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x2e, 0x70, 0x72, 0x6f, 0x70, 0x65, 0x72, 0x74, 0x69, 
+	0x65, 0x73, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x4e, 0x6f, 0x72, 
+	0x6d, 0x61, 0x6c, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x0a, 0x0a, 0x09, 0x66, 0x6f, 
+	0x5f, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 
+	0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x6e, 0x6f, 0x72, 0x6d, 
+	0x61, 0x6c, 0x29, 0x3b, 0x0a, 0x09, 0x66, 0x6f, 0x5f, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x6e, 
+	0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 
+	0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x23, 0x69, 0x66, 
+	0x64, 0x65, 0x66, 0x20, 0x4e, 0x4f, 0x52, 0x4d, 0x41, 0x4c, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 
+	0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 0x69, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x63, 0x72, 
+	0x6f, 0x73, 0x73, 0x28, 0x66, 0x6f, 0x5f, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x66, 0x6f, 0x5f, 0x74, 0x61, 
+	0x6e, 0x67, 0x65, 0x6e, 0x74, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 
+	0x6c, 0x4d, 0x61, 0x70, 0x56, 0x61, 0x6c, 0x75, 0x65, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 
+	0x65, 0x28, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 
+	0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 
+	0x70, 0x75, 0x74, 0x2e, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x29, 0x2e, 0x72, 0x67, 0x62, 0x29, 0x3b, 
+	0x0a, 0x09, 0x09, 0x66, 0x6f, 0x5f, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 
+	0x6c, 0x69, 0x7a, 0x65, 0x28, 0x66, 0x6f, 0x5f, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x2a, 0x20, 0x6e, 0x6f, 
+	0x72, 0x6d, 0x61, 0x6c, 0x4d, 0x61, 0x70, 0x56, 0x61, 0x6c, 0x75, 0x65, 0x2e, 0x78, 0x20, 0x2b, 0x20, 0x62, 0x69, 0x74, 
+	0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x2a, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x4d, 0x61, 0x70, 0x56, 0x61, 
+	0x6c, 0x75, 0x65, 0x2e, 0x79, 0x20, 0x2b, 0x20, 0x66, 0x6f, 0x5f, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 0x2a, 0x20, 
+	0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x4d, 0x61, 0x70, 0x56, 0x61, 0x6c, 0x75, 0x65, 0x2e, 0x7a, 0x29, 0x3b, 0x0a, 0x09, 
+	0x09, 0x66, 0x6f, 0x5f, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 
+	0x69, 0x7a, 0x65, 0x28, 0x66, 0x6f, 0x5f, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x2d, 0x20, 0x64, 0x6f, 0x74, 
+	0x28, 0x66, 0x6f, 0x5f, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x2c, 0x20, 0x66, 0x6f, 0x5f, 0x6e, 0x6f, 0x72, 0x6d, 
+	0x61, 0x6c, 0x29, 0x20, 0x2a, 0x20, 0x66, 0x6f, 0x5f, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x29, 0x3b, 0x0a, 0x09, 0x23, 
+	0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x7d, 0x20, 0x0a, 0x00
 };
 
 static constexpr char mesh_gBuffer_vert[] = {
@@ -811,62 +1573,119 @@ static constexpr char mesh_gBuffer_vert[] = {
 	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
 	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x0a, 
 	0x0a, 0x2f, 0x2f, 0x20, 0x56, 0x65, 0x72, 0x74, 0x65, 0x78, 0x20, 0x61, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65, 
-	0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 
-	0x3d, 0x20, 0x30, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x61, 0x5f, 0x70, 0x6f, 0x73, 0x69, 
-	0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 
-	0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x31, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x61, 0x5f, 0x6e, 
-	0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 
-	0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x32, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x61, 0x5f, 
-	0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x3b, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 
-	0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x33, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 
-	0x61, 0x5f, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x55, 0x6e, 0x69, 
-	0x66, 0x6f, 0x72, 0x6d, 0x20, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 
-	0x28, 0x73, 0x74, 0x64, 0x31, 0x34, 0x30, 0x2c, 0x20, 0x72, 0x6f, 0x77, 0x5f, 0x6d, 0x61, 0x6a, 0x6f, 0x72, 0x2c, 0x20, 
-	0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 
-	0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 
-	0x0a, 0x09, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x44, 0x61, 0x74, 0x61, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 
-	0x65, 0x72, 0x61, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 
-	0x31, 0x34, 0x30, 0x2c, 0x20, 0x72, 0x6f, 0x77, 0x5f, 0x6d, 0x61, 0x6a, 0x6f, 0x72, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 
-	0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x32, 0x29, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x75, 0x62, 0x6f, 
-	0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 
+	0x73, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 0x4f, 0x4d, 0x50, 0x41, 0x43, 0x54, 0x5f, 0x56, 0x45, 
+	0x52, 0x54, 0x45, 0x58, 0x0a, 0x09, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 
+	0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x75, 0x76, 0x65, 0x63, 0x32, 0x20, 0x76, 0x61, 0x5f, 
+	0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x09, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 
+	0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x31, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x75, 0x69, 0x6e, 0x74, 
+	0x20, 0x76, 0x61, 0x5f, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 0x09, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 
+	0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x32, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x75, 0x69, 
+	0x6e, 0x74, 0x20, 0x76, 0x61, 0x5f, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x6c, 0x61, 0x79, 0x6f, 
+	0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x33, 0x29, 0x20, 0x69, 0x6e, 
+	0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x76, 0x61, 0x5f, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 
+	0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 
+	0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x61, 0x5f, 
+	0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x09, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 
+	0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x31, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 
+	0x20, 0x76, 0x61, 0x5f, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 0x09, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 
+	0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x32, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x65, 
+	0x63, 0x34, 0x20, 0x76, 0x61, 0x5f, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x6c, 0x61, 0x79, 0x6f, 
+	0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x33, 0x29, 0x20, 0x69, 0x6e, 
+	0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x61, 0x5f, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 
+	0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x55, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x62, 
+	0x6c, 0x6f, 0x63, 0x6b, 0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 0x31, 0x34, 
+	0x30, 0x2c, 0x20, 0x72, 0x6f, 0x77, 0x5f, 0x6d, 0x61, 0x6a, 0x6f, 0x72, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 
+	0x67, 0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 
+	0x61, 0x6d, 0x65, 0x72, 0x61, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x43, 0x61, 0x6d, 0x65, 
+	0x72, 0x61, 0x44, 0x61, 0x74, 0x61, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x3b, 0x0a, 0x7d, 
+	0x3b, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x47, 0x50, 0x55, 0x5f, 0x44, 0x52, 0x49, 0x56, 0x45, 0x4e, 
+	0x0a, 0x09, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 0x34, 0x33, 0x30, 0x2c, 0x20, 0x72, 0x6f, 
+	0x77, 0x5f, 0x6d, 0x61, 0x6a, 0x6f, 0x72, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x30, 
+	0x29, 0x20, 0x72, 0x65, 0x61, 0x64, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 0x73, 0x73, 
+	0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x73, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 
+	0x09, 0x7b, 0x0a, 0x09, 0x09, 0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x44, 0x61, 0x74, 0x61, 0x20, 0x73, 0x73, 
+	0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x73, 0x5b, 0x5d, 0x3b, 0x0a, 0x09, 0x7d, 0x3b, 0x0a, 
+	0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 0x31, 0x34, 
+	0x30, 0x2c, 0x20, 0x72, 0x6f, 0x77, 0x5f, 0x6d, 0x61, 0x6a, 0x6f, 0x72, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 
+	0x67, 0x20, 0x3d, 0x20, 0x32, 0x29, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x64, 
+	0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 
 	0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x44, 0x61, 0x74, 0x61, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 
-	0x77, 0x61, 0x62, 0x6c, 0x65, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 
-	0x73, 0x0a, 0x0a, 0x6f, 0x75, 0x74, 0x20, 0x56, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x0a, 
-	0x7b, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x64, 0x65, 0x70, 0x74, 0x68, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 
-	0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x74, 0x61, 0x6e, 0x67, 
-	0x65, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 
-	0x3b, 0x0a, 0x7d, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x3b, 
-	0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x69, 
-	0x74, 0x69, 0x6f, 0x6e, 0x73, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x0a, 0x7b, 
-	0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x20, 0x65, 0x76, 0x65, 0x72, 0x79, 0x74, 0x68, 
-	0x69, 0x6e, 0x67, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x69, 0x65, 0x77, 0x2d, 0x73, 0x70, 0x61, 0x63, 0x65, 0x0a, 0x09, 0x0a, 
-	0x09, 0x67, 0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x64, 
-	0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x76, 0x69, 0x65, 0x77, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x20, 0x2a, 0x20, 
-	0x76, 0x61, 0x5f, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x0a, 0x09, 0x69, 0x6f, 0x5f, 0x76, 0x65, 
-	0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x64, 0x65, 0x70, 0x74, 0x68, 0x20, 0x3d, 0x20, 0x31, 
-	0x2e, 0x30, 0x20, 0x2d, 0x20, 0x28, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 0x66, 0x61, 0x72, 
-	0x20, 0x2b, 0x20, 0x67, 0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x7a, 0x29, 0x20, 0x2f, 0x20, 
-	0x28, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 0x66, 0x61, 0x72, 0x20, 0x2d, 0x20, 0x75, 0x62, 
-	0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 0x6e, 0x65, 0x61, 0x72, 0x29, 0x3b, 0x0a, 0x09, 0x69, 0x6f, 0x5f, 
-	0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 
-	0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x75, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 
-	0x61, 0x62, 0x6c, 0x65, 0x2e, 0x76, 0x69, 0x65, 0x77, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x20, 0x2a, 0x20, 0x76, 0x61, 0x5f, 
-	0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x29, 0x2e, 0x78, 0x79, 0x7a, 0x3b, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x54, 0x4f, 0x44, 
-	0x4f, 0x3a, 0x20, 0x43, 0x68, 0x61, 0x6e, 0x67, 0x65, 0x20, 0x74, 0x68, 0x61, 0x74, 0x20, 0x21, 0x20, 0x4e, 0x6f, 0x74, 
-	0x20, 0x4f, 0x4b, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x6e, 0x6f, 0x6e, 0x2d, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 
-	0x73, 0x63, 0x61, 0x6c, 0x65, 0x20, 0x21, 0x0a, 0x09, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 
-	0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 
-	0x6c, 0x69, 0x7a, 0x65, 0x28, 0x75, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x76, 0x69, 
-	0x65, 0x77, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x20, 0x2a, 0x20, 0x76, 0x61, 0x5f, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 
-	0x29, 0x2e, 0x78, 0x79, 0x7a, 0x3b, 0x09, 0x2f, 0x2f, 0x20, 0x54, 0x4f, 0x44, 0x4f, 0x3a, 0x20, 0x43, 0x68, 0x61, 0x6e, 
-	0x67, 0x65, 0x20, 0x74, 0x68, 0x61, 0x74, 0x20, 0x21, 0x20, 0x4e, 0x6f, 0x74, 0x20, 0x4f, 0x4b, 0x20, 0x66, 0x6f, 0x72, 
-	0x20, 0x6e, 0x6f, 0x6e, 0x2d, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x20, 0x21, 
-	0x0a, 0x09, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x65, 
-	0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x3d, 0x20, 0x76, 0x61, 0x5f, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 
-	0x64, 0x73, 0x2e, 0x78, 0x79, 0x3b, 0x0a, 0x0a, 0x09, 0x67, 0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 
-	0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 0x70, 0x72, 0x6f, 0x6a, 0x65, 0x63, 
-	0x74, 0x69, 0x6f, 0x6e, 0x20, 0x2a, 0x20, 0x67, 0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 
-	0x7d, 0x0a, 0x00
+	0x77, 0x61, 0x62, 0x6c, 0x65, 0x3b, 0x0a, 0x09, 0x7d, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x2f, 
+	0x2f, 0x20, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x73, 0x0a, 0x0a, 0x6f, 0x75, 0x74, 0x20, 0x56, 0x65, 0x72, 0x74, 0x65, 
+	0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x64, 0x65, 0x70, 
+	0x74, 0x68, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 0x09, 0x76, 
+	0x65, 0x63, 0x33, 0x20, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 
+	0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 0x09, 0x66, 0x6c, 0x61, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 
+	0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x49, 0x6e, 0x64, 0x65, 0x78, 0x3b, 0x0a, 0x7d, 0x20, 0x69, 0x6f, 
+	0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 
+	0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x0a, 
+	0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x49, 
+	0x6e, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x20, 0x64, 0x72, 0x61, 0x77, 0x73, 0x20, 0x63, 0x61, 0x72, 0x72, 0x79, 0x20, 
+	0x74, 0x68, 0x65, 0x20, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x20, 0x6f, 0x66, 0x20, 0x74, 0x68, 0x65, 0x20, 0x64, 0x72, 0x61, 
+	0x77, 0x61, 0x62, 0x6c, 0x65, 0x20, 0x69, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x69, 0x72, 0x20, 0x62, 0x61, 0x73, 0x65, 0x20, 
+	0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x0a, 0x0a, 0x09, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x47, 0x50, 
+	0x55, 0x5f, 0x44, 0x52, 0x49, 0x56, 0x45, 0x4e, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x44, 0x72, 0x61, 
+	0x77, 0x61, 0x62, 0x6c, 0x65, 0x44, 0x61, 0x74, 0x61, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x20, 0x3d, 
+	0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x73, 0x5b, 0x67, 0x6c, 0x5f, 0x42, 
+	0x61, 0x73, 0x65, 0x49, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x5d, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6c, 0x73, 0x65, 
+	0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x44, 0x61, 0x74, 
+	0x61, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 
+	0x77, 0x61, 0x62, 0x6c, 0x65, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 
+	0x44, 0x65, 0x63, 0x6f, 0x64, 0x65, 0x20, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x20, 0x61, 0x74, 0x74, 0x72, 0x69, 0x62, 
+	0x75, 0x74, 0x65, 0x73, 0x0a, 0x0a, 0x09, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 0x4f, 0x4d, 0x50, 0x41, 0x43, 
+	0x54, 0x5f, 0x56, 0x45, 0x52, 0x54, 0x45, 0x58, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 
+	0x34, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x64, 0x65, 0x63, 0x6f, 0x64, 0x65, 0x43, 
+	0x6f, 0x6d, 0x70, 0x61, 0x63, 0x74, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x76, 0x61, 0x5f, 0x70, 0x6f, 
+	0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x70, 0x6f, 0x73, 
+	0x69, 0x74, 0x69, 0x6f, 0x6e, 0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x2c, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 
+	0x65, 0x2e, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x53, 0x63, 0x61, 0x6c, 0x65, 0x29, 0x3b, 0x0a, 0x09, 0x09, 
+	0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 0x3d, 0x20, 
+	0x64, 0x65, 0x63, 0x6f, 0x64, 0x65, 0x4f, 0x63, 0x74, 0x61, 0x68, 0x65, 0x64, 0x72, 0x61, 0x6c, 0x44, 0x69, 0x72, 0x65, 
+	0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x76, 0x61, 0x5f, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x29, 0x3b, 0x0a, 0x09, 0x09, 
+	0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x3d, 
+	0x20, 0x64, 0x65, 0x63, 0x6f, 0x64, 0x65, 0x4f, 0x63, 0x74, 0x61, 0x68, 0x65, 0x64, 0x72, 0x61, 0x6c, 0x44, 0x69, 0x72, 
+	0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x76, 0x61, 0x5f, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x29, 0x3b, 0x0a, 
+	0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 
+	0x64, 0x73, 0x20, 0x3d, 0x20, 0x64, 0x65, 0x63, 0x6f, 0x64, 0x65, 0x48, 0x61, 0x6c, 0x66, 0x54, 0x65, 0x78, 0x43, 0x6f, 
+	0x6f, 0x72, 0x64, 0x73, 0x28, 0x76, 0x61, 0x5f, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x29, 0x3b, 0x0a, 
+	0x09, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 
+	0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x76, 0x61, 0x5f, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 
+	0x6f, 0x6e, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x6e, 0x6f, 0x72, 
+	0x6d, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x76, 0x61, 0x5f, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 0x09, 0x09, 0x63, 
+	0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 
+	0x76, 0x61, 0x5f, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 
+	0x76, 0x65, 0x63, 0x34, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x3d, 0x20, 0x76, 0x61, 0x5f, 
+	0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 
+	0x09, 0x2f, 0x2f, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x20, 0x65, 0x76, 0x65, 0x72, 0x79, 0x74, 0x68, 0x69, 
+	0x6e, 0x67, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x69, 0x65, 0x77, 0x2d, 0x73, 0x70, 0x61, 0x63, 0x65, 0x0a, 0x09, 0x0a, 0x09, 
+	0x67, 0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 
+	0x6c, 0x65, 0x2e, 0x76, 0x69, 0x65, 0x77, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x20, 0x2a, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 
+	0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x0a, 0x09, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 
+	0x75, 0x74, 0x2e, 0x64, 0x65, 0x70, 0x74, 0x68, 0x20, 0x3d, 0x20, 0x31, 0x2e, 0x30, 0x20, 0x2d, 0x20, 0x28, 0x75, 0x62, 
+	0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 0x66, 0x61, 0x72, 0x20, 0x2b, 0x20, 0x67, 0x6c, 0x5f, 0x50, 0x6f, 
+	0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x7a, 0x29, 0x20, 0x2f, 0x20, 0x28, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 
+	0x65, 0x72, 0x61, 0x2e, 0x66, 0x61, 0x72, 0x20, 0x2d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 
+	0x2e, 0x6e, 0x65, 0x61, 0x72, 0x29, 0x3b, 0x0a, 0x09, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 
+	0x74, 0x70, 0x75, 0x74, 0x2e, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 
+	0x69, 0x7a, 0x65, 0x28, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x76, 0x69, 0x65, 0x77, 0x4d, 0x6f, 0x64, 
+	0x65, 0x6c, 0x20, 0x2a, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x29, 0x2e, 0x78, 0x79, 0x7a, 0x3b, 0x09, 0x09, 0x2f, 
+	0x2f, 0x20, 0x54, 0x4f, 0x44, 0x4f, 0x3a, 0x20, 0x43, 0x68, 0x61, 0x6e, 0x67, 0x65, 0x20, 0x74, 0x68, 0x61, 0x74, 0x20, 
+	0x21, 0x20, 0x4e, 0x6f, 0x74, 0x20, 0x4f, 0x4b, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x6e, 0x6f, 0x6e, 0x2d, 0x75, 0x6e, 0x69, 
+	0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x20, 0x21, 0x0a, 0x09, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 
+	0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 
+	0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x76, 
+	0x69, 0x65, 0x77, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x20, 0x2a, 0x20, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x29, 0x2e, 
+	0x78, 0x79, 0x7a, 0x3b, 0x09, 0x2f, 0x2f, 0x20, 0x54, 0x4f, 0x44, 0x4f, 0x3a, 0x20, 0x43, 0x68, 0x61, 0x6e, 0x67, 0x65, 
+	0x20, 0x74, 0x68, 0x61, 0x74, 0x20, 0x21, 0x20, 0x4e, 0x6f, 0x74, 0x20, 0x4f, 0x4b, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x6e, 
+	0x6f, 0x6e, 0x2d, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x20, 0x21, 0x0a, 0x09, 
+	0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x65, 0x78, 0x43, 
+	0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x3d, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2e, 0x78, 0x79, 
+	0x3b, 0x0a, 0x09, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x6d, 
+	0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x49, 0x6e, 0x64, 0x65, 0x78, 0x20, 0x3d, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 
+	0x62, 0x6c, 0x65, 0x2e, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x49, 0x6e, 0x64, 0x65, 0x78, 0x3b, 0x0a, 0x0a, 
+	0x09, 0x67, 0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 
+	0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 0x70, 0x72, 0x6f, 0x6a, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x2a, 0x20, 0x67, 
+	0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x7d, 0x0a, 0x00
 };
 
 static constexpr char mesh_shadowMapping_frag[] = {
@@ -887,34 +1706,48 @@ static constexpr char mesh_shadowMapping_frag[] = {
 	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
 	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x0a, 
 	0x0a, 0x2f, 0x2f, 0x20, 0x49, 0x6e, 0x70, 0x75, 0x74, 0x73, 0x0a, 0x0a, 0x69, 0x6e, 0x20, 0x47, 0x65, 0x6f, 0x6d, 0x65, 
-	0x74, 0x72, 0x79, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 
-	0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x64, 0x65, 0x70, 0x74, 
-	0x68, 0x3b, 0x0a, 0x7d, 0x20, 0x69, 0x6f, 0x5f, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x4f, 0x75, 0x74, 0x70, 
-	0x75, 0x74, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x55, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x73, 0x0a, 0x0a, 0x23, 0x69, 
-	0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 0x4f, 0x4c, 0x4f, 0x52, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 
-	0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 0x5f, 
-	0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x23, 0x65, 0x6c, 0x73, 0x65, 
-	0x0a, 0x09, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x75, 0x5f, 0x64, 0x72, 0x61, 
-	0x77, 0x61, 0x62, 0x6c, 0x65, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 
-	0x2f, 0x2f, 0x20, 0x46, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x69, 0x74, 0x69, 
-	0x6f, 0x6e, 0x73, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 
-	0x2f, 0x2f, 0x20, 0x49, 0x66, 0x20, 0x74, 0x68, 0x65, 0x20, 0x66, 0x72, 0x61, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x68, 
-	0x61, 0x73, 0x20, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x70, 0x61, 0x72, 0x65, 0x6e, 0x63, 0x79, 0x2c, 0x20, 0x69, 0x74, 0x20, 
-	0x64, 0x6f, 0x65, 0x73, 0x6e, 0x27, 0x74, 0x20, 0x63, 0x61, 0x73, 0x74, 0x20, 0x61, 0x6e, 0x79, 0x20, 0x73, 0x68, 0x61, 
-	0x64, 0x6f, 0x77, 0x20, 0x28, 0x63, 0x6f, 0x6e, 0x76, 0x65, 0x6e, 0x69, 0x65, 0x6e, 0x74, 0x20, 0x61, 0x70, 0x70, 0x72, 
-	0x6f, 0x78, 0x69, 0x6d, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x20, 0x74, 0x68, 0x75, 0x73, 0x20, 0x69, 0x74, 0x20, 0x69, 
-	0x73, 0x20, 0x64, 0x69, 0x73, 0x63, 0x61, 0x72, 0x64, 0x65, 0x64, 0x0a, 0x0a, 0x09, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 
-	0x20, 0x43, 0x4f, 0x4c, 0x4f, 0x52, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x09, 0x76, 0x65, 0x63, 
-	0x34, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x5f, 
-	0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x2c, 0x20, 0x69, 0x6f, 0x5f, 0x67, 0x65, 
-	0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 
-	0x64, 0x73, 0x29, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x09, 0x76, 0x65, 0x63, 0x34, 0x20, 0x63, 
-	0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x43, 0x6f, 0x6c, 
-	0x6f, 0x72, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x09, 0x69, 0x66, 0x20, 0x28, 0x63, 0x6f, 
-	0x6c, 0x6f, 0x72, 0x2e, 0x61, 0x20, 0x21, 0x3d, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x64, 
-	0x69, 0x73, 0x63, 0x61, 0x72, 0x64, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x67, 0x6c, 0x5f, 0x46, 0x72, 0x61, 0x67, 
-	0x44, 0x65, 0x70, 0x74, 0x68, 0x20, 0x3d, 0x20, 0x69, 0x6f, 0x5f, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x4f, 
-	0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x64, 0x65, 0x70, 0x74, 0x68, 0x3b, 0x0a, 0x7d, 0x0a, 0x00
+	0x74, 0x72, 0x79, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 
+	0x43, 0x4f, 0x4c, 0x4f, 0x52, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x09, 0x76, 0x65, 0x63, 0x32, 
+	0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 
+	0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x64, 0x65, 0x70, 0x74, 0x68, 0x3b, 0x0a, 0x09, 0x66, 0x6c, 0x61, 0x74, 0x20, 
+	0x75, 0x69, 0x6e, 0x74, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x49, 0x6e, 0x64, 0x65, 0x78, 0x3b, 0x0a, 
+	0x7d, 0x20, 0x69, 0x6f, 0x5f, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x3b, 
+	0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x53, 0x68, 0x61, 0x64, 0x65, 0x72, 0x20, 0x73, 0x74, 0x6f, 0x72, 0x61, 0x67, 0x65, 0x20, 
+	0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 0x34, 
+	0x33, 0x30, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x38, 0x29, 0x20, 0x72, 0x65, 0x61, 
+	0x64, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x6d, 0x61, 
+	0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x73, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x4d, 0x61, 
+	0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x44, 0x61, 0x74, 0x61, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x6d, 0x61, 0x74, 0x65, 
+	0x72, 0x69, 0x61, 0x6c, 0x73, 0x5b, 0x5d, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x55, 0x6e, 0x69, 0x66, 
+	0x6f, 0x72, 0x6d, 0x73, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 0x4f, 0x4c, 0x4f, 0x52, 0x5f, 0x54, 
+	0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x4d, 0x61, 0x74, 0x65, 
+	0x72, 0x69, 0x61, 0x6c, 0x53, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x20, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 
+	0x6c, 0x65, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 
+	0x46, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x73, 
+	0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 
+	0x49, 0x66, 0x20, 0x74, 0x68, 0x65, 0x20, 0x66, 0x72, 0x61, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x68, 0x61, 0x73, 0x20, 
+	0x74, 0x72, 0x61, 0x6e, 0x73, 0x70, 0x61, 0x72, 0x65, 0x6e, 0x63, 0x79, 0x2c, 0x20, 0x69, 0x74, 0x20, 0x64, 0x6f, 0x65, 
+	0x73, 0x6e, 0x27, 0x74, 0x20, 0x63, 0x61, 0x73, 0x74, 0x20, 0x61, 0x6e, 0x79, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 
+	0x20, 0x28, 0x63, 0x6f, 0x6e, 0x76, 0x65, 0x6e, 0x69, 0x65, 0x6e, 0x74, 0x20, 0x61, 0x70, 0x70, 0x72, 0x6f, 0x78, 0x69, 
+	0x6d, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x20, 0x74, 0x68, 0x75, 0x73, 0x20, 0x69, 0x74, 0x20, 0x69, 0x73, 0x20, 0x64, 
+	0x69, 0x73, 0x63, 0x61, 0x72, 0x64, 0x65, 0x64, 0x0a, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x4d, 0x61, 0x74, 
+	0x65, 0x72, 0x69, 0x61, 0x6c, 0x44, 0x61, 0x74, 0x61, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x20, 0x3d, 
+	0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x73, 0x5b, 0x69, 0x6f, 0x5f, 0x67, 
+	0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 
+	0x61, 0x6c, 0x49, 0x6e, 0x64, 0x65, 0x78, 0x5d, 0x3b, 0x0a, 0x0a, 0x09, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 
+	0x4f, 0x4c, 0x4f, 0x52, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x09, 0x76, 0x65, 0x63, 0x34, 0x20, 
+	0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 
+	0x61, 0x6c, 0x54, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 
+	0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x2c, 0x20, 0x69, 0x6f, 0x5f, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x4f, 0x75, 
+	0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2c, 0x20, 0x6d, 0x61, 0x74, 0x65, 
+	0x72, 0x69, 0x61, 0x6c, 0x2e, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x4c, 0x61, 0x79, 0x65, 0x72, 0x29, 0x3b, 0x0a, 0x09, 0x23, 
+	0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x09, 0x76, 0x65, 0x63, 0x34, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x3d, 0x20, 
+	0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x2e, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6e, 
+	0x64, 0x69, 0x66, 0x0a, 0x0a, 0x09, 0x69, 0x66, 0x20, 0x28, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2e, 0x61, 0x20, 0x21, 0x3d, 
+	0x20, 0x31, 0x2e, 0x30, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x64, 0x69, 0x73, 0x63, 0x61, 0x72, 0x64, 0x3b, 0x0a, 
+	0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x67, 0x6c, 0x5f, 0x46, 0x72, 0x61, 0x67, 0x44, 0x65, 0x70, 0x74, 0x68, 0x20, 0x3d, 0x20, 
+	0x69, 0x6f, 0x5f, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x64, 0x65, 
+	0x70, 0x74, 0x68, 0x3b, 0x0a, 0x7d, 0x0a, 0x00
 };
 
 static constexpr char mesh_shadowMapping_geom[] = {
@@ -941,39 +1774,50 @@ static constexpr char mesh_shadowMapping_geom[] = {
 	0x20, 0x3d, 0x20, 0x53, 0x48, 0x41, 0x44, 0x4f, 0x57, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x5f, 0x43, 0x4f, 
 	0x55, 0x4e, 0x54, 0x20, 0x2a, 0x20, 0x33, 0x29, 0x20, 0x6f, 0x75, 0x74, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x49, 0x6e, 
 	0x70, 0x75, 0x74, 0x73, 0x0a, 0x0a, 0x69, 0x6e, 0x20, 0x56, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 
-	0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 
-	0x0a, 0x7d, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x5b, 0x33, 
-	0x5d, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x55, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 
-	0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 0x31, 0x34, 0x30, 0x2c, 0x20, 0x72, 
-	0x6f, 0x77, 0x5f, 0x6d, 0x61, 0x6a, 0x6f, 0x72, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 
-	0x33, 0x29, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x73, 0x68, 0x61, 0x64, 0x6f, 
-	0x77, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 
-	0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x44, 0x61, 0x74, 0x61, 0x20, 0x75, 0x62, 
-	0x6f, 0x5f, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 
-	0x0a, 0x2f, 0x2f, 0x20, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x73, 0x0a, 0x0a, 0x6f, 0x75, 0x74, 0x20, 0x47, 0x65, 0x6f, 
-	0x6d, 0x65, 0x74, 0x72, 0x79, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 
-	0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x64, 0x65, 
-	0x70, 0x74, 0x68, 0x3b, 0x0a, 0x7d, 0x20, 0x69, 0x6f, 0x5f, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x4f, 0x75, 
-	0x74, 0x70, 0x75, 0x74, 0x3b, 0x0a, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 
-	0x64, 0x65, 0x66, 0x69, 0x6e, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 
-	0x69, 0x6e, 0x28, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x46, 0x6f, 0x72, 0x20, 0x65, 0x61, 0x63, 0x68, 0x20, 
-	0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x20, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x20, 0x65, 0x6d, 0x69, 0x74, 0x20, 0x61, 
-	0x20, 0x63, 0x6f, 0x72, 0x72, 0x65, 0x73, 0x70, 0x6f, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x74, 0x72, 0x69, 0x61, 0x6e, 
-	0x67, 0x6c, 0x65, 0x20, 0x69, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x63, 0x6f, 0x72, 0x72, 0x65, 0x73, 0x70, 0x6f, 0x6e, 
-	0x64, 0x69, 0x6e, 0x67, 0x20, 0x6c, 0x61, 0x79, 0x65, 0x72, 0x0a, 0x0a, 0x09, 0x66, 0x6f, 0x72, 0x20, 0x28, 0x69, 0x6e, 
-	0x74, 0x20, 0x69, 0x20, 0x3d, 0x20, 0x30, 0x3b, 0x20, 0x69, 0x20, 0x3c, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x73, 0x68, 0x61, 
-	0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x2e, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x20, 0x2b, 0x2b, 
-	0x69, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x66, 0x6f, 0x72, 0x20, 0x28, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x6a, 0x20, 
-	0x3d, 0x20, 0x30, 0x3b, 0x20, 0x6a, 0x20, 0x3c, 0x20, 0x33, 0x3b, 0x20, 0x2b, 0x2b, 0x6a, 0x29, 0x0a, 0x09, 0x09, 0x7b, 
-	0x0a, 0x09, 0x09, 0x09, 0x67, 0x6c, 0x5f, 0x4c, 0x61, 0x79, 0x65, 0x72, 0x20, 0x3d, 0x20, 0x69, 0x3b, 0x0a, 0x09, 0x09, 
-	0x09, 0x0a, 0x09, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x70, 0x6f, 0x73, 0x69, 
-	0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 
-	0x65, 0x72, 0x61, 0x73, 0x2e, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x76, 0x69, 0x65, 0x77, 
-	0x20, 0x2a, 0x20, 0x67, 0x6c, 0x5f, 0x69, 0x6e, 0x5b, 0x6a, 0x5d, 0x2e, 0x67, 0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 
-	0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x0a, 0x09, 0x09, 0x09, 0x69, 0x6f, 0x5f, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 
-	0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x3d, 0x20, 0x69, 
-	0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x5b, 0x6a, 0x5d, 0x2e, 0x74, 0x65, 
-	0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x69, 0x6f, 0x5f, 0x67, 0x65, 0x6f, 0x6d, 0x65, 
+	0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 0x4f, 0x4c, 0x4f, 0x52, 0x5f, 0x54, 0x45, 
+	0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 
+	0x64, 0x73, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x09, 0x66, 0x6c, 0x61, 0x74, 0x20, 0x75, 0x69, 
+	0x6e, 0x74, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x49, 0x6e, 0x64, 0x65, 0x78, 0x3b, 0x0a, 0x7d, 0x20, 
+	0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x5b, 0x33, 0x5d, 0x3b, 0x0a, 
+	0x0a, 0x2f, 0x2f, 0x20, 0x55, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x73, 0x0a, 0x0a, 
+	0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 0x31, 0x34, 0x30, 0x2c, 0x20, 0x72, 0x6f, 0x77, 0x5f, 
+	0x6d, 0x61, 0x6a, 0x6f, 0x72, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x33, 0x29, 0x20, 
+	0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x5f, 0x63, 
+	0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x53, 0x68, 0x61, 
+	0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x44, 0x61, 0x74, 0x61, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x73, 
+	0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 
+	0x20, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x73, 0x0a, 0x0a, 0x6f, 0x75, 0x74, 0x20, 0x47, 0x65, 0x6f, 0x6d, 0x65, 0x74, 
+	0x72, 0x79, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 
+	0x4f, 0x4c, 0x4f, 0x52, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 
+	0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x09, 
+	0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x64, 0x65, 0x70, 0x74, 0x68, 0x3b, 0x0a, 0x09, 0x66, 0x6c, 0x61, 0x74, 0x20, 0x75, 
+	0x69, 0x6e, 0x74, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x49, 0x6e, 0x64, 0x65, 0x78, 0x3b, 0x0a, 0x7d, 
+	0x20, 0x69, 0x6f, 0x5f, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x3b, 0x0a, 
+	0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x69, 
+	0x74, 0x69, 0x6f, 0x6e, 0x73, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x0a, 0x7b, 
+	0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x46, 0x6f, 0x72, 0x20, 0x65, 0x61, 0x63, 0x68, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 
+	0x20, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x20, 0x65, 0x6d, 0x69, 0x74, 0x20, 0x61, 0x20, 0x63, 0x6f, 0x72, 0x72, 0x65, 
+	0x73, 0x70, 0x6f, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x74, 0x72, 0x69, 0x61, 0x6e, 0x67, 0x6c, 0x65, 0x20, 0x69, 0x6e, 
+	0x20, 0x74, 0x68, 0x65, 0x20, 0x63, 0x6f, 0x72, 0x72, 0x65, 0x73, 0x70, 0x6f, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x6c, 
+	0x61, 0x79, 0x65, 0x72, 0x0a, 0x0a, 0x09, 0x66, 0x6f, 0x72, 0x20, 0x28, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x20, 0x3d, 0x20, 
+	0x30, 0x3b, 0x20, 0x69, 0x20, 0x3c, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 
+	0x65, 0x72, 0x61, 0x73, 0x2e, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x20, 0x2b, 0x2b, 0x69, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 
+	0x09, 0x09, 0x66, 0x6f, 0x72, 0x20, 0x28, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x6a, 0x20, 0x3d, 0x20, 0x30, 0x3b, 0x20, 0x6a, 
+	0x20, 0x3c, 0x20, 0x33, 0x3b, 0x20, 0x2b, 0x2b, 0x6a, 0x29, 0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x67, 0x6c, 
+	0x5f, 0x4c, 0x61, 0x79, 0x65, 0x72, 0x20, 0x3d, 0x20, 0x69, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x0a, 0x09, 0x09, 0x09, 0x63, 
+	0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 
+	0x20, 0x75, 0x62, 0x6f, 0x5f, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x2e, 0x63, 
+	0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x76, 0x69, 0x65, 0x77, 0x20, 0x2a, 0x20, 0x67, 0x6c, 0x5f, 
+	0x69, 0x6e, 0x5b, 0x6a, 0x5d, 0x2e, 0x67, 0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x0a, 
+	0x09, 0x09, 0x09, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 0x4f, 0x4c, 0x4f, 0x52, 0x5f, 0x54, 0x45, 0x58, 0x54, 
+	0x55, 0x52, 0x45, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x69, 0x6f, 0x5f, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x4f, 
+	0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x3d, 0x20, 0x69, 0x6f, 
+	0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x5b, 0x6a, 0x5d, 0x2e, 0x74, 0x65, 0x78, 
+	0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x09, 0x09, 
+	0x09, 0x69, 0x6f, 0x5f, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x6d, 
+	0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x49, 0x6e, 0x64, 0x65, 0x78, 0x20, 0x3d, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 
+	0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x5b, 0x6a, 0x5d, 0x2e, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 
+	0x61, 0x6c, 0x49, 0x6e, 0x64, 0x65, 0x78, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x69, 0x6f, 0x5f, 0x67, 0x65, 0x6f, 0x6d, 0x65, 
 	0x74, 0x72, 0x79, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x64, 0x65, 0x70, 0x74, 0x68, 0x20, 0x3d, 0x20, 0x31, 0x2e, 
 	0x30, 0x20, 0x2d, 0x20, 0x28, 0x75, 0x62, 0x6f, 0x5f, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 0x65, 0x72, 
 	0x61, 0x73, 0x2e, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x66, 0x61, 0x72, 0x20, 0x2b, 0x20, 
@@ -1008,37 +1852,89 @@ static constexpr char mesh_shadowMapping_vert[] = {
 	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
 	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x0a, 
 	0x0a, 0x2f, 0x2f, 0x20, 0x56, 0x65, 0x72, 0x74, 0x65, 0x78, 0x20, 0x61, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65, 
-	0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 
-	0x3d, 0x20, 0x30, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x61, 0x5f, 0x70, 0x6f, 0x73, 0x69, 
-	0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 
-	0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x31, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x61, 0x5f, 0x6e, 
-	0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 
-	0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x32, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x61, 0x5f, 
-	0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x3b, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 
-	0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x33, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 
-	0x61, 0x5f, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x55, 0x6e, 0x69, 
-	0x66, 0x6f, 0x72, 0x6d, 0x20, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 
+	0x73, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 0x4f, 0x4d, 0x50, 0x41, 0x43, 0x54, 0x5f, 0x56, 0x45, 
+	0x52, 0x54, 0x45, 0x58, 0x0a, 0x09, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 
+	0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x75, 0x76, 0x65, 0x63, 0x32, 0x20, 0x76, 0x61, 0x5f, 
+	0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x6c, 0x61, 0x79, 
+	0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x69, 
+	0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x61, 0x5f, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 
+	0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x54, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x20, 0x63, 
+	0x6f, 0x6f, 0x72, 0x64, 0x69, 0x6e, 0x61, 0x74, 0x65, 0x73, 0x20, 0x61, 0x72, 0x65, 0x20, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 
+	0x66, 0x65, 0x74, 0x63, 0x68, 0x65, 0x64, 0x20, 0x77, 0x68, 0x65, 0x6e, 0x20, 0x6e, 0x65, 0x65, 0x64, 0x65, 0x64, 0x20, 
+	0x66, 0x6f, 0x72, 0x20, 0x61, 0x6c, 0x70, 0x68, 0x61, 0x20, 0x74, 0x65, 0x73, 0x74, 0x69, 0x6e, 0x67, 0x2c, 0x20, 0x73, 
+	0x6f, 0x20, 0x74, 0x68, 0x61, 0x74, 0x20, 0x74, 0x68, 0x65, 0x20, 0x70, 0x61, 0x73, 0x73, 0x20, 0x63, 0x61, 0x6e, 0x20, 
+	0x72, 0x65, 0x61, 0x64, 0x20, 0x74, 0x68, 0x65, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x73, 0x74, 
+	0x72, 0x65, 0x61, 0x6d, 0x20, 0x6f, 0x6e, 0x6c, 0x79, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 0x4f, 
+	0x4c, 0x4f, 0x52, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 
+	0x43, 0x4f, 0x4d, 0x50, 0x41, 0x43, 0x54, 0x5f, 0x56, 0x45, 0x52, 0x54, 0x45, 0x58, 0x0a, 0x09, 0x09, 0x6c, 0x61, 0x79, 
+	0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x33, 0x29, 0x20, 0x69, 
+	0x6e, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x76, 0x61, 0x5f, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 
+	0x0a, 0x09, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x09, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 
+	0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x33, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 
+	0x76, 0x61, 0x5f, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 
+	0x66, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x55, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 
+	0x20, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x73, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x47, 0x50, 0x55, 0x5f, 
+	0x44, 0x52, 0x49, 0x56, 0x45, 0x4e, 0x0a, 0x09, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 0x34, 
+	0x33, 0x30, 0x2c, 0x20, 0x72, 0x6f, 0x77, 0x5f, 0x6d, 0x61, 0x6a, 0x6f, 0x72, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 0x69, 
+	0x6e, 0x67, 0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x72, 0x65, 0x61, 0x64, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x62, 0x75, 0x66, 
+	0x66, 0x65, 0x72, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x73, 0x5f, 0x6c, 
+	0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x44, 
+	0x61, 0x74, 0x61, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x73, 0x5b, 0x5d, 
+	0x3b, 0x0a, 0x09, 0x7d, 0x3b, 0x0a, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 
 	0x28, 0x73, 0x74, 0x64, 0x31, 0x34, 0x30, 0x2c, 0x20, 0x72, 0x6f, 0x77, 0x5f, 0x6d, 0x61, 0x6a, 0x6f, 0x72, 0x2c, 0x20, 
 	0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x32, 0x29, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 
 	0x20, 0x75, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 
-	0x0a, 0x7b, 0x0a, 0x09, 0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x44, 0x61, 0x74, 0x61, 0x20, 0x75, 0x62, 0x6f, 
-	0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x4f, 0x75, 
-	0x74, 0x70, 0x75, 0x74, 0x73, 0x0a, 0x0a, 0x6f, 0x75, 0x74, 0x20, 0x56, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 
-	0x70, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 
-	0x73, 0x3b, 0x0a, 0x7d, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 
-	0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x64, 0x65, 0x66, 0x69, 0x6e, 
-	0x69, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x0a, 
-	0x7b, 0x0a, 0x09, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 
-	0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x3d, 0x20, 0x76, 0x61, 0x5f, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 
-	0x72, 0x64, 0x73, 0x2e, 0x78, 0x79, 0x3b, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x43, 0x61, 0x72, 0x65, 0x66, 0x75, 0x6c, 
-	0x20, 0x21, 0x20, 0x49, 0x74, 0x27, 0x73, 0x20, 0x6e, 0x6f, 0x74, 0x20, 0x76, 0x69, 0x65, 0x77, 0x2d, 0x73, 0x70, 0x61, 
-	0x63, 0x65, 0x20, 0x62, 0x75, 0x74, 0x20, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x2d, 0x73, 0x70, 0x61, 0x63, 0x65, 0x20, 0x21, 
-	0x20, 0x56, 0x69, 0x65, 0x77, 0x2d, 0x73, 0x70, 0x61, 0x63, 0x65, 0x20, 0x77, 0x69, 0x6c, 0x6c, 0x20, 0x6f, 0x6e, 0x6c, 
-	0x79, 0x20, 0x62, 0x65, 0x20, 0x63, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x64, 0x20, 0x69, 0x6e, 0x20, 0x67, 0x65, 0x6f, 
-	0x6d, 0x65, 0x74, 0x72, 0x79, 0x20, 0x73, 0x68, 0x61, 0x64, 0x65, 0x72, 0x2e, 0x0a, 0x09, 0x67, 0x6c, 0x5f, 0x50, 0x6f, 
-	0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 
-	0x65, 0x2e, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x20, 0x2a, 0x20, 0x76, 0x61, 0x5f, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 
-	0x6e, 0x3b, 0x0a, 0x7d, 0x0a, 0x00
+	0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x44, 0x61, 0x74, 0x61, 0x20, 0x75, 
+	0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x3b, 0x0a, 0x09, 0x7d, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 
+	0x64, 0x69, 0x66, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x73, 0x0a, 0x0a, 0x6f, 0x75, 0x74, 
+	0x20, 0x56, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x23, 0x69, 0x66, 
+	0x64, 0x65, 0x66, 0x20, 0x43, 0x4f, 0x4c, 0x4f, 0x52, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x09, 
+	0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6e, 
+	0x64, 0x69, 0x66, 0x0a, 0x09, 0x66, 0x6c, 0x61, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 
+	0x69, 0x61, 0x6c, 0x49, 0x6e, 0x64, 0x65, 0x78, 0x3b, 0x0a, 0x7d, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 
+	0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 
+	0x6e, 0x20, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 
+	0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x49, 0x6e, 0x64, 0x69, 0x72, 0x65, 0x63, 
+	0x74, 0x20, 0x64, 0x72, 0x61, 0x77, 0x73, 0x20, 0x63, 0x61, 0x72, 0x72, 0x79, 0x20, 0x74, 0x68, 0x65, 0x20, 0x69, 0x6e, 
+	0x64, 0x65, 0x78, 0x20, 0x6f, 0x66, 0x20, 0x74, 0x68, 0x65, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x20, 
+	0x69, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x69, 0x72, 0x20, 0x62, 0x61, 0x73, 0x65, 0x20, 0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 
+	0x63, 0x65, 0x0a, 0x0a, 0x09, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x47, 0x50, 0x55, 0x5f, 0x44, 0x52, 0x49, 0x56, 
+	0x45, 0x4e, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x44, 
+	0x61, 0x74, 0x61, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x20, 0x3d, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 
+	0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x73, 0x5b, 0x67, 0x6c, 0x5f, 0x42, 0x61, 0x73, 0x65, 0x49, 0x6e, 0x73, 
+	0x74, 0x61, 0x6e, 0x63, 0x65, 0x5d, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 
+	0x73, 0x74, 0x20, 0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x44, 0x61, 0x74, 0x61, 0x20, 0x64, 0x72, 0x61, 0x77, 
+	0x61, 0x62, 0x6c, 0x65, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x3b, 
+	0x0a, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x09, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 
+	0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x49, 0x6e, 0x64, 0x65, 0x78, 
+	0x20, 0x3d, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 
+	0x49, 0x6e, 0x64, 0x65, 0x78, 0x3b, 0x0a, 0x0a, 0x09, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 0x4f, 0x4c, 0x4f, 
+	0x52, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x09, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 
+	0x4f, 0x4d, 0x50, 0x41, 0x43, 0x54, 0x5f, 0x56, 0x45, 0x52, 0x54, 0x45, 0x58, 0x0a, 0x09, 0x09, 0x09, 0x69, 0x6f, 0x5f, 
+	0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 
+	0x64, 0x73, 0x20, 0x3d, 0x20, 0x64, 0x65, 0x63, 0x6f, 0x64, 0x65, 0x48, 0x61, 0x6c, 0x66, 0x54, 0x65, 0x78, 0x43, 0x6f, 
+	0x6f, 0x72, 0x64, 0x73, 0x28, 0x76, 0x61, 0x5f, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x29, 0x2e, 0x78, 
+	0x79, 0x3b, 0x0a, 0x09, 0x09, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x09, 0x09, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 
+	0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 
+	0x3d, 0x20, 0x76, 0x61, 0x5f, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2e, 0x78, 0x79, 0x3b, 0x0a, 0x09, 
+	0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x09, 0x23, 0x69, 
+	0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 0x4f, 0x4d, 0x50, 0x41, 0x43, 0x54, 0x5f, 0x56, 0x45, 0x52, 0x54, 0x45, 0x58, 0x0a, 
+	0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 
+	0x6e, 0x20, 0x3d, 0x20, 0x64, 0x65, 0x63, 0x6f, 0x64, 0x65, 0x43, 0x6f, 0x6d, 0x70, 0x61, 0x63, 0x74, 0x50, 0x6f, 0x73, 
+	0x69, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x76, 0x61, 0x5f, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x64, 
+	0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x4f, 0x66, 0x66, 0x73, 
+	0x65, 0x74, 0x2c, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 
+	0x6e, 0x53, 0x63, 0x61, 0x6c, 0x65, 0x29, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x09, 0x63, 0x6f, 
+	0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 
+	0x76, 0x61, 0x5f, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 
+	0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x43, 0x61, 0x72, 0x65, 0x66, 0x75, 0x6c, 0x20, 0x21, 0x20, 0x49, 0x74, 0x27, 0x73, 
+	0x20, 0x6e, 0x6f, 0x74, 0x20, 0x76, 0x69, 0x65, 0x77, 0x2d, 0x73, 0x70, 0x61, 0x63, 0x65, 0x20, 0x62, 0x75, 0x74, 0x20, 
+	0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x2d, 0x73, 0x70, 0x61, 0x63, 0x65, 0x20, 0x21, 0x20, 0x56, 0x69, 0x65, 0x77, 0x2d, 0x73, 
+	0x70, 0x61, 0x63, 0x65, 0x20, 0x77, 0x69, 0x6c, 0x6c, 0x20, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x62, 0x65, 0x20, 0x63, 0x6f, 
+	0x6d, 0x70, 0x75, 0x74, 0x65, 0x64, 0x20, 0x69, 0x6e, 0x20, 0x67, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x20, 0x73, 
+	0x68, 0x61, 0x64, 0x65, 0x72, 0x2e, 0x0a, 0x09, 0x67, 0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 
+	0x3d, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x20, 0x2a, 0x20, 0x70, 
+	0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x7d, 0x0a, 0x00
 };
 
 static constexpr char mesh_transparency_frag[] = {
@@ -1062,112 +1958,127 @@ static constexpr char mesh_transparency_frag[] = {
 	0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x70, 0x6f, 0x73, 0x69, 
 	0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 
 	0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 
-	0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 0x7d, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 
-	0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x55, 0x6e, 0x69, 0x66, 0x6f, 
-	0x72, 0x6d, 0x20, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 
-	0x74, 0x64, 0x31, 0x34, 0x30, 0x2c, 0x20, 0x72, 0x6f, 0x77, 0x5f, 0x6d, 0x61, 0x6a, 0x6f, 0x72, 0x2c, 0x20, 0x62, 0x69, 
-	0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x75, 
-	0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 
-	0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x44, 0x61, 0x74, 0x61, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 
-	0x61, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 0x31, 0x34, 
-	0x30, 0x2c, 0x20, 0x72, 0x6f, 0x77, 0x5f, 0x6d, 0x61, 0x6a, 0x6f, 0x72, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 
-	0x67, 0x20, 0x3d, 0x20, 0x31, 0x29, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x6c, 
-	0x69, 0x67, 0x68, 0x74, 0x73, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x4c, 0x69, 0x67, 0x68, 
-	0x74, 0x73, 0x44, 0x61, 0x74, 0x61, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x3b, 0x0a, 0x7d, 
-	0x3b, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 0x31, 0x34, 0x30, 0x2c, 0x20, 0x72, 
-	0x6f, 0x77, 0x5f, 0x6d, 0x61, 0x6a, 0x6f, 0x72, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 
-	0x33, 0x29, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x73, 0x68, 0x61, 0x64, 0x6f, 
-	0x77, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 
-	0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x44, 0x61, 0x74, 0x61, 0x20, 0x75, 0x62, 
-	0x6f, 0x5f, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 
-	0x0a, 0x2f, 0x2f, 0x20, 0x55, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x73, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 
-	0x20, 0x43, 0x4f, 0x4c, 0x4f, 0x52, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x75, 0x6e, 0x69, 0x66, 
-	0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 
-	0x61, 0x62, 0x6c, 0x65, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x75, 0x6e, 
-	0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 
-	0x65, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x64, 
-	0x65, 0x66, 0x20, 0x4d, 0x41, 0x54, 0x45, 0x52, 0x49, 0x41, 0x4c, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 
-	0x09, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 
-	0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x3b, 0x0a, 0x23, 
-	0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x75, 
-	0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x3b, 0x0a, 0x23, 
-	0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x4e, 0x4f, 0x52, 0x4d, 0x41, 0x4c, 
-	0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 
-	0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x4e, 0x6f, 
-	0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 
-	0x20, 0x53, 0x48, 0x41, 0x44, 0x4f, 0x57, 0x0a, 0x09, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 
-	0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x41, 0x72, 0x72, 0x61, 0x79, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x20, 0x75, 0x5f, 
-	0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x54, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x3b, 0x0a, 0x09, 0x75, 0x6e, 0x69, 0x66, 
-	0x6f, 0x72, 0x6d, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x75, 0x5f, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4f, 0x66, 0x66, 
-	0x73, 0x65, 0x74, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x72, 0x61, 0x67, 
-	0x6d, 0x65, 0x6e, 0x74, 0x20, 0x6f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 
-	0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x6f, 0x75, 0x74, 0x20, 
-	0x76, 0x65, 0x63, 0x34, 0x20, 0x66, 0x6f, 0x5f, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 
-	0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x31, 0x29, 0x20, 0x6f, 0x75, 0x74, 
-	0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x66, 0x6f, 0x5f, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x65, 0x72, 0x3b, 0x0a, 0x0a, 
-	0x2f, 0x2f, 0x20, 0x46, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x69, 0x74, 0x69, 
-	0x6f, 0x6e, 0x73, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 
+	0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 0x09, 0x66, 0x6c, 0x61, 0x74, 0x20, 0x75, 0x69, 
+	0x6e, 0x74, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x49, 0x6e, 0x64, 0x65, 0x78, 0x3b, 0x0a, 0x7d, 0x20, 
+	0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 
+	0x20, 0x55, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 
+	0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 0x31, 0x34, 0x30, 0x2c, 0x20, 0x72, 0x6f, 0x77, 0x5f, 0x6d, 0x61, 0x6a, 
+	0x6f, 0x72, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x75, 0x6e, 0x69, 
+	0x66, 0x6f, 0x72, 0x6d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 
+	0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x44, 0x61, 0x74, 0x61, 0x20, 0x75, 0x62, 0x6f, 
+	0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 
+	0x28, 0x73, 0x74, 0x64, 0x31, 0x34, 0x30, 0x2c, 0x20, 0x72, 0x6f, 0x77, 0x5f, 0x6d, 0x61, 0x6a, 0x6f, 0x72, 0x2c, 0x20, 
+	0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x31, 0x29, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 
+	0x20, 0x75, 0x62, 0x6f, 0x5f, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 
+	0x0a, 0x09, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x44, 0x61, 0x74, 0x61, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x6c, 0x69, 0x67, 
+	0x68, 0x74, 0x73, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 
+	0x31, 0x34, 0x30, 0x2c, 0x20, 0x72, 0x6f, 0x77, 0x5f, 0x6d, 0x61, 0x6a, 0x6f, 0x72, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 
+	0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x33, 0x29, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x75, 0x62, 0x6f, 
+	0x5f, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 
+	0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x73, 0x44, 
+	0x61, 0x74, 0x61, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 
+	0x73, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x53, 0x68, 0x61, 0x64, 0x65, 0x72, 0x20, 0x73, 0x74, 0x6f, 
+	0x72, 0x61, 0x67, 0x65, 0x20, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 
+	0x28, 0x73, 0x74, 0x64, 0x34, 0x33, 0x30, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x38, 
+	0x29, 0x20, 0x72, 0x65, 0x61, 0x64, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 0x73, 0x73, 
+	0x62, 0x6f, 0x5f, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x73, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 
+	0x7b, 0x0a, 0x09, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x44, 0x61, 0x74, 0x61, 0x20, 0x73, 0x73, 0x62, 0x6f, 
+	0x5f, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x73, 0x5b, 0x5d, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 
+	0x20, 0x55, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x73, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 0x4f, 
+	0x4c, 0x4f, 0x52, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 
+	0x20, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x53, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x20, 0x75, 0x5f, 0x64, 
+	0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 
+	0x0a, 0x0a, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x4d, 0x41, 0x54, 0x45, 0x52, 0x49, 0x41, 0x4c, 0x5f, 0x54, 0x45, 
+	0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x4d, 0x61, 0x74, 0x65, 0x72, 
+	0x69, 0x61, 0x6c, 0x53, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x20, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 
+	0x65, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x23, 
+	0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x4e, 0x4f, 0x52, 0x4d, 0x41, 0x4c, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 
+	0x0a, 0x09, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 
+	0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 0x23, 0x65, 
+	0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x53, 0x48, 0x41, 0x44, 0x4f, 0x57, 0x0a, 
+	0x09, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x41, 0x72, 
+	0x72, 0x61, 0x79, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x20, 0x75, 0x5f, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x54, 0x65, 
+	0x78, 0x74, 0x75, 0x72, 0x65, 0x3b, 0x0a, 0x09, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x76, 0x65, 0x63, 0x33, 
+	0x20, 0x75, 0x5f, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 
+	0x64, 0x69, 0x66, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x72, 0x61, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x6f, 0x75, 0x74, 
+	0x70, 0x75, 0x74, 0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 
+	0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x66, 0x6f, 0x5f, 
+	0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 
+	0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x31, 0x29, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x66, 
+	0x6f, 0x5f, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x65, 0x72, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x75, 0x6e, 0x63, 0x74, 
+	0x69, 0x6f, 0x6e, 0x20, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 
+	0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x4d, 0x61, 
+	0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x44, 0x61, 0x74, 0x61, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x4d, 
+	0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x73, 0x73, 0x62, 0x6f, 0x5f, 0x6d, 0x61, 0x74, 0x65, 0x72, 
+	0x69, 0x61, 0x6c, 0x73, 0x5b, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 
+	0x2e, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x49, 0x6e, 0x64, 0x65, 0x78, 0x5d, 0x3b, 0x0a, 0x0a, 0x09, 0x2f, 
+	0x2f, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x20, 0x66, 0x72, 0x61, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x63, 
+	0x6f, 0x6c, 0x6f, 0x72, 0x0a, 0x0a, 0x09, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 0x4f, 0x4c, 0x4f, 0x52, 0x5f, 
+	0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 
+	0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x4d, 0x61, 0x74, 0x65, 0x72, 
+	0x69, 0x61, 0x6c, 0x54, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 
+	0x65, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x2c, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 
+	0x70, 0x75, 0x74, 0x2e, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2c, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 
+	0x62, 0x6c, 0x65, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x2e, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x4c, 0x61, 0x79, 
+	0x65, 0x72, 0x29, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 
+	0x76, 0x65, 0x63, 0x34, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 
+	0x65, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x2e, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x09, 0x23, 0x65, 
+	0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x49, 0x66, 0x20, 0x74, 0x68, 0x65, 0x72, 0x65, 0x20, 0x69, 
+	0x73, 0x20, 0x6e, 0x6f, 0x20, 0x61, 0x6c, 0x70, 0x68, 0x61, 0x20, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x70, 0x61, 0x72, 0x65, 
+	0x6e, 0x63, 0x79, 0x20, 0x74, 0x68, 0x65, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x66, 0x72, 0x61, 0x67, 0x6d, 0x65, 0x6e, 
+	0x74, 0x20, 0x77, 0x61, 0x73, 0x20, 0x68, 0x61, 0x6e, 0x64, 0x6c, 0x65, 0x64, 0x20, 0x62, 0x79, 0x20, 0x74, 0x68, 0x65, 
+	0x20, 0x67, 0x42, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 0x73, 0x68, 0x61, 0x64, 0x65, 0x72, 0x2c, 0x20, 0x73, 0x6f, 0x20, 
+	0x69, 0x74, 0x20, 0x63, 0x61, 0x6e, 0x20, 0x62, 0x65, 0x20, 0x64, 0x69, 0x73, 0x63, 0x61, 0x72, 0x64, 0x65, 0x64, 0x2e, 
+	0x0a, 0x09, 0x69, 0x66, 0x20, 0x28, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2e, 0x61, 0x20, 0x3d, 0x3d, 0x20, 0x31, 0x2e, 0x30, 
+	0x20, 0x7c, 0x7c, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2e, 0x61, 0x20, 0x3d, 0x3d, 0x20, 0x30, 0x2e, 0x30, 0x29, 0x0a, 
+	0x09, 0x7b, 0x0a, 0x09, 0x09, 0x64, 0x69, 0x73, 0x63, 0x61, 0x72, 0x64, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x09, 0x0a, 0x09, 
 	0x2f, 0x2f, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x20, 0x66, 0x72, 0x61, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x20, 
-	0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x0a, 0x0a, 0x09, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 0x4f, 0x4c, 0x4f, 0x52, 
-	0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 
-	0x34, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x5f, 
-	0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x2c, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 
-	0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 
-	0x29, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 
-	0x63, 0x34, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 
-	0x65, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 
-	0x20, 0x49, 0x66, 0x20, 0x74, 0x68, 0x65, 0x72, 0x65, 0x20, 0x69, 0x73, 0x20, 0x6e, 0x6f, 0x20, 0x61, 0x6c, 0x70, 0x68, 
-	0x61, 0x20, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x70, 0x61, 0x72, 0x65, 0x6e, 0x63, 0x79, 0x20, 0x74, 0x68, 0x65, 0x6e, 0x20, 
-	0x74, 0x68, 0x65, 0x20, 0x66, 0x72, 0x61, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x77, 0x61, 0x73, 0x20, 0x68, 0x61, 0x6e, 
-	0x64, 0x6c, 0x65, 0x64, 0x20, 0x62, 0x79, 0x20, 0x74, 0x68, 0x65, 0x20, 0x67, 0x42, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 
-	0x73, 0x68, 0x61, 0x64, 0x65, 0x72, 0x2c, 0x20, 0x73, 0x6f, 0x20, 0x69, 0x74, 0x20, 0x63, 0x61, 0x6e, 0x20, 0x62, 0x65, 
-	0x20, 0x64, 0x69, 0x73, 0x63, 0x61, 0x72, 0x64, 0x65, 0x64, 0x2e, 0x0a, 0x09, 0x69, 0x66, 0x20, 0x28, 0x63, 0x6f, 0x6c, 
-	0x6f, 0x72, 0x2e, 0x61, 0x20, 0x3d, 0x3d, 0x20, 0x31, 0x2e, 0x30, 0x20, 0x7c, 0x7c, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 
-	0x2e, 0x61, 0x20, 0x3d, 0x3d, 0x20, 0x30, 0x2e, 0x30, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x64, 0x69, 0x73, 0x63, 
-	0x61, 0x72, 0x64, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x09, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x75, 0x74, 
-	0x65, 0x20, 0x66, 0x72, 0x61, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x0a, 
-	0x0a, 0x09, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x4d, 0x41, 0x54, 0x45, 0x52, 0x49, 0x41, 0x4c, 0x5f, 0x54, 0x45, 
-	0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6d, 
-	0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x5f, 
-	0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x2c, 0x20, 0x69, 0x6f, 
-	0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 
-	0x72, 0x64, 0x73, 0x29, 0x2e, 0x72, 0x67, 0x62, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x09, 0x63, 
-	0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x20, 0x3d, 
-	0x20, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x3b, 
-	0x0a, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x75, 0x74, 
-	0x65, 0x20, 0x66, 0x72, 0x61, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x0a, 0x0a, 0x09, 
-	0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 
-	0x69, 0x7a, 0x65, 0x28, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 
-	0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x4e, 0x4f, 
-	0x52, 0x4d, 0x41, 0x4c, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 
-	0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 
-	0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 
-	0x74, 0x2e, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 
-	0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 0x69, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x63, 0x72, 0x6f, 
-	0x73, 0x73, 0x28, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x29, 0x3b, 
-	0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 
-	0x4d, 0x61, 0x70, 0x56, 0x61, 0x6c, 0x75, 0x65, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 
-	0x28, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x4e, 
-	0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 
-	0x75, 0x74, 0x2e, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x29, 0x2e, 0x72, 0x67, 0x62, 0x29, 0x3b, 0x0a, 
-	0x09, 0x09, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 
-	0x28, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x2a, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x4d, 0x61, 0x70, 
-	0x56, 0x61, 0x6c, 0x75, 0x65, 0x2e, 0x78, 0x20, 0x2b, 0x20, 0x62, 0x69, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 
-	0x2a, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x4d, 0x61, 0x70, 0x56, 0x61, 0x6c, 0x75, 0x65, 0x2e, 0x79, 0x20, 0x2b, 
-	0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 0x2a, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x4d, 0x61, 0x70, 0x56, 
-	0x61, 0x6c, 0x75, 0x65, 0x2e, 0x7a, 0x29, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x09, 0x2f, 
-	0x2f, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x20, 0x66, 0x72, 0x61, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x66, 
-	0x69, 0x6e, 0x61, 0x6c, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x61, 0x66, 0x74, 0x65, 0x72, 0x20, 0x6c, 0x69, 0x67, 
-	0x68, 0x74, 0x69, 0x6e, 0x67, 0x2c, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x73, 0x74, 0x6f, 0x72, 0x65, 0x20, 0x69, 0x74, 0x20, 
-	0x69, 0x6e, 0x20, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x70, 0x61, 0x72, 0x65, 0x6e, 0x63, 0x79, 0x20, 0x61, 0x63, 0x63, 0x75, 
-	0x6d, 0x75, 0x6c, 0x61, 0x74, 0x6f, 0x72, 0x0a, 0x0a, 0x09, 0x66, 0x6f, 0x5f, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2e, 0x72, 
-	0x67, 0x62, 0x20, 0x3d, 0x20, 0x63, 0x6f, 0x6f, 0x6b, 0x54, 0x6f, 0x72, 0x72, 0x61, 0x6e, 0x63, 0x65, 0x28, 0x63, 0x6f, 
-	0x6c, 0x6f, 0x72, 0x2e, 0x72, 0x67, 0x62, 0x2c, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x2c, 0x20, 0x6e, 
-	0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 
-	0x75, 0x74, 0x2e, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x30, 0x2e, 0x30, 0x29, 0x20, 0x2a, 0x20, 
-	0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2e, 0x61, 0x3b, 0x0a, 0x09, 0x66, 0x6f, 0x5f, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2e, 0x61, 
-	0x20, 0x3d, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2e, 0x61, 0x3b, 0x0a, 0x09, 0x66, 0x6f, 0x5f, 0x63, 0x6f, 0x75, 0x6e, 
-	0x74, 0x65, 0x72, 0x20, 0x3d, 0x20, 0x31, 0x2e, 0x30, 0x3b, 0x0a, 0x7d, 0x20, 0x0a, 0x00
+	0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x0a, 0x0a, 0x09, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x4d, 0x41, 
+	0x54, 0x45, 0x52, 0x49, 0x41, 0x4c, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 
+	0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x73, 
+	0x61, 0x6d, 0x70, 0x6c, 0x65, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x54, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 
+	0x28, 0x75, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x2c, 
+	0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x65, 0x78, 
+	0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2c, 0x20, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x4d, 0x61, 0x74, 0x65, 
+	0x72, 0x69, 0x61, 0x6c, 0x2e, 0x70, 0x72, 0x6f, 0x70, 0x65, 0x72, 0x74, 0x69, 0x65, 0x73, 0x4c, 0x61, 0x79, 0x65, 0x72, 
+	0x29, 0x2e, 0x72, 0x67, 0x62, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 
+	0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x64, 0x72, 
+	0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x4d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x2e, 0x70, 0x72, 0x6f, 0x70, 0x65, 
+	0x72, 0x74, 0x69, 0x65, 0x73, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 
+	0x43, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x20, 0x66, 0x72, 0x61, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x6e, 0x6f, 0x72, 
+	0x6d, 0x61, 0x6c, 0x0a, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 0x3d, 0x20, 
+	0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 
+	0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x23, 0x69, 0x66, 
+	0x64, 0x65, 0x66, 0x20, 0x4e, 0x4f, 0x52, 0x4d, 0x41, 0x4c, 0x5f, 0x54, 0x45, 0x58, 0x54, 0x55, 0x52, 0x45, 0x0a, 0x09, 
+	0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 
+	0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 
+	0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x29, 0x3b, 0x0a, 0x09, 0x09, 
+	0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 0x69, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 
+	0x20, 0x3d, 0x20, 0x63, 0x72, 0x6f, 0x73, 0x73, 0x28, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x74, 0x61, 0x6e, 
+	0x67, 0x65, 0x6e, 0x74, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 
+	0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x4d, 0x61, 0x70, 0x56, 0x61, 0x6c, 0x75, 0x65, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 
+	0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x5f, 0x64, 0x72, 0x61, 
+	0x77, 0x61, 0x62, 0x6c, 0x65, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 
+	0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x29, 0x2e, 
+	0x72, 0x67, 0x62, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 
+	0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x2a, 0x20, 0x6e, 0x6f, 0x72, 
+	0x6d, 0x61, 0x6c, 0x4d, 0x61, 0x70, 0x56, 0x61, 0x6c, 0x75, 0x65, 0x2e, 0x78, 0x20, 0x2b, 0x20, 0x62, 0x69, 0x74, 0x61, 
+	0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x2a, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x4d, 0x61, 0x70, 0x56, 0x61, 0x6c, 
+	0x75, 0x65, 0x2e, 0x79, 0x20, 0x2b, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 0x2a, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 
+	0x61, 0x6c, 0x4d, 0x61, 0x70, 0x56, 0x61, 0x6c, 0x75, 0x65, 0x2e, 0x7a, 0x29, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6e, 0x64, 
+	0x69, 0x66, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x20, 0x66, 0x72, 0x61, 0x67, 
+	0x6d, 0x65, 0x6e, 0x74, 0x20, 0x66, 0x69, 0x6e, 0x61, 0x6c, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x61, 0x66, 0x74, 
+	0x65, 0x72, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x69, 0x6e, 0x67, 0x2c, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x73, 0x74, 0x6f, 
+	0x72, 0x65, 0x20, 0x69, 0x74, 0x20, 0x69, 0x6e, 0x20, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x70, 0x61, 0x72, 0x65, 0x6e, 0x63, 
+	0x79, 0x20, 0x61, 0x63, 0x63, 0x75, 0x6d, 0x75, 0x6c, 0x61, 0x74, 0x6f, 0x72, 0x0a, 0x0a, 0x09, 0x66, 0x6f, 0x5f, 0x63, 
+	0x6f, 0x6c, 0x6f, 0x72, 0x2e, 0x72, 0x67, 0x62, 0x20, 0x3d, 0x20, 0x63, 0x6f, 0x6f, 0x6b, 0x54, 0x6f, 0x72, 0x72, 0x61, 
+	0x6e, 0x63, 0x65, 0x28, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2e, 0x72, 0x67, 0x62, 0x2c, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 
+	0x69, 0x61, 0x6c, 0x2c, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 
+	0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x30, 
+	0x2e, 0x30, 0x29, 0x20, 0x2a, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2e, 0x61, 0x3b, 0x0a, 0x09, 0x66, 0x6f, 0x5f, 0x63, 
+	0x6f, 0x6c, 0x6f, 0x72, 0x2e, 0x61, 0x20, 0x3d, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2e, 0x61, 0x3b, 0x0a, 0x09, 0x66, 
+	0x6f, 0x5f, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x65, 0x72, 0x20, 0x3d, 0x20, 0x31, 0x2e, 0x30, 0x3b, 0x0a, 0x7d, 0x20, 0x0a, 
+	0x00
 };
 
 static constexpr char mesh_transparency_vert[] = {
@@ -1188,75 +2099,115 @@ static constexpr char mesh_transparency_vert[] = {
 	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 
 	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x0a, 
 	0x0a, 0x2f, 0x2f, 0x20, 0x56, 0x65, 0x72, 0x74, 0x65, 0x78, 0x20, 0x61, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65, 
-	0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 
-	0x3d, 0x20, 0x30, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x61, 0x5f, 0x70, 0x6f, 0x73, 0x69, 
-	0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 
-	0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x31, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x61, 0x5f, 0x6e, 
-	0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 
-	0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x32, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x61, 0x5f, 
-	0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x3b, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 
-	0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x33, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 
-	0x61, 0x5f, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x55, 0x6e, 0x69, 
-	0x66, 0x6f, 0x72, 0x6d, 0x20, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 
-	0x28, 0x73, 0x74, 0x64, 0x31, 0x34, 0x30, 0x2c, 0x20, 0x72, 0x6f, 0x77, 0x5f, 0x6d, 0x61, 0x6a, 0x6f, 0x72, 0x2c, 0x20, 
-	0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 
-	0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 
-	0x0a, 0x09, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x44, 0x61, 0x74, 0x61, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 
-	0x65, 0x72, 0x61, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 
-	0x31, 0x34, 0x30, 0x2c, 0x20, 0x72, 0x6f, 0x77, 0x5f, 0x6d, 0x61, 0x6a, 0x6f, 0x72, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 
-	0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 0x32, 0x29, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x75, 0x62, 0x6f, 
-	0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 
-	0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x44, 0x61, 0x74, 0x61, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 
-	0x77, 0x61, 0x62, 0x6c, 0x65, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 
-	0x73, 0x0a, 0x0a, 0x6f, 0x75, 0x74, 0x20, 0x56, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x0a, 
-	0x7b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x09, 0x76, 
-	0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x74, 0x61, 
-	0x6e, 0x67, 0x65, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 
-	0x64, 0x73, 0x3b, 0x0a, 0x7d, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 
+	0x73, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 0x4f, 0x4d, 0x50, 0x41, 0x43, 0x54, 0x5f, 0x56, 0x45, 
+	0x52, 0x54, 0x45, 0x58, 0x0a, 0x09, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 
+	0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x75, 0x76, 0x65, 0x63, 0x32, 0x20, 0x76, 0x61, 0x5f, 
+	0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x09, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 
+	0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x31, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x75, 0x69, 0x6e, 0x74, 
+	0x20, 0x76, 0x61, 0x5f, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 0x09, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 
+	0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x32, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x75, 0x69, 
+	0x6e, 0x74, 0x20, 0x76, 0x61, 0x5f, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x6c, 0x61, 0x79, 0x6f, 
+	0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x33, 0x29, 0x20, 0x69, 0x6e, 
+	0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x76, 0x61, 0x5f, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 
+	0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 
+	0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x61, 0x5f, 
+	0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x09, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 
+	0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x31, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 
+	0x20, 0x76, 0x61, 0x5f, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 0x09, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 
+	0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x32, 0x29, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x65, 
+	0x63, 0x34, 0x20, 0x76, 0x61, 0x5f, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x6c, 0x61, 0x79, 0x6f, 
+	0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x33, 0x29, 0x20, 0x69, 0x6e, 
+	0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x61, 0x5f, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 
+	0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x55, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x62, 
+	0x6c, 0x6f, 0x63, 0x6b, 0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 0x31, 0x34, 
+	0x30, 0x2c, 0x20, 0x72, 0x6f, 0x77, 0x5f, 0x6d, 0x61, 0x6a, 0x6f, 0x72, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 
+	0x67, 0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 
+	0x61, 0x6d, 0x65, 0x72, 0x61, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x43, 0x61, 0x6d, 0x65, 
+	0x72, 0x61, 0x44, 0x61, 0x74, 0x61, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x3b, 0x0a, 0x7d, 
+	0x3b, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x73, 0x74, 0x64, 0x31, 0x34, 0x30, 0x2c, 0x20, 0x72, 
+	0x6f, 0x77, 0x5f, 0x6d, 0x61, 0x6a, 0x6f, 0x72, 0x2c, 0x20, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x3d, 0x20, 
+	0x32, 0x29, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 
+	0x62, 0x6c, 0x65, 0x5f, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x44, 0x72, 0x61, 0x77, 0x61, 0x62, 
+	0x6c, 0x65, 0x44, 0x61, 0x74, 0x61, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x3b, 
+	0x0a, 0x7d, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x73, 0x0a, 0x0a, 0x6f, 0x75, 0x74, 
+	0x20, 0x56, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x0a, 0x7b, 0x0a, 0x09, 0x76, 0x65, 0x63, 
+	0x33, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 
+	0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x3b, 
+	0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 0x09, 0x66, 
+	0x6c, 0x61, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x49, 0x6e, 0x64, 
+	0x65, 0x78, 0x3b, 0x0a, 0x7d, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 
 	0x74, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x64, 0x65, 0x66, 0x69, 
 	0x6e, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 
-	0x0a, 0x7b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x20, 0x65, 0x76, 0x65, 0x72, 0x79, 
-	0x74, 0x68, 0x69, 0x6e, 0x67, 0x20, 0x69, 0x6e, 0x20, 0x76, 0x69, 0x65, 0x77, 0x2d, 0x73, 0x70, 0x61, 0x63, 0x65, 0x0a, 
-	0x0a, 0x09, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x70, 0x6f, 
-	0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x28, 0x75, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 
-	0x6c, 0x65, 0x2e, 0x76, 0x69, 0x65, 0x77, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x20, 0x2a, 0x20, 0x76, 0x61, 0x5f, 0x70, 0x6f, 
-	0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x2e, 0x78, 0x79, 0x7a, 0x3b, 0x0a, 0x09, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 
-	0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x6e, 
-	0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x75, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 
-	0x65, 0x2e, 0x76, 0x69, 0x65, 0x77, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x20, 0x2a, 0x20, 0x76, 0x61, 0x5f, 0x6e, 0x6f, 0x72, 
-	0x6d, 0x61, 0x6c, 0x29, 0x2e, 0x78, 0x79, 0x7a, 0x3b, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x54, 0x4f, 0x44, 0x4f, 0x3a, 0x20, 
-	0x43, 0x68, 0x61, 0x6e, 0x67, 0x65, 0x20, 0x74, 0x68, 0x61, 0x74, 0x20, 0x21, 0x20, 0x4e, 0x6f, 0x74, 0x20, 0x4f, 0x4b, 
-	0x20, 0x66, 0x6f, 0x72, 0x20, 0x6e, 0x6f, 0x6e, 0x2d, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x63, 0x61, 
-	0x6c, 0x65, 0x20, 0x21, 0x0a, 0x09, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 
-	0x74, 0x2e, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 
-	0x65, 0x28, 0x75, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x76, 0x69, 0x65, 0x77, 0x4d, 
-	0x6f, 0x64, 0x65, 0x6c, 0x20, 0x2a, 0x20, 0x76, 0x61, 0x5f, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x29, 0x2e, 0x78, 
-	0x79, 0x7a, 0x3b, 0x09, 0x2f, 0x2f, 0x20, 0x54, 0x4f, 0x44, 0x4f, 0x3a, 0x20, 0x43, 0x68, 0x61, 0x6e, 0x67, 0x65, 0x20, 
-	0x74, 0x68, 0x61, 0x74, 0x20, 0x21, 0x20, 0x4e, 0x6f, 0x74, 0x20, 0x4f, 0x4b, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x6e, 0x6f, 
-	0x6e, 0x2d, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x20, 0x21, 0x0a, 0x09, 0x69, 
-	0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x65, 0x78, 0x43, 0x6f, 
-	0x6f, 0x72, 0x64, 0x73, 0x20, 0x3d, 0x20, 0x76, 0x61, 0x5f, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2e, 
-	0x78, 0x79, 0x3b, 0x0a, 0x09, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x54, 0x68, 0x65, 0x20, 0x64, 0x65, 0x70, 0x74, 0x68, 0x20, 
-	0x74, 0x72, 0x61, 0x6e, 0x73, 0x6d, 0x69, 0x74, 0x74, 0x65, 0x64, 0x20, 0x74, 0x6f, 0x20, 0x74, 0x68, 0x65, 0x20, 0x47, 
-	0x4c, 0x20, 0x73, 0x68, 0x61, 0x6c, 0x6c, 0x20, 0x62, 0x65, 0x20, 0x6c, 0x69, 0x6e, 0x65, 0x61, 0x72, 0x20, 0x2d, 0x20, 
-	0x54, 0x68, 0x65, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x20, 0x69, 0x73, 0x20, 0x75, 0x73, 0x69, 0x6e, 0x67, 
-	0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x6e, 0x79, 0x77, 0x61, 0x79, 0x20, 0x69, 0x6e, 0x20, 0x64, 0x65, 0x70, 
-	0x74, 0x68, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x20, 0x66, 0x6f, 0x72, 0x6d, 0x61, 0x74, 0x2c, 0x20, 0x73, 
-	0x6f, 0x20, 0x6e, 0x6f, 0x20, 0x70, 0x72, 0x65, 0x63, 0x69, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x69, 0x73, 0x20, 0x6c, 0x6f, 
-	0x73, 0x74, 0x20, 0x61, 0x74, 0x20, 0x6e, 0x65, 0x61, 0x72, 0x20, 0x64, 0x69, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x0a, 
-	0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x64, 0x65, 0x70, 0x74, 0x68, 0x20, 0x3d, 
-	0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x70, 0x6f, 0x73, 
-	0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x7a, 0x3b, 0x0a, 0x09, 0x67, 0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 
-	0x6e, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 0x70, 0x72, 0x6f, 0x6a, 0x65, 
-	0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x2a, 0x20, 0x76, 0x65, 0x63, 0x34, 0x28, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 
-	0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x31, 
-	0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x09, 0x67, 0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x7a, 0x20, 
-	0x3d, 0x20, 0x2d, 0x20, 0x67, 0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x77, 0x20, 0x2a, 0x20, 
-	0x28, 0x32, 0x2e, 0x30, 0x20, 0x2a, 0x20, 0x64, 0x65, 0x70, 0x74, 0x68, 0x20, 0x2b, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 
-	0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 0x6e, 0x65, 0x61, 0x72, 0x20, 0x2b, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 
-	0x65, 0x72, 0x61, 0x2e, 0x66, 0x61, 0x72, 0x29, 0x20, 0x2f, 0x20, 0x28, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 
-	0x72, 0x61, 0x2e, 0x66, 0x61, 0x72, 0x20, 0x2d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 
-	0x6e, 0x65, 0x61, 0x72, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x00
+	0x0a, 0x7b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x44, 0x65, 0x63, 0x6f, 0x64, 0x65, 0x20, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 
+	0x20, 0x61, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65, 0x73, 0x0a, 0x0a, 0x09, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 
+	0x20, 0x43, 0x4f, 0x4d, 0x50, 0x41, 0x43, 0x54, 0x5f, 0x56, 0x45, 0x52, 0x54, 0x45, 0x58, 0x0a, 0x09, 0x09, 0x63, 0x6f, 
+	0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 
+	0x64, 0x65, 0x63, 0x6f, 0x64, 0x65, 0x43, 0x6f, 0x6d, 0x70, 0x61, 0x63, 0x74, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 
+	0x6e, 0x28, 0x76, 0x61, 0x5f, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x64, 
+	0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x4f, 0x66, 0x66, 0x73, 
+	0x65, 0x74, 0x2c, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x70, 0x6f, 0x73, 
+	0x69, 0x74, 0x69, 0x6f, 0x6e, 0x53, 0x63, 0x61, 0x6c, 0x65, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 
+	0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x64, 0x65, 0x63, 0x6f, 0x64, 
+	0x65, 0x4f, 0x63, 0x74, 0x61, 0x68, 0x65, 0x64, 0x72, 0x61, 0x6c, 0x44, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 
+	0x28, 0x76, 0x61, 0x5f, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 
+	0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x64, 0x65, 0x63, 0x6f, 
+	0x64, 0x65, 0x4f, 0x63, 0x74, 0x61, 0x68, 0x65, 0x64, 0x72, 0x61, 0x6c, 0x44, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 
+	0x6e, 0x28, 0x76, 0x61, 0x5f, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 
+	0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x3d, 0x20, 
+	0x64, 0x65, 0x63, 0x6f, 0x64, 0x65, 0x48, 0x61, 0x6c, 0x66, 0x54, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x28, 
+	0x76, 0x61, 0x5f, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x29, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6c, 0x73, 
+	0x65, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 
+	0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x76, 0x61, 0x5f, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x09, 
+	0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 0x3d, 
+	0x20, 0x76, 0x61, 0x5f, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 
+	0x76, 0x65, 0x63, 0x34, 0x20, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x76, 0x61, 0x5f, 0x74, 0x61, 
+	0x6e, 0x67, 0x65, 0x6e, 0x74, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 
+	0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x3d, 0x20, 0x76, 0x61, 0x5f, 0x74, 0x65, 0x78, 0x43, 0x6f, 
+	0x6f, 0x72, 0x64, 0x73, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x43, 
+	0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x20, 0x65, 0x76, 0x65, 0x72, 0x79, 0x74, 0x68, 0x69, 0x6e, 0x67, 0x20, 0x69, 0x6e, 
+	0x20, 0x76, 0x69, 0x65, 0x77, 0x2d, 0x73, 0x70, 0x61, 0x63, 0x65, 0x0a, 0x0a, 0x09, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 
+	0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 
+	0x20, 0x28, 0x75, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x76, 0x69, 0x65, 0x77, 0x4d, 
+	0x6f, 0x64, 0x65, 0x6c, 0x20, 0x2a, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x2e, 0x78, 0x79, 0x7a, 
+	0x3b, 0x0a, 0x09, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x6e, 
+	0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x75, 0x62, 
+	0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x76, 0x69, 0x65, 0x77, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 
+	0x20, 0x2a, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x29, 0x2e, 0x78, 0x79, 0x7a, 0x3b, 0x09, 0x09, 0x2f, 0x2f, 0x20, 
+	0x54, 0x4f, 0x44, 0x4f, 0x3a, 0x20, 0x43, 0x68, 0x61, 0x6e, 0x67, 0x65, 0x20, 0x74, 0x68, 0x61, 0x74, 0x20, 0x21, 0x20, 
+	0x4e, 0x6f, 0x74, 0x20, 0x4f, 0x4b, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x6e, 0x6f, 0x6e, 0x2d, 0x75, 0x6e, 0x69, 0x66, 0x6f, 
+	0x72, 0x6d, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x20, 0x21, 0x0a, 0x09, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 
+	0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 
+	0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x75, 0x62, 0x6f, 0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 
+	0x2e, 0x76, 0x69, 0x65, 0x77, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x20, 0x2a, 0x20, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 
+	0x29, 0x2e, 0x78, 0x79, 0x7a, 0x3b, 0x09, 0x2f, 0x2f, 0x20, 0x54, 0x4f, 0x44, 0x4f, 0x3a, 0x20, 0x43, 0x68, 0x61, 0x6e, 
+	0x67, 0x65, 0x20, 0x74, 0x68, 0x61, 0x74, 0x20, 0x21, 0x20, 0x4e, 0x6f, 0x74, 0x20, 0x4f, 0x4b, 0x20, 0x66, 0x6f, 0x72, 
+	0x20, 0x6e, 0x6f, 0x6e, 0x2d, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x20, 0x21, 
+	0x0a, 0x09, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x65, 
+	0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x3d, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2e, 
+	0x78, 0x79, 0x3b, 0x0a, 0x09, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 
+	0x2e, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x49, 0x6e, 0x64, 0x65, 0x78, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 
+	0x5f, 0x64, 0x72, 0x61, 0x77, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x6d, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6c, 0x49, 0x6e, 
+	0x64, 0x65, 0x78, 0x3b, 0x0a, 0x09, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x54, 0x68, 0x65, 0x20, 0x64, 0x65, 0x70, 0x74, 0x68, 
+	0x20, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x6d, 0x69, 0x74, 0x74, 0x65, 0x64, 0x20, 0x74, 0x6f, 0x20, 0x74, 0x68, 0x65, 0x20, 
+	0x47, 0x4c, 0x20, 0x73, 0x68, 0x61, 0x6c, 0x6c, 0x20, 0x62, 0x65, 0x20, 0x6c, 0x69, 0x6e, 0x65, 0x61, 0x72, 0x20, 0x2d, 
+	0x20, 0x54, 0x68, 0x65, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x20, 0x69, 0x73, 0x20, 0x75, 0x73, 0x69, 0x6e, 
+	0x67, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x6e, 0x79, 0x77, 0x61, 0x79, 0x20, 0x69, 0x6e, 0x20, 0x64, 0x65, 
+	0x70, 0x74, 0x68, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x20, 0x66, 0x6f, 0x72, 0x6d, 0x61, 0x74, 0x2c, 0x20, 
+	0x73, 0x6f, 0x20, 0x6e, 0x6f, 0x20, 0x70, 0x72, 0x65, 0x63, 0x69, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x69, 0x73, 0x20, 0x6c, 
+	0x6f, 0x73, 0x74, 0x20, 0x61, 0x74, 0x20, 0x6e, 0x65, 0x61, 0x72, 0x20, 0x64, 0x69, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 
+	0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x64, 0x65, 0x70, 0x74, 0x68, 0x20, 
+	0x3d, 0x20, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x70, 0x6f, 
+	0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x7a, 0x3b, 0x0a, 0x09, 0x67, 0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 
+	0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 0x70, 0x72, 0x6f, 0x6a, 
+	0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x2a, 0x20, 0x76, 0x65, 0x63, 0x34, 0x28, 0x69, 0x6f, 0x5f, 0x76, 0x65, 0x72, 
+	0x74, 0x65, 0x78, 0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 
+	0x31, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x09, 0x67, 0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x7a, 
+	0x20, 0x3d, 0x20, 0x2d, 0x20, 0x67, 0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x77, 0x20, 0x2a, 
+	0x20, 0x28, 0x32, 0x2e, 0x30, 0x20, 0x2a, 0x20, 0x64, 0x65, 0x70, 0x74, 0x68, 0x20, 0x2b, 0x20, 0x75, 0x62, 0x6f, 0x5f, 
+	0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 0x6e, 0x65, 0x61, 0x72, 0x20, 0x2b, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 
+	0x6d, 0x65, 0x72, 0x61, 0x2e, 0x66, 0x61, 0x72, 0x29, 0x20, 0x2f, 0x20, 0x28, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 
+	0x65, 0x72, 0x61, 0x2e, 0x66, 0x61, 0x72, 0x20, 0x2d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 
+	0x2e, 0x6e, 0x65, 0x61, 0x72, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x00
 };
 
 static constexpr char ssao_frag[] = {
@@ -1289,144 +2240,157 @@ static constexpr char ssao_frag[] = {
 	0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 0x5f, 0x67, 0x42, 0x75, 
 	0x66, 0x66, 0x65, 0x72, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 
 	0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 0x5f, 0x67, 0x42, 0x75, 0x66, 0x66, 0x65, 0x72, 0x54, 
-	0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x3b, 0x0a, 0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x75, 0x69, 0x6e, 
-	0x74, 0x20, 0x75, 0x5f, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x0a, 0x0a, 0x75, 0x6e, 
-	0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x75, 0x5f, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x53, 
-	0x74, 0x65, 0x70, 0x3b, 0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x75, 
-	0x5f, 0x74, 0x61, 0x6e, 0x48, 0x61, 0x6c, 0x66, 0x46, 0x6f, 0x76, 0x3b, 0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 
-	0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x75, 0x5f, 0x74, 0x77, 0x6f, 0x54, 0x61, 0x6e, 0x48, 0x61, 0x6c, 0x66, 0x46, 
-	0x6f, 0x76, 0x3b, 0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x75, 0x76, 0x65, 0x63, 0x32, 0x20, 0x75, 0x5f, 
-	0x72, 0x65, 0x73, 0x6f, 0x6c, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x72, 0x61, 0x67, 
-	0x6d, 0x65, 0x6e, 0x74, 0x20, 0x6f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 
-	0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x6f, 0x75, 0x74, 0x20, 
-	0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x66, 0x6f, 0x5f, 0x6f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 
-	0x20, 0x46, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x64, 0x65, 0x63, 0x6c, 0x61, 0x72, 0x61, 0x74, 0x69, 0x6f, 
-	0x6e, 0x73, 0x0a, 0x0a, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x69, 0x6e, 0x20, 0x75, 0x69, 0x6e, 
-	0x74, 0x20, 0x78, 0x29, 0x3b, 0x0a, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x69, 0x6e, 0x20, 0x63, 
-	0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x76, 0x65, 0x63, 0x32, 0x20, 0x76, 0x29, 0x3b, 0x0a, 0x75, 0x69, 0x6e, 0x74, 0x20, 
-	0x68, 0x61, 0x73, 0x68, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x76, 0x65, 0x63, 0x33, 0x20, 
-	0x76, 0x29, 0x3b, 0x0a, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 
-	0x73, 0x74, 0x20, 0x75, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x29, 0x3b, 0x0a, 0x0a, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+	0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x3b, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x6e, 0x64, 0x65, 0x66, 0x20, 0x53, 0x53, 0x41, 
+	0x4f, 0x5f, 0x53, 0x41, 0x4d, 0x50, 0x4c, 0x45, 0x5f, 0x43, 0x4f, 0x55, 0x4e, 0x54, 0x0a, 0x09, 0x75, 0x6e, 0x69, 0x66, 
+	0x6f, 0x72, 0x6d, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x75, 0x5f, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x43, 0x6f, 0x75, 
+	0x6e, 0x74, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 
+	0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x75, 0x5f, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x53, 0x74, 0x65, 0x70, 0x3b, 0x0a, 0x75, 
+	0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x75, 0x5f, 0x74, 0x61, 0x6e, 0x48, 0x61, 
+	0x6c, 0x66, 0x46, 0x6f, 0x76, 0x3b, 0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
+	0x20, 0x75, 0x5f, 0x74, 0x77, 0x6f, 0x54, 0x61, 0x6e, 0x48, 0x61, 0x6c, 0x66, 0x46, 0x6f, 0x76, 0x3b, 0x0a, 0x75, 0x6e, 
+	0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x75, 0x76, 0x65, 0x63, 0x32, 0x20, 0x75, 0x5f, 0x72, 0x65, 0x73, 0x6f, 0x6c, 0x75, 
+	0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x72, 0x61, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x6f, 
+	0x75, 0x74, 0x70, 0x75, 0x74, 0x73, 0x0a, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x20, 0x28, 0x6c, 0x6f, 0x63, 0x61, 
+	0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x6f, 0x75, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+	0x66, 0x6f, 0x5f, 0x6f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x75, 0x6e, 0x63, 0x74, 
+	0x69, 0x6f, 0x6e, 0x20, 0x64, 0x65, 0x63, 0x6c, 0x61, 0x72, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x0a, 0x0a, 0x75, 0x69, 
+	0x6e, 0x74, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x69, 0x6e, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x78, 0x29, 0x3b, 0x0a, 
+	0x75, 0x69, 0x6e, 0x74, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 
+	0x76, 0x65, 0x63, 0x32, 0x20, 0x76, 0x29, 0x3b, 0x0a, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x69, 
+	0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x76, 0x65, 0x63, 0x33, 0x20, 0x76, 0x29, 0x3b, 0x0a, 0x75, 0x69, 
+	0x6e, 0x74, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x76, 0x65, 
+	0x63, 0x34, 0x20, 0x76, 0x29, 0x3b, 0x0a, 0x0a, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x72, 0x61, 0x6e, 0x64, 0x6f, 0x6d, 
+	0x28, 0x69, 0x6e, 0x6f, 0x75, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x73, 0x65, 0x65, 0x64, 0x29, 0x3b, 0x0a, 0x0a, 
+	0x2f, 0x2f, 0x20, 0x46, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x69, 0x74, 0x69, 
+	0x6f, 0x6e, 0x73, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 
+	0x75, 0x69, 0x6e, 0x74, 0x20, 0x73, 0x65, 0x65, 0x64, 0x20, 0x3d, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x66, 0x6c, 0x6f, 
+	0x61, 0x74, 0x42, 0x69, 0x74, 0x73, 0x54, 0x6f, 0x55, 0x69, 0x6e, 0x74, 0x28, 0x69, 0x6f, 0x5f, 0x74, 0x65, 0x78, 0x43, 
+	0x6f, 0x6f, 0x72, 0x64, 0x73, 0x29, 0x29, 0x3b, 0x0a, 0x09, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x69, 0x76, 
+	0x65, 0x63, 0x32, 0x20, 0x77, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x20, 0x3d, 0x20, 0x69, 0x76, 
+	0x65, 0x63, 0x32, 0x28, 0x67, 0x6c, 0x5f, 0x46, 0x72, 0x61, 0x67, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x2e, 0x78, 0x79, 0x29, 
+	0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x64, 0x65, 0x70, 0x74, 0x68, 
+	0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 0x6e, 0x65, 0x61, 0x72, 0x20, 0x2b, 
+	0x20, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x46, 0x65, 0x74, 0x63, 0x68, 0x28, 0x75, 0x5f, 0x67, 0x42, 0x75, 0x66, 0x66, 0x65, 
+	0x72, 0x44, 0x65, 0x70, 0x74, 0x68, 0x2c, 0x20, 0x77, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x2c, 
+	0x20, 0x30, 0x29, 0x2e, 0x72, 0x20, 0x2a, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 0x66, 
+	0x61, 0x72, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x76, 0x69, 0x65, 0x77, 
+	0x44, 0x69, 0x72, 0x55, 0x6e, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x64, 0x20, 0x3d, 0x20, 0x76, 0x65, 
+	0x63, 0x33, 0x28, 0x76, 0x65, 0x63, 0x32, 0x28, 0x28, 0x69, 0x6f, 0x5f, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 
+	0x73, 0x2e, 0x78, 0x20, 0x2d, 0x20, 0x30, 0x2e, 0x35, 0x29, 0x20, 0x2a, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 
+	0x65, 0x72, 0x61, 0x2e, 0x61, 0x73, 0x70, 0x65, 0x63, 0x74, 0x2c, 0x20, 0x69, 0x6f, 0x5f, 0x74, 0x65, 0x78, 0x43, 0x6f, 
+	0x6f, 0x72, 0x64, 0x73, 0x2e, 0x79, 0x20, 0x2d, 0x20, 0x30, 0x2e, 0x35, 0x29, 0x20, 0x2a, 0x20, 0x75, 0x5f, 0x74, 0x77, 
+	0x6f, 0x54, 0x61, 0x6e, 0x48, 0x61, 0x6c, 0x66, 0x46, 0x6f, 0x76, 0x2c, 0x20, 0x2d, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 
+	0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 
+	0x20, 0x3d, 0x20, 0x64, 0x65, 0x70, 0x74, 0x68, 0x20, 0x2a, 0x20, 0x76, 0x69, 0x65, 0x77, 0x44, 0x69, 0x72, 0x55, 0x6e, 
+	0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x64, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 
+	0x65, 0x63, 0x33, 0x20, 0x76, 0x69, 0x65, 0x77, 0x44, 0x69, 0x72, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 
+	0x69, 0x7a, 0x65, 0x28, 0x76, 0x69, 0x65, 0x77, 0x44, 0x69, 0x72, 0x55, 0x6e, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 
+	0x7a, 0x65, 0x64, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 
+	0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x46, 0x65, 0x74, 0x63, 0x68, 0x28, 0x75, 
+	0x5f, 0x67, 0x42, 0x75, 0x66, 0x66, 0x65, 0x72, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x77, 0x69, 0x6e, 0x64, 
+	0x6f, 0x77, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x2c, 0x20, 0x30, 0x29, 0x2e, 0x72, 0x67, 0x62, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 
+	0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x74, 
+	0x65, 0x78, 0x65, 0x6c, 0x46, 0x65, 0x74, 0x63, 0x68, 0x28, 0x75, 0x5f, 0x67, 0x42, 0x75, 0x66, 0x66, 0x65, 0x72, 0x54, 
+	0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x2c, 0x20, 0x77, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x2c, 
+	0x20, 0x30, 0x29, 0x2e, 0x72, 0x67, 0x62, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 
+	0x20, 0x62, 0x69, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x63, 0x72, 0x6f, 0x73, 0x73, 0x28, 0x6e, 
+	0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x29, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 
+	0x6e, 0x73, 0x74, 0x20, 0x6d, 0x61, 0x74, 0x33, 0x20, 0x74, 0x62, 0x6e, 0x20, 0x3d, 0x20, 0x6d, 0x61, 0x74, 0x33, 0x28, 
+	0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x2c, 0x20, 0x62, 0x69, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x2c, 0x20, 
+	0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x43, 0x6f, 0x6e, 0x73, 0x74, 0x61, 
+	0x6e, 0x74, 0x20, 0x69, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x70, 0x72, 0x6f, 0x67, 0x72, 0x61, 0x6d, 0x73, 0x20, 0x73, 
+	0x70, 0x65, 0x63, 0x69, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x64, 0x20, 0x74, 0x6f, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x61, 
+	0x6d, 0x70, 0x6c, 0x65, 0x20, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x20, 0x6f, 0x66, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x63, 
+	0x65, 0x6e, 0x65, 0x2c, 0x20, 0x73, 0x6f, 0x20, 0x74, 0x68, 0x61, 0x74, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6c, 0x6f, 0x6f, 
+	0x70, 0x20, 0x63, 0x61, 0x6e, 0x20, 0x62, 0x65, 0x20, 0x75, 0x6e, 0x72, 0x6f, 0x6c, 0x6c, 0x65, 0x64, 0x0a, 0x0a, 0x09, 
+	0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x53, 0x53, 0x41, 0x4f, 0x5f, 0x53, 0x41, 0x4d, 0x50, 0x4c, 0x45, 0x5f, 0x43, 
+	0x4f, 0x55, 0x4e, 0x54, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x73, 0x61, 
+	0x6d, 0x70, 0x6c, 0x65, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x53, 0x53, 0x41, 0x4f, 0x5f, 0x53, 0x41, 0x4d, 
+	0x50, 0x4c, 0x45, 0x5f, 0x43, 0x4f, 0x55, 0x4e, 0x54, 0x3b, 0x0a, 0x09, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x09, 
+	0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x43, 0x6f, 0x75, 
+	0x6e, 0x74, 0x20, 0x3d, 0x20, 0x75, 0x5f, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x0a, 
+	0x09, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x72, 0x61, 0x64, 0x69, 
+	0x75, 0x73, 0x20, 0x3d, 0x20, 0x64, 0x65, 0x70, 0x74, 0x68, 0x20, 0x2a, 0x20, 0x75, 0x5f, 0x74, 0x61, 0x6e, 0x48, 0x61, 
+	0x6c, 0x66, 0x46, 0x6f, 0x76, 0x3b, 0x0a, 0x09, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6f, 0x63, 0x63, 0x6c, 
+	0x75, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x30, 0x2e, 0x30, 0x3b, 0x0a, 0x09, 0x66, 0x6f, 0x72, 0x20, 0x28, 0x75, 
+	0x69, 0x6e, 0x74, 0x20, 0x69, 0x20, 0x3d, 0x20, 0x31, 0x3b, 0x20, 0x69, 0x20, 0x3c, 0x3d, 0x20, 0x73, 0x61, 0x6d, 0x70, 
+	0x6c, 0x65, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x20, 0x2b, 0x2b, 0x69, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x2f, 
+	0x2f, 0x20, 0x49, 0x6e, 0x69, 0x74, 0x69, 0x61, 0x6c, 0x20, 0x76, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x20, 0x69, 0x73, 0x20, 
+	0x6e, 0x6f, 0x74, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x28, 0x63, 0x6f, 0x73, 0x2c, 0x20, 0x65, 0x74, 
+	0x63, 0x2e, 0x2e, 0x29, 0x20, 0x62, 0x65, 0x63, 0x61, 0x75, 0x73, 0x65, 0x20, 0x6d, 0x6f, 0x72, 0x65, 0x20, 0x6c, 0x69, 
+	0x67, 0x68, 0x74, 0x20, 0x63, 0x6f, 0x6d, 0x65, 0x73, 0x20, 0x66, 0x72, 0x6f, 0x6d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 
+	0x6c, 0x20, 0x61, 0x6e, 0x67, 0x6c, 0x65, 0x20, 0x74, 0x68, 0x61, 0x6e, 0x20, 0x66, 0x72, 0x6f, 0x6d, 0x20, 0x67, 0x72, 
+	0x61, 0x7a, 0x69, 0x6e, 0x67, 0x20, 0x61, 0x6e, 0x67, 0x6c, 0x65, 0x0a, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x53, 0x63, 0x61, 
+	0x6c, 0x65, 0x20, 0x66, 0x61, 0x63, 0x74, 0x6f, 0x72, 0x20, 0x69, 0x73, 0x20, 0x6e, 0x6f, 0x74, 0x20, 0x75, 0x6e, 0x69, 
+	0x66, 0x6f, 0x72, 0x6d, 0x20, 0x62, 0x65, 0x63, 0x61, 0x75, 0x73, 0x65, 0x20, 0x6d, 0x6f, 0x72, 0x65, 0x20, 0x6c, 0x69, 
+	0x67, 0x68, 0x74, 0x20, 0x63, 0x6f, 0x6d, 0x65, 0x73, 0x20, 0x66, 0x72, 0x6f, 0x6d, 0x20, 0x6e, 0x65, 0x61, 0x72, 0x20, 
+	0x64, 0x69, 0x66, 0x66, 0x75, 0x73, 0x6f, 0x72, 0x73, 0x20, 0x74, 0x68, 0x61, 0x6e, 0x20, 0x66, 0x61, 0x72, 0x20, 0x6f, 
+	0x6e, 0x65, 0x73, 0x2e, 0x2e, 0x2e, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
+	0x20, 0x74, 0x68, 0x65, 0x74, 0x61, 0x20, 0x3d, 0x20, 0x72, 0x61, 0x6e, 0x64, 0x6f, 0x6d, 0x28, 0x73, 0x65, 0x65, 0x64, 
+	0x29, 0x20, 0x2a, 0x20, 0x63, 0x5f, 0x32, 0x70, 0x69, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 
+	0x6c, 0x6f, 0x61, 0x74, 0x20, 0x70, 0x68, 0x69, 0x20, 0x3d, 0x20, 0x72, 0x61, 0x6e, 0x64, 0x6f, 0x6d, 0x28, 0x73, 0x65, 
+	0x65, 0x64, 0x29, 0x20, 0x2a, 0x20, 0x63, 0x5f, 0x68, 0x61, 0x6c, 0x66, 0x50, 0x69, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 
+	0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x50, 0x68, 0x69, 0x20, 0x3d, 0x20, 0x63, 0x6f, 0x73, 
+	0x28, 0x70, 0x68, 0x69, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
+	0x20, 0x63, 0x75, 0x72, 0x72, 0x65, 0x6e, 0x74, 0x52, 0x61, 0x64, 0x69, 0x75, 0x73, 0x20, 0x3d, 0x20, 0x72, 0x61, 0x64, 
+	0x69, 0x75, 0x73, 0x20, 0x2a, 0x20, 0x69, 0x20, 0x2a, 0x20, 0x69, 0x20, 0x2a, 0x20, 0x75, 0x5f, 0x73, 0x63, 0x61, 0x6c, 
+	0x65, 0x53, 0x74, 0x65, 0x70, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 
+	0x72, 0x61, 0x6e, 0x64, 0x6f, 0x6d, 0x56, 0x65, 0x63, 0x20, 0x3d, 0x20, 0x76, 0x65, 0x63, 0x33, 0x28, 0x63, 0x6f, 0x73, 
+	0x28, 0x74, 0x68, 0x65, 0x74, 0x61, 0x29, 0x20, 0x2a, 0x20, 0x63, 0x50, 0x68, 0x69, 0x2c, 0x20, 0x73, 0x69, 0x6e, 0x28, 
+	0x74, 0x68, 0x65, 0x74, 0x61, 0x29, 0x20, 0x2a, 0x20, 0x63, 0x50, 0x68, 0x69, 0x2c, 0x20, 0x73, 0x69, 0x6e, 0x28, 0x70, 
+	0x68, 0x69, 0x29, 0x29, 0x20, 0x2a, 0x20, 0x63, 0x75, 0x72, 0x72, 0x65, 0x6e, 0x74, 0x52, 0x61, 0x64, 0x69, 0x75, 0x73, 
+	0x3b, 0x0a, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x76, 0x69, 0x65, 0x77, 
+	0x50, 0x6f, 0x73, 0x20, 0x3d, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x2b, 0x20, 0x74, 0x62, 0x6e, 
+	0x20, 0x2a, 0x20, 0x72, 0x61, 0x6e, 0x64, 0x6f, 0x6d, 0x56, 0x65, 0x63, 0x3b, 0x0a, 0x09, 0x09, 0x76, 0x65, 0x63, 0x34, 
+	0x20, 0x6e, 0x64, 0x63, 0x50, 0x6f, 0x73, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 
+	0x2e, 0x70, 0x72, 0x6f, 0x6a, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x2a, 0x20, 0x76, 0x65, 0x63, 0x34, 0x28, 0x76, 
+	0x69, 0x65, 0x77, 0x50, 0x6f, 0x73, 0x2c, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x6e, 0x64, 0x63, 0x50, 
+	0x6f, 0x73, 0x2e, 0x78, 0x79, 0x20, 0x3d, 0x20, 0x28, 0x63, 0x6c, 0x61, 0x6d, 0x70, 0x28, 0x6e, 0x64, 0x63, 0x50, 0x6f, 
+	0x73, 0x2e, 0x78, 0x79, 0x20, 0x2f, 0x20, 0x6e, 0x64, 0x63, 0x50, 0x6f, 0x73, 0x2e, 0x77, 0x2c, 0x20, 0x76, 0x65, 0x63, 
+	0x32, 0x28, 0x2d, 0x31, 0x2e, 0x30, 0x29, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x31, 0x2e, 0x30, 0x29, 0x29, 0x20, 
+	0x2b, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x20, 0x2a, 0x20, 0x30, 0x2e, 0x35, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 
+	0x74, 0x20, 0x69, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x3d, 0x20, 
+	0x69, 0x76, 0x65, 0x63, 0x32, 0x28, 0x6e, 0x64, 0x63, 0x50, 0x6f, 0x73, 0x2e, 0x78, 0x20, 0x2a, 0x20, 0x75, 0x5f, 0x72, 
+	0x65, 0x73, 0x6f, 0x6c, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x78, 0x2c, 0x20, 0x6e, 0x64, 0x63, 0x50, 0x6f, 0x73, 0x2e, 
+	0x79, 0x20, 0x2a, 0x20, 0x75, 0x5f, 0x72, 0x65, 0x73, 0x6f, 0x6c, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x79, 0x29, 0x3b, 
+	0x0a, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x61, 0x6d, 0x70, 
+	0x6c, 0x65, 0x44, 0x65, 0x70, 0x74, 0x68, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 
+	0x2e, 0x6e, 0x65, 0x61, 0x72, 0x20, 0x2b, 0x20, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x46, 0x65, 0x74, 0x63, 0x68, 0x28, 0x75, 
+	0x5f, 0x67, 0x42, 0x75, 0x66, 0x66, 0x65, 0x72, 0x44, 0x65, 0x70, 0x74, 0x68, 0x2c, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 
+	0x6f, 0x72, 0x64, 0x73, 0x2c, 0x20, 0x30, 0x29, 0x2e, 0x72, 0x20, 0x2a, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 
+	0x65, 0x72, 0x61, 0x2e, 0x66, 0x61, 0x72, 0x3b, 0x0a, 0x09, 0x09, 0x69, 0x66, 0x20, 0x28, 0x2d, 0x76, 0x69, 0x65, 0x77, 
+	0x50, 0x6f, 0x73, 0x2e, 0x7a, 0x20, 0x3e, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x44, 0x65, 0x70, 0x74, 0x68, 0x29, 
+	0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x6f, 0x63, 0x63, 0x6c, 0x75, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x2b, 0x3d, 
+	0x20, 0x73, 0x6d, 0x6f, 0x6f, 0x74, 0x68, 0x73, 0x74, 0x65, 0x70, 0x28, 0x30, 0x2e, 0x30, 0x2c, 0x20, 0x31, 0x2e, 0x30, 
+	0x2c, 0x20, 0x2d, 0x32, 0x2e, 0x30, 0x20, 0x2a, 0x20, 0x63, 0x75, 0x72, 0x72, 0x65, 0x6e, 0x74, 0x52, 0x61, 0x64, 0x69, 
+	0x75, 0x73, 0x20, 0x2f, 0x20, 0x28, 0x76, 0x69, 0x65, 0x77, 0x50, 0x6f, 0x73, 0x2e, 0x7a, 0x20, 0x2b, 0x20, 0x73, 0x61, 
+	0x6d, 0x70, 0x6c, 0x65, 0x44, 0x65, 0x70, 0x74, 0x68, 0x29, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x7d, 0x0a, 
+	0x0a, 0x09, 0x66, 0x6f, 0x5f, 0x6f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x20, 0x3d, 0x20, 0x6f, 0x63, 0x63, 0x6c, 0x75, 0x73, 
+	0x69, 0x6f, 0x6e, 0x20, 0x2f, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x0a, 0x7d, 
+	0x20, 0x0a, 0x0a, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x69, 0x6e, 0x20, 0x75, 0x69, 0x6e, 0x74, 
+	0x20, 0x78, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x78, 0x20, 0x2b, 0x3d, 0x20, 0x28, 0x78, 0x20, 0x3c, 0x3c, 0x20, 0x31, 0x30, 
+	0x29, 0x3b, 0x0a, 0x09, 0x78, 0x20, 0x5e, 0x3d, 0x20, 0x28, 0x78, 0x20, 0x3e, 0x3e, 0x20, 0x36, 0x29, 0x3b, 0x0a, 0x09, 
+	0x78, 0x20, 0x2b, 0x3d, 0x20, 0x28, 0x78, 0x20, 0x3c, 0x3c, 0x20, 0x33, 0x29, 0x3b, 0x0a, 0x09, 0x78, 0x20, 0x5e, 0x3d, 
+	0x20, 0x28, 0x78, 0x20, 0x3e, 0x3e, 0x20, 0x31, 0x31, 0x29, 0x3b, 0x0a, 0x09, 0x78, 0x20, 0x2b, 0x3d, 0x20, 0x28, 0x78, 
+	0x20, 0x3c, 0x3c, 0x20, 0x31, 0x35, 0x29, 0x3b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x78, 0x3b, 0x0a, 
+	0x7d, 0x0a, 0x0a, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 
+	0x74, 0x20, 0x75, 0x76, 0x65, 0x63, 0x32, 0x20, 0x76, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 
+	0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x20, 0x76, 0x2e, 0x78, 0x20, 0x5e, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x76, 0x2e, 
+	0x79, 0x29, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x69, 0x6e, 
+	0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x76, 0x65, 0x63, 0x33, 0x20, 0x76, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x72, 
+	0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x20, 0x76, 0x2e, 0x78, 0x20, 0x5e, 0x20, 0x68, 0x61, 
+	0x73, 0x68, 0x28, 0x76, 0x2e, 0x79, 0x29, 0x20, 0x5e, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x76, 0x2e, 0x7a, 0x29, 0x29, 
+	0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 
+	0x6e, 0x73, 0x74, 0x20, 0x75, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 
+	0x72, 0x6e, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x20, 0x76, 0x2e, 0x78, 0x20, 0x5e, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 
+	0x76, 0x2e, 0x79, 0x29, 0x20, 0x5e, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x76, 0x2e, 0x7a, 0x29, 0x20, 0x5e, 0x20, 0x68, 
+	0x61, 0x73, 0x68, 0x28, 0x76, 0x2e, 0x77, 0x29, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
 	0x72, 0x61, 0x6e, 0x64, 0x6f, 0x6d, 0x28, 0x69, 0x6e, 0x6f, 0x75, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x73, 0x65, 
-	0x65, 0x64, 0x29, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x64, 0x65, 
-	0x66, 0x69, 0x6e, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 
-	0x28, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x73, 0x65, 0x65, 0x64, 0x20, 0x3d, 0x20, 0x68, 0x61, 
-	0x73, 0x68, 0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x42, 0x69, 0x74, 0x73, 0x54, 0x6f, 0x55, 0x69, 0x6e, 0x74, 0x28, 0x69, 
-	0x6f, 0x5f, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x29, 0x29, 0x3b, 0x0a, 0x09, 0x0a, 0x09, 0x63, 0x6f, 
-	0x6e, 0x73, 0x74, 0x20, 0x69, 0x76, 0x65, 0x63, 0x32, 0x20, 0x77, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x43, 0x6f, 0x6f, 0x72, 
-	0x64, 0x20, 0x3d, 0x20, 0x69, 0x76, 0x65, 0x63, 0x32, 0x28, 0x67, 0x6c, 0x5f, 0x46, 0x72, 0x61, 0x67, 0x43, 0x6f, 0x6f, 
-	0x72, 0x64, 0x2e, 0x78, 0x79, 0x29, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
-	0x20, 0x64, 0x65, 0x70, 0x74, 0x68, 0x20, 0x3d, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 
-	0x6e, 0x65, 0x61, 0x72, 0x20, 0x2b, 0x20, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x46, 0x65, 0x74, 0x63, 0x68, 0x28, 0x75, 0x5f, 
-	0x67, 0x42, 0x75, 0x66, 0x66, 0x65, 0x72, 0x44, 0x65, 0x70, 0x74, 0x68, 0x2c, 0x20, 0x77, 0x69, 0x6e, 0x64, 0x6f, 0x77, 
-	0x43, 0x6f, 0x6f, 0x72, 0x64, 0x2c, 0x20, 0x30, 0x29, 0x2e, 0x72, 0x20, 0x2a, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 
-	0x6d, 0x65, 0x72, 0x61, 0x2e, 0x66, 0x61, 0x72, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 
-	0x33, 0x20, 0x76, 0x69, 0x65, 0x77, 0x44, 0x69, 0x72, 0x55, 0x6e, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 
-	0x64, 0x20, 0x3d, 0x20, 0x76, 0x65, 0x63, 0x33, 0x28, 0x76, 0x65, 0x63, 0x32, 0x28, 0x28, 0x69, 0x6f, 0x5f, 0x74, 0x65, 
-	0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2e, 0x78, 0x20, 0x2d, 0x20, 0x30, 0x2e, 0x35, 0x29, 0x20, 0x2a, 0x20, 0x75, 
-	0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 0x61, 0x73, 0x70, 0x65, 0x63, 0x74, 0x2c, 0x20, 0x69, 0x6f, 
-	0x5f, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2e, 0x79, 0x20, 0x2d, 0x20, 0x30, 0x2e, 0x35, 0x29, 0x20, 
-	0x2a, 0x20, 0x75, 0x5f, 0x74, 0x77, 0x6f, 0x54, 0x61, 0x6e, 0x48, 0x61, 0x6c, 0x66, 0x46, 0x6f, 0x76, 0x2c, 0x20, 0x2d, 
-	0x31, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x70, 0x6f, 
-	0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x64, 0x65, 0x70, 0x74, 0x68, 0x20, 0x2a, 0x20, 0x76, 0x69, 0x65, 
-	0x77, 0x44, 0x69, 0x72, 0x55, 0x6e, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x64, 0x3b, 0x0a, 0x09, 0x63, 
-	0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x76, 0x69, 0x65, 0x77, 0x44, 0x69, 0x72, 0x20, 0x3d, 0x20, 
-	0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x76, 0x69, 0x65, 0x77, 0x44, 0x69, 0x72, 0x55, 0x6e, 0x6e, 
-	0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x64, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 
-	0x76, 0x65, 0x63, 0x33, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x46, 
-	0x65, 0x74, 0x63, 0x68, 0x28, 0x75, 0x5f, 0x67, 0x42, 0x75, 0x66, 0x66, 0x65, 0x72, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 
-	0x2c, 0x20, 0x77, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x2c, 0x20, 0x30, 0x29, 0x2e, 0x72, 0x67, 
-	0x62, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x74, 0x61, 0x6e, 0x67, 0x65, 
-	0x6e, 0x74, 0x20, 0x3d, 0x20, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x46, 0x65, 0x74, 0x63, 0x68, 0x28, 0x75, 0x5f, 0x67, 0x42, 
-	0x75, 0x66, 0x66, 0x65, 0x72, 0x54, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x2c, 0x20, 0x77, 0x69, 0x6e, 0x64, 0x6f, 0x77, 
-	0x43, 0x6f, 0x6f, 0x72, 0x64, 0x2c, 0x20, 0x30, 0x29, 0x2e, 0x72, 0x67, 0x62, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 
-	0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 0x69, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x63, 
-	0x72, 0x6f, 0x73, 0x73, 0x28, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x20, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 
-	0x29, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x6d, 0x61, 0x74, 0x33, 0x20, 0x74, 0x62, 0x6e, 0x20, 0x3d, 
-	0x20, 0x6d, 0x61, 0x74, 0x33, 0x28, 0x74, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x2c, 0x20, 0x62, 0x69, 0x74, 0x61, 0x6e, 
-	0x67, 0x65, 0x6e, 0x74, 0x2c, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 
-	0x61, 0x74, 0x20, 0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x20, 0x3d, 0x20, 0x64, 0x65, 0x70, 0x74, 0x68, 0x20, 0x2a, 0x20, 
-	0x75, 0x5f, 0x74, 0x61, 0x6e, 0x48, 0x61, 0x6c, 0x66, 0x46, 0x6f, 0x76, 0x3b, 0x0a, 0x09, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 
-	0x61, 0x74, 0x20, 0x6f, 0x63, 0x63, 0x6c, 0x75, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x30, 0x2e, 0x30, 0x3b, 0x0a, 
-	0x09, 0x66, 0x6f, 0x72, 0x20, 0x28, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x20, 0x3d, 0x20, 0x31, 0x3b, 0x20, 0x69, 0x20, 
-	0x3c, 0x3d, 0x20, 0x75, 0x5f, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x20, 0x2b, 0x2b, 
-	0x69, 0x29, 0x0a, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x49, 0x6e, 0x69, 0x74, 0x69, 0x61, 0x6c, 0x20, 0x76, 
-	0x65, 0x63, 0x74, 0x6f, 0x72, 0x20, 0x69, 0x73, 0x20, 0x6e, 0x6f, 0x74, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 
-	0x20, 0x28, 0x63, 0x6f, 0x73, 0x2c, 0x20, 0x65, 0x74, 0x63, 0x2e, 0x2e, 0x29, 0x20, 0x62, 0x65, 0x63, 0x61, 0x75, 0x73, 
-	0x65, 0x20, 0x6d, 0x6f, 0x72, 0x65, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x63, 0x6f, 0x6d, 0x65, 0x73, 0x20, 0x66, 
-	0x72, 0x6f, 0x6d, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x20, 0x61, 0x6e, 0x67, 0x6c, 0x65, 0x20, 0x74, 0x68, 0x61, 
-	0x6e, 0x20, 0x66, 0x72, 0x6f, 0x6d, 0x20, 0x67, 0x72, 0x61, 0x7a, 0x69, 0x6e, 0x67, 0x20, 0x61, 0x6e, 0x67, 0x6c, 0x65, 
-	0x0a, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x53, 0x63, 0x61, 0x6c, 0x65, 0x20, 0x66, 0x61, 0x63, 0x74, 0x6f, 0x72, 0x20, 0x69, 
-	0x73, 0x20, 0x6e, 0x6f, 0x74, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x62, 0x65, 0x63, 0x61, 0x75, 0x73, 
-	0x65, 0x20, 0x6d, 0x6f, 0x72, 0x65, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x63, 0x6f, 0x6d, 0x65, 0x73, 0x20, 0x66, 
-	0x72, 0x6f, 0x6d, 0x20, 0x6e, 0x65, 0x61, 0x72, 0x20, 0x64, 0x69, 0x66, 0x66, 0x75, 0x73, 0x6f, 0x72, 0x73, 0x20, 0x74, 
-	0x68, 0x61, 0x6e, 0x20, 0x66, 0x61, 0x72, 0x20, 0x6f, 0x6e, 0x65, 0x73, 0x2e, 0x2e, 0x2e, 0x0a, 0x09, 0x09, 0x63, 0x6f, 
-	0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x74, 0x68, 0x65, 0x74, 0x61, 0x20, 0x3d, 0x20, 0x72, 0x61, 
-	0x6e, 0x64, 0x6f, 0x6d, 0x28, 0x73, 0x65, 0x65, 0x64, 0x29, 0x20, 0x2a, 0x20, 0x63, 0x5f, 0x32, 0x70, 0x69, 0x3b, 0x0a, 
-	0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x70, 0x68, 0x69, 0x20, 0x3d, 0x20, 
-	0x72, 0x61, 0x6e, 0x64, 0x6f, 0x6d, 0x28, 0x73, 0x65, 0x65, 0x64, 0x29, 0x20, 0x2a, 0x20, 0x63, 0x5f, 0x68, 0x61, 0x6c, 
-	0x66, 0x50, 0x69, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 
-	0x50, 0x68, 0x69, 0x20, 0x3d, 0x20, 0x63, 0x6f, 0x73, 0x28, 0x70, 0x68, 0x69, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 
-	0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x75, 0x72, 0x72, 0x65, 0x6e, 0x74, 0x52, 0x61, 0x64, 
-	0x69, 0x75, 0x73, 0x20, 0x3d, 0x20, 0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x20, 0x2a, 0x20, 0x69, 0x20, 0x2a, 0x20, 0x69, 
-	0x20, 0x2a, 0x20, 0x75, 0x5f, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x53, 0x74, 0x65, 0x70, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 
-	0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x72, 0x61, 0x6e, 0x64, 0x6f, 0x6d, 0x56, 0x65, 0x63, 0x20, 0x3d, 
-	0x20, 0x76, 0x65, 0x63, 0x33, 0x28, 0x63, 0x6f, 0x73, 0x28, 0x74, 0x68, 0x65, 0x74, 0x61, 0x29, 0x20, 0x2a, 0x20, 0x63, 
-	0x50, 0x68, 0x69, 0x2c, 0x20, 0x73, 0x69, 0x6e, 0x28, 0x74, 0x68, 0x65, 0x74, 0x61, 0x29, 0x20, 0x2a, 0x20, 0x63, 0x50, 
-	0x68, 0x69, 0x2c, 0x20, 0x73, 0x69, 0x6e, 0x28, 0x70, 0x68, 0x69, 0x29, 0x29, 0x20, 0x2a, 0x20, 0x63, 0x75, 0x72, 0x72, 
-	0x65, 0x6e, 0x74, 0x52, 0x61, 0x64, 0x69, 0x75, 0x73, 0x3b, 0x0a, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 
-	0x76, 0x65, 0x63, 0x33, 0x20, 0x76, 0x69, 0x65, 0x77, 0x50, 0x6f, 0x73, 0x20, 0x3d, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 
-	0x69, 0x6f, 0x6e, 0x20, 0x2b, 0x20, 0x74, 0x62, 0x6e, 0x20, 0x2a, 0x20, 0x72, 0x61, 0x6e, 0x64, 0x6f, 0x6d, 0x56, 0x65, 
-	0x63, 0x3b, 0x0a, 0x09, 0x09, 0x76, 0x65, 0x63, 0x34, 0x20, 0x6e, 0x64, 0x63, 0x50, 0x6f, 0x73, 0x20, 0x3d, 0x20, 0x75, 
-	0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 0x70, 0x72, 0x6f, 0x6a, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 
-	0x20, 0x2a, 0x20, 0x76, 0x65, 0x63, 0x34, 0x28, 0x76, 0x69, 0x65, 0x77, 0x50, 0x6f, 0x73, 0x2c, 0x20, 0x31, 0x2e, 0x30, 
-	0x29, 0x3b, 0x0a, 0x09, 0x09, 0x6e, 0x64, 0x63, 0x50, 0x6f, 0x73, 0x2e, 0x78, 0x79, 0x20, 0x3d, 0x20, 0x28, 0x63, 0x6c, 
-	0x61, 0x6d, 0x70, 0x28, 0x6e, 0x64, 0x63, 0x50, 0x6f, 0x73, 0x2e, 0x78, 0x79, 0x20, 0x2f, 0x20, 0x6e, 0x64, 0x63, 0x50, 
-	0x6f, 0x73, 0x2e, 0x77, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x2d, 0x31, 0x2e, 0x30, 0x29, 0x2c, 0x20, 0x76, 0x65, 
-	0x63, 0x32, 0x28, 0x31, 0x2e, 0x30, 0x29, 0x29, 0x20, 0x2b, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x20, 0x2a, 0x20, 0x30, 0x2e, 
-	0x35, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x69, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 
-	0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x3d, 0x20, 0x69, 0x76, 0x65, 0x63, 0x32, 0x28, 0x6e, 0x64, 0x63, 0x50, 0x6f, 
-	0x73, 0x2e, 0x78, 0x20, 0x2a, 0x20, 0x75, 0x5f, 0x72, 0x65, 0x73, 0x6f, 0x6c, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x78, 
-	0x2c, 0x20, 0x6e, 0x64, 0x63, 0x50, 0x6f, 0x73, 0x2e, 0x79, 0x20, 0x2a, 0x20, 0x75, 0x5f, 0x72, 0x65, 0x73, 0x6f, 0x6c, 
-	0x75, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x79, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 
-	0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x44, 0x65, 0x70, 0x74, 0x68, 0x20, 0x3d, 0x20, 0x75, 
-	0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 0x6e, 0x65, 0x61, 0x72, 0x20, 0x2b, 0x20, 0x74, 0x65, 0x78, 
-	0x65, 0x6c, 0x46, 0x65, 0x74, 0x63, 0x68, 0x28, 0x75, 0x5f, 0x67, 0x42, 0x75, 0x66, 0x66, 0x65, 0x72, 0x44, 0x65, 0x70, 
-	0x74, 0x68, 0x2c, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2c, 0x20, 0x30, 0x29, 0x2e, 0x72, 0x20, 
-	0x2a, 0x20, 0x75, 0x62, 0x6f, 0x5f, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 0x66, 0x61, 0x72, 0x3b, 0x0a, 0x09, 0x09, 
-	0x69, 0x66, 0x20, 0x28, 0x2d, 0x76, 0x69, 0x65, 0x77, 0x50, 0x6f, 0x73, 0x2e, 0x7a, 0x20, 0x3e, 0x20, 0x73, 0x61, 0x6d, 
-	0x70, 0x6c, 0x65, 0x44, 0x65, 0x70, 0x74, 0x68, 0x29, 0x0a, 0x09, 0x09, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x6f, 0x63, 0x63, 
-	0x6c, 0x75, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x2b, 0x3d, 0x20, 0x73, 0x6d, 0x6f, 0x6f, 0x74, 0x68, 0x73, 0x74, 0x65, 0x70, 
-	0x28, 0x30, 0x2e, 0x30, 0x2c, 0x20, 0x31, 0x2e, 0x30, 0x2c, 0x20, 0x2d, 0x32, 0x2e, 0x30, 0x20, 0x2a, 0x20, 0x63, 0x75, 
-	0x72, 0x72, 0x65, 0x6e, 0x74, 0x52, 0x61, 0x64, 0x69, 0x75, 0x73, 0x20, 0x2f, 0x20, 0x28, 0x76, 0x69, 0x65, 0x77, 0x50, 
-	0x6f, 0x73, 0x2e, 0x7a, 0x20, 0x2b, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x44, 0x65, 0x70, 0x74, 0x68, 0x29, 0x29, 
-	0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x66, 0x6f, 0x5f, 0x6f, 0x75, 0x74, 0x70, 0x75, 0x74, 
-	0x20, 0x3d, 0x20, 0x6f, 0x63, 0x63, 0x6c, 0x75, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x2f, 0x20, 0x75, 0x5f, 0x73, 0x61, 0x6d, 
-	0x70, 0x6c, 0x65, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x0a, 0x7d, 0x20, 0x0a, 0x0a, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x68, 
-	0x61, 0x73, 0x68, 0x28, 0x69, 0x6e, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x78, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x78, 0x20, 
-	0x2b, 0x3d, 0x20, 0x28, 0x78, 0x20, 0x3c, 0x3c, 0x20, 0x31, 0x30, 0x29, 0x3b, 0x0a, 0x09, 0x78, 0x20, 0x5e, 0x3d, 0x20, 
-	0x28, 0x78, 0x20, 0x3e, 0x3e, 0x20, 0x36, 0x29, 0x3b, 0x0a, 0x09, 0x78, 0x20, 0x2b, 0x3d, 0x20, 0x28, 0x78, 0x20, 0x3c, 
-	0x3c, 0x20, 0x33, 0x29, 0x3b, 0x0a, 0x09, 0x78, 0x20, 0x5e, 0x3d, 0x20, 0x28, 0x78, 0x20, 0x3e, 0x3e, 0x20, 0x31, 0x31, 
-	0x29, 0x3b, 0x0a, 0x09, 0x78, 0x20, 0x2b, 0x3d, 0x20, 0x28, 0x78, 0x20, 0x3c, 0x3c, 0x20, 0x31, 0x35, 0x29, 0x3b, 0x0a, 
-	0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x78, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x68, 
-	0x61, 0x73, 0x68, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x76, 0x65, 0x63, 0x32, 0x20, 0x76, 
-	0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x20, 0x76, 0x2e, 
-	0x78, 0x20, 0x5e, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x76, 0x2e, 0x79, 0x29, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x75, 
-	0x69, 0x6e, 0x74, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x76, 
-	0x65, 0x63, 0x33, 0x20, 0x76, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x68, 0x61, 0x73, 
-	0x68, 0x28, 0x20, 0x76, 0x2e, 0x78, 0x20, 0x5e, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x76, 0x2e, 0x79, 0x29, 0x20, 0x5e, 
-	0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x76, 0x2e, 0x7a, 0x29, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x75, 0x69, 0x6e, 0x74, 
-	0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x76, 0x65, 0x63, 0x34, 
-	0x20, 0x76, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x20, 
-	0x76, 0x2e, 0x78, 0x20, 0x5e, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x76, 0x2e, 0x79, 0x29, 0x20, 0x5e, 0x20, 0x68, 0x61, 
-	0x73, 0x68, 0x28, 0x76, 0x2e, 0x7a, 0x29, 0x20, 0x5e, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x76, 0x2e, 0x77, 0x29, 0x29, 
-	0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x72, 0x61, 0x6e, 0x64, 0x6f, 0x6d, 0x28, 0x69, 0x6e, 
-	0x6f, 0x75, 0x74, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x73, 0x65, 0x65, 0x64, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x73, 0x65, 
-	0x65, 0x64, 0x20, 0x3d, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x73, 0x65, 0x65, 0x64, 0x29, 0x3b, 0x0a, 0x09, 0x72, 0x65, 
-	0x74, 0x75, 0x72, 0x6e, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x42, 0x69, 0x74, 0x73, 0x54, 0x6f, 0x46, 0x6c, 0x6f, 0x61, 0x74, 
-	0x28, 0x28, 0x73, 0x65, 0x65, 0x64, 0x20, 0x26, 0x20, 0x30, 0x78, 0x30, 0x30, 0x37, 0x46, 0x46, 0x46, 0x46, 0x46, 0x29, 
-	0x20, 0x7c, 0x20, 0x30, 0x78, 0x33, 0x46, 0x38, 0x30, 0x30, 0x30, 0x30, 0x30, 0x29, 0x20, 0x2d, 0x20, 0x31, 0x2e, 0x30, 
-	0x3b, 0x0a, 0x7d, 0x0a, 0x00
+	0x65, 0x64, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x73, 0x65, 0x65, 0x64, 0x20, 0x3d, 0x20, 0x68, 0x61, 0x73, 0x68, 0x28, 0x73, 
+	0x65, 0x65, 0x64, 0x29, 0x3b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x42, 0x69, 
+	0x74, 0x73, 0x54, 0x6f, 0x46, 0x6c, 0x6f, 0x61, 0x74, 0x28, 0x28, 0x73, 0x65, 0x65, 0x64, 0x20, 0x26, 0x20, 0x30, 0x78, 
+	0x30, 0x30, 0x37, 0x46, 0x46, 0x46, 0x46, 0x46, 0x29, 0x20, 0x7c, 0x20, 0x30, 0x78, 0x33, 0x46, 0x38, 0x30, 0x30, 0x30, 
+	0x30, 0x30, 0x29, 0x20, 0x2d, 0x20, 0x31, 0x2e, 0x30, 0x3b, 0x0a, 0x7d, 0x0a, 0x00
 };
 
 static constexpr char ssao_vert[] = {
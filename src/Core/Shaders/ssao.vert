@@ -1,22 +1,22 @@
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//! \file
-//! \author Reiex
-//! \copyright The MIT License (MIT)
-//! \date 2023
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-// Vertex attributes
-
-layout (location = 0) in vec2 va_position;
-
-// Outputs
-
-out vec2 io_texCoords;
-
-// Function definitions
-
-void main()
-{
-	gl_Position = vec4(va_position, 0.0, 1.0);
-	io_texCoords = (va_position + 1.0) / 2.0;
-}
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Vertex attributes
+
+layout (location = 0) in vec2 va_position;
+
+// Outputs
+
+out vec2 io_texCoords;
+
+// Function definitions
+
+void main()
+{
+	gl_Position = vec4(va_position, 0.0, 1.0);
+	io_texCoords = (va_position + 1.0) / 2.0;
+}
@@ -0,0 +1,191 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <Lyse/Core/Core.hpp>
+
+namespace lys
+{
+	StateCache::StateCache() :
+		_context(nullptr),
+		_faceCullingMode(),
+		_faceCullingOrientation(),
+		_blendEnabled(),
+		_depthTestEnabled(),
+		_depthWriteEnabled(),
+		_shader(nullptr),
+		_buffers(),
+		_textureUnits(),
+		_uniforms(),
+		_shaderUniforms(nullptr)
+	{
+	}
+
+	void StateCache::invalidate()
+	{
+		_context = spl::Context::getCurrentContext();
+
+		_faceCullingMode.reset();
+		_faceCullingOrientation.reset();
+		_blendEnabled.fill(std::nullopt);
+		_depthTestEnabled.reset();
+		_depthWriteEnabled.reset();
+
+		// The containers keep their memory, the programs are bound again every frame
+
+		_shader = nullptr;
+		_buffers.clear();
+		std::fill(_textureUnits.begin(), _textureUnits.end(), nullptr);
+
+		for (std::pair<const spl::ShaderProgram* const, std::vector<Uniform>>& uniforms : _uniforms)
+		{
+			uniforms.second.clear();
+		}
+		_shaderUniforms = nullptr;
+	}
+
+	void StateCache::setFaceCullingMode(spl::FaceCullingMode mode)
+	{
+		assert(_context);
+
+		if (_faceCullingMode != mode)
+		{
+			_context->setFaceCullingMode(mode);
+			_faceCullingMode = mode;
+		}
+	}
+
+	void StateCache::setFaceCullingOrientation(spl::FaceOrientation orientation)
+	{
+		assert(_context);
+
+		if (_faceCullingOrientation != orientation)
+		{
+			_context->setFaceCullingOrientation(orientation);
+			_faceCullingOrientation = orientation;
+		}
+	}
+
+	void StateCache::setIsBlendEnabled(uint32_t drawBuffer, bool enabled)
+	{
+		assert(_context);
+		assert(drawBuffer < maxDrawBufferCount);
+
+		if (_blendEnabled[drawBuffer] != enabled)
+		{
+			_context->setIsBlendEnabled(drawBuffer, enabled);
+			_blendEnabled[drawBuffer] = enabled;
+		}
+	}
+
+	void StateCache::setIsDepthTestEnabled(bool enabled)
+	{
+		assert(_context);
+
+		if (_depthTestEnabled != enabled)
+		{
+			_context->setIsDepthTestEnabled(enabled);
+			_depthTestEnabled = enabled;
+		}
+	}
+
+	void StateCache::setIsDepthWriteEnabled(bool enabled)
+	{
+		assert(_context);
+
+		if (_depthWriteEnabled != enabled)
+		{
+			_context->setIsDepthWriteEnabled(enabled);
+			_depthWriteEnabled = enabled;
+		}
+	}
+
+	void StateCache::bindShader(const spl::ShaderProgram* shader)
+	{
+		if (shader == _shader)
+		{
+			return;
+		}
+
+		spl::ShaderProgram::bind(shader);
+		_shader = shader;
+		_shaderUniforms = &_uniforms[shader];
+	}
+
+	void StateCache::bindBuffer(spl::BufferTarget target, const spl::Buffer* buffer, uint32_t index)
+	{
+		const auto binding = std::find_if(_buffers.begin(), _buffers.end(), [&](const BufferBinding& bound) {
+			return bound.target == target && bound.index == index;
+		});
+
+		if (binding == _buffers.end())
+		{
+			_buffers.push_back({ target, index, buffer });
+		}
+		else if (binding->buffer != buffer)
+		{
+			binding->buffer = buffer;
+		}
+		else
+		{
+			return;
+		}
+
+		spl::Buffer::bind(target, buffer, index);
+	}
+
+	void StateCache::setUniform(int32_t location, uint32_t unit, const spl::Texture* texture)
+	{
+		assert(_shader);
+		assert(texture);
+
+		// The sampler and the texture unit are set by the same call, it is skipped only when neither changed
+
+		if (unit >= _textureUnits.size())
+		{
+			_textureUnits.resize(unit + 1, nullptr);
+		}
+
+		const bool samplerChanged = _updateUniform(location, &unit, sizeof(uint32_t));
+		if (samplerChanged || _textureUnits[unit] != texture)
+		{
+			_shader->setUniform(location, unit, texture);
+			_textureUnits[unit] = texture;
+		}
+	}
+
+	const spl::ShaderProgram* StateCache::getShader() const
+	{
+		return _shader;
+	}
+
+	bool StateCache::_updateUniform(int32_t location, const void* value, uint32_t size)
+	{
+		Uniform uniform;
+		uniform.location = location;
+		std::memset(uniform.value, 0, sizeof(uniform.value));
+		std::memcpy(uniform.value, value, size);
+
+		const auto it = std::find_if(_shaderUniforms->begin(), _shaderUniforms->end(), [&](const Uniform& set) {
+			return set.location == location;
+		});
+
+		if (it == _shaderUniforms->end())
+		{
+			_shaderUniforms->push_back(uniform);
+		}
+		else if (std::memcmp(it->value, uniform.value, sizeof(uniform.value)) != 0)
+		{
+			*it = uniform;
+		}
+		else
+		{
+			return false;
+		}
+
+		return true;
+	}
+}
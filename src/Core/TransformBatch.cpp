@@ -0,0 +1,363 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <Lyse/Core/Core.hpp>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <immintrin.h>
+#endif
+
+namespace lys
+{
+	namespace
+	{
+		// Width of the SIMD registers the matrices are computed with, `blockSize` must be a multiple of it
+
+		namespace simd
+		{
+			#if defined(__AVX2__)
+
+				using Lanes = __m256;
+				constexpr uint32_t laneCount = 8;
+
+				Lanes load(const float* values) { return _mm256_loadu_ps(values); }
+				void store(float* values, Lanes a) { _mm256_storeu_ps(values, a); }
+				Lanes broadcast(float value) { return _mm256_set1_ps(value); }
+				Lanes add(Lanes a, Lanes b) { return _mm256_add_ps(a, b); }
+				Lanes sub(Lanes a, Lanes b) { return _mm256_sub_ps(a, b); }
+				Lanes mul(Lanes a, Lanes b) { return _mm256_mul_ps(a, b); }
+				Lanes div(Lanes a, Lanes b) { return _mm256_div_ps(a, b); }
+
+			#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+				using Lanes = __m128;
+				constexpr uint32_t laneCount = 4;
+
+				Lanes load(const float* values) { return _mm_loadu_ps(values); }
+				void store(float* values, Lanes a) { _mm_storeu_ps(values, a); }
+				Lanes broadcast(float value) { return _mm_set1_ps(value); }
+				Lanes add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+				Lanes sub(Lanes a, Lanes b) { return _mm_sub_ps(a, b); }
+				Lanes mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+				Lanes div(Lanes a, Lanes b) { return _mm_div_ps(a, b); }
+
+			#else
+
+				using Lanes = float;
+				constexpr uint32_t laneCount = 1;
+
+				Lanes load(const float* values) { return *values; }
+				void store(float* values, Lanes a) { *values = a; }
+				Lanes broadcast(float value) { return value; }
+				Lanes add(Lanes a, Lanes b) { return a + b; }
+				Lanes sub(Lanes a, Lanes b) { return a - b; }
+				Lanes mul(Lanes a, Lanes b) { return a * b; }
+				Lanes div(Lanes a, Lanes b) { return a / b; }
+
+			#endif
+		}
+
+		static_assert(TransformBatch::blockSize % simd::laneCount == 0);
+	}
+
+	TransformBatch::TransformBatch() :
+		_translationsX(),
+		_translationsY(),
+		_translationsZ(),
+		_rotationsW(),
+		_rotationsX(),
+		_rotationsY(),
+		_rotationsZ(),
+		_scalesX(),
+		_scalesY(),
+		_scalesZ(),
+		_transforms(),
+		_invTransforms(),
+		_dirtyBlocks(),
+		_size(0)
+	{
+	}
+
+	uint32_t TransformBatch::add(const scp::f32vec3& translation, const scp::f32quat& rotation, const scp::f32vec3& scale)
+	{
+		resize(_size + 1);
+		set(_size - 1, translation, rotation, scale);
+
+		return _size - 1;
+	}
+
+	uint32_t TransformBatch::add(const Transformable& transformable)
+	{
+		return add(transformable.getTranslation(), transformable.getRotation(), transformable.getScale());
+	}
+
+	void TransformBatch::set(uint32_t index, const scp::f32vec3& translation, const scp::f32quat& rotation, const scp::f32vec3& scale)
+	{
+		assert(index < _size);
+
+		_translationsX[index] = translation.x;
+		_translationsY[index] = translation.y;
+		_translationsZ[index] = translation.z;
+		_rotationsW[index] = rotation.w;
+		_rotationsX[index] = rotation.x;
+		_rotationsY[index] = rotation.y;
+		_rotationsZ[index] = rotation.z;
+		_scalesX[index] = scale.x;
+		_scalesY[index] = scale.y;
+		_scalesZ[index] = scale.z;
+
+		_dirtyBlocks[index / blockSize] = true;
+	}
+
+	void TransformBatch::set(uint32_t index, const Transformable& transformable)
+	{
+		set(index, transformable.getTranslation(), transformable.getRotation(), transformable.getScale());
+	}
+
+	void TransformBatch::setTranslation(uint32_t index, const scp::f32vec3& translation)
+	{
+		assert(index < _size);
+
+		_translationsX[index] = translation.x;
+		_translationsY[index] = translation.y;
+		_translationsZ[index] = translation.z;
+
+		_dirtyBlocks[index / blockSize] = true;
+	}
+
+	void TransformBatch::setRotation(uint32_t index, const scp::f32quat& rotation)
+	{
+		assert(index < _size);
+
+		_rotationsW[index] = rotation.w;
+		_rotationsX[index] = rotation.x;
+		_rotationsY[index] = rotation.y;
+		_rotationsZ[index] = rotation.z;
+
+		_dirtyBlocks[index / blockSize] = true;
+	}
+
+	void TransformBatch::setScale(uint32_t index, const scp::f32vec3& scale)
+	{
+		assert(index < _size);
+
+		_scalesX[index] = scale.x;
+		_scalesY[index] = scale.y;
+		_scalesZ[index] = scale.z;
+
+		_dirtyBlocks[index / blockSize] = true;
+	}
+
+	void TransformBatch::resize(uint32_t size)
+	{
+		// The arrays are padded to whole blocks, so that the SIMD loads never read past their end
+
+		const uint32_t paddedSize = ((size + blockSize - 1) / blockSize) * blockSize;
+
+		_translationsX.resize(paddedSize);
+		_translationsY.resize(paddedSize);
+		_translationsZ.resize(paddedSize);
+		_rotationsW.resize(paddedSize);
+		_rotationsX.resize(paddedSize);
+		_rotationsY.resize(paddedSize);
+		_rotationsZ.resize(paddedSize);
+		_scalesX.resize(paddedSize);
+		_scalesY.resize(paddedSize);
+		_scalesZ.resize(paddedSize);
+
+		_transforms.resize(size);
+		_invTransforms.resize(size);
+		_dirtyBlocks.resize(paddedSize / blockSize);
+
+		// New entries and the padding are identity transforms, the padding must not divide by zero
+
+		const uint32_t oldSize = std::min(_size, size);
+		_size = size;
+
+		for (uint32_t i = oldSize; i < paddedSize; ++i)
+		{
+			_translationsX[i] = 0.f;
+			_translationsY[i] = 0.f;
+			_translationsZ[i] = 0.f;
+			_rotationsW[i] = 1.f;
+			_rotationsX[i] = 0.f;
+			_rotationsY[i] = 0.f;
+			_rotationsZ[i] = 0.f;
+			_scalesX[i] = 1.f;
+			_scalesY[i] = 1.f;
+			_scalesZ[i] = 1.f;
+
+			_dirtyBlocks[i / blockSize] = true;
+		}
+	}
+
+	void TransformBatch::clear()
+	{
+		resize(0);
+	}
+
+	void TransformBatch::update()
+	{
+		JobSystem::getGlobal().parallelFor(0, _dirtyBlocks.size(), 256, [&](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				if (_dirtyBlocks[i])
+				{
+					_computeBlock(i);
+					_dirtyBlocks[i] = false;
+				}
+			}
+		});
+	}
+
+	uint32_t TransformBatch::getSize() const
+	{
+		return _size;
+	}
+
+	const scp::f32mat4x4& TransformBatch::getTransformMatrix(uint32_t index) const
+	{
+		assert(index < _size);
+		return _transforms[index];
+	}
+
+	const scp::f32mat4x4& TransformBatch::getInverseTransformMatrix(uint32_t index) const
+	{
+		assert(index < _size);
+		return _invTransforms[index];
+	}
+
+	const scp::f32mat4x4* TransformBatch::getTransformMatrices() const
+	{
+		return _transforms.data();
+	}
+
+	const scp::f32mat4x4* TransformBatch::getInverseTransformMatrices() const
+	{
+		return _invTransforms.data();
+	}
+
+	void TransformBatch::_computeBlock(uint32_t block)
+	{
+		// The 12 first coefficients of the matrices, row by row, for each entry of the block
+
+		alignas(32) float transforms[12][blockSize];
+		alignas(32) float invTransforms[12][blockSize];
+
+		const uint32_t begin = block * blockSize;
+		for (uint32_t offset = 0; offset < blockSize; offset += simd::laneCount)
+		{
+			const uint32_t i = begin + offset;
+
+			const simd::Lanes w = simd::load(&_rotationsW[i]);
+			const simd::Lanes x = simd::load(&_rotationsX[i]);
+			const simd::Lanes y = simd::load(&_rotationsY[i]);
+			const simd::Lanes z = simd::load(&_rotationsZ[i]);
+
+			const simd::Lanes aa = simd::mul(w, w);
+			const simd::Lanes bb = simd::mul(x, x);
+			const simd::Lanes cc = simd::mul(y, y);
+			const simd::Lanes dd = simd::mul(z, z);
+
+			const simd::Lanes two = simd::broadcast(2.f);
+
+			const simd::Lanes ab2 = simd::mul(two, simd::mul(w, x));
+			const simd::Lanes ac2 = simd::mul(two, simd::mul(w, y));
+			const simd::Lanes ad2 = simd::mul(two, simd::mul(w, z));
+
+			const simd::Lanes bc2 = simd::mul(two, simd::mul(x, y));
+			const simd::Lanes bd2 = simd::mul(two, simd::mul(x, z));
+
+			const simd::Lanes cd2 = simd::mul(two, simd::mul(y, z));
+
+			const simd::Lanes r11 = simd::sub(simd::add(aa, bb), simd::add(cc, dd));
+			const simd::Lanes r12 = simd::sub(bc2, ad2);
+			const simd::Lanes r13 = simd::add(ac2, bd2);
+			const simd::Lanes r21 = simd::add(ad2, bc2);
+			const simd::Lanes r22 = simd::sub(simd::add(aa, cc), simd::add(bb, dd));
+			const simd::Lanes r23 = simd::sub(cd2, ab2);
+			const simd::Lanes r31 = simd::sub(bd2, ac2);
+			const simd::Lanes r32 = simd::add(ab2, cd2);
+			const simd::Lanes r33 = simd::sub(simd::add(aa, dd), simd::add(bb, cc));
+
+			const simd::Lanes sx = simd::load(&_scalesX[i]);
+			const simd::Lanes sy = simd::load(&_scalesY[i]);
+			const simd::Lanes sz = simd::load(&_scalesZ[i]);
+
+			const simd::Lanes tx = simd::load(&_translationsX[i]);
+			const simd::Lanes ty = simd::load(&_translationsY[i]);
+			const simd::Lanes tz = simd::load(&_translationsZ[i]);
+
+			simd::store(&transforms[0][offset], simd::mul(r11, sx));
+			simd::store(&transforms[1][offset], simd::mul(r12, sy));
+			simd::store(&transforms[2][offset], simd::mul(r13, sz));
+			simd::store(&transforms[3][offset], tx);
+			simd::store(&transforms[4][offset], simd::mul(r21, sx));
+			simd::store(&transforms[5][offset], simd::mul(r22, sy));
+			simd::store(&transforms[6][offset], simd::mul(r23, sz));
+			simd::store(&transforms[7][offset], ty);
+			simd::store(&transforms[8][offset], simd::mul(r31, sx));
+			simd::store(&transforms[9][offset], simd::mul(r32, sy));
+			simd::store(&transforms[10][offset], simd::mul(r33, sz));
+			simd::store(&transforms[11][offset], tz);
+
+			// The rotation of the inverse quaternion is the transpose divided by the squared norm of the quaternion twice
+
+			const simd::Lanes norm = simd::add(simd::add(aa, bb), simd::add(cc, dd));
+			const simd::Lanes invNormSquared = simd::div(simd::broadcast(1.f), simd::mul(norm, norm));
+
+			const simd::Lanes isx = simd::div(invNormSquared, sx);
+			const simd::Lanes isy = simd::div(invNormSquared, sy);
+			const simd::Lanes isz = simd::div(invNormSquared, sz);
+
+			const simd::Lanes i11 = simd::mul(r11, isx);
+			const simd::Lanes i12 = simd::mul(r21, isx);
+			const simd::Lanes i13 = simd::mul(r31, isx);
+			const simd::Lanes i21 = simd::mul(r12, isy);
+			const simd::Lanes i22 = simd::mul(r22, isy);
+			const simd::Lanes i23 = simd::mul(r32, isy);
+			const simd::Lanes i31 = simd::mul(r13, isz);
+			const simd::Lanes i32 = simd::mul(r23, isz);
+			const simd::Lanes i33 = simd::mul(r33, isz);
+
+			const simd::Lanes zero = simd::broadcast(0.f);
+
+			simd::store(&invTransforms[0][offset], i11);
+			simd::store(&invTransforms[1][offset], i12);
+			simd::store(&invTransforms[2][offset], i13);
+			simd::store(&invTransforms[3][offset], simd::sub(zero, simd::add(simd::add(simd::mul(i11, tx), simd::mul(i12, ty)), simd::mul(i13, tz))));
+			simd::store(&invTransforms[4][offset], i21);
+			simd::store(&invTransforms[5][offset], i22);
+			simd::store(&invTransforms[6][offset], i23);
+			simd::store(&invTransforms[7][offset], simd::sub(zero, simd::add(simd::add(simd::mul(i21, tx), simd::mul(i22, ty)), simd::mul(i23, tz))));
+			simd::store(&invTransforms[8][offset], i31);
+			simd::store(&invTransforms[9][offset], i32);
+			simd::store(&invTransforms[10][offset], i33);
+			simd::store(&invTransforms[11][offset], simd::sub(zero, simd::add(simd::add(simd::mul(i31, tx), simd::mul(i32, ty)), simd::mul(i33, tz))));
+		}
+
+		const uint32_t end = std::min(begin + blockSize, _size);
+		for (uint32_t i = begin; i < end; ++i)
+		{
+			const uint32_t j = i - begin;
+
+			_transforms[i] = {
+				transforms[0][j], transforms[1][j], transforms[2][j], transforms[3][j],
+				transforms[4][j], transforms[5][j], transforms[6][j], transforms[7][j],
+				transforms[8][j], transforms[9][j], transforms[10][j], transforms[11][j],
+				0.f             , 0.f             , 0.f              , 1.f
+			};
+
+			_invTransforms[i] = {
+				invTransforms[0][j], invTransforms[1][j], invTransforms[2][j], invTransforms[3][j],
+				invTransforms[4][j], invTransforms[5][j], invTransforms[6][j], invTransforms[7][j],
+				invTransforms[8][j], invTransforms[9][j], invTransforms[10][j], invTransforms[11][j],
+				0.f                , 0.f                , 0.f                 , 1.f
+			};
+		}
+	}
+}
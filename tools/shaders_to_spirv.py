@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+
+import os
+import subprocess
+import sys
+import tempfile
+
+
+# Feature defines of the header, in the order `Scene::_loadShaders` appends them
+
+FEATURES = ["SHADOW", "TRANSPARENCY", "SSAO", "TEXTURE_ARRAYS"]
+
+DEFINES = {
+	"background": "#define BACKGROUND_TEXTURE\n",
+	"backgroundProjection": "#define BACKGROUND_PROJECTION\n",
+	"backgroundCubemap": "#define BACKGROUND_CUBEMAP\n",
+	"colorMap": "#define COLOR_TEXTURE\n",
+	"materialMap": "#define MATERIAL_TEXTURE\n",
+	"normalMap": "#define NORMAL_TEXTURE\n",
+	"compactVertex": "#define COMPACT_VERTEX\n",
+	"gpuDriven": "#define GPU_DRIVEN\n"
+}
+
+# Same modules as `Scene::_buildShaderLibrary`, with the same sources in the same order. The geometry shaders are not
+# precompiled, `SHADOW_TEXTURE_COUNT` sizes their output and cannot be a specialization constant.
+
+MODULES = [
+	("vert", ["header", "common_glsl", "ssao_vert"]),
+	("frag", ["header", "common_glsl", "ssao_frag"]),
+	("vert", ["header", "common_glsl", "merge_vert"]),
+	("frag", ["header", "common_glsl", "lightingHeader_glsl", "merge_frag", "lighting_glsl"]),
+	("frag", ["header", "common_glsl", "lightingHeader_glsl", "background", "backgroundProjection", "merge_frag", "lighting_glsl"]),
+	("frag", ["header", "common_glsl", "lightingHeader_glsl", "background", "backgroundCubemap", "merge_frag", "lighting_glsl"]),
+	("frag", ["header", "common_glsl", "depthPyramid_frag"]),
+	("comp", ["header", "common_glsl", "culling_comp"]),
+
+	("vert", ["header", "common_glsl", "mesh_gBuffer_vert"]),
+	("vert", ["header", "common_glsl", "compactVertex", "mesh_gBuffer_vert"]),
+	("vert", ["header", "common_glsl", "gpuDriven", "mesh_gBuffer_vert"]),
+	("vert", ["header", "common_glsl", "compactVertex", "gpuDriven", "mesh_gBuffer_vert"]),
+	("frag", ["header", "common_glsl", "mesh_gBuffer_frag"]),
+	("frag", ["header", "common_glsl", "colorMap", "mesh_gBuffer_frag"]),
+	("frag", ["header", "common_glsl", "materialMap", "mesh_gBuffer_frag"]),
+	("frag", ["header", "common_glsl", "colorMap", "materialMap", "mesh_gBuffer_frag"]),
+	("frag", ["header", "common_glsl", "normalMap", "mesh_gBuffer_frag"]),
+	("frag", ["header", "common_glsl", "colorMap", "normalMap", "mesh_gBuffer_frag"]),
+	("frag", ["header", "common_glsl", "materialMap", "normalMap", "mesh_gBuffer_frag"]),
+	("frag", ["header", "common_glsl", "colorMap", "materialMap", "normalMap", "mesh_gBuffer_frag"]),
+	("vert", ["header", "common_glsl", "mesh_shadowMapping_vert"]),
+	("vert", ["header", "common_glsl", "colorMap", "mesh_shadowMapping_vert"]),
+	("vert", ["header", "common_glsl", "compactVertex", "mesh_shadowMapping_vert"]),
+	("vert", ["header", "common_glsl", "compactVertex", "colorMap", "mesh_shadowMapping_vert"]),
+	("vert", ["header", "common_glsl", "gpuDriven", "mesh_shadowMapping_vert"]),
+	("vert", ["header", "common_glsl", "gpuDriven", "colorMap", "mesh_shadowMapping_vert"]),
+	("vert", ["header", "common_glsl", "compactVertex", "gpuDriven", "mesh_shadowMapping_vert"]),
+	("vert", ["header", "common_glsl", "compactVertex", "gpuDriven", "colorMap", "mesh_shadowMapping_vert"]),
+	("frag", ["header", "common_glsl", "mesh_shadowMapping_frag"]),
+	("frag", ["header", "common_glsl", "colorMap", "mesh_shadowMapping_frag"]),
+	("vert", ["header", "common_glsl", "mesh_transparency_vert"]),
+	("vert", ["header", "common_glsl", "compactVertex", "mesh_transparency_vert"]),
+	("frag", ["header", "common_glsl", "lightingHeader_glsl", "mesh_transparency_frag", "lighting_glsl"]),
+	("frag", ["header", "common_glsl", "lightingHeader_glsl", "colorMap", "mesh_transparency_frag", "lighting_glsl"]),
+	("frag", ["header", "common_glsl", "lightingHeader_glsl", "materialMap", "mesh_transparency_frag", "lighting_glsl"]),
+	("frag", ["header", "common_glsl", "lightingHeader_glsl", "colorMap", "materialMap", "mesh_transparency_frag", "lighting_glsl"]),
+	("frag", ["header", "common_glsl", "lightingHeader_glsl", "normalMap", "mesh_transparency_frag", "lighting_glsl"]),
+	("frag", ["header", "common_glsl", "lightingHeader_glsl", "colorMap", "normalMap", "mesh_transparency_frag", "lighting_glsl"]),
+	("frag", ["header", "common_glsl", "lightingHeader_glsl", "materialMap", "normalMap", "mesh_transparency_frag", "lighting_glsl"]),
+	("frag", ["header", "common_glsl", "lightingHeader_glsl", "colorMap", "materialMap", "normalMap", "mesh_transparency_frag", "lighting_glsl"])
+]
+
+
+# FNV-1a, as `hashBytes` in Scene.cpp
+
+def fnv1a(data):
+
+	hash = 14695981039346656037
+
+	for byte in data:
+		hash = ((hash ^ byte) * 1099511628211) % (1 << 64)
+
+	return hash
+
+
+def compile_module(glslang_validator, stage, source, directory):
+
+	source_path = os.path.join(directory, "module." + stage)
+	spirv_path = os.path.join(directory, "module.spv")
+
+	with open(source_path, "w", newline="\n") as file:
+		file.write(source)
+
+	# Default uniforms have no explicit location in the sources, the scene finds them by name
+
+	subprocess.run([glslang_validator, "-G", "--auto-map-locations", "--auto-map-bindings", "-o", spirv_path, source_path], check=True)
+
+	with open(spirv_path, "rb") as file:
+		spirv = file.read()
+
+	assert len(spirv) % 4 == 0
+
+	return [int.from_bytes(spirv[i:i + 4], "little") for i in range(0, len(spirv), 4)]
+
+
+def main(argv):
+
+	# Each argument after the compiler is a comma separated list of features, one header is precompiled per list
+
+	assert len(argv) >= 4
+
+	shader_folder = argv[1]
+	output_path = argv[2]
+	glslang_validator = argv[3]
+
+	sources = {}
+	for filename in os.listdir(shader_folder):
+
+		if len(filename.split(".")) != 2 or filename.split(".")[1] not in ["vert", "frag", "comp", "glsl"]:
+			continue
+
+		with open(os.path.join(shader_folder, filename), "r") as file:
+			sources[filename.split(".")[0] + "_" + filename.split(".")[1]] = file.read()
+
+	modules = {}
+
+	with tempfile.TemporaryDirectory() as directory:
+
+		for features in argv[4:]:
+
+			features = [feature for feature in features.split(",") if feature]
+			assert all(feature in FEATURES for feature in features)
+
+			header = "#version 460 core\n"
+			for feature in FEATURES:
+				if feature in features:
+					header += "#define {}\n".format(feature)
+
+			for stage, parts in MODULES:
+
+				source = "".join(header if part == "header" else DEFINES[part] if part in DEFINES else sources[part] for part in parts)
+
+				hash = fnv1a(source.encode("utf-8"))
+				if hash not in modules:
+					modules[hash] = compile_module(glslang_validator, stage, source, directory)
+
+	output = open(output_path, "w")
+
+	output.write("""\
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \\file
+//! \\author Reiex
+//! \\copyright The MIT License (MIT)
+//! \\date 2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Modules compiled to SPIR-V by the build, found by the hash of their GLSL sources without the counts
+
+struct PrecompiledShaderModule
+{
+	uint64_t hash;
+	const uint32_t* spirv;
+	uint32_t size;
+};
+
+""")
+
+	for hash, spirv in sorted(modules.items()):
+
+		output.write("static constexpr uint32_t spirv_{:016x}[] = {{".format(hash))
+
+		for i, word in enumerate(spirv):
+			if i % 8 == 0:
+				output.write("\n\t")
+			output.write("0x" + hex(word)[2:].zfill(8) + ", ")
+
+		output.write("\n};\n\n")
+
+	output.write("static constexpr PrecompiledShaderModule precompiledShaderModules[] = {\n")
+
+	for hash in sorted(modules.keys()):
+		output.write("\t{{ 0x{0:016x}ull, spirv_{0:016x}, sizeof(spirv_{0:016x}) }},\n".format(hash))
+
+	output.write("\t{ 0, nullptr, 0 }\n};\n")
+
+
+if __name__ == "__main__":
+	main(sys.argv)